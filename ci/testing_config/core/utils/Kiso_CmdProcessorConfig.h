@@ -0,0 +1,54 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ * @file
+ *
+ * @brief Configuration header for the CmdProcessor module.
+ *
+ */
+
+#ifndef KISO_CMDPROCESSOR_CONFIG_H_
+#define KISO_CMDPROCESSOR_CONFIG_H_
+
+/**
+ * Number of commands a command processor with several lanes runs per wake-up, before it lets other tasks
+ * of the same priority run.
+ * May be overridden by the projects compiler definitions.
+ */
+#ifndef CONFIG_CMDPROCESSOR_BATCH_SIZE
+#define CONFIG_CMDPROCESSOR_BATCH_SIZE (8)
+#endif
+
+/**
+ * Number of coalescing commands which may be queued at once per command processor.
+ * One entry increases the RAM footprint by 8 bytes for each CmdProcessor instance.
+ * May be overridden by the projects compiler definitions.
+ */
+#ifndef CONFIG_CMDPROCESSOR_COALESCE_SLOTS
+#define CONFIG_CMDPROCESSOR_COALESCE_SLOTS (4)
+#endif
+
+/**
+ * Number of slots per level of the timer wheel of a command processor, as a power of two (1 to 5).
+ * The wheel has three levels, so it covers 2^(3 * bits) ticks, timers further ahead are placed
+ * again when the wheel reaches its last slot. One slot increases the RAM footprint by 12 bytes
+ * for each CmdProcessor instance.
+ * May be overridden by the projects compiler definitions.
+ */
+#ifndef CONFIG_CMDPROCESSOR_TIMER_SLOT_BITS
+#define CONFIG_CMDPROCESSOR_TIMER_SLOT_BITS (4)
+#endif
+
+#endif // KISO_CMDPROCESSOR_CONFIG_H_
@@ -24,11 +24,38 @@
 
 /**
  * Number of observers allowed within the eventHub.
- * One observer increases the RAM footprint by 12 bytes for each EventHub instance.
+ * One observer increases the RAM footprint by 16 bytes for each EventHub instance.
  * May be overridden by the projects compiler definitions.
  */
 #ifndef CONFIG_EVENTHUB_MAX_OBSERVERS
 #define CONFIG_EVENTHUB_MAX_OBSERVERS (16)
 #endif
 
+/**
+ * Number of lists the observers of single events are sorted into, by a hash of the event.
+ * Must be a power of two. Notifying an event visits the observers of its list only.
+ * May be overridden by the projects compiler definitions.
+ */
+#ifndef CONFIG_EVENTHUB_EVENT_BUCKETS
+#define CONFIG_EVENTHUB_EVENT_BUCKETS (8)
+#endif
+
+/**
+ * Number of notifications from interrupts which may wait for their delivery per EventHub instance.
+ * One notification increases the RAM footprint by 8 bytes for each EventHub instance.
+ * May be overridden by the projects compiler definitions.
+ */
+#ifndef CONFIG_EVENTHUB_ISR_QUEUE_SIZE
+#define CONFIG_EVENTHUB_ISR_QUEUE_SIZE (4)
+#endif
+
+/**
+ * Number of deliveries to asynchronous observers which may wait for their command processor per EventHub instance.
+ * One delivery increases the RAM footprint by 16 bytes for each EventHub instance.
+ * May be overridden by the projects compiler definitions.
+ */
+#ifndef CONFIG_EVENTHUB_ASYNC_QUEUE_SIZE
+#define CONFIG_EVENTHUB_ASYNC_QUEUE_SIZE (8)
+#endif
+
 #endif // KISO_EVENTHUB_CONFIG_H_
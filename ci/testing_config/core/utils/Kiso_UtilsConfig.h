@@ -39,6 +39,12 @@
 #define KISO_FEATURE_I2CTRANSCEIVER  1
 #define KISO_FEATURE_XPROTOCOL       1
 #define KISO_FEATURE_PIPEANDFILTER   1
+#ifndef KISO_UTILS_TASK_NOTIFICATIONS
+#define KISO_UTILS_TASK_NOTIFICATIONS 0
+#endif
+#ifndef KISO_UTILS_STATIC_ALLOCATION
+#define KISO_UTILS_STATIC_ALLOCATION  0
+#endif
 // clang-format on
 
 #endif /* KISO_UTILSCONFIG_H_ */
@@ -40,6 +40,25 @@
 #define KISO_FEATURE_CRC 1
 #endif
 
+#if KISO_FEATURE_CRC
+    #ifndef KISO_CRC_TABLE_DRIVEN
+    /** @brief Enable (1) to calculate CRCs byte-wise from lazily built lookup tables (~0.25, 0.5 and 1 KiB RAM per cached table of CRC8, CRC16 and each CRC32 routine) instead of bit by bit. */
+    #define KISO_CRC_TABLE_DRIVEN 1
+    #endif
+    #ifndef KISO_CRC_TABLE_CACHE_SIZE
+    /** @brief Number of polynomials per CRC routine whose lookup tables are kept; each takes the RAM of one table. Further polynomials use the bit-serial calculation. Requires KISO_CRC_TABLE_DRIVEN. */
+    #define KISO_CRC_TABLE_CACHE_SIZE 2
+    #endif
+    #ifndef KISO_CRC32_SLICING_BY_4
+    /** @brief Enable (1) to process four octets per step in the CRC32 routines (slicing-by-4), at the cost of 3 KiB additional RAM per routine. Requires KISO_CRC_TABLE_DRIVEN. */
+    #define KISO_CRC32_SLICING_BY_4 0
+    #endif
+    #ifndef KISO_CRC_HARDWARE_OFFLOAD
+    /** @brief Enable (1) to let CRC_Update() use the MCU CRC unit when it supports the algorithm. Requires KISO_FEATURE_MCU_CRC. */
+    #define KISO_CRC_HARDWARE_OFFLOAD 0
+    #endif
+#endif /* if KISO_FEATURE_CRC */
+
 #ifndef KISO_FEATURE_EVENTHUB
 /** @brief Enable (1) or disable (0) the EventHub feature. */
 #define KISO_FEATURE_EVENTHUB 1
@@ -65,6 +84,13 @@
 #define KISO_FEATURE_RINGBUFFER 1
 #endif
 
+#if KISO_FEATURE_RINGBUFFER
+    #ifndef KISO_RINGBUFFER_POWER_OF_TWO
+    /** @brief Enable (1) to restrict RingBuffer sizes to powers of two and wrap indices by masking instead of comparing. */
+    #define KISO_RINGBUFFER_POWER_OF_TWO 0
+    #endif
+#endif /* if KISO_FEATURE_RINGBUFFER */
+
 #ifndef KISO_FEATURE_SLEEPCONTROL
 /** @brief Enable (1) or disable (0) the SleepControl feature. */
 #define KISO_FEATURE_SLEEPCONTROL 0
@@ -97,11 +123,28 @@
 #define KISO_FEATURE_XPROTOCOL 1
 #endif
 
+#if KISO_FEATURE_XPROTOCOL
+    #ifndef KISO_XPROTOCOL_COBS
+    /** @brief Enable (1) to frame XProtocol messages with Consistent Overhead Byte Stuffing (at most 1 byte overhead per 254) instead of escaping SD, ED and ESC. Both peers must use the same framing. */
+    #define KISO_XPROTOCOL_COBS 0
+    #endif
+#endif /* if KISO_FEATURE_XPROTOCOL */
+
 #ifndef KISO_FEATURE_PIPEANDFILTER
 /** @brief Enable (1) or disable (0) the pipe & filter pattern feature. */
 #define KISO_FEATURE_PIPEANDFILTER 1
 #endif
 
+#ifndef KISO_UTILS_TASK_NOTIFICATIONS
+/** @brief Enable (1) to wake the tasks waiting in GuardedTask, UARTTransceiver, I2CTransceiver and the cellular engine with direct-to-task notifications instead of binary semaphores, which need no RAM and wake the task faster. Requires configUSE_TASK_NOTIFICATIONS. */
+#define KISO_UTILS_TASK_NOTIFICATIONS 0
+#endif
+
+#ifndef KISO_UTILS_STATIC_ALLOCATION
+/** @brief Enable (1) to provide the *Static() initialization functions of CmdProcessor, EventHub, GuardedTask, PipeAndFilter, UARTTransceiver and I2CTransceiver, which create their FreeRTOS objects in storage given by the caller, and to keep the logging task and semaphores in static memory. Requires configSUPPORT_STATIC_ALLOCATION. With configSUPPORT_DYNAMIC_ALLOCATION 0 the heap based functions are left out. */
+#define KISO_UTILS_STATIC_ALLOCATION 0
+#endif
+
 // clang-format on
 
 #endif /* KISO_UTILSCONFIG_H_ */
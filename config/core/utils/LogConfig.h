@@ -28,23 +28,37 @@
 /* Enable/Disable recorders */
 #define KISO_SYNC_RECORDER 1
 #define KISO_ASYNC_RECORDER 0
+/* Records raw arguments instead of text, decoded on the host by core/utils/tools/log_decoder.py */
+#define KISO_BINARY_RECORDER 0
 
 /* Enable /Disable appenders */
 #define KISO_UART_APPENDER 1
+/* Sends batches of log lines from two alternating buffers without blocking, instead of KISO_UART_APPENDER */
+#define KISO_UART_DMA_APPENDER 0
+/* Keeps the latest log output in RAM across warm resets, needs a .noinit section in the linker script */
+#define KISO_RAM_APPENDER 0
+/* Maximum number of appenders used at the same time, see Logging_AddAppender() */
+#define LOG_APPENDER_COUNT (UINT8_C(2))
 
 /* Filter configuration */
-/* Number of allowed filters >=1 */
+/* Number of allowed filters, 1 to 31, each takes 2x128 bytes of double-buffered lookup table */
 #define LOG_FILTER_ITEM_COUNT (UINT8_C(1))
 /* Default log level for package and module */
 #define LOG_LEVEL_PACKAGE_DEFAULT (LOG_LEVEL_DEBUG)
 #define LOG_LEVEL_MODULE_DEFAULT (LOG_LEVEL_DEBUG)
 
+/* Limits the messages per call site, the suppressed ones are counted in a later message */
+#define KISO_LOG_RATE_LIMIT 0
+
 /* Configuration for the asynchronous-recorder (if activated) */
 #if KISO_ASYNC_RECORDER == 1
+/* Maximum length of a log line, also the size of a queue slot */
 #define LOG_BUFFER_SIZE (UINT16_C(256))
+/* Queue memory, LOG_QUEUE_BUFFER_SIZE / LOG_BUFFER_SIZE must be a power of two */
 #define LOG_QUEUE_BUFFER_SIZE (UINT16_C(2048))
 #define LOG_TASK_STACK_SIZE (UINT16_C(256))
-#define LOG_TASK_PRIORITY (UINT8_C(4))
+/* The logging task should run below the tasks which log */
+#define LOG_TASK_PRIORITY (UINT8_C(1))
 
 #define LOG_SYS_CLOCK_DELAY (10)
 #define LOG_APPENDER_TIMEOUT (50)
@@ -57,4 +71,38 @@
 
 #endif
 
+/* Configuration for the rate limit (if activated) */
+#if KISO_LOG_RATE_LIMIT == 1
+/* Number of call sites tracked at once, a power of two */
+#define LOG_RATE_LIMIT_SLOTS (UINT8_C(16))
+/* Length of a window in ms */
+#define LOG_RATE_LIMIT_WINDOW (UINT32_C(1000))
+/* Messages a call site may log per window, 0 for no limit */
+#define LOG_RATE_LIMIT_BUDGET_FATAL (UINT16_C(0))
+#define LOG_RATE_LIMIT_BUDGET_ERROR (UINT16_C(10))
+#define LOG_RATE_LIMIT_BUDGET_WARNING (UINT16_C(5))
+#define LOG_RATE_LIMIT_BUDGET_INFO (UINT16_C(5))
+#define LOG_RATE_LIMIT_BUDGET_DEBUG (UINT16_C(5))
+#endif
+
+/* Configuration for the UART-DMA-appender (if activated) */
+#if KISO_UART_DMA_APPENDER == 1
+/* Size of each of the two buffers, the largest batch sent at once */
+#define LOG_UART_DMA_BUFFER_SIZE (UINT16_C(512))
+/* Time in ms after which a buffer which is not full is sent */
+#define LOG_UART_DMA_FLUSH_TIMEOUT (UINT32_C(20))
+#endif
+
+/* Configuration for the RAM-appender (if activated) */
+#if KISO_RAM_APPENDER == 1
+/* Size of the ring buffer, a power of two */
+#define LOG_RAM_APPENDER_SIZE (UINT16_C(2048))
+#endif
+
+/* Configuration for the binary-recorder (if activated) */
+#if KISO_BINARY_RECORDER == 1
+/* Maximum length of a record, longer argument lists are cut */
+#define LOG_BINARY_RECORD_SIZE (UINT16_C(96))
+#endif
+
 #endif /* LOG_CONFIG_H */
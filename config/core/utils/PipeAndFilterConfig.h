@@ -16,7 +16,8 @@
 #define CONFIG_PIPEANDFILTERCFG_H_
 
 #define PIPE_SIZE 100         /**< Size of the internal buffer used by the pipe */
-#define FILTER_STACK_SIZE 500 /**< Should be higher than 3*PIPE_SIZE */
+#define FILTER_STACK_SIZE 500 /**< Should be higher than 3*PIPE_SIZE, unless only buffer pipes are used */
 #define FILTER_PRIORITY 1     /**< Priority of the pipe & filter construction in an RTOS context */
+#define BUFFER_PIPE_DEPTH 4   /**< Number of buffers a buffer pipe holds */
 
 #endif /* CONFIG_PIPEANDFILTERCFG_H_ */
@@ -43,7 +43,7 @@
 #include "Kiso_Logging.h"
 
 /**
- * @brief Number of bytes per chunk with which we read the receive buffer
+ * @brief Maximum number of bytes per chunk with which we parse the receive buffer
  */
 #define CELLULAR_RX_READ_BUFFER_SIZE (UINT32_C(128))
 
@@ -65,11 +65,18 @@
  */
 static Retcode_T SkipEventsUntilCommand(void);
 
+#if KISO_UTILS_TASK_NOTIFICATIONS
+/* The response parser task is notified directly when rx data is ready */
+
+static TaskHandle_t CellularDriver_TxWaitingTask = NULL; //!< Task waiting for the tx data to be sent
+static bool CellularDriver_TxDone = false;               //!< Set when the tx data is sent, until the waiting task sees it
+#else
 static StaticSemaphore_t AtResponseParser_RxWakeupBuffer;        //!< Semaphore storage for rx data ready signalling
 static SemaphoreHandle_t AtResponseParser_RxWakeupHandle = NULL; //!< Handle for rx data ready semaphore
 
 static StaticSemaphore_t CellularDriver_TxWakeupBuffer;        //!< Semaphore storage for tx data sent signalling
 static SemaphoreHandle_t CellularDriver_TxWakeupHandle = NULL; //!< Handle for tx data sent semaphore
+#endif
 
 static StaticTask_t AtResponseParser_TaskBuffer;                              //!< static task allocation for Response parser task
 static StackType_t AtResponseParser_TaskStack[CELLULAR_RESP_TASK_STACK_SIZE]; //!< Stack allocation for response parser
@@ -97,6 +104,30 @@ static uint8_t UartRxByte;                                //!< single byte rx bu
 
 char Engine_AtSendBuffer[CELLULAR_AT_SEND_BUFFER_SIZE]; //!< At engine TX buffer
 
+#if KISO_UTILS_TASK_NOTIFICATIONS
+/* Waits for the tx data to be sent. Other notifications of the task only make it look at the flag again. */
+static bool CellularDriver_WaitTxDone(TickType_t ticksToWait)
+{
+    TimeOut_t timeOut;
+    bool isDone;
+
+    vTaskSetTimeOutState(&timeOut);
+    __atomic_store_n(&CellularDriver_TxWaitingTask, xTaskGetCurrentTaskHandle(), __ATOMIC_SEQ_CST);
+    for (;;)
+    {
+        isDone = __atomic_exchange_n(&CellularDriver_TxDone, false, __ATOMIC_SEQ_CST);
+        if (isDone || (pdTRUE == xTaskCheckForTimeOut(&timeOut, &ticksToWait))) //LCOV_EXCL_BR_LINE
+        {
+            break;
+        }
+        (void)xTaskNotifyWait(0UL, 0UL, NULL, ticksToWait); //LCOV_EXCL_BR_LINE
+    }
+    __atomic_store_n(&CellularDriver_TxWaitingTask, NULL, __ATOMIC_SEQ_CST);
+
+    return isDone;
+}
+#endif
+
 static void HandleMcuIsrCallback(UART_T uart, struct MCU_UART_Event_S event)
 {
     KISO_UNUSED(uart);
@@ -104,9 +135,19 @@ static void HandleMcuIsrCallback(UART_T uart, struct MCU_UART_Event_S event)
 
     if (event.TxComplete)
     {
-        /* all bytes have been transmitted, signal semaphore */
         BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+#if KISO_UTILS_TASK_NOTIFICATIONS
+        /* all bytes have been transmitted, wake the sender without touching its notification value */
+        __atomic_store_n(&CellularDriver_TxDone, true, __ATOMIC_SEQ_CST);
+        TaskHandle_t waitingTask = __atomic_load_n(&CellularDriver_TxWaitingTask, __ATOMIC_SEQ_CST);
+        if (NULL != waitingTask)
+        {
+            (void)xTaskNotifyFromISR(waitingTask, 0UL, eNoAction, &xHigherPriorityTaskWoken); //LCOV_EXCL_BR_LINE
+        }
+#else
+        /* all bytes have been transmitted, signal semaphore */
         (void)xSemaphoreGiveFromISR(CellularDriver_TxWakeupHandle, &xHigherPriorityTaskWoken); //LCOV_EXCL_BR_LINE
+#endif
         portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
     }
 
@@ -123,7 +164,15 @@ static void HandleMcuIsrCallback(UART_T uart, struct MCU_UART_Event_S event)
         {
             //-- Wake up task to trigger AT command response parser
             BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+#if KISO_UTILS_TASK_NOTIFICATIONS
+            /* Data which arrives before the task exists is parsed after the next line end */
+            if (NULL != AtResponseParser_TaskHandle)
+            {
+                (void)xTaskNotifyFromISR(AtResponseParser_TaskHandle, 0UL, eIncrement, &xHigherPriorityTaskWoken); //LCOV_EXCL_BR_LINE
+            }
+#else
             (void)xSemaphoreGiveFromISR(AtResponseParser_RxWakeupHandle, &xHigherPriorityTaskWoken); //LCOV_EXCL_BR_LINE
+#endif
             portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
         }
     }
@@ -167,10 +216,14 @@ static void AtResponseParser_TaskLoop(void)
 
     uint32_t bytesRead, flukeFreeBytesRead;
     const uint8_t *flukeRxReadBuffer;
-    uint8_t rxReadBuffer[CELLULAR_RX_READ_BUFFER_SIZE];
+    RingBuffer_Region_T rxRegions[RINGBUFFER_REGION_COUNT];
 
     // wait for the RX IRQ to wake us up
+#if KISO_UTILS_TASK_NOTIFICATIONS
+    (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY); //LCOV_EXCL_BR_LINE
+#else
     (void)xSemaphoreTake(AtResponseParser_RxWakeupHandle, portMAX_DELAY); //LCOV_EXCL_BR_LINE
+#endif
 
     while (1)
     {
@@ -181,18 +234,19 @@ static void AtResponseParser_TaskLoop(void)
          */
         vTaskDelay(50);
 #endif
-        bytesRead = RingBuffer_Read(&UartRxBufDescr, rxReadBuffer, sizeof(rxReadBuffer)); //LCOV_EXCL_BR_LINE
-        if ((UINT32_C(0) == bytesRead))
+        /* Parse the received data in place, the ring-buffer region is only released afterwards */
+        if (UINT32_C(0) == RingBuffer_Peek(&UartRxBufDescr, rxRegions)) //LCOV_EXCL_BR_LINE
         {
             break;
         }
+        bytesRead = (rxRegions[0].Length < CELLULAR_RX_READ_BUFFER_SIZE) ? rxRegions[0].Length : CELLULAR_RX_READ_BUFFER_SIZE;
         if (IsFlukeFilterEnabled)
         {
-            flukeRxReadBuffer = Utils_TrimFlukeCharacters(rxReadBuffer, bytesRead, &flukeFreeBytesRead); //LCOV_EXCL_BR_LINE
+            flukeRxReadBuffer = Utils_TrimFlukeCharacters(rxRegions[0].Data, bytesRead, &flukeFreeBytesRead); //LCOV_EXCL_BR_LINE
         }
         else
         {
-            flukeRxReadBuffer = rxReadBuffer;
+            flukeRxReadBuffer = rxRegions[0].Data;
             flukeFreeBytesRead = bytesRead;
         }
 #if CELLULAR_ENABLE_TRACING
@@ -204,6 +258,7 @@ static void AtResponseParser_TaskLoop(void)
         }
 #endif
         (void)AtResponseParser_Parse(flukeRxReadBuffer, flukeFreeBytesRead); //LCOV_EXCL_BR_LINE
+        (void)RingBuffer_Consume(&UartRxBufDescr, bytesRead);                 //LCOV_EXCL_BR_LINE
     }
 }
 
@@ -312,11 +367,16 @@ Retcode_T Engine_Initialize(Cellular_StateChanged_T onStateChanged)
     RingBuffer_Initialize(&UartRxBufDescr, UartRxReadBuffer, sizeof(UartRxReadBuffer));
 
     // 2. Setup RX/TX signaling
+#if KISO_UTILS_TASK_NOTIFICATIONS
+    CellularDriver_TxWaitingTask = NULL;
+    CellularDriver_TxDone = false;
+#else
     AtResponseParser_RxWakeupHandle = xSemaphoreCreateBinaryStatic(&AtResponseParser_RxWakeupBuffer);
     assert(NULL != AtResponseParser_RxWakeupHandle); /* due to static allocation */
 
     CellularDriver_TxWakeupHandle = xSemaphoreCreateBinaryStatic(&CellularDriver_TxWakeupBuffer);
     assert(NULL != CellularDriver_TxWakeupHandle); /* due to static allocation */
+#endif
 
     // 3. Setup the hardware using the BSP
     status = Hardware_Initialize(HandleMcuIsrCallback, &UartRxByte);
@@ -374,8 +434,12 @@ Retcode_T Engine_SendAtCommand(const uint8_t *buffer, uint32_t bufferLength)
         return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_UNINITIALIZED);
     }
 
-    /* ensure the semaphore is NOT signaled as we begin to send */
+    /* ensure the end of transfer is NOT signaled as we begin to send */
+#if KISO_UTILS_TASK_NOTIFICATIONS
+    __atomic_store_n(&CellularDriver_TxDone, false, __ATOMIC_SEQ_CST);
+#else
     (void)xSemaphoreTake(CellularDriver_TxWakeupHandle, 0); //LCOV_EXCL_BR_LINE
+#endif
 
     ret = MCU_UART_Send(CellularSerialDevice, (const uint8_t *)buffer, bufferLength); //LCOV_EXCL_BR_LINE
     if (RETCODE_OK != ret)
@@ -384,8 +448,12 @@ Retcode_T Engine_SendAtCommand(const uint8_t *buffer, uint32_t bufferLength)
     }
 
     /* wait the end of serial transfer */
+#if KISO_UTILS_TASK_NOTIFICATIONS
+    if (!CellularDriver_WaitTxDone(CELLULAR_SEND_AT_COMMAND_WAIT_TIME))
+#else
     BaseType_t result = xSemaphoreTake(CellularDriver_TxWakeupHandle, CELLULAR_SEND_AT_COMMAND_WAIT_TIME); //LCOV_EXCL_BR_LINE
     if (pdPASS != result)
+#endif
     {
         return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SEMAPHORE_ERROR);
     }
@@ -470,10 +538,15 @@ Retcode_T Engine_Deinitialize(void)
 {
     Retcode_T ret = RETCODE_OK;
 
+#if KISO_UTILS_TASK_NOTIFICATIONS
+    assert(NULL != CellularDriver_RequestLock &&
+           NULL != OnStateChanged);
+#else
     assert(NULL != CellularDriver_RequestLock &&
            NULL != AtResponseParser_RxWakeupHandle &&
            NULL != CellularDriver_TxWakeupHandle &&
            NULL != OnStateChanged);
+#endif
 
     vSemaphoreDelete(CellularDriver_RequestLock);
     CellularDriver_RequestLock = NULL;
@@ -501,11 +574,13 @@ Retcode_T Engine_Deinitialize(void)
 
     CellularSerialDevice = (UART_T)0;
 
+#if !KISO_UTILS_TASK_NOTIFICATIONS
     vSemaphoreDelete(AtResponseParser_RxWakeupHandle);
     AtResponseParser_RxWakeupHandle = NULL;
 
     vSemaphoreDelete(CellularDriver_TxWakeupHandle);
     CellularDriver_TxWakeupHandle = NULL;
+#endif
 
     OnStateChanged = NULL;
 
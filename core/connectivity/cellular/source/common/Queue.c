@@ -48,18 +48,11 @@ Retcode_T Queue_Create(Queue_T *Queue, uint8_t *Buffer, uint32_t BufferSize)
     Queue->Count = 0;
     Queue->Last = NULL;
 
-    Queue->Lock = xSemaphoreCreateMutex();
-    if (NULL == Queue->Lock)
-    {
-        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_OUT_OF_RESOURCES);
-    }
+    Queue->Lock = xSemaphoreCreateMutexStatic(&Queue->LockBuffer);
+    assert(NULL != Queue->Lock); /* due to static allocation */
 
-    Queue->Wakeup = xSemaphoreCreateBinary();
-    if (NULL == Queue->Wakeup)
-    {
-        vSemaphoreDelete(Queue->Lock);
-        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_OUT_OF_RESOURCES);
-    }
+    Queue->Wakeup = xSemaphoreCreateBinaryStatic(&Queue->WakeupBuffer);
+    assert(NULL != Queue->Wakeup); /* due to static allocation */
 
     return RETCODE_OK;
 }
@@ -128,6 +128,8 @@ typedef struct
     QueueItem_T *Last;
     SemaphoreHandle_t Lock;
     SemaphoreHandle_t Wakeup;
+    StaticSemaphore_t LockBuffer;
+    StaticSemaphore_t WakeupBuffer;
 } Queue_T;
 
 /**
@@ -137,9 +139,11 @@ typedef struct
  * @param[in] Buffer        The buffer to be used for storing queue items (must not be equal to NULL).
  * @param[in] BufferSize    The size of provided buffer (must not be equal to zero).
  *
+ * @note The semaphores (Lock and Wakeup, see #Queue_T) are created in the queue structure itself,
+ * the queue does not allocate from the FreeRTOS heap.
+ *
  * @retval #RETCODE_OK               If the queue was successfully initialized
  * @retval #RETCODE_INVALID_PARAM    If one of the parameters is invalid (NULL pointer or 0 as Buffer Size)
- * @retval #RETCODE_OUT_OF_RESOURCES If the Queue associated semaphores (Lock and Wakeup, see #Queue_T) can't be created
  */
 Retcode_T Queue_Create(Queue_T *Queue, uint8_t *Buffer, uint32_t BufferSize);
 
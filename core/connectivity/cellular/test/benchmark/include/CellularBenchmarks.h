@@ -0,0 +1,28 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ * @brief
+ *      Benchmark suites of the cellular package, see Benchmark.h
+ *
+ * @file
+ */
+
+#ifndef CELLULARBENCHMARKS_H_
+#define CELLULARBENCHMARKS_H_
+
+/** AtResponseParser: AtResponseParser_Parse() on whole responses and byte by byte */
+void AtResponseParser_Benchmark(void);
+
+#endif /* CELLULARBENCHMARKS_H_ */
@@ -0,0 +1,99 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ * @brief
+ *      Benchmarks of the AT response parser
+ *
+ * @details
+ *      Parses a typical mix of command echo, information text, URC and final response code, once
+ *      in one call and once byte by byte as received from the UART.
+ *
+ * @file
+ **/
+
+#include "Kiso_CellularModules.h"
+
+#include "AtResponseParser.h"
+
+#include "Benchmark.h"
+#include "CellularBenchmarks.h"
+
+#include "Kiso_Basics.h"
+
+#include <string.h>
+
+static uint32_t ParsedEvents;
+
+static const char Response[] =
+    "AT+CGMR\r\r\n"
+    "L0.0.00.00.05.06 [Feb 03 2018 13:00:41]\r\n"
+    "\r\nOK\r\n"
+    "AT+CREG?\r\r\n"
+    "+CREG: 2,5,\"00D2\",\"0000A3B1\",7\r\n"
+    "\r\nOK\r\n"
+    "AT+UPSD=0,1,\"internet\"\r\r\n"
+    "\r\nERROR\r\n";
+
+static void CountData(const uint8_t *data, uint32_t length)
+{
+    KISO_UNUSED(data);
+    ParsedEvents += length;
+}
+
+static void CountResponseCode(AtResponseCode_T code)
+{
+    ParsedEvents += (uint32_t)code;
+}
+
+static void CountError(void)
+{
+    ParsedEvents++;
+}
+
+static void Run_Parse(void *param, uint32_t iterations)
+{
+    uint32_t chunkLength = *(const uint32_t *)param;
+    uint32_t length = (uint32_t)strlen(Response);
+
+    ParsedEvents = 0U;
+    AtResponseParser_Reset();
+    for (uint32_t i = 0U; i < iterations; i++)
+    {
+        for (uint32_t offset = 0U; offset < length; offset += chunkLength)
+        {
+            uint32_t chunk = ((length - offset) < chunkLength) ? (length - offset) : chunkLength;
+            (void)AtResponseParser_Parse((const uint8_t *)&Response[offset], chunk);
+        }
+    }
+    Benchmark_Keep(ParsedEvents);
+}
+
+/*  The description of the function is available in CellularBenchmarks.h */
+void AtResponseParser_Benchmark(void)
+{
+    static uint32_t whole = UINT32_MAX;
+    static uint32_t byte = 1U;
+    uint32_t length = (uint32_t)strlen(Response);
+
+    AtResponseParser_RegisterCmdEchoCallback(CountData);
+    AtResponseParser_RegisterCmdCallback(CountData);
+    AtResponseParser_RegisterCmdArgCallback(CountData);
+    AtResponseParser_RegisterMiscCallback(CountData);
+    AtResponseParser_RegisterResponseCodeCallback(CountResponseCode);
+    AtResponseParser_RegisterErrorCallback(CountError);
+
+    Benchmark_Run("Cellular/AtResponseParser_Parse/Whole", Run_Parse, &whole, length);
+    Benchmark_Run("Cellular/AtResponseParser_Parse/ByteByByte", Run_Parse, &byte, length);
+}
@@ -0,0 +1,49 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ * @brief
+ *      Runs the benchmarks of the cellular package, see Benchmark.h for the command line.
+ *
+ * @details
+ *      The parser is benchmarked without a scheduler, so the FreeRTOS critical section it uses
+ *      is replaced by nothing.
+ *
+ * @file
+ **/
+
+#include "Benchmark.h"
+#include "CellularBenchmarks.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+static const Benchmark_Suite_T Suites[] = {
+    AtResponseParser_Benchmark,
+};
+
+/* Replaces the FreeRTOS port, there is no scheduler while benchmarking */
+void vPortEnterCritical(void)
+{
+}
+
+/* Replaces the FreeRTOS port, there is no scheduler while benchmarking */
+void vPortExitCritical(void)
+{
+}
+
+int main(int argc, char *argv[])
+{
+    return Benchmark_Main(argc, argv, Suites, (uint32_t)(sizeof(Suites) / sizeof(Suites[0])));
+}
@@ -0,0 +1,244 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+#include <gtest.h>
+
+#include <array>
+
+FFF_DEFINITION_BLOCK_START
+
+extern "C"
+{
+/* Setup compile time configuration defines */
+#define KISO_UTILS_TASK_NOTIFICATIONS 1
+
+#include "Kiso_CellularModules.h"
+#undef KISO_MODULE_ID
+#define KISO_MODULE_ID KISO_CELLULAR_MODULE_ID_ENGINE
+
+#include "AtResponseParser_th.hh"
+#include "AtResponseQueue_th.hh"
+
+#include "AtUtils_th.hh"
+#include "AtUrc_th.hh"
+#include "Hardware_th.hh"
+#include "Kiso_MCU_UART_th.hh"
+
+#include "Kiso_Retcode_th.hh"
+#include "Kiso_Assert_th.hh"
+#include "Kiso_RingBuffer_th.hh"
+#include "Kiso_Logging_th.hh"
+#undef LOG_DEBUG
+#define LOG_DEBUG(...) \
+    do                 \
+    {                  \
+    } while (0)
+
+#include "FreeRTOS_th.hh"
+#include "task_th.hh"
+#include "semphr_th.hh"
+#include "portmacro_th.hh"
+
+#undef KISO_MODULE_ID
+#include "Engine.c"
+}
+
+FFF_DEFINITION_BLOCK_END
+
+static SemaphoreHandle_t Custom_xSemaphoreCreateMutexStatic(StaticSemaphore_t *staticSemphr)
+{
+    return (SemaphoreHandle_t)staticSemphr;
+}
+
+static TaskHandle_t Custom_xTaskCreateStatic(TaskFunction_t fun, const char *, uint32_t, void *, UBaseType_t, StackType_t *, StaticTask_t *)
+{
+    return (TaskHandle_t)fun;
+}
+static TaskHandle_t const CurrentTask = (TaskHandle_t)0x42;
+
+/* Event of the UART ISR while the task waits, and at which wake-up, 0 for never */
+static struct MCU_UART_Event_S EventAtWait;
+static uint32_t EventAtWaitCount = 0;
+
+static BaseType_t FakeTaskNotifyWait(uint32_t bitsToClearOnEntry, uint32_t bitsToClearOnExit, uint32_t *value, TickType_t ticksToWait)
+{
+    KISO_UNUSED(bitsToClearOnEntry);
+    KISO_UNUSED(bitsToClearOnExit);
+    KISO_UNUSED(value);
+    KISO_UNUSED(ticksToWait);
+    if (EventAtWaitCount == xTaskNotifyWait_fake.call_count)
+    {
+        HandleMcuIsrCallback((UART_T)123, EventAtWait);
+    }
+    return pdTRUE;
+}
+
+class TS_Engine_TaskNotify : public testing::Test
+{
+protected:
+    uint8_t Buffer[16];
+
+    virtual void SetUp()
+    {
+        FFF_RESET_HISTORY();
+
+        RESET_FAKE(xSemaphoreCreateBinaryStatic);
+        RESET_FAKE(xSemaphoreTake);
+        RESET_FAKE(MCU_UART_Send);
+        RESET_FAKE(AtResponseQueue_GetEvent);
+        RESET_FAKE(Urc_HandleResponses);
+        RESET_FAKE(RingBuffer_Write);
+        RESET_FAKE(xTaskGetCurrentTaskHandle);
+        RESET_FAKE(vTaskSetTimeOutState);
+        RESET_FAKE(xTaskCheckForTimeOut);
+        RESET_FAKE(xTaskNotifyWait);
+        RESET_FAKE(xTaskNotifyFromISR);
+        RESET_FAKE(ulTaskNotifyTake);
+
+        CellularSerialDevice = (UART_T)123;
+        CellularDriver_TxWaitingTask = NULL;
+        CellularDriver_TxDone = false;
+        AtResponseParser_TaskHandle = NULL;
+
+        memset(&EventAtWait, 0, sizeof(EventAtWait));
+        EventAtWaitCount = 0;
+        RingBuffer_Write_fake.return_val = 1U;
+        xTaskGetCurrentTaskHandle_fake.return_val = CurrentTask;
+        xTaskNotifyWait_fake.custom_fake = FakeTaskNotifyWait;
+    }
+};
+
+TEST_F(TS_Engine_TaskNotify, SendWakesWaitingTask)
+{
+    /* Other notifications of the task come first */
+    EventAtWait.TxComplete = 1;
+    EventAtWaitCount = 2;
+
+    Retcode_T rc = Engine_SendAtCommand(Buffer, sizeof(Buffer));
+
+    EXPECT_EQ(RETCODE_OK, rc);
+    EXPECT_EQ(0U, xSemaphoreTake_fake.call_count);
+    EXPECT_EQ(1U, MCU_UART_Send_fake.call_count);
+    EXPECT_EQ(2U, xTaskNotifyWait_fake.call_count);
+    EXPECT_EQ(1U, xTaskNotifyFromISR_fake.call_count);
+    EXPECT_EQ(CurrentTask, xTaskNotifyFromISR_fake.arg0_val);
+    EXPECT_EQ(eNoAction, xTaskNotifyFromISR_fake.arg2_val);
+    EXPECT_EQ(NULL, CellularDriver_TxWaitingTask);
+    EXPECT_FALSE(CellularDriver_TxDone);
+    EXPECT_EQ(1U, AtResponseQueue_GetEvent_fake.call_count);
+    EXPECT_EQ(1U, Urc_HandleResponses_fake.call_count);
+}
+
+TEST_F(TS_Engine_TaskNotify, SendIgnoresEarlierTxComplete)
+{
+    BaseType_t timeOut[] = {pdFALSE, pdTRUE};
+    SET_RETURN_SEQ(xTaskCheckForTimeOut, timeOut, 2);
+    CellularDriver_TxDone = true;
+
+    Retcode_T rc = Engine_SendAtCommand(Buffer, sizeof(Buffer));
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SEMAPHORE_ERROR), rc);
+    EXPECT_EQ(1U, xTaskNotifyWait_fake.call_count);
+    EXPECT_EQ(NULL, CellularDriver_TxWaitingTask);
+    EXPECT_EQ(0U, AtResponseQueue_GetEvent_fake.call_count);
+}
+
+TEST_F(TS_Engine_TaskNotify, SendFailureDoesNotWait)
+{
+    MCU_UART_Send_fake.return_val = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_FAILURE);
+
+    Retcode_T rc = Engine_SendAtCommand(Buffer, sizeof(Buffer));
+
+    EXPECT_EQ(MCU_UART_Send_fake.return_val, rc);
+    EXPECT_EQ(0U, vTaskSetTimeOutState_fake.call_count);
+    EXPECT_EQ(0U, xTaskNotifyWait_fake.call_count);
+}
+
+TEST_F(TS_Engine_TaskNotify, TxCompleteWithoutWaiterIsKept)
+{
+    struct MCU_UART_Event_S event;
+    memset(&event, 0, sizeof(event));
+    event.TxComplete = 1;
+
+    HandleMcuIsrCallback((UART_T)123, event);
+
+    EXPECT_TRUE(CellularDriver_TxDone);
+    EXPECT_EQ(0U, xTaskNotifyFromISR_fake.call_count);
+}
+
+TEST_F(TS_Engine_TaskNotify, LineEndNotifiesResponseParser)
+{
+    struct MCU_UART_Event_S event;
+    memset(&event, 0, sizeof(event));
+    event.RxComplete = 1;
+    AtResponseParser_TaskHandle = (TaskHandle_t)AtResponseParser_Task;
+
+    UartRxByte = 'A';
+    HandleMcuIsrCallback((UART_T)123, event);
+    EXPECT_EQ(0U, xTaskNotifyFromISR_fake.call_count);
+
+    UartRxByte = AT_DEFAULT_S4_CHARACTER;
+    HandleMcuIsrCallback((UART_T)123, event);
+    EXPECT_EQ(2U, RingBuffer_Write_fake.call_count);
+    EXPECT_EQ(1U, xTaskNotifyFromISR_fake.call_count);
+    EXPECT_EQ(AtResponseParser_TaskHandle, xTaskNotifyFromISR_fake.arg0_val);
+    EXPECT_EQ(eIncrement, xTaskNotifyFromISR_fake.arg2_val);
+}
+
+TEST_F(TS_Engine_TaskNotify, LineEndBeforeTaskExists)
+{
+    struct MCU_UART_Event_S event;
+    memset(&event, 0, sizeof(event));
+    event.RxComplete = 1;
+    UartRxByte = AT_DEFAULT_S4_CHARACTER;
+
+    HandleMcuIsrCallback((UART_T)123, event);
+
+    EXPECT_EQ(1U, RingBuffer_Write_fake.call_count);
+    EXPECT_EQ(0U, xTaskNotifyFromISR_fake.call_count);
+}
+
+TEST_F(TS_Engine_TaskNotify, ResponseParserWaitsForNotification)
+{
+    RESET_FAKE(RingBuffer_Peek);
+    AtResponseParser_TaskLoop();
+
+    EXPECT_EQ(1U, ulTaskNotifyTake_fake.call_count);
+    EXPECT_EQ(pdTRUE, ulTaskNotifyTake_fake.arg0_val);
+    EXPECT_EQ(portMAX_DELAY, ulTaskNotifyTake_fake.arg1_val);
+    EXPECT_EQ(0U, xSemaphoreTake_fake.call_count);
+}
+
+TEST_F(TS_Engine_TaskNotify, InitializeCreatesNoWakeupSemaphores)
+{
+    RESET_FAKE(RingBuffer_Initialize);
+    RESET_FAKE(Hardware_Initialize);
+    RESET_FAKE(Hardware_GetCommunicationChannel);
+    RESET_FAKE(AtResponseQueue_Init);
+    RESET_FAKE(AtResponseQueue_RegisterWithResponseParser);
+    RESET_FAKE(xSemaphoreCreateMutexStatic);
+    RESET_FAKE(xTaskCreateStatic);
+    xSemaphoreCreateMutexStatic_fake.custom_fake = Custom_xSemaphoreCreateMutexStatic;
+    xTaskCreateStatic_fake.custom_fake = Custom_xTaskCreateStatic;
+    CellularDriver_TxWaitingTask = CurrentTask;
+    CellularDriver_TxDone = true;
+
+    Retcode_T rc = Engine_Initialize((Cellular_StateChanged_T)123);
+
+    EXPECT_EQ(RETCODE_OK, rc);
+    EXPECT_EQ(0U, xSemaphoreCreateBinaryStatic_fake.call_count);
+    EXPECT_EQ(NULL, CellularDriver_TxWaitingTask);
+    EXPECT_FALSE(CellularDriver_TxDone);
+    EXPECT_EQ(RETCODE_OK, Engine_Deinitialize());
+}
@@ -14,6 +14,8 @@
 
 #include <gtest.h>
 
+#include <array>
+
 FFF_DEFINITION_BLOCK_START
 
 extern "C"
@@ -49,8 +51,6 @@ extern "C"
 #include "Engine.c"
 }
 
-#include <array>
-
 FFF_DEFINITION_BLOCK_END
 
 static SemaphoreHandle_t Custom_xSemaphoreCreateBinaryStatic(StaticSemaphore_t *staticSemphr)
@@ -68,6 +68,20 @@ static TaskHandle_t Custom_xTaskCreateStatic(TaskFunction_t fun, const char *, u
     return (TaskHandle_t)fun;
 }
 
+static uint8_t PeekData[] = {'\r', '\n'};
+static uint32_t PeekLengths[2];
+static uint32_t PeekCount;
+
+static uint32_t Custom_RingBuffer_Peek(RingBuffer_T *, RingBuffer_Region_T *regions)
+{
+    uint32_t length = (PeekCount < 2U) ? PeekLengths[PeekCount++] : 0U;
+    regions[0].Data = PeekData;
+    regions[0].Length = length;
+    regions[1].Data = PeekData;
+    regions[1].Length = 0U;
+    return length;
+}
+
 class TS_Engine_Tasks : public testing::Test
 {
 protected:
@@ -77,7 +91,14 @@ protected:
 
         FFF_RESET_HISTORY();
 
-        RESET_FAKE(RingBuffer_Read);
+        RESET_FAKE(RingBuffer_Peek);
+        RESET_FAKE(RingBuffer_Consume);
+        RESET_FAKE(AtResponseParser_Parse);
+
+        RingBuffer_Peek_fake.custom_fake = Custom_RingBuffer_Peek;
+        PeekLengths[0] = 0U;
+        PeekLengths[1] = 0U;
+        PeekCount = 0U;
 
         IsFlukeFilterEnabled = false;
     }
@@ -85,23 +106,40 @@ protected:
 
 TEST_F(TS_Engine_Tasks, ReadData_ZeroLength)
 {
-    RingBuffer_Read_fake.return_val = 0;
     AtResponseParser_TaskLoop();
+
+    EXPECT_EQ(0U, AtResponseParser_Parse_fake.call_count);
+    EXPECT_EQ(0U, RingBuffer_Consume_fake.call_count);
 }
 
 TEST_F(TS_Engine_Tasks, ReadData_OneByte)
 {
-    uint32_t readReturns[2] = {1, 0};
-    SET_RETURN_SEQ(RingBuffer_Read, readReturns, 2);
+    PeekLengths[0] = 1U;
     AtResponseParser_TaskLoop();
+
+    EXPECT_EQ(1U, AtResponseParser_Parse_fake.call_count);
+    EXPECT_EQ(PeekData, AtResponseParser_Parse_fake.arg0_val);
+    EXPECT_EQ(1U, RingBuffer_Consume_fake.call_count);
+    EXPECT_EQ(1U, RingBuffer_Consume_fake.arg1_val);
 }
 
 TEST_F(TS_Engine_Tasks, ReadData_OneByteFlukeFilter)
 {
-    uint32_t readReturns[2] = {1, 0};
-    SET_RETURN_SEQ(RingBuffer_Read, readReturns, 2);
+    PeekLengths[0] = 1U;
     IsFlukeFilterEnabled = true;
     AtResponseParser_TaskLoop();
+
+    EXPECT_EQ(1U, RingBuffer_Consume_fake.call_count);
+    EXPECT_EQ(1U, RingBuffer_Consume_fake.arg1_val);
+}
+
+TEST_F(TS_Engine_Tasks, ReadData_ChunkLimit)
+{
+    PeekLengths[0] = CELLULAR_RX_READ_BUFFER_SIZE + 1U;
+    AtResponseParser_TaskLoop();
+
+    EXPECT_EQ(1U, RingBuffer_Consume_fake.call_count);
+    EXPECT_EQ(CELLULAR_RX_READ_BUFFER_SIZE, RingBuffer_Consume_fake.arg1_val);
 }
 
 class TS_Engine_Initialize : public testing::Test
@@ -341,7 +379,7 @@ protected:
 TEST_F(TS_Engine_SendAtCommand, Success)
 {
     Retcode_T rc = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_FAILURE);
-    uint8_t buffer[128];
+    uint8_t buffer[128] = {0};
 
     rc = Engine_SendAtCommand(buffer, sizeof(buffer));
 
@@ -374,7 +412,7 @@ TEST_F(TS_Engine_SendAtCommand, BufferNull_Failure)
 TEST_F(TS_Engine_SendAtCommand, ComDeviceNonInit_Failure)
 {
     Retcode_T rc = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_FAILURE);
-    uint8_t buffer[128];
+    uint8_t buffer[128] = {0};
     CellularSerialDevice = (UART_T)0;
 
     rc = Engine_SendAtCommand(buffer, sizeof(buffer));
@@ -389,7 +427,7 @@ TEST_F(TS_Engine_SendAtCommand, ComDeviceNonInit_Failure)
 TEST_F(TS_Engine_SendAtCommand, Send_Failure)
 {
     Retcode_T rc = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_FAILURE);
-    uint8_t buffer[128];
+    uint8_t buffer[128] = {0};
 
     MCU_UART_Send_fake.return_val = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_FAILURE);
 
@@ -409,7 +447,7 @@ TEST_F(TS_Engine_SendAtCommand, Send_Failure)
 TEST_F(TS_Engine_SendAtCommand, TimeoutAfterSend_Failure)
 {
     Retcode_T rc = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_FAILURE);
-    uint8_t buffer[128];
+    uint8_t buffer[128] = {0};
 
     // TODO: Use takeRetVals in the fixture
     std::array<BaseType_t, 2> retVals = {pdFAIL, pdFAIL};
@@ -466,7 +504,7 @@ protected:
 TEST_F(TS_Engine_SendAtCommandWaitEcho, EchoEnabled_Success)
 {
     Retcode_T rc = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_FAILURE);
-    uint8_t buffer[128];
+    uint8_t buffer[128] = {0};
     size_t footerLen = strlen(ENGINE_ATCMD_FOOTER);
     for (size_t i = 0; i < sizeof(buffer) - 1 - footerLen; ++i)
     {
@@ -499,7 +537,7 @@ TEST_F(TS_Engine_SendAtCommandWaitEcho, EchoEnabled_Success)
 TEST_F(TS_Engine_SendAtCommandWaitEcho, EchoDisabled_Success)
 {
     Retcode_T rc = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_FAILURE);
-    uint8_t buffer[128];
+    uint8_t buffer[128] = {0};
     size_t footerLen = strlen(ENGINE_ATCMD_FOOTER);
     for (size_t i = 0; i < sizeof(buffer) - 1 - footerLen; ++i)
     {
@@ -21,7 +21,10 @@
  * @brief       MCU CRC Peripheral Driver
  *
  * @details     The CRC Peripheral Driver will be initialized internally when particular CRC APIs are called for
- *              calculating CRC.
+ *              calculating CRC. It stays initialized between calls and is only reconfigured when a call needs a
+ *              different polynomial, width or data format; MCU_CRC_Deinitialize() releases it again.
+ *              The peripheral serves one calculation at a time, a call made while another one is running fails
+ *              with #RETCODE_INCONSISTENT_STATE instead of blocking.
  */
 
 #ifndef KISO_MCU_CRC_H
@@ -76,6 +79,16 @@ struct MCU_CRC32_S
     MCU_CRC_DataType_T DataFormat;
 };
 
+/**
+ * @brief       Parameters of an incremental CRC calculation on a byte stream
+ */
+struct MCU_CRC_Stream_S
+{
+    uint8_t Width;       /**< CRC width in bits, 8, 16 or 32 */
+    uint32_t Polynomial; /**< Generating polynomial without its leading term, e.g. 0x04C11DB7 for a 32-bit CRC */
+    bool ReflectInput;   /**< Process each input octet least significant bit first */
+};
+
 /**
  * @brief       Computes the 8-bit CRC value of an 8-bit data buffer
  *
@@ -132,6 +145,37 @@ Retcode_T MCU_CRC16(struct MCU_CRC16_S *initParms, uint16_t *data_in, uint32_t d
  */
 Retcode_T MCU_CRC32(struct MCU_CRC32_S *initParms, uint32_t *data_in, uint32_t dataLength, uint32_t *crc);
 
+/**
+ * @brief       Continues a CRC calculation over a byte stream
+ *
+ * @details     The calculation starts from the CRC register value passed in crc, so a stream can be processed in
+ *              several calls. The register is never reflected on output and no final XOR is applied; this is
+ *              left to the caller.
+ *
+ * @param[in]   stream: Parameters of the calculation.
+ *
+ * @param[in,out] crc: CRC register value to start from, updated register value on return.
+ *
+ * @param[in]   data_in: Pointer to the input data, no alignment required.
+ *
+ * @param[in]   dataLength: Number of bytes in data_in.
+ *
+ * @retval      RETCODE_OK on success.
+ * @retval      RETCODE_NOT_SUPPORTED if the peripheral does not support the requested width.
+ * @retval      RETCODE_INCONSISTENT_STATE if the peripheral is in use by another calculation.
+ * @retval      Another error code otherwise.
+ */
+Retcode_T MCU_CRC_Accumulate(const struct MCU_CRC_Stream_S *stream, uint32_t *crc, const uint8_t *data_in, uint32_t dataLength);
+
+/**
+ * @brief       Deinitializes the CRC peripheral and disables its clock
+ *
+ * @details     The peripheral is initialized again by the next calculation.
+ *
+ * @retval      RETCODE_OK on success, or an error code otherwise.
+ */
+Retcode_T MCU_CRC_Deinitialize(void);
+
 #endif /* KISO_FEATURE_MCU_CRC  */
 #endif /* KISO_MCU_CRC_H */
 /**@} */
@@ -15,6 +15,11 @@
 /**
  * @file
  * @brief Contains the realization of the MCU CRC interface for STM32
+ *
+ * @details The peripheral is initialized on first use and stays initialized (and clocked) until
+ *          MCU_CRC_Deinitialize() is called. It is only reconfigured if a call needs a different
+ *          configuration than the previous one. Concurrent callers are rejected instead of corrupting
+ *          a running calculation.
  */
 
 #include "Kiso_MCU_CRC.h"
@@ -28,176 +33,258 @@
 #undef KISO_MODULE_ID
 #define KISO_MODULE_ID KISO_ESSENTIALS_MODULE_ID_CRC
 
-/** See description in the interface declaration */
-Retcode_T MCU_CRC8(struct MCU_CRC8_S *initParms, uint8_t *data_in, uint32_t dataLength, uint8_t *crc)
+static CRC_HandleTypeDef CrcHandle;
+static bool IsCrcInitialized = false;
+static bool IsCrcBusy = false;
+
+/* Grants exclusive access to the peripheral, without blocking */
+static bool AcquireCrc(void)
+{
+    return !__atomic_exchange_n(&IsCrcBusy, true, __ATOMIC_ACQUIRE);
+}
+
+static void ReleaseCrc(void)
+{
+    __atomic_store_n(&IsCrcBusy, false, __ATOMIC_RELEASE);
+}
+
+/* Initializes the peripheral unless it already runs with the requested configuration */
+static Retcode_T ConfigureCrc(const CRC_InitTypeDef *init, uint32_t inputDataFormat)
 {
     Retcode_T retcode = RETCODE_OK;
 
-    if ((NULL == initParms) || (NULL == data_in) || (NULL == crc))
+    if (!IsCrcInitialized ||
+        (inputDataFormat != CrcHandle.InputDataFormat) ||
+        (init->DefaultPolynomialUse != CrcHandle.Init.DefaultPolynomialUse) ||
+        (init->GeneratingPolynomial != CrcHandle.Init.GeneratingPolynomial) ||
+        (init->CRCLength != CrcHandle.Init.CRCLength) ||
+        (init->InputDataInversionMode != CrcHandle.Init.InputDataInversionMode) ||
+        (init->OutputDataInversionMode != CrcHandle.Init.OutputDataInversionMode))
     {
-        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
-    }
-
-    CRC_HandleTypeDef handle;
+        if (!IsCrcInitialized)
+        {
+            __HAL_RCC_CRC_CLK_ENABLE();
+        }
 
-    handle.Instance = CRC;
-    handle.Init.DefaultPolynomialUse = DEFAULT_POLYNOMIAL_DISABLE;
-    handle.Init.DefaultInitValueUse = DEFAULT_INIT_VALUE_DISABLE;
-    handle.Init.InputDataInversionMode = CRC_INPUTDATA_INVERSION_NONE;
-    handle.Init.OutputDataInversionMode = CRC_OUTPUTDATA_INVERSION_DISABLE;
-    handle.InputDataFormat = CRC_INPUTDATA_FORMAT_BYTES;
-    handle.Init.CRCLength = CRC_POLYLENGTH_8B;
+        CrcHandle.Instance = CRC;
+        CrcHandle.Init = *init;
+        CrcHandle.InputDataFormat = inputDataFormat;
 
-    handle.Init.GeneratingPolynomial = (uint32_t)initParms->GeneratePolynomial;
-    handle.Init.InitValue = (uint32_t)initParms->InitVal;
+        /* CRC module initialization by passing the populated CRC handle */
+        if (HAL_OK == HAL_CRC_Init(&CrcHandle))
+        {
+            IsCrcInitialized = true;
+        }
+        else
+        {
+            /* TODO: Use a more meaningful error code */
+            retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_FAILURE);
+            IsCrcInitialized = false;
+            __HAL_RCC_CRC_CLK_DISABLE();
+        }
+    }
+    return retcode;
+}
 
-    __HAL_RCC_CRC_CLK_ENABLE();
+/* Runs a calculation on the configured peripheral, starting from the given register value */
+static Retcode_T CalculateCrc(const CRC_InitTypeDef *init, uint32_t inputDataFormat, uint32_t initValue, const void *data_in, uint32_t dataLength, uint32_t *crc)
+{
+    Retcode_T retcode;
 
-    /* CRC module initialization by passing the populated CRC handle */
-    if (HAL_OK != HAL_CRC_Init(&handle))
+    if (!AcquireCrc())
     {
-        /* TODO: Use a more meaningful error code */
-        retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_FAILURE);
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INCONSISTENT_STATE);
     }
 
+    retcode = ConfigureCrc(init, inputDataFormat);
     if (RETCODE_OK == retcode)
     {
-        *crc = HAL_CRC_Calculate(&handle, (uint32_t *)data_in, dataLength);
-
-        if (HAL_OK != HAL_CRC_DeInit(&handle))
-        {
-            /* TODO: Use a more meaningful error code */
-            retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_FAILURE);
-        }
+        __HAL_CRC_INITIALCRCVALUE_CONFIG(&CrcHandle, initValue);
+        /* The HAL reads the buffer according to InputDataFormat, the cast only matches its signature */
+        *crc = HAL_CRC_Calculate(&CrcHandle, (uint32_t *)(uintptr_t)data_in, dataLength);
     }
 
-    __HAL_RCC_CRC_CLK_DISABLE();
+    ReleaseCrc();
 
     return retcode;
 }
 
-Retcode_T MCU_CRC16(struct MCU_CRC16_S *initParms, uint16_t *data_in, uint32_t dataLength, uint16_t *crc)
+/** See description in the interface declaration */
+Retcode_T MCU_CRC8(struct MCU_CRC8_S *initParms, uint8_t *data_in, uint32_t dataLength, uint8_t *crc)
 {
-    Retcode_T retcode = RETCODE_OK;
+    Retcode_T retcode;
+    uint32_t result = 0UL;
 
     if ((NULL == initParms) || (NULL == data_in) || (NULL == crc))
     {
         return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
     }
 
-    CRC_HandleTypeDef handle;
+    CRC_InitTypeDef init;
+
+    init.DefaultPolynomialUse = DEFAULT_POLYNOMIAL_DISABLE;
+    init.DefaultInitValueUse = DEFAULT_INIT_VALUE_DISABLE;
+    init.InputDataInversionMode = CRC_INPUTDATA_INVERSION_NONE;
+    init.OutputDataInversionMode = CRC_OUTPUTDATA_INVERSION_DISABLE;
+    init.CRCLength = CRC_POLYLENGTH_8B;
+    init.GeneratingPolynomial = (uint32_t)initParms->GeneratePolynomial;
+    init.InitValue = (uint32_t)initParms->InitVal;
 
-    handle.Instance = CRC;
-    handle.Init.DefaultPolynomialUse = DEFAULT_POLYNOMIAL_DISABLE;
-    handle.Init.DefaultInitValueUse = DEFAULT_INIT_VALUE_DISABLE;
-    handle.Init.InputDataInversionMode = CRC_INPUTDATA_INVERSION_NONE;
-    handle.Init.OutputDataInversionMode = CRC_OUTPUTDATA_INVERSION_DISABLE;
-    handle.InputDataFormat = CRC_INPUTDATA_FORMAT_HALFWORDS;
-    handle.Init.CRCLength = CRC_POLYLENGTH_16B;
+    retcode = CalculateCrc(&init, CRC_INPUTDATA_FORMAT_BYTES, init.InitValue, data_in, dataLength, &result);
+    if (RETCODE_OK == retcode)
+    {
+        *crc = (uint8_t)result;
+    }
 
-    handle.Init.GeneratingPolynomial = (uint32_t)initParms->GeneratePolynomial;
-    handle.Init.InitValue = (uint32_t)initParms->InitVal;
+    return retcode;
+}
 
-    __HAL_RCC_CRC_CLK_ENABLE();
+/** See description in the interface declaration */
+Retcode_T MCU_CRC16(struct MCU_CRC16_S *initParms, uint16_t *data_in, uint32_t dataLength, uint16_t *crc)
+{
+    Retcode_T retcode;
+    uint32_t result = 0UL;
 
-    /* CRC module initialization by passing the populated CRC handle */
-    if (HAL_OK != HAL_CRC_Init(&handle))
+    if ((NULL == initParms) || (NULL == data_in) || (NULL == crc))
     {
-        /* TODO: Use a more meaningful error code */
-        retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_FAILURE);
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
     }
 
+    CRC_InitTypeDef init;
+
+    init.DefaultPolynomialUse = DEFAULT_POLYNOMIAL_DISABLE;
+    init.DefaultInitValueUse = DEFAULT_INIT_VALUE_DISABLE;
+    init.InputDataInversionMode = CRC_INPUTDATA_INVERSION_NONE;
+    init.OutputDataInversionMode = CRC_OUTPUTDATA_INVERSION_DISABLE;
+    init.CRCLength = CRC_POLYLENGTH_16B;
+    init.GeneratingPolynomial = (uint32_t)initParms->GeneratePolynomial;
+    init.InitValue = (uint32_t)initParms->InitVal;
+
+    retcode = CalculateCrc(&init, CRC_INPUTDATA_FORMAT_HALFWORDS, init.InitValue, data_in, dataLength, &result);
     if (RETCODE_OK == retcode)
     {
-        *crc = HAL_CRC_Calculate(&handle, (uint32_t *)data_in, dataLength);
-
-        if (HAL_OK != HAL_CRC_DeInit(&handle))
-        {
-            /* TODO: Use a more meaningful error code */
-            retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_FAILURE);
-        }
+        *crc = (uint16_t)result;
     }
 
-    __HAL_RCC_CRC_CLK_DISABLE();
-
     return retcode;
 }
 
 /** See description in the interface declaration */
 Retcode_T MCU_CRC32(struct MCU_CRC32_S *initParms, uint32_t *data_in, uint32_t dataLength, uint32_t *crc)
 {
-    Retcode_T retcode = RETCODE_OK;
+    uint32_t inputDataFormat;
 
     if ((NULL == initParms) || (NULL == data_in) || (NULL == crc))
     {
         return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
     }
 
-    CRC_HandleTypeDef handle;
+    CRC_InitTypeDef init;
 
-    handle.Instance = CRC;
-    handle.Init.InputDataInversionMode = CRC_INPUTDATA_INVERSION_NONE;
-    handle.Init.OutputDataInversionMode = CRC_OUTPUTDATA_INVERSION_DISABLE;
-    handle.Init.CRCLength = CRC_POLYLENGTH_32B;
+    init.InputDataInversionMode = CRC_INPUTDATA_INVERSION_NONE;
+    init.OutputDataInversionMode = CRC_OUTPUTDATA_INVERSION_DISABLE;
+    init.CRCLength = CRC_POLYLENGTH_32B;
+    /* The initial value is written before each calculation, so the configuration never depends on it */
+    init.DefaultInitValueUse = DEFAULT_INIT_VALUE_DISABLE;
+    init.InitValue = initParms->InitVal;
 
     if (MCU_CRC32_POLY_ETHERNET == initParms->GeneratePolynomial)
     {
-        handle.Init.DefaultPolynomialUse = DEFAULT_POLYNOMIAL_ENABLE;
+        init.DefaultPolynomialUse = DEFAULT_POLYNOMIAL_ENABLE;
+        init.GeneratingPolynomial = MCU_CRC32_POLY_ETHERNET;
     }
     else
     {
-        handle.Init.DefaultPolynomialUse = DEFAULT_POLYNOMIAL_DISABLE;
-        handle.Init.GeneratingPolynomial = initParms->GeneratePolynomial;
-    }
-    if (MCU_CRC32_INIT_VALUE_DEFAULT == initParms->InitVal)
-    {
-        handle.Init.DefaultInitValueUse = DEFAULT_INIT_VALUE_ENABLE;
-    }
-    else
-    {
-        handle.Init.DefaultInitValueUse = DEFAULT_INIT_VALUE_DISABLE;
-        handle.Init.InitValue = initParms->InitVal;
+        init.DefaultPolynomialUse = DEFAULT_POLYNOMIAL_DISABLE;
+        init.GeneratingPolynomial = initParms->GeneratePolynomial;
     }
 
     switch (initParms->DataFormat)
     {
     case MCU_CRC_DATA_8BIT:
-        handle.InputDataFormat = CRC_INPUTDATA_FORMAT_BYTES;
+        inputDataFormat = CRC_INPUTDATA_FORMAT_BYTES;
         break;
 
     case MCU_CRC_DATA_16BIT:
-        handle.InputDataFormat = CRC_INPUTDATA_FORMAT_HALFWORDS;
+        inputDataFormat = CRC_INPUTDATA_FORMAT_HALFWORDS;
         break;
 
     case MCU_CRC_DATA_32BIT:
-        handle.InputDataFormat = CRC_INPUTDATA_FORMAT_WORDS;
+        inputDataFormat = CRC_INPUTDATA_FORMAT_WORDS;
         break;
 
     default:
         return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INVALID_PARAM);
     }
 
-    __HAL_RCC_CRC_CLK_ENABLE();
+    return CalculateCrc(&init, inputDataFormat, init.InitValue, data_in, dataLength, crc);
+}
+
+/** See description in the interface declaration */
+Retcode_T MCU_CRC_Accumulate(const struct MCU_CRC_Stream_S *stream, uint32_t *crc, const uint8_t *data_in, uint32_t dataLength)
+{
+    uint32_t mask;
+
+    if ((NULL == stream) || (NULL == crc) || (NULL == data_in))
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+    }
+
+    CRC_InitTypeDef init;
 
-    /* CRC module initialization by passing the populated CRC handle */
-    if (HAL_OK != HAL_CRC_Init(&handle))
+    switch (stream->Width)
     {
-        /* TODO: Use a more meaningful error code */
-        retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_FAILURE);
+    case 8:
+        init.CRCLength = CRC_POLYLENGTH_8B;
+        mask = UINT32_C(0xFF);
+        break;
+
+    case 16:
+        init.CRCLength = CRC_POLYLENGTH_16B;
+        mask = UINT32_C(0xFFFF);
+        break;
+
+    case 32:
+        init.CRCLength = CRC_POLYLENGTH_32B;
+        mask = UINT32_C(0xFFFFFFFF);
+        break;
+
+    default:
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NOT_SUPPORTED);
     }
 
-    if (RETCODE_OK == retcode)
+    init.DefaultPolynomialUse = DEFAULT_POLYNOMIAL_DISABLE;
+    init.GeneratingPolynomial = stream->Polynomial & mask;
+    init.DefaultInitValueUse = DEFAULT_INIT_VALUE_DISABLE;
+    init.InitValue = *crc & mask;
+    init.InputDataInversionMode = stream->ReflectInput ? CRC_INPUTDATA_INVERSION_BYTE : CRC_INPUTDATA_INVERSION_NONE;
+    init.OutputDataInversionMode = CRC_OUTPUTDATA_INVERSION_DISABLE;
+
+    return CalculateCrc(&init, CRC_INPUTDATA_FORMAT_BYTES, init.InitValue, data_in, dataLength, crc);
+}
+
+/** See description in the interface declaration */
+Retcode_T MCU_CRC_Deinitialize(void)
+{
+    Retcode_T retcode = RETCODE_OK;
+
+    if (!AcquireCrc())
     {
-        *crc = HAL_CRC_Calculate(&handle, data_in, dataLength);
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INCONSISTENT_STATE);
+    }
 
-        if (HAL_OK != HAL_CRC_DeInit(&handle))
+    if (IsCrcInitialized)
+    {
+        if (HAL_OK != HAL_CRC_DeInit(&CrcHandle))
         {
             /* TODO: Use a more meaningful error code */
             retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_FAILURE);
         }
+        IsCrcInitialized = false;
+        __HAL_RCC_CRC_CLK_DISABLE();
     }
 
-    __HAL_RCC_CRC_CLK_DISABLE();
+    ReleaseCrc();
 
     return retcode;
 }
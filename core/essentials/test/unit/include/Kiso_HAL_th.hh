@@ -24,5 +24,6 @@
 /* Faked variables needs to be initialized by the test fixture */
 
 /* Mock-ups for the provided interfaces */
+FAKE_VALUE_FUNC(bool, HAL_IsInISR)
 
 #endif /* KISO_HAL_TH_HH */
@@ -49,6 +49,11 @@ protected:
         RESET_FAKE(HAL_CRC_Init);
         RESET_FAKE(HAL_CRC_DeInit);
         RESET_FAKE(HAL_CRC_Calculate);
+        RESET_FAKE(__HAL_CRC_INITIALCRCVALUE_CONFIG);
+        RESET_FAKE(__HAL_RCC_CRC_CLK_ENABLE);
+        RESET_FAKE(__HAL_RCC_CRC_CLK_DISABLE);
+        IsCrcInitialized = false;
+        IsCrcBusy = false;
     }
 
     virtual void TearDown()
@@ -127,7 +132,7 @@ TEST_F(KISO_CRCtest, Crc8Success)
     retcode = MCU_CRC8(&initParms, &testData, len, &testCrc);
 
     EXPECT_EQ(1U, HAL_CRC_Init_fake.call_count);
-    EXPECT_EQ(1U, HAL_CRC_DeInit_fake.call_count);
+    EXPECT_EQ(0U, HAL_CRC_DeInit_fake.call_count);
     EXPECT_EQ(1U, HAL_CRC_Calculate_fake.call_count);
     EXPECT_EQ(testCrc, CrcVal);
     EXPECT_EQ(RETCODE_OK, retcode);
@@ -161,20 +166,18 @@ TEST_F(KISO_CRCtest, Crc8RetcodeFailure)
     EXPECT_EQ(RETCODE_SEVERITY_ERROR, Retcode_GetSeverity(retcode));
     EXPECT_EQ(RETCODE_FAILURE, Retcode_GetCode(retcode));
 
-    /* testcase for HAL_CRC_DeInit failure */
+    /* a failed initialization is retried by the next call */
 
     initParms.GeneratePolynomial = UINT8_C(0);
     initParms.InitVal = UINT8_C(0);
     HAL_CRC_Init_fake.return_val = HAL_OK;
-    HAL_CRC_DeInit_fake.return_val = HAL_ERROR;
 
     retcode = MCU_CRC8(&initParms, &testData, len, &testCrc);
 
     EXPECT_EQ(2U, HAL_CRC_Init_fake.call_count);
-    EXPECT_EQ(1U, HAL_CRC_DeInit_fake.call_count);
+    EXPECT_EQ(0U, HAL_CRC_DeInit_fake.call_count);
     EXPECT_EQ(1U, HAL_CRC_Calculate_fake.call_count);
-    EXPECT_EQ(RETCODE_SEVERITY_ERROR, Retcode_GetSeverity(retcode));
-    EXPECT_EQ(RETCODE_FAILURE, Retcode_GetCode(retcode));
+    EXPECT_EQ(RETCODE_OK, retcode);
 }
 
 TEST_F(KISO_CRCtest, Crc16InvalidParmeters)
@@ -248,7 +251,7 @@ TEST_F(KISO_CRCtest, Crc16Success)
     retcode = MCU_CRC16(&initParms, &testData, len, &testCrc);
 
     EXPECT_EQ(1U, HAL_CRC_Init_fake.call_count);
-    EXPECT_EQ(1U, HAL_CRC_DeInit_fake.call_count);
+    EXPECT_EQ(0U, HAL_CRC_DeInit_fake.call_count);
     EXPECT_EQ(1U, HAL_CRC_Calculate_fake.call_count);
     EXPECT_EQ(testCrc, CrcVal);
     EXPECT_EQ(RETCODE_OK, retcode);
@@ -282,20 +285,18 @@ TEST_F(KISO_CRCtest, Crc16RetcodeFailure)
     EXPECT_EQ(RETCODE_SEVERITY_ERROR, Retcode_GetSeverity(retcode));
     EXPECT_EQ(RETCODE_FAILURE, Retcode_GetCode(retcode));
 
-    /* testcase for HAL_CRC_DeInit failure */
+    /* a failed initialization is retried by the next call */
 
     initParms.GeneratePolynomial = UINT16_C(0);
     initParms.InitVal = UINT16_C(0);
     HAL_CRC_Init_fake.return_val = HAL_OK;
-    HAL_CRC_DeInit_fake.return_val = HAL_ERROR;
 
     retcode = MCU_CRC16(&initParms, &testData, len, &testCrc);
 
     EXPECT_EQ(2U, HAL_CRC_Init_fake.call_count);
-    EXPECT_EQ(1U, HAL_CRC_DeInit_fake.call_count);
+    EXPECT_EQ(0U, HAL_CRC_DeInit_fake.call_count);
     EXPECT_EQ(1U, HAL_CRC_Calculate_fake.call_count);
-    EXPECT_EQ(RETCODE_SEVERITY_ERROR, Retcode_GetSeverity(retcode));
-    EXPECT_EQ(RETCODE_FAILURE, Retcode_GetCode(retcode));
+    EXPECT_EQ(RETCODE_OK, retcode);
 }
 
 TEST_F(KISO_CRCtest, Crc32InvalidParmeters)
@@ -387,7 +388,7 @@ TEST_F(KISO_CRCtest, Crc32Success)
     retcode = MCU_CRC32(&initParms, &testData, len, &testCrc);
 
     EXPECT_EQ(1U, HAL_CRC_Init_fake.call_count);
-    EXPECT_EQ(1U, HAL_CRC_DeInit_fake.call_count);
+    EXPECT_EQ(0U, HAL_CRC_DeInit_fake.call_count);
     EXPECT_EQ(1U, HAL_CRC_Calculate_fake.call_count);
     EXPECT_EQ(testCrc, CrcVal);
     EXPECT_EQ(RETCODE_OK, retcode);
@@ -425,15 +426,144 @@ TEST_F(KISO_CRCtest, Crc32RetcodeFailure)
     initParms.InitVal = UINT32_C(0);
     initParms.DataFormat = MCU_CRC_DATA_16BIT;
     HAL_CRC_Init_fake.return_val = HAL_OK;
-    HAL_CRC_DeInit_fake.return_val = HAL_ERROR;
 
     retcode = MCU_CRC32(&initParms, &testData, len, &testCrc);
 
     EXPECT_EQ(2U, HAL_CRC_Init_fake.call_count);
-    EXPECT_EQ(1U, HAL_CRC_DeInit_fake.call_count);
+    EXPECT_EQ(0U, HAL_CRC_DeInit_fake.call_count);
     EXPECT_EQ(1U, HAL_CRC_Calculate_fake.call_count);
-    EXPECT_EQ(RETCODE_SEVERITY_ERROR, Retcode_GetSeverity(retcode));
-    EXPECT_EQ(RETCODE_FAILURE, Retcode_GetCode(retcode));
+    EXPECT_EQ(RETCODE_OK, retcode);
+}
+TEST_F(KISO_CRCtest, CrcKeepsPeripheralInitialized)
+{
+    /** @testcase{ KISO_CRCtest::CrcKeepsPeripheralInitialized: }
+	 * Consecutive calculations with the same configuration initialize the peripheral only once,
+	 * a changed initial value only rewrites the INIT register and a changed polynomial reconfigures it.
+	 */
+
+    struct MCU_CRC32_S initParms;
+    initParms.GeneratePolynomial = MCU_CRC32_POLY_ETHERNET;
+    initParms.InitVal = MCU_CRC32_INIT_VALUE_DEFAULT;
+    initParms.DataFormat = MCU_CRC_DATA_32BIT;
+    uint32_t testData = UINT32_C(1);
+    uint32_t testCrc = UINT32_C(0);
+    HAL_CRC_Init_fake.return_val = HAL_OK;
+
+    EXPECT_EQ(RETCODE_OK, MCU_CRC32(&initParms, &testData, 1U, &testCrc));
+    EXPECT_EQ(RETCODE_OK, MCU_CRC32(&initParms, &testData, 1U, &testCrc));
+    initParms.InitVal = UINT32_C(0x12345678);
+    EXPECT_EQ(RETCODE_OK, MCU_CRC32(&initParms, &testData, 1U, &testCrc));
+
+    EXPECT_EQ(1U, HAL_CRC_Init_fake.call_count);
+    EXPECT_EQ(1U, __HAL_RCC_CRC_CLK_ENABLE_fake.call_count);
+    EXPECT_EQ(3U, HAL_CRC_Calculate_fake.call_count);
+    EXPECT_EQ(3U, __HAL_CRC_INITIALCRCVALUE_CONFIG_fake.call_count);
+    EXPECT_EQ(UINT32_C(0x12345678), __HAL_CRC_INITIALCRCVALUE_CONFIG_fake.arg1_val);
+
+    initParms.GeneratePolynomial = UINT32_C(0x1EDC6F41);
+    EXPECT_EQ(RETCODE_OK, MCU_CRC32(&initParms, &testData, 1U, &testCrc));
+
+    EXPECT_EQ(2U, HAL_CRC_Init_fake.call_count);
+    EXPECT_EQ(1U, __HAL_RCC_CRC_CLK_ENABLE_fake.call_count);
+    EXPECT_EQ(UINT32_C(0x1EDC6F41), CrcHandle.Init.GeneratingPolynomial);
+    EXPECT_EQ(0U, HAL_CRC_DeInit_fake.call_count);
+}
+
+TEST_F(KISO_CRCtest, CrcAccumulateInvalidParameters)
+{
+    /** @testcase{ KISO_CRCtest::CrcAccumulateInvalidParameters: }
+	 * MCU_CRC_Accumulate() rejects NULL pointers and widths the peripheral does not support.
+	 */
+
+    struct MCU_CRC_Stream_S stream = {16, UINT32_C(0x1021), false};
+    uint8_t testData = UINT8_C(1);
+    uint32_t testCrc = UINT32_C(0);
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), MCU_CRC_Accumulate(NULL, &testCrc, &testData, 1U));
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), MCU_CRC_Accumulate(&stream, NULL, &testData, 1U));
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), MCU_CRC_Accumulate(&stream, &testCrc, NULL, 1U));
+
+    stream.Width = 24;
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NOT_SUPPORTED), MCU_CRC_Accumulate(&stream, &testCrc, &testData, 1U));
+
+    EXPECT_EQ(0U, HAL_CRC_Init_fake.call_count);
+    EXPECT_EQ(0U, HAL_CRC_Calculate_fake.call_count);
+}
+
+TEST_F(KISO_CRCtest, CrcAccumulateSuccess)
+{
+    /** @testcase{ KISO_CRCtest::CrcAccumulateSuccess: }
+	 * MCU_CRC_Accumulate() configures the peripheral for the stream, starts from the passed register value
+	 * and returns the new one.
+	 */
+
+    struct MCU_CRC_Stream_S stream = {16, UINT32_C(0x1021), true};
+    uint8_t testData[3] = {1, 2, 3};
+    uint32_t testCrc = UINT32_C(0xFFFF);
+    HAL_CRC_Init_fake.return_val = HAL_OK;
+    HAL_CRC_Calculate_fake.return_val = UINT32_C(0x1234);
+
+    EXPECT_EQ(RETCODE_OK, MCU_CRC_Accumulate(&stream, &testCrc, testData, sizeof(testData)));
+
+    EXPECT_EQ(UINT32_C(0x1234), testCrc);
+    EXPECT_EQ(1U, HAL_CRC_Init_fake.call_count);
+    EXPECT_EQ((uint32_t)CRC_POLYLENGTH_16B, CrcHandle.Init.CRCLength);
+    EXPECT_EQ(UINT32_C(0x1021), CrcHandle.Init.GeneratingPolynomial);
+    EXPECT_EQ((uint32_t)CRC_INPUTDATA_INVERSION_BYTE, CrcHandle.Init.InputDataInversionMode);
+    EXPECT_EQ((uint32_t)CRC_OUTPUTDATA_INVERSION_DISABLE, CrcHandle.Init.OutputDataInversionMode);
+    EXPECT_EQ((uint32_t)CRC_INPUTDATA_FORMAT_BYTES, CrcHandle.InputDataFormat);
+    EXPECT_EQ(UINT32_C(0xFFFF), __HAL_CRC_INITIALCRCVALUE_CONFIG_fake.arg1_val);
+    EXPECT_EQ(sizeof(testData), HAL_CRC_Calculate_fake.arg2_val);
+
+    EXPECT_EQ(RETCODE_OK, MCU_CRC_Accumulate(&stream, &testCrc, testData, sizeof(testData)));
+
+    EXPECT_EQ(1U, HAL_CRC_Init_fake.call_count);
+    EXPECT_EQ(UINT32_C(0x1234), __HAL_CRC_INITIALCRCVALUE_CONFIG_fake.arg1_val);
+}
+
+TEST_F(KISO_CRCtest, CrcAccumulateBusy)
+{
+    /** @testcase{ KISO_CRCtest::CrcAccumulateBusy: }
+	 * A calculation requested while the peripheral is in use fails without touching the peripheral.
+	 */
+
+    struct MCU_CRC_Stream_S stream = {32, MCU_CRC32_POLY_ETHERNET, false};
+    uint8_t testData = UINT8_C(1);
+    uint32_t testCrc = UINT32_C(0);
+    IsCrcBusy = true;
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INCONSISTENT_STATE), MCU_CRC_Accumulate(&stream, &testCrc, &testData, 1U));
+
+    EXPECT_EQ(0U, HAL_CRC_Init_fake.call_count);
+    EXPECT_EQ(0U, HAL_CRC_Calculate_fake.call_count);
+    EXPECT_TRUE(IsCrcBusy);
+}
+
+TEST_F(KISO_CRCtest, CrcDeinitialize)
+{
+    /** @testcase{ KISO_CRCtest::CrcDeinitialize: }
+	 * MCU_CRC_Deinitialize() releases an initialized peripheral once and reports HAL failures.
+	 */
+
+    struct MCU_CRC_Stream_S stream = {8, UINT32_C(0x07), false};
+    uint8_t testData = UINT8_C(1);
+    uint32_t testCrc = UINT32_C(0);
+    HAL_CRC_Init_fake.return_val = HAL_OK;
+    HAL_CRC_DeInit_fake.return_val = HAL_OK;
+
+    EXPECT_EQ(RETCODE_OK, MCU_CRC_Deinitialize());
+    EXPECT_EQ(0U, HAL_CRC_DeInit_fake.call_count);
+
+    EXPECT_EQ(RETCODE_OK, MCU_CRC_Accumulate(&stream, &testCrc, &testData, 1U));
+    EXPECT_EQ(RETCODE_OK, MCU_CRC_Deinitialize());
+    EXPECT_EQ(1U, HAL_CRC_DeInit_fake.call_count);
+    EXPECT_EQ(1U, __HAL_RCC_CRC_CLK_DISABLE_fake.call_count);
+
+    HAL_CRC_DeInit_fake.return_val = HAL_ERROR;
+    EXPECT_EQ(RETCODE_OK, MCU_CRC_Accumulate(&stream, &testCrc, &testData, 1U));
+    EXPECT_EQ(2U, HAL_CRC_Init_fake.call_count);
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_FAILURE), MCU_CRC_Deinitialize());
+    EXPECT_FALSE(IsCrcInitialized);
 }
 #else
 }
@@ -37,6 +37,11 @@
  *      result in shifter
  * @endcode
  *
+ *      If KISO_CRC_TABLE_DRIVEN is enabled, each routine processes one octet per step using a
+ *      256-entry lookup table. Tables are built on the first call with a polynomial and kept for
+ *      up to KISO_CRC_TABLE_CACHE_SIZE polynomials per routine; calls with further polynomials use
+ *      the bit-serial calculation above. Both paths produce identical results.
+ *
  * @file
  **/
 
@@ -56,6 +61,44 @@
 #define CRC32_INVERSE(x) (x = x ^ (~0UL))
 #define CRC32_ETHERNET_REVERSE_POLYNOMIAL UINT32_C(0xEDB88320) /**< CRC32 polynomial for Ethernet standard IEEE 802.3 */
 
+#define CRC_WIDTH_MIN UINT8_C(8)  /**< Smallest CRC width supported by the context API */
+#define CRC_WIDTH_MAX UINT8_C(32) /**< Largest CRC width supported by the context API */
+
+/**
+ * @brief
+ *      Parameters of a CRC algorithm in the notation of the CRC catalogue
+ *      (http://reveng.sourceforge.net/crc-catalogue/), in the order width, poly, init, refin, refout, xorout.
+ */
+typedef struct CRC_Params_S
+{
+    uint8_t Width;   /**< Width of the CRC in bits, CRC_WIDTH_MIN to CRC_WIDTH_MAX */
+    uint32_t Poly;   /**< Polynomial without its leading term, not reflected */
+    uint32_t Init;   /**< Initial register value, not reflected */
+    bool RefIn;      /**< Process input octets least significant bit first */
+    bool RefOut;     /**< Reflect the register before the final XOR */
+    uint32_t XorOut; /**< Value XORed to the register to get the CRC */
+} CRC_Params_T;
+
+/* Initializers for CRC_Params_T of commonly used algorithms, named as in the CRC catalogue */
+#define CRC_PARAMS_CRC8_SMBUS {UINT8_C(8), UINT32_C(0x07), UINT32_C(0x00), false, false, UINT32_C(0x00)}
+#define CRC_PARAMS_CRC16_IBM_3740 {UINT8_C(16), UINT32_C(0x1021), UINT32_C(0xFFFF), false, false, UINT32_C(0x0000)} /**< a.k.a. CRC-16/CCITT-FALSE */
+#define CRC_PARAMS_CRC16_KERMIT {UINT8_C(16), UINT32_C(0x1021), UINT32_C(0x0000), true, true, UINT32_C(0x0000)}
+#define CRC_PARAMS_CRC16_XMODEM {UINT8_C(16), UINT32_C(0x1021), UINT32_C(0x0000), false, false, UINT32_C(0x0000)}
+#define CRC_PARAMS_CRC32_ISO_HDLC {UINT8_C(32), UINT32_C(0x04C11DB7), UINT32_C(0xFFFFFFFF), true, true, UINT32_C(0xFFFFFFFF)} /**< a.k.a. CRC-32, Ethernet */
+#define CRC_PARAMS_CRC32_ISCSI {UINT8_C(32), UINT32_C(0x1EDC6F41), UINT32_C(0xFFFFFFFF), true, true, UINT32_C(0xFFFFFFFF)}   /**< a.k.a. CRC-32C */
+#define CRC_PARAMS_CRC32_MPEG_2 {UINT8_C(32), UINT32_C(0x04C11DB7), UINT32_C(0xFFFFFFFF), false, false, UINT32_C(0x00000000)}
+
+/**
+ * @brief
+ *      State of an incremental CRC calculation. Its members are private to the CRC module.
+ */
+typedef struct CRC_Context_S
+{
+    CRC_Params_T Params;
+    uint32_t EnginePoly;
+    uint32_t Register;
+} CRC_Context_T;
+
 /* public function prototype declarations */
 
 /**
@@ -150,6 +193,88 @@ Retcode_T CRC_32(uint32_t poly, uint32_t *shifter, const uint8_t *data_p, uint16
  */
 Retcode_T CRC_32_Reverse(uint32_t poly, uint32_t *shifter, const uint8_t *data_p, uint16_t len);
 
+/**
+ * @brief
+ *      Starts an incremental CRC calculation with the given algorithm.
+ *
+ * @param[out]  context
+ *      Context to initialize; it holds a copy of the parameters
+ * @param[in]  params
+ *      Parameters of the algorithm, e.g. initialized with CRC_PARAMS_CRC32_ISO_HDLC
+ *
+ * @retval  #RETCODE_OK
+ *      When successful
+ * @retval  #RETCODE_NULL_POINTER
+ *      When any of the input pointers is NULL
+ * @retval  #RETCODE_INVALID_PARAM
+ *      When the width is outside CRC_WIDTH_MIN to CRC_WIDTH_MAX
+ */
+Retcode_T CRC_Initialize(CRC_Context_T *context, const CRC_Params_T *params);
+
+/**
+ * @brief
+ *      Feeds the next octets of a message into an incremental CRC calculation.
+ *
+ * @details
+ *      A message can be split into any number of updates of any length; the result does not depend on the split.
+ *      With KISO_CRC_HARDWARE_OFFLOAD enabled, the update runs on the MCU CRC unit if it supports the algorithm and
+ *      is not in use, otherwise in software.
+ *
+ * @param[in,out]  context
+ *      Context initialized by CRC_Initialize()
+ * @param[in]  data_p
+ *      Pointer to the next octets of the message, no alignment required
+ * @param[in]  len
+ *      Number of octets in data
+ *
+ * @retval  #RETCODE_OK
+ *      When successful
+ * @retval  #RETCODE_NULL_POINTER
+ *      When any of the input pointers is NULL
+ */
+Retcode_T CRC_Update(CRC_Context_T *context, const uint8_t *data_p, uint32_t len);
+
+/**
+ * @brief
+ *      Gets the CRC of all octets fed into a context so far.
+ *
+ * @details
+ *      The context is not modified, so it can be updated further afterwards.
+ *
+ * @param[in]  context
+ *      Context initialized by CRC_Initialize()
+ * @param[out]  crc
+ *      CRC with output reflection and final XOR applied, in the lowest width bits
+ *
+ * @retval  #RETCODE_OK
+ *      When successful
+ * @retval  #RETCODE_NULL_POINTER
+ *      When any of the input pointers is NULL
+ */
+Retcode_T CRC_Finalize(const CRC_Context_T *context, uint32_t *crc);
+
+/**
+ * @brief
+ *      Calculates the CRC of a message in one go, see CRC_Initialize(), CRC_Update() and CRC_Finalize().
+ *
+ * @param[in]  params
+ *      Parameters of the algorithm
+ * @param[in]  data_p
+ *      Pointer to start of the message
+ * @param[in]  len
+ *      Number of octets in the message
+ * @param[out]  crc
+ *      Calculated CRC
+ *
+ * @retval  #RETCODE_OK
+ *      When successful
+ * @retval  #RETCODE_NULL_POINTER
+ *      When any of the input pointers is NULL
+ * @retval  #RETCODE_INVALID_PARAM
+ *      When the width is outside CRC_WIDTH_MIN to CRC_WIDTH_MAX
+ */
+Retcode_T CRC_Calculate(const CRC_Params_T *params, const uint8_t *data_p, uint32_t len, uint32_t *crc);
+
 #endif /* if KISO_FEATURE_CRC */
 
 #endif /* KISO_CRC_H_ */
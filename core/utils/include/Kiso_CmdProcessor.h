@@ -26,6 +26,24 @@
  *      function from the queue. This function is enqueued by the application
  *      using the command enqueue function
  *
+ *      A command processor initialized by CmdProcessor_InitializeLanes() has a
+ *      queue per lane (see #CmdProcessor_Lane_T). Its task always runs the oldest
+ *      command of the most urgent lane next, so urgent work does not wait behind
+ *      bulk work. It runs up to #CONFIG_CMDPROCESSOR_BATCH_SIZE commands per
+ *      wake-up. A command enqueued with coalescing is not queued a second time
+ *      while the same function with the same param1 is still waiting.
+ *
+ *      Delayed and periodic commands are kept in a hierarchical timer wheel which
+ *      the task of the command processor runs itself, the task sleeps until the
+ *      next timer is due, or timers move down a level of the wheel. The caller provides the #CmdProcessor_Timer_T of each
+ *      timer, so scheduling and cancelling a timer takes constant time and needs
+ *      no RTOS objects.
+ *
+ *      With KISO_UTILS_STATIC_ALLOCATION, CmdProcessor_InitializeStatic() and
+ *      CmdProcessor_InitializeLanesStatic() create the queues and the task in a
+ *      #CmdProcessor_Storage_T, a stack and a queue memory given by the caller
+ *      instead of the FreeRTOS heap.
+ *
  * @code
  *
  *      // function to load in queue
@@ -34,18 +52,14 @@
  *          // do some functionality
  *      }
  *
+ *      static CmdProcessor_Timer_T appTimer;
+ *
  *      int main(void)
  *      {
  *          // Intialize the command processor
  *          CmdProcessor_Initialize(&cmdprocessor,"<taskname>",priority, stack_size,queue_size);
- *          //create a timer task
- *          OS_timerCreate(timer, 10,pdTRUE ,NULL, vTimerCallback);
- *      }
- *
- *      // Timer call back function to load application function in queue
- *      void vTimerCallback( OS_timerHandle_tp pxTimer )
- *      {
- *          CmdProcessor_enqueue(&CmdProcessor,&AppFunc, NULL, NULL);
+ *          // run AppFunc every 10 ms
+ *          CmdProcessor_EnqueuePeriodic(&cmdprocessor, &appTimer, &AppFunc, NULL, 0, 10);
  *      }
  *
  * @endcode
@@ -63,6 +77,10 @@
 
 #include "Kiso_Basics.h"
 #include "Kiso_Retcode.h"
+#include "Kiso_CmdProcessorConfig.h"
+#if KISO_UTILS_STATIC_ALLOCATION
+#include "FreeRTOS.h"
+#endif
 
 /* public type and macro definitions */
 #define CMDPROCESSOR_MAX_NAME_LEN UINT32_C(32) /**< Maximum length of command processor task name including 0 termination char */
@@ -87,11 +105,66 @@ typedef void *cmdProcessorTaskHandle_t;
 
 typedef void *cmdProcessorQueueHandle_t;
 
+/** The lanes of a command processor, from the most to the least urgent one */
+enum CmdProcessor_Lane_E
+{
+    CMDPROCESSOR_LANE_URGENT, /**< Short work which must not wait, e.g. handling a button or a modem URC */
+    CMDPROCESSOR_LANE_NORMAL, /**< The lane of CmdProcessor_Enqueue() */
+    CMDPROCESSOR_LANE_BULK,   /**< Long running work, e.g. writing flash or downloading */
+    CMDPROCESSOR_LANE_COUNT
+};
+
+typedef enum CmdProcessor_Lane_E CmdProcessor_Lane_T;
+
+/* A function and context of a queued coalescing command */
+struct _CmdProcessor_Coalesce_S
+{
+    CmdProcessor_Func_T func;
+    void *param1;
+};
+
+#define CMDPROCESSOR_TIMER_LEVELS UINT32_C(3)                                         /**< Number of levels of the timer wheel */
+#define CMDPROCESSOR_TIMER_SLOTS (UINT32_C(1) << CONFIG_CMDPROCESSOR_TIMER_SLOT_BITS) /**< Number of slots per level */
+
+/**
+ * A delayed or periodic command. The caller keeps it while it is scheduled, it must be
+ * zero initialized before its first use.
+ */
+struct _CmdProcessor_Timer_S
+{
+    struct _CmdProcessor_Timer_S *next;
+    struct _CmdProcessor_Timer_S **pprev; /**< Link pointing at this timer, NULL while it is not scheduled */
+    CmdProcessor_Func_T func;
+    void *param1;
+    uint32_t param2;
+    uint32_t deadline; /**< Tick at which the command is due */
+    uint32_t period;   /**< Ticks between two runs, 0 for a single run */
+    uint32_t slot;     /**< Slot of the wheel holding the timer, level * CMDPROCESSOR_TIMER_SLOTS + index */
+};
+
+typedef struct _CmdProcessor_Timer_S CmdProcessor_Timer_T;
+
+/* Timers of a command processor, changed with interrupts disabled only */
+struct _CmdProcessor_TimerWheel_S
+{
+    CmdProcessor_Timer_T *slots[CMDPROCESSOR_TIMER_LEVELS][CMDPROCESSOR_TIMER_SLOTS];
+    uint32_t occupied[CMDPROCESSOR_TIMER_LEVELS]; /**< Bit per slot which holds timers */
+    CmdProcessor_Timer_T *expiring;               /**< Due timers which did not run yet */
+    uint32_t time;                                /**< Next tick the wheel runs */
+    uint32_t wakeTime;                            /**< Tick at which the sleeping task wakes up */
+    bool isSleeping;                              /**< The task waits for a command */
+    bool hasWakeTime;                             /**< The task wakes up at wakeTime without a command */
+};
+
 /* Structure contains task handle and queue handle as it members to access the queue and task easily.*/
 struct _CmdProcessor_S
 {
     cmdProcessorTaskHandle_t task;
-    cmdProcessorQueueHandle_t queue;
+    cmdProcessorQueueHandle_t queues[CMDPROCESSOR_LANE_COUNT]; /**< Queue per lane, NULL for a lane without queue */
+    uint32_t laneCount;                                        /**< Number of lanes with a queue */
+    struct _CmdProcessor_Coalesce_S queued[CONFIG_CMDPROCESSOR_COALESCE_SLOTS];
+    uint32_t queuedCount; /**< Number of used entries of queued */
+    struct _CmdProcessor_TimerWheel_S timers;
     int8_t name[CMDPROCESSOR_MAX_NAME_LEN];
 };
 
@@ -101,6 +174,23 @@ struct _CmdProcessor_S
  */
 typedef struct _CmdProcessor_S CmdProcessor_T;
 
+#if KISO_UTILS_STATIC_ALLOCATION
+/** Size of a queued command, in bytes: function, param1 and param2, padded to the alignment of pointers */
+#define CMDPROCESSOR_COMMAND_SIZE ((((2U * sizeof(void *) + sizeof(uint32_t)) + sizeof(void *) - 1U) / sizeof(void *)) * sizeof(void *))
+
+/** Size of the queue memory for the given number of commands of all lanes, in bytes */
+#define CMDPROCESSOR_QUEUE_MEMORY_SIZE(commands) ((commands)*CMDPROCESSOR_COMMAND_SIZE)
+
+/** Storage of the FreeRTOS objects of a command processor, see CmdProcessor_InitializeLanesStatic() */
+struct _CmdProcessor_Storage_S
+{
+    StaticTask_t task;
+    StaticQueue_t queues[CMDPROCESSOR_LANE_COUNT];
+};
+
+typedef struct _CmdProcessor_Storage_S CmdProcessor_Storage_T;
+#endif /* if KISO_UTILS_STATIC_ALLOCATION */
+
 /** enums to represent the return status of a command processor */
 enum CmdProcessor_Retcode_E
 {
@@ -145,6 +235,102 @@ enum CmdProcessor_Retcode_E
  */
 Retcode_T CmdProcessor_Initialize(CmdProcessor_T *cmdProcessor, const char *name, uint32_t taskPriority, uint32_t taskStackDepth, uint32_t queueSize);
 
+/**
+ * @brief
+ *      This function initializes a command processor instance with several lanes.
+ *      It creates a queue for every lane with a size and the task which processes
+ *      them.
+ *
+ * @note
+ *      A command processor with more than one lane wakes its task by the direct to
+ *      task notification. The commands must not use the notification of the task.
+ *
+ * @param[in]   cmdProcessor
+ *      Contains the queue and task handles
+ * @param[in]   name
+ *      Represents the task name
+ * @param[in]   taskPriority
+ *      Represents the task priority
+ * @param[in]   taskStackDepth
+ *      Represents the stack Size for the task
+ * @param[in]   queueSizes
+ *      The queue size per lane, 0 for a lane which is not used
+ *
+ * @retval      #RETCODE_OK
+ *      When the queues and the task are created successfully
+ * @retval      #RETCODE_INVALID_PARAM
+ *      When a pointer is NULL or no lane has a queue size
+ * @retval      #RETCODE_FAILURE
+ *      When a queue or the task is not created
+ */
+Retcode_T CmdProcessor_InitializeLanes(CmdProcessor_T *cmdProcessor, const char *name, uint32_t taskPriority, uint32_t taskStackDepth,
+                                       const uint32_t queueSizes[CMDPROCESSOR_LANE_COUNT]);
+
+#if KISO_UTILS_STATIC_ALLOCATION
+/**
+ * @brief
+ *      This function initializes the command processor instance like CmdProcessor_Initialize(),
+ *      but creates the queue and the task in the given storage instead of the FreeRTOS heap.
+ *
+ * @param[in]   cmdProcessor
+ *      Contains the queue and task handles
+ * @param[in]   name
+ *      Represents the task name
+ * @param[in]   taskPriority
+ *      Represents the task priority
+ * @param[in]   taskStackDepth
+ *      Represents the stack Size for the task, in words
+ * @param[in]   queueSize
+ *      Represents the queue Size
+ * @param[in]   taskStack
+ *      The stack of the task, taskStackDepth words
+ * @param[in]   queueMemory
+ *      The memory of the queue, #CMDPROCESSOR_QUEUE_MEMORY_SIZE(queueSize) bytes
+ * @param[in]   storage
+ *      The storage of the queue and the task
+ *
+ * @retval      #RETCODE_OK
+ *      When the queue and the task are created
+ * @retval      #RETCODE_INVALID_PARAM
+ *      When a pointer is NULL or the queue size is 0
+ */
+Retcode_T CmdProcessor_InitializeStatic(CmdProcessor_T *cmdProcessor, const char *name, uint32_t taskPriority, uint32_t taskStackDepth, uint32_t queueSize,
+                                        StackType_t *taskStack, uint8_t *queueMemory, CmdProcessor_Storage_T *storage);
+
+/**
+ * @brief
+ *      This function initializes a command processor instance with several lanes like
+ *      CmdProcessor_InitializeLanes(), but creates the queues and the task in the given
+ *      storage instead of the FreeRTOS heap.
+ *
+ * @param[in]   cmdProcessor
+ *      Contains the queue and task handles
+ * @param[in]   name
+ *      Represents the task name
+ * @param[in]   taskPriority
+ *      Represents the task priority
+ * @param[in]   taskStackDepth
+ *      Represents the stack Size for the task, in words
+ * @param[in]   queueSizes
+ *      The queue size per lane, 0 for a lane which is not used
+ * @param[in]   taskStack
+ *      The stack of the task, taskStackDepth words
+ * @param[in]   queueMemory
+ *      The memory of the queues, one after another, #CMDPROCESSOR_QUEUE_MEMORY_SIZE() of the
+ *      sum of the queue sizes in bytes
+ * @param[in]   storage
+ *      The storage of the queues and the task
+ *
+ * @retval      #RETCODE_OK
+ *      When the queues and the task are created
+ * @retval      #RETCODE_INVALID_PARAM
+ *      When a pointer is NULL or no lane has a queue size
+ */
+Retcode_T CmdProcessor_InitializeLanesStatic(CmdProcessor_T *cmdProcessor, const char *name, uint32_t taskPriority, uint32_t taskStackDepth,
+                                             const uint32_t queueSizes[CMDPROCESSOR_LANE_COUNT], StackType_t *taskStack, uint8_t *queueMemory,
+                                             CmdProcessor_Storage_T *storage);
+#endif /* if KISO_UTILS_STATIC_ALLOCATION */
+
 /**
  *  @brief
  *      This routine is used to hand-over a function to the command processor for execution. The function is added
@@ -201,6 +387,122 @@ Retcode_T CmdProcessor_Enqueue(CmdProcessor_T *cmdProcessor, CmdProcessor_Func_T
  */
 Retcode_T CmdProcessor_EnqueueFromIsr(CmdProcessor_T *cmdProcessor, CmdProcessor_Func_T func, void *param1, uint32_t param2);
 
+/**
+ *  @brief
+ *      This routine is used to hand-over a function to a given lane of the command
+ *      processor for execution.
+ *
+ *  @details
+ *      If isCoalesced is true and the same function with the same param1 has been
+ *      enqueued with coalescing before and did not start yet, the function is not
+ *      queued again. The queued one runs with its own param2. Up to
+ *      #CONFIG_CMDPROCESSOR_COALESCE_SLOTS coalescing commands are tracked, further
+ *      ones are queued normally.
+ *
+ *  @param[in]  cmdProcessor
+ *      Contains the queue handles
+ *  @param[in]  lane
+ *      The lane to queue the function in
+ *  @param[in]  isCoalesced
+ *      Whether a waiting identical command replaces this one
+ *  @param[in]  func
+ *      Represents the function
+ *  @param[in]  param1
+ *      A generic pointer to an arbitrary context data structure which will be passed to the function when it is invoked by the command processor.
+ *  @param[in]  param2
+ *      Second argument of the function
+ *
+ *  @retval     #RETCODE_OK
+ *      When the function is pushed successfully into the queue, or is already waiting
+ *  @retval     #RETCODE_INVALID_PARAM
+ *      When cmdProcessor is NULL or the lane has no queue
+ *  @retval     #RETCODE_FAILURE
+ *      When the queue is full
+ */
+Retcode_T CmdProcessor_EnqueueToLane(CmdProcessor_T *cmdProcessor, CmdProcessor_Lane_T lane, bool isCoalesced,
+                                     CmdProcessor_Func_T func, void *param1, uint32_t param2);
+
+/**
+ *  @brief
+ *      This routine is used to hand-over a function to a given lane of the command
+ *      processor from ISR context.
+ *
+ *  @retval See CmdProcessor_EnqueueToLane()
+ */
+Retcode_T CmdProcessor_EnqueueToLaneFromIsr(CmdProcessor_T *cmdProcessor, CmdProcessor_Lane_T lane, bool isCoalesced,
+                                            CmdProcessor_Func_T func, void *param1, uint32_t param2);
+
+/**
+ *  @brief
+ *      This routine is used to run a function in the command processor after a delay.
+ *
+ *  @details
+ *      The function runs in the task of the command processor, before the queued
+ *      commands, once the delay has passed. A timer which is scheduled already is
+ *      moved to the new deadline. The timer must not be used with another command
+ *      processor while it is scheduled.
+ *
+ *  @note
+ *      Must not be called from ISR context.
+ *
+ *  @param[in]  cmdProcessor
+ *      The command processor running the function
+ *  @param[in]  timer
+ *      Storage of the timer, kept by the caller while it is scheduled
+ *  @param[in]  func
+ *      Represents the function
+ *  @param[in]  param1
+ *      A generic pointer to an arbitrary context data structure which will be passed to the function when it is invoked by the command processor.
+ *  @param[in]  param2
+ *      Second argument of the function
+ *  @param[in]  delay
+ *      Time in ms until the function runs
+ *
+ *  @retval     #RETCODE_OK
+ *      When the timer is scheduled
+ *  @retval     #RETCODE_INVALID_PARAM
+ *      When cmdProcessor, timer or func is NULL, or the command processor is not initialized
+ */
+Retcode_T CmdProcessor_EnqueueDelayed(CmdProcessor_T *cmdProcessor, CmdProcessor_Timer_T *timer,
+                                      CmdProcessor_Func_T func, void *param1, uint32_t param2, uint32_t delay);
+
+/**
+ *  @brief
+ *      This routine is used to run a function in the command processor periodically.
+ *
+ *  @details
+ *      The function first runs one period after the call, then once per period
+ *      until the timer is cancelled. Runs which are missed because the command
+ *      processor was busy are skipped, later runs keep to the original period.
+ *
+ *  @param[in]  period
+ *      Time in ms between two runs of the function, rounded up to one tick
+ *
+ *  @retval See CmdProcessor_EnqueueDelayed()
+ */
+Retcode_T CmdProcessor_EnqueuePeriodic(CmdProcessor_T *cmdProcessor, CmdProcessor_Timer_T *timer,
+                                       CmdProcessor_Func_T func, void *param1, uint32_t param2, uint32_t period);
+
+/**
+ *  @brief
+ *      This routine is used to cancel a delayed or periodic function.
+ *
+ *  @details
+ *      Nothing happens if the timer is not scheduled. A function which is running
+ *      already completes.
+ *
+ *  @param[in]  cmdProcessor
+ *      The command processor the timer is scheduled in
+ *  @param[in]  timer
+ *      The timer to cancel
+ *
+ *  @retval     #RETCODE_OK
+ *      When the timer is not scheduled anymore
+ *  @retval     #RETCODE_INVALID_PARAM
+ *      When cmdProcessor or timer is NULL
+ */
+Retcode_T CmdProcessor_CancelTimer(CmdProcessor_T *cmdProcessor, CmdProcessor_Timer_T *timer);
+
 /**
  * @brief
  *      The API suspends the command processor service.
@@ -28,6 +28,25 @@
  *      so on. By default, the module allows for up to 16 observers per event hub
  *      but this can be overridden by changing the CONFIG_EVENTHUB_MAX_OBSERVERS flag.
  *
+ *      The observers of an event are chained per event, in one of
+ *      CONFIG_EVENTHUB_EVENT_BUCKETS lists selected by a hash of the event, and the
+ *      observers of all events in a list of their own. A notification therefore only
+ *      visits the observers of its bucket and of all events. Observers are never
+ *      removed, a new one is filled in completely before it is linked into its list,
+ *      so notifications walk the lists without taking the hub lock. The lock only
+ *      serializes the registrations.
+ *
+ *      An observer registered with EventHub_ObserveAsync() or EventHub_ObserveAllAsync()
+ *      is called by the task of a command processor instead of the notifying task, so a
+ *      slow observer does not hold up the publishers. Up to CONFIG_EVENTHUB_ASYNC_QUEUE_SIZE
+ *      such deliveries may be queued per hub. An observer may ask for consecutive
+ *      notifications of the same event to be coalesced, it is then called once with the
+ *      data of the latest notification. The latency and the queue depth of the
+ *      deliveries are available by EventHub_GetAsyncStatistics().
+ *
+ *      With KISO_UTILS_STATIC_ALLOCATION, EventHub_InitializeStatic() creates the hub lock
+ *      in an #EventHub_Storage_T given by the caller instead of the FreeRTOS heap.
+ *
  * @file
  **/
 
@@ -42,27 +61,102 @@
 #include "Kiso_Basics.h"
 #include "Kiso_Retcode.h"
 #include "Kiso_EventHubConfig.h"
+#include "Kiso_CmdProcessor.h"
+#if KISO_UTILS_STATIC_ALLOCATION
+#include "FreeRTOS.h"
+#endif
 
 typedef uint32_t TaskEvent_T;
 
 typedef void (*EventHandler_T)(TaskEvent_T event, const void *data);
 
+#if (CONFIG_EVENTHUB_MAX_OBSERVERS > 255)
+#error "CONFIG_EVENTHUB_MAX_OBSERVERS must not be greater than 255"
+#endif
+
+#if (CONFIG_EVENTHUB_EVENT_BUCKETS < 1) || ((CONFIG_EVENTHUB_EVENT_BUCKETS & (CONFIG_EVENTHUB_EVENT_BUCKETS - 1)) != 0)
+#error "CONFIG_EVENTHUB_EVENT_BUCKETS must be a power of two"
+#endif
+
+#if (CONFIG_EVENTHUB_ISR_QUEUE_SIZE < 1) || (CONFIG_EVENTHUB_ISR_QUEUE_SIZE > 255)
+#error "CONFIG_EVENTHUB_ISR_QUEUE_SIZE must be within 1 and 255"
+#endif
+
+#if (CONFIG_EVENTHUB_ASYNC_QUEUE_SIZE < 1) || (CONFIG_EVENTHUB_ASYNC_QUEUE_SIZE > 255)
+#error "CONFIG_EVENTHUB_ASYNC_QUEUE_SIZE must be within 1 and 255"
+#endif
+
 struct EventObserver_S
 {
     TaskEvent_T event;
     bool allEvents;
+    uint8_t next;           /**< Number of the next observer in the same list, 0 at the end of the list */
+    bool isCoalesced;       /**< A queued delivery of the same event takes the data of a new notification */
+    uint8_t queuedDelivery; /**< Number of the latest queued delivery to the observer, 0 if none */
     EventHandler_T handler;
+    struct _CmdProcessor_S *cmdProcessor; /**< Command processor calling the handler, NULL to call it in the notifying task */
 };
 typedef struct EventObserver_S EventObserver_T;
 
+/* A notification for an asynchronous observer, queued in its command processor */
+struct EventDelivery_S
+{
+    TaskEvent_T event;
+    const void *data;
+    uint32_t queuedTick; /**< Tick count at the time of the notification, for the latency */
+    uint8_t observer;    /**< Number of the observer, 0 if the delivery is unused */
+};
+typedef struct EventDelivery_S EventDelivery_T;
+
+/**
+ * Figures of the asynchronous deliveries of a hub. Latencies are the times in ticks
+ * from the notification to the call of the observer.
+ */
+struct EventHubAsyncStatistics_S
+{
+    uint32_t delivered;    /**< Deliveries which called their observer */
+    uint32_t coalesced;    /**< Notifications merged into a queued delivery */
+    uint32_t dropped;      /**< Notifications lost as the hub or the command processor queue was full */
+    uint32_t latencyMax;   /**< Longest latency */
+    uint32_t latencyTotal; /**< Sum of the latencies of the delivered notifications */
+    uint8_t depth;         /**< Deliveries queued at the moment */
+    uint8_t depthMax;      /**< Highest number of deliveries queued at once */
+};
+typedef struct EventHubAsyncStatistics_S EventHubAsyncStatistics_T;
+
+/* A notification from an interrupt, waiting for its delivery */
+struct EventDeferred_S
+{
+    TaskEvent_T event;
+    const void *data;
+};
+typedef struct EventDeferred_S EventDeferred_T;
+
 struct EventHub_S
 {
     uint32_t observerCount;
     EventObserver_T observers[CONFIG_EVENTHUB_MAX_OBSERVERS];
+    uint8_t eventObservers[CONFIG_EVENTHUB_EVENT_BUCKETS]; /**< Number of the first observer per bucket, 0 if none */
+    uint8_t allObservers;                                  /**< Number of the first observer of all events, 0 if none */
+    EventDeferred_T deferred[CONFIG_EVENTHUB_ISR_QUEUE_SIZE];
+    uint8_t deferredHead;
+    uint8_t deferredCount;
+    bool isDeliveryPending;
+    EventDelivery_T deliveries[CONFIG_EVENTHUB_ASYNC_QUEUE_SIZE];
+    EventHubAsyncStatistics_T asyncStatistics;
     void *lock;
 };
 typedef struct EventHub_S EventHub_T;
 
+#if KISO_UTILS_STATIC_ALLOCATION
+/** Storage of the lock of an event hub, see EventHub_InitializeStatic() */
+struct EventHub_Storage_S
+{
+    StaticSemaphore_t lock;
+};
+typedef struct EventHub_Storage_S EventHub_Storage_T;
+#endif /* if KISO_UTILS_STATIC_ALLOCATION */
+
 /**
  * @brief
  *      This function initializes a given event hub handle.
@@ -79,6 +173,25 @@ typedef struct EventHub_S EventHub_T;
  */
 Retcode_T EventHub_Initialize(EventHub_T *hub);
 
+#if KISO_UTILS_STATIC_ALLOCATION
+/**
+ * @brief
+ *      This function initializes a given event hub handle like EventHub_Initialize(),
+ *      but creates its lock in the given storage instead of the FreeRTOS heap.
+ *
+ * @param[in,out] hub
+ *      A pointer to an EventHub structure
+ * @param[in] storage
+ *      The storage of the hub lock, valid as long as the hub is used
+ *
+ * @retval #RETCODE_OK
+ *      When the event hub is initialized successfully
+ * @retval #RETCODE_NULL_POINTER
+ *      When a parameter pointer is NULL
+ */
+Retcode_T EventHub_InitializeStatic(EventHub_T *hub, EventHub_Storage_T *storage);
+#endif /* if KISO_UTILS_STATIC_ALLOCATION */
+
 /**
  * @brief
  *      This function adds an observe of a given event to a hub
@@ -122,6 +235,85 @@ Retcode_T EventHub_Observe(EventHub_T *hub, EventHandler_T handler, TaskEvent_T
  */
 Retcode_T EventHub_ObserveAll(EventHub_T *hub, EventHandler_T handler);
 
+#if KISO_FEATURE_CMDPROCESSOR
+
+/**
+ * @brief
+ *      This function adds an observe of a given event to a hub, the observer is
+ *      called by a command processor
+ *
+ * @param[in] hub
+ *      A pointer to an EventHub structure
+ * @param[in] handler
+ *      A function pointer to the user-code run function that
+ *      should be called when the event is signaled
+ * @param[in] event
+ *      The event that should be observed
+ * @param[in] cmdProcessor
+ *      The command processor which calls the handler
+ * @param[in] isCoalesced
+ *      If true, a notification of the event while the previous one still waits
+ *      for the command processor only replaces its data
+ *
+ * @note
+ *      The data handed to EventHub_Notify() must stay valid until the handler
+ *      has been called.
+ *
+ * @retval #RETCODE_OK
+ *      When the observation is added successfully
+ * @retval #RETCODE_NULL_POINTER
+ *      When the hub, handler or cmdProcessor pointer is NULL
+ * @retval #RETCODE_UNINITIALIZED
+ *      When the hub has not been initialized previously
+ * @retval #RETCODE_SEMAPHORE_ERROR
+ *      When the hub lock can't be taken or released successfully
+ * @retval #RETCODE_OUT_OF_RESOURCES
+ *      When the maximum number of observation is already reached
+ *      (see #CONFIG_EVENTHUB_MAX_OBSERVERS)
+ */
+Retcode_T EventHub_ObserveAsync(EventHub_T *hub, EventHandler_T handler, TaskEvent_T event, CmdProcessor_T *cmdProcessor, bool isCoalesced);
+
+/**
+ * @brief
+ *      This function adds an observe of all events to a hub, the observer is
+ *      called by a command processor
+ *
+ * @param[in] hub
+ *      A pointer to an EventHub structure
+ * @param[in] handler
+ *      A function pointer to the user-code run function that
+ *      should be called when the event is signaled
+ * @param[in] cmdProcessor
+ *      The command processor which calls the handler
+ * @param[in] isCoalesced
+ *      If true, a notification of the same event as the latest one still waiting
+ *      for the command processor only replaces its data
+ *
+ * @retval See EventHub_ObserveAsync()
+ */
+Retcode_T EventHub_ObserveAllAsync(EventHub_T *hub, EventHandler_T handler, CmdProcessor_T *cmdProcessor, bool isCoalesced);
+
+/**
+ * @brief
+ *      This function reads the figures of the asynchronous deliveries of a hub
+ *
+ * @param[in] hub
+ *      A pointer to an EventHub structure
+ * @param[out] statistics
+ *      The figures of the hub
+ * @param[in] isReset
+ *      If true, the counters, the latencies and the highest depth start again
+ *      from the current depth
+ *
+ * @retval #RETCODE_OK
+ *      When the figures are read successfully
+ * @retval #RETCODE_NULL_POINTER
+ *      When the hub or statistics pointer is NULL
+ */
+Retcode_T EventHub_GetAsyncStatistics(EventHub_T *hub, EventHubAsyncStatistics_T *statistics, bool isReset);
+
+#endif /* if KISO_FEATURE_CMDPROCESSOR */
+
 /**
  * @brief
  *      This function informs the hub that a given event has occurred
@@ -134,7 +326,13 @@ Retcode_T EventHub_ObserveAll(EventHub_T *hub, EventHandler_T handler);
  *      Additional data to hand to the observer
  *
  * @note
- *      Event notifications from interrupt context is not supported.
+ *      The observers of the event are called in the order of their registration,
+ *      followed by the observers of all events. The hub lock is not taken, so an
+ *      observer may notify further events or register further observers.
+ *      Asynchronous observers are only queued in their command processor.
+ *
+ * @note
+ *      Use EventHub_NotifyFromIsr() in interrupt context.
  *
  * @retval #RETCODE_OK
  *      When all observers have been notified successfully
@@ -142,11 +340,46 @@ Retcode_T EventHub_ObserveAll(EventHub_T *hub, EventHandler_T handler);
  *      When the hub pointer is NULL
  * @retval #RETCODE_UNINITIALIZED
  *      When the hub has not been initialized previously
- * @retval #RETCODE_SEMAPHORE_ERROR
- *      When the hub lock can't be taken or released successfully
+ * @retval #RETCODE_OUT_OF_RESOURCES
+ *      When the notification is lost for an asynchronous observer, as the hub or the
+ *      command processor queue is full. The other observers are notified.
  */
 Retcode_T EventHub_Notify(EventHub_T *hub, TaskEvent_T Event, const void *data);
 
+/**
+ * @brief
+ *      This function informs the hub from interrupt context that a given event has
+ *      occurred
+ *
+ * @details
+ *      The notification is queued in the hub and the observers are called later by
+ *      the timer service task of FreeRTOS, in the same way as by EventHub_Notify().
+ *      Notifications from interrupts are delivered in the order they were made.
+ *      Up to CONFIG_EVENTHUB_ISR_QUEUE_SIZE notifications may wait for delivery.
+ *
+ * @param[in] hub
+ *      A pointer to an EventHub structure
+ * @param[in] event
+ *      The event that occurred
+ * @param[in] data
+ *      Additional data to hand to the observer, it must stay valid until delivery
+ *
+ * @retval #RETCODE_OK
+ *      When the notification is queued for delivery
+ * @retval #RETCODE_NULL_POINTER
+ *      When the hub pointer is NULL
+ * @retval #RETCODE_UNINITIALIZED
+ *      When the hub has not been initialized previously
+ * @retval #RETCODE_OUT_OF_RESOURCES
+ *      When the queue of the hub is full, the notification is lost
+ * @retval #RETCODE_FAILURE
+ *      When the delivery can't be handed to the timer service task, the
+ *      notification is delivered together with the next one
+ * @retval #RETCODE_NOT_SUPPORTED
+ *      When the FreeRTOS timers are disabled (configUSE_TIMERS)
+ */
+Retcode_T EventHub_NotifyFromIsr(EventHub_T *hub, TaskEvent_T event, const void *data);
+
 #endif /* if KISO_FEATURE_EVENTHUB */
 
 #endif /* KISO_EVENTHUB_H_ */
@@ -39,6 +39,16 @@
  *             execution of function will not be resumed. 
  *      Responsibility to handle such situations is transfered to user code.
  *
+ *      With KISO_UTILS_TASK_NOTIFICATIONS the task is signaled by incrementing its notification
+ *      value instead of giving a binary semaphore. The value belongs to the guarded task, so the
+ *      run function must not take notifications of its own with ulTaskNotifyTake() or
+ *      xTaskNotifyWait(). Waiting in the UART and I2C transceivers is fine, they leave the value
+ *      alone.
+ *
+ *      With KISO_UTILS_STATIC_ALLOCATION, GuardedTask_InitializeStatic() creates the task and
+ *      its semaphore in a #GuardedTask_Storage_T and a stack given by the caller instead of the
+ *      FreeRTOS heap. Both must stay valid until GuardedTask_Deinitialize().
+ *
  * @code{.c}
  * #include "Kiso_GuardedTask.h"
  *
@@ -86,6 +96,9 @@
 
 #include "Kiso_Basics.h"
 #include "Kiso_Retcode.h"
+#if KISO_UTILS_STATIC_ALLOCATION
+#include "FreeRTOS.h"
+#endif
 
 /* public type and macro definitions */
 typedef void (*GuardedTask_Function_T)(void);
@@ -97,12 +110,27 @@ typedef void *GuardedTask_SemaphoreHandle_T;
 struct GuardedTask_S
 {
     GuardedTask_TaskHandle_T task;
+#if !KISO_UTILS_TASK_NOTIFICATIONS
     GuardedTask_SemaphoreHandle_T signal;
+#endif
     GuardedTask_Function_T runFunction;
 };
 
 typedef struct GuardedTask_S GuardedTask_T;
 
+#if KISO_UTILS_STATIC_ALLOCATION
+/** Storage of the FreeRTOS objects of a guarded task, see GuardedTask_InitializeStatic() */
+struct GuardedTask_Storage_S
+{
+    StaticTask_t task;
+#if !KISO_UTILS_TASK_NOTIFICATIONS
+    StaticSemaphore_t signal;
+#endif
+};
+
+typedef struct GuardedTask_Storage_S GuardedTask_Storage_T;
+#endif /* if KISO_UTILS_STATIC_ALLOCATION */
+
 /* public function prototype declarations */
 
 /** @brief
@@ -129,6 +157,35 @@ typedef struct GuardedTask_S GuardedTask_T;
  */
 Retcode_T GuardedTask_Initialize(GuardedTask_T *handle, GuardedTask_Function_T taskRunFunction, const char *taskName, uint32_t taskPriority, uint32_t taskStackSize);
 
+#if KISO_UTILS_STATIC_ALLOCATION
+/** @brief
+ *      This function initializes a given GuardedTask handle like GuardedTask_Initialize(),
+ *      but creates the task and its semaphore in the given storage instead of the FreeRTOS heap.
+ *
+ * @param[in] handle
+ *      A pointer to an empty GuardedTask structure
+ * @param[in] taskRunFunction
+ *      A function pointer to the user-code run function that should be called by the task
+ * @param[in] taskName
+ *      A cstring representing the name of the task
+ * @param[in] taskPriority
+ *      The task priority
+ * @param[in] taskStackSize
+ *      The task stack size, in words
+ * @param[in] taskStack
+ *      The stack of the task, taskStackSize words
+ * @param[in] storage
+ *      The storage of the task and its semaphore
+ *
+ * @retval  #RETCODE_OK
+ *      Guarded Task has been initialized successfully
+ * @retval  #RETCODE_INVALID_PARAM
+ *      One of the parameters was invalid
+ */
+Retcode_T GuardedTask_InitializeStatic(GuardedTask_T *handle, GuardedTask_Function_T taskRunFunction, const char *taskName, uint32_t taskPriority, uint32_t taskStackSize,
+                                       StackType_t *taskStack, GuardedTask_Storage_T *storage);
+#endif /* if KISO_UTILS_STATIC_ALLOCATION */
+
 /**  @brief
  *      This function deinitializes a given GuardTask handle and sets all attributes to NULL.
  *
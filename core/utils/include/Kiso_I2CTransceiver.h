@@ -56,6 +56,9 @@
  *
  * @endcode
  *
+ * With KISO_UTILS_STATIC_ALLOCATION, I2CTransceiver_InitStatic() creates the semaphores
+ * in an #I2cTranceiverStorage_T given by the caller instead of the FreeRTOS heap.
+ *
  * @file
  */
 #ifndef KISO_I2CTRANSCEIVER_H_
@@ -69,6 +72,9 @@
 #include "Kiso_HAL.h"
 #if KISO_FEATURE_I2C
 #include "Kiso_MCU_I2C.h"
+#if KISO_UTILS_STATIC_ALLOCATION
+#include "FreeRTOS.h"
+#endif
 
 /** Struct holding the I2C related configuration */
 struct I2cTranceiverHandle_S
@@ -76,8 +82,15 @@ struct I2cTranceiverHandle_S
     bool InitializationStatus;
     /* I2C Handle used by the I2C driver in Essentials */
     I2C_T I2CHandle;
+#if KISO_UTILS_TASK_NOTIFICATIONS
+    /*task waiting for the end of the read/write process*/
+    void *I2CWaitingTask;
+    /*set at the end of the read/write process, until the waiting task sees it*/
+    bool I2CTransferDone;
+#else
     /*semaphore used to synchronize the read/write process*/
     void *I2CBusSync;
+#endif
     /*mutex used to synchronize the access of read/write process*/
     void *I2CMutexLock;
     /* status of I2C transfer*/
@@ -85,6 +98,18 @@ struct I2cTranceiverHandle_S
 };
 typedef struct I2cTranceiverHandle_S I2cTranceiverHandle_T, *I2cTranceiverHandlePtr_T;
 
+#if KISO_UTILS_STATIC_ALLOCATION
+/** Struct holding the semaphores of an I2C transceiver, see I2CTransceiver_InitStatic() */
+struct I2cTranceiverStorage_S
+{
+#if !KISO_UTILS_TASK_NOTIFICATIONS
+    StaticSemaphore_t I2CBusSync;
+#endif
+    StaticSemaphore_t I2CMutexLock;
+};
+typedef struct I2cTranceiverStorage_S I2cTranceiverStorage_T;
+#endif
+
 /**
  * @brief
  *      Initializes the transceiver for the use with the passed I2C handle.
@@ -102,13 +127,38 @@ typedef struct I2cTranceiverHandle_S I2cTranceiverHandle_T, *I2cTranceiverHandle
  *      If any of the parameter is NULL.
  * @retval #RETCODE_SEMAPHORE_ERROR
  *      If the semaphores are not created (see #I2cTranceiverHandle_T.I2CBusSync
- *      and #I2cTranceiverHandle_T.I2CMutexLock).
+ *      and #I2cTranceiverHandle_T.I2CMutexLock, only the latter with
+ *      KISO_UTILS_TASK_NOTIFICATIONS).
  * @retval #RETCODE_DOPPLE_INITIALIZATION
  *      If you are trying to initialize the transceiver again.
  * 
  */
 Retcode_T I2CTransceiver_Init(I2cTranceiverHandlePtr_T i2cTransceiver, I2C_T i2cHandle);
 
+#if KISO_UTILS_STATIC_ALLOCATION
+/**
+ * @brief
+ *      Initializes the transceiver like I2CTransceiver_Init(), but creates the
+ *      semaphores in the given storage instead of the FreeRTOS heap.
+ *
+ * @param [in] i2cTransceiver
+ *      A pointer to be initialized for I2C transceiver context structure to be initialized.
+ *
+ * @param [in] i2cHandle
+ *      The handle of the I2C to be used by the transceiver. The handle
+ *      must be initialized before passing it here.
+ *
+ * @param [in] storage
+ *      The storage of the semaphores, valid until I2CTransceiver_Deinit().
+ *
+ * @retval #RETCODE_OK
+ *      If successfully initialized.
+ * @retval #RETCODE_NULL_POINTER
+ *      If any of the parameter is NULL.
+ */
+Retcode_T I2CTransceiver_InitStatic(I2cTranceiverHandlePtr_T i2cTransceiver, I2C_T i2cHandle, I2cTranceiverStorage_T *storage);
+#endif
+
 /**
  * @brief
  *      Function to read a register of a device connected to I2C
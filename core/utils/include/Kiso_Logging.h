@@ -279,6 +279,12 @@ typedef Retcode_T (*LogRecordDeinit_T)(void *self);
  */
 typedef Retcode_T (*LogRecordWrite_T)(void *self, LogLevel_T level, uint8_t package, uint8_t module, const char *file, uint32_t line, const char *fmt, va_list args);
 
+/**
+ * @brief
+ *      A function pointer type to pass a recorded message on to the appenders, see #Logging_AddAppender.
+ */
+typedef Retcode_T (*LogRecordAppend_T)(void *self, LogLevel_T level, const char *message, uint32_t length);
+
 /**
  * @brief
  *      A function pointer type to log appender initializer.
@@ -312,6 +318,7 @@ typedef struct
     LogRecordWrite_T Write;
     void *Wakeup;
     LogAppender_T Appender;
+    LogRecordAppend_T Append; /**< Set by Logging_Init(), recorders write to Appender if NULL */
 } LogRecorder_T;
 
 /**
@@ -326,18 +333,50 @@ extern const LogRecorder_T *Logging_AsyncRecorder;
  */
 extern const LogRecorder_T *Logging_SyncRecorder;
 
+/**
+ * @brief
+ *      External reference to log binary recorder, which defers formatting to the host.
+ *
+ * @details
+ *      The appender receives XProtocol frames instead of text lines. They are turned back into text
+ *      with core/utils/tools/log_decoder.py and the ELF file of the application.
+ */
+extern const LogRecorder_T *Logging_BinaryRecorder;
+
 /**
  * @brief
  *      External reference to log UART appender.
  */
 extern const LogAppender_T *Logging_UARTAppender;
 
+/**
+ * @brief
+ *      External reference to log UART appender with batched, non-blocking transfers.
+ *
+ * @details
+ *      Collects log lines in one of two buffers of LOG_UART_DMA_BUFFER_SIZE bytes while the other
+ *      one is sent. A buffer is sent when it is full or LOG_UART_DMA_FLUSH_TIMEOUT ms after its
+ *      first line. Uses the same UART as #Logging_UARTAppender, only one of both can be used.
+ */
+extern const LogAppender_T *Logging_UARTDMAAppender;
+
 /**
  * @brief
  *      External reference to log external flash appender.
  */
 extern const LogAppender_T *Logging_ExtFlashMemAppender;
 
+/**
+ * @brief
+ *      External reference to log RAM appender.
+ *
+ * @details
+ *      Keeps the latest LOG_RAM_APPENDER_SIZE bytes of log output in a ring buffer in the .noinit
+ *      section, which is not cleared by a warm reset. After a crash the log can be read with
+ *      #Logging_ReadRAMAppender, or by a debugger from the symbol LogRamAppenderBuffer.
+ */
+extern const LogAppender_T *Logging_RAMAppender;
+
 /**
  * @brief
  *      Initializes the log recorder and appender engines.
@@ -359,6 +398,35 @@ extern const LogAppender_T *Logging_ExtFlashMemAppender;
  */
 Retcode_T Logging_Init(const LogRecorder_T *recorder, const LogAppender_T *appender);
 
+/**
+ * @brief
+ *      Adds an appender, which gets the messages up to the given level.
+ *
+ * @details
+ *      The appender passed to #Logging_Init gets all messages passing the filters. Further appenders
+ *      are initialized here and get the same messages as long as their level is not exceeded. Adding
+ *      an appender again only changes its level, which also applies to the appender passed to
+ *      #Logging_Init. Messages above the levels of all appenders are dropped before they are
+ *      recorded.
+ *
+ * @param [in] appender
+ *      A log appender implementation.
+ * @param [in] level
+ *      The highest level written to the appender.
+ *
+ * @retval RETCODE_OK
+ *      If successfully added
+ * @retval RETCODE_INVALID_PARAM
+ *      If appender or any of its attributes is null
+ * @retval RETCODE_UNINITIALIZED
+ *      If the logger has not been initialized previously
+ * @retval RETCODE_OUT_OF_RESOURCES
+ *      If LOG_APPENDER_COUNT appenders have been added already
+ * @return
+ *      Errors from appender.Init (see #LogAppenderInit_T) will be returned
+ */
+Retcode_T Logging_AddAppender(const LogAppender_T *appender, LogLevel_T level);
+
 /**
  * @brief
  *      Log a message
@@ -375,6 +443,45 @@ Retcode_T Logging_Init(const LogRecorder_T *recorder, const LogAppender_T *appen
  */
 Retcode_T Logging_Log(LogLevel_T level, uint8_t package, uint8_t module, const char *file, uint32_t line, const char *fmt, ...);
 
+#if KISO_RAM_APPENDER
+/**
+ * @brief
+ *      Reads the log kept by the RAM appender, also after a warm reset.
+ *
+ * @param [in] position
+ *      Offset into the kept log, 0 is the oldest byte still kept.
+ * @param [out] buffer
+ *      Buffer for the log.
+ * @param [in] size
+ *      Size of the buffer.
+ *
+ * @return
+ *      Number of bytes copied to the buffer, 0 once the end of the log is reached
+ */
+uint32_t Logging_ReadRAMAppender(uint32_t position, char *buffer, uint32_t size);
+
+/**
+ * @brief
+ *      Discards the log kept by the RAM appender.
+ */
+void Logging_ClearRAMAppender(void);
+#endif /* KISO_RAM_APPENDER */
+
+#if KISO_ASYNC_RECORDER
+/**
+ * @brief
+ *      Number of messages the asynchronous recorder has dropped because its queue was full.
+ *
+ * @details
+ *      Messages are dropped instead of blocking the caller, see LOG_QUEUE_BUFFER_SIZE. The logging
+ *      task also reports newly dropped messages in the log itself.
+ *
+ * @return
+ *      Dropped messages since the recorder was initialized
+ */
+uint32_t Logging_GetDroppedCount(void);
+#endif /* KISO_ASYNC_RECORDER */
+
 /**
  * @brief
  *      Log filter id type.
@@ -449,6 +556,66 @@ Retcode_T LogFilter_Configure(LogFilterId_T id, LogLevel_T level, uint8_t packag
  */
 bool LogFilter_Apply(LogLevel_T level, uint8_t package, uint8_t module);
 
+#if KISO_LOG_RATE_LIMIT
+/**
+ * @brief
+ *      Messages of a call site suppressed by the rate limit, see LogRateLimit_TakeSuppressed().
+ */
+typedef struct
+{
+    const char *File;
+    uint32_t Line;
+    LogLevel_T Level; /**< level of the last suppressed message */
+    uint8_t Package;
+    uint8_t Module;
+    uint32_t Suppressed;
+} LogRateLimitReport_T;
+
+/**
+ * @brief
+ *      An internal function to check if a call site is within its budget of messages.
+ *
+ * @details
+ *      A call site may log LOG_RATE_LIMIT_BUDGET_<level> messages per LOG_RATE_LIMIT_WINDOW ms,
+ *      further messages in the window are counted. Levels with a budget of 0 are not limited.
+ *
+ * @param [in] level
+ *      A log level.
+ * @param [in] package
+ *      A package id.
+ * @param [in] module
+ *      A log module id.
+ * @param [in] file
+ *      The file of the call site.
+ * @param [in] line
+ *      The line of the call site.
+ * @param [out] suppressed
+ *      Messages of the call site suppressed in its previous window, only set for the first
+ *      message of a window, 0 otherwise.
+ *
+ * @return True
+ *      If the message is to be logged, false if it is suppressed.
+ */
+bool LogRateLimit_Apply(LogLevel_T level, uint8_t package, uint8_t module, const char *file, uint32_t line, uint32_t *suppressed);
+
+/**
+ * @brief
+ *      An internal function to take the count of a call site other than the logging one.
+ *
+ * @details
+ *      Counts are left by call sites which were replaced in the table of LogRateLimit_Apply(),
+ *      or whose window ended without a further message. Each message takes them all, so no
+ *      count waits longer than for the next message of any call site.
+ *
+ * @param [out] report
+ *      The call site and its count, only set if one was taken.
+ *
+ * @return True
+ *      If a count was taken, false if there is none left.
+ */
+bool LogRateLimit_TakeSuppressed(LogRateLimitReport_T *report);
+#endif /* KISO_LOG_RATE_LIMIT */
+
 #endif /* if KISO_FEATURE_LOGGING */
 
 #endif /* KISO_LOGGING_H */
@@ -28,6 +28,27 @@
  *     for buffering or for synchronization.
  * @par Utilization
  *     Please refer directly to the functions to understand how to use it.
+ * @par Buffer pipes
+ *     A pipe created by PipeAndFilter_CreateBufferPipe() does not copy the data, it carries
+ *     buffers of a pool created by PipeAndFilter_CreatePool(). A buffer is owned by one filter
+ *     at a time, which may change it in place and hand it on to the next pipe, so the data is
+ *     not copied between the stages and a filter task does not need stack for the data.
+ * @par Fusion and batching
+ *     Every filter has its own task, so each stage of a chain costs a context switch per message.
+ *     Cheap stages can be fused with PipeAndFilter_CreateFusedFilter(), which runs them one after
+ *     the other in a single task. PipeAndFilter_SetBatchSize() lets a filter process all the
+ *     messages waiting in its input pipe each time it wakes up. PipeAndFilter_GetStatistics()
+ *     reports the throughput of every stage and the high-water mark of the input pipe.
+ * @par Topologies
+ *     A filter may write to several pipes, see PipeAndFilter_SetOutputPipes(), and several filters
+ *     may write to the same pipe. Byte pipes with several writers must be created by
+ *     PipeAndFilter_CreateMergePipe(), buffer pipes take any number of writers. What a writer does
+ *     when a pipe is full is the policy of the pipe, see PipeAndFilter_SetPolicy(), so a slow
+ *     consumer does not need to stall the producer.
+ * @par Static allocation
+ *     With KISO_UTILS_STATIC_ALLOCATION, the *Static() variants of the creational APIs create the
+ *     pipes, filters and pools in storage given by the caller instead of the FreeRTOS heap. The
+ *     storage must stay valid as long as the pipe, filter or pool is used.
  * @par Extension
  *     You are free to propose a different implementation for this API. We will try to have per OS a specific implementation.
  *     The different implementations will be saved under source/<OS name>/.
@@ -42,6 +63,9 @@
 
 #include "Kiso_Retcode.h"
 #include "PipeAndFilterConfig.h"
+#if KISO_UTILS_STATIC_ALLOCATION
+#include "FreeRTOS.h"
+#endif
 
 /**
  * @brief
@@ -61,6 +85,90 @@
  */
 typedef Retcode_T (*PipeAndFilter_FilterFunction_T)(uint8_t *bufferIn, uint32_t bufferInSize, uint8_t *bufferOut, uint32_t *bufferOutSize);
 
+/**
+ * @brief
+ *     Will contain a pointer to an internal pool structure.
+ *     In case of FreeRTOS, it will contain a queue handle holding the free buffers.
+ */
+typedef void *PipeAndFilter_PoolInternalHandle_T;
+
+/**
+ * @brief
+ *     Pool of buffers of the same size, see PipeAndFilter_CreatePool().
+ * @warning
+ *     Do not modify it yourself! The creational APIs will do it for you.
+ */
+typedef struct PipeAndFilter_Pool_S
+{
+    PipeAndFilter_PoolInternalHandle_T poolInternalHandle; /**< link to the free buffers */
+    uint32_t bufferSize;                                   /**< Size of each buffer */
+} PipeAndFilter_Pool_T;
+
+/**
+ * @brief
+ *     Buffer of a pool, passed between filters by buffer pipes.
+ */
+typedef struct PipeAndFilter_Buffer_S
+{
+    uint8_t *data;                     /**< Data of the buffer, may be changed in place by its owner */
+    uint32_t length;                   /**< Number of bytes of data, set by its owner */
+    uint32_t size;                     /**< Size of data */
+    struct PipeAndFilter_Pool_S *pool; /**< Pool the buffer is released to */
+    uint32_t references;               /**< Number of owners, the buffer is back in the pool once all released it */
+} PipeAndFilter_Buffer_T;
+
+/**
+ * @brief
+ *     Function pattern used to define a filter between buffer pipes
+ * @param [in] bufferIn
+ *     Buffer received from the input pipe, NULL for a filter without input pipe.
+ *     The filter owns it during the call.
+ * @param [in,out] bufferOut
+ *     Buffer to put in the output pipe, set to bufferIn before the call. The filter may
+ *     leave it to hand bufferIn on, set it to another buffer it allocated, or set it to
+ *     NULL to pass nothing on. The input buffer is released unless it is handed on, a
+ *     buffer which cannot be passed on is released as well.
+ * @return
+ *     RETCODE_OK - If everything was fine \n
+ *     OTHER - Needs to be define by the user, the output buffer is released \n
+ */
+typedef Retcode_T (*PipeAndFilter_BufferFilterFunction_T)(PipeAndFilter_Buffer_T *bufferIn, PipeAndFilter_Buffer_T **bufferOut);
+
+/**
+ * @brief
+ *     Statistics of a filter stage, see PipeAndFilter_GetStatistics().
+ * @note
+ *     The activations and the high-water mark concern the input pipe of the filter, so they are
+ *     only counted for the first stage of a fused filter. Buffer filters count buffers as messages
+ *     and bytes, and the high-water mark in buffers.
+ */
+typedef struct PipeAndFilter_Statistics_S
+{
+    uint32_t activations;     /**< Number of times the filter woke up for input */
+    uint32_t messagesIn;      /**< Number of messages the stage processed */
+    uint32_t messagesOut;     /**< Number of messages the stage passed on */
+    uint32_t bytesIn;         /**< Number of bytes the stage processed */
+    uint32_t bytesOut;        /**< Number of bytes the stage passed on */
+    uint32_t errors;          /**< Number of messages the stage failed on */
+    uint32_t pipeInHighWater; /**< Most bytes waiting in the input pipe when the filter woke up */
+} PipeAndFilter_Statistics_T;
+
+/**
+ * @brief
+ *     Stage of a filter, see PipeAndFilter_CreateFusedFilter().
+ */
+typedef struct PipeAndFilter_Stage_S
+{
+    PipeAndFilter_FilterFunction_T filterFunction; /**< filter function of the stage, set by the user */
+    PipeAndFilter_Statistics_T statistics;         /**< Statistics of the stage, do not modify it yourself */
+} PipeAndFilter_Stage_T;
+
+/**
+ * @brief
+ *     Batch size of a filter processing all the messages waiting in its input pipe, see PipeAndFilter_SetBatchSize().
+ */
+#define PIPEANDFILTER_BATCH_ALL UINT32_MAX
+
 /**
  * @brief
  *     Will contain a pointer to an internal pipe structure.
@@ -68,6 +176,24 @@ typedef Retcode_T (*PipeAndFilter_FilterFunction_T)(uint8_t *bufferIn, uint32_t
  */
 typedef void *PipeAndFilter_PipeInternalHandle_T;
 
+/**
+ * @brief
+ *     Will contain a pointer to an internal lock structure.
+ *     In case of FreeRTOS, it will contain a mutex handle.
+ */
+typedef void *PipeAndFilter_LockInternalHandle_T;
+
+/**
+ * @brief
+ *     What a writer does when a pipe is full, see PipeAndFilter_SetPolicy().
+ */
+typedef enum PipeAndFilter_Policy_E
+{
+    PIPEANDFILTER_POLICY_BLOCK,       /**< The writing filter waits until the pipe has room */
+    PIPEANDFILTER_POLICY_DROP_NEWEST, /**< The message which does not fit is dropped */
+    PIPEANDFILTER_POLICY_DROP_OLDEST, /**< The oldest messages of the pipe are dropped to make room, buffer pipes only */
+} PipeAndFilter_Policy_T;
+
 /**
  * @brief
  *     Will contain a pointer to an internal filter handle structure.
@@ -85,6 +211,10 @@ typedef struct PipeAndFilter_Pipe_S
 {
     PipeAndFilter_FilterInternalHandle_T filterInternalHandle; /**< link to the receiver handle */
     PipeAndFilter_PipeInternalHandle_T pipeInternalHandle;     /**< link to the pipe handle */
+    PipeAndFilter_LockInternalHandle_T lockInternalHandle;     /**< Serializes the writers of a merge pipe */
+    PipeAndFilter_Policy_T policy;                             /**< What a writer does when the pipe is full */
+    bool isBufferPipe;                                         /**< The pipe carries buffers instead of bytes */
+    uint32_t dropped;                                          /**< Number of messages dropped by the policy */
 } PipeAndFilter_Pipe_T;
 
 /**
@@ -96,9 +226,16 @@ typedef struct PipeAndFilter_Pipe_S
 typedef struct PipeAndFilter_Filter_S
 {
     PipeAndFilter_FilterFunction_T filterFunction;             /**< filter function to call */
+    PipeAndFilter_BufferFilterFunction_T bufferFilterFunction; /**< filter function to call, for buffer pipes */
     PipeAndFilter_Pipe_T *pipeInHandle;                        /**< Pipe as input */
     PipeAndFilter_Pipe_T *pipeOutHandle;                       /**< Pipe as output */
+    PipeAndFilter_Pipe_T **pipeOutHandles;                     /**< Pipes every output goes to */
+    uint32_t pipeOutCount;                                     /**< Number of output pipes */
     PipeAndFilter_FilterInternalHandle_T filterInternalHandle; /**< Internal handle */
+    PipeAndFilter_Stage_T stage;                               /**< Stage of a filter which is not fused */
+    PipeAndFilter_Stage_T *stages;                             /**< Stages run one after the other on each message */
+    uint32_t stageCount;                                       /**< Number of stages */
+    uint32_t batchSize;                                        /**< Most messages processed per activation */
 } PipeAndFilter_Filter_T;
 
 /******** Creational *********/
@@ -128,6 +265,56 @@ typedef struct PipeAndFilter_Filter_S
  */
 Retcode_T PipeAndFilter_CreatePipe(PipeAndFilter_Pipe_T *pipeHandle);
 
+/**
+ * @brief
+ *     Create a pipe which several filters may write to.
+ * @param [out] pipeHandle
+ *     Handle to the pipe.
+ * @return
+ *     RETCODE_OK - Success \n
+ *     RETCODE_NULL_POINTER - pipeHandle was NULL \n
+ *     RETCODE_OUT_OF_RESOURCES - FreeRTOS heap does not have enough space to create the resource \n
+ *
+ * @note
+ *     A byte pipe takes one writer at a time, the writers of a merge pipe take turns with a mutex.
+ *     A merge pipe cannot be filled from ISR context. Buffer pipes need no merge variant.
+ */
+Retcode_T PipeAndFilter_CreateMergePipe(PipeAndFilter_Pipe_T *pipeHandle);
+
+/**
+ * @brief
+ *     Set what the writers of a pipe do when it is full.
+ * @param [in] pipeHandle
+ *     Handle of the pipe.
+ * @param [in] policy
+ *     The policy, a pipe created by the creational APIs blocks its writers.
+ * @return
+ *     RETCODE_OK - Success \n
+ *     RETCODE_NULL_POINTER - pipeHandle was NULL \n
+ *     RETCODE_INVALID_PARAM - The policy is unknown \n
+ *     RETCODE_NOT_SUPPORTED - PIPEANDFILTER_POLICY_DROP_OLDEST for a byte pipe, which only its filter may read \n
+ *
+ * @note
+ *     The policy applies to the filters writing to the pipe. The fill functions never wait, they
+ *     report a full pipe to the caller whatever the policy. A dropped buffer is released.
+ *
+ * @code
+ *    // The uplink may lag behind, the acquisition keeps the latest samples for it
+ *    (void)PipeAndFilter_SetPolicy(&uplinkPipe, PIPEANDFILTER_POLICY_DROP_OLDEST);
+ * @endcode
+ */
+Retcode_T PipeAndFilter_SetPolicy(PipeAndFilter_Pipe_T *pipeHandle, PipeAndFilter_Policy_T policy);
+
+/**
+ * @brief
+ *     Get the number of messages the policy of a pipe dropped.
+ * @param [in] pipeHandle
+ *     Handle of the pipe.
+ * @return
+ *     Number of messages dropped since the pipe was created, 0 if pipeHandle is NULL.
+ */
+uint32_t PipeAndFilter_GetDropped(const PipeAndFilter_Pipe_T *pipeHandle);
+
 /**
  * @brief
  *     Create a filter.
@@ -186,6 +373,199 @@ Retcode_T PipeAndFilter_CreatePipe(PipeAndFilter_Pipe_T *pipeHandle);
  */
 Retcode_T PipeAndFilter_CreateFilter(PipeAndFilter_FilterFunction_T filterFunction, PipeAndFilter_Pipe_T *pipeInHandle, PipeAndFilter_Pipe_T *pipeOutHandle, PipeAndFilter_Filter_T *filterHandle);
 
+/**
+ * @brief
+ *     Create a filter which runs a chain of filter functions in a single task.
+ * @param [in] stages
+ *     Array of stages with their filter functions set, kept by the caller as long as the filter is used.
+ *     The output of each stage is the input of the next one, the output of the last stage is put in
+ *     the output pipe. A stage which outputs no bytes ends the chain for the message.
+ * @param [in] stageCount
+ *     Number of stages.
+ * @param [in] pipeInHandle
+ *     Handle of the input pipe, or NULL. In the case of no input pipe, the first stage will behave like a while loop.
+ * @param [in] pipeOutHandle
+ *     Handle of the output pipe, or NULL.
+ * @param [out] filterHandle
+ *     Handle of the filter.
+ * @return
+ *    RETCODE_OK - Success \n
+ *    RETCODE_NULL_POINTER - stages, one of their functions or filterHandle was NULL \n
+ *    RETCODE_INVALID_PARAM - stageCount is 0 \n
+ *    RETCODE_OUT_OF_RESOURCES - FreeRTOS heap does not have enough space to create the resource \n
+ *
+ * @note
+ *     Fusing saves the task, the pipe and the context switches between the stages. It suits stages
+ *     which are cheap compared to a context switch, a slow stage delays all the stages of its chain.
+ *
+ * @code
+ *    PipeAndFilter_Stage_T stages[] = {{.filterFunction = decode}, {.filterFunction = scale}, {.filterFunction = encode}};
+ *
+ *    (void)PipeAndFilter_CreateFusedFilter(stages, 3, &pipe1, &pipe2, &filter1);
+ * @endcode
+ */
+Retcode_T PipeAndFilter_CreateFusedFilter(PipeAndFilter_Stage_T *stages, uint32_t stageCount, PipeAndFilter_Pipe_T *pipeInHandle, PipeAndFilter_Pipe_T *pipeOutHandle, PipeAndFilter_Filter_T *filterHandle);
+
+/**
+ * @brief
+ *     Create a pool of buffers for buffer pipes.
+ * @param [out] pool
+ *     Handle to the pool.
+ * @param [in] buffers
+ *     Array of count buffer structures, kept by the caller as long as the pool is used.
+ * @param [in] memory
+ *     Memory of count * bufferSize bytes for the data of the buffers, kept by the caller as long as the pool is used.
+ * @param [in] count
+ *     Number of buffers.
+ * @param [in] bufferSize
+ *     Size of each buffer.
+ * @return
+ *     RETCODE_OK - Success \n
+ *     RETCODE_NULL_POINTER - One of the inputs was NULL \n
+ *     RETCODE_INVALID_PARAM - count or bufferSize is 0 \n
+ *     RETCODE_OUT_OF_RESOURCES - FreeRTOS heap does not have enough space to create the resource \n
+ *
+ * @code
+ *     #define SAMPLES_BUFFERS 4
+ *     #define SAMPLES_SIZE 256
+ *
+ *     PipeAndFilter_Pool_T samplesPool;
+ *     PipeAndFilter_Buffer_T samplesBuffers[SAMPLES_BUFFERS];
+ *     uint8_t samplesMemory[SAMPLES_BUFFERS * SAMPLES_SIZE];
+ *
+ *     Retcode_T init(void)
+ *     {
+ *         return PipeAndFilter_CreatePool(&samplesPool, samplesBuffers, samplesMemory, SAMPLES_BUFFERS, SAMPLES_SIZE);
+ *     }
+ * @endcode
+ */
+Retcode_T PipeAndFilter_CreatePool(PipeAndFilter_Pool_T *pool, PipeAndFilter_Buffer_T *buffers, uint8_t *memory, uint32_t count, uint32_t bufferSize);
+
+/**
+ * @brief
+ *     Create a pipe which carries buffers of pools instead of copies of the data.
+ * @param [out] pipeHandle
+ *     Handle to the pipe.
+ * @return
+ *     RETCODE_OK - Success \n
+ *     RETCODE_NULL_POINTER - pipeHandle was NULL \n
+ *     RETCODE_OUT_OF_RESOURCES - FreeRTOS heap does not have enough space to create the resource \n
+ *
+ * @note
+ *     The number of buffers a pipe holds is defined by BUFFER_PIPE_DEPTH in the configuration "PipeAndFilterCfg.h".
+ *     A buffer pipe can only be connected to filters created by PipeAndFilter_CreateBufferFilter().
+ */
+Retcode_T PipeAndFilter_CreateBufferPipe(PipeAndFilter_Pipe_T *pipeHandle);
+
+/**
+ * @brief
+ *     Create a filter between buffer pipes.
+ * @param [in] filterFunction
+ *     Filter function that is called for each buffer of the input pipe.
+ * @param [in] pipeInHandle
+ *     Handle of the input buffer pipe, or NULL. In the case of no input pipe, the `function` will behave like a while loop.
+ * @param [in] pipeOutHandle
+ *     Handle of the output buffer pipe, or NULL. In the case of no output pipe, the buffers handed on are released.
+ * @param [out] filterHandle
+ *     Handle of the filter.
+ * @return
+ *    RETCODE_OK - Success \n
+ *    RETCODE_NULL_POINTER - filterHandle was NULL \n
+ *    RETCODE_OUT_OF_RESOURCES - FreeRTOS heap does not have enough space to create the resource \n
+ *
+ * @code
+ *    // Scales the samples in place and hands the buffer on
+ *    Retcode_T scale(PipeAndFilter_Buffer_T *bufferIn, PipeAndFilter_Buffer_T **bufferOut)
+ *    {
+ *        for (uint32_t i = 0; i < bufferIn->length; i++)
+ *        {
+ *            bufferIn->data[i] >>= 1;
+ *        }
+ *        return RETCODE_OK;
+ *    }
+ *
+ *    (void)PipeAndFilter_CreateBufferFilter(scale, &pipe1, &pipe2, &filter1);
+ * @endcode
+ */
+Retcode_T PipeAndFilter_CreateBufferFilter(PipeAndFilter_BufferFilterFunction_T filterFunction, PipeAndFilter_Pipe_T *pipeInHandle, PipeAndFilter_Pipe_T *pipeOutHandle, PipeAndFilter_Filter_T *filterHandle);
+
+/**
+ * @brief
+ *     Set the pipes every output of a filter goes to, instead of its output pipe.
+ * @param [in] filterHandle
+ *     Handle of the filter.
+ * @param [in] pipeOutHandles
+ *     Array of output pipes, kept by the caller as long as the filter is used.
+ * @param [in] pipeOutCount
+ *     Number of output pipes, 0 for none.
+ * @return
+ *    RETCODE_OK - Success \n
+ *    RETCODE_NULL_POINTER - filterHandle, pipeOutHandles or one of the pipes was NULL \n
+ *    RETCODE_INVALID_PARAM - The pipes do not all carry the kind of data of the filter \n
+ *
+ * @note
+ *     Call it before the first message reaches the filter. Byte pipes get a copy of the output each,
+ *     buffer pipes share the output buffer, so the filters reading them must not change it in place.
+ *     Each pipe applies its own policy, a blocking pipe stalls the filter for all the others.
+ *
+ * @code
+ *    PipeAndFilter_Pipe_T *rawConsumers[] = {&compressorPipe, &detectorPipe};
+ *
+ *    (void)PipeAndFilter_CreateBufferFilter(acquire, NULL, NULL, &acquisition);
+ *    (void)PipeAndFilter_SetOutputPipes(&acquisition, rawConsumers, 2);
+ * @endcode
+ */
+Retcode_T PipeAndFilter_SetOutputPipes(PipeAndFilter_Filter_T *filterHandle, PipeAndFilter_Pipe_T **pipeOutHandles, uint32_t pipeOutCount);
+
+/**
+ * @brief
+ *     Set how many messages a filter processes each time it wakes up.
+ * @param [in] filterHandle
+ *     Handle of the filter.
+ * @param [in] batchSize
+ *     Most messages processed per activation, PIPEANDFILTER_BATCH_ALL for all the messages waiting
+ *     in the input pipe. A filter created by the creational APIs processes one.
+ * @return
+ *    RETCODE_OK - Success \n
+ *    RETCODE_NULL_POINTER - filterHandle was NULL \n
+ *    RETCODE_INVALID_PARAM - batchSize is 0 \n
+ *
+ * @note
+ *     The messages of a batch are received without waiting, the filter only blocks on its input
+ *     pipe once the pipe is empty or the batch is complete.
+ */
+Retcode_T PipeAndFilter_SetBatchSize(PipeAndFilter_Filter_T *filterHandle, uint32_t batchSize);
+
+/**
+ * @brief
+ *     Get the statistics of a filter stage.
+ * @param [in] filterHandle
+ *     Handle of the filter.
+ * @param [in] stage
+ *     Index of the stage, 0 for a filter which is not fused.
+ * @param [out] statistics
+ *     Statistics of the stage since the filter was created or its statistics were reset.
+ * @return
+ *    RETCODE_OK - Success \n
+ *    RETCODE_NULL_POINTER - One of the inputs was NULL \n
+ *    RETCODE_INVALID_PARAM - The filter has no such stage \n
+ *
+ * @note
+ *     The filter task counts without locking, a copy taken while it runs may be off by the message in progress.
+ */
+Retcode_T PipeAndFilter_GetStatistics(const PipeAndFilter_Filter_T *filterHandle, uint32_t stage, PipeAndFilter_Statistics_T *statistics);
+
+/**
+ * @brief
+ *     Reset the statistics of all the stages of a filter.
+ * @param [in] filterHandle
+ *     Handle of the filter.
+ * @return
+ *    RETCODE_OK - Success \n
+ *    RETCODE_NULL_POINTER - filterHandle was NULL \n
+ */
+Retcode_T PipeAndFilter_ResetStatistics(PipeAndFilter_Filter_T *filterHandle);
+
 /******** Behavioral *********/
 /**
  * @brief
@@ -224,6 +604,7 @@ Retcode_T PipeAndFilter_FillPipe(PipeAndFilter_Pipe_T pipe, uint8_t *xTxBuffer,
  *     RETCODE_OK - Success \n
  *     RETCODE_NULL_POINTER - One of the inputs where NULL. \n
  *     RETCODE_OUT_OF_RESOURCES - If the initialization was done, it means that the pipe is full. \n
+ *     RETCODE_NOT_SUPPORTED - The pipe is a merge pipe. \n
  *
  * @note
  *     This function should be called from a ISR context.
@@ -241,6 +622,257 @@ Retcode_T PipeAndFilter_FillPipe(PipeAndFilter_Pipe_T pipe, uint8_t *xTxBuffer,
  */
 Retcode_T PipeAndFilter_FillPipeFromISR(PipeAndFilter_Pipe_T pipe, uint8_t *xTxBuffer, uint32_t xToSendBytes);
 
+/**
+ * @brief
+ *     Take a buffer from a pool. The caller owns it until it hands it to a buffer pipe or releases it.
+ * @param [in] pool
+ *     Pool to take the buffer from.
+ * @param [out] buffer
+ *     The buffer, with a length of 0, or NULL if none is free.
+ * @param [in] timeout
+ *     Time in ms to wait for a free buffer.
+ * @return
+ *     RETCODE_OK - Success \n
+ *     RETCODE_NULL_POINTER - One of the inputs was NULL \n
+ *     RETCODE_OUT_OF_RESOURCES - No buffer was free within the timeout \n
+ *
+ * @note
+ *     This function should be called from a non-ISR context.
+ */
+Retcode_T PipeAndFilter_AllocateBuffer(PipeAndFilter_Pool_T *pool, PipeAndFilter_Buffer_T **buffer, uint32_t timeout);
+
+/**
+ * @brief
+ *     Take a buffer from a pool without waiting, from ISR context.
+ * @return See PipeAndFilter_AllocateBuffer()
+ */
+Retcode_T PipeAndFilter_AllocateBufferFromISR(PipeAndFilter_Pool_T *pool, PipeAndFilter_Buffer_T **buffer);
+
+/**
+ * @brief
+ *     Give a buffer back to its pool.
+ * @param [in] buffer
+ *     Buffer owned by the caller.
+ * @return
+ *     RETCODE_OK - Success \n
+ *     RETCODE_NULL_POINTER - buffer was NULL \n
+ *     RETCODE_FAILURE - The pool holds all its buffers already, the buffer was released twice \n
+ *
+ * @note
+ *     A buffer shared by several output pipes goes back to the pool once all its owners released it.
+ *     This function may be called from a non-ISR context and from a ISR context.
+ */
+Retcode_T PipeAndFilter_ReleaseBuffer(PipeAndFilter_Buffer_T *buffer);
+
+/**
+ * @brief
+ *     Hand a buffer to a buffer pipe. It should be used to fill the first pipe.
+ * @param [in] pipe
+ *     The buffer pipe.
+ * @param [in] buffer
+ *     Buffer owned by the caller. On success, the pipe owns it, otherwise the caller keeps it.
+ * @return
+ *     RETCODE_OK - Success \n
+ *     RETCODE_NULL_POINTER - One of the inputs where NULL. \n
+ *     RETCODE_INVALID_PARAM - The length of the buffer exceeds its size. \n
+ *     RETCODE_OUT_OF_RESOURCES - The pipe is full. \n
+ *
+ * @note
+ *     This function should be called from a non-ISR context.
+ *
+ * @code
+ *     void function(void)
+ *     {
+ *         PipeAndFilter_Buffer_T *buffer;
+ *         if (RETCODE_OK == PipeAndFilter_AllocateBuffer(&samplesPool, &buffer, 0))
+ *         {
+ *             buffer->length = ReadSamples(buffer->data, buffer->size);
+ *             if (RETCODE_OK != PipeAndFilter_FillBufferPipe(pipe1, buffer))
+ *             {
+ *                 (void)PipeAndFilter_ReleaseBuffer(buffer);
+ *             }
+ *         }
+ *     }
+ * @endcode
+ */
+Retcode_T PipeAndFilter_FillBufferPipe(PipeAndFilter_Pipe_T pipe, PipeAndFilter_Buffer_T *buffer);
+
+/**
+ * @brief
+ *     Hand a buffer to a buffer pipe from ISR context.
+ * @return See PipeAndFilter_FillBufferPipe()
+ */
+Retcode_T PipeAndFilter_FillBufferPipeFromISR(PipeAndFilter_Pipe_T pipe, PipeAndFilter_Buffer_T *buffer);
+
+#if KISO_UTILS_STATIC_ALLOCATION
+/**
+ * @brief
+ *     Storage of a byte pipe, see PipeAndFilter_CreatePipeStatic() and PipeAndFilter_CreateMergePipeStatic().
+ */
+typedef struct PipeAndFilter_PipeStorage_S
+{
+    StaticMessageBuffer_t buffer;
+    uint8_t memory[PIPE_SIZE + 1]; /**< A message buffer needs one byte more than it holds */
+    StaticSemaphore_t lock;        /**< Used by merge pipes only */
+} PipeAndFilter_PipeStorage_T;
+
+/**
+ * @brief
+ *     Storage of a buffer pipe, see PipeAndFilter_CreateBufferPipeStatic().
+ */
+typedef struct PipeAndFilter_BufferPipeStorage_S
+{
+    StaticQueue_t queue;
+    PipeAndFilter_Buffer_T *buffers[BUFFER_PIPE_DEPTH];
+} PipeAndFilter_BufferPipeStorage_T;
+
+/**
+ * @brief
+ *     Storage of the task of a filter, see PipeAndFilter_CreateFilterStatic().
+ */
+typedef struct PipeAndFilter_FilterStorage_S
+{
+    StaticTask_t task;
+    StackType_t stack[FILTER_STACK_SIZE];
+} PipeAndFilter_FilterStorage_T;
+
+/**
+ * @brief
+ *     Storage of the free buffers of a pool, see PipeAndFilter_CreatePoolStatic().
+ */
+typedef struct PipeAndFilter_PoolStorage_S
+{
+    StaticQueue_t queue;
+} PipeAndFilter_PoolStorage_T;
+
+/**
+ * @brief
+ *     Create a pipe like PipeAndFilter_CreatePipe(), in the given storage.
+ * @param [out] pipeHandle
+ *     Handle to the pipe.
+ * @param [in] storage
+ *     Storage of the pipe.
+ * @return
+ *     RETCODE_OK - Success \n
+ *     RETCODE_NULL_POINTER - One of the inputs was NULL \n
+ */
+Retcode_T PipeAndFilter_CreatePipeStatic(PipeAndFilter_Pipe_T *pipeHandle, PipeAndFilter_PipeStorage_T *storage);
+
+/**
+ * @brief
+ *     Create a pipe which several filters may write to like PipeAndFilter_CreateMergePipe(), in the given storage.
+ * @param [out] pipeHandle
+ *     Handle to the pipe.
+ * @param [in] storage
+ *     Storage of the pipe and its mutex.
+ * @return
+ *     RETCODE_OK - Success \n
+ *     RETCODE_NULL_POINTER - One of the inputs was NULL \n
+ */
+Retcode_T PipeAndFilter_CreateMergePipeStatic(PipeAndFilter_Pipe_T *pipeHandle, PipeAndFilter_PipeStorage_T *storage);
+
+/**
+ * @brief
+ *     Create a filter like PipeAndFilter_CreateFilter(), with its task in the given storage.
+ * @param [in] filterFunction
+ *     Filter function that is called for each message of the input pipe.
+ * @param [in] pipeInHandle
+ *     Handle of the input pipe, or NULL.
+ * @param [in] pipeOutHandle
+ *     Handle of the output pipe, or NULL.
+ * @param [out] filterHandle
+ *     Handle of the filter.
+ * @param [in] storage
+ *     Storage of the task of the filter.
+ * @return
+ *    RETCODE_OK - Success \n
+ *    RETCODE_NULL_POINTER - filterHandle or storage was NULL \n
+ */
+Retcode_T PipeAndFilter_CreateFilterStatic(PipeAndFilter_FilterFunction_T filterFunction, PipeAndFilter_Pipe_T *pipeInHandle, PipeAndFilter_Pipe_T *pipeOutHandle, PipeAndFilter_Filter_T *filterHandle,
+                                           PipeAndFilter_FilterStorage_T *storage);
+
+/**
+ * @brief
+ *     Create a filter running several stages like PipeAndFilter_CreateFusedFilter(), with its task in the given storage.
+ * @param [in] stages
+ *     Array of stages, kept by the caller as long as the filter is used.
+ * @param [in] stageCount
+ *     Number of stages.
+ * @param [in] pipeInHandle
+ *     Handle of the input pipe, or NULL.
+ * @param [in] pipeOutHandle
+ *     Handle of the output pipe, or NULL.
+ * @param [out] filterHandle
+ *     Handle of the filter.
+ * @param [in] storage
+ *     Storage of the task of the filter.
+ * @return
+ *    RETCODE_OK - Success \n
+ *    RETCODE_NULL_POINTER - stages, a stage function, filterHandle or storage was NULL \n
+ *    RETCODE_INVALID_PARAM - stageCount is 0 \n
+ */
+Retcode_T PipeAndFilter_CreateFusedFilterStatic(PipeAndFilter_Stage_T *stages, uint32_t stageCount, PipeAndFilter_Pipe_T *pipeInHandle, PipeAndFilter_Pipe_T *pipeOutHandle, PipeAndFilter_Filter_T *filterHandle,
+                                                PipeAndFilter_FilterStorage_T *storage);
+
+/**
+ * @brief
+ *     Create a filter between buffer pipes like PipeAndFilter_CreateBufferFilter(), with its task in the given storage.
+ * @param [in] filterFunction
+ *     Filter function that is called for each buffer of the input pipe.
+ * @param [in] pipeInHandle
+ *     Handle of the input buffer pipe, or NULL.
+ * @param [in] pipeOutHandle
+ *     Handle of the output buffer pipe, or NULL.
+ * @param [out] filterHandle
+ *     Handle of the filter.
+ * @param [in] storage
+ *     Storage of the task of the filter.
+ * @return
+ *    RETCODE_OK - Success \n
+ *    RETCODE_NULL_POINTER - filterHandle or storage was NULL \n
+ */
+Retcode_T PipeAndFilter_CreateBufferFilterStatic(PipeAndFilter_BufferFilterFunction_T filterFunction, PipeAndFilter_Pipe_T *pipeInHandle, PipeAndFilter_Pipe_T *pipeOutHandle, PipeAndFilter_Filter_T *filterHandle,
+                                                 PipeAndFilter_FilterStorage_T *storage);
+
+/**
+ * @brief
+ *     Create a buffer pipe like PipeAndFilter_CreateBufferPipe(), in the given storage.
+ * @param [out] pipeHandle
+ *     Handle to the pipe.
+ * @param [in] storage
+ *     Storage of the pipe.
+ * @return
+ *     RETCODE_OK - Success \n
+ *     RETCODE_NULL_POINTER - One of the inputs was NULL \n
+ */
+Retcode_T PipeAndFilter_CreateBufferPipeStatic(PipeAndFilter_Pipe_T *pipeHandle, PipeAndFilter_BufferPipeStorage_T *storage);
+
+/**
+ * @brief
+ *     Create a pool of buffers like PipeAndFilter_CreatePool(), with its free buffers in the given storage.
+ * @param [out] pool
+ *     Handle to the pool.
+ * @param [in] buffers
+ *     Array of count buffer structures, kept by the caller as long as the pool is used.
+ * @param [in] memory
+ *     Memory of count * bufferSize bytes for the data of the buffers, kept by the caller as long as the pool is used.
+ * @param [in] count
+ *     Number of buffers.
+ * @param [in] bufferSize
+ *     Size of each buffer.
+ * @param [in] freeBuffers
+ *     Array of count buffer pointers holding the free buffers, kept by the caller as long as the pool is used.
+ * @param [in] storage
+ *     Storage of the free buffers.
+ * @return
+ *     RETCODE_OK - Success \n
+ *     RETCODE_NULL_POINTER - One of the inputs was NULL \n
+ *     RETCODE_INVALID_PARAM - count or bufferSize is 0 \n
+ */
+Retcode_T PipeAndFilter_CreatePoolStatic(PipeAndFilter_Pool_T *pool, PipeAndFilter_Buffer_T *buffers, uint8_t *memory, uint32_t count, uint32_t bufferSize,
+                                         PipeAndFilter_Buffer_T **freeBuffers, PipeAndFilter_PoolStorage_T *storage);
+#endif /* if KISO_UTILS_STATIC_ALLOCATION */
+
 #endif /* if KISO_FEATURE_PIPEANDFILTER */
 
 #endif /* INCLUDE_KISO_PIPEANDFILTER_H_ */
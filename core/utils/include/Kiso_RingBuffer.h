@@ -45,7 +45,7 @@
    {
       uint8_t readBuffer[SIZE];
       ...
-      // it makes sense to protect the read operation with a critical section 
+      // no critical section is needed as long as there is only one reader
       length = RingBuffer_Read(&ringBuffer, readBuffer, SIZE);
       ...
   return;
@@ -54,7 +54,7 @@
   void yourFunctionWritingToTheRingBuffer(void)
   {
     ...
-    //it makes sense to protect the write operation with a critical section
+    // no critical section is needed as long as there is only one writer (e.g. the UART ISR)
     if (characterCount == RingBuffer_Write(&ringBuffer, "TEST", strlen("TEST")))
     ...
     return;
@@ -82,6 +82,12 @@
  *      The read function only returns data unless the buffer is empty
  *      The write function only writes data when the buffer is not full.
  *
+ *      The buffer is lock-free for one producer and one consumer, for example an ISR
+ *      writing and a task reading. Each side only modifies its own index and exchanges
+ *      it with acquire/release ordering (C11 fences where available, DMB on Cortex-M),
+ *      so neither side needs a critical section. Several producers or several consumers
+ *      must still be serialized by the caller.
+ *
  *      Definition:
  *      - WriteIndex: the location where data is stored to
  *      - ReadIndex:  the location from where to read from
@@ -93,8 +99,27 @@ typedef struct RingBuffer_S
     uint32_t WriteIndex; /**< Write index. NOT to be changed by hand */
     uint32_t ReadIndex;  /**< Read index. NOT to be changed by hand */
     uint32_t Size;       /**< Maximum number of bytes in the user-supplied buffer. Must be set during initialization */
+    bool Overwrite;      /**< Record mode only: drop the oldest records to make room for a new one. Set during initialization */
 } RingBuffer_T;
 
+/**
+ *  @brief
+ *      Maximum number of contiguous regions a range inside the ring-buffer can be split into.
+ *      A range may wrap around the end of the buffer space only once.
+ */
+#define RINGBUFFER_REGION_COUNT (2UL)
+
+/**
+ *  @brief
+ *      Describes a contiguous region inside the user-supplied buffer of a ring-buffer.
+ *      Used by the zero-copy interface (RingBuffer_Reserve() / RingBuffer_Peek()).
+ */
+typedef struct RingBuffer_Region_S
+{
+    uint8_t *Data;   /**< Start of the region inside the user-supplied buffer */
+    uint32_t Length; /**< Number of bytes in the region, may be 0 */
+} RingBuffer_Region_T;
+
 /**
  *  @brief
  *      Initializes a ring-buffer to empty state with a given buffer and buffer size
@@ -113,6 +138,7 @@ typedef struct RingBuffer_S
  *      Size of the circular buffer. Must be known to the caller and will get stored
  *      inside the descriptor.
  *      MUST BE > 1
+ *      MUST BE a power of two if KISO_RINGBUFFER_POWER_OF_TWO is enabled
  *      NOTE: the actual number of bytes that can be stored is size -1
  * 
  */
@@ -171,6 +197,232 @@ uint32_t RingBuffer_Write(RingBuffer_T *ringBuffer, uint8_t *data, uint32_t leng
  */
 uint32_t RingBuffer_Read(RingBuffer_T *ringBuffer, uint8_t *data, uint32_t length);
 
+/**
+ *  @brief
+ *      Provides the currently free space of the ring-buffer for the producer to fill in place,
+ *      for example by DMA, without copying through an intermediate buffer.
+ *
+ *  @details
+ *      The free space is described by up to #RINGBUFFER_REGION_COUNT contiguous regions,
+ *      to be filled in order. Once filled, the data has to be published by RingBuffer_Commit().
+ *      The regions stay valid until the next commit, since the consumer can only release
+ *      space, never take it.
+ *
+ *  @note
+ *      Must only be called by the (single) producer of the ring-buffer.
+ *
+ *  @param [ in ] ringBuffer
+ *      Pointer to the ring-buffer descriptor
+ *      MUST NOT be NULL
+ *
+ *  @param [ out ] regions
+ *      Array of #RINGBUFFER_REGION_COUNT elements receiving the free regions.
+ *      MUST NOT be NULL
+ *
+ *  @return
+ *      Total number of free bytes, i.e. the sum of the region lengths
+ *
+ */
+uint32_t RingBuffer_Reserve(RingBuffer_T *ringBuffer, RingBuffer_Region_T *regions);
+
+/**
+ *  @brief
+ *      Publishes bytes the producer has filled into the regions provided by RingBuffer_Reserve().
+ *
+ *  @param [ in ] ringBuffer
+ *      Pointer to the ring-buffer descriptor
+ *      MUST NOT be NULL
+ *
+ *  @param [ in ] length
+ *      Number of bytes to publish, starting at the first reserved region
+ *
+ *  @return
+ *      Actual number of bytes published, limited by the free space of the buffer
+ *
+ */
+uint32_t RingBuffer_Commit(RingBuffer_T *ringBuffer, uint32_t length);
+
+/**
+ *  @brief
+ *      Provides the currently readable data of the ring-buffer for the consumer to process in place,
+ *      without copying it into an intermediate buffer.
+ *
+ *  @details
+ *      The readable data is described by up to #RINGBUFFER_REGION_COUNT contiguous regions,
+ *      to be processed in order. Once processed, the data has to be released by RingBuffer_Consume().
+ *      The regions stay valid until then, since the producer can only add data, never overwrite it.
+ *
+ *  @note
+ *      Must only be called by the (single) consumer of the ring-buffer.
+ *
+ *  @param [ in ] ringBuffer
+ *      Pointer to the ring-buffer descriptor
+ *      MUST NOT be NULL
+ *
+ *  @param [ out ] regions
+ *      Array of #RINGBUFFER_REGION_COUNT elements receiving the readable regions.
+ *      MUST NOT be NULL
+ *
+ *  @return
+ *      Total number of readable bytes, i.e. the sum of the region lengths
+ *
+ */
+uint32_t RingBuffer_Peek(RingBuffer_T *ringBuffer, RingBuffer_Region_T *regions);
+
+/**
+ *  @brief
+ *      Releases bytes the consumer has processed from the regions provided by RingBuffer_Peek().
+ *
+ *  @param [ in ] ringBuffer
+ *      Pointer to the ring-buffer descriptor
+ *      MUST NOT be NULL
+ *
+ *  @param [ in ] length
+ *      Number of bytes to release, starting at the first peeked region
+ *
+ *  @return
+ *      Actual number of bytes released, limited by the fill-level of the buffer
+ *
+ */
+uint32_t RingBuffer_Consume(RingBuffer_T *ringBuffer, uint32_t length);
+
+/**
+ *  @brief
+ *      Size of the length prefix stored in front of each record in record mode.
+ */
+#define RINGBUFFER_RECORD_HEADER_SIZE (2UL)
+
+/**
+ *  @brief
+ *      Maximum payload length of a single record in record mode.
+ */
+#define RINGBUFFER_RECORD_MAX_LENGTH (0xFFFFUL)
+
+/**
+ *  @brief
+ *      Initializes a ring-buffer for record mode, where variable-length messages are
+ *      stored and retrieved as a whole.
+ *
+ *  @details
+ *      Each record is stored with a #RINGBUFFER_RECORD_HEADER_SIZE length prefix in the
+ *      buffer space, so no allocation or per-message locking is needed. Writing, reading and
+ *      peeking a record is O(1). A record buffer must only be accessed by the record functions.
+ *
+ *      Like in byte mode, one producer (for example an ISR) and one consumer can access the
+ *      buffer concurrently without locking. With overwrite policy, the producer drops the
+ *      oldest records if the buffer is full (useful for telemetry), otherwise the new record
+ *      is rejected. Dropping is done with an atomic compare-and-swap on the ReadIndex, which
+ *      the consumer uses as well to detect records that were dropped while it copied them.
+ *
+ *  @param [ in ] ringBuffer
+ *      Pointer to the ring-buffer descriptor.
+ *      MUST NOT be NULL
+ *
+ *  @param [ in ] bufferSpace
+ *      Pointer to the circular buffer, see RingBuffer_Initialize().
+ *      MUST NOT be NULL
+ *
+ *  @param [ in ] size
+ *      Size of the circular buffer.
+ *      MUST BE > #RINGBUFFER_RECORD_HEADER_SIZE + 1
+ *
+ *  @param [ in ] overwrite
+ *      true to drop the oldest records when full, false to reject new records when full.
+ *
+ */
+void RingBuffer_InitializeRecords(RingBuffer_T *ringBuffer, uint8_t *bufferSpace, uint32_t size, bool overwrite);
+
+/**
+ *  @brief
+ *      Stores a complete record in a record mode ring-buffer.
+ *
+ *  @param [ in ] ringBuffer
+ *      Pointer to the ring-buffer descriptor
+ *      MUST NOT be NULL
+ *
+ *  @param [ in ] data
+ *      Pointer to the record payload
+ *      MUST NOT be NULL
+ *
+ *  @param [ in ] length
+ *      Length of the record payload.
+ *      MUST BE > 0, <= #RINGBUFFER_RECORD_MAX_LENGTH and fit into the buffer including its prefix
+ *
+ *  @return
+ *      true if the record was stored, false if it is invalid or there is not enough
+ *      space left (only without overwrite policy)
+ *
+ */
+bool RingBuffer_WriteRecord(RingBuffer_T *ringBuffer, const uint8_t *data, uint32_t length);
+
+/**
+ *  @brief
+ *      Removes the oldest record from a record mode ring-buffer and copies its payload
+ *      into the user supplied buffer.
+ *
+ *  @note
+ *      If the record is larger than the user supplied buffer, only the first size bytes
+ *      are copied and the remainder is lost. The return value tells the record length,
+ *      RingBuffer_PeekRecord() can be used to check it in advance.
+ *
+ *  @param [ in ] ringBuffer
+ *      Pointer to the ring-buffer descriptor
+ *      MUST NOT be NULL
+ *
+ *  @param [ out ] data
+ *      Pointer to the user supplied buffer for the payload
+ *      MUST NOT be NULL
+ *
+ *  @param [ in ] size
+ *      Size of the user supplied buffer
+ *
+ *  @return
+ *      Length of the removed record, 0 if the buffer is empty
+ *
+ */
+uint32_t RingBuffer_ReadRecord(RingBuffer_T *ringBuffer, uint8_t *data, uint32_t size);
+
+/**
+ *  @brief
+ *      Provides the payload of the oldest record in a record mode ring-buffer for in place
+ *      processing, without removing it.
+ *
+ *  @details
+ *      The payload is described by up to #RINGBUFFER_REGION_COUNT contiguous regions.
+ *      The record has to be released by RingBuffer_ConsumeRecord() afterwards.
+ *
+ *  @note
+ *      With overwrite policy the producer may drop and overwrite the peeked record at any time.
+ *      Use RingBuffer_ReadRecord() for such buffers, unless the producer is held off.
+ *
+ *  @param [ in ] ringBuffer
+ *      Pointer to the ring-buffer descriptor
+ *      MUST NOT be NULL
+ *
+ *  @param [ out ] regions
+ *      Array of #RINGBUFFER_REGION_COUNT elements receiving the payload regions.
+ *      MUST NOT be NULL
+ *
+ *  @return
+ *      Length of the oldest record, 0 if the buffer is empty
+ *
+ */
+uint32_t RingBuffer_PeekRecord(RingBuffer_T *ringBuffer, RingBuffer_Region_T *regions);
+
+/**
+ *  @brief
+ *      Removes the oldest record from a record mode ring-buffer without copying it.
+ *
+ *  @param [ in ] ringBuffer
+ *      Pointer to the ring-buffer descriptor
+ *      MUST NOT be NULL
+ *
+ *  @return
+ *      Length of the removed record, 0 if the buffer is empty
+ *
+ */
+uint32_t RingBuffer_ConsumeRecord(RingBuffer_T *ringBuffer);
+
 /**
  *  @brief
  *      Resets the ring-buffer. All the saved / available data
@@ -67,6 +67,12 @@
  *      instances may co-exist in the same application. However, they must operate on
  *      different UART or LEUART ports.
  *
+ * @note
+ *      With KISO_UTILS_STATIC_ALLOCATION, UARTTransceiver_InitializeStatic() creates
+ *      the semaphores in a #UARTTransceiver_Storage_T given by the caller instead of
+ *      the FreeRTOS heap. With KISO_UTILS_TASK_NOTIFICATIONS the transceiver has no
+ *      semaphores, so UARTTransceiver_Initialize() does not use the heap anyway.
+ *
  * @code{.c}
  * #include "KISO_UARTTransceiver.h"
  *
@@ -132,6 +138,9 @@
 #include "Kiso_Retcode.h"
 #include "Kiso_HAL.h"
 #include "Kiso_RingBuffer.h"
+#if KISO_UTILS_STATIC_ALLOCATION && !KISO_UTILS_TASK_NOTIFICATIONS
+#include "FreeRTOS.h"
+#endif
 
 #if KISO_FEATURE_UART || KISO_FEATURE_LEUART
 
@@ -204,11 +213,24 @@ struct _UARTTransceiver_S
     /* currently received byte */
     uint8_t LastByte;
 
+#if KISO_UTILS_TASK_NOTIFICATIONS
+    /*task waiting for the send process to complete*/
+    void *TxWaitingTask;
+
+    /*task waiting for a frame end or a receive error*/
+    void *RxWaitingTask;
+
+    /*set by the loop callback, until the waiting task sees it*/
+    bool TxSignaled;
+
+    bool RxSignaled;
+#else
     /*semaphore used to synchronize the send process*/
     void *TxSemaphore;
 
     /*semaphore used to synchronize the error handling process*/
     void *RxSemaphore;
+#endif
 
 #if KISO_FEATURE_UART
     union MCU_UART_Event_U AsyncEvent;
@@ -220,6 +242,20 @@ struct _UARTTransceiver_S
 
 typedef struct _UARTTransceiver_S UARTTransceiver_T;
 
+#if KISO_UTILS_STATIC_ALLOCATION && !KISO_UTILS_TASK_NOTIFICATIONS
+/**
+ * Storage of the semaphores of an UART Transceiver, see UARTTransceiver_InitializeStatic()
+ */
+struct _UARTTransceiver_Storage_S
+{
+    StaticSemaphore_t TxSemaphore;
+
+    StaticSemaphore_t RxSemaphore;
+};
+
+typedef struct _UARTTransceiver_Storage_S UARTTransceiver_Storage_T;
+#endif
+
 /**
  * @brief
  *      Initializes the transceiver for the use with the passed UART or
@@ -249,7 +285,7 @@ typedef struct _UARTTransceiver_S UARTTransceiver_T;
  *      If any of the parameter is NULL
  * @retval #RETCODE_SEMAPHORE_ERROR
  *      If the semaphores are not created (see #UARTTransceiver_T.TxSemaphore
- *      and #UARTTransceiver_T.RxSemaphore)
+ *      and #UARTTransceiver_T.RxSemaphore), never with KISO_UTILS_TASK_NOTIFICATIONS
  * @retval #RETCODE_DOPPLE_INITIALIZATION
  *      If you are trying to initialized the transceiver again
  */
@@ -258,6 +294,45 @@ Retcode_T UARTTransceiver_Initialize(
     HWHandle_T handle, uint8_t *rawRxBuffer, uint32_t rawRxBufferSize,
     enum UARTTransceiver_UartType_E type);
 
+#if KISO_UTILS_STATIC_ALLOCATION && !KISO_UTILS_TASK_NOTIFICATIONS
+/**
+ * @brief
+ *      Initializes the transceiver like UARTTransceiver_Initialize(), but creates
+ *      the semaphores in the given storage instead of the FreeRTOS heap.
+ *
+ * @param[in] transceiver
+ *      A pointer to the transceiver context structure to be initialized
+ *
+ * @param[in] handle
+ *      The handle of the UART or LEUART to be used by the transceiver. The handle
+ *      must be initialized before passing it here.
+ *
+ * @param[in] rawRxBuffer
+ *      The buffer which will be used by the transceiver internally to save
+ *      the received bytes. It must not be NULL.
+ *
+ * @param[in] rawRxBufferSize
+ *      The size of the rawRxBuffer. It must be larger than zero.
+ *
+ * @param[in] type
+ *      The type of the UART
+ *
+ * @param[in] storage
+ *      The storage of the semaphores, valid until UARTTransceiver_Deinitialize()
+ *
+ * @retval #RETCODE_OK
+ *      If successfully initialized
+ * @retval #RETCODE_INVALID_PARAM
+ *      If any of the parameter is NULL
+ * @retval #RETCODE_DOPPLE_INITIALIZATION
+ *      If you are trying to initialized the transceiver again
+ */
+Retcode_T UARTTransceiver_InitializeStatic(
+    UARTTransceiver_T *transceiver,
+    HWHandle_T handle, uint8_t *rawRxBuffer, uint32_t rawRxBufferSize,
+    enum UARTTransceiver_UartType_E type, UARTTransceiver_Storage_T *storage);
+#endif
+
 /**
  * @brief
  *      De-initializes the transceiver.
@@ -413,6 +488,9 @@ Retcode_T UARTTransceiver_Stop(UARTTransceiver_T *transceiver);
  *      the given buffer size. If more bytes are available in the transceiver internal
  *      buffer, they will reside there.
  *
+ * @note
+ *      The internal buffer is read lock-free, without disabling the RX interrupt.
+ *      Therefore only one task at a time may read from a transceiver.
  *
  * @param[in] transceiver
  *      A pointer to the transceiver
@@ -98,6 +98,10 @@ enum KISO_UTILS_ModuleID_E
     KISO_UTILS_MODULE_ID_EVENTHUB,
     KISO_UTILS_MODULE_ID_SLEEPCONTROL,
     KISO_UTILS_MODULE_ID_PIPEANDFILTER,
+    KISO_UTILS_MODULE_ID_LOGGING_RECORD_BINARY,
+    KISO_UTILS_MODULE_ID_LOGGING_APPENDER_RAM,
+    KISO_UTILS_MODULE_ID_LOGGING_APPENDER_UART_DMA,
+    KISO_UTILS_MODULE_ID_LOGGING_RATE_LIMIT,
 };
 
 #endif /* KISO_UTILS_H_ */
@@ -47,6 +47,18 @@
  *      | ED     | 0xC9      | ESC_ED        | 0xDBDE    |
  *      | ESC    | 0xDB      | ESC_ESC       | 0xDBDD    |
  *
+ *      With KISO_XPROTOCOL_COBS enabled, frames are encoded with Consistent Overhead Byte Stuffing
+ *      instead, which bounds the overhead independent of the payload:
+ *
+ *      | COBS(Payload, CS)                       | ED |
+ *      |-----------------------------------------|----|
+ *      | N + 2 + 1 + (N + 2) / 254 Bytes at most | 1B |
+ *
+ *      The payload followed by the checksum (same CRC, Network Byte Order) is split at every 0x00
+ *      byte into blocks of at most 254 bytes. Each block is prefixed by a code byte holding its
+ *      length plus one, which replaces the 0x00 following the block. The encoded bytes therefore
+ *      never contain 0x00, which serves as end delimiter.
+ *
 
  * @code{.c}
  * #include "Kiso_XProtocol.h"
@@ -54,7 +66,7 @@
  * int main(void)
  * {
  *     uint8_t initialBuff[] = {"XProtocol test!"};
- *     uint8_t encodedBuff[sizeof(initialBuff) * 2] = {0};
+ *     uint8_t encodedBuff[XPROTOCOL_MAX_ENCODED_LENGTH(sizeof(initialBuff))] = {0};
  *     uint8_t decodedBuff[sizeof(initialBuff) * 2] = {0};
  *     uint32_t frameLength = 0;
  *     uint32_t dataLength = 0;
@@ -104,6 +116,65 @@
 #include "Kiso_Basics.h"
 #include "Kiso_Retcode.h"
 
+/**
+ * @brief
+ *      Maximum length of an encoded frame for a payload of dataLength bytes: SD, ED and every byte of
+ *      checksum and payload escaped, or with KISO_XPROTOCOL_COBS one code byte per started block of
+ *      254 bytes and ED. Usable for statically sized frame buffers.
+ */
+#if KISO_XPROTOCOL_COBS
+#define XPROTOCOL_MAX_ENCODED_LENGTH(dataLength) (UINT32_C(4) + (uint32_t)(dataLength) + ((uint32_t)(dataLength) + UINT32_C(2)) / UINT32_C(254))
+#else
+#define XPROTOCOL_MAX_ENCODED_LENGTH(dataLength) (UINT32_C(6) + UINT32_C(2) * (uint32_t)(dataLength))
+#endif
+
+/**
+ * @brief
+ *      A piece of the payload of a frame, see XProtocol_EncodeFrameSegments()
+ */
+typedef struct XProtocol_Segment_S
+{
+    const uint8_t *Data; /**< Pointer to the data, may only be NULL if Length is 0 */
+    uint32_t Length;     /**< Number of bytes in Data */
+} XProtocol_Segment_T;
+
+/**
+ * @brief
+ *      Called by the streaming decoder for every complete frame with a valid checksum.
+ *
+ * @param[in] payload
+ *      Decoded payload, only valid until the callback returns
+ * @param payloadLength
+ *      Length of the payload
+ * @param[in] callbackParam
+ *      Parameter passed to XProtocol_DecoderInitialize()
+ */
+typedef void (*XProtocol_FrameCallback_T)(const uint8_t *payload, uint32_t payloadLength, void *callbackParam);
+
+/**
+ * @brief
+ *      State of a streaming decoder, see XProtocol_DecoderInitialize(). Its members are private to the
+ *      XProtocol module.
+ */
+typedef struct XProtocol_Decoder_S
+{
+    uint8_t *Buffer;
+    uint32_t BufferSize;
+    uint32_t PayloadLength;
+    uint32_t CrcLength;
+    uint16_t Checksum;
+    uint16_t ReceivedChecksum;
+    uint8_t ChecksumLength;
+    uint8_t State;
+    uint8_t BlockRemaining;
+    bool ZeroPending;
+    uint8_t Spare[2];
+    uint8_t *Reserved;
+    uint32_t ReservedSize;
+    XProtocol_FrameCallback_T Callback;
+    void *CallbackParam;
+} XProtocol_Decoder_T;
+
 /**
  * @brief
  *      Initializes the xProtocol module
@@ -139,6 +210,48 @@ Retcode_T XProtocol_Init(void);
 Retcode_T XProtocol_EncodeFrame(const uint8_t *data, uint32_t dataLength,
                                 uint32_t maxFrameLength, uint8_t *frame, uint32_t *frameLength);
 
+/**
+ * @brief
+ *      Encodes an xProtocol frame whose payload is the concatenation of several segments,
+ *      e.g. a header and a payload, without copying them into one buffer first.
+ *
+ * @details
+ *      The checksum is calculated while escaping the payload, so every payload byte is read once.
+ *
+ * @param[in] segments
+ *      Array of segments, which must not be NULL unless segmentCount is 0
+ * @param segmentCount
+ *      Number of segments in the array
+ * @param maxFrameLength
+ *      Maximum number of bytes the frame buffer can hold; XProtocol_GetMaxEncodedLength() of the
+ *      total payload length is always sufficient
+ * @param[out] frame
+ *      Pointer to buffer which is supposed to hold the encoded
+ *      frame, which must not be NULL
+ * @param[out] frameLength
+ *      Length of the encoded frame
+ * @retval RETCODE_SUCCESS
+ *      Data encoding to frame successfull
+ * @retval RETCODE_NULL_POINTER
+ *      If segments, the data of a non-empty segment, frame or frameLength is NULL
+ * @retval RETCODE_XPROTOCOL_FRAME_BUFFER_TOO_SMALL
+ *      Encoded frame does not fit in frame buffer
+ */
+Retcode_T XProtocol_EncodeFrameSegments(const XProtocol_Segment_T *segments, uint32_t segmentCount,
+                                        uint32_t maxFrameLength, uint8_t *frame, uint32_t *frameLength);
+
+/**
+ * @brief
+ *      Get the worst case length of an encoded frame, to size frame buffers up front.
+ *
+ * @param dataLength
+ *      Length of the payload, at most (UINT32_MAX - 6) / 2
+ *
+ * @return
+ *      Number of bytes a frame buffer needs to hold the frame in any case, see XPROTOCOL_MAX_ENCODED_LENGTH
+ */
+uint32_t XProtocol_GetMaxEncodedLength(uint32_t dataLength);
+
 /**
  * @brief
  *      Decodes an xProtocol frame.
@@ -223,6 +336,110 @@ Retcode_T XProtocol_IsCompleteFrame(const uint8_t *frame, uint32_t frameLength,
 Retcode_T XProtocol_GetPayloadLength(const uint8_t *frame, uint32_t frameLength,
                                      uint32_t *payloadLength);
 
+/**
+ * @brief
+ *      Initializes a streaming decoder.
+ *
+ * @details
+ *      A streaming decoder is fed with received bytes in chunks of any size, e.g. as they arrive from
+ *      UART or DMA, by XProtocol_DecoderPush() or by XProtocol_DecoderReserve() and
+ *      XProtocol_DecoderCommit(). Each byte is looked at once: it is unescaped into the payload buffer
+ *      and the checksum is updated while decoding. Every complete frame with a valid checksum is
+ *      passed to the callback; broken frames are dropped and decoding resynchronizes at the next
+ *      frame boundary.
+ *
+ *      A decoder must only be used by one task at a time.
+ *
+ * @param[out] decoder
+ *      Decoder to initialize, which must not be NULL
+ * @param[in] buffer
+ *      Buffer for the payload of one frame, which must not be NULL
+ * @param bufferSize
+ *      Size of the buffer, i.e. the maximum payload length accepted
+ * @param callback
+ *      Function called for every valid frame, may be NULL
+ * @param[in] callbackParam
+ *      Passed to the callback
+ *
+ * @retval RETCODE_SUCCESS
+ *      Decoder initialized
+ * @retval RETCODE_NULL_POINTER
+ *      If decoder or buffer is NULL
+ */
+Retcode_T XProtocol_DecoderInitialize(XProtocol_Decoder_T *decoder, uint8_t *buffer, uint32_t bufferSize,
+                                      XProtocol_FrameCallback_T callback, void *callbackParam);
+
+/**
+ * @brief
+ *      Drops a partially received frame, e.g. after a reception error.
+ *
+ * @param[in,out] decoder
+ *      Initialized decoder
+ */
+void XProtocol_DecoderReset(XProtocol_Decoder_T *decoder);
+
+/**
+ * @brief
+ *      Decodes the next chunk of received bytes.
+ *
+ * @param[in,out] decoder
+ *      Initialized decoder, which must not be NULL
+ * @param[in] data
+ *      Received bytes, which must not be NULL
+ * @param length
+ *      Number of received bytes
+ *
+ * @retval RETCODE_SUCCESS
+ *      All frames which ended in this chunk were valid and passed to the callback
+ * @retval RETCODE_NULL_POINTER
+ *      If decoder or data is NULL
+ * @retval RETCODE_XPROTOCOL_INTEGRITY_FAILED
+ *      A frame had a wrong checksum or an invalid escape sequence and was dropped
+ * @retval RETCODE_XPROTOCOL_DATA_BUFFER_TOO_SMALL
+ *      The payload of a frame exceeded the decoder buffer and the frame was dropped
+ * @retval RETCODE_XPROTOCOL_END_DELIMITER_MISSING
+ *      A frame was cut off by the start of another one and dropped
+ *
+ * @note
+ *      If several frames were dropped, the reason for the last one is returned. The remaining bytes
+ *      of the chunk are decoded in any case.
+ */
+Retcode_T XProtocol_DecoderPush(XProtocol_Decoder_T *decoder, const uint8_t *data, uint32_t length);
+
+/**
+ * @brief
+ *      Gets the space where the next received bytes can be placed to be decoded in place, without
+ *      copying them from a receive buffer first. Pass the number of bytes received there to
+ *      XProtocol_DecoderCommit() afterwards.
+ *
+ * @param[in,out] decoder
+ *      Initialized decoder
+ * @param[out] data
+ *      Start of the space to receive into
+ *
+ * @return
+ *      Number of bytes which may be received into data, at least 1 for an initialized decoder
+ */
+uint32_t XProtocol_DecoderReserve(XProtocol_Decoder_T *decoder, uint8_t **data);
+
+/**
+ * @brief
+ *      Decodes bytes received into the space returned by XProtocol_DecoderReserve().
+ *
+ * @param[in,out] decoder
+ *      Initialized decoder
+ * @param length
+ *      Number of bytes received, at most as many as reserved
+ *
+ * @retval RETCODE_NULL_POINTER
+ *      If decoder is NULL or no space was reserved before
+ * @retval RETCODE_INVALID_PARAM
+ *      If length exceeds the reserved space
+ * @retval others
+ *      As for XProtocol_DecoderPush()
+ */
+Retcode_T XProtocol_DecoderCommit(XProtocol_Decoder_T *decoder, uint32_t length);
+
 #endif /* if KISO_FEATURE_XPROTOCOL */
 
 #endif /* KISO_XPROTOCOL_H_ */
@@ -23,7 +23,25 @@
  *      - CRC_16()
  *      - CRC_32()
  *      - CRC_32_Reverse()
- * 
+ *      - CRC_Initialize()
+ *      - CRC_Update()
+ *      - CRC_Finalize()
+ *      - CRC_Calculate()
+ *
+ *      With KISO_CRC_TABLE_DRIVEN enabled, the CRC is calculated byte-wise from a 256-entry
+ *      lookup table instead of bit by bit. Each routine caches the tables of up to
+ *      KISO_CRC_TABLE_CACHE_SIZE polynomials, built lazily on the first call with each of them;
+ *      calls with further polynomials fall back to the bit-serial calculation. Results are
+ *      bit-exact in both cases.
+ *      With KISO_CRC32_SLICING_BY_4 enabled, the CRC-32 routines additionally process four
+ *      octets per step from four tables (slicing-by-4).
+ *
+ *      The context API (CRC_Initialize(), CRC_Update(), CRC_Finalize()) maps every parameter set
+ *      onto the two 32-bit engines of CRC_32() and CRC_32_Reverse(): normal CRCs keep their
+ *      register aligned to the most significant bit, reflected CRCs keep it reflected and aligned
+ *      to the least significant bit. With KISO_CRC_HARDWARE_OFFLOAD enabled, updates are handed
+ *      to the MCU CRC unit first and only calculated in software if the unit rejects them.
+ *
  * @file
  **/
 
@@ -37,125 +55,550 @@
 
 #if KISO_FEATURE_CRC
 
+#ifndef KISO_CRC_TABLE_DRIVEN
+#define KISO_CRC_TABLE_DRIVEN 1
+#endif
+
+#ifndef KISO_CRC_TABLE_CACHE_SIZE
+#define KISO_CRC_TABLE_CACHE_SIZE 2
+#endif
+
+#ifndef KISO_CRC32_SLICING_BY_4
+#define KISO_CRC32_SLICING_BY_4 0
+#endif
+
+#ifndef KISO_CRC_HARDWARE_OFFLOAD
+#define KISO_CRC_HARDWARE_OFFLOAD 0
+#endif
+
+#if KISO_CRC_HARDWARE_OFFLOAD
+#include "Kiso_MCU_CRC.h"
+#if !KISO_FEATURE_MCU_CRC
+#error "KISO_CRC_HARDWARE_OFFLOAD requires KISO_FEATURE_MCU_CRC"
+#endif
+#endif /* if KISO_CRC_HARDWARE_OFFLOAD */
+
 #define CRC_SHIFT_VAL UINT8_C(1)                     /**< used to shift data by one time */
 #define CRC8_MASK_VAL UINT8_C(0X80)                  /**< used to mask MSB bit of the byte */
 #define CRC16_MASK_VAL UINT16_C(0X8000)              /**< used to mask MSB bit of the byte */
 #define CRC32_MASK_VAL UINT32_C(0X80000000)          /**< used to mask MSB bit of the byte */
 #define CRC32_ETHERNET_MASK_VAL UINT32_C(0x00000001) /**< used to mask LSB bit of the byte */
 
-/*  The description of the function is available in Kiso_CRC.h */
-Retcode_T CRC_8(uint8_t poly, uint8_t *shifter, const uint8_t *data_p, uint16_t len)
+#if KISO_CRC_TABLE_DRIVEN
+
+#define CRC_TABLE_ENTRIES (256U) /**< one entry per octet value */
+
+#if KISO_CRC32_SLICING_BY_4
+#define CRC32_TABLE_SLICES (4U) /**< octets processed per step */
+#else
+#define CRC32_TABLE_SLICES (1U)
+#endif
+
+/**
+ * @brief
+ *      Build state of a lazily generated lookup table.
+ */
+enum CRC_TableState_E
+{
+    CRC_TABLE_EMPTY = 0, /**< not built yet, can be claimed by the next caller */
+    CRC_TABLE_BUILDING,  /**< being built by a caller, others use the bit-serial calculation */
+    CRC_TABLE_READY,     /**< built for CRC_TableHeader_T.Poly */
+};
+
+/**
+ * @brief
+ *      Result of looking up a polynomial in one slot of a table cache.
+ */
+enum CRC_TableMatch_E
+{
+    CRC_TABLE_MISMATCH = 0, /**< the slot cannot be used for the polynomial */
+    CRC_TABLE_MATCHING,     /**< the slot holds the table of the polynomial */
+    CRC_TABLE_CLAIMED,      /**< the slot was empty and has to be built for the polynomial by the caller */
+};
+
+typedef struct CRC_TableHeader_S
+{
+    uint32_t State;
+    uint32_t Poly; /**< only valid once State is CRC_TABLE_READY */
+} CRC_TableHeader_T;
+
+typedef struct CRC_Table8_S
+{
+    CRC_TableHeader_T Header;
+    uint8_t Table[CRC_TABLE_ENTRIES];
+} CRC_Table8_T;
+
+typedef struct CRC_Table16_S
+{
+    CRC_TableHeader_T Header;
+    uint16_t Table[CRC_TABLE_ENTRIES];
+} CRC_Table16_T;
+
+typedef struct CRC_Table32_S
+{
+    CRC_TableHeader_T Header;
+    uint32_t Table[CRC32_TABLE_SLICES][CRC_TABLE_ENTRIES];
+} CRC_Table32_T;
+
+/* Each routine caches the tables of up to KISO_CRC_TABLE_CACHE_SIZE polynomials, the slots are claimed in order */
+static CRC_Table8_T Crc8Tables[KISO_CRC_TABLE_CACHE_SIZE];
+static CRC_Table16_T Crc16Tables[KISO_CRC_TABLE_CACHE_SIZE];
+static CRC_Table32_T Crc32Tables[KISO_CRC_TABLE_CACHE_SIZE];
+static CRC_Table32_T Crc32ReverseTables[KISO_CRC_TABLE_CACHE_SIZE];
+
+/*
+ * Checks whether a cache slot holds the table of the given polynomial. An empty slot is claimed
+ * atomically if isClaimable is still set; the caller then has to build the table and publish it
+ * with PublishTable(). Once a slot is seen being built (possibly for the same polynomial), no
+ * further slot is claimed by this lookup, and the caller uses the bit-serial calculation meanwhile.
+ */
+static enum CRC_TableMatch_E MatchTable(CRC_TableHeader_T *header, uint32_t poly, bool *isClaimable)
+{
+    enum CRC_TableMatch_E match = CRC_TABLE_MISMATCH;
+    uint32_t expected = CRC_TABLE_EMPTY;
+    uint32_t state = __atomic_load_n(&header->State, __ATOMIC_ACQUIRE);
+
+    if (CRC_TABLE_READY == state)
+    {
+        /* The polynomial is published along with the table, so it may only be read after the acquire */
+        if (poly == header->Poly)
+        {
+            match = CRC_TABLE_MATCHING;
+        }
+    }
+    else if ((CRC_TABLE_EMPTY == state) && *isClaimable &&
+             __atomic_compare_exchange_n(&header->State, &expected, CRC_TABLE_BUILDING, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+    {
+        match = CRC_TABLE_CLAIMED;
+    }
+    else
+    {
+        *isClaimable = false;
+    }
+    return match;
+}
+
+static void PublishTable(CRC_TableHeader_T *header, uint32_t poly)
+{
+    header->Poly = poly;
+    __atomic_store_n(&header->State, CRC_TABLE_READY, __ATOMIC_RELEASE);
+}
+
+static void BuildCrc8Table(CRC_Table8_T *cached, uint8_t poly)
+{
+    for (uint32_t i = 0U; i < CRC_TABLE_ENTRIES; i++)
+    {
+        uint8_t entry = (uint8_t)i;
+        for (uint8_t bit = 0U; bit < 8U; bit++)
+        {
+            entry = (entry & CRC8_MASK_VAL) ? (uint8_t)((entry << CRC_SHIFT_VAL) ^ poly) : (uint8_t)(entry << CRC_SHIFT_VAL);
+        }
+        cached->Table[i] = entry;
+    }
+    PublishTable(&cached->Header, poly);
+}
+
+static void BuildCrc16Table(CRC_Table16_T *cached, uint16_t poly)
+{
+    for (uint32_t i = 0U; i < CRC_TABLE_ENTRIES; i++)
+    {
+        uint16_t entry = (uint16_t)(i << 8);
+        for (uint8_t bit = 0U; bit < 8U; bit++)
+        {
+            entry = (entry & CRC16_MASK_VAL) ? (uint16_t)((entry << CRC_SHIFT_VAL) ^ poly) : (uint16_t)(entry << CRC_SHIFT_VAL);
+        }
+        cached->Table[i] = entry;
+    }
+    PublishTable(&cached->Header, poly);
+}
+
+static void BuildCrc32Table(CRC_Table32_T *cached, uint32_t poly)
+{
+    for (uint32_t i = 0U; i < CRC_TABLE_ENTRIES; i++)
+    {
+        uint32_t entry = i << 24;
+        for (uint8_t bit = 0U; bit < 8U; bit++)
+        {
+            entry = (entry & CRC32_MASK_VAL) ? ((entry << CRC_SHIFT_VAL) ^ poly) : (entry << CRC_SHIFT_VAL);
+        }
+        cached->Table[0][i] = entry;
+    }
+    for (uint32_t slice = 1U; slice < CRC32_TABLE_SLICES; slice++)
+    {
+        for (uint32_t i = 0U; i < CRC_TABLE_ENTRIES; i++)
+        {
+            uint32_t previous = cached->Table[slice - 1U][i];
+            cached->Table[slice][i] = (previous << 8) ^ cached->Table[0][previous >> 24];
+        }
+    }
+    PublishTable(&cached->Header, poly);
+}
+
+static void BuildCrc32ReverseTable(CRC_Table32_T *cached, uint32_t poly)
+{
+    for (uint32_t i = 0U; i < CRC_TABLE_ENTRIES; i++)
+    {
+        uint32_t entry = i;
+        for (uint8_t bit = 0U; bit < 8U; bit++)
+        {
+            entry = (entry & CRC32_ETHERNET_MASK_VAL) ? ((entry >> CRC_SHIFT_VAL) ^ poly) : (entry >> CRC_SHIFT_VAL);
+        }
+        cached->Table[0][i] = entry;
+    }
+    for (uint32_t slice = 1U; slice < CRC32_TABLE_SLICES; slice++)
+    {
+        for (uint32_t i = 0U; i < CRC_TABLE_ENTRIES; i++)
+        {
+            uint32_t previous = cached->Table[slice - 1U][i];
+            cached->Table[slice][i] = (previous >> 8) ^ cached->Table[0][previous & 0xFFUL];
+        }
+    }
+    PublishTable(&cached->Header, poly);
+}
+
+static const uint8_t *GetCrc8Table(uint8_t poly)
+{
+    const uint8_t *table = NULL;
+    bool isClaimable = true;
+
+    for (uint32_t slot = 0U; (NULL == table) && (slot < KISO_CRC_TABLE_CACHE_SIZE); slot++)
+    {
+        switch (MatchTable(&Crc8Tables[slot].Header, poly, &isClaimable))
+        {
+        case CRC_TABLE_CLAIMED:
+            BuildCrc8Table(&Crc8Tables[slot], poly);
+            table = Crc8Tables[slot].Table;
+            break;
+        case CRC_TABLE_MATCHING:
+            table = Crc8Tables[slot].Table;
+            break;
+        default:
+            break;
+        }
+    }
+    return table;
+}
+
+static const uint16_t *GetCrc16Table(uint16_t poly)
+{
+    const uint16_t *table = NULL;
+    bool isClaimable = true;
+
+    for (uint32_t slot = 0U; (NULL == table) && (slot < KISO_CRC_TABLE_CACHE_SIZE); slot++)
+    {
+        switch (MatchTable(&Crc16Tables[slot].Header, poly, &isClaimable))
+        {
+        case CRC_TABLE_CLAIMED:
+            BuildCrc16Table(&Crc16Tables[slot], poly);
+            table = Crc16Tables[slot].Table;
+            break;
+        case CRC_TABLE_MATCHING:
+            table = Crc16Tables[slot].Table;
+            break;
+        default:
+            break;
+        }
+    }
+    return table;
+}
+
+static const CRC_Table32_T *GetCrc32Table(uint32_t poly)
+{
+    const CRC_Table32_T *table = NULL;
+    bool isClaimable = true;
+
+    for (uint32_t slot = 0U; (NULL == table) && (slot < KISO_CRC_TABLE_CACHE_SIZE); slot++)
+    {
+        switch (MatchTable(&Crc32Tables[slot].Header, poly, &isClaimable))
+        {
+        case CRC_TABLE_CLAIMED:
+            BuildCrc32Table(&Crc32Tables[slot], poly);
+            table = &Crc32Tables[slot];
+            break;
+        case CRC_TABLE_MATCHING:
+            table = &Crc32Tables[slot];
+            break;
+        default:
+            break;
+        }
+    }
+    return table;
+}
+
+static const CRC_Table32_T *GetCrc32ReverseTable(uint32_t poly)
+{
+    const CRC_Table32_T *table = NULL;
+    bool isClaimable = true;
+
+    for (uint32_t slot = 0U; (NULL == table) && (slot < KISO_CRC_TABLE_CACHE_SIZE); slot++)
+    {
+        switch (MatchTable(&Crc32ReverseTables[slot].Header, poly, &isClaimable))
+        {
+        case CRC_TABLE_CLAIMED:
+            BuildCrc32ReverseTable(&Crc32ReverseTables[slot], poly);
+            table = &Crc32ReverseTables[slot];
+            break;
+        case CRC_TABLE_MATCHING:
+            table = &Crc32ReverseTables[slot];
+            break;
+        default:
+            break;
+        }
+    }
+    return table;
+}
+
+static uint8_t Crc8Lookup(const uint8_t *table, uint8_t shifter, const uint8_t *data_p, uint32_t len)
+{
+    while (len--)
+    {
+        shifter = table[shifter ^ *data_p++];
+    }
+    return shifter;
+}
+
+static uint16_t Crc16Lookup(const uint16_t *table, uint16_t shifter, const uint8_t *data_p, uint32_t len)
+{
+    while (len--)
+    {
+        shifter = (uint16_t)(shifter << 8) ^ table[(uint8_t)(shifter >> 8) ^ *data_p++];
+    }
+    return shifter;
+}
+
+static uint32_t Crc32Lookup(const CRC_Table32_T *table, uint32_t shifter, const uint8_t *data_p, uint32_t len)
+{
+#if KISO_CRC32_SLICING_BY_4
+    /* Process four octets per step; octets are combined explicitly, so alignment and endianness do not matter */
+    for (; len >= CRC32_TABLE_SLICES; len -= CRC32_TABLE_SLICES, data_p += CRC32_TABLE_SLICES)
+    {
+        shifter ^= ((uint32_t)data_p[0] << 24) | ((uint32_t)data_p[1] << 16) | ((uint32_t)data_p[2] << 8) | (uint32_t)data_p[3];
+        shifter = table->Table[3][shifter >> 24] ^ table->Table[2][(shifter >> 16) & 0xFFUL] ^
+                  table->Table[1][(shifter >> 8) & 0xFFUL] ^ table->Table[0][shifter & 0xFFUL];
+    }
+#endif /* if KISO_CRC32_SLICING_BY_4 */
+    while (len--)
+    {
+        shifter = (shifter << 8) ^ table->Table[0][(shifter >> 24) ^ *data_p++];
+    }
+    return shifter;
+}
+
+static uint32_t Crc32ReverseLookup(const CRC_Table32_T *table, uint32_t shifter, const uint8_t *data_p, uint32_t len)
+{
+#if KISO_CRC32_SLICING_BY_4
+    /* Process four octets per step; octets are combined explicitly, so alignment and endianness do not matter */
+    for (; len >= CRC32_TABLE_SLICES; len -= CRC32_TABLE_SLICES, data_p += CRC32_TABLE_SLICES)
+    {
+        shifter ^= (uint32_t)data_p[0] | ((uint32_t)data_p[1] << 8) | ((uint32_t)data_p[2] << 16) | ((uint32_t)data_p[3] << 24);
+        shifter = table->Table[3][shifter & 0xFFUL] ^ table->Table[2][(shifter >> 8) & 0xFFUL] ^
+                  table->Table[1][(shifter >> 16) & 0xFFUL] ^ table->Table[0][shifter >> 24];
+    }
+#endif /* if KISO_CRC32_SLICING_BY_4 */
+    while (len--)
+    {
+        shifter = (shifter >> 8) ^ table->Table[0][(shifter ^ *data_p++) & 0xFFUL];
+    }
+    return shifter;
+}
+
+#endif /* if KISO_CRC_TABLE_DRIVEN */
+
+static uint8_t Crc8Bitwise(uint8_t poly, uint8_t shifter, const uint8_t *data_p, uint32_t len)
 {
     uint8_t lftmstShftrBit;
-    uint16_t octetIdx = UINT8_C(0);
+    uint32_t octetIdx = UINT32_C(0);
     int8_t bitIdx;
     uint8_t dataStrmOctt;
     uint8_t octetMsk;
     uint8_t dataStrmBit;
-    Retcode_T retVal = RETCODE_OK;
-
-    if ((NULL == shifter) || (NULL == data_p))
-    {
-        retVal = RETCODE(RETCODE_SEVERITY_ERROR, (uint32_t)RETCODE_FAILURE);
-    }
 
     /* As long as there are bit in data stream: check every octet */
-    else
+    while (len--)
     {
-        while (len--)
+        /* Get next octet from data stream */
+        dataStrmOctt = *(data_p + octetIdx);
+
+        /* Next bit in data stream */
+        for (bitIdx = INT8_C(7); bitIdx >= INT8_C(0); bitIdx--)
         {
-            /* Get next octet from data stream */
-            dataStrmOctt = *(data_p + octetIdx);
+            /* Leftmost bit in shifter */
+            lftmstShftrBit = shifter & CRC8_MASK_VAL;
+            octetMsk = (CRC_SHIFT_VAL << bitIdx);
+
+            /* Bit in datastream */
+            dataStrmBit = dataStrmOctt & octetMsk;
 
-            /* Next bit in data stream */
-            for (bitIdx = INT8_C(7); bitIdx >= INT8_C(0); bitIdx--)
+            if ((lftmstShftrBit != UINT8_C(0)) != (dataStrmBit != UINT8_C(0)))
             {
-                /* Leftmost bit in shifter */
-                lftmstShftrBit = *shifter & CRC8_MASK_VAL;
-                octetMsk = (CRC_SHIFT_VAL << bitIdx);
-
-                /* Bit in datastream */
-                dataStrmBit = dataStrmOctt & octetMsk;
-
-                if ((lftmstShftrBit != UINT8_C(0)) != (dataStrmBit != UINT8_C(0)))
-                {
-                    *shifter = (*shifter << CRC_SHIFT_VAL) ^ poly;
-                }
-                else
-                {
-                    *shifter = (*shifter << CRC_SHIFT_VAL);
-                }
+                shifter = (shifter << CRC_SHIFT_VAL) ^ poly;
+            }
+            else
+            {
+                shifter = (shifter << CRC_SHIFT_VAL);
             }
-
-            /* Next byte in datastream */
-            octetIdx++;
         }
 
-        retVal = RETCODE_OK;
+        /* Next byte in datastream */
+        octetIdx++;
     }
-    return (retVal);
+    return shifter;
 }
 
-/*  The description of the function is available in Kiso_CRC.h */
-Retcode_T CRC_16(uint16_t poly, uint16_t *shifter, const uint8_t *data_p, uint16_t len)
+static uint16_t Crc16Bitwise(uint16_t poly, uint16_t shifter, const uint8_t *data_p, uint32_t len)
 {
     uint16_t lftmstShftrBit;
-    uint16_t octetIdx = UINT8_C(0);
+    uint32_t octetIdx = UINT32_C(0);
     int8_t bitIdx;
     uint8_t dataStrmOctt;
     uint8_t octetMsk;
     uint8_t dataStrmBit;
-    Retcode_T retVal = RETCODE_OK;
 
-    if ((NULL == shifter) || (NULL == data_p))
+    /* As long as there are bit in data stream: check every octet */
+    while (len--)
     {
-        retVal = RETCODE(RETCODE_SEVERITY_ERROR, (uint32_t)RETCODE_FAILURE);
+        /* Get next octet from data stream */
+        dataStrmOctt = *(data_p + octetIdx);
+
+        /* Next bit in data stream */
+        for (bitIdx = INT8_C(7); bitIdx >= INT8_C(0); bitIdx--)
+        {
+            /* Leftmost bit in shifter*/
+            lftmstShftrBit = shifter & CRC16_MASK_VAL;
+            octetMsk = (CRC_SHIFT_VAL << bitIdx);
+            /* Bit in data stream */
+            dataStrmBit = dataStrmOctt & octetMsk;
+
+            if ((lftmstShftrBit != UINT16_C(0)) != (dataStrmBit != UINT8_C(0)))
+            {
+                shifter = (shifter << CRC_SHIFT_VAL) ^ poly;
+            }
+            else
+            {
+                shifter = (shifter << CRC_SHIFT_VAL);
+            }
+        }
+
+        /* Next byte in data stream */
+        octetIdx++;
     }
-    else
+    return shifter;
+}
+
+static uint32_t Crc32Bitwise(uint32_t poly, uint32_t shifter, const uint8_t *data_p, uint32_t len)
+{
+    uint32_t lftmstShftrBit;
+    uint32_t octetIdx = UINT32_C(0);
+    int8_t bitIdx;
+    uint8_t dataStrmOctt;
+    uint8_t octetMsk;
+    uint8_t dataStrmBit;
+
+    /* As long as there are bit in data stream: check every octet */
+    while (len--)
     {
-        /* As long as there are bit in data stream: check every octet */
-        while (len--)
+        /* Get next octet from data stream */
+        dataStrmOctt = *(data_p + octetIdx);
+
+        /* Next bit in data stream */
+        for (bitIdx = INT8_C(7); bitIdx >= INT8_C(0); bitIdx--)
         {
-            /* Get next octet from data stream */
-            dataStrmOctt = *(data_p + octetIdx);
+            /* Leftmost bit in shifter */
+            lftmstShftrBit = shifter & CRC32_MASK_VAL;
+
+            octetMsk = (CRC_SHIFT_VAL << bitIdx);
+            /* Bit in data stream */
+            dataStrmBit = dataStrmOctt & octetMsk;
 
-            /* Next bit in data stream */
-            for (bitIdx = INT8_C(7); bitIdx >= INT8_C(0); bitIdx--)
+            if ((lftmstShftrBit != UINT32_C(0)) != (dataStrmBit != UINT8_C(0)))
             {
-                /* Leftmost bit in shifter*/
-                lftmstShftrBit = *shifter & CRC16_MASK_VAL;
-                octetMsk = (CRC_SHIFT_VAL << bitIdx);
-                /* Bit in data stream */
-                dataStrmBit = dataStrmOctt & octetMsk;
-
-                if ((lftmstShftrBit != UINT16_C(0)) != (dataStrmBit != UINT8_C(0)))
-                {
-                    *shifter = (*shifter << CRC_SHIFT_VAL) ^ poly;
-                }
-                else
-                {
-                    *shifter = (*shifter << CRC_SHIFT_VAL);
-                }
+                shifter = (shifter << CRC_SHIFT_VAL) ^ poly;
+            }
+            else
+            {
+                shifter = (shifter << CRC_SHIFT_VAL);
             }
-
-            /* Next byte in data stream */
-            octetIdx++;
         }
 
-        retVal = RETCODE_OK;
+        /* Next byte in data stream */
+        octetIdx++;
     }
-    return (retVal);
+    /* Result in shifter */
+    return shifter;
 }
 
-/*  The description of the function is available in Kiso_CRC.h */
-Retcode_T CRC_32(uint32_t poly, uint32_t *shifter, const uint8_t *data_p, uint16_t len)
+static uint32_t Crc32ReverseBitwise(uint32_t poly, uint32_t shifter, const uint8_t *data_p, uint32_t len)
 {
     uint32_t lftmstShftrBit;
-    uint16_t octetIdx = UINT8_C(0);
+    uint32_t octetIdx = UINT32_C(0);
     int8_t bitIdx;
     uint8_t dataStrmOctt;
     uint8_t octetMsk;
     uint8_t dataStrmBit;
+
+    /* As long as there are bit in data stream: check every octet */
+    while (len--)
+    {
+        /* Get next octet from data stream */
+        dataStrmOctt = *(data_p + octetIdx);
+
+        /* Next bit in data stream */
+        for (bitIdx = INT8_C(0); bitIdx <= INT8_C(7); bitIdx++)
+        {
+            /* Leftmost bit in shifter */
+            lftmstShftrBit = shifter & CRC32_ETHERNET_MASK_VAL;
+
+            /* Bit in data stream */
+            octetMsk = (CRC_SHIFT_VAL << bitIdx);
+            /* Bit in data stream */
+            dataStrmBit = dataStrmOctt & octetMsk;
+
+            if ((lftmstShftrBit != UINT32_C(0)) != (dataStrmBit != UINT8_C(0)))
+            {
+                shifter = (shifter >> CRC_SHIFT_VAL) ^ poly;
+            }
+            else
+            {
+                shifter = (shifter >> CRC_SHIFT_VAL);
+            }
+        }
+
+        /* Next byte in data stream */
+        octetIdx++;
+    }
+    /* Result in shifter */
+    return shifter;
+}
+
+/* Continues a CRC whose register is aligned to the most significant bit, processing octets MSB first */
+static uint32_t UpdateMsbFirst(uint32_t poly, uint32_t shifter, const uint8_t *data_p, uint32_t len)
+{
+#if KISO_CRC_TABLE_DRIVEN
+    const CRC_Table32_T *table = GetCrc32Table(poly);
+    if (NULL != table)
+    {
+        return Crc32Lookup(table, shifter, data_p, len);
+    }
+#endif /* if KISO_CRC_TABLE_DRIVEN */
+    return Crc32Bitwise(poly, shifter, data_p, len);
+}
+
+/* Continues a reflected CRC, whose register is aligned to the least significant bit, processing octets LSB first */
+static uint32_t UpdateLsbFirst(uint32_t poly, uint32_t shifter, const uint8_t *data_p, uint32_t len)
+{
+#if KISO_CRC_TABLE_DRIVEN
+    const CRC_Table32_T *table = GetCrc32ReverseTable(poly);
+    if (NULL != table)
+    {
+        return Crc32ReverseLookup(table, shifter, data_p, len);
+    }
+#endif /* if KISO_CRC_TABLE_DRIVEN */
+    return Crc32ReverseBitwise(poly, shifter, data_p, len);
+}
+
+/*  The description of the function is available in Kiso_CRC.h */
+Retcode_T CRC_8(uint8_t poly, uint8_t *shifter, const uint8_t *data_p, uint16_t len)
+{
     Retcode_T retVal = RETCODE_OK;
 
     if ((NULL == shifter) || (NULL == data_p))
@@ -164,37 +607,59 @@ Retcode_T CRC_32(uint32_t poly, uint32_t *shifter, const uint8_t *data_p, uint16
     }
     else
     {
-        /* As long as there are bit in data stream: check every octet */
-        while (len--)
+#if KISO_CRC_TABLE_DRIVEN
+        const uint8_t *table = GetCrc8Table(poly);
+        if (NULL != table)
+        {
+            *shifter = Crc8Lookup(table, *shifter, data_p, len);
+        }
+        else
+#endif /* if KISO_CRC_TABLE_DRIVEN */
         {
-            /* Get next octet from data stream */
-            dataStrmOctt = *(data_p + octetIdx);
+            *shifter = Crc8Bitwise(poly, *shifter, data_p, len);
+        }
+    }
+    return (retVal);
+}
 
-            /* Next bit in data stream */
-            for (bitIdx = INT8_C(7); bitIdx >= INT8_C(0); bitIdx--)
-            {
-                /* Leftmost bit in shifter */
-                lftmstShftrBit = *shifter & CRC32_MASK_VAL;
-
-                octetMsk = (CRC_SHIFT_VAL << bitIdx);
-                /* Bit in data stream */
-                dataStrmBit = dataStrmOctt & octetMsk;
-
-                if ((lftmstShftrBit != UINT32_C(0)) != (dataStrmBit != UINT8_C(0)))
-                {
-                    *shifter = (*shifter << CRC_SHIFT_VAL) ^ poly;
-                }
-                else
-                {
-                    *shifter = (*shifter << CRC_SHIFT_VAL);
-                }
-            }
+/*  The description of the function is available in Kiso_CRC.h */
+Retcode_T CRC_16(uint16_t poly, uint16_t *shifter, const uint8_t *data_p, uint16_t len)
+{
+    Retcode_T retVal = RETCODE_OK;
 
-            /* Next byte in data stream */
-            octetIdx++;
+    if ((NULL == shifter) || (NULL == data_p))
+    {
+        retVal = RETCODE(RETCODE_SEVERITY_ERROR, (uint32_t)RETCODE_FAILURE);
+    }
+    else
+    {
+#if KISO_CRC_TABLE_DRIVEN
+        const uint16_t *table = GetCrc16Table(poly);
+        if (NULL != table)
+        {
+            *shifter = Crc16Lookup(table, *shifter, data_p, len);
         }
+        else
+#endif /* if KISO_CRC_TABLE_DRIVEN */
+        {
+            *shifter = Crc16Bitwise(poly, *shifter, data_p, len);
+        }
+    }
+    return (retVal);
+}
 
-        retVal = RETCODE_OK;
+/*  The description of the function is available in Kiso_CRC.h */
+Retcode_T CRC_32(uint32_t poly, uint32_t *shifter, const uint8_t *data_p, uint16_t len)
+{
+    Retcode_T retVal = RETCODE_OK;
+
+    if ((NULL == shifter) || (NULL == data_p))
+    {
+        retVal = RETCODE(RETCODE_SEVERITY_ERROR, (uint32_t)RETCODE_FAILURE);
+    }
+    else
+    {
+        *shifter = UpdateMsbFirst(poly, *shifter, data_p, len);
     }
     /* Result in shifter */
     return (retVal);
@@ -203,12 +668,6 @@ Retcode_T CRC_32(uint32_t poly, uint32_t *shifter, const uint8_t *data_p, uint16
 /*  The description of the function is available in Kiso_CRC.h */
 Retcode_T CRC_32_Reverse(uint32_t poly, uint32_t *shifter, const uint8_t *data_p, uint16_t len)
 {
-    uint32_t lftmstShftrBit;
-    uint16_t octetIdx = UINT8_C(0);
-    int8_t bitIdx;
-    uint8_t dataStrmOctt;
-    uint8_t octetMsk;
-    uint8_t dataStrmBit;
     Retcode_T retVal = RETCODE_OK;
 
     if ((NULL == shifter) || (NULL == data_p))
@@ -217,41 +676,172 @@ Retcode_T CRC_32_Reverse(uint32_t poly, uint32_t *shifter, const uint8_t *data_p
     }
     else
     {
-        /* As long as there are bit in data stream: check every octet */
-        while (len--)
+        *shifter = UpdateLsbFirst(poly, *shifter, data_p, len);
+    }
+    /* Result in shifter */
+    return (retVal);
+}
+
+/* Mirrors the lowest width bits of value */
+static uint32_t Reflect(uint32_t value, uint8_t width)
+{
+    uint32_t result = UINT32_C(0);
+
+    for (uint8_t bit = 0U; bit < width; bit++)
+    {
+        result = (result << CRC_SHIFT_VAL) | (value & UINT32_C(1));
+        value >>= CRC_SHIFT_VAL;
+    }
+    return result;
+}
+
+static uint32_t GetWidthMask(uint8_t width)
+{
+    return (CRC_WIDTH_MAX == width) ? UINT32_MAX : ((UINT32_C(1) << width) - UINT32_C(1));
+}
+
+/*
+ * Converts the register of a context to the form defined by the CRC catalogue: width bits wide,
+ * not reflected. This is the form used by the hardware CRC unit.
+ */
+static uint32_t GetCatalogueRegister(const CRC_Context_T *context)
+{
+    uint32_t crcRegister;
+
+    if (context->Params.RefIn)
+    {
+        crcRegister = Reflect(context->Register, context->Params.Width);
+    }
+    else
+    {
+        crcRegister = context->Register >> (CRC_WIDTH_MAX - context->Params.Width);
+    }
+    return crcRegister;
+}
+
+static void SetCatalogueRegister(CRC_Context_T *context, uint32_t crcRegister)
+{
+    if (context->Params.RefIn)
+    {
+        context->Register = Reflect(crcRegister, context->Params.Width);
+    }
+    else
+    {
+        context->Register = crcRegister << (CRC_WIDTH_MAX - context->Params.Width);
+    }
+}
+
+#if KISO_CRC_HARDWARE_OFFLOAD
+/* Returns false if the hardware CRC unit cannot take the calculation and it has to be done in software */
+static bool UpdateInHardware(CRC_Context_T *context, const uint8_t *data_p, uint32_t len)
+{
+    struct MCU_CRC_Stream_S stream;
+    uint32_t crcRegister = GetCatalogueRegister(context);
+    bool isDone = false;
+
+    stream.Width = context->Params.Width;
+    stream.Polynomial = context->Params.Poly;
+    stream.ReflectInput = context->Params.RefIn;
+    if (RETCODE_OK == MCU_CRC_Accumulate(&stream, &crcRegister, data_p, len))
+    {
+        SetCatalogueRegister(context, crcRegister);
+        isDone = true;
+    }
+    return isDone;
+}
+#endif /* if KISO_CRC_HARDWARE_OFFLOAD */
+
+/*  The description of the function is available in Kiso_CRC.h */
+Retcode_T CRC_Initialize(CRC_Context_T *context, const CRC_Params_T *params)
+{
+    Retcode_T retVal = RETCODE_OK;
+
+    if ((NULL == context) || (NULL == params))
+    {
+        retVal = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+    }
+    else if ((CRC_WIDTH_MIN > params->Width) || (CRC_WIDTH_MAX < params->Width))
+    {
+        retVal = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INVALID_PARAM);
+    }
+    else
+    {
+        context->Params = *params;
+        /* The engines work on 32-bit registers: MSB aligned for normal, LSB aligned for reflected CRCs */
+        if (params->RefIn)
+        {
+            context->EnginePoly = Reflect(params->Poly, params->Width);
+        }
+        else
         {
-            /* Get next octet from data stream */
-            dataStrmOctt = *(data_p + octetIdx);
+            context->EnginePoly = (params->Poly & GetWidthMask(params->Width)) << (CRC_WIDTH_MAX - params->Width);
+        }
+        SetCatalogueRegister(context, params->Init & GetWidthMask(params->Width));
+    }
+    return (retVal);
+}
 
-            /* Next bit in data stream */
-            for (bitIdx = INT8_C(0); bitIdx <= INT8_C(7); bitIdx++)
-            {
-                /* Leftmost bit in shifter */
-                lftmstShftrBit = *shifter & CRC32_ETHERNET_MASK_VAL;
-
-                /* Bit in data stream */
-                octetMsk = (CRC_SHIFT_VAL << bitIdx);
-                /* Bit in data stream */
-                dataStrmBit = dataStrmOctt & octetMsk;
-
-                if ((lftmstShftrBit != UINT32_C(0)) != (dataStrmBit != UINT8_C(0)))
-                {
-                    *shifter = (*shifter >> CRC_SHIFT_VAL) ^ poly;
-                }
-                else
-                {
-                    *shifter = (*shifter >> CRC_SHIFT_VAL);
-                }
-            }
+/*  The description of the function is available in Kiso_CRC.h */
+Retcode_T CRC_Update(CRC_Context_T *context, const uint8_t *data_p, uint32_t len)
+{
+    Retcode_T retVal = RETCODE_OK;
 
-            /* Next byte in data stream */
-            octetIdx++;
+    if ((NULL == context) || (NULL == data_p))
+    {
+        retVal = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+    }
+#if KISO_CRC_HARDWARE_OFFLOAD
+    else if (UpdateInHardware(context, data_p, len))
+    {
+        /* Done by the hardware CRC unit */
+    }
+#endif /* if KISO_CRC_HARDWARE_OFFLOAD */
+    else if (context->Params.RefIn)
+    {
+        context->Register = UpdateLsbFirst(context->EnginePoly, context->Register, data_p, len);
+    }
+    else
+    {
+        context->Register = UpdateMsbFirst(context->EnginePoly, context->Register, data_p, len);
+    }
+    return (retVal);
+}
+
+/*  The description of the function is available in Kiso_CRC.h */
+Retcode_T CRC_Finalize(const CRC_Context_T *context, uint32_t *crc)
+{
+    Retcode_T retVal = RETCODE_OK;
+
+    if ((NULL == context) || (NULL == crc))
+    {
+        retVal = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+    }
+    else
+    {
+        uint32_t result = GetCatalogueRegister(context);
+        if (context->Params.RefOut)
+        {
+            result = Reflect(result, context->Params.Width);
         }
+        *crc = (result ^ context->Params.XorOut) & GetWidthMask(context->Params.Width);
+    }
+    return (retVal);
+}
+
+/*  The description of the function is available in Kiso_CRC.h */
+Retcode_T CRC_Calculate(const CRC_Params_T *params, const uint8_t *data_p, uint32_t len, uint32_t *crc)
+{
+    CRC_Context_T context;
+    Retcode_T retVal = CRC_Initialize(&context, params);
 
-        /* Result in shifter */
-        retVal = RETCODE_OK;
+    if (RETCODE_OK == retVal)
+    {
+        retVal = CRC_Update(&context, data_p, len);
+    }
+    if (RETCODE_OK == retVal)
+    {
+        retVal = CRC_Finalize(&context, crc);
     }
-    /* Result in shifter */
     return (retVal);
 }
 
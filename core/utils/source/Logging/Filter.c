@@ -47,6 +47,16 @@
 #define LOG_MODULE_ID_ALL (0)
 #define LOG_FILTER_ID_INVALID (LOG_FILTER_ITEM_COUNT)
 
+#define LOG_FILTER_ID_COUNT (UINT32_C(256))       /**< Number of package and of module ids */
+#define LOG_FILTER_LIMIT_MASK (UINT8_C(0x07))     /**< Limit bits of a package entry */
+#define LOG_FILTER_ROW_SHIFT (3U)                 /**< Position of the row number in a package entry */
+#define LOG_FILTER_LIMIT_PASS_ALL (UINT8_C(0x07)) /**< Limit without any active filter */
+#define LOG_FILTER_NO_ROW (0U)                    /**< Row number of packages without module filters */
+
+#if LOG_FILTER_ITEM_COUNT > 31
+#error "LOG_FILTER_ITEM_COUNT must not exceed 31, the number of rows a package entry can address"
+#endif
+
 /**
  * @brief Log filter item.
  */
@@ -63,6 +73,162 @@ static LogFilterItem_T LogFilterItems[LOG_FILTER_ITEM_COUNT] =
          .Package = LOG_PACKAGE_ID_ALL,
          .Module = LOG_MODULE_ID_ALL}};
 
+/*
+ * The filter items are compiled into lookup tables, so applying them does not depend on
+ * LOG_FILTER_ITEM_COUNT. A log call passes if its level is below the limit of its package and
+ * module, the limit being the highest level of the matching filters plus one, or 0 if no filter
+ * matches.
+ *
+ * Filters for all packages and modules make up a single limit, which lets most log calls pass
+ * after one comparison. Each package entry holds the limit of the filters for all modules of the package
+ * in the lower three bits and a row number in the upper five bits. Packages affected by filters
+ * for single modules get a row with a limit per module, two modules per byte. Packages without a
+ * row of their own share the row of the filters for single modules of all packages, if there are
+ * any. As every filter adds at most one row, LOG_FILTER_ITEM_COUNT rows are enough.
+ *
+ * The tables are rebuilt whenever a filter changes. They are double-buffered: a change compiles
+ * the filter items into the inactive set and then publishes it with a single pointer store, so a
+ * log call applying them at the same time, from a task or an ISR, sees either the old or the new
+ * set but never one being built (unless a second change starts before it completes). Changes of
+ * the filters themselves still have to be serialized by the caller, as before.
+ */
+typedef struct
+{
+    uint8_t Limit;
+    uint8_t Packages[LOG_FILTER_ID_COUNT];
+    uint8_t Rows[LOG_FILTER_ITEM_COUNT][LOG_FILTER_ID_COUNT / 2U];
+} LogFilterTables_T;
+
+static LogFilterTables_T LogFilterTables[2] =
+    {
+        {.Limit = (uint8_t)(LOG_LEVEL_PACKAGE_DEFAULT + 1)}};
+static LogFilterTables_T *LogFilterActiveTables = &LogFilterTables[0];
+
+static uint8_t LogFilter_GetModuleLimit(const LogFilterTables_T *tables, uint32_t row, uint8_t module)
+{
+    return (uint8_t)((tables->Rows[row - 1U][module >> 1] >> ((module & 1U) * 4U)) & 0x0FU);
+}
+
+static void LogFilter_RaiseModuleLimit(LogFilterTables_T *tables, uint32_t row, uint8_t module, uint8_t limit)
+{
+    if (limit > LogFilter_GetModuleLimit(tables, row, module))
+    {
+        uint8_t shift = (uint8_t)((module & 1U) * 4U);
+        uint8_t *entry = &tables->Rows[row - 1U][module >> 1];
+        *entry = (uint8_t)((*entry & ~(0x0FU << shift)) | (uint32_t)(limit << shift));
+    }
+}
+
+static void LogFilter_RaisePackageLimit(LogFilterTables_T *tables, uint8_t package, uint8_t limit)
+{
+    if (limit > (tables->Packages[package] & LOG_FILTER_LIMIT_MASK))
+    {
+        tables->Packages[package] = (uint8_t)((tables->Packages[package] & ~LOG_FILTER_LIMIT_MASK) | limit);
+    }
+}
+
+/* Returns the row of the package, which is created with the filters of the shared row if needed */
+static uint32_t LogFilter_GetPackageRow(LogFilterTables_T *tables, uint8_t package, uint32_t sharedRow, uint32_t *rowCount)
+{
+    uint32_t row = (uint32_t)tables->Packages[package] >> LOG_FILTER_ROW_SHIFT;
+
+    if ((LOG_FILTER_NO_ROW == row) || (row == sharedRow))
+    {
+        row = ++(*rowCount);
+        memset(tables->Rows[row - 1U], 0, sizeof(tables->Rows[0]));
+        for (uint32_t i = 0; i < LOG_FILTER_ITEM_COUNT; ++i)
+        {
+            if (((uint8_t)LOG_LEVEL_NONE != LogFilterItems[i].Level) &&
+                ((uint8_t)LOG_PACKAGE_ID_ALL == LogFilterItems[i].Package) &&
+                ((uint8_t)LOG_MODULE_ID_ALL != LogFilterItems[i].Module))
+            {
+                LogFilter_RaiseModuleLimit(tables, row, LogFilterItems[i].Module, (uint8_t)(LogFilterItems[i].Level + 1U));
+            }
+        }
+        tables->Packages[package] = (uint8_t)((tables->Packages[package] & LOG_FILTER_LIMIT_MASK) | (row << LOG_FILTER_ROW_SHIFT));
+    }
+    return row;
+}
+
+/* Compiles the filter items into the given, inactive lookup tables */
+static void LogFilter_CompileTables(LogFilterTables_T *tables)
+{
+    uint32_t rowCount = UINT32_C(0);
+    uint32_t sharedRow = LOG_FILTER_NO_ROW;
+    bool isAnyActive = false;
+
+    tables->Limit = UINT8_C(0);
+    memset(tables->Packages, 0, sizeof(tables->Packages));
+
+    /* Filters for all modules, and the shared row of filters for single modules of all packages */
+    for (uint32_t i = 0; i < LOG_FILTER_ITEM_COUNT; ++i)
+    {
+        uint8_t limit = (uint8_t)(LogFilterItems[i].Level + 1U);
+
+        if ((uint8_t)LOG_LEVEL_NONE == LogFilterItems[i].Level)
+        {
+            continue;
+        }
+        isAnyActive = true;
+        if ((uint8_t)LOG_MODULE_ID_ALL == LogFilterItems[i].Module)
+        {
+            if ((uint8_t)LOG_PACKAGE_ID_ALL == LogFilterItems[i].Package)
+            {
+                tables->Limit = (limit > tables->Limit) ? limit : tables->Limit;
+            }
+            else
+            {
+                LogFilter_RaisePackageLimit(tables, LogFilterItems[i].Package, limit);
+            }
+        }
+        else if ((uint8_t)LOG_PACKAGE_ID_ALL == LogFilterItems[i].Package)
+        {
+            if (LOG_FILTER_NO_ROW == sharedRow)
+            {
+                sharedRow = ++rowCount;
+                memset(tables->Rows[sharedRow - 1U], 0, sizeof(tables->Rows[0]));
+            }
+            LogFilter_RaiseModuleLimit(tables, sharedRow, LogFilterItems[i].Module, limit);
+        }
+    }
+
+    if (!isAnyActive)
+    {
+        tables->Limit = LOG_FILTER_LIMIT_PASS_ALL;
+        return;
+    }
+    if (LOG_FILTER_NO_ROW != sharedRow)
+    {
+        for (uint32_t package = 0; package < LOG_FILTER_ID_COUNT; ++package)
+        {
+            tables->Packages[package] |= (uint8_t)(sharedRow << LOG_FILTER_ROW_SHIFT);
+        }
+    }
+
+    /* Filters for single modules of single packages, on top of the shared row */
+    for (uint32_t i = 0; i < LOG_FILTER_ITEM_COUNT; ++i)
+    {
+        if (((uint8_t)LOG_LEVEL_NONE != LogFilterItems[i].Level) &&
+            ((uint8_t)LOG_PACKAGE_ID_ALL != LogFilterItems[i].Package) &&
+            ((uint8_t)LOG_MODULE_ID_ALL != LogFilterItems[i].Module))
+        {
+            uint32_t row = LogFilter_GetPackageRow(tables, LogFilterItems[i].Package, sharedRow, &rowCount);
+            LogFilter_RaiseModuleLimit(tables, row, LogFilterItems[i].Module, (uint8_t)(LogFilterItems[i].Level + 1U));
+        }
+    }
+}
+
+/* Compiles the filter items into the inactive lookup tables and makes them the active ones */
+static void LogFilter_Compile(void)
+{
+    LogFilterTables_T *tables = (LogFilterActiveTables == &LogFilterTables[0]) ? &LogFilterTables[1] : &LogFilterTables[0];
+
+    LogFilter_CompileTables(tables);
+
+    /* Publish the tables only after they have been built */
+    __atomic_store_n(&LogFilterActiveTables, tables, __ATOMIC_RELEASE);
+}
+
 /*  The description of the function is available in Kiso_Logging.h */
 LogFilterId_T LogFilter_Add(LogLevel_T level, uint8_t package, uint8_t module)
 {
@@ -75,6 +241,7 @@ LogFilterId_T LogFilter_Add(LogLevel_T level, uint8_t package, uint8_t module)
             LogFilterItems[i].Level = (uint8_t)level;
             LogFilterItems[i].Package = package;
             LogFilterItems[i].Module = module;
+            LogFilter_Compile();
             break;
         }
     }
@@ -97,6 +264,7 @@ Retcode_T LogFilter_Delete(LogFilterId_T id)
     }
 
     LogFilterItems[id].Level = (uint8_t)LOG_LEVEL_NONE;
+    LogFilter_Compile();
     return RETCODE_OK;
 }
 
@@ -111,6 +279,7 @@ Retcode_T LogFilter_Configure(LogFilterId_T id, LogLevel_T level, uint8_t packag
     LogFilterItems[id].Level = (uint8_t)level;
     LogFilterItems[id].Package = package;
     LogFilterItems[id].Module = module;
+    LogFilter_Compile();
 
     return RETCODE_OK;
 }
@@ -118,21 +287,23 @@ Retcode_T LogFilter_Configure(LogFilterId_T id, LogLevel_T level, uint8_t packag
 /*  The description of the function is available in Kiso_Logging.h */
 bool LogFilter_Apply(LogLevel_T level, uint8_t package, uint8_t module)
 {
-    bool enabled = true;
+    const LogFilterTables_T *tables = __atomic_load_n(&LogFilterActiveTables, __ATOMIC_ACQUIRE);
+    uint8_t entry;
+    uint32_t row;
 
-    for (uint32_t i = 0; i < LOG_FILTER_ITEM_COUNT; ++i)
+    if ((uint8_t)level < tables->Limit)
     {
-        if ((uint8_t)LOG_LEVEL_NONE != LogFilterItems[i].Level)
-        {
-            enabled = false;
-            if ((uint8_t)level <= LogFilterItems[i].Level && ((uint8_t)LOG_PACKAGE_ID_ALL == LogFilterItems[i].Package || package == LogFilterItems[i].Package) && ((uint8_t)LOG_MODULE_ID_ALL == LogFilterItems[i].Module || module == LogFilterItems[i].Module))
-            {
-                return true;
-            }
-        }
+        return true;
+    }
+
+    entry = tables->Packages[package];
+    if ((uint8_t)level < (entry & LOG_FILTER_LIMIT_MASK))
+    {
+        return true;
     }
 
-    return enabled;
+    row = (uint32_t)entry >> LOG_FILTER_ROW_SHIFT;
+    return (LOG_FILTER_NO_ROW != row) && ((uint8_t)level < LogFilter_GetModuleLimit(tables, row, module));
 }
 
 #endif /* if KISO_FEATURE_LOGGING */
@@ -21,6 +21,7 @@
  *      Implements log engine interface.
  *      This source file implements following features:
  *      - Logging_Init()
+ *      - Logging_AddAppender()
  *      - Logging_Log()
  * 
  * @file
@@ -42,9 +43,60 @@
 
 /* System header file */
 #include <stdio.h>
+#include <inttypes.h>
+
+/* Message in place of the messages a call site was not allowed to log, see LogRateLimit_Apply() */
+#define LOG_RATE_LIMIT_FMT "%" PRIu32 " messages suppressed"
+
+#ifndef LOG_APPENDER_COUNT
+/* Maximum number of appenders, including the one passed to Logging_Init() */
+#define LOG_APPENDER_COUNT (UINT8_C(2))
+#endif
+
+/* An appender and the highest level it gets */
+typedef struct
+{
+    LogAppender_T Appender;
+    uint8_t Level;
+} Logging_AppenderItem_T;
 
 static LogRecorder_T Logging_Recorder =
-    {.Init = NULL, .Deinit = NULL, .Write = NULL, .Wakeup = NULL, .Appender = {.Init = NULL, .Write = NULL}};
+    {.Init = NULL, .Deinit = NULL, .Write = NULL, .Wakeup = NULL, .Appender = {.Init = NULL, .Write = NULL}, .Append = NULL};
+
+static Logging_AppenderItem_T Logging_Appenders[LOG_APPENDER_COUNT];
+static uint32_t Logging_AppenderCount = 0;
+
+/* Highest level of all appenders, messages above are not recorded at all */
+static uint8_t Logging_AppenderLevel = (uint8_t)LOG_LEVEL_NONE;
+
+static void Logging_UpdateAppenderLevel(void)
+{
+    uint8_t level = (uint8_t)LOG_LEVEL_NONE;
+
+    for (uint32_t i = 0; i < Logging_AppenderCount; ++i)
+    {
+        level = (Logging_Appenders[i].Level > level) ? Logging_Appenders[i].Level : level;
+    }
+    Logging_AppenderLevel = level;
+}
+
+/* Passes a recorded message on to all appenders up to its level, the first error is returned */
+static Retcode_T Logging_Append(void *self, LogLevel_T level, const char *message, uint32_t length)
+{
+    Retcode_T retcode = RETCODE_OK;
+    KISO_UNUSED(self);
+
+    for (uint32_t i = 0; i < Logging_AppenderCount; ++i)
+    {
+        if ((uint8_t)level <= Logging_Appenders[i].Level)
+        {
+            Retcode_T appenderRetcode = Logging_Appenders[i].Appender.Write(message, length);
+            retcode = (RETCODE_OK == retcode) ? appenderRetcode : retcode;
+        }
+    }
+
+    return retcode;
+}
 
 /*  The description of the function is available in Kiso_Logging.h */
 Retcode_T Logging_Init(const LogRecorder_T *recorder, const LogAppender_T *appender)
@@ -59,6 +111,12 @@ Retcode_T Logging_Init(const LogRecorder_T *recorder, const LogAppender_T *appen
     Logging_Recorder.Write = recorder->Write;
     Logging_Recorder.Appender.Init = appender->Init;
     Logging_Recorder.Appender.Write = appender->Write;
+    Logging_Recorder.Append = Logging_Append;
+
+    Logging_Appenders[0].Appender = *appender;
+    Logging_Appenders[0].Level = (uint8_t)LOG_LEVEL_DEBUG;
+    Logging_AppenderCount = 1;
+    Logging_UpdateAppenderLevel();
 
     Retcode_T retcode = Logging_Recorder.Init(&Logging_Recorder);
     if (RETCODE_OK != retcode)
@@ -75,6 +133,63 @@ Retcode_T Logging_Init(const LogRecorder_T *recorder, const LogAppender_T *appen
     return retcode;
 }
 
+/*  The description of the function is available in Kiso_Logging.h */
+Retcode_T Logging_AddAppender(const LogAppender_T *appender, LogLevel_T level)
+{
+    uint32_t i;
+
+    if (NULL == appender || NULL == appender->Init || NULL == appender->Write)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INVALID_PARAM);
+    }
+    if (NULL == Logging_Recorder.Write)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_UNINITIALIZED);
+    }
+
+    for (i = 0; i < Logging_AppenderCount; ++i)
+    {
+        if (Logging_Appenders[i].Appender.Write == appender->Write)
+        {
+            break;
+        }
+    }
+    if (i >= Logging_AppenderCount)
+    {
+        if (Logging_AppenderCount >= LOG_APPENDER_COUNT)
+        {
+            return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_OUT_OF_RESOURCES);
+        }
+
+        Retcode_T retcode = appender->Init(Logging_Recorder.Wakeup);
+        if (RETCODE_OK != retcode)
+        {
+            return retcode;
+        }
+        Logging_Appenders[i].Appender = *appender;
+        Logging_AppenderCount++;
+    }
+
+    Logging_Appenders[i].Level = (uint8_t)level;
+    Logging_UpdateAppenderLevel();
+
+    return RETCODE_OK;
+}
+
+#if KISO_LOG_RATE_LIMIT
+/* Records a message of the logging itself */
+static Retcode_T Logging_Record(LogLevel_T level, uint8_t package, uint8_t module, const char *file,
+                                uint32_t line, const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    Retcode_T retcode = Logging_Recorder.Write(&Logging_Recorder, level, package, module, file, line, fmt, args);
+    va_end(args);
+
+    return retcode;
+}
+#endif /* KISO_LOG_RATE_LIMIT */
+
 /*  The description of the function is available in Kiso_Logging.h */
 Retcode_T Logging_Log(LogLevel_T level, uint8_t package, uint8_t module, const char *file,
                       uint32_t line, const char *fmt, ...)
@@ -84,13 +199,33 @@ Retcode_T Logging_Log(LogLevel_T level, uint8_t package, uint8_t module, const c
         return RETCODE(RETCODE_SEVERITY_WARNING, RETCODE_UNINITIALIZED);
     }
 
-    if (!LogFilter_Apply(level, package, module))
+    if (((uint8_t)level > Logging_AppenderLevel) || !LogFilter_Apply(level, package, module))
     {
         return RETCODE(RETCODE_SEVERITY_INFO, RETCODE_NOT_SUPPORTED);
     }
 
     assert(NULL != file && NULL != fmt);
 
+#if KISO_LOG_RATE_LIMIT
+    uint32_t suppressed = 0;
+    LogRateLimitReport_T report;
+    bool isPassed = LogRateLimit_Apply(level, package, module, file, line, &suppressed);
+    while (LogRateLimit_TakeSuppressed(&report))
+    {
+        /* Counts left by other call sites go to these, like their own count below */
+        (void)Logging_Record(report.Level, report.Package, report.Module, report.File, report.Line, LOG_RATE_LIMIT_FMT, report.Suppressed);
+    }
+    if (!isPassed)
+    {
+        return RETCODE(RETCODE_SEVERITY_INFO, RETCODE_NOT_SUPPORTED);
+    }
+    if (0 != suppressed)
+    {
+        /* The count goes to the call site, so it is filtered and found like its messages */
+        (void)Logging_Record(level, package, module, file, line, LOG_RATE_LIMIT_FMT, suppressed);
+    }
+#endif /* KISO_LOG_RATE_LIMIT */
+
     va_list args;
     va_start(args, fmt);
     Retcode_T retcode = Logging_Recorder.Write(&Logging_Recorder, level, package, module, file, line, fmt, args);
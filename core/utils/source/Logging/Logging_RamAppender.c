@@ -0,0 +1,162 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ *
+ * @brief
+ *      Implements log appender into a RAM ring buffer, which survives warm resets.
+ *
+ * @details
+ *      This source file implements following features:
+ *      - Logging_ReadRAMAppender()
+ *      - Logging_ClearRAMAppender()
+ *
+ *      The buffer is placed in the .noinit section, which the startup code does not clear. A magic
+ *      number tells a buffer kept over a reset from uninitialized RAM after power up. Writers
+ *      reserve their part of the ring with an atomic add, so the appender can be used by several
+ *      tasks and interrupts at once without locking.
+ *
+ * @file
+ **/
+
+/* Module includes */
+#include "Kiso_Utils.h"
+#undef KISO_MODULE_ID
+#define KISO_MODULE_ID KISO_UTILS_MODULE_ID_LOGGING_APPENDER_RAM
+
+/* Include the real interface header */
+#include "Kiso_Logging.h"
+
+#if KISO_FEATURE_LOGGING && KISO_RAM_APPENDER
+
+#include "Kiso_Basics.h"
+#include "Kiso_Retcode.h"
+
+#ifndef LOG_RAM_APPENDER_SIZE
+/* Size of the ring buffer */
+#define LOG_RAM_APPENDER_SIZE (UINT16_C(2048))
+#endif
+
+#if (LOG_RAM_APPENDER_SIZE < 2) || ((LOG_RAM_APPENDER_SIZE & (LOG_RAM_APPENDER_SIZE - 1)) != 0)
+#error "LOG_RAM_APPENDER_SIZE must be a power of two"
+#endif
+
+#define LOG_RAM_APPENDER_MAGIC UINT32_C(0x4C4F4752) /**< Marks a buffer written since power up ("LOGR") */
+
+/* Ring buffer and its state, laid out for debuggers reading it after a crash */
+typedef struct
+{
+    uint32_t Magic;
+    uint32_t Size;
+    uint32_t Head; /**< Bytes written since the buffer was cleared, the last Size of them are kept */
+    char Data[LOG_RAM_APPENDER_SIZE];
+} LogRamAppender_Buffer_T;
+
+LogRamAppender_Buffer_T LogRamAppenderBuffer __attribute__((section(".noinit")));
+
+static bool RamAppender_IsValid(void)
+{
+    return (LOG_RAM_APPENDER_MAGIC == LogRamAppenderBuffer.Magic) && (LOG_RAM_APPENDER_SIZE == LogRamAppenderBuffer.Size);
+}
+
+static Retcode_T RamAppender_Init(void *wakeup)
+{
+    KISO_UNUSED(wakeup);
+
+    /* The log of the time before a warm reset is kept */
+    if (!RamAppender_IsValid())
+    {
+        Logging_ClearRAMAppender();
+    }
+    return RETCODE_OK;
+}
+
+static Retcode_T RamAppender_Write(const char *message, uint32_t length)
+{
+    uint32_t position;
+    uint32_t first;
+
+    if (NULL == message)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+    }
+
+    /* Only the end of a message longer than the buffer is kept anyway */
+    position = __atomic_fetch_add(&LogRamAppenderBuffer.Head, length, __ATOMIC_RELAXED);
+    if (length > LOG_RAM_APPENDER_SIZE)
+    {
+        position += length - LOG_RAM_APPENDER_SIZE;
+        message += length - LOG_RAM_APPENDER_SIZE;
+        length = LOG_RAM_APPENDER_SIZE;
+    }
+
+    position &= (LOG_RAM_APPENDER_SIZE - 1U);
+    first = LOG_RAM_APPENDER_SIZE - position;
+    first = (length < first) ? length : first;
+    memcpy(&LogRamAppenderBuffer.Data[position], message, first);
+    memcpy(LogRamAppenderBuffer.Data, &message[first], length - first);
+
+    return RETCODE_OK;
+}
+
+/*  The description of the function is available in Kiso_Logging.h */
+uint32_t Logging_ReadRAMAppender(uint32_t position, char *buffer, uint32_t size)
+{
+    uint32_t head;
+    uint32_t kept;
+    uint32_t length;
+    uint32_t first;
+
+    if ((NULL == buffer) || !RamAppender_IsValid())
+    {
+        return 0;
+    }
+
+    head = __atomic_load_n(&LogRamAppenderBuffer.Head, __ATOMIC_RELAXED);
+    kept = (head < LOG_RAM_APPENDER_SIZE) ? head : LOG_RAM_APPENDER_SIZE;
+    if (position >= kept)
+    {
+        return 0;
+    }
+
+    length = kept - position;
+    length = (size < length) ? size : length;
+    position = (head - kept + position) & (LOG_RAM_APPENDER_SIZE - 1U);
+    first = LOG_RAM_APPENDER_SIZE - position;
+    first = (length < first) ? length : first;
+    memcpy(buffer, &LogRamAppenderBuffer.Data[position], first);
+    memcpy(&buffer[first], LogRamAppenderBuffer.Data, length - first);
+
+    return length;
+}
+
+/*  The description of the function is available in Kiso_Logging.h */
+void Logging_ClearRAMAppender(void)
+{
+    LogRamAppenderBuffer.Size = LOG_RAM_APPENDER_SIZE;
+    __atomic_store_n(&LogRamAppenderBuffer.Head, 0U, __ATOMIC_RELAXED);
+    LogRamAppenderBuffer.Magic = LOG_RAM_APPENDER_MAGIC;
+}
+
+static const LogAppender_T RamAppender =
+    {
+        .Init = RamAppender_Init,
+        .Write = RamAppender_Write};
+
+/**
+ * Exported
+ */
+const LogAppender_T *Logging_RAMAppender = &RamAppender;
+
+#endif /* if KISO_FEATURE_LOGGING && KISO_RAM_APPENDER */
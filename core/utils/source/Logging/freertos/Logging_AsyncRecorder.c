@@ -0,0 +1,386 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ *
+ * @brief
+ *      Implementation of the asynchronous log recorder.
+ *
+ * @details
+ *      The caller of a LOG_* macro only formats its message into a slot of a lock-free queue,
+ *      which takes no lock and never blocks, so it can be done from tasks and ISRs alike. A
+ *      low-priority logging task adds tick, level, task name and location to each message and
+ *      drains the queue into the appender. When the queue is full, messages are dropped and
+ *      counted; the logging task reports the count in the log.
+ *
+ *      The queue is a bounded array of LOG_QUEUE_BUFFER_SIZE / LOG_BUFFER_SIZE slots, each with a
+ *      sequence number. Producers claim a slot by a compare-and-swap on the enqueue position and
+ *      publish it by advancing its sequence, the logging task consumes published slots in order.
+ *
+ * @file
+ **/
+
+/* Include utils to have access to the defined module and error IDs */
+#include "Kiso_Utils.h"
+#undef KISO_MODULE_ID
+#define KISO_MODULE_ID KISO_UTILS_MODULE_ID_LOGGING_RECORD_ASYNCHRONOUS
+
+/* Include the Logging header, which include the configuration that enable and define macros for this module */
+#include "Kiso_Logging.h"
+
+/* Enable/Disable macro for the feature */
+#if KISO_FEATURE_LOGGING && KISO_ASYNC_RECORDER
+
+/* Include needed headers */
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "Kiso_Basics.h"
+#include "Kiso_Retcode.h"
+#include "Kiso_Assert.h"
+#include "Kiso_HAL.h"
+
+#ifndef LOG_QUEUE_BUFFER_SIZE
+#define LOG_QUEUE_BUFFER_SIZE (UINT16_C(2048))
+#endif
+#ifndef LOG_TASK_STACK_SIZE
+#define LOG_TASK_STACK_SIZE (UINT16_C(256))
+#endif
+#ifndef LOG_TASK_PRIORITY
+#define LOG_TASK_PRIORITY (UINT8_C(1))
+#endif
+
+/* Number of messages the queue can hold, each slot takes LOG_BUFFER_SIZE bytes */
+#define LOG_QUEUE_SLOT_COUNT (LOG_QUEUE_BUFFER_SIZE / LOG_BUFFER_SIZE)
+
+#if (LOG_QUEUE_SLOT_COUNT < 2) || (0 != (LOG_QUEUE_SLOT_COUNT & (LOG_QUEUE_SLOT_COUNT - 1)))
+#error "LOG_QUEUE_BUFFER_SIZE / LOG_BUFFER_SIZE must be a power of two of at least 2"
+#endif
+
+/* Message structure definition via macros*/
+#define LOG_LINE_FMT "%" PRIu32 " %s %" PRIu32 " %.*s\t[%s:%" PRIu32 "]\t"
+#define LOG_LINE_ENDING "\r\n"
+#define LOG_DROPPED_FMT "%" PRIu32 " log messages dropped" LOG_LINE_ENDING
+#define LOG_ISR_TASK_NAME "ISR"
+
+/* Everything known about a message when it is logged, formatted by the logging task */
+typedef struct
+{
+    uint32_t Sequence; /**< Slot is free for the producer at position Sequence, published if Sequence is position + 1 */
+    uint32_t Tick;
+    const char *File;
+    uint32_t Line;
+    uint8_t Level;
+    uint8_t Package;
+    char TaskName[configMAX_TASK_NAME_LEN];
+} AsyncRecorder_Header_T;
+
+/* A slot of the log queue, the message text fills it up to LOG_BUFFER_SIZE */
+typedef struct
+{
+    AsyncRecorder_Header_T Header;
+    char Message[LOG_BUFFER_SIZE - sizeof(AsyncRecorder_Header_T)];
+} AsyncRecorder_Slot_T;
+
+static const char *const LevelString[LOG_LEVEL_COUNT] =
+    {"", "F", "E", "W", "I", "D"};
+
+static AsyncRecorder_Slot_T Queue[LOG_QUEUE_SLOT_COUNT];
+static uint32_t EnqueuePosition;
+static uint32_t DequeuePosition;
+static uint32_t DroppedCount;
+static uint32_t DroppedReported;
+static TaskHandle_t LogTask = NULL;
+
+#if KISO_UTILS_STATIC_ALLOCATION
+static StaticTask_t LogTaskBuffer;
+static StackType_t LogTaskStack[LOG_TASK_STACK_SIZE];
+#endif
+
+/* Only used by the logging task, kept off its stack */
+static char LineBuffer[LOG_BUFFER_SIZE];
+
+static void AsyncRecorder_ResetQueue(void)
+{
+    for (uint32_t i = 0; i < LOG_QUEUE_SLOT_COUNT; i++)
+    {
+        Queue[i].Header.Sequence = i;
+    }
+    EnqueuePosition = 0;
+    DequeuePosition = 0;
+    __atomic_store_n(&DroppedCount, 0, __ATOMIC_RELAXED);
+    DroppedReported = 0;
+}
+
+/*
+ * Claims the slot for the next message. Tasks and ISRs may preempt each other at any point, so
+ * the claim is a compare-and-swap which is simply retried if another producer came first.
+ */
+static AsyncRecorder_Slot_T *AsyncRecorder_Claim(void)
+{
+    uint32_t position = __atomic_load_n(&EnqueuePosition, __ATOMIC_RELAXED);
+
+    for (;;)
+    {
+        AsyncRecorder_Slot_T *slot = &Queue[position & (LOG_QUEUE_SLOT_COUNT - 1)];
+        int32_t distance = (int32_t)(__atomic_load_n(&slot->Header.Sequence, __ATOMIC_ACQUIRE) - position);
+
+        if (0 == distance)
+        {
+            if (__atomic_compare_exchange_n(&EnqueuePosition, &position, position + 1, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                return slot;
+            }
+            /* position has been updated by the failed compare-and-swap */
+        }
+        else if (distance < 0)
+        {
+            /* The slot still holds a message from the previous round, the queue is full */
+            return NULL;
+        }
+        else
+        {
+            position = __atomic_load_n(&EnqueuePosition, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static void AsyncRecorder_WakeUp(bool isInIsr)
+{
+    if (NULL == LogTask)
+    {
+        return;
+    }
+    if (isInIsr)
+    {
+        BaseType_t higherPriorityTaskWoken = pdFALSE;
+        vTaskNotifyGiveFromISR(LogTask, &higherPriorityTaskWoken);
+        portYIELD_FROM_ISR(higherPriorityTaskWoken);
+    }
+    else
+    {
+        (void)xTaskNotifyGive(LogTask);
+    }
+}
+
+/* Writes the line buffer to the appenders */
+static Retcode_T AsyncRecorder_Append(LogRecorder_T *recorder, LogLevel_T level, uint32_t length)
+{
+    if (NULL != recorder->Append)
+    {
+        return recorder->Append(recorder, level, LineBuffer, length);
+    }
+    return recorder->Appender.Write(LineBuffer, length);
+}
+
+/* Formats the published slots and writes them to the appender, returns the number of messages written */
+static uint32_t AsyncRecorder_Drain(LogRecorder_T *recorder)
+{
+    uint32_t count = 0;
+    int32_t size;
+    LogLevel_T level;
+
+    for (;;)
+    {
+        AsyncRecorder_Slot_T *slot = &Queue[DequeuePosition & (LOG_QUEUE_SLOT_COUNT - 1)];
+
+        if ((DequeuePosition + 1) != __atomic_load_n(&slot->Header.Sequence, __ATOMIC_ACQUIRE))
+        {
+            /* Empty, or the oldest message is still being formatted by its producer */
+            break;
+        }
+
+        level = (LogLevel_T)slot->Header.Level;
+        size = snprintf(LineBuffer, sizeof(LineBuffer), LOG_LINE_FMT "%s" LOG_LINE_ENDING,
+                        slot->Header.Tick, LevelString[slot->Header.Level], (uint32_t)slot->Header.Package,
+                        configMAX_TASK_NAME_LEN, slot->Header.TaskName, slot->Header.File, slot->Header.Line,
+                        slot->Message);
+
+        /* Hand the slot back to the producers before the appender possibly blocks */
+        __atomic_store_n(&slot->Header.Sequence, DequeuePosition + LOG_QUEUE_SLOT_COUNT, __ATOMIC_RELEASE);
+        DequeuePosition++;
+
+        if (size > 0)
+        {
+            /* A line longer than the buffer is cut, but still ends the line */
+            if ((uint32_t)size >= sizeof(LineBuffer))
+            {
+                size = (int32_t)sizeof(LineBuffer) - 1;
+                memcpy(&LineBuffer[(uint32_t)size - (sizeof(LOG_LINE_ENDING) - 1)], LOG_LINE_ENDING, sizeof(LOG_LINE_ENDING) - 1);
+            }
+            (void)AsyncRecorder_Append(recorder, level, (uint32_t)size);
+        }
+        count++;
+    }
+
+    uint32_t dropped = __atomic_load_n(&DroppedCount, __ATOMIC_RELAXED);
+    if (dropped != DroppedReported)
+    {
+        size = snprintf(LineBuffer, sizeof(LineBuffer), LOG_DROPPED_FMT, dropped - DroppedReported);
+        DroppedReported = dropped;
+        if ((size > 0) && ((uint32_t)size < sizeof(LineBuffer)))
+        {
+            (void)AsyncRecorder_Append(recorder, LOG_LEVEL_WARNING, (uint32_t)size);
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief
+ * 		The logging task, woken up by a task notification for every message
+ */
+static void AsyncRecorder_Task(void *param)
+{
+    LogRecorder_T *recorder = (LogRecorder_T *)param;
+
+    for (;;)
+    {
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        (void)AsyncRecorder_Drain(recorder);
+    }
+}
+
+/**
+ * @brief
+ * 		Initialize the recorder, create the logging task and hand it as wakeup to the appender
+ */
+static Retcode_T AsyncRecorder_Init(void *self)
+{
+    LogRecorder_T *recorder = (LogRecorder_T *)self;
+    if (NULL == recorder)
+    {
+        return (RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER));
+    }
+    if (NULL != LogTask)
+    {
+        return (RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INCONSISTENT_STATE));
+    }
+
+    AsyncRecorder_ResetQueue();
+#if KISO_UTILS_STATIC_ALLOCATION
+    LogTask = xTaskCreateStatic(AsyncRecorder_Task, "Logging", LOG_TASK_STACK_SIZE, recorder, LOG_TASK_PRIORITY, LogTaskStack, &LogTaskBuffer);
+#else
+    if (pdPASS != xTaskCreate(AsyncRecorder_Task, "Logging", LOG_TASK_STACK_SIZE, recorder, LOG_TASK_PRIORITY, &LogTask))
+    {
+        LogTask = NULL;
+    }
+#endif
+    if (NULL == LogTask)
+    {
+        return (RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_OUT_OF_RESOURCES));
+    }
+    recorder->Wakeup = LogTask;
+
+    return RETCODE_OK;
+}
+
+/**
+ * @brief
+ * 		Deinitialize the recorder, messages which are still queued are lost
+ */
+static Retcode_T AsyncRecorder_Deinit(void *self)
+{
+    LogRecorder_T *recorder = (LogRecorder_T *)self;
+    if (NULL == recorder)
+    {
+        return (RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER));
+    }
+
+    if (NULL != LogTask)
+    {
+        vTaskDelete(LogTask);
+        LogTask = NULL;
+    }
+    recorder->Wakeup = NULL;
+
+    return RETCODE_OK;
+}
+
+/**
+ * @brief
+ * 		Function that will be called when a log API is called (LOG_XXX(...)), from a task or an ISR
+ */
+static Retcode_T AsyncRecorder_Write(void *self, LogLevel_T level, uint8_t package, uint8_t module, const char *file, uint32_t line, const char *fmt, va_list args)
+{
+    KISO_UNUSED(module);
+
+    /* Check NULL pointers to avoid overflows or wrong addressing */
+    if ((NULL == file) || (NULL == fmt) || (NULL == self))
+    {
+        return (RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER));
+    }
+
+    bool isInIsr = HAL_IsInISR();
+    AsyncRecorder_Slot_T *slot = AsyncRecorder_Claim();
+    if (NULL == slot)
+    {
+        (void)__atomic_fetch_add(&DroppedCount, 1, __ATOMIC_RELAXED);
+        return (RETCODE(RETCODE_SEVERITY_WARNING, RETCODE_OUT_OF_RESOURCES));
+    }
+
+    /* Everything which is only valid now is captured, the rest is formatted by the logging task */
+    uint32_t position = slot->Header.Sequence;
+    slot->Header.Level = (uint8_t)level;
+    slot->Header.Package = package;
+    slot->Header.File = file;
+    slot->Header.Line = line;
+    if (isInIsr)
+    {
+        slot->Header.Tick = (uint32_t)xTaskGetTickCountFromISR();
+        (void)strncpy(slot->Header.TaskName, LOG_ISR_TASK_NAME, sizeof(slot->Header.TaskName));
+    }
+    else
+    {
+        slot->Header.Tick = (uint32_t)xTaskGetTickCount();
+        const char *taskName = pcTaskGetTaskName(NULL);
+        (void)strncpy(slot->Header.TaskName, (NULL != taskName) ? taskName : "", sizeof(slot->Header.TaskName));
+    }
+    if (vsnprintf(slot->Message, sizeof(slot->Message), fmt, args) < 0)
+    {
+        slot->Message[0] = '\0';
+    }
+
+    /* Publish the message */
+    __atomic_store_n(&slot->Header.Sequence, position + 1, __ATOMIC_RELEASE);
+
+    AsyncRecorder_WakeUp(isInIsr);
+
+    return RETCODE_OK;
+}
+
+/*  The description of the function is available in Kiso_Logging.h */
+uint32_t Logging_GetDroppedCount(void)
+{
+    return __atomic_load_n(&DroppedCount, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Create singleton
+ */
+static const LogRecorder_T LogRecordAsync =
+    {
+        .Init = AsyncRecorder_Init,
+        .Deinit = AsyncRecorder_Deinit,
+        .Write = AsyncRecorder_Write,
+        .Wakeup = NULL,
+        .Appender =
+            {.Init = NULL, .Write = NULL},
+        .Append = NULL};
+const LogRecorder_T *Logging_AsyncRecorder = &LogRecordAsync;
+
+#endif /* if KISO_FEATURE_LOGGING && KISO_ASYNC_RECORDER*/
@@ -0,0 +1,446 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ *
+ * @brief
+ *      Implementation of the binary (deferred format) synchronous log record.
+ *
+ * @details
+ *      Instead of formatting the message, the recorder writes a record with the addresses of the
+ *      format string and the file name, and the raw arguments. The text is rebuilt on the host from
+ *      the ELF file of the application, see core/utils/tools/log_decoder.py.
+ *
+ *      Every record is sent as one XProtocol frame, which gives the host a CRC and a way to
+ *      resynchronize. The payload of a frame is little-endian:
+ *
+ *      | Flags | Level | Package | Module | Tick | Format | File | Line | Arguments |
+ *      |-------|-------|---------|--------|------|--------|------|------|-----------|
+ *      | 1B    | 1B    | 1B      | 1B     | 4B   | 4B     | 4B   | 4B   | N Bytes   |
+ *
+ *      Format and File are addresses in the ELF file. The arguments follow the conversions of the
+ *      format string:
+ *      - '*' width and precision, c, d, i, o, u, x, X and p (also with the l, h, hh, z, t length
+ *        modifiers): 4 bytes, char and short as promoted to int, the decoder converts them back
+ *      - d, i, o, u, x and X with the ll or j length modifier: 8 bytes
+ *      - a, e, f, g (also upper case): 8 bytes IEEE 754 double, a long double is converted
+ *      - s: 1 byte length and the characters, without terminator, cut at the precision
+ *      - n and %: nothing, %n is not written back
+ *
+ *      If the arguments do not fit into LOG_BINARY_RECORD_SIZE, or the format string contains an
+ *      unknown conversion, the arguments are cut and the truncated flag is set. The name of the
+ *      calling task is not recorded.
+ *
+ * @file
+ **/
+
+/* Include utils to have access to the defined module and error IDs */
+#include "Kiso_Utils.h"
+#undef KISO_MODULE_ID
+#define KISO_MODULE_ID KISO_UTILS_MODULE_ID_LOGGING_RECORD_BINARY
+
+/* Include the Logging header, which include the configuration that enable and define macros for this module */
+#include "Kiso_Logging.h"
+
+/* Enable/Disable macro for the feature */
+#if KISO_FEATURE_LOGGING && KISO_BINARY_RECORDER
+
+#if !KISO_FEATURE_XPROTOCOL
+#error "The binary recorder frames its records with XProtocol, enable KISO_FEATURE_XPROTOCOL"
+#endif
+
+/* Include needed headers */
+#include <stdarg.h>
+#include <stddef.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "Kiso_Basics.h"
+#include "Kiso_Retcode.h"
+#include "Kiso_Assert.h"
+#include "Kiso_XProtocol.h"
+
+#ifndef LOG_BINARY_RECORD_SIZE
+/* Maximum length of the payload of a record */
+#define LOG_BINARY_RECORD_SIZE (UINT16_C(96))
+#endif
+
+#define BINARY_RECORD_HEADER_SIZE UINT32_C(20)     /**< Flags, level, package, module, tick, format, file and line */
+#define BINARY_RECORD_FLAG_TRUNCATED UINT8_C(0x01) /**< Not all arguments fit into the record */
+#define BINARY_RECORD_MAX_STRING_LENGTH UINT32_C(255)
+
+#if LOG_BINARY_RECORD_SIZE <= 20
+#error "LOG_BINARY_RECORD_SIZE must leave room for arguments behind the 20 byte header"
+#endif
+
+static_assert(sizeof(double) == sizeof(uint64_t), "double is expected to be IEEE 754 binary64");
+
+/* Length modifiers which change how an argument is fetched */
+enum BinaryRecorder_Length_E
+{
+    BINARY_RECORDER_LENGTH_DEFAULT,
+    BINARY_RECORDER_LENGTH_LONG,
+    BINARY_RECORDER_LENGTH_LONG_LONG,
+    BINARY_RECORDER_LENGTH_INTMAX,
+    BINARY_RECORDER_LENGTH_SIZE,
+    BINARY_RECORDER_LENGTH_PTRDIFF,
+    BINARY_RECORDER_LENGTH_LONG_DOUBLE
+};
+
+/* Arguments being packed into a record */
+typedef struct BinaryRecorder_Packer_S
+{
+    uint8_t *Buffer;
+    uint32_t Length;
+    uint32_t Size;
+    bool IsTruncated;
+} BinaryRecorder_Packer_T;
+
+static void BinaryRecorder_PutUint32(uint8_t *buffer, uint32_t value)
+{
+    buffer[0] = (uint8_t)value;
+    buffer[1] = (uint8_t)(value >> 8);
+    buffer[2] = (uint8_t)(value >> 16);
+    buffer[3] = (uint8_t)(value >> 24);
+}
+
+static void BinaryRecorder_PackUint32(BinaryRecorder_Packer_T *packer, uint32_t value)
+{
+    if ((packer->Size - packer->Length) < UINT32_C(4))
+    {
+        packer->IsTruncated = true;
+        return;
+    }
+    BinaryRecorder_PutUint32(&packer->Buffer[packer->Length], value);
+    packer->Length += UINT32_C(4);
+}
+
+static void BinaryRecorder_PackUint64(BinaryRecorder_Packer_T *packer, uint64_t value)
+{
+    if ((packer->Size - packer->Length) < UINT32_C(8))
+    {
+        packer->IsTruncated = true;
+        return;
+    }
+    BinaryRecorder_PutUint32(&packer->Buffer[packer->Length], (uint32_t)value);
+    BinaryRecorder_PutUint32(&packer->Buffer[packer->Length + UINT32_C(4)], (uint32_t)(value >> 32));
+    packer->Length += UINT32_C(8);
+}
+
+static void BinaryRecorder_PackDouble(BinaryRecorder_Packer_T *packer, double value)
+{
+    uint64_t bits;
+
+    memcpy(&bits, &value, sizeof(bits));
+    BinaryRecorder_PackUint64(packer, bits);
+}
+
+/* A negative precision means none was given */
+static void BinaryRecorder_PackString(BinaryRecorder_Packer_T *packer, const char *string, int32_t precision)
+{
+    uint32_t maxLength = BINARY_RECORD_MAX_STRING_LENGTH;
+    uint32_t length = UINT32_C(0);
+
+    if (packer->Length >= packer->Size)
+    {
+        packer->IsTruncated = true;
+        return;
+    }
+    if (NULL == string)
+    {
+        string = "(null)";
+    }
+    if ((0 <= precision) && ((uint32_t)precision < maxLength))
+    {
+        maxLength = (uint32_t)precision;
+    }
+    while ((length < maxLength) && ('\0' != string[length]))
+    {
+        length++;
+    }
+    if (length > (packer->Size - packer->Length - UINT32_C(1)))
+    {
+        length = packer->Size - packer->Length - UINT32_C(1);
+        packer->IsTruncated = true;
+    }
+
+    packer->Buffer[packer->Length] = (uint8_t)length;
+    memcpy(&packer->Buffer[packer->Length + UINT32_C(1)], string, length);
+    packer->Length += UINT32_C(1) + length;
+}
+
+static void BinaryRecorder_PackInteger(BinaryRecorder_Packer_T *packer, enum BinaryRecorder_Length_E length, va_list *args)
+{
+    /* The targets are 32 bit, only long long and intmax_t need 8 bytes */
+    switch (length)
+    {
+    case BINARY_RECORDER_LENGTH_LONG:
+        BinaryRecorder_PackUint32(packer, (uint32_t)va_arg(*args, unsigned long));
+        break;
+    case BINARY_RECORDER_LENGTH_LONG_LONG:
+        BinaryRecorder_PackUint64(packer, (uint64_t)va_arg(*args, unsigned long long));
+        break;
+    case BINARY_RECORDER_LENGTH_INTMAX:
+        BinaryRecorder_PackUint64(packer, (uint64_t)va_arg(*args, uintmax_t));
+        break;
+    case BINARY_RECORDER_LENGTH_SIZE:
+        BinaryRecorder_PackUint32(packer, (uint32_t)va_arg(*args, size_t));
+        break;
+    case BINARY_RECORDER_LENGTH_PTRDIFF:
+        BinaryRecorder_PackUint32(packer, (uint32_t)va_arg(*args, ptrdiff_t));
+        break;
+    default:
+        /* char and short are promoted to int */
+        BinaryRecorder_PackUint32(packer, (uint32_t)va_arg(*args, unsigned int));
+        break;
+    }
+}
+
+/* Skips flags, width, precision and length modifier, returns the conversion character */
+static const char *BinaryRecorder_ParseSpecification(const char *fmt, BinaryRecorder_Packer_T *packer, va_list *args,
+                                                     int32_t *precision, enum BinaryRecorder_Length_E *length)
+{
+    while (NULL != strchr("-+ #0", *fmt) && ('\0' != *fmt))
+    {
+        fmt++;
+    }
+    if ('*' == *fmt)
+    {
+        BinaryRecorder_PackUint32(packer, (uint32_t)va_arg(*args, int));
+        fmt++;
+    }
+    while (('0' <= *fmt) && ('9' >= *fmt))
+    {
+        fmt++;
+    }
+
+    *precision = -1;
+    if ('.' == *fmt)
+    {
+        fmt++;
+        if ('*' == *fmt)
+        {
+            *precision = (int32_t)va_arg(*args, int);
+            BinaryRecorder_PackUint32(packer, (uint32_t)*precision);
+            fmt++;
+        }
+        else
+        {
+            *precision = 0;
+            while (('0' <= *fmt) && ('9' >= *fmt))
+            {
+                *precision = (*precision * 10) + (*fmt - '0');
+                fmt++;
+            }
+        }
+    }
+
+    *length = BINARY_RECORDER_LENGTH_DEFAULT;
+    switch (*fmt)
+    {
+    case 'h':
+        fmt += ('h' == fmt[1]) ? 2 : 1;
+        break;
+    case 'l':
+        *length = ('l' == fmt[1]) ? BINARY_RECORDER_LENGTH_LONG_LONG : BINARY_RECORDER_LENGTH_LONG;
+        fmt += ('l' == fmt[1]) ? 2 : 1;
+        break;
+    case 'j':
+        *length = BINARY_RECORDER_LENGTH_INTMAX;
+        fmt++;
+        break;
+    case 'z':
+        *length = BINARY_RECORDER_LENGTH_SIZE;
+        fmt++;
+        break;
+    case 't':
+        *length = BINARY_RECORDER_LENGTH_PTRDIFF;
+        fmt++;
+        break;
+    case 'L':
+        *length = BINARY_RECORDER_LENGTH_LONG_DOUBLE;
+        fmt++;
+        break;
+    default:
+        break;
+    }
+    return fmt;
+}
+
+/* Copies the arguments of fmt into the packer, without formatting them */
+static void BinaryRecorder_PackArguments(BinaryRecorder_Packer_T *packer, const char *fmt, va_list *args)
+{
+    while (('\0' != *fmt) && !packer->IsTruncated)
+    {
+        int32_t precision;
+        enum BinaryRecorder_Length_E length;
+
+        if ('%' != *fmt++)
+        {
+            continue;
+        }
+        if ('%' == *fmt)
+        {
+            fmt++;
+            continue;
+        }
+
+        fmt = BinaryRecorder_ParseSpecification(fmt, packer, args, &precision, &length);
+        switch (*fmt)
+        {
+        case 'c':
+        case 'd':
+        case 'i':
+        case 'o':
+        case 'u':
+        case 'x':
+        case 'X':
+            BinaryRecorder_PackInteger(packer, length, args);
+            break;
+        case 'p':
+            BinaryRecorder_PackUint32(packer, (uint32_t)(uintptr_t)va_arg(*args, void *));
+            break;
+        case 'a':
+        case 'A':
+        case 'e':
+        case 'E':
+        case 'f':
+        case 'F':
+        case 'g':
+        case 'G':
+            if (BINARY_RECORDER_LENGTH_LONG_DOUBLE == length)
+            {
+                BinaryRecorder_PackDouble(packer, (double)va_arg(*args, long double));
+            }
+            else
+            {
+                BinaryRecorder_PackDouble(packer, va_arg(*args, double));
+            }
+            break;
+        case 's':
+            BinaryRecorder_PackString(packer, va_arg(*args, const char *), precision);
+            break;
+        case 'n':
+            (void)va_arg(*args, void *);
+            break;
+        default:
+            /* The type of the remaining arguments is unknown */
+            packer->IsTruncated = true;
+            break;
+        }
+        if ('\0' != *fmt)
+        {
+            fmt++;
+        }
+    }
+}
+
+/**
+ * @brief
+ * 		Initialize the recorder (check if the object provided is valid)
+ */
+static Retcode_T BinaryRecorder_Init(void *self)
+{
+    LogRecorder_T *recorder = (LogRecorder_T *)self;
+    if (NULL == recorder)
+    {
+        return (RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER));
+    }
+    return RETCODE_OK;
+}
+
+/**
+ * @brief
+ * 		Deinitialize the recorder (check if the object provided is valid)
+ */
+static Retcode_T BinaryRecorder_Deinit(void *self)
+{
+    LogRecorder_T *recorder = (LogRecorder_T *)self;
+    if (NULL == recorder)
+    {
+        return (RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER));
+    }
+    return RETCODE_OK;
+}
+
+/**
+ * @brief
+ * 		Function that will be called when a log API is called (LOG_XXX(...))
+ */
+static Retcode_T BinaryRecorder_Write(void *self, LogLevel_T level, uint8_t package, uint8_t module, const char *file, uint32_t line, const char *fmt, va_list args)
+{
+    uint8_t record[LOG_BINARY_RECORD_SIZE];
+    uint8_t frame[XPROTOCOL_MAX_ENCODED_LENGTH(LOG_BINARY_RECORD_SIZE)];
+    uint32_t frameLength = UINT32_C(0);
+    BinaryRecorder_Packer_T packer;
+    va_list argsCopy;
+    Retcode_T retcode;
+
+    /* Check NULL pointers to avoid overflows or wrong addressing */
+    if ((NULL == file) || (NULL == fmt) || (NULL == self))
+    {
+        return (RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER));
+    }
+
+    /* Cast the pointer to the recorder to be able to access the appender */
+    LogRecorder_T *recorder = (LogRecorder_T *)self;
+
+    record[1] = (uint8_t)level;
+    record[2] = package;
+    record[3] = module;
+    BinaryRecorder_PutUint32(&record[4], (uint32_t)xTaskGetTickCount());
+    BinaryRecorder_PutUint32(&record[8], (uint32_t)(uintptr_t)fmt);
+    BinaryRecorder_PutUint32(&record[12], (uint32_t)(uintptr_t)file);
+    BinaryRecorder_PutUint32(&record[16], line);
+
+    packer.Buffer = record;
+    packer.Length = BINARY_RECORD_HEADER_SIZE;
+    packer.Size = sizeof(record);
+    packer.IsTruncated = false;
+
+    /* va_list may be an array type, a copy can be passed on by address in any case */
+    va_copy(argsCopy, args);
+    BinaryRecorder_PackArguments(&packer, fmt, &argsCopy);
+    va_end(argsCopy);
+    record[0] = packer.IsTruncated ? BINARY_RECORD_FLAG_TRUNCATED : UINT8_C(0);
+
+    retcode = XProtocol_EncodeFrame(record, packer.Length, sizeof(frame), frame, &frameLength);
+    if (RETCODE_OK != retcode)
+    {
+        return retcode;
+    }
+
+    /* Write to the appenders the generated log record */
+    if (NULL != recorder->Append)
+    {
+        return recorder->Append(recorder, level, (const char *)frame, frameLength);
+    }
+    return recorder->Appender.Write((const char *)frame, frameLength);
+}
+
+/**
+ * @brief Create singleton
+ */
+static const LogRecorder_T LogRecordBinary =
+    {
+        .Init = BinaryRecorder_Init,
+        .Deinit = BinaryRecorder_Deinit,
+        .Write = BinaryRecorder_Write,
+        .Wakeup = NULL,
+        .Appender =
+            {.Init = NULL, .Write = NULL},
+        .Append = NULL};
+const LogRecorder_T *Logging_BinaryRecorder = &LogRecordBinary;
+
+#endif /* if KISO_FEATURE_LOGGING && KISO_BINARY_RECORDER */
@@ -0,0 +1,278 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ *
+ * @brief
+ *      Rate limiting of log call sites.
+ *
+ * @details
+ *      This source file implements following features:
+ *      - LogRateLimit_Apply()
+ *      - LogRateLimit_TakeSuppressed()
+ *
+ *      Every call site, identified by its file and line, may log a number of messages per
+ *      LOG_RATE_LIMIT_WINDOW ms which depends on the level, see LOG_RATE_LIMIT_BUDGET_*. Further
+ *      messages of the call site in the same window are only counted, the count is handed to the
+ *      first message of the call site after the window.
+ *
+ *      The call sites which logged last are kept in a small hash table of LOG_RATE_LIMIT_SLOTS
+ *      entries, a call site which finds no free entry replaces the one with the oldest window.
+ *      The count of a replaced call site, and of a call site which did not log again after its
+ *      window, is handed to the next message of any call site instead. Up to
+ *      LOG_RATE_LIMIT_EVICTED replaced counts can wait for it; while that many wait, a call
+ *      site which finds no free entry is not limited.
+ *
+ * @file
+ **/
+
+/* Module includes */
+#include "Kiso_Utils.h"
+#undef KISO_MODULE_ID
+#define KISO_MODULE_ID KISO_UTILS_MODULE_ID_LOGGING_RATE_LIMIT
+
+/* Include Kiso_Logging interface header */
+#include "Kiso_Logging.h"
+
+#if KISO_FEATURE_LOGGING && KISO_LOG_RATE_LIMIT
+
+/* KISO header files */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "Kiso_Basics.h"
+#include "Kiso_HAL.h"
+#include "Kiso_HAL_CriticalSection.h"
+
+#ifndef LOG_RATE_LIMIT_SLOTS
+/* Number of call sites tracked at once, a power of two */
+#define LOG_RATE_LIMIT_SLOTS (UINT8_C(16))
+#endif
+#ifndef LOG_RATE_LIMIT_WINDOW
+/* Length of a window in ms */
+#define LOG_RATE_LIMIT_WINDOW (UINT32_C(1000))
+#endif
+/* Messages a call site may log per window, 0 for no limit */
+#ifndef LOG_RATE_LIMIT_BUDGET_FATAL
+#define LOG_RATE_LIMIT_BUDGET_FATAL (UINT16_C(0))
+#endif
+#ifndef LOG_RATE_LIMIT_BUDGET_ERROR
+#define LOG_RATE_LIMIT_BUDGET_ERROR (UINT16_C(10))
+#endif
+#ifndef LOG_RATE_LIMIT_BUDGET_WARNING
+#define LOG_RATE_LIMIT_BUDGET_WARNING (UINT16_C(5))
+#endif
+#ifndef LOG_RATE_LIMIT_BUDGET_INFO
+#define LOG_RATE_LIMIT_BUDGET_INFO (UINT16_C(5))
+#endif
+#ifndef LOG_RATE_LIMIT_BUDGET_DEBUG
+#define LOG_RATE_LIMIT_BUDGET_DEBUG (UINT16_C(5))
+#endif
+
+#if (LOG_RATE_LIMIT_SLOTS < 1) || ((LOG_RATE_LIMIT_SLOTS & (LOG_RATE_LIMIT_SLOTS - 1)) != 0)
+#error "LOG_RATE_LIMIT_SLOTS must be a power of two"
+#endif
+
+/* Number of entries searched for a call site, starting at its hash */
+#define LOG_RATE_LIMIT_PROBES ((LOG_RATE_LIMIT_SLOTS < 4) ? LOG_RATE_LIMIT_SLOTS : 4U)
+
+/* Number of replaced call sites whose count was not taken yet */
+#define LOG_RATE_LIMIT_EVICTED (2U)
+
+/* A call site and its current window */
+typedef struct
+{
+    const char *File;
+    uint32_t Line;
+    TickType_t WindowStart;
+    uint16_t Count;
+    uint8_t Package;
+    uint8_t Module;
+    LogLevel_T Level; /**< of the last suppressed message */
+    uint32_t Suppressed;
+} LogRateLimitSlot_T;
+
+static const uint16_t LogRateLimitBudget[LOG_LEVEL_COUNT] =
+    {
+        0,
+        LOG_RATE_LIMIT_BUDGET_FATAL,
+        LOG_RATE_LIMIT_BUDGET_ERROR,
+        LOG_RATE_LIMIT_BUDGET_WARNING,
+        LOG_RATE_LIMIT_BUDGET_INFO,
+        LOG_RATE_LIMIT_BUDGET_DEBUG};
+
+static LogRateLimitSlot_T LogRateLimitSlots[LOG_RATE_LIMIT_SLOTS];
+
+/* Replaced call sites with a count, free while File is NULL */
+static LogRateLimitSlot_T LogRateLimitEvicted[LOG_RATE_LIMIT_EVICTED];
+
+/* Counts in the slots and the replaced call sites, lets logging skip LogRateLimit_TakeSuppressed() */
+static uint32_t LogRateLimitPending = 0;
+
+/* File names are string literals, so their addresses tell the files apart */
+static uint32_t LogRateLimit_Hash(const char *file, uint32_t line)
+{
+    uint32_t hash = (uint32_t)(uintptr_t)file ^ (line * UINT32_C(0x9E3779B1));
+    return (hash ^ (hash >> 16)) & (LOG_RATE_LIMIT_SLOTS - 1U);
+}
+
+static LogRateLimitSlot_T *LogRateLimit_Find(const char *file, uint32_t line, TickType_t now)
+{
+    uint32_t index = LogRateLimit_Hash(file, line);
+    LogRateLimitSlot_T *oldest = &LogRateLimitSlots[index];
+
+    for (uint32_t i = 0; i < LOG_RATE_LIMIT_PROBES; ++i)
+    {
+        LogRateLimitSlot_T *slot = &LogRateLimitSlots[(index + i) & (LOG_RATE_LIMIT_SLOTS - 1U)];
+        if ((slot->File == file) && (slot->Line == line))
+        {
+            return slot;
+        }
+        if ((NULL == slot->File) || ((TickType_t)(now - slot->WindowStart) > (TickType_t)(now - oldest->WindowStart)))
+        {
+            oldest = slot;
+            if (NULL == slot->File)
+            {
+                break;
+            }
+        }
+    }
+
+    if (0 != oldest->Suppressed)
+    {
+        LogRateLimitSlot_T *evicted = NULL;
+        for (uint32_t i = 0; (i < LOG_RATE_LIMIT_EVICTED) && (NULL == evicted); ++i)
+        {
+            evicted = (NULL == LogRateLimitEvicted[i].File) ? &LogRateLimitEvicted[i] : NULL;
+        }
+        if (NULL == evicted)
+        {
+            /* Keep the count rather than tracking the call site */
+            return NULL;
+        }
+        *evicted = *oldest;
+    }
+
+    oldest->File = file;
+    oldest->Line = line;
+    oldest->WindowStart = now;
+    oldest->Count = 0;
+    oldest->Suppressed = 0;
+    return oldest;
+}
+
+/*  The description of the function is available in Kiso_Logging.h */
+bool LogRateLimit_Apply(LogLevel_T level, uint8_t package, uint8_t module, const char *file, uint32_t line, uint32_t *suppressed)
+{
+    bool isPassed = true;
+    uint32_t count = 0;
+    TickType_t now;
+
+    *suppressed = 0;
+    if (((uint32_t)level >= (uint32_t)LOG_LEVEL_COUNT) || (0 == LogRateLimitBudget[level]))
+    {
+        return true;
+    }
+
+    now = HAL_IsInISR() ? xTaskGetTickCountFromISR() : xTaskGetTickCount();
+
+    /* Tasks and ISRs log alike, a slot is only changed with interrupts disabled */
+    (void)HAL_CriticalSection_Enter(&count);
+
+    /* A call site without a slot is not limited */
+    LogRateLimitSlot_T *slot = LogRateLimit_Find(file, line, now);
+    if (NULL != slot)
+    {
+        if ((TickType_t)(now - slot->WindowStart) >= pdMS_TO_TICKS(LOG_RATE_LIMIT_WINDOW))
+        {
+            *suppressed = slot->Suppressed;
+            LogRateLimitPending -= (0 != slot->Suppressed) ? 1U : 0U;
+            slot->WindowStart = now;
+            slot->Count = 0;
+            slot->Suppressed = 0;
+        }
+        if (slot->Count < LogRateLimitBudget[level])
+        {
+            slot->Count++;
+        }
+        else
+        {
+            LogRateLimitPending += (0 == slot->Suppressed) ? 1U : 0U;
+            slot->Package = package;
+            slot->Module = module;
+            slot->Level = level;
+            slot->Suppressed++;
+            isPassed = false;
+        }
+    }
+
+    (void)HAL_CriticalSection_Leave(&count);
+
+    return isPassed;
+}
+
+/* Hands out the count of a slot and clears it */
+static void LogRateLimit_Take(LogRateLimitSlot_T *slot, LogRateLimitReport_T *report)
+{
+    report->File = slot->File;
+    report->Line = slot->Line;
+    report->Level = slot->Level;
+    report->Package = slot->Package;
+    report->Module = slot->Module;
+    report->Suppressed = slot->Suppressed;
+    slot->Suppressed = 0;
+    LogRateLimitPending--;
+}
+
+/*  The description of the function is available in Kiso_Logging.h */
+bool LogRateLimit_TakeSuppressed(LogRateLimitReport_T *report)
+{
+    bool isTaken = false;
+    uint32_t count = 0;
+    TickType_t now;
+
+    if (0 == __atomic_load_n(&LogRateLimitPending, __ATOMIC_RELAXED))
+    {
+        return false;
+    }
+
+    now = HAL_IsInISR() ? xTaskGetTickCountFromISR() : xTaskGetTickCount();
+
+    (void)HAL_CriticalSection_Enter(&count);
+
+    for (uint32_t i = 0; (i < LOG_RATE_LIMIT_EVICTED) && !isTaken; ++i)
+    {
+        if (NULL != LogRateLimitEvicted[i].File)
+        {
+            LogRateLimit_Take(&LogRateLimitEvicted[i], report);
+            LogRateLimitEvicted[i].File = NULL;
+            isTaken = true;
+        }
+    }
+    for (uint32_t i = 0; (i < LOG_RATE_LIMIT_SLOTS) && !isTaken; ++i)
+    {
+        LogRateLimitSlot_T *slot = &LogRateLimitSlots[i];
+        if ((0 != slot->Suppressed) && ((TickType_t)(now - slot->WindowStart) >= pdMS_TO_TICKS(LOG_RATE_LIMIT_WINDOW)))
+        {
+            /* The call site starts a new window with its next message, which has nothing left to report */
+            LogRateLimit_Take(slot, report);
+            isTaken = true;
+        }
+    }
+
+    (void)HAL_CriticalSection_Leave(&count);
+
+    return isTaken;
+}
+
+#endif /* if KISO_FEATURE_LOGGING && KISO_LOG_RATE_LIMIT */
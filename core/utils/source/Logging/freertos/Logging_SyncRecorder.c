@@ -113,7 +113,11 @@ static Retcode_T SyncRecorder_Write(void *self, LogLevel_T level, uint8_t packag
         size += snprintf(buffer + size, sizeof(buffer) - size, LOG_LINE_ENDING);
     }
 
-    /* Write to the appender the generated log message */
+    /* Write to the appenders the generated log message */
+    if (NULL != recorder->Append)
+    {
+        return recorder->Append(recorder, level, buffer, size);
+    }
     return recorder->Appender.Write(buffer, size);
 }
 
@@ -127,7 +131,8 @@ static const LogRecorder_T LogRecordSyncCompact =
         .Write = SyncRecorder_Write,
         .Wakeup = NULL,
         .Appender =
-            {.Init = NULL, .Write = NULL}};
+            {.Init = NULL, .Write = NULL},
+        .Append = NULL};
 const LogRecorder_T *Logging_SyncRecorder = &LogRecordSyncCompact;
 
 #endif /* if KISO_FEATURE_LOGGING && KISO_SYNC_RECORDER*/
@@ -74,6 +74,10 @@ UARTTransceiver_T LogTransceiver;
 
 uint8_t buffer[LOG_BUFFER_SIZE];
 
+#if KISO_UTILS_STATIC_ALLOCATION && !KISO_UTILS_TASK_NOTIFICATIONS
+static UARTTransceiver_Storage_T LogTransceiverStorage;
+#endif
+
 /*---------------------- EXPOSED FUNCTIONS IMPLEMENTATION -----------------------------------------------------------*/
 
 /*---------------------- LOCAL FUNCTIONS IMPLEMENTATION -------------------------------------------------------------*/
@@ -90,7 +94,11 @@ static Retcode_T UartAppenderInit(void *init)
     }
     if (RETCODE_OK == retcode)
     {
+#if KISO_UTILS_STATIC_ALLOCATION && !KISO_UTILS_TASK_NOTIFICATIONS
+        retcode = UARTTransceiver_InitializeStatic(&LogTransceiver, uartHandle, buffer, LOG_BUFFER_SIZE, UART_TRANSCEIVER_UART_TYPE_UART, &LogTransceiverStorage);
+#else
         retcode = UARTTransceiver_Initialize(&LogTransceiver, uartHandle, buffer, LOG_BUFFER_SIZE, UART_TRANSCEIVER_UART_TYPE_UART);
+#endif
     }
     if (RETCODE_OK == retcode)
     {
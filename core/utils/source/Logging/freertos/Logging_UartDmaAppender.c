@@ -0,0 +1,308 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ *
+ * @brief
+ *      Implements a batching log appender over the UART of the test interface.
+ *
+ * @details
+ *      Log lines are collected in one of two buffers while the other one is sent. A buffer is
+ *      sent when it is full, or LOG_UART_DMA_FLUSH_TIMEOUT ms after the first line went into
+ *      it. The transceiver runs in asynchronous mode, so a send only starts the DMA (or
+ *      interrupt driven) transfer of the MCU driver and returns, the transfer complete event
+ *      hands the buffer back. A writer only waits if a buffer fills up before the previous one
+ *      is sent, that is if more is logged than the UART can carry.
+ *
+ *      Use it instead of KISO_UART_APPENDER, both appenders own the UART of the test interface.
+ *
+ * @file
+ **/
+
+/* Module includes */
+#include "Kiso_Utils.h"
+#undef KISO_MODULE_ID
+#define KISO_MODULE_ID KISO_UTILS_MODULE_ID_LOGGING_APPENDER_UART_DMA
+
+/* Include the real interface header */
+#include "Kiso_Logging.h"
+
+#if KISO_FEATURE_LOGGING && KISO_UART_DMA_APPENDER
+
+/* Additional interface header files */
+#include <string.h>
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "timers.h"
+#include "Kiso_BSP_TestInterface.h"
+#include "Kiso_MCU_UART.h"
+#include "Kiso_UARTTransceiver.h"
+
+#if !KISO_FEATURE_BSP_TEST_INTERFACE
+#error "KISO_Logginng module needs KISO_FEATURE_BSP_TEST_INTERFACE feature to be implemented and enabled."
+#endif
+
+#if !KISO_FEATURE_UART
+#error "KISO_Logginng module needs KISO_FEATURE_UART feature to be implemented and enabled."
+#endif
+
+#if !KISO_FEATURE_UARTTRANSCEIVER
+#error "KISO_Logginng module needs KISO_FEATURE_UARTTRANSCEIVER feature to be implemented and enabled."
+#endif
+/*---------------------- MACROS DEFINITION --------------------------------------------------------------------------*/
+
+#ifndef LOG_UART_DMA_BUFFER_SIZE
+/* Size of each of the two buffers */
+#define LOG_UART_DMA_BUFFER_SIZE (UINT16_C(512))
+#endif
+#ifndef LOG_UART_DMA_FLUSH_TIMEOUT
+/* Time in ms after which a buffer which is not full is sent */
+#define LOG_UART_DMA_FLUSH_TIMEOUT (UINT32_C(20))
+#endif
+
+/* The appender does not receive, the transceiver still needs a receive buffer */
+#define LOG_UART_DMA_RX_BUFFER_SIZE (UINT32_C(1))
+
+/*---------------------- LOCAL FUNCTIONS DECLARATION ----------------------------------------------------------------*/
+static Retcode_T UartDmaAppenderInit(void *init);
+static Retcode_T UartDmaAppenderWrite(const char *message, uint32_t length);
+static void UartDmaCallback(UART_T uart, struct MCU_UART_Event_S event);
+static void UartDmaTransceiverCallback(struct MCU_UART_Event_S event);
+static void UartDmaFlushTimeout(TimerHandle_t timer);
+static bool UartDmaCheckEndFrameFunc(uint8_t lastByte);
+
+/*---------------------- VARIABLES DECLARATION ----------------------------------------------------------------------*/
+static const LogAppender_T UartDmaAppender =
+    {
+        .Init = UartDmaAppenderInit,
+        .Write = UartDmaAppenderWrite};
+/**
+ * Exported
+ */
+const LogAppender_T *Logging_UARTDMAAppender = &UartDmaAppender;
+
+static UARTTransceiver_T UartDmaTransceiver;
+
+static uint8_t UartDmaRxBuffer[LOG_UART_DMA_RX_BUFFER_SIZE];
+
+/* The buffer being filled is UartDmaBuffers[UartDmaFillIndex], the other one may be in transfer */
+static uint8_t UartDmaBuffers[2][LOG_UART_DMA_BUFFER_SIZE];
+static uint32_t UartDmaFillIndex = 0;
+static uint32_t UartDmaFillLength = 0;
+
+/* The flush timer runs for the buffer being filled */
+static bool UartDmaIsFlushPending = false;
+
+/* Serializes the writers and the flush timer */
+static SemaphoreHandle_t UartDmaLock = NULL;
+
+/* Available while no transfer is running */
+static SemaphoreHandle_t UartDmaTxDone = NULL;
+
+static TimerHandle_t UartDmaFlushTimer = NULL;
+
+#if KISO_UTILS_STATIC_ALLOCATION
+static StaticSemaphore_t UartDmaLockBuffer;
+static StaticSemaphore_t UartDmaTxDoneBuffer;
+static StaticTimer_t UartDmaFlushTimerBuffer;
+#if !KISO_UTILS_TASK_NOTIFICATIONS
+static UARTTransceiver_Storage_T UartDmaTransceiverStorage;
+#endif
+#endif
+
+/*---------------------- EXPOSED FUNCTIONS IMPLEMENTATION -----------------------------------------------------------*/
+
+/*---------------------- LOCAL FUNCTIONS IMPLEMENTATION -------------------------------------------------------------*/
+
+static Retcode_T UartDmaAppenderCreateResources(void)
+{
+    if (NULL == UartDmaLock)
+    {
+#if KISO_UTILS_STATIC_ALLOCATION
+        UartDmaLock = xSemaphoreCreateMutexStatic(&UartDmaLockBuffer);
+#else
+        UartDmaLock = xSemaphoreCreateMutex();
+#endif
+    }
+    if (NULL == UartDmaTxDone)
+    {
+#if KISO_UTILS_STATIC_ALLOCATION
+        UartDmaTxDone = xSemaphoreCreateBinaryStatic(&UartDmaTxDoneBuffer);
+#else
+        UartDmaTxDone = xSemaphoreCreateBinary();
+#endif
+        if (NULL != UartDmaTxDone)
+        {
+            (void)xSemaphoreGive(UartDmaTxDone);
+        }
+    }
+    if (NULL == UartDmaFlushTimer)
+    {
+#if KISO_UTILS_STATIC_ALLOCATION
+        UartDmaFlushTimer = xTimerCreateStatic("LogFlush", pdMS_TO_TICKS(LOG_UART_DMA_FLUSH_TIMEOUT), pdFALSE, NULL, UartDmaFlushTimeout, &UartDmaFlushTimerBuffer);
+#else
+        UartDmaFlushTimer = xTimerCreate("LogFlush", pdMS_TO_TICKS(LOG_UART_DMA_FLUSH_TIMEOUT), pdFALSE, NULL, UartDmaFlushTimeout);
+#endif
+    }
+    if ((NULL == UartDmaLock) || (NULL == UartDmaTxDone) || (NULL == UartDmaFlushTimer))
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_OUT_OF_RESOURCES);
+    }
+    return RETCODE_OK;
+}
+
+static Retcode_T UartDmaAppenderInit(void *init)
+{
+    (void)init;
+    HWHandle_T uartHandle = NULL;
+    Retcode_T retcode = UartDmaAppenderCreateResources();
+    if (RETCODE_OK == retcode)
+    {
+        retcode = BSP_TestInterface_Connect();
+    }
+    if (RETCODE_OK == retcode)
+    {
+        uartHandle = BSP_TestInterface_GetUARTHandle();
+        retcode = MCU_UART_Initialize(uartHandle, UartDmaCallback);
+    }
+    if (RETCODE_OK == retcode)
+    {
+#if KISO_UTILS_STATIC_ALLOCATION && !KISO_UTILS_TASK_NOTIFICATIONS
+        retcode = UARTTransceiver_InitializeStatic(&UartDmaTransceiver, uartHandle, UartDmaRxBuffer, LOG_UART_DMA_RX_BUFFER_SIZE, UART_TRANSCEIVER_UART_TYPE_UART, &UartDmaTransceiverStorage);
+#else
+        retcode = UARTTransceiver_Initialize(&UartDmaTransceiver, uartHandle, UartDmaRxBuffer, LOG_UART_DMA_RX_BUFFER_SIZE, UART_TRANSCEIVER_UART_TYPE_UART);
+#endif
+    }
+    if (RETCODE_OK == retcode)
+    {
+        retcode = BSP_TestInterface_Enable();
+    }
+    if (RETCODE_OK == retcode)
+    {
+        retcode = UARTTransceiver_StartInAsyncMode(&UartDmaTransceiver, UartDmaCheckEndFrameFunc, UartDmaTransceiverCallback);
+    }
+    return retcode;
+}
+
+/* Starts the transfer of the buffer being filled and switches to the other one, the caller holds the lock */
+static Retcode_T UartDmaAppenderFlush(TickType_t timeout)
+{
+    Retcode_T retcode;
+    uint8_t *buffer;
+    uint32_t length;
+
+    if (0 == UartDmaFillLength)
+    {
+        return RETCODE_OK;
+    }
+    if (pdTRUE != xSemaphoreTake(UartDmaTxDone, timeout))
+    {
+        /* The other buffer is still in transfer */
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_TIMEOUT);
+    }
+
+    buffer = UartDmaBuffers[UartDmaFillIndex];
+    length = UartDmaFillLength;
+    UartDmaFillIndex ^= 1U;
+    UartDmaFillLength = 0;
+    UartDmaIsFlushPending = false;
+
+    retcode = UARTTransceiver_WriteData(&UartDmaTransceiver, buffer, length, 0);
+    if (RETCODE_OK != retcode)
+    {
+        /* No transfer complete event will follow, the lines of the batch are lost */
+        (void)xSemaphoreGive(UartDmaTxDone);
+    }
+    return retcode;
+}
+
+static Retcode_T UartDmaAppenderWrite(const char *message, uint32_t length)
+{
+    Retcode_T retcode = RETCODE_OK;
+
+    if (NULL == message)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+    }
+    if (pdTRUE != xSemaphoreTake(UartDmaLock, pdMS_TO_TICKS(LOG_APPENDER_TIMEOUT)))
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SEMAPHORE_ERROR);
+    }
+
+    while ((0 != length) && (RETCODE_OK == retcode))
+    {
+        uint32_t chunk = LOG_UART_DMA_BUFFER_SIZE - UartDmaFillLength;
+        chunk = (length < chunk) ? length : chunk;
+        memcpy(&UartDmaBuffers[UartDmaFillIndex][UartDmaFillLength], message, chunk);
+        UartDmaFillLength += chunk;
+        message += chunk;
+        length -= chunk;
+
+        if (LOG_UART_DMA_BUFFER_SIZE == UartDmaFillLength)
+        {
+            retcode = UartDmaAppenderFlush(pdMS_TO_TICKS(LOG_APPENDER_TIMEOUT));
+        }
+    }
+
+    /* The timer runs from the first line of a batch, so no line waits longer than the timeout */
+    if ((0 != UartDmaFillLength) && !UartDmaIsFlushPending)
+    {
+        UartDmaIsFlushPending = (pdPASS == xTimerStart(UartDmaFlushTimer, 0));
+    }
+
+    (void)xSemaphoreGive(UartDmaLock);
+    return retcode;
+}
+
+/* Runs in the timer task, which must not block */
+static void UartDmaFlushTimeout(TimerHandle_t timer)
+{
+    if (pdTRUE != xSemaphoreTake(UartDmaLock, 0))
+    {
+        /* A writer is busy, try again later */
+        (void)xTimerReset(timer, 0);
+        return;
+    }
+    if ((RETCODE_OK != UartDmaAppenderFlush(0)) && (0 != UartDmaFillLength))
+    {
+        (void)xTimerReset(timer, 0);
+    }
+    (void)xSemaphoreGive(UartDmaLock);
+}
+
+static void UartDmaTransceiverCallback(struct MCU_UART_Event_S event)
+{
+    if (event.TxComplete)
+    {
+        BaseType_t higherPriorityTaskWoken = pdFALSE;
+        if (pdTRUE == xSemaphoreGiveFromISR(UartDmaTxDone, &higherPriorityTaskWoken))
+        {
+            portYIELD_FROM_ISR(higherPriorityTaskWoken);
+        }
+    }
+}
+
+static void UartDmaCallback(UART_T uart, struct MCU_UART_Event_S event)
+{
+    (void)uart;
+    UARTTransceiver_LoopCallback(&UartDmaTransceiver, event);
+}
+
+static bool UartDmaCheckEndFrameFunc(uint8_t lastByte)
+{
+    (void)lastByte;
+    return false;
+}
+
+#endif
@@ -19,12 +19,26 @@
  *      intended to be used as transport for data between ISR and user code.
  *      Read and Write functions may handle data only partially, depending of fill-level
  *      of the buffer, so corresponding calls may need to be retried.
+ *      Data is moved in at most two contiguous segments (up to the end of the buffer space
+ *      and from its beginning) using memcpy instead of byte-wise copying.
+ *      With KISO_RINGBUFFER_POWER_OF_TWO enabled, index wrapping is done by masking.
+ *      One producer and one consumer (e.g. an ISR and a task) can access the buffer
+ *      concurrently without locking; the indices are exchanged with acquire/release ordering.
  *
  * @details
  *      This source file implements following features:
  *      - RingBuffer_Initialize()
  *      - RingBuffer_Write()
  *      - RingBuffer_Read()
+ *      - RingBuffer_Reserve()
+ *      - RingBuffer_Commit()
+ *      - RingBuffer_Peek()
+ *      - RingBuffer_Consume()
+ *      - RingBuffer_InitializeRecords()
+ *      - RingBuffer_WriteRecord()
+ *      - RingBuffer_ReadRecord()
+ *      - RingBuffer_PeekRecord()
+ *      - RingBuffer_ConsumeRecord()
  *      - RingBuffer_Reset()
   @note
  *      For optimization purposes, error handling is minimized and responsibility
@@ -50,44 +64,119 @@
 #include "Kiso_Basics.h"
 #include "Kiso_Assert.h"
 
-static KISO_INLINE void Add(RingBuffer_T *ringBuffer, uint8_t element)
+#ifndef KISO_RINGBUFFER_POWER_OF_TWO
+#define KISO_RINGBUFFER_POWER_OF_TWO 0
+#endif
+
+/*
+ * Memory ordering of the lock-free single-producer / single-consumer protocol:
+ * - The WriteIndex is only written by the producer, the ReadIndex only by the consumer.
+ * - Each side loads the index of the other side with acquire semantics, so the data (consumer)
+ *   or the free space (producer) announced by it is accessed only after the index was observed.
+ * - Each side stores its own index with release semantics, so all its accesses to the buffer
+ *   space are complete before the other side can observe the new index.
+ * Neither side therefore needs a critical section, as long as there is only one of each.
+ */
+#if defined(__GNUC__) && defined(__ARM_ARCH_PROFILE) && ('M' == __ARM_ARCH_PROFILE)
+#define RINGBUFFER_BARRIER_ACQUIRE() __asm volatile("dmb" ::: "memory")
+#define RINGBUFFER_BARRIER_RELEASE() __asm volatile("dmb" ::: "memory")
+#elif defined(__GNUC__)
+#define RINGBUFFER_BARRIER_ACQUIRE() __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#define RINGBUFFER_BARRIER_RELEASE() __atomic_thread_fence(__ATOMIC_RELEASE)
+#else
+#error "No memory barrier available for the lock-free RingBuffer on this toolchain"
+#endif
+
+static KISO_INLINE uint32_t LoadAcquire(const uint32_t *index)
 {
-    /* Load the writeIndex to avoid false intermediate values on the real write index */
-    register uint32_t index = ringBuffer->WriteIndex;
+    uint32_t value = *(const volatile uint32_t *)index;
+    RINGBUFFER_BARRIER_ACQUIRE();
+    return value;
+}
 
-    /* Write the element and increment the index */
-    ringBuffer->Base[index++] = element;
+static KISO_INLINE void StoreRelease(uint32_t *index, uint32_t value)
+{
+    RINGBUFFER_BARRIER_RELEASE();
+    *(volatile uint32_t *)index = value;
+}
 
-    /* Update the index */
-    ringBuffer->WriteIndex = (ringBuffer->Size != index) ? index : 0UL;
-    /* Now it is safe to read from the "old" index and write to the new index */
+/* Only used for the ReadIndex of record buffers with overwrite policy, which both sides may advance */
+static KISO_INLINE bool CompareAndSwap(uint32_t *index, uint32_t *expected, uint32_t desired)
+{
+    return __atomic_compare_exchange_n(index, expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
 }
 
-static KISO_INLINE uint8_t Get(RingBuffer_T *ringBuffer)
+static KISO_INLINE uint32_t WrapIndex(const RingBuffer_T *ringBuffer, uint32_t index)
 {
-    /* Use a copy of the ReadIndex to avoid false intermediate values on the real read index
-     * since it is also used in the write process (add) */
-    register uint32_t index = ringBuffer->ReadIndex;
+#if KISO_RINGBUFFER_POWER_OF_TWO
+    return index & (ringBuffer->Size - 1UL);
+#else
+    /* Indices never advance by more than Size, so a single subtraction is sufficient */
+    return (index < ringBuffer->Size) ? index : (index - ringBuffer->Size);
+#endif
+}
 
-    /* Read the data from the buffer and increment the index */
-    uint8_t element = ringBuffer->Base[index++];
+static KISO_INLINE uint32_t GetFillLevel(const RingBuffer_T *ringBuffer, uint32_t writeIndex, uint32_t readIndex)
+{
+#if KISO_RINGBUFFER_POWER_OF_TWO
+    return (writeIndex - readIndex) & (ringBuffer->Size - 1UL);
+#else
+    return (writeIndex >= readIndex) ? (writeIndex - readIndex) : (writeIndex + ringBuffer->Size - readIndex);
+#endif
+}
 
-    /* Update the index */
-    ringBuffer->ReadIndex = (ringBuffer->Size != index) ? index : 0UL;
-    /* Now it is safe to write to this index again */
-    return element;
+static KISO_INLINE uint32_t GetFreeSpace(const RingBuffer_T *ringBuffer, uint32_t writeIndex, uint32_t readIndex)
+{
+    /* One slot is always kept free to tell a full from an empty buffer */
+    return ringBuffer->Size - 1UL - GetFillLevel(ringBuffer, writeIndex, readIndex);
 }
 
-static KISO_INLINE bool RingBuffer_IsFull(RingBuffer_T *ringBuffer)
+static KISO_INLINE void GetRegions(const RingBuffer_T *ringBuffer, uint32_t index, uint32_t length, RingBuffer_Region_T *regions)
 {
-    /* Incrementing the WriteIndex would hit the ReadIndex => full */
-    return ((ringBuffer->WriteIndex + 1UL) % (ringBuffer->Size)) != ringBuffer->ReadIndex ? false : true;
+    /* Split the range up to the end of the buffer space and the remainder (if any) from its beginning */
+    uint32_t firstLength = ringBuffer->Size - index;
+
+    if (firstLength > length)
+    {
+        firstLength = length;
+    }
+    regions[0].Data = &ringBuffer->Base[index];
+    regions[0].Length = firstLength;
+    regions[1].Data = ringBuffer->Base;
+    regions[1].Length = length - firstLength;
 }
 
-static KISO_INLINE bool RingBuffer_IsEmpty(RingBuffer_T *ringBuffer)
+static KISO_INLINE void CopyIn(const RingBuffer_T *ringBuffer, uint32_t index, const uint8_t *data, uint32_t length)
 {
-    /* The ReadIndex equals the WriteIndex => empty */
-    return ringBuffer->ReadIndex == ringBuffer->WriteIndex ? true : false;
+    RingBuffer_Region_T regions[RINGBUFFER_REGION_COUNT];
+
+    GetRegions(ringBuffer, index, length, regions);
+    (void)memcpy(regions[0].Data, data, regions[0].Length);
+    (void)memcpy(regions[1].Data, &data[regions[0].Length], regions[1].Length);
+}
+
+static KISO_INLINE void CopyOut(const RingBuffer_T *ringBuffer, uint32_t index, uint8_t *data, uint32_t length)
+{
+    RingBuffer_Region_T regions[RINGBUFFER_REGION_COUNT];
+
+    GetRegions(ringBuffer, index, length, regions);
+    (void)memcpy(data, regions[0].Data, regions[0].Length);
+    (void)memcpy(&data[regions[0].Length], regions[1].Data, regions[1].Length);
+}
+
+static KISO_INLINE uint32_t GetRecordLength(const RingBuffer_T *ringBuffer, uint32_t index)
+{
+    /* The length prefix is stored little-endian and may wrap around the end of the buffer space */
+    uint8_t header[RINGBUFFER_RECORD_HEADER_SIZE];
+
+    CopyOut(ringBuffer, index, header, RINGBUFFER_RECORD_HEADER_SIZE);
+    return (uint32_t)header[0] | ((uint32_t)header[1] << 8);
+}
+
+static KISO_INLINE uint32_t GetReadIndex(const RingBuffer_T *ringBuffer)
+{
+    /* With overwrite policy the producer may advance the ReadIndex as well */
+    return ringBuffer->Overwrite ? LoadAcquire(&ringBuffer->ReadIndex) : ringBuffer->ReadIndex;
 }
 
 /*  The description of the function is available in Kiso_RingBuffer.h */
@@ -97,6 +186,13 @@ void RingBuffer_Initialize(RingBuffer_T *ringBuffer, uint8_t *bufferSpace, uint3
     {
         Retcode_RaiseError(RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_INVALID_PARAM));
     }
+#if KISO_RINGBUFFER_POWER_OF_TWO
+    else if (0UL != (size & (size - 1UL)))
+    {
+        /* Masking the indices requires the size to be a power of two */
+        Retcode_RaiseError(RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_INVALID_PARAM));
+    }
+#endif /* if KISO_RINGBUFFER_POWER_OF_TWO */
     else
     {
         /* Initialize the ring-buffer structure:buffer, index r/w, buffer size */
@@ -104,20 +200,25 @@ void RingBuffer_Initialize(RingBuffer_T *ringBuffer, uint8_t *bufferSpace, uint3
         ringBuffer->ReadIndex = 0;
         ringBuffer->WriteIndex = 0;
         ringBuffer->Size = size;
+        ringBuffer->Overwrite = false;
     }
 }
 
 /*  The description of the function is available in Kiso_RingBuffer.h */
 uint32_t RingBuffer_Write(RingBuffer_T *ringBuffer, uint8_t *data, uint32_t length)
 {
-    uint32_t actualLength = 0UL;
+    /* Take a copy of both indices. The consumer may only advance the ReadIndex concurrently, which
+     * can only make the buffer "more empty" - so the free space computed here is a safe lower bound */
+    uint32_t writeIndex = ringBuffer->WriteIndex;
+    uint32_t freeSpace = GetFreeSpace(ringBuffer, writeIndex, LoadAcquire(&ringBuffer->ReadIndex));
+    uint32_t actualLength = (length < freeSpace) ? length : freeSpace;
 
-    while (!RingBuffer_IsFull(ringBuffer) && length--)
+    if (actualLength > 0UL)
     {
-        /* Now it is safe to write to the buffer when it is not empty, since no one else is writing to it.
-         * It could only get even "more empty" since some read processes can have consumed (read) data from the buffer
-         */
-        Add(ringBuffer, data[actualLength++]);
+        CopyIn(ringBuffer, writeIndex, data, actualLength);
+
+        /* Publish the data only after it has been copied */
+        StoreRelease(&ringBuffer->WriteIndex, WrapIndex(ringBuffer, writeIndex + actualLength));
     }
     return actualLength;
 }
@@ -128,16 +229,205 @@ uint32_t RingBuffer_Read(RingBuffer_T *ringBuffer, uint8_t *data, uint32_t lengt
     uint32_t actualLength = 0UL;
     if ((NULL != ringBuffer) && (NULL != data))
     {
-        /* Read data while the buffer is not empty for the amount of requested data */
-        while (!RingBuffer_IsEmpty(ringBuffer) && length--)
+        /* Use a copy of the ReadIndex, since it is also used in the write process. The producer may only
+         * advance the WriteIndex concurrently, so the fill-level computed here is a safe lower bound */
+        uint32_t readIndex = ringBuffer->ReadIndex;
+        uint32_t fillLevel = GetFillLevel(ringBuffer, LoadAcquire(&ringBuffer->WriteIndex), readIndex);
+
+        actualLength = (length < fillLevel) ? length : fillLevel;
+        if (actualLength > 0UL)
         {
-            data[actualLength++] = Get(ringBuffer);
+            CopyOut(ringBuffer, readIndex, data, actualLength);
+
+            /* Release the space only after the data has been copied */
+            StoreRelease(&ringBuffer->ReadIndex, WrapIndex(ringBuffer, readIndex + actualLength));
         }
     }
     /* Report the number of bytes read */
     return actualLength;
 }
 
+/*  The description of the function is available in Kiso_RingBuffer.h */
+uint32_t RingBuffer_Reserve(RingBuffer_T *ringBuffer, RingBuffer_Region_T *regions)
+{
+    uint32_t writeIndex = ringBuffer->WriteIndex;
+    uint32_t freeSpace = GetFreeSpace(ringBuffer, writeIndex, LoadAcquire(&ringBuffer->ReadIndex));
+
+    GetRegions(ringBuffer, writeIndex, freeSpace, regions);
+    return freeSpace;
+}
+
+/*  The description of the function is available in Kiso_RingBuffer.h */
+uint32_t RingBuffer_Commit(RingBuffer_T *ringBuffer, uint32_t length)
+{
+    uint32_t writeIndex = ringBuffer->WriteIndex;
+    uint32_t freeSpace = GetFreeSpace(ringBuffer, writeIndex, LoadAcquire(&ringBuffer->ReadIndex));
+    uint32_t actualLength = (length < freeSpace) ? length : freeSpace;
+
+    /* The producer has already filled the reserved region, so just publish it */
+    StoreRelease(&ringBuffer->WriteIndex, WrapIndex(ringBuffer, writeIndex + actualLength));
+    return actualLength;
+}
+
+/*  The description of the function is available in Kiso_RingBuffer.h */
+uint32_t RingBuffer_Peek(RingBuffer_T *ringBuffer, RingBuffer_Region_T *regions)
+{
+    uint32_t readIndex = ringBuffer->ReadIndex;
+    uint32_t fillLevel = GetFillLevel(ringBuffer, LoadAcquire(&ringBuffer->WriteIndex), readIndex);
+
+    GetRegions(ringBuffer, readIndex, fillLevel, regions);
+    return fillLevel;
+}
+
+/*  The description of the function is available in Kiso_RingBuffer.h */
+uint32_t RingBuffer_Consume(RingBuffer_T *ringBuffer, uint32_t length)
+{
+    uint32_t readIndex = ringBuffer->ReadIndex;
+    uint32_t fillLevel = GetFillLevel(ringBuffer, LoadAcquire(&ringBuffer->WriteIndex), readIndex);
+    uint32_t actualLength = (length < fillLevel) ? length : fillLevel;
+
+    /* The consumer is done with the peeked region, so release it to the producer */
+    StoreRelease(&ringBuffer->ReadIndex, WrapIndex(ringBuffer, readIndex + actualLength));
+    return actualLength;
+}
+
+/*  The description of the function is available in Kiso_RingBuffer.h */
+void RingBuffer_InitializeRecords(RingBuffer_T *ringBuffer, uint8_t *bufferSpace, uint32_t size, bool overwrite)
+{
+    if (size <= (RINGBUFFER_RECORD_HEADER_SIZE + 1UL))
+    {
+        /* There has to be space for at least one record of one byte */
+        Retcode_RaiseError(RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_INVALID_PARAM));
+    }
+    else
+    {
+        RingBuffer_Initialize(ringBuffer, bufferSpace, size);
+        if (NULL != ringBuffer)
+        {
+            ringBuffer->Overwrite = overwrite;
+        }
+    }
+}
+
+/*  The description of the function is available in Kiso_RingBuffer.h */
+bool RingBuffer_WriteRecord(RingBuffer_T *ringBuffer, const uint8_t *data, uint32_t length)
+{
+    uint8_t header[RINGBUFFER_RECORD_HEADER_SIZE] = {(uint8_t)length, (uint8_t)(length >> 8)};
+    uint32_t writeIndex = ringBuffer->WriteIndex;
+    uint32_t readIndex = LoadAcquire(&ringBuffer->ReadIndex);
+    uint32_t recordSize = RINGBUFFER_RECORD_HEADER_SIZE + length;
+    bool isWritable = (0UL != length) && (length <= RINGBUFFER_RECORD_MAX_LENGTH) && (recordSize < ringBuffer->Size);
+
+    while (isWritable && (recordSize > GetFreeSpace(ringBuffer, writeIndex, readIndex)))
+    {
+        if (ringBuffer->Overwrite)
+        {
+            /* Drop the oldest record. If the consumer has released it in the meantime, the exchange
+             * fails and readIndex is updated to the current value, so just check the space again */
+            (void)CompareAndSwap(&ringBuffer->ReadIndex, &readIndex,
+                                 WrapIndex(ringBuffer, readIndex + RINGBUFFER_RECORD_HEADER_SIZE + GetRecordLength(ringBuffer, readIndex)));
+        }
+        else
+        {
+            isWritable = false;
+        }
+    }
+
+    if (isWritable)
+    {
+        CopyIn(ringBuffer, writeIndex, header, RINGBUFFER_RECORD_HEADER_SIZE);
+        CopyIn(ringBuffer, WrapIndex(ringBuffer, writeIndex + RINGBUFFER_RECORD_HEADER_SIZE), data, length);
+
+        /* Publish the complete record at once */
+        StoreRelease(&ringBuffer->WriteIndex, WrapIndex(ringBuffer, writeIndex + recordSize));
+    }
+    return isWritable;
+}
+
+/*  The description of the function is available in Kiso_RingBuffer.h */
+uint32_t RingBuffer_ReadRecord(RingBuffer_T *ringBuffer, uint8_t *data, uint32_t size)
+{
+    uint32_t recordLength = 0UL;
+    bool isDone = false;
+
+    while (!isDone)
+    {
+        uint32_t readIndex = GetReadIndex(ringBuffer);
+        uint32_t fillLevel = GetFillLevel(ringBuffer, LoadAcquire(&ringBuffer->WriteIndex), readIndex);
+
+        recordLength = (0UL != fillLevel) ? GetRecordLength(ringBuffer, readIndex) : 0UL;
+        if ((0UL == fillLevel) || ((RINGBUFFER_RECORD_HEADER_SIZE + recordLength) > fillLevel))
+        {
+            /* Either empty, or the producer has just overwritten the record we were looking at */
+            recordLength = 0UL;
+            isDone = !ringBuffer->Overwrite || (0UL == fillLevel);
+        }
+        else
+        {
+            uint32_t nextIndex = WrapIndex(ringBuffer, readIndex + RINGBUFFER_RECORD_HEADER_SIZE + recordLength);
+
+            CopyOut(ringBuffer, WrapIndex(ringBuffer, readIndex + RINGBUFFER_RECORD_HEADER_SIZE), data, (recordLength < size) ? recordLength : size);
+            if (ringBuffer->Overwrite)
+            {
+                /* If the producer has dropped the record while we copied it, the copy may be torn - retry */
+                isDone = CompareAndSwap(&ringBuffer->ReadIndex, &readIndex, nextIndex);
+            }
+            else
+            {
+                StoreRelease(&ringBuffer->ReadIndex, nextIndex);
+                isDone = true;
+            }
+        }
+    }
+    return recordLength;
+}
+
+/*  The description of the function is available in Kiso_RingBuffer.h */
+uint32_t RingBuffer_PeekRecord(RingBuffer_T *ringBuffer, RingBuffer_Region_T *regions)
+{
+    uint32_t readIndex = GetReadIndex(ringBuffer);
+    uint32_t fillLevel = GetFillLevel(ringBuffer, LoadAcquire(&ringBuffer->WriteIndex), readIndex);
+    uint32_t recordLength = (0UL != fillLevel) ? GetRecordLength(ringBuffer, readIndex) : 0UL;
+
+    if ((RINGBUFFER_RECORD_HEADER_SIZE + recordLength) > fillLevel)
+    {
+        recordLength = 0UL;
+    }
+    GetRegions(ringBuffer, WrapIndex(ringBuffer, readIndex + RINGBUFFER_RECORD_HEADER_SIZE), recordLength, regions);
+    return recordLength;
+}
+
+/*  The description of the function is available in Kiso_RingBuffer.h */
+uint32_t RingBuffer_ConsumeRecord(RingBuffer_T *ringBuffer)
+{
+    uint32_t recordLength = 0UL;
+    bool isDone = false;
+
+    while (!isDone)
+    {
+        uint32_t readIndex = GetReadIndex(ringBuffer);
+        uint32_t fillLevel = GetFillLevel(ringBuffer, LoadAcquire(&ringBuffer->WriteIndex), readIndex);
+
+        recordLength = (0UL != fillLevel) ? GetRecordLength(ringBuffer, readIndex) : 0UL;
+        if ((0UL == fillLevel) || ((RINGBUFFER_RECORD_HEADER_SIZE + recordLength) > fillLevel))
+        {
+            recordLength = 0UL;
+            isDone = !ringBuffer->Overwrite || (0UL == fillLevel);
+        }
+        else if (ringBuffer->Overwrite)
+        {
+            isDone = CompareAndSwap(&ringBuffer->ReadIndex, &readIndex,
+                                    WrapIndex(ringBuffer, readIndex + RINGBUFFER_RECORD_HEADER_SIZE + recordLength));
+        }
+        else
+        {
+            StoreRelease(&ringBuffer->ReadIndex, WrapIndex(ringBuffer, readIndex + RINGBUFFER_RECORD_HEADER_SIZE + recordLength));
+            isDone = true;
+        }
+    }
+    return recordLength;
+}
+
 /*  The description of the function is available in Kiso_RingBuffer.h */
 void RingBuffer_Reset(RingBuffer_T *ringBuffer)
 {
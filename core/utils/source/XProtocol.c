@@ -20,11 +20,22 @@
  * @details
  *      This source file implements following features:
  *      - XProtocol_Init()
+ *      - XProtocol_GetMaxEncodedLength()
  *      - XProtocol_EncodeFrame()
+ *      - XProtocol_EncodeFrameSegments()
  *      - XProtocol_GetPayloadLength()
  *      - XProtocol_DecodeFrame()
  *      - XProtocol_IsCompleteFrame()
- * 
+ *      - XProtocol_DecoderInitialize()
+ *      - XProtocol_DecoderReset()
+ *      - XProtocol_DecoderPush()
+ *      - XProtocol_DecoderReserve()
+ *      - XProtocol_DecoderCommit()
+ *
+ *      The framing is either SD/ED with escaping or, if KISO_XPROTOCOL_COBS is enabled, Consistent
+ *      Overhead Byte Stuffing. Only Encode_Frame(), Count_Payload(), Decode_Frame(),
+ *      Decoder_StoreByte() and Decoder_Process() depend on it.
+ *
  * @file
  **/
 
@@ -42,6 +53,10 @@
 #include "Kiso_Retcode.h"
 #include "Kiso_CRC.h"
 
+#ifndef KISO_XPROTOCOL_COBS
+#define KISO_XPROTOCOL_COBS 0
+#endif
+
 #define XPROTOCOL_CRC_CCITT_POLY 0x1021U /**< Polynom for function crc16 */
 #define XPROTOCOL_SD 0xC0                /**< Start delimitter */
 #define XPROTOCOL_ED 0xC9                /**< End delimitter */
@@ -50,178 +65,605 @@
 #define XPROTOCOL_ESCAPED_ED 0xDE        /**< Escaped ED */
 #define XPROTOCOL_ESCAPED_ESC 0xDD       /**< Escaped ESC */
 
-static Retcode_T Escape_SpecialCharacters(uint8_t *frame, uint32_t *indicator, uint32_t maxFrameLength)
+#define XPROTOCOL_SPECIAL_MASK 0xE0    /**< Bits shared by SD, ED and ESC */
+#define XPROTOCOL_SPECIAL_PATTERN 0xC0 /**< Value of the shared bits of SD, ED and ESC */
+
+#define XPROTOCOL_COBS_DELIMITER 0x00 /**< End delimiter of COBS frames */
+#define XPROTOCOL_COBS_MAX_CODE 0xFF  /**< Code of a full block of 254 bytes, which is not followed by 0x00 */
+
+#if KISO_XPROTOCOL_COBS
+#define XPROTOCOL_END_OF_FRAME XPROTOCOL_COBS_DELIMITER /**< Last byte of every frame */
+#else
+#define XPROTOCOL_END_OF_FRAME XPROTOCOL_ED /**< Last byte of every frame */
+#endif
+
+#define XPROTOCOL_CHECKSUM_LENGTH UINT32_C(2)         /**< Unescaped length of the checksum */
+#define XPROTOCOL_MIN_FRAME_LENGTH UINT32_C(4)         /**< SD, unescaped checksum and ED, or COBS code, checksum and ED */
+#define XPROTOCOL_CRC_MAX_CHUNK_LENGTH UINT32_C(0xFFFF) /**< Maximum number of bytes CRC_16 accepts per call */
+
+/* States of the streaming decoder */
+enum XProtocol_DecoderState_E
 {
-    if (XPROTOCOL_SD == frame[*indicator])
+    XPROTOCOL_DECODER_IDLE = 0, /**< Waiting for a frame to start */
+    XPROTOCOL_DECODER_FRAME,    /**< Inside a frame */
+    XPROTOCOL_DECODER_ESCAPE,   /**< Inside a frame, previous byte was ESC */
+    XPROTOCOL_DECODER_DISCARD,  /**< Dropping a broken frame up to its end delimiter */
+};
+
+/* Continues the payload's checksum based on CRC-CCITT (XModem) over any number of bytes */
+static void Update_Checksum(uint16_t *checksum, const uint8_t *data, uint32_t dataLength)
+{
+    while (UINT32_C(0) < dataLength)
+    {
+        uint32_t chunkLength = (XPROTOCOL_CRC_MAX_CHUNK_LENGTH < dataLength) ? XPROTOCOL_CRC_MAX_CHUNK_LENGTH : dataLength;
+
+        /* Ignoring the Retcode_T returning value. We know that it's always returning
+         * RETCODE_OK because the callers check for NULL pointers themselves. */
+        (void)CRC_16(XPROTOCOL_CRC_CCITT_POLY, checksum, data, (uint16_t)chunkLength);
+        data += chunkLength;
+        dataLength -= chunkLength;
+    }
+}
+
+/* Drops the current frame and remembers why */
+static void Decoder_DropFrame(XProtocol_Decoder_T *decoder, uint8_t nextState, Retcode_T reason, Retcode_T *retcode)
+{
+    decoder->State = nextState;
+    *retcode = RETCODE(RETCODE_SEVERITY_ERROR, reason);
+}
+
+static void Decoder_StartFrame(XProtocol_Decoder_T *decoder)
+{
+    decoder->State = XPROTOCOL_DECODER_FRAME;
+    decoder->PayloadLength = UINT32_C(0);
+    decoder->CrcLength = UINT32_C(0);
+    decoder->ChecksumLength = UINT8_C(0);
+    decoder->ReceivedChecksum = UINT16_C(0);
+    decoder->Checksum = UINT16_C(0);
+    decoder->BlockRemaining = UINT8_C(0);
+    decoder->ZeroPending = false;
+}
+
+/* Feeds the bytes stored since the last call to the checksum, while they are still in the cache */
+static void Decoder_UpdateChecksum(XProtocol_Decoder_T *decoder)
+{
+    Update_Checksum(&decoder->Checksum, &decoder->Buffer[decoder->CrcLength], decoder->PayloadLength - decoder->CrcLength);
+    decoder->CrcLength = decoder->PayloadLength;
+}
+
+static void Decoder_EndFrame(XProtocol_Decoder_T *decoder, Retcode_T *retcode)
+{
+    decoder->State = XPROTOCOL_DECODER_IDLE;
+    if (XPROTOCOL_CHECKSUM_LENGTH > decoder->ChecksumLength)
+    {
+        *retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_INTEGRITY_FAILED);
+    }
+    else
     {
-        frame[*indicator] = XPROTOCOL_ESC;
-        (*indicator)++;
-        if (maxFrameLength <= *indicator)
+        Decoder_UpdateChecksum(decoder);
+        if (decoder->Checksum != decoder->ReceivedChecksum)
         {
-            return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_FRAME_BUFFER_TOO_SMALL);
+            *retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_INTEGRITY_FAILED);
+        }
+        else if (NULL != decoder->Callback)
+        {
+            decoder->Callback(decoder->Buffer, decoder->PayloadLength, decoder->CallbackParam);
         }
-        frame[*indicator] = XPROTOCOL_ESCAPED_SD;
     }
-    else if (XPROTOCOL_ED == frame[*indicator])
+}
+
+#if KISO_XPROTOCOL_COBS
+
+/* Position of the code byte of the block being written and the code it will get */
+struct Cobs_Block_S
+{
+    uint32_t CodeIndex;
+    uint8_t Code;
+};
+
+/* Writes the code of the current block and opens the next one behind it */
+static Retcode_T Cobs_CloseBlock(struct Cobs_Block_S *block, uint8_t *frame, uint32_t *indicator, uint32_t maxFrameLength)
+{
+    /* One byte of the frame buffer is kept for the end delimiter */
+    if (*indicator >= (maxFrameLength - UINT32_C(1)))
     {
-        frame[*indicator] = XPROTOCOL_ESC;
-        (*indicator)++;
-        if (maxFrameLength <= *indicator)
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_FRAME_BUFFER_TOO_SMALL);
+    }
+    frame[block->CodeIndex] = block->Code;
+    block->CodeIndex = (*indicator)++;
+    block->Code = UINT8_C(1);
+
+    return RETCODE_OK;
+}
+
+/*
+ * Stuffs data into the frame. If checksum is not NULL, it is calculated in the same pass: runs of
+ * non-zero bytes are fed to the CRC and copied to the frame in one go.
+ */
+static Retcode_T Cobs_EncodeBytes(const uint8_t *data, uint32_t dataLength, uint16_t *checksum,
+                                  struct Cobs_Block_S *block, uint8_t *frame, uint32_t *indicator, uint32_t maxFrameLength)
+{
+    const uint8_t *end = data + dataLength;
+    Retcode_T retcode = RETCODE_OK;
+
+    while ((data < end) && (RETCODE_OK == retcode))
+    {
+        const uint8_t *run = data;
+        uint32_t runLength;
+        uint32_t room = (uint32_t)(XPROTOCOL_COBS_MAX_CODE - block->Code);
+        const uint8_t *runEnd = ((uint32_t)(end - data) > room) ? (data + room) : end;
+        bool isZero;
+
+        while ((data < runEnd) && (XPROTOCOL_COBS_DELIMITER != *data))
+        {
+            data++;
+        }
+        runLength = (uint32_t)(data - run);
+        isZero = (data < runEnd);
+
+        if (NULL != checksum)
+        {
+            /* Include the 0x00 ending the run, if any, in the same CRC call */
+            Update_Checksum(checksum, run, isZero ? (runLength + UINT32_C(1)) : runLength);
+        }
+
+        if (runLength > (maxFrameLength - UINT32_C(1) - *indicator))
         {
             return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_FRAME_BUFFER_TOO_SMALL);
         }
-        frame[*indicator] = XPROTOCOL_ESCAPED_ED;
+        (void)memcpy(&frame[*indicator], run, runLength);
+        *indicator += runLength;
+        block->Code = (uint8_t)(block->Code + runLength);
+
+        if (isZero)
+        {
+            /* The 0x00 is replaced by the code of the next block */
+            data++;
+            retcode = Cobs_CloseBlock(block, frame, indicator, maxFrameLength);
+        }
+        else if ((XPROTOCOL_COBS_MAX_CODE == block->Code) && (data < end))
+        {
+            retcode = Cobs_CloseBlock(block, frame, indicator, maxFrameLength);
+        }
+    }
+    return retcode;
+}
+
+static Retcode_T Encode_Frame(const XProtocol_Segment_T *segments, uint32_t segmentCount,
+                              uint32_t maxFrameLength, uint8_t *frame, uint32_t *frameLength)
+{
+    struct Cobs_Block_S block = {UINT32_C(0), UINT8_C(1)};
+    uint32_t indicator = UINT32_C(1);
+    uint16_t checksum = UINT16_C(0x0000);
+    uint8_t checksumBytes[XPROTOCOL_CHECKSUM_LENGTH];
+    Retcode_T retcode = RETCODE_OK;
+
+    /* Stuff the payload and calculate its checksum in a single pass */
+    for (uint32_t x = UINT32_C(0); (x < segmentCount) && (RETCODE_OK == retcode); x++)
+    {
+        retcode = Cobs_EncodeBytes(segments[x].Data, segments[x].Length, &checksum, &block, frame, &indicator, maxFrameLength);
     }
-    else if (XPROTOCOL_ESC == frame[*indicator])
+
+    /* The checksum follows the payload, so it can be appended without going back (Network Byte Order) */
+    checksumBytes[0] = (uint8_t)(checksum >> 8);
+    checksumBytes[1] = (uint8_t)(checksum & 0xFF);
+    if (RETCODE_OK == retcode)
     {
-        frame[*indicator] = XPROTOCOL_ESC;
-        (*indicator)++;
-        if (maxFrameLength <= *indicator)
+        /* A full last block of the payload is closed here, as more bytes follow */
+        if (XPROTOCOL_COBS_MAX_CODE == block.Code)
         {
-            return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_FRAME_BUFFER_TOO_SMALL);
+            retcode = Cobs_CloseBlock(&block, frame, &indicator, maxFrameLength);
         }
-        frame[*indicator] = XPROTOCOL_ESCAPED_ESC;
     }
-    (*indicator)++;
+    if (RETCODE_OK == retcode)
+    {
+        retcode = Cobs_EncodeBytes(checksumBytes, XPROTOCOL_CHECKSUM_LENGTH, NULL, &block, frame, &indicator, maxFrameLength);
+    }
+    if (RETCODE_OK != retcode)
+    {
+        return retcode;
+    }
+
+    frame[block.CodeIndex] = block.Code;
+    frame[indicator] = XPROTOCOL_COBS_DELIMITER;
+    *frameLength = indicator + 1;
+
     return RETCODE_OK;
 }
 
-static void UnEscape_SpecialCharacters(const uint8_t *frame, uint32_t indicator,
-                                       uint8_t *data, uint32_t counter)
+/* Counts the bytes of checksum and payload by following the chain of code bytes */
+static Retcode_T Count_Payload(const uint8_t *frame, uint32_t frameLength, uint32_t *payloadLength)
 {
-    if (XPROTOCOL_ESC == frame[indicator])
+    uint32_t counter = UINT32_C(0);
+    uint32_t x = UINT32_C(0);
+
+    while ((x < frameLength) && (XPROTOCOL_COBS_DELIMITER != frame[x]))
     {
-        /* Check the byte after escape letter */
-        if (XPROTOCOL_ESCAPED_SD == frame[indicator + 1])
-        {
-            data[counter] = XPROTOCOL_SD;
-        }
-        else if (XPROTOCOL_ESCAPED_ED == frame[indicator + 1])
+        uint8_t code = frame[x];
+
+        counter += (uint32_t)code - UINT32_C(1);
+        x += code;
+        if (x > frameLength)
         {
-            data[counter] = XPROTOCOL_ED;
+            return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_INTEGRITY_FAILED);
         }
-        else if (XPROTOCOL_ESCAPED_ESC == frame[indicator + 1])
+        /* Every block but a full or the last one stands for a 0x00 */
+        if ((XPROTOCOL_COBS_MAX_CODE != code) && (x < frameLength) && (XPROTOCOL_COBS_DELIMITER != frame[x]))
         {
-            data[counter] = XPROTOCOL_ESC;
+            counter++;
         }
     }
+
+    if (XPROTOCOL_CHECKSUM_LENGTH < counter)
+    {
+        *payloadLength = counter - XPROTOCOL_CHECKSUM_LENGTH;
+    }
     else
     {
-        data[counter] = frame[indicator];
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_INTEGRITY_FAILED);
     }
+
+    return RETCODE_OK;
 }
 
-/*  The description of the function is available in Kiso_XProtocol.h */
-Retcode_T XProtocol_Init(void)
+/*
+ * Stores one unstuffed byte. The checksum trails the payload, so the last two bytes received are
+ * held back in ReceivedChecksum until further bytes show that they belong to the payload.
+ */
+static void Decoder_StoreByte(XProtocol_Decoder_T *decoder, uint8_t byte, Retcode_T *retcode)
 {
-    return RETCODE_OK;
+    if (XPROTOCOL_CHECKSUM_LENGTH > decoder->ChecksumLength)
+    {
+        decoder->ReceivedChecksum = (uint16_t)((decoder->ReceivedChecksum << 8) | byte);
+        decoder->ChecksumLength++;
+    }
+    else if (decoder->BufferSize > decoder->PayloadLength)
+    {
+        decoder->Buffer[decoder->PayloadLength++] = (uint8_t)(decoder->ReceivedChecksum >> 8);
+        decoder->ReceivedChecksum = (uint16_t)((decoder->ReceivedChecksum << 8) | byte);
+    }
+    else
+    {
+        Decoder_DropFrame(decoder, XPROTOCOL_DECODER_DISCARD, RETCODE_XPROTOCOL_DATA_BUFFER_TOO_SMALL, retcode);
+    }
 }
 
-/*  The description of the function is available in Kiso_XProtocol.h */
-Retcode_T XProtocol_EncodeFrame(const uint8_t *data, uint32_t dataLength,
-                                uint32_t maxFrameLength, uint8_t *frame, uint32_t *frameLength)
+/* Stores a run of unstuffed bytes, moving all but the two held back bytes in one go */
+static void Decoder_StoreRun(XProtocol_Decoder_T *decoder, const uint8_t *run, uint32_t runLength, Retcode_T *retcode)
 {
-    uint32_t indicator = UINT32_C(0);
-    uint16_t checksum = UINT16_C(0x0000);
-    Retcode_T retcode = RETCODE_OK;
+    uint16_t held;
 
-    if (NULL == data || NULL == frame || NULL == frameLength)
+    while ((XPROTOCOL_CHECKSUM_LENGTH > decoder->ChecksumLength) && (UINT32_C(0) < runLength))
     {
-        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+        Decoder_StoreByte(decoder, *run++, retcode);
+        runLength--;
+    }
+    if (UINT32_C(0) == runLength)
+    {
+        return;
+    }
+    if (runLength > (decoder->BufferSize - decoder->PayloadLength))
+    {
+        Decoder_DropFrame(decoder, XPROTOCOL_DECODER_DISCARD, RETCODE_XPROTOCOL_DATA_BUFFER_TOO_SMALL, retcode);
+        return;
     }
 
-    /* Calculate payload's checksum based on CRC-CCITT (XModem)
-     * ignoring the Retcode_T returning value. We know that it's
-     * always returning RETCODE_OK because we check for NULL pointers
-     * ourselves.
-     */
-    (void)CRC_16(XPROTOCOL_CRC_CCITT_POLY, &checksum, data, (uint16_t)dataLength);
-
-    /* Create encoded frame byte per byte */
-    /* Set start delimiter */
-    if (maxFrameLength > indicator)
+    /* The run may lie inside the buffer right at the payload end, so it is read before it is overwritten */
+    held = decoder->ReceivedChecksum;
+    if (UINT32_C(1) == runLength)
     {
-        frame[indicator] = XPROTOCOL_SD;
-        indicator++;
+        decoder->ReceivedChecksum = (uint16_t)((held << 8) | run[0]);
+        decoder->Buffer[decoder->PayloadLength] = (uint8_t)(held >> 8);
     }
     else
     {
-        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_FRAME_BUFFER_TOO_SMALL);
+        decoder->ReceivedChecksum = (uint16_t)(((uint16_t)run[runLength - 2] << 8) | run[runLength - 1]);
+        (void)memmove(&decoder->Buffer[decoder->PayloadLength + XPROTOCOL_CHECKSUM_LENGTH], run, runLength - XPROTOCOL_CHECKSUM_LENGTH);
+        decoder->Buffer[decoder->PayloadLength] = (uint8_t)(held >> 8);
+        decoder->Buffer[decoder->PayloadLength + 1] = (uint8_t)(held & 0xFF);
     }
+    decoder->PayloadLength += runLength;
+}
 
-    /* Set 1st byte of checksum (Network Byte Order) */
-    if (maxFrameLength > indicator)
+/* Handles a code byte: emits the 0x00 replaced by the previous block and starts the next one */
+static void Decoder_StartBlock(XProtocol_Decoder_T *decoder, uint8_t code, Retcode_T *retcode)
+{
+    if (decoder->ZeroPending)
     {
-        frame[indicator] = (uint8_t)(checksum >> 8);
+        Decoder_StoreByte(decoder, XPROTOCOL_COBS_DELIMITER, retcode);
     }
-    else
+    decoder->BlockRemaining = (uint8_t)(code - 1);
+    decoder->ZeroPending = (XPROTOCOL_COBS_MAX_CODE != code);
+}
+
+/*
+ * Decodes a chunk of received bytes. The chunk may lie inside the decoder buffer, as long as it
+ * starts at or behind the current payload end: unstuffing never makes the payload grow faster than
+ * the input is consumed, so runs are moved with memmove.
+ */
+static Retcode_T Decoder_Process(XProtocol_Decoder_T *decoder, const uint8_t *data, uint32_t length)
+{
+    const uint8_t *end = data + length;
+    Retcode_T retcode = RETCODE_OK;
+
+    while (data < end)
     {
-        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_FRAME_BUFFER_TOO_SMALL);
+        uint8_t byte;
+
+        switch (decoder->State)
+        {
+        case XPROTOCOL_DECODER_FRAME:
+            if (UINT8_C(0) < decoder->BlockRemaining)
+            {
+                /* Move the bytes of the block received so far in one go */
+                const uint8_t *run = data;
+                uint32_t runLength;
+                const uint8_t *runEnd = ((uint32_t)(end - data) > decoder->BlockRemaining) ? (data + decoder->BlockRemaining) : end;
+                while ((data < runEnd) && (XPROTOCOL_COBS_DELIMITER != *data))
+                {
+                    data++;
+                }
+                runLength = (uint32_t)(data - run);
+                decoder->BlockRemaining = (uint8_t)(decoder->BlockRemaining - runLength);
+                Decoder_StoreRun(decoder, run, runLength, &retcode);
+                if ((data == end) || (XPROTOCOL_DECODER_FRAME != decoder->State))
+                {
+                    break;
+                }
+            }
+            byte = *data++;
+            if (XPROTOCOL_COBS_DELIMITER == byte)
+            {
+                if (UINT8_C(0) < decoder->BlockRemaining)
+                {
+                    /* Frame was cut off inside a block */
+                    Decoder_DropFrame(decoder, XPROTOCOL_DECODER_IDLE, RETCODE_XPROTOCOL_INTEGRITY_FAILED, &retcode);
+                }
+                else
+                {
+                    Decoder_EndFrame(decoder, &retcode);
+                }
+            }
+            else
+            {
+                Decoder_StartBlock(decoder, byte, &retcode);
+            }
+            break;
+
+        case XPROTOCOL_DECODER_DISCARD:
+            byte = *data++;
+            if (XPROTOCOL_COBS_DELIMITER == byte)
+            {
+                decoder->State = XPROTOCOL_DECODER_IDLE;
+            }
+            break;
+
+        case XPROTOCOL_DECODER_IDLE:
+        default:
+            /* Every byte but a delimiter starts a frame, empty frames are ignored */
+            byte = *data++;
+            if (XPROTOCOL_COBS_DELIMITER != byte)
+            {
+                Decoder_StartFrame(decoder);
+                Decoder_StartBlock(decoder, byte, &retcode);
+            }
+            break;
+        }
     }
 
-    /* Escape special character of 1st byte of checksum if exists */
-    retcode = Escape_SpecialCharacters(frame, &indicator, maxFrameLength);
-    if (RETCODE_OK != retcode)
+    if (XPROTOCOL_DECODER_FRAME == decoder->State)
     {
-        return retcode;
+        Decoder_UpdateChecksum(decoder);
+    }
+    return retcode;
+}
+
+static void Decode_FrameCallback(const uint8_t *payload, uint32_t payloadLength, void *callbackParam)
+{
+    KISO_UNUSED(payload);
+    *(uint32_t *)callbackParam = payloadLength;
+}
+
+/* Decodes the frame in one chunk with a decoder writing directly to data */
+static Retcode_T Decode_Frame(const uint8_t *frame, uint32_t frameLength,
+                              uint32_t maxDataLength, uint8_t *data, uint32_t *dataLength)
+{
+    XProtocol_Decoder_T decoder;
+    uint32_t payloadLength = UINT32_MAX;
+    Retcode_T retcode;
+
+    /* Check for missing end delimiter */
+    if (XPROTOCOL_COBS_DELIMITER != frame[frameLength - 1])
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_END_DELIMITER_MISSING);
+    }
+
+    /* A delimiter inside the frame would make it two frames */
+    if (NULL != memchr(frame, XPROTOCOL_COBS_DELIMITER, frameLength - UINT32_C(1)))
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_INTEGRITY_FAILED);
     }
 
-    /* Set 2nd byte of checksum (Network Byte Order) */
-    if (maxFrameLength > indicator)
+    retcode = XProtocol_DecoderInitialize(&decoder, data, maxDataLength, Decode_FrameCallback, &payloadLength);
+    if (RETCODE_OK == retcode)
+    {
+        retcode = Decoder_Process(&decoder, frame, frameLength);
+    }
+    if ((RETCODE_OK == retcode) && (UINT32_MAX == payloadLength))
+    {
+        /* Nothing but the delimiter */
+        retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_INTEGRITY_FAILED);
+    }
+    if (RETCODE_OK == retcode)
     {
-        frame[indicator] = (uint8_t)(checksum & 0xFF);
+        *dataLength = payloadLength;
+    }
+    return retcode;
+}
+
+#else /* if KISO_XPROTOCOL_COBS */
+
+/* Only bytes of the form 110xxxxx can be special, so most bytes are rejected by a single comparison */
+static KISO_INLINE bool IsSpecialCharacter(uint8_t byte)
+{
+    return (XPROTOCOL_SPECIAL_PATTERN == (byte & XPROTOCOL_SPECIAL_MASK)) &&
+           ((XPROTOCOL_SD == byte) || (XPROTOCOL_ED == byte) || (XPROTOCOL_ESC == byte));
+}
+
+static uint8_t Escape_SpecialCharacter(uint8_t byte)
+{
+    uint8_t escaped;
+
+    if (XPROTOCOL_SD == byte)
+    {
+        escaped = XPROTOCOL_ESCAPED_SD;
+    }
+    else if (XPROTOCOL_ED == byte)
+    {
+        escaped = XPROTOCOL_ESCAPED_ED;
     }
     else
     {
-        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_FRAME_BUFFER_TOO_SMALL);
+        escaped = XPROTOCOL_ESCAPED_ESC;
     }
+    return escaped;
+}
 
-    /* Escape special character of 2nd byte of checksum if exists */
-    retcode = Escape_SpecialCharacters(frame, &indicator, maxFrameLength);
-    if (RETCODE_OK != retcode)
+/* Writes a byte to the frame, escaped if necessary, and returns the number of bytes written */
+static uint32_t Escape_Byte(uint8_t byte, uint8_t *frame)
+{
+    uint32_t length = UINT32_C(1);
+
+    if (IsSpecialCharacter(byte))
     {
-        return retcode;
+        frame[0] = XPROTOCOL_ESC;
+        frame[1] = Escape_SpecialCharacter(byte);
+        length = UINT32_C(2);
     }
+    else
+    {
+        frame[0] = byte;
+    }
+    return length;
+}
+
+/*
+ * Escapes one data segment into the frame, starting at *indicator and leaving room for the end
+ * delimiter. The checksum is calculated in the same pass: runs of bytes without special characters
+ * are fed to the CRC and copied to the frame in one go.
+ */
+static Retcode_T Encode_Segment(const uint8_t *data, uint32_t dataLength, uint16_t *checksum,
+                                uint8_t *frame, uint32_t *indicator, uint32_t maxFrameLength)
+{
+    const uint8_t *end = data + dataLength;
 
-    for (uint32_t x = UINT32_C(0); x < dataLength; x++)
+    while (data < end)
     {
-        if (maxFrameLength > indicator)
+        const uint8_t *run = data;
+        uint32_t runLength;
+
+        while ((data < end) && !IsSpecialCharacter(*data))
         {
-            frame[indicator] = data[x];
+            data++;
         }
-        else
+        runLength = (uint32_t)(data - run);
+
+        /* Include the special character ending the run, if any, in the same CRC call */
+        Update_Checksum(checksum, run, (data < end) ? (runLength + UINT32_C(1)) : runLength);
+
+        /* One byte of the frame buffer is kept for the end delimiter */
+        if (runLength > (maxFrameLength - UINT32_C(1) - *indicator))
         {
             return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_FRAME_BUFFER_TOO_SMALL);
         }
-        /* Escape special character of payload byte if exists */
-        retcode = Escape_SpecialCharacters(frame, &indicator, maxFrameLength);
-        if (RETCODE_OK != retcode)
+        (void)memcpy(&frame[*indicator], run, runLength);
+        *indicator += runLength;
+
+        if (data < end)
         {
-            return retcode;
+            if (UINT32_C(2) > (maxFrameLength - UINT32_C(1) - *indicator))
+            {
+                return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_FRAME_BUFFER_TOO_SMALL);
+            }
+            frame[(*indicator)++] = XPROTOCOL_ESC;
+            frame[(*indicator)++] = Escape_SpecialCharacter(*data);
+            data++;
         }
     }
-    if (maxFrameLength > indicator)
+    return RETCODE_OK;
+}
+
+static void UnEscape_SpecialCharacters(const uint8_t *frame, uint32_t indicator,
+                                       uint8_t *data, uint32_t counter)
+{
+    if (XPROTOCOL_ESC == frame[indicator])
     {
-        frame[indicator] = XPROTOCOL_ED;
+        /* Check the byte after escape letter */
+        if (XPROTOCOL_ESCAPED_SD == frame[indicator + 1])
+        {
+            data[counter] = XPROTOCOL_SD;
+        }
+        else if (XPROTOCOL_ESCAPED_ED == frame[indicator + 1])
+        {
+            data[counter] = XPROTOCOL_ED;
+        }
+        else if (XPROTOCOL_ESCAPED_ESC == frame[indicator + 1])
+        {
+            data[counter] = XPROTOCOL_ESC;
+        }
     }
     else
     {
-        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_FRAME_BUFFER_TOO_SMALL);
+        data[counter] = frame[indicator];
     }
+}
+
+static Retcode_T Encode_Frame(const XProtocol_Segment_T *segments, uint32_t segmentCount,
+                              uint32_t maxFrameLength, uint8_t *frame, uint32_t *frameLength)
+{
+    /* The payload is placed behind the unescaped checksum and moved if the checksum turns out to need escaping */
+    uint32_t indicator = UINT32_C(1) + XPROTOCOL_CHECKSUM_LENGTH;
+    uint16_t checksum = UINT16_C(0x0000);
+    uint8_t escapedChecksum[2 * XPROTOCOL_CHECKSUM_LENGTH];
+    uint32_t escapedChecksumLength;
+    Retcode_T retcode = RETCODE_OK;
+
+    /* Escape the payload and calculate its checksum in a single pass */
+    for (uint32_t x = UINT32_C(0); (x < segmentCount) && (RETCODE_OK == retcode); x++)
+    {
+        retcode = Encode_Segment(segments[x].Data, segments[x].Length, &checksum, frame, &indicator, maxFrameLength);
+    }
+    if (RETCODE_OK != retcode)
+    {
+        return retcode;
+    }
+
+    /* Checksum in Network Byte Order */
+    escapedChecksumLength = Escape_Byte((uint8_t)(checksum >> 8), escapedChecksum);
+    escapedChecksumLength += Escape_Byte((uint8_t)(checksum & 0xFF), &escapedChecksum[escapedChecksumLength]);
+    if (XPROTOCOL_CHECKSUM_LENGTH < escapedChecksumLength)
+    {
+        uint32_t shift = escapedChecksumLength - XPROTOCOL_CHECKSUM_LENGTH;
+        if (shift > (maxFrameLength - UINT32_C(1) - indicator))
+        {
+            return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_FRAME_BUFFER_TOO_SMALL);
+        }
+        (void)memmove(&frame[UINT32_C(1) + escapedChecksumLength], &frame[UINT32_C(1) + XPROTOCOL_CHECKSUM_LENGTH],
+                indicator - (UINT32_C(1) + XPROTOCOL_CHECKSUM_LENGTH));
+        indicator += shift;
+    }
+
+    frame[0] = XPROTOCOL_SD;
+    (void)memcpy(&frame[1], escapedChecksum, escapedChecksumLength);
+    frame[indicator] = XPROTOCOL_ED;
     *frameLength = indicator + 1;
 
     return RETCODE_OK;
 }
 
-/*  The description of the function is available in Kiso_XProtocol.h */
-Retcode_T XProtocol_GetPayloadLength(const uint8_t *frame, uint32_t frameLength,
-                                     uint32_t *payloadLength)
+static Retcode_T Count_Payload(const uint8_t *frame, uint32_t frameLength, uint32_t *payloadLength)
 {
     uint32_t counter = UINT32_C(0);
-    if (NULL == payloadLength || NULL == frame)
-    {
-        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
-    }
 
     /* check the number of checksum and payload bytes of frame after decoding */
     for (uint32_t x = UINT32_C(0); x < frameLength; x++)
@@ -246,24 +688,13 @@ Retcode_T XProtocol_GetPayloadLength(const uint8_t *frame, uint32_t frameLength,
     return RETCODE_OK;
 }
 
-/*  The description of the function is available in Kiso_XProtocol.h */
-Retcode_T XProtocol_DecodeFrame(const uint8_t *frame, uint32_t frameLength,
-                                uint32_t maxDataLength, uint8_t *data, uint32_t *dataLength)
+static Retcode_T Decode_Frame(const uint8_t *frame, uint32_t frameLength,
+                              uint32_t maxDataLength, uint8_t *data, uint32_t *dataLength)
 {
     uint16_t checksum = UINT16_C(0x0000);
     uint8_t chksmbuff[2] =
         {0};
 
-    if (NULL == data || NULL == dataLength || NULL == frame)
-    {
-        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
-    }
-
-    if (UINT32_C(0) == frameLength)
-    {
-        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_FRAME_BUFFER_TOO_SMALL);
-    }
-
     /* Check for missing start delimiter */
     if (XPROTOCOL_SD != frame[0])
     {
@@ -326,12 +757,8 @@ Retcode_T XProtocol_DecodeFrame(const uint8_t *frame, uint32_t frameLength,
     /* Retrieve frame's checksum */
     uint16_t cs = ((uint16_t)chksmbuff[0] << 8) | chksmbuff[1];
 
-    /* Calculate payload's checksum based on CRC-CCITT (XModem)
-     * ignoring the Retcode_T returning value. We know that it's
-     * always returning RETCODE_OK because we check for NULL pointers
-     * ourselves.
-     */
-    (void)CRC_16(XPROTOCOL_CRC_CCITT_POLY, &checksum, data, (uint16_t)(counter));
+    /* Calculate payload's checksum based on CRC-CCITT (XModem) */
+    Update_Checksum(&checksum, data, counter);
 
     /* Check if calculated checksum is the same with retrieved (Network Byte Order) */
     if (checksum != cs)
@@ -343,6 +770,224 @@ Retcode_T XProtocol_DecodeFrame(const uint8_t *frame, uint32_t frameLength,
     return RETCODE_OK;
 }
 
+/* Stores one unescaped byte, the first two of a frame belong to the checksum (Network Byte Order) */
+static void Decoder_StoreByte(XProtocol_Decoder_T *decoder, uint8_t byte, Retcode_T *retcode)
+{
+    if (XPROTOCOL_CHECKSUM_LENGTH > decoder->ChecksumLength)
+    {
+        decoder->ReceivedChecksum = (uint16_t)((decoder->ReceivedChecksum << 8) | byte);
+        decoder->ChecksumLength++;
+    }
+    else if (decoder->BufferSize > decoder->PayloadLength)
+    {
+        decoder->Buffer[decoder->PayloadLength++] = byte;
+    }
+    else
+    {
+        Decoder_DropFrame(decoder, XPROTOCOL_DECODER_DISCARD, RETCODE_XPROTOCOL_DATA_BUFFER_TOO_SMALL, retcode);
+    }
+}
+
+/*
+ * Decodes a chunk of received bytes. The chunk may lie inside the decoder buffer, as long as it
+ * starts at or behind the current payload end: unescaping never makes the payload grow faster than
+ * the input is consumed, so runs are moved with memmove.
+ */
+static Retcode_T Decoder_Process(XProtocol_Decoder_T *decoder, const uint8_t *data, uint32_t length)
+{
+    const uint8_t *end = data + length;
+    Retcode_T retcode = RETCODE_OK;
+
+    while (data < end)
+    {
+        uint8_t byte;
+
+        switch (decoder->State)
+        {
+        case XPROTOCOL_DECODER_FRAME:
+            if (XPROTOCOL_CHECKSUM_LENGTH == decoder->ChecksumLength)
+            {
+                /* Move the run of bytes without special characters in one go */
+                const uint8_t *run = data;
+                uint32_t runLength;
+                while ((data < end) && !IsSpecialCharacter(*data))
+                {
+                    data++;
+                }
+                runLength = (uint32_t)(data - run);
+                if (runLength > (decoder->BufferSize - decoder->PayloadLength))
+                {
+                    Decoder_DropFrame(decoder, XPROTOCOL_DECODER_DISCARD, RETCODE_XPROTOCOL_DATA_BUFFER_TOO_SMALL, &retcode);
+                    break;
+                }
+                (void)memmove(&decoder->Buffer[decoder->PayloadLength], run, runLength);
+                decoder->PayloadLength += runLength;
+                if (data == end)
+                {
+                    break;
+                }
+            }
+            byte = *data++;
+            if (XPROTOCOL_SD == byte)
+            {
+                /* Previous frame was cut off, the new one starts here */
+                Decoder_DropFrame(decoder, XPROTOCOL_DECODER_FRAME, RETCODE_XPROTOCOL_END_DELIMITER_MISSING, &retcode);
+                Decoder_StartFrame(decoder);
+            }
+            else if (XPROTOCOL_ED == byte)
+            {
+                Decoder_EndFrame(decoder, &retcode);
+            }
+            else if (XPROTOCOL_ESC == byte)
+            {
+                decoder->State = XPROTOCOL_DECODER_ESCAPE;
+            }
+            else
+            {
+                Decoder_StoreByte(decoder, byte, &retcode);
+            }
+            break;
+
+        case XPROTOCOL_DECODER_ESCAPE:
+            byte = *data++;
+            decoder->State = XPROTOCOL_DECODER_FRAME;
+            if (XPROTOCOL_ESCAPED_SD == byte)
+            {
+                Decoder_StoreByte(decoder, XPROTOCOL_SD, &retcode);
+            }
+            else if (XPROTOCOL_ESCAPED_ED == byte)
+            {
+                Decoder_StoreByte(decoder, XPROTOCOL_ED, &retcode);
+            }
+            else if (XPROTOCOL_ESCAPED_ESC == byte)
+            {
+                Decoder_StoreByte(decoder, XPROTOCOL_ESC, &retcode);
+            }
+            else if (XPROTOCOL_SD == byte)
+            {
+                Decoder_DropFrame(decoder, XPROTOCOL_DECODER_FRAME, RETCODE_XPROTOCOL_INTEGRITY_FAILED, &retcode);
+                Decoder_StartFrame(decoder);
+            }
+            else
+            {
+                Decoder_DropFrame(decoder, (XPROTOCOL_ED == byte) ? XPROTOCOL_DECODER_IDLE : XPROTOCOL_DECODER_DISCARD,
+                                  RETCODE_XPROTOCOL_INTEGRITY_FAILED, &retcode);
+            }
+            break;
+
+        case XPROTOCOL_DECODER_DISCARD:
+            byte = *data++;
+            if (XPROTOCOL_SD == byte)
+            {
+                Decoder_StartFrame(decoder);
+            }
+            else if (XPROTOCOL_ED == byte)
+            {
+                decoder->State = XPROTOCOL_DECODER_IDLE;
+            }
+            break;
+
+        case XPROTOCOL_DECODER_IDLE:
+        default:
+            byte = *data++;
+            if (XPROTOCOL_SD == byte)
+            {
+                Decoder_StartFrame(decoder);
+            }
+            break;
+        }
+    }
+
+    if ((XPROTOCOL_DECODER_FRAME == decoder->State) || (XPROTOCOL_DECODER_ESCAPE == decoder->State))
+    {
+        Decoder_UpdateChecksum(decoder);
+    }
+    return retcode;
+}
+
+#endif /* if KISO_XPROTOCOL_COBS */
+
+/*  The description of the function is available in Kiso_XProtocol.h */
+Retcode_T XProtocol_Init(void)
+{
+    return RETCODE_OK;
+}
+
+/*  The description of the function is available in Kiso_XProtocol.h */
+uint32_t XProtocol_GetMaxEncodedLength(uint32_t dataLength)
+{
+    return XPROTOCOL_MAX_ENCODED_LENGTH(dataLength);
+}
+
+/*  The description of the function is available in Kiso_XProtocol.h */
+Retcode_T XProtocol_EncodeFrame(const uint8_t *data, uint32_t dataLength,
+                                uint32_t maxFrameLength, uint8_t *frame, uint32_t *frameLength)
+{
+    XProtocol_Segment_T segment;
+
+    if (NULL == data)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+    }
+    segment.Data = data;
+    segment.Length = dataLength;
+
+    return XProtocol_EncodeFrameSegments(&segment, UINT32_C(1), maxFrameLength, frame, frameLength);
+}
+
+/*  The description of the function is available in Kiso_XProtocol.h */
+Retcode_T XProtocol_EncodeFrameSegments(const XProtocol_Segment_T *segments, uint32_t segmentCount,
+                                        uint32_t maxFrameLength, uint8_t *frame, uint32_t *frameLength)
+{
+    if ((NULL == segments && UINT32_C(0) < segmentCount) || NULL == frame || NULL == frameLength)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+    }
+    for (uint32_t x = UINT32_C(0); x < segmentCount; x++)
+    {
+        if (NULL == segments[x].Data && UINT32_C(0) < segments[x].Length)
+        {
+            return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+        }
+    }
+
+    if (XPROTOCOL_MIN_FRAME_LENGTH > maxFrameLength)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_FRAME_BUFFER_TOO_SMALL);
+    }
+
+    return Encode_Frame(segments, segmentCount, maxFrameLength, frame, frameLength);
+}
+
+/*  The description of the function is available in Kiso_XProtocol.h */
+Retcode_T XProtocol_GetPayloadLength(const uint8_t *frame, uint32_t frameLength,
+                                     uint32_t *payloadLength)
+{
+    if (NULL == payloadLength || NULL == frame)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+    }
+
+    return Count_Payload(frame, frameLength, payloadLength);
+}
+
+/*  The description of the function is available in Kiso_XProtocol.h */
+Retcode_T XProtocol_DecodeFrame(const uint8_t *frame, uint32_t frameLength,
+                                uint32_t maxDataLength, uint8_t *data, uint32_t *dataLength)
+{
+    if (NULL == data || NULL == dataLength || NULL == frame)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+    }
+
+    if (UINT32_C(0) == frameLength)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_FRAME_BUFFER_TOO_SMALL);
+    }
+
+    return Decode_Frame(frame, frameLength, maxDataLength, data, dataLength);
+}
+
 /*  The description of the function is available in Kiso_XProtocol.h */
 Retcode_T XProtocol_IsCompleteFrame(const uint8_t *frame, uint32_t frameLength,
                                     const uint8_t **lastCheckPosition)
@@ -359,7 +1004,7 @@ Retcode_T XProtocol_IsCompleteFrame(const uint8_t *frame, uint32_t frameLength,
             *lastCheckPosition = &frame[frameLength - 1];
         }
 
-        if (XPROTOCOL_ED != frame[frameLength - 1])
+        if (XPROTOCOL_END_OF_FRAME != frame[frameLength - 1])
         {
             return RETCODE(RETCODE_SEVERITY_INFO, RETCODE_XPROTOCOL_FRAME_NOT_COMPLETE_YET);
         }
@@ -372,4 +1017,95 @@ Retcode_T XProtocol_IsCompleteFrame(const uint8_t *frame, uint32_t frameLength,
     return RETCODE_OK;
 }
 
-#endif /* if KISO_FEATURE_XPROTOCOL */
\ No newline at end of file
+/*  The description of the function is available in Kiso_XProtocol.h */
+Retcode_T XProtocol_DecoderInitialize(XProtocol_Decoder_T *decoder, uint8_t *buffer, uint32_t bufferSize,
+                                      XProtocol_FrameCallback_T callback, void *callbackParam)
+{
+    if (NULL == decoder || NULL == buffer)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+    }
+
+    decoder->Buffer = buffer;
+    decoder->BufferSize = bufferSize;
+    decoder->Callback = callback;
+    decoder->CallbackParam = callbackParam;
+    decoder->Reserved = NULL;
+    XProtocol_DecoderReset(decoder);
+
+    return RETCODE_OK;
+}
+
+/*  The description of the function is available in Kiso_XProtocol.h */
+void XProtocol_DecoderReset(XProtocol_Decoder_T *decoder)
+{
+    if (NULL != decoder)
+    {
+        Decoder_StartFrame(decoder);
+        decoder->State = XPROTOCOL_DECODER_IDLE;
+    }
+}
+
+/*  The description of the function is available in Kiso_XProtocol.h */
+Retcode_T XProtocol_DecoderPush(XProtocol_Decoder_T *decoder, const uint8_t *data, uint32_t length)
+{
+    if (NULL == decoder || NULL == data)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+    }
+
+    return Decoder_Process(decoder, data, length);
+}
+
+/*  The description of the function is available in Kiso_XProtocol.h */
+uint32_t XProtocol_DecoderReserve(XProtocol_Decoder_T *decoder, uint8_t **data)
+{
+    uint32_t offset;
+    uint32_t size = UINT32_C(0);
+
+    if (NULL != decoder && NULL != data)
+    {
+        /* Bytes of a frame being received have to stay in front of the receive position */
+        offset = UINT32_C(0);
+        if ((XPROTOCOL_DECODER_FRAME == decoder->State) || (XPROTOCOL_DECODER_ESCAPE == decoder->State))
+        {
+            offset = decoder->PayloadLength;
+        }
+        if (decoder->BufferSize > offset)
+        {
+            *data = &decoder->Buffer[offset];
+            size = decoder->BufferSize - offset;
+        }
+        else
+        {
+            /* Payload buffer is full, only the end delimiter may follow */
+            *data = decoder->Spare;
+            size = (uint32_t)sizeof(decoder->Spare);
+        }
+        decoder->Reserved = *data;
+        decoder->ReservedSize = size;
+    }
+    return size;
+}
+
+/*  The description of the function is available in Kiso_XProtocol.h */
+Retcode_T XProtocol_DecoderCommit(XProtocol_Decoder_T *decoder, uint32_t length)
+{
+    Retcode_T retcode;
+
+    if (NULL == decoder || NULL == decoder->Reserved)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+    }
+    if (length > decoder->ReservedSize)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INVALID_PARAM);
+    }
+
+    retcode = Decoder_Process(decoder, decoder->Reserved, length);
+    decoder->Reserved = NULL;
+
+    return retcode;
+}
+
+#endif /* if KISO_FEATURE_XPROTOCOL */
@@ -21,11 +21,26 @@
  * @details
  *      This source file implements following features:
  *      - CmdProcessor_Initialize()
+ *      - CmdProcessor_InitializeLanes()
+ *      - CmdProcessor_InitializeStatic()
+ *      - CmdProcessor_InitializeLanesStatic()
  *      - CmdProcessor_Enqueue()
  *      - CmdProcessor_EnqueueFromIsr()
+ *      - CmdProcessor_EnqueueToLane()
+ *      - CmdProcessor_EnqueueToLaneFromIsr()
+ *      - CmdProcessor_EnqueueDelayed()
+ *      - CmdProcessor_EnqueuePeriodic()
+ *      - CmdProcessor_CancelTimer()
  *      - CmdProcessor_Suspend()
  *      - CmdProcessor_Resume()
  *
+ *      The timer wheel has CMDPROCESSOR_TIMER_LEVELS levels of CMDPROCESSOR_TIMER_SLOTS slots.
+ *      A slot of level n holds the timers due within one span of CMDPROCESSOR_TIMER_SLOTS^n
+ *      ticks, which is as far ahead as its level covers. When the wheel time enters the span
+ *      of an upper slot, its timers move down to the level below, until they reach level 0
+ *      and run at their tick. A bitmap per level tells the occupied slots, so the task finds
+ *      the next tick it has to run at without looking at the timers.
+ *
  * @file
  **/
 
@@ -43,6 +58,7 @@
 #include "Kiso_Basics.h"
 #include "Kiso_Retcode.h"
 #include "Kiso_Assert.h"
+#include "Kiso_HAL_CriticalSection.h"
 
 /* FreeRTOS header files */
 #include "FreeRTOS.h"
@@ -62,126 +78,656 @@ struct CmdProcessor_Cmd_S
 /*The data type for command processor elements */
 typedef struct CmdProcessor_Cmd_S CmdProcessor_Cmd_T;
 
+#if (CONFIG_CMDPROCESSOR_TIMER_SLOT_BITS < 1) || (CONFIG_CMDPROCESSOR_TIMER_SLOT_BITS > 5)
+#error "CONFIG_CMDPROCESSOR_TIMER_SLOT_BITS must be between 1 and 5"
+#endif
+
+#define TIMER_SLOT_MASK (CMDPROCESSOR_TIMER_SLOTS - 1U)
+/* Bits of all slots of a level */
+#define TIMER_OCCUPIED_MASK ((uint32_t)((UINT64_C(1) << CMDPROCESSOR_TIMER_SLOTS) - 1U))
+/* Ticks covered by the wheel */
+#define TIMER_RANGE (UINT32_C(1) << (CMDPROCESSOR_TIMER_LEVELS * CONFIG_CMDPROCESSOR_TIMER_SLOT_BITS))
+
 /* This function  dequeues the queue and executes the function */
 static void Run(void *pvParameters);
 
 static void Dequeue(CmdProcessor_T *cmdProcessor);
 
+static cmdProcessorQueueHandle_t GetSingleQueue(CmdProcessor_T *cmdProcessor);
+
+/* Sets up a command processor without its queues and task, fails if no lane has a queue */
+static Retcode_T Prepare(CmdProcessor_T *cmdProcessor, const char *name, const uint32_t queueSizes[CMDPROCESSOR_LANE_COUNT])
+{
+    uint32_t nameLen;
+    uint32_t lane;
+    bool hasQueue = false;
+
+    if ((NULL == cmdProcessor) || (NULL == name) || (NULL == queueSizes))
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, (uint32_t)RETCODE_INVALID_PARAM);
+    }
+
+    nameLen = strlen(name);
+    memset(cmdProcessor->name, 0, CMDPROCESSOR_MAX_NAME_LEN);
+    nameLen = (nameLen >= CMDPROCESSOR_MAX_NAME_LEN - 1) ? (CMDPROCESSOR_MAX_NAME_LEN - 1) : nameLen;
+    memcpy(cmdProcessor->name, name, nameLen);
+    memset(cmdProcessor->queues, 0, sizeof(cmdProcessor->queues));
+    memset(cmdProcessor->queued, 0, sizeof(cmdProcessor->queued));
+    cmdProcessor->queuedCount = 0;
+    memset(&cmdProcessor->timers, 0, sizeof(cmdProcessor->timers));
+    cmdProcessor->laneCount = 0;
+
+    for (lane = 0; lane < (uint32_t)CMDPROCESSOR_LANE_COUNT; lane++)
+    {
+        hasQueue = hasQueue || (0 != queueSizes[lane]);
+    }
+    if (!hasQueue)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, (uint32_t)RETCODE_INVALID_PARAM);
+    }
+
+    return RETCODE_OK;
+}
+
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
 /* The description of the function is available in Kiso_CmdProcessor.h*/
 Retcode_T CmdProcessor_Initialize(
     CmdProcessor_T *cmdProcessor, const char *name,
     uint32_t taskPriority, uint32_t taskStackDepth, uint32_t queueSize)
 {
-    uint32_t nameLen;
-    Retcode_T retcode = RETCODE_OK;
+    uint32_t queueSizes[CMDPROCESSOR_LANE_COUNT] = {0};
 
-    if ((NULL != cmdProcessor) && (NULL != name))
-    {
-        nameLen = strlen(name);
-        memset(cmdProcessor->name, 0, CMDPROCESSOR_MAX_NAME_LEN);
-        nameLen = (nameLen >= CMDPROCESSOR_MAX_NAME_LEN - 1) ? (CMDPROCESSOR_MAX_NAME_LEN - 1) : nameLen;
-        memcpy(cmdProcessor->name, name, nameLen);
+    queueSizes[CMDPROCESSOR_LANE_NORMAL] = queueSize;
+    return CmdProcessor_InitializeLanes(cmdProcessor, name, taskPriority, taskStackDepth, queueSizes);
+}
 
-        cmdProcessor->queue = (cmdProcessorQueueHandle_t)xQueueCreate(queueSize, sizeof(CmdProcessor_Cmd_T));
+/* The description of the function is available in Kiso_CmdProcessor.h*/
+Retcode_T CmdProcessor_InitializeLanes(CmdProcessor_T *cmdProcessor, const char *name, uint32_t taskPriority, uint32_t taskStackDepth,
+                                       const uint32_t queueSizes[CMDPROCESSOR_LANE_COUNT])
+{
+    uint32_t lane;
+    Retcode_T retcode = Prepare(cmdProcessor, name, queueSizes);
 
-        if (NULL == cmdProcessor->queue)
-        {
-            retcode = RETCODE(RETCODE_SEVERITY_ERROR, (uint32_t)RETCODE_FAILURE);
-        }
-        else
-        {
-            if (pdPASS != xTaskCreate(Run, (const char *)cmdProcessor->name, (uint16_t)taskStackDepth,
-                                      (void *)cmdProcessor, taskPriority, &cmdProcessor->task))
+    if (RETCODE_OK != retcode)
+    {
+        return retcode;
+    }
 
+    for (lane = 0; (lane < (uint32_t)CMDPROCESSOR_LANE_COUNT) && (RETCODE_OK == retcode); lane++)
+    {
+        if (0 != queueSizes[lane])
+        {
+            cmdProcessor->queues[lane] = (cmdProcessorQueueHandle_t)xQueueCreate(queueSizes[lane], sizeof(CmdProcessor_Cmd_T));
+            if (NULL == cmdProcessor->queues[lane])
             {
-                /* The task was not created as there was insufficient heap memory remaining.*/
                 retcode = RETCODE(RETCODE_SEVERITY_ERROR, (uint32_t)RETCODE_FAILURE);
             }
             else
             {
-                retcode = RETCODE_OK;
+                cmdProcessor->laneCount++;
             }
         }
     }
-    else
+
+    if (RETCODE_OK == retcode)
+    {
+        if (pdPASS != xTaskCreate(Run, (const char *)cmdProcessor->name, (uint16_t)taskStackDepth,
+                                  (void *)cmdProcessor, taskPriority, &cmdProcessor->task))
+
+        {
+            /* The task was not created as there was insufficient heap memory remaining.*/
+            retcode = RETCODE(RETCODE_SEVERITY_ERROR, (uint32_t)RETCODE_FAILURE);
+        }
+    }
+
+    if (RETCODE_OK != retcode)
     {
-        retcode = RETCODE(RETCODE_SEVERITY_ERROR, (uint32_t)RETCODE_INVALID_PARAM);
+        for (lane = 0; lane < (uint32_t)CMDPROCESSOR_LANE_COUNT; lane++)
+        {
+            if (NULL != cmdProcessor->queues[lane])
+            {
+                vQueueDelete((QueueHandle_t)cmdProcessor->queues[lane]);
+                cmdProcessor->queues[lane] = NULL;
+            }
+        }
+        cmdProcessor->laneCount = 0;
     }
 
     return retcode;
 }
+#endif /* if (configSUPPORT_DYNAMIC_ALLOCATION == 1) */
 
-/*  The description of the function is available in Kiso_CmdProcessor.h */
-Retcode_T CmdProcessor_Enqueue(CmdProcessor_T *cmdProcessor, CmdProcessor_Func_T func, void *param1, uint32_t param2)
+#if KISO_UTILS_STATIC_ALLOCATION
+static_assert(sizeof(CmdProcessor_Cmd_T) == CMDPROCESSOR_COMMAND_SIZE, "CMDPROCESSOR_COMMAND_SIZE must match the queued command");
+
+/* The description of the function is available in Kiso_CmdProcessor.h*/
+Retcode_T CmdProcessor_InitializeStatic(CmdProcessor_T *cmdProcessor, const char *name, uint32_t taskPriority, uint32_t taskStackDepth, uint32_t queueSize,
+                                        StackType_t *taskStack, uint8_t *queueMemory, CmdProcessor_Storage_T *storage)
 {
-    BaseType_t rc;
+    uint32_t queueSizes[CMDPROCESSOR_LANE_COUNT] = {0};
+
+    queueSizes[CMDPROCESSOR_LANE_NORMAL] = queueSize;
+    return CmdProcessor_InitializeLanesStatic(cmdProcessor, name, taskPriority, taskStackDepth, queueSizes, taskStack, queueMemory, storage);
+}
+
+/* The description of the function is available in Kiso_CmdProcessor.h*/
+Retcode_T CmdProcessor_InitializeLanesStatic(CmdProcessor_T *cmdProcessor, const char *name, uint32_t taskPriority, uint32_t taskStackDepth,
+                                             const uint32_t queueSizes[CMDPROCESSOR_LANE_COUNT], StackType_t *taskStack, uint8_t *queueMemory,
+                                             CmdProcessor_Storage_T *storage)
+{
+    uint32_t lane;
     Retcode_T retcode;
 
+    if ((NULL == taskStack) || (NULL == queueMemory) || (NULL == storage))
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, (uint32_t)RETCODE_INVALID_PARAM);
+    }
+
+    retcode = Prepare(cmdProcessor, name, queueSizes);
+    if (RETCODE_OK != retcode)
+    {
+        return retcode;
+    }
+
+    /* Creating objects in given storage does not fail, the lanes share the queue memory */
+    for (lane = 0; lane < (uint32_t)CMDPROCESSOR_LANE_COUNT; lane++)
+    {
+        if (0 != queueSizes[lane])
+        {
+            cmdProcessor->queues[lane] = (cmdProcessorQueueHandle_t)xQueueCreateStatic(queueSizes[lane], sizeof(CmdProcessor_Cmd_T), queueMemory, &storage->queues[lane]);
+            queueMemory += CMDPROCESSOR_QUEUE_MEMORY_SIZE(queueSizes[lane]);
+            cmdProcessor->laneCount++;
+        }
+    }
+
+    cmdProcessor->task = (cmdProcessorTaskHandle_t)xTaskCreateStatic(Run, (const char *)cmdProcessor->name, taskStackDepth,
+                                                                     (void *)cmdProcessor, taskPriority, taskStack, &storage->task);
+
+    return RETCODE_OK;
+}
+#endif /* if KISO_UTILS_STATIC_ALLOCATION */
+
+/* Looks up a waiting coalescing command or reserves a slot for it, returns false if it waits already */
+static bool Coalesce(CmdProcessor_T *cmdProcessor, const CmdProcessor_Cmd_T *cmd)
+{
+    uint32_t count = 0;
+    uint32_t slot;
+    struct _CmdProcessor_Coalesce_S *free = NULL;
+    bool isNew = true;
+
+    /* Enqueuing tasks, interrupts and the command processor share the slots */
+    (void)HAL_CriticalSection_Enter(&count);
+    for (slot = 0; slot < CONFIG_CMDPROCESSOR_COALESCE_SLOTS; slot++)
+    {
+        struct _CmdProcessor_Coalesce_S *queued = &cmdProcessor->queued[slot];
+        if ((queued->func == cmd->func) && (queued->param1 == cmd->param1))
+        {
+            isNew = false;
+            break;
+        }
+        if ((NULL == free) && (NULL == queued->func))
+        {
+            free = queued;
+        }
+    }
+    if (isNew && (NULL != free))
+    {
+        free->func = cmd->func;
+        free->param1 = cmd->param1;
+        cmdProcessor->queuedCount++;
+    }
+    (void)HAL_CriticalSection_Leave(&count);
+
+    return isNew;
+}
+
+/*
+ * Frees the slot of the function and param1 of a command. The queued commands do not carry their
+ * slot, which keeps them small, so the slot is looked up. A command enqueued without coalescing
+ * frees the slot as well, the waiting one then may be queued once more.
+ */
+static void ReleaseCoalesceSlot(CmdProcessor_T *cmdProcessor, const CmdProcessor_Cmd_T *cmd)
+{
+    uint32_t count = 0;
+    uint32_t slot;
+
+    /* Most commands run while no coalescing one waits, which is checked without the critical section */
+    if (0U == __atomic_load_n(&cmdProcessor->queuedCount, __ATOMIC_RELAXED))
+    {
+        return;
+    }
+
+    (void)HAL_CriticalSection_Enter(&count);
+    for (slot = 0; slot < CONFIG_CMDPROCESSOR_COALESCE_SLOTS; slot++)
+    {
+        struct _CmdProcessor_Coalesce_S *queued = &cmdProcessor->queued[slot];
+        if ((queued->func == cmd->func) && (queued->param1 == cmd->param1))
+        {
+            queued->func = NULL;
+            queued->param1 = NULL;
+            cmdProcessor->queuedCount--;
+            break;
+        }
+    }
+    (void)HAL_CriticalSection_Leave(&count);
+}
+
+static Retcode_T Enqueue(CmdProcessor_T *cmdProcessor, CmdProcessor_Lane_T lane, bool isCoalesced, bool isFromIsr,
+                         CmdProcessor_Func_T func, void *param1, uint32_t param2)
+{
+    BaseType_t rc;
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    CmdProcessor_Cmd_T cmd;
+
     /* Null checking */
     assert(func);
 
-    CmdProcessor_Cmd_T cmd;
+    if ((NULL == cmdProcessor) || ((uint32_t)lane >= (uint32_t)CMDPROCESSOR_LANE_COUNT) || (NULL == cmdProcessor->queues[lane]))
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, (uint32_t)RETCODE_INVALID_PARAM);
+    }
+
     cmd.func = func;
     cmd.param1 = param1;
     cmd.param2 = param2;
 
+    if (isCoalesced && !Coalesce(cmdProcessor, &cmd))
+    {
+        return RETCODE_OK;
+    }
+
     /* On success, CMDPROCESSOR_OK is returned.CMDPROCESSOR_QUEUE_FULL if the queue is full */
-    if ((NULL != cmdProcessor) && (NULL != cmdProcessor->queue))
+    if (isFromIsr)
+    {
+        rc = xQueueSendFromISR(cmdProcessor->queues[lane], &cmd, &higherPriorityTaskWoken);
+    }
+    else
     {
-        rc = xQueueSend(cmdProcessor->queue, &cmd, 0);
+        rc = xQueueSend(cmdProcessor->queues[lane], &cmd, 0);
+    }
+    if (pdPASS != rc)
+    {
+        if (isCoalesced)
+        {
+            ReleaseCoalesceSlot(cmdProcessor, &cmd);
+        }
+        return RETCODE(RETCODE_SEVERITY_ERROR, (uint32_t)RETCODE_FAILURE);
+    }
 
-        if (pdPASS == rc)
+    /* A task with a single lane waits on its queue, otherwise on its notification */
+    if (cmdProcessor->laneCount > 1U)
+    {
+        if (isFromIsr)
         {
-            retcode = RETCODE_OK;
+            vTaskNotifyGiveFromISR((TaskHandle_t)cmdProcessor->task, &higherPriorityTaskWoken);
         }
         else
         {
-            retcode = RETCODE(RETCODE_SEVERITY_ERROR, (uint32_t)RETCODE_FAILURE);
+            (void)xTaskNotifyGive((TaskHandle_t)cmdProcessor->task);
         }
     }
-    else
+    if (isFromIsr)
     {
-        retcode = RETCODE(RETCODE_SEVERITY_ERROR, (uint32_t)RETCODE_INVALID_PARAM);
+        portYIELD_FROM_ISR(higherPriorityTaskWoken);
     }
 
-    return retcode;
+    return RETCODE_OK;
+}
+
+/*  The description of the function is available in Kiso_CmdProcessor.h */
+Retcode_T CmdProcessor_Enqueue(CmdProcessor_T *cmdProcessor, CmdProcessor_Func_T func, void *param1, uint32_t param2)
+{
+    return Enqueue(cmdProcessor, CMDPROCESSOR_LANE_NORMAL, false, false, func, param1, param2);
 }
 
 /*  The description of the function is available in Kiso_CmdProcessor.h */
 Retcode_T CmdProcessor_EnqueueFromIsr(CmdProcessor_T *cmdProcessor, CmdProcessor_Func_T func, void *param1, uint32_t param2)
 {
-    int32_t rc = pdPASS;
-    Retcode_T retcode = RETCODE_OK;
-    uint32_t higherPriorityTaskWoken = pdFALSE;
+    return Enqueue(cmdProcessor, CMDPROCESSOR_LANE_NORMAL, false, true, func, param1, param2);
+}
 
-    /* Null checking */
-    assert(func != NULL);
+/*  The description of the function is available in Kiso_CmdProcessor.h */
+Retcode_T CmdProcessor_EnqueueToLane(CmdProcessor_T *cmdProcessor, CmdProcessor_Lane_T lane, bool isCoalesced,
+                                     CmdProcessor_Func_T func, void *param1, uint32_t param2)
+{
+    return Enqueue(cmdProcessor, lane, isCoalesced, false, func, param1, param2);
+}
 
-    CmdProcessor_Cmd_T cmd;
-    cmd.func = func;
-    cmd.param1 = param1;
-    cmd.param2 = param2;
+/*  The description of the function is available in Kiso_CmdProcessor.h */
+Retcode_T CmdProcessor_EnqueueToLaneFromIsr(CmdProcessor_T *cmdProcessor, CmdProcessor_Lane_T lane, bool isCoalesced,
+                                            CmdProcessor_Func_T func, void *param1, uint32_t param2)
+{
+    return Enqueue(cmdProcessor, lane, isCoalesced, true, func, param1, param2);
+}
 
-    /* On success, CMDPROCESSOR_OK is returned.CMDPROCESSOR_QUEUE_FULL if the queue is full */
-    if ((NULL != cmdProcessor) && (NULL != cmdProcessor->queue))
+static void TimerLink(CmdProcessor_Timer_T **head, CmdProcessor_Timer_T *timer)
+{
+    timer->next = *head;
+    if (NULL != timer->next)
+    {
+        timer->next->pprev = &timer->next;
+    }
+    timer->pprev = head;
+    *head = timer;
+}
+
+/* Takes the timer from its slot or from the expiring ones, whichever it is in */
+static void TimerUnlink(struct _CmdProcessor_TimerWheel_S *wheel, CmdProcessor_Timer_T *timer)
+{
+    uint32_t level = timer->slot >> CONFIG_CMDPROCESSOR_TIMER_SLOT_BITS;
+    uint32_t index = timer->slot & TIMER_SLOT_MASK;
+
+    *timer->pprev = timer->next;
+    if (NULL != timer->next)
+    {
+        timer->next->pprev = timer->pprev;
+    }
+    timer->next = NULL;
+    timer->pprev = NULL;
+
+    if (NULL == wheel->slots[level][index])
+    {
+        wheel->occupied[level] &= ~(UINT32_C(1) << index);
+    }
+}
+
+/* Puts the timer in the lowest level which reaches its deadline */
+static void TimerInsert(struct _CmdProcessor_TimerWheel_S *wheel, CmdProcessor_Timer_T *timer)
+{
+    uint32_t deadline = timer->deadline;
+    uint32_t delta = deadline - wheel->time;
+    uint32_t level = 0;
+    uint32_t index;
+
+    if ((int32_t)delta < 0)
+    {
+        /* Overdue, it runs with the next tick of the wheel */
+        deadline = wheel->time;
+        delta = 0;
+    }
+    else if (delta >= TIMER_RANGE)
+    {
+        /* Beyond the wheel, it is placed again when its slot comes round */
+        deadline = wheel->time + TIMER_RANGE - 1U;
+        delta = TIMER_RANGE - 1U;
+    }
+    while ((delta >> (CONFIG_CMDPROCESSOR_TIMER_SLOT_BITS * (level + 1U))) != 0U)
     {
-        rc = xQueueSendFromISR(cmdProcessor->queue, &cmd, (BaseType_t *)&higherPriorityTaskWoken);
-        if (pdPASS == rc)
+        level++;
+    }
+
+    index = (deadline >> (CONFIG_CMDPROCESSOR_TIMER_SLOT_BITS * level)) & TIMER_SLOT_MASK;
+    timer->slot = (level << CONFIG_CMDPROCESSOR_TIMER_SLOT_BITS) | index;
+    TimerLink(&wheel->slots[level][index], timer);
+    wheel->occupied[level] |= UINT32_C(1) << index;
+}
+
+/* Number of slots from the given one to the next occupied one, going round, CMDPROCESSOR_TIMER_SLOTS if none */
+static uint32_t TimerNextSlot(uint32_t occupied, uint32_t from)
+{
+    uint32_t rotated = occupied;
+
+    if (0U == occupied)
+    {
+        return CMDPROCESSOR_TIMER_SLOTS;
+    }
+    if (0U != from)
+    {
+        rotated = ((occupied >> from) | (occupied << (CMDPROCESSOR_TIMER_SLOTS - from))) & TIMER_OCCUPIED_MASK;
+    }
+    return (uint32_t)__builtin_ctz(rotated);
+}
+
+/* Ticks from the wheel time to the next tick with timers to run or move down, portMAX_DELAY if there are no timers */
+static TickType_t TimerTicksToNext(const struct _CmdProcessor_TimerWheel_S *wheel)
+{
+    TickType_t next = portMAX_DELAY;
+    uint32_t level;
+
+    for (level = 0; level < CMDPROCESSOR_TIMER_LEVELS; level++)
+    {
+        uint32_t shift = CONFIG_CMDPROCESSOR_TIMER_SLOT_BITS * level;
+        uint32_t span = wheel->time >> shift;
+        uint32_t distance;
+
+        /* The slot of an upper level is emptied on the first tick of its span */
+        if ((0U != level) && (0U != (wheel->time & ((UINT32_C(1) << shift) - 1U))))
+        {
+            span++;
+        }
+        distance = TimerNextSlot(wheel->occupied[level], span & TIMER_SLOT_MASK);
+        if (distance < CMDPROCESSOR_TIMER_SLOTS)
+        {
+            TickType_t ticks = (TickType_t)(((span + distance) << shift) - wheel->time);
+            next = (ticks < next) ? ticks : next;
+        }
+    }
+    return next;
+}
+
+/* Runs one tick of the wheel, the caller holds the critical section, which is left while a function runs */
+static void TimerRunTick(struct _CmdProcessor_TimerWheel_S *wheel, TickType_t now, uint32_t *count)
+{
+    CmdProcessor_Timer_T *timer;
+    uint32_t level;
+    uint32_t index = wheel->time & TIMER_SLOT_MASK;
+
+    /* Upper levels first, their timers may move down to the span starting now */
+    for (level = CMDPROCESSOR_TIMER_LEVELS - 1U; level > 0U; level--)
+    {
+        uint32_t shift = CONFIG_CMDPROCESSOR_TIMER_SLOT_BITS * level;
+        if (0U == (wheel->time & ((UINT32_C(1) << shift) - 1U)))
+        {
+            CmdProcessor_Timer_T **slot = &wheel->slots[level][(wheel->time >> shift) & TIMER_SLOT_MASK];
+            while (NULL != *slot)
+            {
+                timer = *slot;
+                TimerUnlink(wheel, timer);
+                TimerInsert(wheel, timer);
+                (void)HAL_CriticalSection_Leave(count);
+                (void)HAL_CriticalSection_Enter(count);
+            }
+        }
+    }
+
+    /* The due timers are set aside, so timers scheduled by the functions go to the next tick */
+    wheel->expiring = wheel->slots[0][index];
+    if (NULL != wheel->expiring)
+    {
+        wheel->expiring->pprev = &wheel->expiring;
+    }
+    wheel->slots[0][index] = NULL;
+    wheel->occupied[0] &= ~(UINT32_C(1) << index);
+    wheel->time++;
+
+    while (NULL != wheel->expiring)
+    {
+        CmdProcessor_Func_T func;
+        void *param1;
+        uint32_t param2;
+
+        timer = wheel->expiring;
+        TimerUnlink(wheel, timer);
+        func = timer->func;
+        param1 = timer->param1;
+        param2 = timer->param2;
+        if (0U != timer->period)
+        {
+            timer->deadline += timer->period;
+            if ((int32_t)(timer->deadline - now) <= 0)
+            {
+                /* Missed runs are skipped */
+                timer->deadline += ((now - timer->deadline) / timer->period + 1U) * timer->period;
+            }
+            TimerInsert(wheel, timer);
+        }
+
+        (void)HAL_CriticalSection_Leave(count);
+        func(param1, param2);
+        (void)HAL_CriticalSection_Enter(count);
+    }
+}
+
+/*
+ * Runs the timers which are due and marks the task as sleeping, returns the time the task may wait
+ * for a command before it has to run timers again
+ */
+static TickType_t TimerRun(CmdProcessor_T *cmdProcessor)
+{
+    struct _CmdProcessor_TimerWheel_S *wheel = &cmdProcessor->timers;
+    TickType_t now = xTaskGetTickCount();
+    TickType_t ticks = portMAX_DELAY;
+    uint32_t count = 0;
+
+    (void)HAL_CriticalSection_Enter(&count);
+    while ((int32_t)(now - wheel->time) >= 0)
+    {
+        ticks = TimerTicksToNext(wheel);
+        if (portMAX_DELAY == ticks)
         {
-            retcode = RETCODE_OK;
-            portYIELD_FROM_ISR(higherPriorityTaskWoken);
+            wheel->time = now + 1U;
+        }
+        else if (0U != ticks)
+        {
+            /* Nothing to do up to the next occupied slot */
+            wheel->time += (ticks < (now - wheel->time + 1U)) ? ticks : (now - wheel->time + 1U);
         }
         else
         {
-            retcode = RETCODE(RETCODE_SEVERITY_ERROR, (uint32_t)RETCODE_FAILURE);
+            TimerRunTick(wheel, now, &count);
         }
     }
-    else
+
+    ticks = TimerTicksToNext(wheel);
+    if (portMAX_DELAY != ticks)
     {
-        retcode = RETCODE(RETCODE_SEVERITY_ERROR, (uint32_t)RETCODE_INVALID_PARAM);
+        ticks += wheel->time - now;
     }
+    wheel->isSleeping = true;
+    wheel->hasWakeTime = (portMAX_DELAY != ticks);
+    wheel->wakeTime = now + ticks;
+    (void)HAL_CriticalSection_Leave(&count);
 
-    return retcode;
+    return ticks;
+}
+
+static void TimerAwake(CmdProcessor_T *cmdProcessor)
+{
+    uint32_t count = 0;
+
+    (void)HAL_CriticalSection_Enter(&count);
+    cmdProcessor->timers.isSleeping = false;
+    (void)HAL_CriticalSection_Leave(&count);
+}
+
+/* Queued to wake up a task with a single lane, which waits on its queue */
+static void TimerWakeUp(void *param1, uint32_t param2)
+{
+    KISO_UNUSED(param1);
+    KISO_UNUSED(param2);
+}
+
+static Retcode_T ScheduleTimer(CmdProcessor_T *cmdProcessor, CmdProcessor_Timer_T *timer, CmdProcessor_Func_T func,
+                               void *param1, uint32_t param2, TickType_t delay, TickType_t period)
+{
+    struct _CmdProcessor_TimerWheel_S *wheel;
+    TickType_t now;
+    uint32_t count = 0;
+    uint32_t level;
+    bool isEmpty = true;
+    bool isWakeUp;
+
+    if ((NULL == cmdProcessor) || (NULL == timer) || (NULL == func) || (NULL == GetSingleQueue(cmdProcessor)))
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, (uint32_t)RETCODE_INVALID_PARAM);
+    }
+
+    wheel = &cmdProcessor->timers;
+    now = xTaskGetTickCount();
+
+    (void)HAL_CriticalSection_Enter(&count);
+    if (NULL != timer->pprev)
+    {
+        TimerUnlink(wheel, timer);
+    }
+    for (level = 0; level < CMDPROCESSOR_TIMER_LEVELS; level++)
+    {
+        isEmpty = isEmpty && (0U == wheel->occupied[level]);
+    }
+    if (isEmpty && (NULL == wheel->expiring) && ((int32_t)(now - wheel->time) > 0))
+    {
+        /* The wheel of a task waiting without timers is not turned, it starts from now */
+        wheel->time = now;
+    }
+
+    timer->func = func;
+    timer->param1 = param1;
+    timer->param2 = param2;
+    timer->deadline = now + delay;
+    timer->period = period;
+    TimerInsert(wheel, timer);
+
+    /* The task only needs to wake up for a timer due before it wakes up anyway */
+    isWakeUp = wheel->isSleeping && (!wheel->hasWakeTime || ((int32_t)(timer->deadline - wheel->wakeTime) < 0));
+    if (isWakeUp)
+    {
+        wheel->isSleeping = false;
+    }
+    (void)HAL_CriticalSection_Leave(&count);
+
+    if (isWakeUp)
+    {
+        if (cmdProcessor->laneCount > 1U)
+        {
+            (void)xTaskNotifyGive((TaskHandle_t)cmdProcessor->task);
+        }
+        else
+        {
+            CmdProcessor_Cmd_T cmd = {TimerWakeUp, NULL, 0};
+
+            /* A full queue wakes the task anyway */
+            (void)xQueueSend(GetSingleQueue(cmdProcessor), &cmd, 0);
+        }
+    }
+
+    return RETCODE_OK;
+}
+
+/*  The description of the function is available in Kiso_CmdProcessor.h */
+Retcode_T CmdProcessor_EnqueueDelayed(CmdProcessor_T *cmdProcessor, CmdProcessor_Timer_T *timer,
+                                      CmdProcessor_Func_T func, void *param1, uint32_t param2, uint32_t delay)
+{
+    return ScheduleTimer(cmdProcessor, timer, func, param1, param2, pdMS_TO_TICKS(delay), 0);
+}
+
+/*  The description of the function is available in Kiso_CmdProcessor.h */
+Retcode_T CmdProcessor_EnqueuePeriodic(CmdProcessor_T *cmdProcessor, CmdProcessor_Timer_T *timer,
+                                       CmdProcessor_Func_T func, void *param1, uint32_t param2, uint32_t period)
+{
+    TickType_t ticks = pdMS_TO_TICKS(period);
+
+    ticks = (0U == ticks) ? 1U : ticks;
+    return ScheduleTimer(cmdProcessor, timer, func, param1, param2, ticks, ticks);
+}
+
+/*  The description of the function is available in Kiso_CmdProcessor.h */
+Retcode_T CmdProcessor_CancelTimer(CmdProcessor_T *cmdProcessor, CmdProcessor_Timer_T *timer)
+{
+    uint32_t count = 0;
+
+    if ((NULL == cmdProcessor) || (NULL == timer))
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, (uint32_t)RETCODE_INVALID_PARAM);
+    }
+
+    (void)HAL_CriticalSection_Enter(&count);
+    if (NULL != timer->pprev)
+    {
+        TimerUnlink(&cmdProcessor->timers, timer);
+    }
+    (void)HAL_CriticalSection_Leave(&count);
+
+    return RETCODE_OK;
 }
 
 /*  The description of the function is available in Kiso_CmdProcessor.h */
@@ -222,36 +768,95 @@ static void Run(void *pvParameters)
     Retcode_RaiseError(RETCODE(RETCODE_SEVERITY_FATAL, (uint32_t)RETCODE_FAILURE));
 }
 
+static void Execute(CmdProcessor_T *cmdProcessor, const CmdProcessor_Cmd_T *cmd)
+{
+    /* A coalescing command enqueued from now on runs once more */
+    ReleaseCoalesceSlot(cmdProcessor, cmd);
+
+    if (NULL != cmd->func)
+    {
+        cmd->func(cmd->param1, cmd->param2);
+    }
+    else
+    {
+        Retcode_RaiseError(RETCODE(RETCODE_SEVERITY_FATAL, (uint32_t)RETCODE_INVALID_PARAM));
+    }
+}
+
+/* Takes the oldest command of the most urgent lane, without waiting */
+static bool ReceiveMostUrgent(CmdProcessor_T *cmdProcessor, CmdProcessor_Cmd_T *cmd)
+{
+    uint32_t lane;
+
+    for (lane = 0; lane < (uint32_t)CMDPROCESSOR_LANE_COUNT; lane++)
+    {
+        if ((NULL != cmdProcessor->queues[lane]) && (pdPASS == xQueueReceive(cmdProcessor->queues[lane], cmd, 0)))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static cmdProcessorQueueHandle_t GetSingleQueue(CmdProcessor_T *cmdProcessor)
+{
+    uint32_t lane;
+
+    for (lane = 0; lane < (uint32_t)CMDPROCESSOR_LANE_COUNT; lane++)
+    {
+        if (NULL != cmdProcessor->queues[lane])
+        {
+            return cmdProcessor->queues[lane];
+        }
+    }
+    return NULL;
+}
+
 /*  The description of the function is available in Kiso_CmdProcessor.h */
 static void Dequeue(CmdProcessor_T *cmdProcessor)
 {
-    if ((NULL != cmdProcessor) && (NULL != cmdProcessor->queue))
+    if ((NULL == cmdProcessor) || (NULL == GetSingleQueue(cmdProcessor)))
+    {
+        Retcode_RaiseError(RETCODE(RETCODE_SEVERITY_FATAL, (uint32_t)RETCODE_INVALID_PARAM));
+    }
+    else if (cmdProcessor->laneCount <= 1U)
     {
         CmdProcessor_Cmd_T cmd;
-        cmdProcessorQueueHandle_t cmdQueue;
         BaseType_t rc;
+        TickType_t timeout = TimerRun(cmdProcessor);
 
-        cmdQueue = cmdProcessor->queue;
-        rc = xQueueReceive(cmdQueue, &cmd, portMAX_DELAY);
+        rc = xQueueReceive(GetSingleQueue(cmdProcessor), &cmd, timeout);
+        TimerAwake(cmdProcessor);
         if (rc == pdPASS)
         {
-            if (NULL != cmd.func)
-            {
-                cmd.func(cmd.param1, cmd.param2);
-            }
-            else
-            {
-                Retcode_RaiseError(RETCODE(RETCODE_SEVERITY_FATAL, (uint32_t)RETCODE_INVALID_PARAM));
-            }
+            Execute(cmdProcessor, &cmd);
         }
-        else
+        else if (portMAX_DELAY == timeout)
         {
             Retcode_RaiseError(RETCODE(RETCODE_SEVERITY_FATAL, (uint32_t)RETCODE_CMDPROCESSOR_QUEUE_ERROR));
         }
     }
     else
     {
-        Retcode_RaiseError(RETCODE(RETCODE_SEVERITY_FATAL, (uint32_t)RETCODE_INVALID_PARAM));
+        CmdProcessor_Cmd_T cmd;
+        uint32_t executed = 0;
+        TickType_t timeout = TimerRun(cmdProcessor);
+
+        /* The notification only wakes the task, the queues tell what is pending */
+        while ((executed < CONFIG_CMDPROCESSOR_BATCH_SIZE) && ReceiveMostUrgent(cmdProcessor, &cmd))
+        {
+            Execute(cmdProcessor, &cmd);
+            executed++;
+        }
+        if (0 == executed)
+        {
+            (void)ulTaskNotifyTake(pdTRUE, timeout);
+        }
+        TimerAwake(cmdProcessor);
+        if (CONFIG_CMDPROCESSOR_BATCH_SIZE == executed)
+        {
+            taskYIELD();
+        }
     }
 }
 
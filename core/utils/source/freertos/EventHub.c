@@ -20,9 +20,14 @@
  * @details
  *      This source file implements following features:
  *      - EventHub_Initialize()
+ *      - EventHub_InitializeStatic()
  *      - EventHub_Observe()
  *      - EventHub_ObserveAll()
  *      - EventHub_Notify()
+ *      - EventHub_NotifyFromIsr()
+ *      - EventHub_ObserveAsync()
+ *      - EventHub_ObserveAllAsync()
+ *      - EventHub_GetAsyncStatistics()
  * @file
  **/
 
@@ -39,12 +44,19 @@
 /* KISO basics header files */
 #include "Kiso_Basics.h"
 #include "Kiso_Retcode.h"
+#include "Kiso_HAL_CriticalSection.h"
 
 /* FreeRTOS header files */
 #include "FreeRTOS.h"
 #include "task.h"
 #include "semphr.h"
+#include "timers.h"
 
+#if KISO_FEATURE_CMDPROCESSOR
+#include "Kiso_CmdProcessor.h"
+#endif
+
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
 /*  The description of the function is available in Kiso_EventHub.h */
 Retcode_T EventHub_Initialize(EventHub_T *hub)
 {
@@ -63,9 +75,39 @@ Retcode_T EventHub_Initialize(EventHub_T *hub)
 
     return RETCODE_OK;
 }
+#endif /* if (configSUPPORT_DYNAMIC_ALLOCATION == 1) */
 
+#if KISO_UTILS_STATIC_ALLOCATION
 /*  The description of the function is available in Kiso_EventHub.h */
-Retcode_T EventHub_Observe(EventHub_T *hub, EventHandler_T handler, TaskEvent_T event)
+Retcode_T EventHub_InitializeStatic(EventHub_T *hub, EventHub_Storage_T *storage)
+{
+    if ((NULL == hub) || (NULL == storage))
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, (Retcode_T)RETCODE_NULL_POINTER);
+    }
+
+    memset(hub, 0, sizeof(EventHub_T));
+
+    hub->lock = (SemaphoreHandle_t)xSemaphoreCreateMutexStatic(&storage->lock);
+
+    return RETCODE_OK;
+}
+#endif /* if KISO_UTILS_STATIC_ALLOCATION */
+
+/* Observers are numbered from 1 in the lists, so a list of a cleared hub is empty */
+static uint8_t *EventHub_GetList(EventHub_T *hub, TaskEvent_T event, bool allEvents)
+{
+    if (allEvents)
+    {
+        return &hub->allObservers;
+    }
+    event ^= (event >> 16);
+    event ^= (event >> 8);
+    return &hub->eventObservers[event & (CONFIG_EVENTHUB_EVENT_BUCKETS - 1U)];
+}
+
+static Retcode_T EventHub_AddObserver(EventHub_T *hub, EventHandler_T handler, TaskEvent_T event, bool allEvents,
+                                      struct _CmdProcessor_S *cmdProcessor, bool isCoalesced)
 {
     Retcode_T retval = RETCODE_OK;
 
@@ -91,10 +133,26 @@ Retcode_T EventHub_Observe(EventHub_T *hub, EventHandler_T handler, TaskEvent_T
 
     if (retval == RETCODE_OK)
     {
-        hub->observers[hub->observerCount].event = event;
-        hub->observers[hub->observerCount].allEvents = false;
-        hub->observers[hub->observerCount].handler = handler;
+        EventObserver_T *observer = &hub->observers[hub->observerCount];
+        uint8_t *link = EventHub_GetList(hub, event, allEvents);
+
+        observer->event = event;
+        observer->allEvents = allEvents;
+        observer->handler = handler;
+        observer->cmdProcessor = cmdProcessor;
+        observer->isCoalesced = isCoalesced;
+        observer->queuedDelivery = 0;
+        observer->next = 0;
+
+        /* Appended at the end of the list, so the observers are called in the order of registration */
+        while (0 != *link)
+        {
+            link = &hub->observers[*link - 1U].next;
+        }
         hub->observerCount++;
+
+        /* Notifications in progress see the observer only after it is complete */
+        __atomic_store_n(link, (uint8_t)hub->observerCount, __ATOMIC_RELEASE);
     }
 
     if (pdPASS != xSemaphoreGive((SemaphoreHandle_t)hub->lock))
@@ -105,49 +163,263 @@ Retcode_T EventHub_Observe(EventHub_T *hub, EventHandler_T handler, TaskEvent_T
     return retval;
 }
 
+#if KISO_FEATURE_CMDPROCESSOR
+
+/* Frees a delivery, the caller is in the critical section */
+static void EventHub_ReleaseDelivery(EventHub_T *hub, uint32_t index)
+{
+    EventObserver_T *observer = &hub->observers[hub->deliveries[index].observer - 1U];
+
+    if ((index + 1U) == observer->queuedDelivery)
+    {
+        observer->queuedDelivery = 0;
+    }
+    hub->deliveries[index].observer = 0;
+    hub->asyncStatistics.depth--;
+}
+
+/* Runs in the command processor of the observer */
+static void EventHub_RunDelivery(void *param1, uint32_t param2)
+{
+    EventHub_T *hub = (EventHub_T *)param1;
+    EventHubAsyncStatistics_T *statistics = &hub->asyncStatistics;
+    EventDelivery_T delivery;
+    uint32_t now = (uint32_t)xTaskGetTickCount();
+    uint32_t latency;
+    uint32_t count = 0;
+
+    (void)HAL_CriticalSection_Enter(&count);
+    delivery = hub->deliveries[param2];
+    EventHub_ReleaseDelivery(hub, param2);
+    latency = now - delivery.queuedTick;
+    statistics->delivered++;
+    statistics->latencyTotal += latency;
+    if (latency > statistics->latencyMax)
+    {
+        statistics->latencyMax = latency;
+    }
+    (void)HAL_CriticalSection_Leave(&count);
+
+    hub->observers[delivery.observer - 1U].handler(delivery.event, delivery.data);
+}
+
+/* Queues the notification in the command processor of the observer, or merges it into the queued one */
+static Retcode_T EventHub_QueueDelivery(EventHub_T *hub, uint8_t number, TaskEvent_T event, const void *data)
+{
+    EventObserver_T *observer = &hub->observers[number - 1U];
+    EventHubAsyncStatistics_T *statistics = &hub->asyncStatistics;
+    uint32_t now = (uint32_t)xTaskGetTickCount();
+    uint32_t index = CONFIG_EVENTHUB_ASYNC_QUEUE_SIZE;
+    uint32_t count = 0;
+    bool isMerged = false;
+
+    /* Notifying tasks and the command processors share the deliveries */
+    (void)HAL_CriticalSection_Enter(&count);
+    if (observer->isCoalesced && (0 != observer->queuedDelivery) &&
+        (event == hub->deliveries[observer->queuedDelivery - 1U].event))
+    {
+        hub->deliveries[observer->queuedDelivery - 1U].data = data;
+        statistics->coalesced++;
+        isMerged = true;
+    }
+    else
+    {
+        for (index = 0; index < CONFIG_EVENTHUB_ASYNC_QUEUE_SIZE; index++)
+        {
+            if (0 == hub->deliveries[index].observer)
+            {
+                break;
+            }
+        }
+        if (CONFIG_EVENTHUB_ASYNC_QUEUE_SIZE == index)
+        {
+            statistics->dropped++;
+        }
+        else
+        {
+            hub->deliveries[index].event = event;
+            hub->deliveries[index].data = data;
+            hub->deliveries[index].queuedTick = now;
+            hub->deliveries[index].observer = number;
+            observer->queuedDelivery = (uint8_t)(index + 1U);
+            statistics->depth++;
+            if (statistics->depth > statistics->depthMax)
+            {
+                statistics->depthMax = statistics->depth;
+            }
+        }
+    }
+    (void)HAL_CriticalSection_Leave(&count);
+
+    if (isMerged)
+    {
+        return RETCODE_OK;
+    }
+    if (CONFIG_EVENTHUB_ASYNC_QUEUE_SIZE == index)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, (Retcode_T)RETCODE_OUT_OF_RESOURCES);
+    }
+    if (RETCODE_OK != CmdProcessor_Enqueue(observer->cmdProcessor, EventHub_RunDelivery, hub, index))
+    {
+        (void)HAL_CriticalSection_Enter(&count);
+        EventHub_ReleaseDelivery(hub, index);
+        statistics->dropped++;
+        (void)HAL_CriticalSection_Leave(&count);
+        return RETCODE(RETCODE_SEVERITY_ERROR, (Retcode_T)RETCODE_OUT_OF_RESOURCES);
+    }
+    return RETCODE_OK;
+}
+
+#endif /* if KISO_FEATURE_CMDPROCESSOR */
+
+static Retcode_T EventHub_CallObservers(EventHub_T *hub, const uint8_t *list, TaskEvent_T event, const void *data)
+{
+    Retcode_T retval = RETCODE_OK;
+    uint8_t number = __atomic_load_n(list, __ATOMIC_ACQUIRE);
+
+    while (0 != number)
+    {
+        const EventObserver_T *observer = &hub->observers[number - 1U];
+        if (observer->allEvents || event == observer->event)
+        {
+#if KISO_FEATURE_CMDPROCESSOR
+            if (NULL != observer->cmdProcessor)
+            {
+                Retcode_T rc = EventHub_QueueDelivery(hub, number, event, data);
+                retval = (RETCODE_OK == retval) ? rc : retval;
+            }
+            else
+#endif
+            {
+                observer->handler(event, data);
+            }
+        }
+        number = __atomic_load_n(&observer->next, __ATOMIC_ACQUIRE);
+    }
+    return retval;
+}
+
+static Retcode_T EventHub_Deliver(EventHub_T *hub, TaskEvent_T event, const void *data)
+{
+    Retcode_T retval = EventHub_CallObservers(hub, EventHub_GetList(hub, event, false), event, data);
+    Retcode_T rc = EventHub_CallObservers(hub, &hub->allObservers, event, data);
+    return (RETCODE_OK == retval) ? rc : retval;
+}
+
+/*  The description of the function is available in Kiso_EventHub.h */
+Retcode_T EventHub_Observe(EventHub_T *hub, EventHandler_T handler, TaskEvent_T event)
+{
+    return EventHub_AddObserver(hub, handler, event, false, NULL, false);
+}
+
 /*  The description of the function is available in Kiso_EventHub.h */
 Retcode_T EventHub_ObserveAll(EventHub_T *hub, EventHandler_T handler)
 {
-    Retcode_T retval = RETCODE_OK;
+    return EventHub_AddObserver(hub, handler, 0, true, NULL, false);
+}
 
-    if (NULL == hub || NULL == handler)
+#if KISO_FEATURE_CMDPROCESSOR
+
+/*  The description of the function is available in Kiso_EventHub.h */
+Retcode_T EventHub_ObserveAsync(EventHub_T *hub, EventHandler_T handler, TaskEvent_T event, CmdProcessor_T *cmdProcessor, bool isCoalesced)
+{
+    if (NULL == cmdProcessor)
     {
         return RETCODE(RETCODE_SEVERITY_ERROR, (Retcode_T)RETCODE_NULL_POINTER);
     }
+    return EventHub_AddObserver(hub, handler, event, false, cmdProcessor, isCoalesced);
+}
 
-    if (NULL == hub->lock)
+/*  The description of the function is available in Kiso_EventHub.h */
+Retcode_T EventHub_ObserveAllAsync(EventHub_T *hub, EventHandler_T handler, CmdProcessor_T *cmdProcessor, bool isCoalesced)
+{
+    if (NULL == cmdProcessor)
     {
-        return RETCODE(RETCODE_SEVERITY_ERROR, (Retcode_T)RETCODE_UNINITIALIZED);
+        return RETCODE(RETCODE_SEVERITY_ERROR, (Retcode_T)RETCODE_NULL_POINTER);
     }
+    return EventHub_AddObserver(hub, handler, 0, true, cmdProcessor, isCoalesced);
+}
 
-    if (pdPASS != xSemaphoreTake((SemaphoreHandle_t)hub->lock, portMAX_DELAY))
+/*  The description of the function is available in Kiso_EventHub.h */
+Retcode_T EventHub_GetAsyncStatistics(EventHub_T *hub, EventHubAsyncStatistics_T *statistics, bool isReset)
+{
+    uint32_t count = 0;
+
+    if (NULL == hub || NULL == statistics)
     {
-        return RETCODE(RETCODE_SEVERITY_ERROR, (Retcode_T)RETCODE_SEMAPHORE_ERROR);
+        return RETCODE(RETCODE_SEVERITY_ERROR, (Retcode_T)RETCODE_NULL_POINTER);
     }
 
-    if (CONFIG_EVENTHUB_MAX_OBSERVERS == hub->observerCount)
+    (void)HAL_CriticalSection_Enter(&count);
+    *statistics = hub->asyncStatistics;
+    if (isReset)
     {
-        retval = RETCODE(RETCODE_SEVERITY_ERROR, (Retcode_T)RETCODE_OUT_OF_RESOURCES);
+        uint8_t depth = hub->asyncStatistics.depth;
+        memset(&hub->asyncStatistics, 0, sizeof(hub->asyncStatistics));
+        hub->asyncStatistics.depth = depth;
+        hub->asyncStatistics.depthMax = depth;
     }
+    (void)HAL_CriticalSection_Leave(&count);
 
-    if (retval == RETCODE_OK)
+    return RETCODE_OK;
+}
+
+#endif /* if KISO_FEATURE_CMDPROCESSOR */
+
+/*  The description of the function is available in Kiso_EventHub.h */
+Retcode_T EventHub_Notify(EventHub_T *hub, TaskEvent_T event, const void *data)
+{
+    if (NULL == hub)
     {
-        hub->observers[hub->observerCount].allEvents = true;
-        hub->observers[hub->observerCount].handler = handler;
-        hub->observerCount++;
+        return RETCODE(RETCODE_SEVERITY_ERROR, (Retcode_T)RETCODE_NULL_POINTER);
     }
 
-    if (pdPASS != xSemaphoreGive((SemaphoreHandle_t)hub->lock))
+    if (NULL == hub->lock)
     {
-        return RETCODE(RETCODE_SEVERITY_ERROR, (Retcode_T)RETCODE_SEMAPHORE_ERROR);
+        return RETCODE(RETCODE_SEVERITY_ERROR, (Retcode_T)RETCODE_UNINITIALIZED);
     }
 
-    return retval;
+    return EventHub_Deliver(hub, event, data);
+}
+
+#if configUSE_TIMERS
+
+/* Runs in the timer service task, delivers the notifications queued by interrupts */
+static void EventHub_DeliverDeferred(void *param, uint32_t unused)
+{
+    KISO_UNUSED(unused);
+    EventHub_T *hub = (EventHub_T *)param;
+    uint32_t count = 0;
+
+    for (;;)
+    {
+        EventDeferred_T deferred;
+
+        (void)HAL_CriticalSection_Enter(&count);
+        if (0 == hub->deferredCount)
+        {
+            hub->isDeliveryPending = false;
+            (void)HAL_CriticalSection_Leave(&count);
+            break;
+        }
+        deferred = hub->deferred[hub->deferredHead];
+        hub->deferredHead = (uint8_t)((hub->deferredHead + 1U) % CONFIG_EVENTHUB_ISR_QUEUE_SIZE);
+        hub->deferredCount--;
+        (void)HAL_CriticalSection_Leave(&count);
+
+        /* Lost asynchronous deliveries are counted in the statistics */
+        (void)EventHub_Deliver(hub, deferred.event, deferred.data);
+    }
 }
 
 /*  The description of the function is available in Kiso_EventHub.h */
-Retcode_T EventHub_Notify(EventHub_T *hub, TaskEvent_T event, const void *data)
+Retcode_T EventHub_NotifyFromIsr(EventHub_T *hub, TaskEvent_T event, const void *data)
 {
+    Retcode_T retval = RETCODE_OK;
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    uint32_t count = 0;
+    bool isPendRequired = false;
+
     if (NULL == hub)
     {
         return RETCODE(RETCODE_SEVERITY_ERROR, (Retcode_T)RETCODE_NULL_POINTER);
@@ -158,29 +430,53 @@ Retcode_T EventHub_Notify(EventHub_T *hub, TaskEvent_T event, const void *data)
         return RETCODE(RETCODE_SEVERITY_ERROR, (Retcode_T)RETCODE_UNINITIALIZED);
     }
 
-    if (pdPASS != xSemaphoreTake((SemaphoreHandle_t)hub->lock, portMAX_DELAY))
+    /* Interrupts of a higher priority may notify the same hub */
+    (void)HAL_CriticalSection_Enter(&count);
+    if (CONFIG_EVENTHUB_ISR_QUEUE_SIZE == hub->deferredCount)
     {
-        return RETCODE(RETCODE_SEVERITY_ERROR, (Retcode_T)RETCODE_SEMAPHORE_ERROR);
+        retval = RETCODE(RETCODE_SEVERITY_ERROR, (Retcode_T)RETCODE_OUT_OF_RESOURCES);
     }
+    else
+    {
+        EventDeferred_T *deferred = &hub->deferred[(hub->deferredHead + hub->deferredCount) % CONFIG_EVENTHUB_ISR_QUEUE_SIZE];
+        deferred->event = event;
+        deferred->data = data;
+        hub->deferredCount++;
+        isPendRequired = !hub->isDeliveryPending;
+        hub->isDeliveryPending = true;
+    }
+    (void)HAL_CriticalSection_Leave(&count);
 
-    uint32_t i;
-    for (i = 0; i < hub->observerCount; i++)
+    /* One pending delivery empties the whole queue */
+    if (isPendRequired)
     {
-        if (NULL != hub->observers[i].handler)
+        if (pdPASS == xTimerPendFunctionCallFromISR(EventHub_DeliverDeferred, hub, 0, &higherPriorityTaskWoken))
         {
-            if (hub->observers[i].allEvents || event == hub->observers[i].event)
-            {
-                hub->observers[i].handler(event, data);
-            }
+            portYIELD_FROM_ISR(higherPriorityTaskWoken);
+        }
+        else
+        {
+            (void)HAL_CriticalSection_Enter(&count);
+            hub->isDeliveryPending = false;
+            (void)HAL_CriticalSection_Leave(&count);
+            retval = RETCODE(RETCODE_SEVERITY_ERROR, (Retcode_T)RETCODE_FAILURE);
         }
     }
 
-    if (pdPASS != xSemaphoreGive((SemaphoreHandle_t)hub->lock))
-    {
-        return RETCODE(RETCODE_SEVERITY_ERROR, (Retcode_T)RETCODE_SEMAPHORE_ERROR);
-    }
+    return retval;
+}
 
-    return RETCODE_OK;
+#else
+
+/*  The description of the function is available in Kiso_EventHub.h */
+Retcode_T EventHub_NotifyFromIsr(EventHub_T *hub, TaskEvent_T event, const void *data)
+{
+    KISO_UNUSED(hub);
+    KISO_UNUSED(event);
+    KISO_UNUSED(data);
+    return RETCODE(RETCODE_SEVERITY_ERROR, (Retcode_T)RETCODE_NOT_SUPPORTED);
 }
 
+#endif /* if configUSE_TIMERS */
+
 #endif /* if KISO_FEATURE_EVENTHUB */
@@ -59,6 +59,16 @@ static void GuardedTaskRunFunction(void *param);
 /* Local functions */
 static void GuardedTaskExecute(GuardedTask_T *context)
 {
+#if KISO_UTILS_TASK_NOTIFICATIONS
+    if ((NULL != context) && (NULL != context->runFunction))
+    {
+        /* Wait for the notification value to be incremented. A wake-up which leaves it at zero
+         * was meant for a transceiver the run function waited for, and is ignored. */
+        if (0UL == ulTaskNotifyTake(pdTRUE, portMAX_DELAY))
+        {
+            return;
+        }
+#else
     if ((NULL != context) && (NULL != context->runFunction) && (NULL != context->signal))
     {
         /* Wait for the "run"-semaphore to be signaled. */
@@ -68,6 +78,7 @@ static void GuardedTaskExecute(GuardedTask_T *context)
             Retcode_RaiseError(RETCODE(RETCODE_SEVERITY_FATAL, (uint32_t)RETCODE_GUARDEDTASK_SEMAPHORE_ERROR));
             return;
         }
+#endif
 
         context->runFunction();
     }
@@ -101,11 +112,13 @@ Retcode_T GuardedTask_Deinitialize(GuardedTask_T *handle)
             handle->task = NULL;
         }
 
+#if !KISO_UTILS_TASK_NOTIFICATIONS
         if (NULL != handle->signal)
         {
             vSemaphoreDelete(handle->signal);
             handle->signal = NULL;
         }
+#endif
 
         handle->runFunction = NULL;
 
@@ -119,6 +132,7 @@ Retcode_T GuardedTask_Deinitialize(GuardedTask_T *handle)
     return retcode;
 }
 
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
 /*  The description of the function is available in Kiso_GuardedTask.h */
 Retcode_T GuardedTask_Initialize(GuardedTask_T *handle, GuardedTask_Function_T taskRunFunction, const char *taskName, uint32_t taskPriority, uint32_t taskStackSize)
 {
@@ -128,11 +142,13 @@ Retcode_T GuardedTask_Initialize(GuardedTask_T *handle, GuardedTask_Function_T t
     {
         handle->runFunction = taskRunFunction;
 
+#if !KISO_UTILS_TASK_NOTIFICATIONS
         handle->signal = xSemaphoreCreateBinary();
         if (handle->signal == NULL)
         {
             retcode = RETCODE(RETCODE_SEVERITY_ERROR, (uint32_t)RETCODE_OUT_OF_RESOURCES);
         }
+#endif
 
         if (RETCODE_OK == retcode)
         {
@@ -142,6 +158,7 @@ Retcode_T GuardedTask_Initialize(GuardedTask_T *handle, GuardedTask_Function_T t
             }
         }
 
+#if !KISO_UTILS_TASK_NOTIFICATIONS
         if (RETCODE_OK != retcode)
         {
             if (NULL != handle->signal)
@@ -150,6 +167,7 @@ Retcode_T GuardedTask_Initialize(GuardedTask_T *handle, GuardedTask_Function_T t
                 handle->signal = NULL;
             }
         }
+#endif
     }
     else
     {
@@ -158,15 +176,45 @@ Retcode_T GuardedTask_Initialize(GuardedTask_T *handle, GuardedTask_Function_T t
 
     return retcode;
 }
+#endif /* if (configSUPPORT_DYNAMIC_ALLOCATION == 1) */
+
+#if KISO_UTILS_STATIC_ALLOCATION
+/*  The description of the function is available in Kiso_GuardedTask.h */
+Retcode_T GuardedTask_InitializeStatic(GuardedTask_T *handle, GuardedTask_Function_T taskRunFunction, const char *taskName, uint32_t taskPriority, uint32_t taskStackSize,
+                                       StackType_t *taskStack, GuardedTask_Storage_T *storage)
+{
+    if ((NULL == handle) || (NULL == taskRunFunction) || (NULL == taskName) || (NULL == taskStack) || (NULL == storage))
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, (uint32_t)RETCODE_INVALID_PARAM);
+    }
+
+    /* Creating objects in given storage does not fail */
+    handle->runFunction = taskRunFunction;
+#if !KISO_UTILS_TASK_NOTIFICATIONS
+    handle->signal = xSemaphoreCreateBinaryStatic(&storage->signal);
+#endif
+    handle->task = xTaskCreateStatic(GuardedTaskRunFunction, taskName, taskStackSize, handle, taskPriority, taskStack, &storage->task);
+
+    return RETCODE_OK;
+}
+#endif /* if KISO_UTILS_STATIC_ALLOCATION */
 
 /*  The description of the function is available in Kiso_GuardedTask.h */
 Retcode_T GuardedTask_Signal(GuardedTask_T *handle)
 {
     Retcode_T retcode = RETCODE_OK;
 
+#if KISO_UTILS_TASK_NOTIFICATIONS
+    if ((NULL != handle) && (NULL != handle->task))
+    {
+        uint32_t previousValue = 0UL;
+        (void)xTaskNotifyAndQuery(handle->task, 0UL, eIncrement, &previousValue);
+        if (0UL == previousValue)
+#else
     if ((NULL != handle) && (NULL != handle->signal))
     {
         if (pdPASS == xSemaphoreGive(handle->signal))
+#endif
         {
             retcode = RETCODE_OK;
         }
@@ -191,6 +239,18 @@ Retcode_T GuardedTask_SignalFromIsr(GuardedTask_T *handle)
 {
     Retcode_T retcode = RETCODE_OK;
 
+#if KISO_UTILS_TASK_NOTIFICATIONS
+    if ((NULL != handle) && (NULL != handle->task))
+    {
+        BaseType_t higherPriorityTaskWoken = pdFALSE;
+        uint32_t previousValue = 0UL;
+        (void)xTaskNotifyAndQueryFromISR(handle->task, 0UL, eIncrement, &previousValue, &higherPriorityTaskWoken);
+        portYIELD_FROM_ISR(higherPriorityTaskWoken);
+        if (0UL == previousValue)
+        {
+            retcode = RETCODE_OK;
+        }
+#else
     if ((NULL != handle) && (NULL != handle->signal))
     {
         BaseType_t higherPriorityTaskWoken = pdFALSE;
@@ -200,6 +260,7 @@ Retcode_T GuardedTask_SignalFromIsr(GuardedTask_T *handle)
 
             retcode = RETCODE_OK;
         }
+#endif
         else
         {
             // The osRetcode will be pdFAIL if the internal queue interaction failed.
@@ -21,6 +21,7 @@
  *      This source file implements following features:
  *      - I2CTransceiver_LoopCallback()
  *      - I2CTransceiver_Init()
+ *      - I2CTransceiver_InitStatic()
  *      - I2CTransceiver_Read()
  *      - I2CTransceiver_Write()
  *      - I2CTransceiver_Deinit()
@@ -40,6 +41,7 @@
 
 /* FreeRTOS header files */
 #include "FreeRTOS.h"
+#include "task.h"
 #include "semphr.h"
 
 #if KISO_FEATURE_I2C
@@ -47,6 +49,49 @@
 #define CANCEL_I2C_TRANSMISSION UINT32_C(0)
 #define DATA_TRANSFER_TIMEOUT_MS UINT32_C(1000)
 
+#if KISO_UTILS_TASK_NOTIFICATIONS
+/* The end of a transfer is signaled to the waiting task directly, there is no semaphore to check */
+#define I2C_BUS_SYNC_MISSING(i2cTransceiver) (false)
+
+/* Signals the end of the transfer, from the loop callback */
+static void I2CTransceiverSignalFromIsr(I2cTranceiverHandlePtr_T i2cTransceiver, BaseType_t *higherPriorityTaskWoken)
+{
+    TaskHandle_t waitingTask;
+
+    __atomic_store_n(&i2cTransceiver->I2CTransferDone, true, __ATOMIC_SEQ_CST);
+    waitingTask = (TaskHandle_t)__atomic_load_n(&i2cTransceiver->I2CWaitingTask, __ATOMIC_SEQ_CST);
+    if (NULL != waitingTask)
+    {
+        /* Only wakes the task, its notification value may belong to someone else (e.g. GuardedTask) */
+        (void)xTaskNotifyFromISR(waitingTask, 0UL, eNoAction, higherPriorityTaskWoken);
+    }
+}
+
+/* Waits for the end of the transfer. Other notifications of the task only make it look at the flag again. */
+static bool I2CTransceiverWait(I2cTranceiverHandlePtr_T i2cTransceiver, TickType_t ticksToWait)
+{
+    TimeOut_t timeOut;
+    bool isDone;
+
+    vTaskSetTimeOutState(&timeOut);
+    __atomic_store_n(&i2cTransceiver->I2CWaitingTask, (void *)xTaskGetCurrentTaskHandle(), __ATOMIC_SEQ_CST);
+    for (;;)
+    {
+        isDone = __atomic_exchange_n(&i2cTransceiver->I2CTransferDone, false, __ATOMIC_SEQ_CST);
+        if (isDone || (pdTRUE == xTaskCheckForTimeOut(&timeOut, &ticksToWait)))
+        {
+            break;
+        }
+        (void)xTaskNotifyWait(0UL, 0UL, NULL, ticksToWait);
+    }
+    __atomic_store_n(&i2cTransceiver->I2CWaitingTask, NULL, __ATOMIC_SEQ_CST);
+
+    return isDone;
+}
+#else
+#define I2C_BUS_SYNC_MISSING(i2cTransceiver) (NULL == (i2cTransceiver)->I2CBusSync)
+#endif /* if KISO_UTILS_TASK_NOTIFICATIONS */
+
 /*  The description of the function is available in Kiso_I2CTransceiver.h */
 void I2CTransceiver_LoopCallback(I2cTranceiverHandlePtr_T i2cTransceiver, struct MCU_I2C_Event_S event)
 {
@@ -63,7 +108,7 @@ void I2CTransceiver_LoopCallback(I2cTranceiverHandlePtr_T i2cTransceiver, struct
         { /* Transciever is not initialized */
             retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_UNINITIALIZED);
         }
-        else if (NULL == i2cTransceiver->I2CBusSync)
+        else if (I2C_BUS_SYNC_MISSING(i2cTransceiver))
         { /* I2C Bus lock not present */
             retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
         }
@@ -81,6 +126,11 @@ void I2CTransceiver_LoopCallback(I2cTranceiverHandlePtr_T i2cTransceiver, struct
             i2cTransceiver->I2cTransferStatusFlag = INT8_C(-1); //  Error in I2C Transfer Flagged
             retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_I2CTRANSCEIVER_TRANSFER_ERROR);
         }
+#if KISO_UTILS_TASK_NOTIFICATIONS
+        /* Signal the waiting task even in case of transfer errors or Transfer completed */
+        I2CTransceiverSignalFromIsr(i2cTransceiver, &higherPriorityTaskWoken);
+        portYIELD_FROM_ISR(higherPriorityTaskWoken);
+#else
         /* Give Semaphore even in case of transfer errors or Transfer completed */
         if (pdTRUE == xSemaphoreGiveFromISR(i2cTransceiver->I2CBusSync, &higherPriorityTaskWoken))
         {
@@ -90,6 +140,7 @@ void I2CTransceiver_LoopCallback(I2cTranceiverHandlePtr_T i2cTransceiver, struct
         {
             /* Ignore... semaphore has already been given */
         }
+#endif
     }
     if (RETCODE_OK != retcode)
     {
@@ -97,8 +148,45 @@ void I2CTransceiver_LoopCallback(I2cTranceiverHandlePtr_T i2cTransceiver, struct
     }
 }
 
-/*  The description of the function is available in Kiso_I2CTransceiver.h */
-Retcode_T I2CTransceiver_Init(I2cTranceiverHandlePtr_T i2cTransceiver, I2C_T i2cHandle)
+/* Creates a mutex in the given storage, or on the FreeRTOS heap if it is NULL */
+static SemaphoreHandle_t I2CTransceiverCreateMutex(StaticSemaphore_t *buffer)
+{
+#if KISO_UTILS_STATIC_ALLOCATION
+    if (NULL != buffer)
+    {
+        return xSemaphoreCreateMutexStatic(buffer);
+    }
+#else
+    KISO_UNUSED(buffer);
+#endif
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+    return xSemaphoreCreateMutex();
+#else
+    return NULL;
+#endif
+}
+
+#if !KISO_UTILS_TASK_NOTIFICATIONS
+/* Creates a binary semaphore in the given storage, or on the FreeRTOS heap if it is NULL */
+static SemaphoreHandle_t I2CTransceiverCreateBinary(StaticSemaphore_t *buffer)
+{
+#if KISO_UTILS_STATIC_ALLOCATION
+    if (NULL != buffer)
+    {
+        return xSemaphoreCreateBinaryStatic(buffer);
+    }
+#else
+    KISO_UNUSED(buffer);
+#endif
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+    return xSemaphoreCreateBinary();
+#else
+    return NULL;
+#endif
+}
+#endif /* if !KISO_UTILS_TASK_NOTIFICATIONS */
+
+static Retcode_T I2CTransceiverInit(I2cTranceiverHandlePtr_T i2cTransceiver, I2C_T i2cHandle, StaticSemaphore_t *busSyncBuffer, StaticSemaphore_t *mutexBuffer)
 {
     Retcode_T retcode = RETCODE_OK;
     if ((NULL == i2cTransceiver) || (NULL == i2cHandle))
@@ -111,8 +199,22 @@ Retcode_T I2CTransceiver_Init(I2cTranceiverHandlePtr_T i2cTransceiver, I2C_T i2c
         {
 
             i2cTransceiver->I2CHandle = i2cHandle;
-            i2cTransceiver->I2CBusSync = xSemaphoreCreateBinary();
-            i2cTransceiver->I2CMutexLock = xSemaphoreCreateMutex();
+#if KISO_UTILS_TASK_NOTIFICATIONS
+            KISO_UNUSED(busSyncBuffer);
+            i2cTransceiver->I2CWaitingTask = NULL;
+            i2cTransceiver->I2CTransferDone = false;
+            i2cTransceiver->I2CMutexLock = I2CTransceiverCreateMutex(mutexBuffer);
+            if (NULL != i2cTransceiver->I2CMutexLock)
+            {
+                i2cTransceiver->InitializationStatus = true;
+            }
+            else
+            {
+                retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_OUT_OF_RESOURCES);
+            }
+#else
+            i2cTransceiver->I2CBusSync = I2CTransceiverCreateBinary(busSyncBuffer);
+            i2cTransceiver->I2CMutexLock = I2CTransceiverCreateMutex(mutexBuffer);
             if ((NULL != i2cTransceiver->I2CBusSync) && (NULL != i2cTransceiver->I2CMutexLock))
             {
                 i2cTransceiver->InitializationStatus = true;
@@ -131,6 +233,7 @@ Retcode_T I2CTransceiver_Init(I2cTranceiverHandlePtr_T i2cTransceiver, I2C_T i2c
             {
                 retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_OUT_OF_RESOURCES);
             }
+#endif /* if KISO_UTILS_TASK_NOTIFICATIONS */
         }
         else
         {
@@ -141,6 +244,30 @@ Retcode_T I2CTransceiver_Init(I2cTranceiverHandlePtr_T i2cTransceiver, I2C_T i2c
     return retcode;
 }
 
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+/*  The description of the function is available in Kiso_I2CTransceiver.h */
+Retcode_T I2CTransceiver_Init(I2cTranceiverHandlePtr_T i2cTransceiver, I2C_T i2cHandle)
+{
+    return I2CTransceiverInit(i2cTransceiver, i2cHandle, NULL, NULL);
+}
+#endif
+
+#if KISO_UTILS_STATIC_ALLOCATION
+/*  The description of the function is available in Kiso_I2CTransceiver.h */
+Retcode_T I2CTransceiver_InitStatic(I2cTranceiverHandlePtr_T i2cTransceiver, I2C_T i2cHandle, I2cTranceiverStorage_T *storage)
+{
+    if (NULL == storage)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+    }
+#if KISO_UTILS_TASK_NOTIFICATIONS
+    return I2CTransceiverInit(i2cTransceiver, i2cHandle, NULL, &storage->I2CMutexLock);
+#else
+    return I2CTransceiverInit(i2cTransceiver, i2cHandle, &storage->I2CBusSync, &storage->I2CMutexLock);
+#endif
+}
+#endif
+
 /*  The description of the function is available in Kiso_I2CTransceiver.h */
 Retcode_T I2CTransceiver_Read(I2cTranceiverHandlePtr_T i2cTransceiver, uint8_t i2cAddr, uint8_t regAddr, uint8_t *buffer, uint8_t bytesToRead)
 {
@@ -151,7 +278,7 @@ Retcode_T I2CTransceiver_Read(I2cTranceiverHandlePtr_T i2cTransceiver, uint8_t i
         return (RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INVALID_PARAM));
     }
 
-    if ((NULL == i2cTransceiver) || (NULL == buffer) || (NULL == i2cTransceiver->I2CBusSync) || (NULL == i2cTransceiver->I2CMutexLock) || (NULL == i2cTransceiver->I2CHandle))
+    if ((NULL == i2cTransceiver) || (NULL == buffer) || I2C_BUS_SYNC_MISSING(i2cTransceiver) || (NULL == i2cTransceiver->I2CMutexLock) || (NULL == i2cTransceiver->I2CHandle))
     {
         return (RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER));
     }
@@ -164,10 +291,17 @@ Retcode_T I2CTransceiver_Read(I2cTranceiverHandlePtr_T i2cTransceiver, uint8_t i
     {
         return (RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SEMAPHORE_ERROR));
     }
+#if KISO_UTILS_TASK_NOTIFICATIONS
+    i2cTransceiver->I2CTransferDone = false;
+#endif
     retcode = MCU_I2C_ReadRegister(i2cTransceiver->I2CHandle, (uint16_t)i2cAddr, regAddr, buffer, bytesToRead);
     if (RETCODE_OK == retcode)
     {
+#if KISO_UTILS_TASK_NOTIFICATIONS
+        if (!I2CTransceiverWait(i2cTransceiver, (TickType_t)pdMS_TO_TICKS(DATA_TRANSFER_TIMEOUT_MS)))
+#else
         if (pdTRUE != xSemaphoreTake(i2cTransceiver->I2CBusSync, (TickType_t)pdMS_TO_TICKS(DATA_TRANSFER_TIMEOUT_MS)))
+#endif
         {
             /* Since the I2C transfer time out happened, Abort an ongoing I2C transmission.*/
             retcode = MCU_I2C_Send(i2cTransceiver->I2CHandle, (uint16_t)i2cAddr, buffer, CANCEL_I2C_TRANSMISSION);
@@ -201,7 +335,7 @@ Retcode_T I2CTransceiver_Write(I2cTranceiverHandlePtr_T i2cTransceiver, uint8_t
         return (RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INVALID_PARAM));
     }
 
-    if ((NULL == i2cTransceiver) || (NULL == buffer) || (NULL == i2cTransceiver->I2CBusSync) || (NULL == i2cTransceiver->I2CMutexLock) || (NULL == i2cTransceiver->I2CHandle))
+    if ((NULL == i2cTransceiver) || (NULL == buffer) || I2C_BUS_SYNC_MISSING(i2cTransceiver) || (NULL == i2cTransceiver->I2CMutexLock) || (NULL == i2cTransceiver->I2CHandle))
     {
         return (RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER));
     }
@@ -214,10 +348,17 @@ Retcode_T I2CTransceiver_Write(I2cTranceiverHandlePtr_T i2cTransceiver, uint8_t
     {
         return (RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SEMAPHORE_ERROR));
     }
+#if KISO_UTILS_TASK_NOTIFICATIONS
+    i2cTransceiver->I2CTransferDone = false;
+#endif
     retcode = MCU_I2C_WriteRegister(i2cTransceiver->I2CHandle, (uint16_t)i2cAddr, regAddr, buffer, bytesToWrite);
     if (RETCODE_OK == retcode)
     {
+#if KISO_UTILS_TASK_NOTIFICATIONS
+        if (!I2CTransceiverWait(i2cTransceiver, (TickType_t)pdMS_TO_TICKS(DATA_TRANSFER_TIMEOUT_MS)))
+#else
         if (pdTRUE != xSemaphoreTake(i2cTransceiver->I2CBusSync, (TickType_t)pdMS_TO_TICKS(DATA_TRANSFER_TIMEOUT_MS)))
+#endif
         {
             /* Since the I2C transfer time out happened, Abort an ongoing I2C transmission.*/
             retcode = MCU_I2C_Send(i2cTransceiver->I2CHandle, (uint16_t)i2cAddr, buffer, CANCEL_I2C_TRANSMISSION);
@@ -247,7 +388,7 @@ Retcode_T I2CTransceiver_Deinit(I2cTranceiverHandlePtr_T i2cTransceiver)
 {
     Retcode_T retcode = RETCODE_OK;
 
-    if ((NULL == i2cTransceiver) || (NULL == i2cTransceiver->I2CBusSync) || (NULL == i2cTransceiver->I2CMutexLock) || (NULL == i2cTransceiver->I2CHandle))
+    if ((NULL == i2cTransceiver) || I2C_BUS_SYNC_MISSING(i2cTransceiver) || (NULL == i2cTransceiver->I2CMutexLock) || (NULL == i2cTransceiver->I2CHandle))
     { /* Handle is not initialized */
         return (RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER));
     }
@@ -257,8 +398,10 @@ Retcode_T I2CTransceiver_Deinit(I2cTranceiverHandlePtr_T i2cTransceiver)
     }
 
     i2cTransceiver->I2CHandle = NULL;
+#if !KISO_UTILS_TASK_NOTIFICATIONS
     vSemaphoreDelete(i2cTransceiver->I2CBusSync);
     i2cTransceiver->I2CBusSync = NULL;
+#endif
     vSemaphoreDelete(i2cTransceiver->I2CMutexLock);
     i2cTransceiver->I2CMutexLock = NULL;
     i2cTransceiver->InitializationStatus = false;
@@ -24,6 +24,36 @@
  * 		- PipeAndFilter_CreateFilter()
  * 		- PipeAndFilter_FillPipe()
  * 		- PipeAndFilter_FillPipeFromISR()
+ * 		- RunBufferFilter()
+ * 		- PipeAndFilter_CreateMergePipe()
+ * 		- PipeAndFilter_SetPolicy()
+ * 		- PipeAndFilter_GetDropped()
+ * 		- PipeAndFilter_SetOutputPipes()
+ * 		- PipeAndFilter_CreateFusedFilter()
+ * 		- PipeAndFilter_SetBatchSize()
+ * 		- PipeAndFilter_GetStatistics()
+ * 		- PipeAndFilter_ResetStatistics()
+ * 		- PipeAndFilter_CreatePool()
+ * 		- PipeAndFilter_CreateBufferPipe()
+ * 		- PipeAndFilter_CreateBufferFilter()
+ * 		- PipeAndFilter_AllocateBuffer()
+ * 		- PipeAndFilter_AllocateBufferFromISR()
+ * 		- PipeAndFilter_ReleaseBuffer()
+ * 		- PipeAndFilter_FillBufferPipe()
+ * 		- PipeAndFilter_FillBufferPipeFromISR()
+ * 		- PipeAndFilter_CreatePipeStatic()
+ * 		- PipeAndFilter_CreateMergePipeStatic()
+ * 		- PipeAndFilter_CreateFilterStatic()
+ * 		- PipeAndFilter_CreateFusedFilterStatic()
+ * 		- PipeAndFilter_CreateBufferFilterStatic()
+ * 		- PipeAndFilter_CreateBufferPipeStatic()
+ * 		- PipeAndFilter_CreatePoolStatic()
+ *
+ * 		A buffer pipe and the free buffers of a pool are queues of buffer pointers, so only the
+ * 		pointer is copied when a buffer changes hands.
+ *
+ * 		The creating functions take the storage of their FreeRTOS object, NULL creates it on the
+ * 		FreeRTOS heap instead.
  * 
  * @file
  **/
@@ -38,9 +68,14 @@
 
 #if KISO_FEATURE_PIPEANDFILTER
 
+#include <string.h>
+#include "Kiso_HAL.h"
+
 /* FreeRTOS header files */
 #include "FreeRTOS.h"
 #include "message_buffer.h"
+#include "queue.h"
+#include "semphr.h"
 #include "task.h"
 
 /* Will be used in unittest to be able to test the FreeRTOS task */
@@ -56,31 +91,165 @@
  */
 void RunFilter(void *pvParameters);
 
+/**
+ * @brief
+ * 		function that will be used as parameter for a freeRTOS task of a filter between buffer pipes.
+ * @param [in] void * pvParameters
+ * 		Will contain the pipe context to be executed in the FreeRTOS task.
+ */
+void RunBufferFilter(void *pvParameters);
+
+/* Writes a message to a byte pipe, a full pipe blocks the writer or drops the message */
+static Retcode_T SendMessage(PipeAndFilter_Pipe_T *pipe, uint8_t *xTxBuffer, uint32_t xToSendBytes)
+{
+    Retcode_T retcode = RETCODE_OK;
+    TickType_t xTicksToWait = (pipe->policy == PIPEANDFILTER_POLICY_BLOCK) ? portMAX_DELAY : 0;
+
+    // The writers of a merge pipe take turns
+    if (pipe->lockInternalHandle != NULL && pdTRUE != xSemaphoreTake((SemaphoreHandle_t)pipe->lockInternalHandle, portMAX_DELAY))
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SEMAPHORE_ERROR);
+    }
+
+    if (xMessageBufferSend((MessageBufferHandle_t)pipe->pipeInternalHandle, (void *)xTxBuffer, xToSendBytes, xTicksToWait) != xToSendBytes)
+    {
+        if (pipe->policy == PIPEANDFILTER_POLICY_BLOCK)
+        {
+            retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_OUT_OF_RESOURCES);
+        }
+        else
+        {
+            pipe->dropped++;
+        }
+    }
+
+    if (pipe->lockInternalHandle != NULL)
+    {
+        (void)xSemaphoreGive((SemaphoreHandle_t)pipe->lockInternalHandle);
+    }
+    return retcode;
+}
+
+/* Hands a reference to a buffer to a buffer pipe, the reference is released if the buffer does not get in */
+static Retcode_T SendBuffer(PipeAndFilter_Pipe_T *pipe, PipeAndFilter_Buffer_T *buffer)
+{
+    PipeAndFilter_Buffer_T *oldest = NULL;
+    TickType_t xTicksToWait = (pipe->policy == PIPEANDFILTER_POLICY_BLOCK) ? portMAX_DELAY : 0;
+    BaseType_t sent = xQueueSend((QueueHandle_t)pipe->pipeInternalHandle, (void *)&buffer, xTicksToWait);
+
+    // Make room, as long as there is something to drop; other writers may take it first
+    while (sent != pdPASS && pipe->policy == PIPEANDFILTER_POLICY_DROP_OLDEST && pdPASS == xQueueReceive((QueueHandle_t)pipe->pipeInternalHandle, (void *)&oldest, 0))
+    {
+        (void)PipeAndFilter_ReleaseBuffer(oldest);
+        (void)__atomic_fetch_add(&pipe->dropped, 1U, __ATOMIC_RELAXED);
+        sent = xQueueSend((QueueHandle_t)pipe->pipeInternalHandle, (void *)&buffer, 0);
+    }
+    if (sent == pdPASS)
+    {
+        return RETCODE_OK;
+    }
+
+    (void)PipeAndFilter_ReleaseBuffer(buffer);
+    if (pipe->policy == PIPEANDFILTER_POLICY_BLOCK)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_OUT_OF_RESOURCES);
+    }
+    (void)__atomic_fetch_add(&pipe->dropped, 1U, __ATOMIC_RELAXED);
+    return RETCODE_OK;
+}
+
+/* Keeps the most bytes or buffers seen waiting in the input pipe */
+static void UpdateHighWater(PipeAndFilter_Statistics_T *statistics, uint32_t waiting)
+{
+    if (waiting > statistics->pipeInHighWater)
+    {
+        statistics->pipeInHighWater = waiting;
+    }
+}
+
+/* Runs the stages of a filter on a message, the two buffers take turns as input and output of a stage */
+static Retcode_T RunStages(PipeAndFilter_Filter_T *filterContext, uint8_t *xRxBuffer, uint32_t xReceivedBytes, uint8_t *xTxBuffer, uint8_t **xToSend, uint32_t *xToSendBytes)
+{
+    Retcode_T retcode = RETCODE_OK;
+    uint8_t *xIn = xRxBuffer;
+    uint8_t *xOut = xTxBuffer;
+    uint32_t xInBytes = xReceivedBytes;
+    uint32_t xOutBytes = 0;
+
+    *xToSend = NULL;
+    *xToSendBytes = 0;
+    for (uint32_t i = 0; i < filterContext->stageCount; i++)
+    {
+        PipeAndFilter_Statistics_T *statistics = &filterContext->stages[i].statistics;
+
+        statistics->messagesIn++;
+        statistics->bytesIn += xInBytes;
+        xOutBytes = 0;
+        retcode = filterContext->stages[i].filterFunction(xIn, xInBytes, xOut, &xOutBytes);
+
+        // Check stage output
+        if (xOutBytes > PIPE_SIZE)
+        {
+            retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_OUT_OF_RESOURCES);
+        }
+        if (retcode != RETCODE_OK)
+        {
+            statistics->errors++;
+            break;
+        }
+        if (xOutBytes == 0)
+        {
+            // Nothing to pass on
+            break;
+        }
+        if (i + 1 == filterContext->stageCount)
+        {
+            // The last stage counts its output once it is sent
+            *xToSend = xOut;
+            *xToSendBytes = xOutBytes;
+        }
+        else
+        {
+            statistics->messagesOut++;
+            statistics->bytesOut += xOutBytes;
+            xIn = xOut;
+            xOut = (xOut == xTxBuffer) ? xRxBuffer : xTxBuffer;
+            xInBytes = xOutBytes;
+        }
+    }
+    return retcode;
+}
+
 void RunFilter(void *pvParameters)
 {
     Retcode_T retcode = RETCODE_OK;
     size_t xReceivedBytes = 0;
+    uint8_t *xToSend = NULL;
     uint32_t xToSendBytes = 0;
-    size_t xSendBytes = 0;
+    uint32_t xBatchCount = 0;
     uint8_t xRxBuffer[PIPE_SIZE] = {0};
     uint8_t xTxBuffer[PIPE_SIZE] = {0};
+    PipeAndFilter_Statistics_T *firstStatistics = NULL;
+    PipeAndFilter_Statistics_T *lastStatistics = NULL;
 
     PipeAndFilter_Filter_T *filterContext = (PipeAndFilter_Filter_T *)(pvParameters);
 
-    if (filterContext == NULL || filterContext->filterFunction == NULL)
+    if (filterContext == NULL || filterContext->filterFunction == NULL || filterContext->stages == NULL || filterContext->stageCount == 0)
     {
         // NULL parameters was given!
         retcode = RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_NULL_POINTER);
         Retcode_RaiseError(retcode);
         return;
     }
+    firstStatistics = &filterContext->stages[0].statistics;
+    lastStatistics = &filterContext->stages[filterContext->stageCount - 1].statistics;
 
     do
     {
         // Clean variables
         retcode = RETCODE_OK;
         xReceivedBytes = 0;
-        xToSendBytes = 0;
+        xBatchCount = 0;
 
         // Get input if exist
         if (filterContext->pipeInHandle != NULL)
@@ -91,29 +260,163 @@ void RunFilter(void *pvParameters)
             {
                 retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_OUT_OF_RESOURCES);
             }
+            else
+            {
+                UpdateHighWater(firstStatistics, PIPE_SIZE - xMessageBufferSpaceAvailable((MessageBufferHandle_t)filterContext->pipeInHandle->pipeInternalHandle) + xReceivedBytes);
+            }
         }
+        firstStatistics->activations++;
 
-        // Process input
-        if (retcode == RETCODE_OK)
+        // Process the input and the messages waiting behind it, up to the batch size
+        while (retcode == RETCODE_OK)
         {
-            retcode = filterContext->filterFunction(xRxBuffer, xReceivedBytes, xTxBuffer, &xToSendBytes);
+            retcode = RunStages(filterContext, xRxBuffer, xReceivedBytes, xTxBuffer, &xToSend, &xToSendBytes);
+
+            // Send output, a copy to each output pipe
+            if (xToSendBytes != 0 && retcode == RETCODE_OK)
+            {
+                for (uint32_t i = 0; i < filterContext->pipeOutCount; i++)
+                {
+                    Retcode_T sendRetcode = SendMessage(filterContext->pipeOutHandles[i], xToSend, xToSendBytes);
+                    retcode = (retcode == RETCODE_OK) ? sendRetcode : retcode;
+                }
+                if (retcode != RETCODE_OK)
+                {
+                    lastStatistics->errors++;
+                }
+                else
+                {
+                    lastStatistics->messagesOut++;
+                    lastStatistics->bytesOut += xToSendBytes;
+                }
+            }
+
+            // Get the next message of the batch without waiting
+            xBatchCount++;
+            if (retcode != RETCODE_OK || filterContext->pipeInHandle == NULL || xBatchCount >= filterContext->batchSize)
+            {
+                break;
+            }
+            xReceivedBytes = xMessageBufferReceive((MessageBufferHandle_t)filterContext->pipeInHandle->pipeInternalHandle, (void *)xRxBuffer, PIPE_SIZE, 0);
+            if (xReceivedBytes == 0)
+            {
+                break;
+            }
         }
 
-        // Check filter output
-        if (xToSendBytes > PIPE_SIZE)
+        // Raise error if occurred
+        if (retcode != RETCODE_OK)
         {
-            retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_OUT_OF_RESOURCES);
+            Retcode_RaiseError(retcode);
         }
+    } while (RUN_FILTER_ALWAYS);
+}
+
+void RunBufferFilter(void *pvParameters)
+{
+    Retcode_T retcode = RETCODE_OK;
+    PipeAndFilter_Buffer_T *bufferIn = NULL;
+    PipeAndFilter_Buffer_T *bufferOut = NULL;
+    uint32_t xBatchCount = 0;
+    PipeAndFilter_Statistics_T *statistics = NULL;
+
+    PipeAndFilter_Filter_T *filterContext = (PipeAndFilter_Filter_T *)(pvParameters);
+
+    if (filterContext == NULL || filterContext->bufferFilterFunction == NULL || filterContext->stages == NULL)
+    {
+        // NULL parameters was given!
+        retcode = RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_NULL_POINTER);
+        Retcode_RaiseError(retcode);
+        return;
+    }
+    statistics = &filterContext->stages[0].statistics;
 
-        // Send output
-        if (filterContext->pipeOutHandle != NULL && xToSendBytes != 0 && retcode == RETCODE_OK)
+    do
+    {
+        // Clean variables
+        retcode = RETCODE_OK;
+        bufferIn = NULL;
+        xBatchCount = 0;
+
+        // Get input if exist
+        if (filterContext->pipeInHandle != NULL)
         {
-            xSendBytes = xMessageBufferSend((MessageBufferHandle_t)filterContext->pipeOutHandle->pipeInternalHandle, (void *)xTxBuffer, xToSendBytes, portMAX_DELAY);
+            if (pdPASS != xQueueReceive((QueueHandle_t)filterContext->pipeInHandle->pipeInternalHandle, (void *)&bufferIn, portMAX_DELAY))
+            {
+                retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_OUT_OF_RESOURCES);
+            }
+            else
+            {
+                UpdateHighWater(statistics, (uint32_t)uxQueueMessagesWaiting((QueueHandle_t)filterContext->pipeInHandle->pipeInternalHandle) + 1U);
+            }
+        }
+        statistics->activations++;
+
+        // Process the input and the buffers waiting behind it, up to the batch size
+        while (retcode == RETCODE_OK)
+        {
+            // Process input, in place unless the filter hands on another buffer
+            statistics->messagesIn++;
+            statistics->bytesIn += (bufferIn != NULL) ? bufferIn->length : 0U;
+            bufferOut = bufferIn;
+            retcode = filterContext->bufferFilterFunction(bufferIn, &bufferOut);
+            if (bufferIn != NULL && bufferIn != bufferOut)
+            {
+                (void)PipeAndFilter_ReleaseBuffer(bufferIn);
+            }
 
-            if (xSendBytes != xToSendBytes)
+            // Check filter output
+            if (bufferOut != NULL && retcode == RETCODE_OK && bufferOut->length > bufferOut->size)
             {
                 retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_OUT_OF_RESOURCES);
             }
+
+            // Send output, each output pipe owns a reference to it from now on
+            if (bufferOut != NULL && retcode == RETCODE_OK && filterContext->pipeOutCount != 0)
+            {
+                uint32_t xLength = bufferOut->length;
+                if (filterContext->pipeOutCount > 1)
+                {
+                    (void)__atomic_fetch_add(&bufferOut->references, filterContext->pipeOutCount - 1U, __ATOMIC_RELAXED);
+                }
+                for (uint32_t i = 0; i < filterContext->pipeOutCount; i++)
+                {
+                    Retcode_T sendRetcode = SendBuffer(filterContext->pipeOutHandles[i], bufferOut);
+                    retcode = (retcode == RETCODE_OK) ? sendRetcode : retcode;
+                }
+                bufferOut = NULL;
+                if (retcode == RETCODE_OK)
+                {
+                    statistics->messagesOut++;
+                    statistics->bytesOut += xLength;
+                }
+            }
+            if (bufferOut != NULL)
+            {
+                if (retcode == RETCODE_OK)
+                {
+                    // A sink passes its output on to nobody
+                    statistics->messagesOut++;
+                    statistics->bytesOut += bufferOut->length;
+                }
+                (void)PipeAndFilter_ReleaseBuffer(bufferOut);
+            }
+            if (retcode != RETCODE_OK)
+            {
+                statistics->errors++;
+            }
+
+            // Get the next buffer of the batch without waiting
+            xBatchCount++;
+            bufferIn = NULL;
+            if (retcode != RETCODE_OK || filterContext->pipeInHandle == NULL || xBatchCount >= filterContext->batchSize)
+            {
+                break;
+            }
+            if (pdPASS != xQueueReceive((QueueHandle_t)filterContext->pipeInHandle->pipeInternalHandle, (void *)&bufferIn, 0))
+            {
+                break;
+            }
         }
 
         // Raise error if occurred
@@ -124,14 +427,87 @@ void RunFilter(void *pvParameters)
     } while (RUN_FILTER_ALWAYS);
 }
 
-/*  The description of the function is available in Kiso_PipeAndFilter.h */
-Retcode_T PipeAndFilter_CreatePipe(PipeAndFilter_Pipe_T *pipeHandle)
+static MessageBufferHandle_t CreateMessageBuffer(uint8_t *memory, StaticMessageBuffer_t *buffer)
+{
+#if KISO_UTILS_STATIC_ALLOCATION
+    if (buffer != NULL)
+    {
+        return xMessageBufferCreateStatic((size_t)PIPE_SIZE, memory, buffer);
+    }
+#else
+    KISO_UNUSED(memory);
+    KISO_UNUSED(buffer);
+#endif
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+    return xMessageBufferCreate((size_t)PIPE_SIZE);
+#else
+    return NULL;
+#endif
+}
+
+static SemaphoreHandle_t CreateMutex(StaticSemaphore_t *buffer)
+{
+#if KISO_UTILS_STATIC_ALLOCATION
+    if (buffer != NULL)
+    {
+        return xSemaphoreCreateMutexStatic(buffer);
+    }
+#else
+    KISO_UNUSED(buffer);
+#endif
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+    return xSemaphoreCreateMutex();
+#else
+    return NULL;
+#endif
+}
+
+/* The queue holds pointers to buffers only */
+static QueueHandle_t CreateBufferQueue(uint32_t length, PipeAndFilter_Buffer_T **memory, StaticQueue_t *buffer)
+{
+#if KISO_UTILS_STATIC_ALLOCATION
+    if (buffer != NULL)
+    {
+        return xQueueCreateStatic(length, sizeof(PipeAndFilter_Buffer_T *), (uint8_t *)memory, buffer);
+    }
+#else
+    KISO_UNUSED(memory);
+    KISO_UNUSED(buffer);
+#endif
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+    return xQueueCreate(length, sizeof(PipeAndFilter_Buffer_T *));
+#else
+    return NULL;
+#endif
+}
+
+static TaskHandle_t CreateFilterTask(TaskFunction_t run, PipeAndFilter_Filter_T *filterHandle, StackType_t *stack, StaticTask_t *buffer)
+{
+#if KISO_UTILS_STATIC_ALLOCATION
+    if (buffer != NULL)
+    {
+        return xTaskCreateStatic(run, "Filter", FILTER_STACK_SIZE, filterHandle, FILTER_PRIORITY, stack, buffer);
+    }
+#else
+    KISO_UNUSED(stack);
+    KISO_UNUSED(buffer);
+#endif
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+    TaskHandle_t xHandle = NULL;
+    (void)xTaskCreate(run, "Filter", FILTER_STACK_SIZE, filterHandle, FILTER_PRIORITY, &xHandle);
+    return xHandle;
+#else
+    return NULL;
+#endif
+}
+
+static Retcode_T CreatePipe(PipeAndFilter_Pipe_T *pipeHandle, uint8_t *memory, StaticMessageBuffer_t *buffer)
 {
     Retcode_T retcode = RETCODE_OK;
     MessageBufferHandle_t xMessageBuffer;
 
     // Create stream-buffer
-    xMessageBuffer = xMessageBufferCreate((size_t)PIPE_SIZE);
+    xMessageBuffer = CreateMessageBuffer(memory, buffer);
 
     if (xMessageBuffer == NULL)
     {
@@ -141,11 +517,107 @@ Retcode_T PipeAndFilter_CreatePipe(PipeAndFilter_Pipe_T *pipeHandle)
     // Exit
     pipeHandle->pipeInternalHandle = (PipeAndFilter_PipeInternalHandle_T)xMessageBuffer;
     pipeHandle->filterInternalHandle = NULL;
+    pipeHandle->lockInternalHandle = NULL;
+    pipeHandle->policy = PIPEANDFILTER_POLICY_BLOCK;
+    pipeHandle->isBufferPipe = false;
+    pipeHandle->dropped = 0;
     return retcode;
 }
 
+static Retcode_T CreateMergePipe(PipeAndFilter_Pipe_T *pipeHandle, uint8_t *memory, StaticMessageBuffer_t *buffer, StaticSemaphore_t *lock)
+{
+    Retcode_T retcode = RETCODE_OK;
+    SemaphoreHandle_t xMutex;
+
+    if (pipeHandle == NULL)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+    }
+
+    retcode = CreatePipe(pipeHandle, memory, buffer);
+    if (retcode == RETCODE_OK)
+    {
+        xMutex = CreateMutex(lock);
+        if (xMutex == NULL)
+        {
+            vMessageBufferDelete((MessageBufferHandle_t)pipeHandle->pipeInternalHandle);
+            pipeHandle->pipeInternalHandle = NULL;
+            retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_OUT_OF_RESOURCES);
+        }
+        pipeHandle->lockInternalHandle = (PipeAndFilter_LockInternalHandle_T)xMutex;
+    }
+    return retcode;
+}
+
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
 /*  The description of the function is available in Kiso_PipeAndFilter.h */
-Retcode_T PipeAndFilter_CreateFilter(PipeAndFilter_FilterFunction_T filterFunction, PipeAndFilter_Pipe_T *pipeInHandle, PipeAndFilter_Pipe_T *pipeOutHandle, PipeAndFilter_Filter_T *filterHandle)
+Retcode_T PipeAndFilter_CreatePipe(PipeAndFilter_Pipe_T *pipeHandle)
+{
+    return CreatePipe(pipeHandle, NULL, NULL);
+}
+
+/*  The description of the function is available in Kiso_PipeAndFilter.h */
+Retcode_T PipeAndFilter_CreateMergePipe(PipeAndFilter_Pipe_T *pipeHandle)
+{
+    return CreateMergePipe(pipeHandle, NULL, NULL, NULL);
+}
+#endif /* if (configSUPPORT_DYNAMIC_ALLOCATION == 1) */
+
+#if KISO_UTILS_STATIC_ALLOCATION
+/*  The description of the function is available in Kiso_PipeAndFilter.h */
+Retcode_T PipeAndFilter_CreatePipeStatic(PipeAndFilter_Pipe_T *pipeHandle, PipeAndFilter_PipeStorage_T *storage)
+{
+    if (pipeHandle == NULL || storage == NULL)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+    }
+    return CreatePipe(pipeHandle, storage->memory, &storage->buffer);
+}
+
+/*  The description of the function is available in Kiso_PipeAndFilter.h */
+Retcode_T PipeAndFilter_CreateMergePipeStatic(PipeAndFilter_Pipe_T *pipeHandle, PipeAndFilter_PipeStorage_T *storage)
+{
+    if (storage == NULL)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+    }
+    return CreateMergePipe(pipeHandle, storage->memory, &storage->buffer, &storage->lock);
+}
+#endif /* if KISO_UTILS_STATIC_ALLOCATION */
+
+/*  The description of the function is available in Kiso_PipeAndFilter.h */
+Retcode_T PipeAndFilter_SetPolicy(PipeAndFilter_Pipe_T *pipeHandle, PipeAndFilter_Policy_T policy)
+{
+    if (pipeHandle == NULL)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+    }
+    if ((uint32_t)policy > (uint32_t)PIPEANDFILTER_POLICY_DROP_OLDEST)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INVALID_PARAM);
+    }
+    // Dropping the oldest message means reading the pipe, a message buffer takes one reader only
+    if (policy == PIPEANDFILTER_POLICY_DROP_OLDEST && !pipeHandle->isBufferPipe)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NOT_SUPPORTED);
+    }
+    pipeHandle->policy = policy;
+    return RETCODE_OK;
+}
+
+/*  The description of the function is available in Kiso_PipeAndFilter.h */
+uint32_t PipeAndFilter_GetDropped(const PipeAndFilter_Pipe_T *pipeHandle)
+{
+    if (pipeHandle == NULL)
+    {
+        return 0;
+    }
+    return __atomic_load_n(&pipeHandle->dropped, __ATOMIC_RELAXED);
+}
+
+/* Creates the task of a filter, which runs the given loop */
+static Retcode_T CreateFilter(TaskFunction_t run, PipeAndFilter_Pipe_T *pipeInHandle, PipeAndFilter_Pipe_T *pipeOutHandle, PipeAndFilter_Filter_T *filterHandle,
+                              StackType_t *stack, StaticTask_t *task)
 {
     Retcode_T retcode = RETCODE_OK;
     TaskHandle_t xHandle = NULL;
@@ -158,11 +630,17 @@ Retcode_T PipeAndFilter_CreateFilter(PipeAndFilter_FilterFunction_T filterFuncti
     else
     {
         // Fill filter internal structure
-        filterHandle->filterFunction = filterFunction;
         filterHandle->pipeInHandle = pipeInHandle;
         filterHandle->pipeOutHandle = pipeOutHandle;
+        filterHandle->pipeOutHandles = &filterHandle->pipeOutHandle;
+        filterHandle->pipeOutCount = (pipeOutHandle != NULL) ? 1U : 0U;
+        filterHandle->batchSize = 1;
+        for (uint32_t i = 0; i < filterHandle->stageCount; i++)
+        {
+            memset(&filterHandle->stages[i].statistics, 0, sizeof(PipeAndFilter_Statistics_T));
+        }
 
-        (void)xTaskCreate(RunFilter, "Filter", FILTER_STACK_SIZE, filterHandle, FILTER_PRIORITY, &xHandle);
+        xHandle = CreateFilterTask(run, filterHandle, stack, task);
 
         if (xHandle == NULL)
         {
@@ -180,6 +658,360 @@ Retcode_T PipeAndFilter_CreateFilter(PipeAndFilter_FilterFunction_T filterFuncti
     return retcode;
 }
 
+static Retcode_T CreateSingleFilter(PipeAndFilter_FilterFunction_T filterFunction, PipeAndFilter_Pipe_T *pipeInHandle, PipeAndFilter_Pipe_T *pipeOutHandle, PipeAndFilter_Filter_T *filterHandle,
+                                    StackType_t *stack, StaticTask_t *task)
+{
+    if (filterHandle != NULL)
+    {
+        filterHandle->filterFunction = filterFunction;
+        filterHandle->bufferFilterFunction = NULL;
+        filterHandle->stage.filterFunction = filterFunction;
+        filterHandle->stages = &filterHandle->stage;
+        filterHandle->stageCount = 1;
+    }
+    return CreateFilter(RunFilter, pipeInHandle, pipeOutHandle, filterHandle, stack, task);
+}
+
+static Retcode_T CreateFusedFilter(PipeAndFilter_Stage_T *stages, uint32_t stageCount, PipeAndFilter_Pipe_T *pipeInHandle, PipeAndFilter_Pipe_T *pipeOutHandle, PipeAndFilter_Filter_T *filterHandle,
+                                   StackType_t *stack, StaticTask_t *task)
+{
+    if (stages == NULL || filterHandle == NULL)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+    }
+    if (stageCount == 0)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INVALID_PARAM);
+    }
+    for (uint32_t i = 0; i < stageCount; i++)
+    {
+        if (stages[i].filterFunction == NULL)
+        {
+            return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+        }
+    }
+
+    filterHandle->filterFunction = stages[0].filterFunction;
+    filterHandle->bufferFilterFunction = NULL;
+    filterHandle->stages = stages;
+    filterHandle->stageCount = stageCount;
+    return CreateFilter(RunFilter, pipeInHandle, pipeOutHandle, filterHandle, stack, task);
+}
+
+static Retcode_T CreateBufferFilter(PipeAndFilter_BufferFilterFunction_T filterFunction, PipeAndFilter_Pipe_T *pipeInHandle, PipeAndFilter_Pipe_T *pipeOutHandle, PipeAndFilter_Filter_T *filterHandle,
+                                    StackType_t *stack, StaticTask_t *task)
+{
+    if (filterHandle != NULL)
+    {
+        filterHandle->filterFunction = NULL;
+        filterHandle->bufferFilterFunction = filterFunction;
+        filterHandle->stage.filterFunction = NULL;
+        filterHandle->stages = &filterHandle->stage;
+        filterHandle->stageCount = 1;
+    }
+    return CreateFilter(RunBufferFilter, pipeInHandle, pipeOutHandle, filterHandle, stack, task);
+}
+
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+/*  The description of the function is available in Kiso_PipeAndFilter.h */
+Retcode_T PipeAndFilter_CreateFilter(PipeAndFilter_FilterFunction_T filterFunction, PipeAndFilter_Pipe_T *pipeInHandle, PipeAndFilter_Pipe_T *pipeOutHandle, PipeAndFilter_Filter_T *filterHandle)
+{
+    return CreateSingleFilter(filterFunction, pipeInHandle, pipeOutHandle, filterHandle, NULL, NULL);
+}
+
+/*  The description of the function is available in Kiso_PipeAndFilter.h */
+Retcode_T PipeAndFilter_CreateFusedFilter(PipeAndFilter_Stage_T *stages, uint32_t stageCount, PipeAndFilter_Pipe_T *pipeInHandle, PipeAndFilter_Pipe_T *pipeOutHandle, PipeAndFilter_Filter_T *filterHandle)
+{
+    return CreateFusedFilter(stages, stageCount, pipeInHandle, pipeOutHandle, filterHandle, NULL, NULL);
+}
+
+/*  The description of the function is available in Kiso_PipeAndFilter.h */
+Retcode_T PipeAndFilter_CreateBufferFilter(PipeAndFilter_BufferFilterFunction_T filterFunction, PipeAndFilter_Pipe_T *pipeInHandle, PipeAndFilter_Pipe_T *pipeOutHandle, PipeAndFilter_Filter_T *filterHandle)
+{
+    return CreateBufferFilter(filterFunction, pipeInHandle, pipeOutHandle, filterHandle, NULL, NULL);
+}
+#endif /* if (configSUPPORT_DYNAMIC_ALLOCATION == 1) */
+
+#if KISO_UTILS_STATIC_ALLOCATION
+/*  The description of the function is available in Kiso_PipeAndFilter.h */
+Retcode_T PipeAndFilter_CreateFilterStatic(PipeAndFilter_FilterFunction_T filterFunction, PipeAndFilter_Pipe_T *pipeInHandle, PipeAndFilter_Pipe_T *pipeOutHandle, PipeAndFilter_Filter_T *filterHandle,
+                                           PipeAndFilter_FilterStorage_T *storage)
+{
+    if (storage == NULL)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+    }
+    return CreateSingleFilter(filterFunction, pipeInHandle, pipeOutHandle, filterHandle, storage->stack, &storage->task);
+}
+
+/*  The description of the function is available in Kiso_PipeAndFilter.h */
+Retcode_T PipeAndFilter_CreateFusedFilterStatic(PipeAndFilter_Stage_T *stages, uint32_t stageCount, PipeAndFilter_Pipe_T *pipeInHandle, PipeAndFilter_Pipe_T *pipeOutHandle, PipeAndFilter_Filter_T *filterHandle,
+                                                PipeAndFilter_FilterStorage_T *storage)
+{
+    if (storage == NULL)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+    }
+    return CreateFusedFilter(stages, stageCount, pipeInHandle, pipeOutHandle, filterHandle, storage->stack, &storage->task);
+}
+
+/*  The description of the function is available in Kiso_PipeAndFilter.h */
+Retcode_T PipeAndFilter_CreateBufferFilterStatic(PipeAndFilter_BufferFilterFunction_T filterFunction, PipeAndFilter_Pipe_T *pipeInHandle, PipeAndFilter_Pipe_T *pipeOutHandle, PipeAndFilter_Filter_T *filterHandle,
+                                                 PipeAndFilter_FilterStorage_T *storage)
+{
+    if (storage == NULL)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+    }
+    return CreateBufferFilter(filterFunction, pipeInHandle, pipeOutHandle, filterHandle, storage->stack, &storage->task);
+}
+#endif /* if KISO_UTILS_STATIC_ALLOCATION */
+
+/*  The description of the function is available in Kiso_PipeAndFilter.h */
+Retcode_T PipeAndFilter_SetOutputPipes(PipeAndFilter_Filter_T *filterHandle, PipeAndFilter_Pipe_T **pipeOutHandles, uint32_t pipeOutCount)
+{
+    if (filterHandle == NULL || (pipeOutHandles == NULL && pipeOutCount != 0))
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+    }
+    for (uint32_t i = 0; i < pipeOutCount; i++)
+    {
+        if (pipeOutHandles[i] == NULL)
+        {
+            return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+        }
+        if (pipeOutHandles[i]->isBufferPipe != (filterHandle->bufferFilterFunction != NULL))
+        {
+            return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INVALID_PARAM);
+        }
+    }
+    filterHandle->pipeOutHandle = (pipeOutCount != 0) ? pipeOutHandles[0] : NULL;
+    filterHandle->pipeOutHandles = pipeOutHandles;
+    filterHandle->pipeOutCount = pipeOutCount;
+    return RETCODE_OK;
+}
+
+/*  The description of the function is available in Kiso_PipeAndFilter.h */
+Retcode_T PipeAndFilter_SetBatchSize(PipeAndFilter_Filter_T *filterHandle, uint32_t batchSize)
+{
+    if (filterHandle == NULL)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+    }
+    if (batchSize == 0)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INVALID_PARAM);
+    }
+    filterHandle->batchSize = batchSize;
+    return RETCODE_OK;
+}
+
+/*  The description of the function is available in Kiso_PipeAndFilter.h */
+Retcode_T PipeAndFilter_GetStatistics(const PipeAndFilter_Filter_T *filterHandle, uint32_t stage, PipeAndFilter_Statistics_T *statistics)
+{
+    if (filterHandle == NULL || filterHandle->stages == NULL || statistics == NULL)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+    }
+    if (stage >= filterHandle->stageCount)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INVALID_PARAM);
+    }
+    *statistics = filterHandle->stages[stage].statistics;
+    return RETCODE_OK;
+}
+
+/*  The description of the function is available in Kiso_PipeAndFilter.h */
+Retcode_T PipeAndFilter_ResetStatistics(PipeAndFilter_Filter_T *filterHandle)
+{
+    if (filterHandle == NULL || filterHandle->stages == NULL)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+    }
+    for (uint32_t i = 0; i < filterHandle->stageCount; i++)
+    {
+        memset(&filterHandle->stages[i].statistics, 0, sizeof(PipeAndFilter_Statistics_T));
+    }
+    return RETCODE_OK;
+}
+
+static Retcode_T CreateBufferPipe(PipeAndFilter_Pipe_T *pipeHandle, PipeAndFilter_Buffer_T **memory, StaticQueue_t *queue)
+{
+    Retcode_T retcode = RETCODE_OK;
+    QueueHandle_t xQueue;
+
+    if (pipeHandle == NULL)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+    }
+
+    xQueue = CreateBufferQueue(BUFFER_PIPE_DEPTH, memory, queue);
+
+    if (xQueue == NULL)
+    {
+        retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_OUT_OF_RESOURCES);
+    }
+
+    // Exit
+    pipeHandle->pipeInternalHandle = (PipeAndFilter_PipeInternalHandle_T)xQueue;
+    pipeHandle->filterInternalHandle = NULL;
+    pipeHandle->lockInternalHandle = NULL;
+    pipeHandle->policy = PIPEANDFILTER_POLICY_BLOCK;
+    pipeHandle->isBufferPipe = true;
+    pipeHandle->dropped = 0;
+    return retcode;
+}
+
+static Retcode_T CreatePool(PipeAndFilter_Pool_T *pool, PipeAndFilter_Buffer_T *buffers, uint8_t *memory, uint32_t count, uint32_t bufferSize,
+                            PipeAndFilter_Buffer_T **freeBuffers, StaticQueue_t *queue)
+{
+    QueueHandle_t xFreeBuffers;
+
+    if (pool == NULL || buffers == NULL || memory == NULL)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+    }
+    if (count == 0 || bufferSize == 0)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INVALID_PARAM);
+    }
+
+    xFreeBuffers = CreateBufferQueue(count, freeBuffers, queue);
+    if (xFreeBuffers == NULL)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_OUT_OF_RESOURCES);
+    }
+
+    pool->poolInternalHandle = (PipeAndFilter_PoolInternalHandle_T)xFreeBuffers;
+    pool->bufferSize = bufferSize;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        PipeAndFilter_Buffer_T *buffer = &buffers[i];
+        buffer->data = &memory[i * bufferSize];
+        buffer->length = 0;
+        buffer->references = 0;
+        buffer->size = bufferSize;
+        buffer->pool = pool;
+        (void)xQueueSend(xFreeBuffers, (void *)&buffer, 0);
+    }
+    return RETCODE_OK;
+}
+
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+/*  The description of the function is available in Kiso_PipeAndFilter.h */
+Retcode_T PipeAndFilter_CreateBufferPipe(PipeAndFilter_Pipe_T *pipeHandle)
+{
+    return CreateBufferPipe(pipeHandle, NULL, NULL);
+}
+
+/*  The description of the function is available in Kiso_PipeAndFilter.h */
+Retcode_T PipeAndFilter_CreatePool(PipeAndFilter_Pool_T *pool, PipeAndFilter_Buffer_T *buffers, uint8_t *memory, uint32_t count, uint32_t bufferSize)
+{
+    return CreatePool(pool, buffers, memory, count, bufferSize, NULL, NULL);
+}
+#endif /* if (configSUPPORT_DYNAMIC_ALLOCATION == 1) */
+
+#if KISO_UTILS_STATIC_ALLOCATION
+/*  The description of the function is available in Kiso_PipeAndFilter.h */
+Retcode_T PipeAndFilter_CreateBufferPipeStatic(PipeAndFilter_Pipe_T *pipeHandle, PipeAndFilter_BufferPipeStorage_T *storage)
+{
+    if (storage == NULL)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+    }
+    return CreateBufferPipe(pipeHandle, storage->buffers, &storage->queue);
+}
+
+/*  The description of the function is available in Kiso_PipeAndFilter.h */
+Retcode_T PipeAndFilter_CreatePoolStatic(PipeAndFilter_Pool_T *pool, PipeAndFilter_Buffer_T *buffers, uint8_t *memory, uint32_t count, uint32_t bufferSize,
+                                         PipeAndFilter_Buffer_T **freeBuffers, PipeAndFilter_PoolStorage_T *storage)
+{
+    if (freeBuffers == NULL || storage == NULL)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+    }
+    return CreatePool(pool, buffers, memory, count, bufferSize, freeBuffers, &storage->queue);
+}
+#endif /* if KISO_UTILS_STATIC_ALLOCATION */
+
+/*  The description of the function is available in Kiso_PipeAndFilter.h */
+Retcode_T PipeAndFilter_AllocateBuffer(PipeAndFilter_Pool_T *pool, PipeAndFilter_Buffer_T **buffer, uint32_t timeout)
+{
+    if (pool == NULL || pool->poolInternalHandle == NULL || buffer == NULL)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+    }
+
+    if (pdPASS != xQueueReceive((QueueHandle_t)pool->poolInternalHandle, (void *)buffer, pdMS_TO_TICKS(timeout)))
+    {
+        *buffer = NULL;
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_OUT_OF_RESOURCES);
+    }
+    (*buffer)->length = 0;
+    (*buffer)->references = 1;
+    return RETCODE_OK;
+}
+
+/*  The description of the function is available in Kiso_PipeAndFilter.h */
+Retcode_T PipeAndFilter_AllocateBufferFromISR(PipeAndFilter_Pool_T *pool, PipeAndFilter_Buffer_T **buffer)
+{
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+
+    if (pool == NULL || pool->poolInternalHandle == NULL || buffer == NULL)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+    }
+
+    if (pdPASS != xQueueReceiveFromISR((QueueHandle_t)pool->poolInternalHandle, (void *)buffer, &higherPriorityTaskWoken))
+    {
+        *buffer = NULL;
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_OUT_OF_RESOURCES);
+    }
+    (*buffer)->length = 0;
+    (*buffer)->references = 1;
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+    return RETCODE_OK;
+}
+
+/*  The description of the function is available in Kiso_PipeAndFilter.h */
+Retcode_T PipeAndFilter_ReleaseBuffer(PipeAndFilter_Buffer_T *buffer)
+{
+    BaseType_t rc;
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    uint32_t references;
+
+    if (buffer == NULL || buffer->pool == NULL)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+    }
+
+    // A buffer shared by several pipes goes back to the pool with the release of its last owner
+    references = __atomic_load_n(&buffer->references, __ATOMIC_RELAXED);
+    do
+    {
+        if (references == 0)
+        {
+            return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_FAILURE);
+        }
+    } while (!__atomic_compare_exchange_n(&buffer->references, &references, references - 1U, true, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+    if (references > 1U)
+    {
+        return RETCODE_OK;
+    }
+
+    // The pool has room for all its buffers, so it is only full if this one was released already
+    if (HAL_IsInISR())
+    {
+        rc = xQueueSendFromISR((QueueHandle_t)buffer->pool->poolInternalHandle, (void *)&buffer, &higherPriorityTaskWoken);
+        portYIELD_FROM_ISR(higherPriorityTaskWoken);
+    }
+    else
+    {
+        rc = xQueueSend((QueueHandle_t)buffer->pool->poolInternalHandle, (void *)&buffer, 0);
+    }
+    return (pdPASS == rc) ? RETCODE_OK : RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_FAILURE);
+}
+
 /*  The description of the function is available in Kiso_PipeAndFilter.h */
 Retcode_T PipeAndFilter_FillPipe(PipeAndFilter_Pipe_T pipe, uint8_t *xTxBuffer, uint32_t xToSendBytes)
 {
@@ -191,9 +1023,20 @@ Retcode_T PipeAndFilter_FillPipe(PipeAndFilter_Pipe_T pipe, uint8_t *xTxBuffer,
         retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
     }
 
+    // The writers of a merge pipe take turns
+    if (retcode == RETCODE_OK && pipe.lockInternalHandle != NULL && pdTRUE != xSemaphoreTake((SemaphoreHandle_t)pipe.lockInternalHandle, portMAX_DELAY))
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SEMAPHORE_ERROR);
+    }
+
     if (retcode == RETCODE_OK)
     {
         xSendBytes = xMessageBufferSend((MessageBufferHandle_t)pipe.pipeInternalHandle, (void *)xTxBuffer, xToSendBytes, 0);
+
+        if (pipe.lockInternalHandle != NULL)
+        {
+            (void)xSemaphoreGive((SemaphoreHandle_t)pipe.lockInternalHandle);
+        }
     }
 
     if (xSendBytes != xToSendBytes)
@@ -213,6 +1056,11 @@ Retcode_T PipeAndFilter_FillPipeFromISR(PipeAndFilter_Pipe_T pipe, uint8_t *xTxB
     {
         retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
     }
+    else if (pipe.lockInternalHandle != NULL)
+    {
+        // The other writers of a merge pipe cannot be waited for
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NOT_SUPPORTED);
+    }
 
     if (retcode == RETCODE_OK)
     {
@@ -226,4 +1074,45 @@ Retcode_T PipeAndFilter_FillPipeFromISR(PipeAndFilter_Pipe_T pipe, uint8_t *xTxB
     return retcode;
 }
 
+/*  The description of the function is available in Kiso_PipeAndFilter.h */
+Retcode_T PipeAndFilter_FillBufferPipe(PipeAndFilter_Pipe_T pipe, PipeAndFilter_Buffer_T *buffer)
+{
+    if (pipe.pipeInternalHandle == NULL || buffer == NULL)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+    }
+    if (buffer->length > buffer->size)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INVALID_PARAM);
+    }
+
+    if (pdPASS != xQueueSend((QueueHandle_t)pipe.pipeInternalHandle, (void *)&buffer, 0))
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_OUT_OF_RESOURCES);
+    }
+    return RETCODE_OK;
+}
+
+/*  The description of the function is available in Kiso_PipeAndFilter.h */
+Retcode_T PipeAndFilter_FillBufferPipeFromISR(PipeAndFilter_Pipe_T pipe, PipeAndFilter_Buffer_T *buffer)
+{
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+
+    if (pipe.pipeInternalHandle == NULL || buffer == NULL)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER);
+    }
+    if (buffer->length > buffer->size)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INVALID_PARAM);
+    }
+
+    if (pdPASS != xQueueSendFromISR((QueueHandle_t)pipe.pipeInternalHandle, (void *)&buffer, &higherPriorityTaskWoken))
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_OUT_OF_RESOURCES);
+    }
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+    return RETCODE_OK;
+}
+
 #endif /* if KISO_FEATURE_PIPEANDFILTER */
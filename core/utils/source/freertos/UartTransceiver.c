@@ -20,6 +20,7 @@
  * @details
  *      This source file implements following features:
  *      - UARTTransceiver_Initialize()
+ *      - UARTTransceiver_InitializeStatic()
  *      - UARTTransceiver_Deinitialize()
  *      - UARTTransceiver_Start()
  *      - UARTTransceiver_StartInAsyncMode()
@@ -67,10 +68,82 @@
  */
 static bool dummyFrameEndCheckFunc(uint8_t x);
 
-/*  The description of the function is available in Kiso_UARTTransceiver.h */
-Retcode_T UARTTransceiver_Initialize(UARTTransceiver_T *transceiver,
-                                     HWHandle_T handle, uint8_t *rawRxBuffer, uint32_t rawRxBufferSize,
-                                     enum UARTTransceiver_UartType_E type)
+/* Wakes the task waiting for the send process (isTx) or for a frame end or receive error, from the loop callback */
+static void UARTTransceiverSignalFromIsr(UARTTransceiver_T *transceiver, bool isTx)
+{
+    portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+#if KISO_UTILS_TASK_NOTIFICATIONS
+    void **waitingTask = isTx ? &transceiver->TxWaitingTask : &transceiver->RxWaitingTask;
+    TaskHandle_t task;
+
+    __atomic_store_n(isTx ? &transceiver->TxSignaled : &transceiver->RxSignaled, true, __ATOMIC_SEQ_CST);
+    task = (TaskHandle_t)__atomic_load_n(waitingTask, __ATOMIC_SEQ_CST);
+    if (NULL != task)
+    {
+        /* Only wakes the task, its notification value may belong to someone else (e.g. GuardedTask) */
+        (void)xTaskNotifyFromISR(task, 0UL, eNoAction, &xHigherPriorityTaskWoken);
+    }
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+#else
+    if (pdTRUE == xSemaphoreGiveFromISR(isTx ? transceiver->TxSemaphore : transceiver->RxSemaphore, &xHigherPriorityTaskWoken))
+    {
+        portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+    }
+#endif
+}
+
+/* Waits for the send process (isTx) or for a frame end or receive error, returns false on timeout */
+static bool UARTTransceiverWait(UARTTransceiver_T *transceiver, bool isTx, TickType_t ticksToWait)
+{
+#if KISO_UTILS_TASK_NOTIFICATIONS
+    void **waitingTask = isTx ? &transceiver->TxWaitingTask : &transceiver->RxWaitingTask;
+    bool *isSignaled = isTx ? &transceiver->TxSignaled : &transceiver->RxSignaled;
+    TimeOut_t timeOut;
+    bool isDone;
+
+    /* Other notifications of the task only make it look at the flag again */
+    vTaskSetTimeOutState(&timeOut);
+    __atomic_store_n(waitingTask, (void *)xTaskGetCurrentTaskHandle(), __ATOMIC_SEQ_CST);
+    for (;;)
+    {
+        isDone = __atomic_exchange_n(isSignaled, false, __ATOMIC_SEQ_CST);
+        if (isDone || (pdTRUE == xTaskCheckForTimeOut(&timeOut, &ticksToWait)))
+        {
+            break;
+        }
+        (void)xTaskNotifyWait(0UL, 0UL, NULL, ticksToWait);
+    }
+    __atomic_store_n(waitingTask, NULL, __ATOMIC_SEQ_CST);
+
+    return isDone;
+#else
+    return (pdFAIL != xSemaphoreTake(isTx ? transceiver->TxSemaphore : transceiver->RxSemaphore, ticksToWait));
+#endif
+}
+
+#if !KISO_UTILS_TASK_NOTIFICATIONS
+/* Creates a binary semaphore in the given storage, or on the FreeRTOS heap if it is NULL */
+static SemaphoreHandle_t UARTTransceiverCreateSemaphore(StaticSemaphore_t *buffer)
+{
+#if KISO_UTILS_STATIC_ALLOCATION
+    if (NULL != buffer)
+    {
+        return xSemaphoreCreateBinaryStatic(buffer);
+    }
+#else
+    KISO_UNUSED(buffer);
+#endif
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+    return xSemaphoreCreateBinary();
+#else
+    return NULL;
+#endif
+}
+#endif /* if !KISO_UTILS_TASK_NOTIFICATIONS */
+
+static Retcode_T UARTTransceiverInitialize(UARTTransceiver_T *transceiver,
+                                           HWHandle_T handle, uint8_t *rawRxBuffer, uint32_t rawRxBufferSize,
+                                           enum UARTTransceiver_UartType_E type, StaticSemaphore_t *rxSemaphoreBuffer, StaticSemaphore_t *txSemaphoreBuffer)
 {
     Retcode_T retcode = RETCODE_OK;
     if (NULL == transceiver || NULL == handle || NULL == rawRxBuffer || 0 == rawRxBufferSize || UART_TRANSCEIVER_UART_TYPE_NONE == type)
@@ -84,9 +157,18 @@ Retcode_T UARTTransceiver_Initialize(UARTTransceiver_T *transceiver,
             transceiver->handle = handle;
             transceiver->UartType = type;
             RingBuffer_Initialize(&(transceiver->UartRxBufDescr), rawRxBuffer, rawRxBufferSize);
-            transceiver->RxSemaphore = xSemaphoreCreateBinary();
-            transceiver->TxSemaphore = xSemaphoreCreateBinary();
             transceiver->EndOfFrameCheck = dummyFrameEndCheckFunc;
+#if KISO_UTILS_TASK_NOTIFICATIONS
+            KISO_UNUSED(rxSemaphoreBuffer);
+            KISO_UNUSED(txSemaphoreBuffer);
+            transceiver->TxWaitingTask = NULL;
+            transceiver->RxWaitingTask = NULL;
+            transceiver->TxSignaled = false;
+            transceiver->RxSignaled = false;
+            transceiver->State = UART_TRANSCEIVER_STATE_INITIALIZED;
+#else
+            transceiver->RxSemaphore = UARTTransceiverCreateSemaphore(rxSemaphoreBuffer);
+            transceiver->TxSemaphore = UARTTransceiverCreateSemaphore(txSemaphoreBuffer);
 
             if (NULL != transceiver->RxSemaphore && NULL != transceiver->TxSemaphore)
             {
@@ -96,6 +178,7 @@ Retcode_T UARTTransceiver_Initialize(UARTTransceiver_T *transceiver,
             {
                 retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SEMAPHORE_ERROR);
             }
+#endif
         }
         else
         {
@@ -105,6 +188,30 @@ Retcode_T UARTTransceiver_Initialize(UARTTransceiver_T *transceiver,
     return retcode;
 }
 
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1) || KISO_UTILS_TASK_NOTIFICATIONS
+/*  The description of the function is available in Kiso_UARTTransceiver.h */
+Retcode_T UARTTransceiver_Initialize(UARTTransceiver_T *transceiver,
+                                     HWHandle_T handle, uint8_t *rawRxBuffer, uint32_t rawRxBufferSize,
+                                     enum UARTTransceiver_UartType_E type)
+{
+    return UARTTransceiverInitialize(transceiver, handle, rawRxBuffer, rawRxBufferSize, type, NULL, NULL);
+}
+#endif
+
+#if KISO_UTILS_STATIC_ALLOCATION && !KISO_UTILS_TASK_NOTIFICATIONS
+/*  The description of the function is available in Kiso_UARTTransceiver.h */
+Retcode_T UARTTransceiver_InitializeStatic(UARTTransceiver_T *transceiver,
+                                           HWHandle_T handle, uint8_t *rawRxBuffer, uint32_t rawRxBufferSize,
+                                           enum UARTTransceiver_UartType_E type, UARTTransceiver_Storage_T *storage)
+{
+    if (NULL == storage)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INVALID_PARAM);
+    }
+    return UARTTransceiverInitialize(transceiver, handle, rawRxBuffer, rawRxBufferSize, type, &storage->RxSemaphore, &storage->TxSemaphore);
+}
+#endif
+
 /*  The description of the function is available in Kiso_UARTTransceiver.h */
 Retcode_T UARTTransceiver_Deinitialize(UARTTransceiver_T *transceiver)
 {
@@ -116,8 +223,10 @@ Retcode_T UARTTransceiver_Deinitialize(UARTTransceiver_T *transceiver)
     else
     {
         transceiver->handle = NULL;
+#if !KISO_UTILS_TASK_NOTIFICATIONS
         vSemaphoreDelete(transceiver->RxSemaphore);
         vSemaphoreDelete(transceiver->TxSemaphore);
+#endif
         transceiver->State = UART_TRANSCEIVER_STATE_RESET;
         transceiver->Mode = UART_TRANSCEIVER_MODE_NONE;
         retcode = RETCODE_OK;
@@ -344,7 +453,7 @@ Retcode_T UARTTransceiver_ReadData(UARTTransceiver_T *transceiver, uint8_t *buff
         {
             if (transceiver->Mode == UART_TRANSCEIVER_MODE_SYNCH)
             {
-                if (pdFAIL == xSemaphoreTake(transceiver->RxSemaphore, (timeout_ms / portTICK_RATE_MS)))
+                if (!UARTTransceiverWait(transceiver, false, (timeout_ms / portTICK_RATE_MS)))
                 {
                     /* see Event TxComplete in uartEvents_HAL (HAL ISR user callback) */
                     retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SEMAPHORE_ERROR);
@@ -357,9 +466,9 @@ Retcode_T UARTTransceiver_ReadData(UARTTransceiver_T *transceiver, uint8_t *buff
                     }
                 }
             }
-            taskENTER_CRITICAL();
+            /* The RX ISR is the only producer and this is the only consumer of the ring-buffer,
+             * so the read is lock-free and RX interrupts are not held off while copying */
             *length = RingBuffer_Read(&transceiver->UartRxBufDescr, buffer, size);
-            taskEXIT_CRITICAL();
         }
         else
         {
@@ -381,6 +490,10 @@ Retcode_T UARTTransceiver_WriteData(UARTTransceiver_T *transceiver, const uint8_
     {
         if (UART_TRANSCEIVER_STATE_ACTIVE == transceiver->State)
         {
+#if KISO_UTILS_TASK_NOTIFICATIONS
+            /* A late end of an earlier send process which timed out must not end this one */
+            transceiver->TxSignaled = false;
+#endif
 #if KISO_FEATURE_UART
             if (transceiver->UartType == UART_TRANSCEIVER_UART_TYPE_UART)
             {
@@ -400,7 +513,7 @@ Retcode_T UARTTransceiver_WriteData(UARTTransceiver_T *transceiver, const uint8_
                 }
                 else
                 {
-                    if (pdFAIL == xSemaphoreTake(transceiver->TxSemaphore, (timeout_ms / portTICK_RATE_MS)))
+                    if (!UARTTransceiverWait(transceiver, true, (timeout_ms / portTICK_RATE_MS)))
                     {
                         /* See Event TxComplete in uartEvents_HAL (HAL ISR user callback) */
                         retcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SEMAPHORE_ERROR);
@@ -439,11 +552,7 @@ void UARTTransceiver_LoopCallback(UARTTransceiver_T *transceiver, struct MCU_UAR
                 }
                 else
                 {
-                    portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
-                    if (pdTRUE == xSemaphoreGiveFromISR(transceiver->RxSemaphore, &xHigherPriorityTaskWoken))
-                    {
-                        portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
-                    }
+                    UARTTransceiverSignalFromIsr(transceiver, false);
                 }
             }
         }
@@ -456,11 +565,7 @@ void UARTTransceiver_LoopCallback(UARTTransceiver_T *transceiver, struct MCU_UAR
         }
         else
         {
-            portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
-            if (pdTRUE == xSemaphoreGiveFromISR(transceiver->TxSemaphore, &xHigherPriorityTaskWoken))
-            {
-                portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
-            }
+            UARTTransceiverSignalFromIsr(transceiver, true);
         }
     }
     if (event.RxError)
@@ -472,11 +577,7 @@ void UARTTransceiver_LoopCallback(UARTTransceiver_T *transceiver, struct MCU_UAR
         else
         {
             transceiver->errorCode = RETCODE_FAILURE;
-            portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
-            if (pdTRUE == xSemaphoreGiveFromISR(transceiver->RxSemaphore, &xHigherPriorityTaskWoken))
-            {
-                portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
-            }
+            UARTTransceiverSignalFromIsr(transceiver, false);
         }
     }
     if (transceiver->AsyncEvent.registerValue)
@@ -505,11 +606,7 @@ void UARTTransceiver_LoopCallbackLE(UARTTransceiver_T *transceiver, struct MCU_L
                 }
                 else
                 {
-                    portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
-                    if (pdTRUE == xSemaphoreGiveFromISR(transceiver->RxSemaphore, &xHigherPriorityTaskWoken))
-                    {
-                        portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
-                    }
+                    UARTTransceiverSignalFromIsr(transceiver, false);
                 }
             }
         }
@@ -522,11 +619,7 @@ void UARTTransceiver_LoopCallbackLE(UARTTransceiver_T *transceiver, struct MCU_L
         }
         else
         {
-            portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
-            if (pdTRUE == xSemaphoreGiveFromISR(transceiver->TxSemaphore, &xHigherPriorityTaskWoken))
-            {
-                portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
-            }
+            UARTTransceiverSignalFromIsr(transceiver, true);
         }
     }
     if (event.RxError)
@@ -538,11 +631,7 @@ void UARTTransceiver_LoopCallbackLE(UARTTransceiver_T *transceiver, struct MCU_L
         else
         {
             transceiver->errorCode = RETCODE_FAILURE;
-            portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
-            if (pdTRUE == xSemaphoreGiveFromISR(transceiver->RxSemaphore, &xHigherPriorityTaskWoken))
-            {
-                portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
-            }
+            UARTTransceiverSignalFromIsr(transceiver, false);
         }
     }
     if (transceiver->AsyncEvent.registerValue)
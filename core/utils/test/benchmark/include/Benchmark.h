@@ -0,0 +1,118 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ * @brief
+ *      Host benchmark harness for the Kiso modules.
+ *
+ * @details
+ *      A benchmark executable consists of suites, which call Benchmark_Run() for every operation to
+ *      be measured. The harness repeats the operation until a measurement takes long enough to be
+ *      accurate and keeps the fastest of several measurements. Results are printed as ns/op and
+ *      bytes/s and can be written as JSON, which in turn can serve as baseline of a later run:
+ *
+ *      | Option                | Meaning                                                         |
+ *      |-----------------------|-----------------------------------------------------------------|
+ *      | --filter=TEXT         | Only run benchmarks whose name contains TEXT                     |
+ *      | --json=FILE           | Write the results to FILE                                       |
+ *      | --baseline=FILE       | Fail if a benchmark got slower than in FILE by the threshold     |
+ *      | --threshold=PERCENT   | Allowed slowdown, unless the baseline entry has its own          |
+ *      | --min-time-ms=MS      | Minimum duration of one measurement                             |
+ *      | --repetitions=N       | Number of measurements, the fastest one is reported             |
+ *
+ *      Benchmarks are only built on the host with ENABLE_TESTING and ENABLE_BENCHMARKS.
+ *
+ * @file
+ */
+
+#ifndef BENCHMARK_H_
+#define BENCHMARK_H_
+
+#include <stdint.h>
+
+/**
+ * @brief
+ *      Operation to be measured.
+ *
+ * @param[in] param
+ *      Parameter given to Benchmark_Run()
+ * @param iterations
+ *      Number of times the operation has to be executed
+ */
+typedef void (*Benchmark_Function_T)(void *param, uint32_t iterations);
+
+/**
+ * @brief
+ *      Registers the benchmarks of one module by calling Benchmark_Run() and Benchmark_Report().
+ */
+typedef void (*Benchmark_Suite_T)(void);
+
+/**
+ * @brief
+ *      Measures an operation and records the result.
+ *
+ * @param[in] name
+ *      Unique name of the benchmark, e.g. "CRC/CRC_16/1024"
+ * @param function
+ *      Operation to be measured
+ * @param[in] param
+ *      Passed to function
+ * @param bytesPerOperation
+ *      Number of bytes processed by one operation, 0 if throughput is not meaningful
+ */
+void Benchmark_Run(const char *name, Benchmark_Function_T function, void *param, uint32_t bytesPerOperation);
+
+/**
+ * @brief
+ *      Records a value which is not a duration, e.g. the encoded size of a frame. Such values are
+ *      part of the output, but not checked against the baseline.
+ *
+ * @param[in] name
+ *      Unique name of the value
+ * @param value
+ *      Value to report
+ * @param[in] unit
+ *      Unit of the value, e.g. "bytes"
+ */
+void Benchmark_Report(const char *name, double value, const char *unit);
+
+/**
+ * @brief
+ *      Consumes a result of a benchmarked operation, so that the compiler cannot optimize the
+ *      operation away.
+ *
+ * @param value
+ *      Result to consume
+ */
+void Benchmark_Keep(uint32_t value);
+
+/**
+ * @brief
+ *      Parses the command line, runs the suites and writes and checks the results.
+ *
+ * @param argc
+ *      Argument count of main()
+ * @param[in] argv
+ *      Argument vector of main()
+ * @param[in] suites
+ *      Suites to run
+ * @param suiteCount
+ *      Number of suites
+ *
+ * @return
+ *      0 on success, 1 if a benchmark regressed against the baseline, 2 on usage or I/O errors
+ */
+int Benchmark_Main(int argc, char *argv[], const Benchmark_Suite_T *suites, uint32_t suiteCount);
+
+#endif /* BENCHMARK_H_ */
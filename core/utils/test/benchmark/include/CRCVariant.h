@@ -0,0 +1,60 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ * @brief
+ *      CRC compiled once per implementation, so that they can be compared in one benchmark run.
+ *
+ * @details
+ *      CRCBitSerial.c, CRCTable.c and CRCSlicingBy4.c each compile CRC.c with KISO_CRC_TABLE_DRIVEN
+ *      and KISO_CRC32_SLICING_BY_4 set accordingly. Including this header with CRC_VARIANT() defined
+ *      renames the public functions, which are then exported through a CRCVariant_T. The unrenamed
+ *      CRC.c keeps the configured implementation for the other modules.
+ *
+ * @file
+ */
+
+#ifndef CRCVARIANT_H_
+#define CRCVARIANT_H_
+
+#ifdef CRC_VARIANT
+#define CRC_8 CRC_VARIANT(CRC_8)
+#define CRC_16 CRC_VARIANT(CRC_16)
+#define CRC_32 CRC_VARIANT(CRC_32)
+#define CRC_32_Reverse CRC_VARIANT(CRC_32_Reverse)
+#define CRC_Initialize CRC_VARIANT(Initialize)
+#define CRC_Update CRC_VARIANT(Update)
+#define CRC_Finalize CRC_VARIANT(Finalize)
+#define CRC_Calculate CRC_VARIANT(Calculate)
+#endif /* CRC_VARIANT */
+
+#include "Kiso_CRC.h"
+
+/**
+ * @brief
+ *      The CRC functions used by the benchmarks, see Kiso_CRC.h.
+ */
+typedef struct CRCVariant_S
+{
+    const char *Name;
+    Retcode_T (*Crc16)(uint16_t poly, uint16_t *shifter, const uint8_t *data_p, uint16_t len);
+    Retcode_T (*Crc32)(uint32_t poly, uint32_t *shifter, const uint8_t *data_p, uint16_t len);
+    Retcode_T (*Crc32Reverse)(uint32_t poly, uint32_t *shifter, const uint8_t *data_p, uint16_t len);
+} CRCVariant_T;
+
+extern const CRCVariant_T CRCVariant_BitSerial;  /**< one bit per step, no tables */
+extern const CRCVariant_T CRCVariant_Table;      /**< one octet per step from a 256-entry table */
+extern const CRCVariant_T CRCVariant_SlicingBy4; /**< CRC-32 four octets per step from four tables */
+
+#endif /* CRCVARIANT_H_ */
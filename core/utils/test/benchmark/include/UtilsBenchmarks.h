@@ -0,0 +1,40 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ * @brief
+ *      Benchmark suites of the utils package, see Benchmark.h
+ *
+ * @file
+ */
+
+#ifndef UTILSBENCHMARKS_H_
+#define UTILSBENCHMARKS_H_
+
+/** CRC: the legacy routines and the context API for several algorithms and sizes, and the implementations compared */
+void CRC_Benchmark(void);
+
+/** RingBuffer: copying (against the former byte-wise loop), zero-copy and record interfaces */
+void RingBuffer_Benchmark(void);
+
+/** XProtocol: encoding and decoding with escaping and with COBS framing */
+void XProtocol_Benchmark(void);
+
+/** Logging: LogFilter_Apply() for passing and blocked messages */
+void Logging_Benchmark(void);
+
+/** CmdLineDebugger: CmdLineDbg_Parse() against a command list */
+void CmdLineDebugger_Benchmark(void);
+
+#endif /* UTILSBENCHMARKS_H_ */
@@ -0,0 +1,64 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ * @brief
+ *      XProtocol compiled once per framing, so that both can be compared in one benchmark run.
+ *
+ * @details
+ *      XProtocolEscaping.c and XProtocolCobs.c each compile XProtocol.c with KISO_XPROTOCOL_COBS set
+ *      accordingly. Including this header with XPROTOCOL_FRAMING() defined renames the public
+ *      functions, which are then exported through an XProtocolFraming_T.
+ *
+ * @file
+ */
+
+#ifndef XPROTOCOLFRAMING_H_
+#define XPROTOCOLFRAMING_H_
+
+#ifdef XPROTOCOL_FRAMING
+#define XProtocol_Init XPROTOCOL_FRAMING(Init)
+#define XProtocol_EncodeFrame XPROTOCOL_FRAMING(EncodeFrame)
+#define XProtocol_EncodeFrameSegments XPROTOCOL_FRAMING(EncodeFrameSegments)
+#define XProtocol_GetMaxEncodedLength XPROTOCOL_FRAMING(GetMaxEncodedLength)
+#define XProtocol_DecodeFrame XPROTOCOL_FRAMING(DecodeFrame)
+#define XProtocol_IsCompleteFrame XPROTOCOL_FRAMING(IsCompleteFrame)
+#define XProtocol_GetPayloadLength XPROTOCOL_FRAMING(GetPayloadLength)
+#define XProtocol_DecoderInitialize XPROTOCOL_FRAMING(DecoderInitialize)
+#define XProtocol_DecoderReset XPROTOCOL_FRAMING(DecoderReset)
+#define XProtocol_DecoderPush XPROTOCOL_FRAMING(DecoderPush)
+#define XProtocol_DecoderReserve XPROTOCOL_FRAMING(DecoderReserve)
+#define XProtocol_DecoderCommit XPROTOCOL_FRAMING(DecoderCommit)
+#endif /* XPROTOCOL_FRAMING */
+
+#include "Kiso_XProtocol.h"
+
+/**
+ * @brief
+ *      The XProtocol functions used by the benchmarks, see Kiso_XProtocol.h.
+ */
+typedef struct XProtocolFraming_S
+{
+    const char *Name;
+    Retcode_T (*EncodeFrame)(const uint8_t *data, uint32_t dataLength, uint32_t frameBufferSize, uint8_t *frame, uint32_t *frameLength);
+    uint32_t (*GetMaxEncodedLength)(uint32_t dataLength);
+    Retcode_T (*DecodeFrame)(const uint8_t *frame, uint32_t frameLength, uint32_t dataBufferSize, uint8_t *data, uint32_t *dataLength);
+    Retcode_T (*DecoderInitialize)(XProtocol_Decoder_T *decoder, uint8_t *buffer, uint32_t bufferSize, XProtocol_FrameCallback_T callback, void *callbackParam);
+    Retcode_T (*DecoderPush)(XProtocol_Decoder_T *decoder, const uint8_t *data, uint32_t length);
+} XProtocolFraming_T;
+
+extern const XProtocolFraming_T XProtocolFraming_Escaping; /**< SD/ED framing with escaping */
+extern const XProtocolFraming_T XProtocolFraming_Cobs;     /**< COBS framing */
+
+#endif /* XPROTOCOLFRAMING_H_ */
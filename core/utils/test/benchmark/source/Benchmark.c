@@ -0,0 +1,417 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ * @brief
+ *      Host benchmark harness implementation
+ *
+ * @details
+ *      This source file implements following features:
+ *      - Benchmark_Run()
+ *      - Benchmark_Report()
+ *      - Benchmark_Keep()
+ *      - Benchmark_Main()
+ *
+ * @file
+ **/
+
+/* clock_gettime() is POSIX */
+#define _POSIX_C_SOURCE 199309L
+
+#include "Benchmark.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCHMARK_MAX_RESULTS 256U              /**< Maximum number of results per run */
+#define BENCHMARK_NAME_LENGTH 64U               /**< Maximum length of a benchmark name, including the terminator */
+#define BENCHMARK_UNIT_LENGTH 16U               /**< Maximum length of a unit, including the terminator */
+#define BENCHMARK_LINE_LENGTH 512U              /**< Maximum length of a line of a baseline file */
+#define BENCHMARK_DEFAULT_MIN_TIME_MS 100U      /**< Default minimum duration of one measurement */
+#define BENCHMARK_DEFAULT_REPETITIONS 5U        /**< Default number of measurements per benchmark */
+#define BENCHMARK_DEFAULT_THRESHOLD_PERCENT 10. /**< Default allowed slowdown against the baseline */
+#define BENCHMARK_NS_PER_MS 1000000.
+#define BENCHMARK_NS_PER_S 1000000000.
+
+/* Result of one benchmark or reported value */
+typedef struct Benchmark_Result_S
+{
+    char Name[BENCHMARK_NAME_LENGTH];
+    bool IsTimed;
+    uint32_t Iterations;
+    double NsPerOperation;
+    double BytesPerSecond;
+    double Value;
+    char Unit[BENCHMARK_UNIT_LENGTH];
+} Benchmark_Result_T;
+
+/* Command line options */
+typedef struct Benchmark_Options_S
+{
+    const char *Filter;
+    const char *JsonPath;
+    const char *BaselinePath;
+    double ThresholdPercent;
+    uint32_t MinTimeMs;
+    uint32_t Repetitions;
+} Benchmark_Options_T;
+
+static Benchmark_Result_T Results[BENCHMARK_MAX_RESULTS];
+static uint32_t ResultCount;
+static Benchmark_Options_T Options;
+static bool IsResultDropped;
+
+/* Written by Benchmark_Keep(), never read */
+static volatile uint32_t Sink;
+
+static double GetNanoseconds(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((double)now.tv_sec * BENCHMARK_NS_PER_S) + (double)now.tv_nsec;
+}
+
+static double Measure(Benchmark_Function_T function, void *param, uint32_t iterations)
+{
+    double start = GetNanoseconds();
+    function(param, iterations);
+    return GetNanoseconds() - start;
+}
+
+static Benchmark_Result_T *AddResult(const char *name)
+{
+    Benchmark_Result_T *result;
+
+    if (BENCHMARK_MAX_RESULTS <= ResultCount)
+    {
+        (void)fprintf(stderr, "Too many results, %s dropped\n", name);
+        IsResultDropped = true;
+        return NULL;
+    }
+    result = &Results[ResultCount++];
+    memset(result, 0, sizeof(*result));
+    (void)snprintf(result->Name, sizeof(result->Name), "%s", name);
+    return result;
+}
+
+static bool IsSelected(const char *name)
+{
+    return (NULL == Options.Filter) || (NULL != strstr(name, Options.Filter));
+}
+
+/*  The description of the function is available in Benchmark.h */
+void Benchmark_Run(const char *name, Benchmark_Function_T function, void *param, uint32_t bytesPerOperation)
+{
+    Benchmark_Result_T *result;
+    double minTime = (double)Options.MinTimeMs * BENCHMARK_NS_PER_MS;
+    uint32_t iterations = 1U;
+    double elapsed;
+    double fastest;
+
+    if (!IsSelected(name))
+    {
+        return;
+    }
+    result = AddResult(name);
+    if (NULL == result)
+    {
+        return;
+    }
+
+    /* Warm up caches and grow the iteration count until a measurement is long enough to be accurate */
+    elapsed = Measure(function, param, iterations);
+    while ((elapsed < minTime) && (iterations < (UINT32_MAX / 100U)))
+    {
+        double scale = (elapsed > 0.) ? ((minTime * 1.2) / elapsed) : 100.;
+        scale = (scale < 2.) ? 2. : ((scale > 100.) ? 100. : scale);
+        iterations = (uint32_t)((double)iterations * scale);
+        elapsed = Measure(function, param, iterations);
+    }
+
+    /* The fastest measurement is the one least disturbed by the rest of the system */
+    fastest = elapsed;
+    for (uint32_t repetition = 1U; repetition < Options.Repetitions; repetition++)
+    {
+        elapsed = Measure(function, param, iterations);
+        fastest = (elapsed < fastest) ? elapsed : fastest;
+    }
+
+    result->IsTimed = true;
+    result->Iterations = iterations;
+    result->NsPerOperation = fastest / (double)iterations;
+    if ((0U < bytesPerOperation) && (0. < result->NsPerOperation))
+    {
+        result->BytesPerSecond = ((double)bytesPerOperation * BENCHMARK_NS_PER_S) / result->NsPerOperation;
+    }
+
+    if (0. < result->BytesPerSecond)
+    {
+        (void)printf("%-52s %12.1f ns/op %12.1f MB/s\n", result->Name, result->NsPerOperation, result->BytesPerSecond / 1.e6);
+    }
+    else
+    {
+        (void)printf("%-52s %12.1f ns/op\n", result->Name, result->NsPerOperation);
+    }
+}
+
+/*  The description of the function is available in Benchmark.h */
+void Benchmark_Report(const char *name, double value, const char *unit)
+{
+    Benchmark_Result_T *result;
+
+    if (!IsSelected(name))
+    {
+        return;
+    }
+    result = AddResult(name);
+    if (NULL == result)
+    {
+        return;
+    }
+    result->Value = value;
+    (void)snprintf(result->Unit, sizeof(result->Unit), "%s", unit);
+
+    (void)printf("%-52s %12.1f %s\n", result->Name, result->Value, result->Unit);
+}
+
+/*  The description of the function is available in Benchmark.h */
+void Benchmark_Keep(uint32_t value)
+{
+    Sink = Sink + value;
+}
+
+static bool WriteJson(const char *path)
+{
+    FILE *file = fopen(path, "w");
+
+    if (NULL == file)
+    {
+        (void)fprintf(stderr, "Cannot write %s\n", path);
+        return false;
+    }
+
+    /* One result per line, which keeps the baseline parser trivial */
+    (void)fprintf(file, "{\n  \"benchmarks\": [\n");
+    for (uint32_t i = 0U; i < ResultCount; i++)
+    {
+        const Benchmark_Result_T *result = &Results[i];
+        const char *separator = ((i + 1U) < ResultCount) ? "," : "";
+
+        if (result->IsTimed)
+        {
+            (void)fprintf(file, "    {\"name\": \"%s\", \"iterations\": %lu, \"ns_per_op\": %.3f, \"bytes_per_second\": %.1f}%s\n",
+                          result->Name, (unsigned long)result->Iterations, result->NsPerOperation, result->BytesPerSecond, separator);
+        }
+        else
+        {
+            (void)fprintf(file, "    {\"name\": \"%s\", \"value\": %.3f, \"unit\": \"%s\"}%s\n",
+                          result->Name, result->Value, result->Unit, separator);
+        }
+    }
+    (void)fprintf(file, "  ]\n}\n");
+
+    return (0 == fclose(file));
+}
+
+/* Reads the number following "key": in line, if any */
+static bool GetNumber(const char *line, const char *key, double *value)
+{
+    const char *position = strstr(line, key);
+    char *end;
+
+    if (NULL == position)
+    {
+        return false;
+    }
+    position += strlen(key);
+    *value = strtod(position, &end);
+    return (end != position);
+}
+
+/* Reads the value of "name": in line, if any */
+static bool GetName(const char *line, char *name, size_t size)
+{
+    static const char key[] = "\"name\": \"";
+    const char *position = strstr(line, key);
+    const char *end;
+
+    if (NULL == position)
+    {
+        return false;
+    }
+    position += sizeof(key) - 1U;
+    end = strchr(position, '"');
+    if ((NULL == end) || ((size_t)(end - position) >= size))
+    {
+        return false;
+    }
+    memcpy(name, position, (size_t)(end - position));
+    name[end - position] = '\0';
+    return true;
+}
+
+static const Benchmark_Result_T *FindResult(const char *name)
+{
+    for (uint32_t i = 0U; i < ResultCount; i++)
+    {
+        if (Results[i].IsTimed && (0 == strcmp(Results[i].Name, name)))
+        {
+            return &Results[i];
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Compares the timed results with a baseline written by --json. A baseline entry may carry a
+ * "threshold_percent" of its own for benchmarks which are known to be noisy.
+ */
+static int CheckBaseline(const char *path)
+{
+    char line[BENCHMARK_LINE_LENGTH];
+    char name[BENCHMARK_NAME_LENGTH];
+    uint32_t compared = 0U;
+    uint32_t regressed = 0U;
+    FILE *file = fopen(path, "r");
+
+    if (NULL == file)
+    {
+        (void)fprintf(stderr, "Cannot read baseline %s\n", path);
+        return 2;
+    }
+
+    while (NULL != fgets(line, (int)sizeof(line), file))
+    {
+        const Benchmark_Result_T *result;
+        double baseline;
+        double threshold = Options.ThresholdPercent;
+        double limit;
+
+        if (!GetName(line, name, sizeof(name)) || !GetNumber(line, "\"ns_per_op\":", &baseline))
+        {
+            continue;
+        }
+        result = FindResult(name);
+        if (NULL == result)
+        {
+            continue;
+        }
+        (void)GetNumber(line, "\"threshold_percent\":", &threshold);
+
+        compared++;
+        limit = baseline * (1. + (threshold / 100.));
+        if (result->NsPerOperation > limit)
+        {
+            regressed++;
+            (void)printf("REGRESSION %s: %.1f ns/op, baseline %.1f ns/op (+%.1f%%, allowed %.1f%%)\n",
+                         name, result->NsPerOperation, baseline, ((result->NsPerOperation / baseline) - 1.) * 100., threshold);
+        }
+    }
+    (void)fclose(file);
+
+    (void)printf("%lu of %lu benchmarks compared with the baseline regressed\n", (unsigned long)regressed, (unsigned long)compared);
+    return (0U < regressed) ? 1 : 0;
+}
+
+static const char *GetOption(const char *argument, const char *option)
+{
+    size_t length = strlen(option);
+
+    return (0 == strncmp(argument, option, length)) ? (argument + length) : NULL;
+}
+
+static bool ParseArguments(int argc, char *argv[])
+{
+    Options.Filter = NULL;
+    Options.JsonPath = NULL;
+    Options.BaselinePath = NULL;
+    Options.ThresholdPercent = BENCHMARK_DEFAULT_THRESHOLD_PERCENT;
+    Options.MinTimeMs = BENCHMARK_DEFAULT_MIN_TIME_MS;
+    Options.Repetitions = BENCHMARK_DEFAULT_REPETITIONS;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *value;
+
+        if (NULL != (value = GetOption(argv[i], "--filter=")))
+        {
+            Options.Filter = value;
+        }
+        else if (NULL != (value = GetOption(argv[i], "--json=")))
+        {
+            Options.JsonPath = value;
+        }
+        else if (NULL != (value = GetOption(argv[i], "--baseline=")))
+        {
+            Options.BaselinePath = value;
+        }
+        else if (NULL != (value = GetOption(argv[i], "--threshold=")))
+        {
+            Options.ThresholdPercent = strtod(value, NULL);
+        }
+        else if (NULL != (value = GetOption(argv[i], "--min-time-ms=")))
+        {
+            Options.MinTimeMs = (uint32_t)strtoul(value, NULL, 10);
+        }
+        else if (NULL != (value = GetOption(argv[i], "--repetitions=")))
+        {
+            Options.Repetitions = (uint32_t)strtoul(value, NULL, 10);
+        }
+        else
+        {
+            (void)fprintf(stderr, "Usage: %s [--filter=TEXT] [--json=FILE] [--baseline=FILE] [--threshold=PERCENT] "
+                                  "[--min-time-ms=MS] [--repetitions=N]\n",
+                          argv[0]);
+            return false;
+        }
+    }
+    Options.Repetitions = (0U < Options.Repetitions) ? Options.Repetitions : 1U;
+    return true;
+}
+
+/*  The description of the function is available in Benchmark.h */
+int Benchmark_Main(int argc, char *argv[], const Benchmark_Suite_T *suites, uint32_t suiteCount)
+{
+    int status = 0;
+
+    if (!ParseArguments(argc, argv))
+    {
+        return 2;
+    }
+
+    ResultCount = 0U;
+    IsResultDropped = false;
+    for (uint32_t i = 0U; i < suiteCount; i++)
+    {
+        suites[i]();
+    }
+
+    if ((NULL != Options.JsonPath) && !WriteJson(Options.JsonPath))
+    {
+        status = 2;
+    }
+    if ((0 == status) && (NULL != Options.BaselinePath))
+    {
+        status = CheckBaseline(Options.BaselinePath);
+    }
+    if ((0 == status) && IsResultDropped)
+    {
+        status = 2;
+    }
+    return status;
+}
@@ -0,0 +1,35 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ * @brief
+ *      CRC with CRC-32 slicing-by-4 table lookup, see CRCVariant.h
+ *
+ * @file
+ **/
+
+#define KISO_CRC_TABLE_DRIVEN 1
+#define KISO_CRC32_SLICING_BY_4 1
+#define KISO_CRC_HARDWARE_OFFLOAD 0
+#define CRC_VARIANT(name) CRCSlicingBy4_##name
+
+#include "CRCVariant.h"
+#include "CRC.c"
+
+const CRCVariant_T CRCVariant_SlicingBy4 = {
+    .Name = "SlicingBy4",
+    .Crc16 = CRC_16,
+    .Crc32 = CRC_32,
+    .Crc32Reverse = CRC_32_Reverse,
+};
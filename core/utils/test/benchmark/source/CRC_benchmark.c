@@ -0,0 +1,172 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ * @brief
+ *      Benchmarks of the CRC module, comparing the bit-serial, table and slicing-by-4 implementations
+ *
+ * @file
+ **/
+
+#include "Benchmark.h"
+#include "UtilsBenchmarks.h"
+
+#include "CRCVariant.h"
+
+#include <stdio.h>
+
+#define CRC_BENCHMARK_MAX_LENGTH 1024U
+
+typedef struct CRC_Benchmark_S
+{
+    CRC_Params_T Params;
+    uint32_t Length;
+} CRC_Benchmark_T;
+
+typedef struct CRC_VariantBenchmark_S
+{
+    const CRCVariant_T *Variant;
+    uint32_t Length;
+} CRC_VariantBenchmark_T;
+
+static uint8_t Data[CRC_BENCHMARK_MAX_LENGTH];
+
+static void Run_Crc16(void *param, uint32_t iterations)
+{
+    const CRC_Benchmark_T *benchmark = (const CRC_Benchmark_T *)param;
+    uint16_t shifter = UINT16_C(0xFFFF);
+
+    for (uint32_t i = 0U; i < iterations; i++)
+    {
+        (void)CRC_16(UINT16_C(0x1021), &shifter, Data, (uint16_t)benchmark->Length);
+    }
+    Benchmark_Keep(shifter);
+}
+
+static void Run_Crc32Reverse(void *param, uint32_t iterations)
+{
+    const CRC_Benchmark_T *benchmark = (const CRC_Benchmark_T *)param;
+    uint32_t shifter = UINT32_C(0xFFFFFFFF);
+
+    for (uint32_t i = 0U; i < iterations; i++)
+    {
+        (void)CRC_32_Reverse(CRC32_ETHERNET_REVERSE_POLYNOMIAL, &shifter, Data, (uint16_t)benchmark->Length);
+    }
+    Benchmark_Keep(shifter);
+}
+
+static void Run_Calculate(void *param, uint32_t iterations)
+{
+    const CRC_Benchmark_T *benchmark = (const CRC_Benchmark_T *)param;
+    uint32_t crc = 0U;
+
+    for (uint32_t i = 0U; i < iterations; i++)
+    {
+        (void)CRC_Calculate(&benchmark->Params, Data, benchmark->Length, &crc);
+        Data[0] = (uint8_t)crc;
+    }
+    Benchmark_Keep(crc);
+}
+
+static void Run_VariantCrc16(void *param, uint32_t iterations)
+{
+    const CRC_VariantBenchmark_T *benchmark = (const CRC_VariantBenchmark_T *)param;
+    uint16_t shifter = UINT16_C(0xFFFF);
+
+    for (uint32_t i = 0U; i < iterations; i++)
+    {
+        (void)benchmark->Variant->Crc16(UINT16_C(0x1021), &shifter, Data, (uint16_t)benchmark->Length);
+    }
+    Benchmark_Keep(shifter);
+}
+
+static void Run_VariantCrc32(void *param, uint32_t iterations)
+{
+    const CRC_VariantBenchmark_T *benchmark = (const CRC_VariantBenchmark_T *)param;
+    uint32_t shifter = UINT32_C(0xFFFFFFFF);
+
+    for (uint32_t i = 0U; i < iterations; i++)
+    {
+        (void)benchmark->Variant->Crc32(UINT32_C(0x04C11DB7), &shifter, Data, (uint16_t)benchmark->Length);
+    }
+    Benchmark_Keep(shifter);
+}
+
+static void Run_VariantCrc32Reverse(void *param, uint32_t iterations)
+{
+    const CRC_VariantBenchmark_T *benchmark = (const CRC_VariantBenchmark_T *)param;
+    uint32_t shifter = UINT32_C(0xFFFFFFFF);
+
+    for (uint32_t i = 0U; i < iterations; i++)
+    {
+        (void)benchmark->Variant->Crc32Reverse(CRC32_ETHERNET_REVERSE_POLYNOMIAL, &shifter, Data, (uint16_t)benchmark->Length);
+    }
+    Benchmark_Keep(shifter);
+}
+
+/*  The description of the function is available in UtilsBenchmarks.h */
+void CRC_Benchmark(void)
+{
+    static const uint32_t lengths[] = {16U, 256U, CRC_BENCHMARK_MAX_LENGTH};
+    static const struct
+    {
+        const char *Name;
+        CRC_Params_T Params;
+    } algorithms[] = {
+        {"CRC8_SMBUS", CRC_PARAMS_CRC8_SMBUS},
+        {"CRC16_IBM_3740", CRC_PARAMS_CRC16_IBM_3740},
+        {"CRC16_KERMIT", CRC_PARAMS_CRC16_KERMIT},
+        {"CRC32_ISO_HDLC", CRC_PARAMS_CRC32_ISO_HDLC},
+        {"CRC32_MPEG_2", CRC_PARAMS_CRC32_MPEG_2},
+    };
+    static const CRCVariant_T *const variants[] = {&CRCVariant_BitSerial, &CRCVariant_Table, &CRCVariant_SlicingBy4};
+    char name[64];
+
+    for (uint32_t i = 0U; i < CRC_BENCHMARK_MAX_LENGTH; i++)
+    {
+        Data[i] = (uint8_t)((i * 31U) + 7U);
+    }
+
+    for (uint32_t l = 0U; l < (sizeof(lengths) / sizeof(lengths[0])); l++)
+    {
+        CRC_Benchmark_T benchmark = {CRC_PARAMS_CRC16_IBM_3740, lengths[l]};
+
+        (void)snprintf(name, sizeof(name), "CRC/CRC_16/%lu", (unsigned long)lengths[l]);
+        Benchmark_Run(name, Run_Crc16, &benchmark, lengths[l]);
+
+        (void)snprintf(name, sizeof(name), "CRC/CRC_32_Reverse/%lu", (unsigned long)lengths[l]);
+        Benchmark_Run(name, Run_Crc32Reverse, &benchmark, lengths[l]);
+
+        for (uint32_t a = 0U; a < (sizeof(algorithms) / sizeof(algorithms[0])); a++)
+        {
+            benchmark.Params = algorithms[a].Params;
+            (void)snprintf(name, sizeof(name), "CRC/Calculate/%s/%lu", algorithms[a].Name, (unsigned long)lengths[l]);
+            Benchmark_Run(name, Run_Calculate, &benchmark, lengths[l]);
+        }
+
+        for (uint32_t v = 0U; v < (sizeof(variants) / sizeof(variants[0])); v++)
+        {
+            CRC_VariantBenchmark_T variant = {variants[v], lengths[l]};
+
+            (void)snprintf(name, sizeof(name), "CRC/%s/CRC_16/%lu", variants[v]->Name, (unsigned long)lengths[l]);
+            Benchmark_Run(name, Run_VariantCrc16, &variant, lengths[l]);
+
+            (void)snprintf(name, sizeof(name), "CRC/%s/CRC_32/%lu", variants[v]->Name, (unsigned long)lengths[l]);
+            Benchmark_Run(name, Run_VariantCrc32, &variant, lengths[l]);
+
+            (void)snprintf(name, sizeof(name), "CRC/%s/CRC_32_Reverse/%lu", variants[v]->Name, (unsigned long)lengths[l]);
+            Benchmark_Run(name, Run_VariantCrc32Reverse, &variant, lengths[l]);
+        }
+    }
+}
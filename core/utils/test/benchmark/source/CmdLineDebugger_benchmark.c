@@ -0,0 +1,84 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ * @brief
+ *      Benchmarks of the CmdLineDebugger module
+ *
+ * @file
+ **/
+
+#include "Benchmark.h"
+#include "UtilsBenchmarks.h"
+
+#include "Kiso_CmdLineDebugger.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define CMDLINEDEBUGGER_BENCHMARK_INPUT_SIZE 64U
+
+static uint32_t ExecutedCommands;
+
+static Retcode_T Command(uint32_t argc, const char *const *argv)
+{
+    KISO_UNUSED(argv);
+    ExecutedCommands += argc;
+    return RETCODE_OK;
+}
+
+static struct CmdLineDbg_Element_S Commands[] = {
+    {Command, "help", NULL},
+    {Command, "version", NULL},
+    {Command, "reset", NULL},
+    {Command, "led", NULL},
+    {Command, "button", NULL},
+    {Command, "sensor", NULL},
+    {Command, "uart", NULL},
+    {Command, "spi", NULL},
+    {Command, "i2c", NULL},
+    {Command, "flash", NULL},
+    {Command, "cellular", NULL},
+    {Command, "log", NULL},
+};
+
+/* CmdLineDbg_Parse() tokenizes in place, so every iteration starts from a fresh copy */
+static void Run_Parse(void *param, uint32_t iterations)
+{
+    const char *line = (const char *)param;
+    size_t length = strlen(line) + 1U;
+    char input[CMDLINEDEBUGGER_BENCHMARK_INPUT_SIZE];
+
+    ExecutedCommands = 0U;
+    for (uint32_t i = 0U; i < iterations; i++)
+    {
+        memcpy(input, line, length);
+        (void)CmdLineDbg_Parse(Commands, input);
+    }
+    Benchmark_Keep(ExecutedCommands);
+}
+
+/*  The description of the function is available in UtilsBenchmarks.h */
+void CmdLineDebugger_Benchmark(void)
+{
+    static char first[] = "help";
+    static char last[] = "log level 3 module 17";
+    static char unknown[] = "unknown command";
+
+    (void)CmdLineDbg_RegisterCmdArray(Commands, sizeof(Commands) / sizeof(Commands[0]));
+
+    Benchmark_Run("CmdLineDebugger/Parse/First", Run_Parse, first, (uint32_t)strlen(first));
+    Benchmark_Run("CmdLineDebugger/Parse/LastWithArguments", Run_Parse, last, (uint32_t)strlen(last));
+    Benchmark_Run("CmdLineDebugger/Parse/Unknown", Run_Parse, unknown, (uint32_t)strlen(unknown));
+}
@@ -0,0 +1,44 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ * @brief
+ *      Host replacements for the essentials services used by the benchmarked modules.
+ *
+ * @details
+ *      Benchmarks link the real module sources, which report errors through Retcode and check
+ *      assertions. On the host both simply end up on stderr.
+ *
+ * @file
+ **/
+
+#include "Kiso_Basics.h"
+#include "Kiso_Retcode.h"
+#include "Kiso_Assert.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Replaces the essentials implementation, errors raised while benchmarking are printed */
+void Retcode_RaiseError(Retcode_T error)
+{
+    (void)fprintf(stderr, "Error raised: 0x%08lx\n", (unsigned long)error);
+}
+
+/* Replaces the essentials implementation, failed assertions end the benchmark */
+void Assert_Dynamic(const unsigned long line, const unsigned char *const file)
+{
+    (void)fprintf(stderr, "Assertion failed: %s:%lu\n", (const char *)file, line);
+    abort();
+}
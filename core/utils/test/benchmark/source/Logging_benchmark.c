@@ -0,0 +1,57 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ * @brief
+ *      Benchmarks of the logging filter
+ *
+ * @file
+ **/
+
+#include "Kiso_Utils.h"
+#undef KISO_MODULE_ID
+#define KISO_MODULE_ID KISO_UTILS_MODULE_ID_LOGGING
+
+#include "Benchmark.h"
+#include "UtilsBenchmarks.h"
+
+#include "Kiso_Logging.h"
+
+#define LOGGING_BENCHMARK_PACKAGE UINT8_C(5)
+#define LOGGING_BENCHMARK_MODULE UINT8_C(17)
+#define LOGGING_BENCHMARK_ALL_MODULES UINT8_C(0) /**< Module id matching every module in a filter */
+
+static void Run_Apply(void *param, uint32_t iterations)
+{
+    LogLevel_T level = *(const LogLevel_T *)param;
+    uint32_t passed = 0U;
+
+    for (uint32_t i = 0U; i < iterations; i++)
+    {
+        passed += (uint32_t)LogFilter_Apply(level, LOGGING_BENCHMARK_PACKAGE, (uint8_t)(LOGGING_BENCHMARK_MODULE + (i & 7U)));
+    }
+    Benchmark_Keep(passed);
+}
+
+/*  The description of the function is available in UtilsBenchmarks.h */
+void Logging_Benchmark(void)
+{
+    static LogLevel_T passing = LOG_LEVEL_ERROR;
+    static LogLevel_T blocked = LOG_LEVEL_DEBUG;
+
+    (void)LogFilter_Configure(0U, LOG_LEVEL_WARNING, LOGGING_BENCHMARK_PACKAGE, LOGGING_BENCHMARK_ALL_MODULES);
+
+    Benchmark_Run("Logging/LogFilter_Apply/Passing", Run_Apply, &passing, 0U);
+    Benchmark_Run("Logging/LogFilter_Apply/Blocked", Run_Apply, &blocked, 0U);
+}
@@ -0,0 +1,36 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ * @brief
+ *      Runs the benchmarks of the utils package, see Benchmark.h for the command line.
+ *
+ * @file
+ **/
+
+#include "Benchmark.h"
+#include "UtilsBenchmarks.h"
+
+static const Benchmark_Suite_T Suites[] = {
+    CRC_Benchmark,
+    RingBuffer_Benchmark,
+    XProtocol_Benchmark,
+    Logging_Benchmark,
+    CmdLineDebugger_Benchmark,
+};
+
+int main(int argc, char *argv[])
+{
+    return Benchmark_Main(argc, argv, Suites, (uint32_t)(sizeof(Suites) / sizeof(Suites[0])));
+}
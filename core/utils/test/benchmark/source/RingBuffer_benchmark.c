@@ -0,0 +1,161 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ * @brief
+ *      Benchmarks of the RingBuffer module, with the former byte-wise copy loop as baseline
+ *
+ * @file
+ **/
+
+#include "Benchmark.h"
+#include "UtilsBenchmarks.h"
+
+#include "Kiso_RingBuffer.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define RINGBUFFER_BENCHMARK_SIZE 1024U
+#define RINGBUFFER_BENCHMARK_MAX_CHUNK 256U
+
+static uint8_t BufferSpace[RINGBUFFER_BENCHMARK_SIZE];
+static uint8_t Chunk[RINGBUFFER_BENCHMARK_MAX_CHUNK];
+static RingBuffer_T RingBuffer;
+
+/* The byte-wise copy with a modulo full check per byte, which RingBuffer.c used before the block copies */
+static uint32_t ByteWise_Write(RingBuffer_T *ringBuffer, const uint8_t *data, uint32_t length)
+{
+    uint32_t actualLength = 0UL;
+
+    while ((((ringBuffer->WriteIndex + 1UL) % ringBuffer->Size) != ringBuffer->ReadIndex) && length--)
+    {
+        uint32_t index = ringBuffer->WriteIndex;
+
+        ringBuffer->Base[index++] = data[actualLength++];
+        ringBuffer->WriteIndex = (ringBuffer->Size != index) ? index : 0UL;
+    }
+    return actualLength;
+}
+
+static uint32_t ByteWise_Read(RingBuffer_T *ringBuffer, uint8_t *data, uint32_t length)
+{
+    uint32_t actualLength = 0UL;
+
+    while ((ringBuffer->ReadIndex != ringBuffer->WriteIndex) && length--)
+    {
+        uint32_t index = ringBuffer->ReadIndex;
+
+        data[actualLength++] = ringBuffer->Base[index++];
+        ringBuffer->ReadIndex = (ringBuffer->Size != index) ? index : 0UL;
+    }
+    return actualLength;
+}
+
+static void Run_ByteWiseWriteRead(void *param, uint32_t iterations)
+{
+    uint32_t length = *(const uint32_t *)param;
+    uint32_t sum = 0U;
+
+    RingBuffer_Initialize(&RingBuffer, BufferSpace, RINGBUFFER_BENCHMARK_SIZE);
+    for (uint32_t i = 0U; i < iterations; i++)
+    {
+        sum += ByteWise_Write(&RingBuffer, Chunk, length);
+        sum += ByteWise_Read(&RingBuffer, Chunk, length);
+    }
+    Benchmark_Keep(sum);
+}
+
+/* Every iteration writes and reads one chunk, so the indices keep wrapping around */
+static void Run_WriteRead(void *param, uint32_t iterations)
+{
+    uint32_t length = *(const uint32_t *)param;
+    uint32_t sum = 0U;
+
+    RingBuffer_Initialize(&RingBuffer, BufferSpace, RINGBUFFER_BENCHMARK_SIZE);
+    for (uint32_t i = 0U; i < iterations; i++)
+    {
+        sum += RingBuffer_Write(&RingBuffer, Chunk, length);
+        sum += RingBuffer_Read(&RingBuffer, Chunk, length);
+    }
+    Benchmark_Keep(sum);
+}
+
+static void Run_ReserveCommitPeekConsume(void *param, uint32_t iterations)
+{
+    uint32_t length = *(const uint32_t *)param;
+    RingBuffer_Region_T regions[RINGBUFFER_REGION_COUNT];
+    uint32_t sum = 0U;
+
+    RingBuffer_Initialize(&RingBuffer, BufferSpace, RINGBUFFER_BENCHMARK_SIZE);
+    for (uint32_t i = 0U; i < iterations; i++)
+    {
+        uint32_t copied = 0U;
+
+        (void)RingBuffer_Reserve(&RingBuffer, regions);
+        for (uint32_t r = 0U; (r < RINGBUFFER_REGION_COUNT) && (copied < length); r++)
+        {
+            uint32_t part = ((length - copied) < regions[r].Length) ? (length - copied) : regions[r].Length;
+            memcpy(regions[r].Data, &Chunk[copied], part);
+            copied += part;
+        }
+        sum += RingBuffer_Commit(&RingBuffer, copied);
+
+        (void)RingBuffer_Peek(&RingBuffer, regions);
+        sum += regions[0].Data[0];
+        sum += RingBuffer_Consume(&RingBuffer, copied);
+    }
+    Benchmark_Keep(sum);
+}
+
+static void Run_Records(void *param, uint32_t iterations)
+{
+    uint32_t length = *(const uint32_t *)param;
+    uint32_t sum = 0U;
+
+    RingBuffer_InitializeRecords(&RingBuffer, BufferSpace, RINGBUFFER_BENCHMARK_SIZE, false);
+    for (uint32_t i = 0U; i < iterations; i++)
+    {
+        sum += (uint32_t)RingBuffer_WriteRecord(&RingBuffer, Chunk, length);
+        sum += RingBuffer_ReadRecord(&RingBuffer, Chunk, RINGBUFFER_BENCHMARK_MAX_CHUNK);
+    }
+    Benchmark_Keep(sum);
+}
+
+/*  The description of the function is available in UtilsBenchmarks.h */
+void RingBuffer_Benchmark(void)
+{
+    static uint32_t lengths[] = {1U, 16U, RINGBUFFER_BENCHMARK_MAX_CHUNK};
+    char name[64];
+
+    for (uint32_t i = 0U; i < RINGBUFFER_BENCHMARK_MAX_CHUNK; i++)
+    {
+        Chunk[i] = (uint8_t)i;
+    }
+
+    for (uint32_t l = 0U; l < (sizeof(lengths) / sizeof(lengths[0])); l++)
+    {
+        (void)snprintf(name, sizeof(name), "RingBuffer/WriteRead/%lu", (unsigned long)lengths[l]);
+        Benchmark_Run(name, Run_WriteRead, &lengths[l], lengths[l]);
+
+        (void)snprintf(name, sizeof(name), "RingBuffer/ByteWiseWriteRead/%lu", (unsigned long)lengths[l]);
+        Benchmark_Run(name, Run_ByteWiseWriteRead, &lengths[l], lengths[l]);
+
+        (void)snprintf(name, sizeof(name), "RingBuffer/ReserveCommitPeekConsume/%lu", (unsigned long)lengths[l]);
+        Benchmark_Run(name, Run_ReserveCommitPeekConsume, &lengths[l], lengths[l]);
+
+        (void)snprintf(name, sizeof(name), "RingBuffer/WriteReadRecord/%lu", (unsigned long)lengths[l]);
+        Benchmark_Run(name, Run_Records, &lengths[l], lengths[l]);
+    }
+}
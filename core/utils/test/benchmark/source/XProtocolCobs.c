@@ -0,0 +1,35 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ * @brief
+ *      XProtocol with COBS framing, see XProtocolFraming.h
+ *
+ * @file
+ **/
+
+#define KISO_XPROTOCOL_COBS 1
+#define XPROTOCOL_FRAMING(name) XProtocolCobs_##name
+
+#include "XProtocolFraming.h"
+#include "XProtocol.c"
+
+const XProtocolFraming_T XProtocolFraming_Cobs = {
+    .Name = "Cobs",
+    .EncodeFrame = XProtocol_EncodeFrame,
+    .GetMaxEncodedLength = XProtocol_GetMaxEncodedLength,
+    .DecodeFrame = XProtocol_DecodeFrame,
+    .DecoderInitialize = XProtocol_DecoderInitialize,
+    .DecoderPush = XProtocol_DecoderPush,
+};
@@ -0,0 +1,159 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ * @brief
+ *      Benchmarks of the XProtocol module, comparing the framing with escaping to COBS framing
+ *
+ * @details
+ *      Both framings are measured in CPU time and in bytes on the wire, for payloads which need no
+ *      escaping, random binary payloads and payloads consisting of delimiters and escape characters
+ *      only.
+ *
+ * @file
+ **/
+
+#include "Benchmark.h"
+#include "UtilsBenchmarks.h"
+#include "XProtocolFraming.h"
+
+#include <stdio.h>
+
+#define XPROTOCOL_BENCHMARK_MAX_LENGTH 1024U
+#define XPROTOCOL_BENCHMARK_MAX_FRAME_LENGTH (6U + (2U * XPROTOCOL_BENCHMARK_MAX_LENGTH))
+
+/* Contents of the benchmarked payloads */
+enum XProtocol_Payload_E
+{
+    XPROTOCOL_PAYLOAD_TEXT = 0, /**< Printable characters, nothing to escape and no zeros */
+    XPROTOCOL_PAYLOAD_BINARY,   /**< Pseudo random bytes */
+    XPROTOCOL_PAYLOAD_SPECIAL,  /**< Delimiters and escape characters of both framings only */
+    XPROTOCOL_PAYLOAD_COUNT
+};
+
+typedef struct XProtocol_Benchmark_S
+{
+    const XProtocolFraming_T *Framing;
+    uint32_t Length;
+    uint32_t FrameLength;
+} XProtocol_Benchmark_T;
+
+static uint8_t Payload[XPROTOCOL_BENCHMARK_MAX_LENGTH];
+static uint8_t Frame[XPROTOCOL_BENCHMARK_MAX_FRAME_LENGTH];
+static uint8_t Decoded[XPROTOCOL_BENCHMARK_MAX_LENGTH];
+static uint32_t DecodedFrames;
+
+static void FrameReceived(const uint8_t *payload, uint32_t payloadLength, void *callbackParam)
+{
+    KISO_UNUSED(payload);
+    KISO_UNUSED(callbackParam);
+    DecodedFrames += payloadLength;
+}
+
+static void Run_Encode(void *param, uint32_t iterations)
+{
+    const XProtocol_Benchmark_T *benchmark = (const XProtocol_Benchmark_T *)param;
+    uint32_t frameLength = 0U;
+
+    for (uint32_t i = 0U; i < iterations; i++)
+    {
+        (void)benchmark->Framing->EncodeFrame(Payload, benchmark->Length, sizeof(Frame), Frame, &frameLength);
+    }
+    Benchmark_Keep(frameLength);
+}
+
+static void Run_Decode(void *param, uint32_t iterations)
+{
+    const XProtocol_Benchmark_T *benchmark = (const XProtocol_Benchmark_T *)param;
+    uint32_t dataLength = 0U;
+
+    for (uint32_t i = 0U; i < iterations; i++)
+    {
+        (void)benchmark->Framing->DecodeFrame(Frame, benchmark->FrameLength, sizeof(Decoded), Decoded, &dataLength);
+    }
+    Benchmark_Keep(dataLength);
+}
+
+static void Run_DecoderPush(void *param, uint32_t iterations)
+{
+    const XProtocol_Benchmark_T *benchmark = (const XProtocol_Benchmark_T *)param;
+    XProtocol_Decoder_T decoder;
+
+    DecodedFrames = 0U;
+    (void)benchmark->Framing->DecoderInitialize(&decoder, Decoded, sizeof(Decoded), FrameReceived, NULL);
+    for (uint32_t i = 0U; i < iterations; i++)
+    {
+        (void)benchmark->Framing->DecoderPush(&decoder, Frame, benchmark->FrameLength);
+    }
+    Benchmark_Keep(DecodedFrames);
+}
+
+static void Fill_Payload(enum XProtocol_Payload_E kind)
+{
+    static const uint8_t special[] = {0x00, 0xC0, 0xC9, 0xDB};
+    uint32_t random = UINT32_C(12345);
+
+    for (uint32_t i = 0U; i < XPROTOCOL_BENCHMARK_MAX_LENGTH; i++)
+    {
+        random = (random * UINT32_C(1103515245)) + UINT32_C(12345);
+        switch (kind)
+        {
+        case XPROTOCOL_PAYLOAD_TEXT:
+            Payload[i] = (uint8_t)(' ' + (i % 95U));
+            break;
+        case XPROTOCOL_PAYLOAD_BINARY:
+            Payload[i] = (uint8_t)(random >> 24);
+            break;
+        default:
+            Payload[i] = special[i % sizeof(special)];
+            break;
+        }
+    }
+}
+
+/*  The description of the function is available in UtilsBenchmarks.h */
+void XProtocol_Benchmark(void)
+{
+    static const XProtocolFraming_T *const framings[] = {&XProtocolFraming_Escaping, &XProtocolFraming_Cobs};
+    static const char *const kinds[XPROTOCOL_PAYLOAD_COUNT] = {"Text", "Binary", "Special"};
+    static const uint32_t lengths[] = {16U, 256U, XPROTOCOL_BENCHMARK_MAX_LENGTH};
+    char name[64];
+
+    for (uint32_t k = 0U; k < (uint32_t)XPROTOCOL_PAYLOAD_COUNT; k++)
+    {
+        Fill_Payload((enum XProtocol_Payload_E)k);
+        for (uint32_t l = 0U; l < (sizeof(lengths) / sizeof(lengths[0])); l++)
+        {
+            for (uint32_t f = 0U; f < (sizeof(framings) / sizeof(framings[0])); f++)
+            {
+                XProtocol_Benchmark_T benchmark = {framings[f], lengths[l], 0U};
+                const char *framing = framings[f]->Name;
+
+                (void)framings[f]->EncodeFrame(Payload, lengths[l], sizeof(Frame), Frame, &benchmark.FrameLength);
+                (void)snprintf(name, sizeof(name), "XProtocol/%s/FrameLength/%s/%lu", framing, kinds[k], (unsigned long)lengths[l]);
+                Benchmark_Report(name, (double)benchmark.FrameLength, "bytes");
+
+                (void)snprintf(name, sizeof(name), "XProtocol/%s/EncodeFrame/%s/%lu", framing, kinds[k], (unsigned long)lengths[l]);
+                Benchmark_Run(name, Run_Encode, &benchmark, lengths[l]);
+
+                /* Run_Encode() leaves the same frame in the buffer */
+                (void)snprintf(name, sizeof(name), "XProtocol/%s/DecodeFrame/%s/%lu", framing, kinds[k], (unsigned long)lengths[l]);
+                Benchmark_Run(name, Run_Decode, &benchmark, lengths[l]);
+
+                (void)snprintf(name, sizeof(name), "XProtocol/%s/DecoderPush/%s/%lu", framing, kinds[k], (unsigned long)lengths[l]);
+                Benchmark_Run(name, Run_DecoderPush, &benchmark, lengths[l]);
+            }
+        }
+    }
+}
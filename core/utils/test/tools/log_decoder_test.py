@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+
+"""
+Binary Log Decoder Test
+***********************
+
+:module: log_decoder_test
+
+:platform: Windows, Linux, MacOS
+:synopsis: Round trip test of core/utils/tools/log_decoder.py.
+Records are packed and framed like Logging_BinaryRecorder does on the target,
+with the format strings in a minimal ELF file, and decoded by running the
+decoder as the user would. The expected lines are the output of printf() on a
+32 bit target.
+
+:Copyright: Copyright (c) 2010-2019 Robert Bosch GmbH
+
+    This program and the accompanying materials are made available under the
+    terms of the Eclipse Public License 2.0 which is available at
+    http://www.eclipse.org/legal/epl-2.0.
+
+    SPDX-License-Identifier: EPL-2.0
+
+    Contributors:
+        Robert Bosch GmbH - initial contribution
+"""
+
+import os
+import struct
+import subprocess
+import sys
+import tempfile
+import unittest
+
+DECODER = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', '..', 'tools', 'log_decoder.py')
+
+XPROTOCOL_SD = 0xC0
+XPROTOCOL_ED = 0xC9
+XPROTOCOL_ESC = 0xDB
+XPROTOCOL_ESCAPE = {XPROTOCOL_SD: 0xDC, XPROTOCOL_ED: 0xDE, XPROTOCOL_ESC: 0xDD}
+
+RODATA_ADDRESS = 0x08001000
+FILE_NAME = 'app.c'
+LOG_LEVEL_WARNING = 3
+
+
+def crc16(data):
+    """ CRC-16 as calculated by XProtocol, polynomial 0x1021 and initial value 0. """
+    crc = 0
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def escaping_frame(payload):
+    """ SD, checksum and payload with the delimiters escaped, ED. """
+    content = bytes([crc16(payload) >> 8, crc16(payload) & 0xFF]) + payload
+    frame = bytearray([XPROTOCOL_SD])
+    for byte in content:
+        frame += bytes([XPROTOCOL_ESC, XPROTOCOL_ESCAPE[byte]]) if (byte in XPROTOCOL_ESCAPE) else bytes([byte])
+    frame.append(XPROTOCOL_ED)
+    return bytes(frame)
+
+
+def cobs_frame(payload):
+    """ Payload and checksum, COBS encoded and terminated by 0x00. """
+    content = payload + bytes([crc16(payload) >> 8, crc16(payload) & 0xFF])
+    frame = bytearray()
+    block = bytearray()
+    for byte in content:
+        if 0 == byte:
+            frame += bytes([len(block) + 1]) + block
+            block = bytearray()
+            continue
+        block.append(byte)
+        if 0xFE == len(block):
+            frame += bytes([0xFF]) + block
+            block = bytearray()
+    frame += bytes([len(block) + 1]) + block
+    frame.append(0)
+    return bytes(frame)
+
+
+def elf_image(strings):
+    """ A 32 bit little-endian ELF file with the strings in one loaded section, and their addresses. """
+    data = bytearray()
+    addresses = []
+    for string in strings:
+        addresses.append(RODATA_ADDRESS + len(data))
+        data += string.encode() + b'\0'
+    header_size = 52
+    section_header_offset = header_size + len(data)
+    header = bytearray(header_size)
+    header[0:6] = b'\x7fELF\x01\x01'
+    struct.pack_into('<I', header, 0x20, section_header_offset)
+    struct.pack_into('<HH', header, 0x2E, 40, 2)
+    null_section = bytes(40)
+    rodata_section = struct.pack('<IIIIIIIIII', 0, 1, 0x2, RODATA_ADDRESS, header_size, len(data), 0, 0, 4, 0)
+    return bytes(header) + bytes(data) + null_section + rodata_section, addresses
+
+
+def record(fmt_address, file_address, arguments, line=42, flags=0):
+    """ A record as written by the binary recorder, arguments are (struct format, value) pairs. """
+    payload = struct.pack('<BBBBIIII', flags, LOG_LEVEL_WARNING, 1, 2, 1000, fmt_address, file_address, line)
+    for kind, value in arguments:
+        payload += struct.pack('<' + kind, value)
+    return payload
+
+
+def word(value):
+    """ An int, long or pointer argument as packed on the target: 4 bytes of the promoted value. """
+    return ('I', value & 0xFFFFFFFF)
+
+
+class LogDecoderTest(unittest.TestCase):
+    """ Encodes records of format strings and their arguments, decodes them and compares the messages. """
+
+    CASES = [
+        # Format, arguments as packed on the target, printf() output on the target
+        ('%hhu', [word(300)], '44'),
+        ('%hhd', [word(200)], '-56'),
+        ('%hhd', [word(-1)], '-1'),
+        ('%hhx', [word(0x1234)], '34'),
+        ('%hd', [word(40000)], '-25536'),
+        ('%hu', [word(-1)], '65535'),
+        ('%04hX', [word(0x12345)], '2345'),
+        ('%#ho', [word(0x10008)], '010'),
+        ('%d %u %x', [word(-7), word(-1), word(0xBEEF)], '-7 4294967295 beef'),
+        ('%lld %llx', [('Q', (-2) & 0xFFFFFFFFFFFFFFFF), ('Q', 0x123456789)], '-2 123456789'),
+        ('%*d|%-*hhd|', [word(5), word(12), word(4), word(255)], '   12|-1  |'),
+        ('%s=%c %.2f', [('B', 3), ('3s', b'key'), word(ord('v')), ('d', 2.5)], 'key=v 2.50'),
+    ]
+
+    def decode(self, frames, framing):
+        strings = [case[0] for case in self.CASES] + [FILE_NAME]
+        image, addresses = elf_image(strings)
+        with tempfile.TemporaryDirectory() as directory:
+            elf_path = os.path.join(directory, 'app.elf')
+            with open(elf_path, 'wb') as elf:
+                elf.write(image)
+            result = subprocess.run([sys.executable, DECODER, '--framing', framing, elf_path, '-'],
+                                    input=frames(addresses), stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+        return result.returncode, result.stdout.decode().splitlines(), result.stderr.decode()
+
+    def records(self, addresses):
+        return [record(addresses[i], addresses[-1], case[1]) for i, case in enumerate(self.CASES)]
+
+    def check_round_trip(self, framing, frame):
+        code, lines, errors = self.decode(lambda addresses: b''.join(frame(r) for r in self.records(addresses)), framing)
+        self.assertEqual(0, code, errors)
+        self.assertEqual(len(self.CASES), len(lines))
+        for (fmt, _, expected), line in zip(self.CASES, lines):
+            self.assertEqual('1000 W 1\t[{}:42]\t{}'.format(FILE_NAME, expected), line, fmt)
+
+    def test_escaping(self):
+        self.check_round_trip('escaping', escaping_frame)
+
+    def test_cobs(self):
+        self.check_round_trip('cobs', cobs_frame)
+
+    def test_cut_arguments(self):
+        # The second argument did not fit into the record
+        code, lines, _ = self.decode(
+            lambda addresses: escaping_frame(record(addresses[8], addresses[-1], [word(1)], flags=0x01)), 'escaping')
+        self.assertEqual(0, code)
+        self.assertEqual(['1000 W 1\t[{}:42]\t1  ...'.format(FILE_NAME)], lines)
+
+    def test_wrong_checksum(self):
+        def frames(addresses):
+            frame = bytearray(escaping_frame(record(addresses[0], addresses[-1], [word(1)])))
+            frame[1] ^= 0x01
+            return bytes(frame)
+        code, lines, errors = self.decode(frames, 'escaping')
+        self.assertEqual(1, code)
+        self.assertEqual([], lines)
+        self.assertIn('1 frames with a wrong checksum', errors)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -41,6 +41,10 @@ FAKE_VALUE_FUNC(Retcode_T, CRC_8, uint8_t, uint8_t *, const uint8_t *, uint16_t)
 FAKE_VALUE_FUNC(Retcode_T, CRC_16, uint16_t, uint16_t *, const uint8_t *, uint16_t)
 FAKE_VALUE_FUNC(Retcode_T, CRC_32, uint32_t, uint32_t *, const uint8_t *, uint16_t)
 FAKE_VALUE_FUNC(Retcode_T, CRC_32_Reverse, uint32_t, uint32_t *, const uint8_t *, uint16_t)
+FAKE_VALUE_FUNC(Retcode_T, CRC_Initialize, CRC_Context_T *, const CRC_Params_T *)
+FAKE_VALUE_FUNC(Retcode_T, CRC_Update, CRC_Context_T *, const uint8_t *, uint32_t)
+FAKE_VALUE_FUNC(Retcode_T, CRC_Finalize, const CRC_Context_T *, uint32_t *)
+FAKE_VALUE_FUNC(Retcode_T, CRC_Calculate, const CRC_Params_T *, const uint8_t *, uint32_t, uint32_t *)
 
 #endif /* KISO_CRC_TH_HH_*/
 
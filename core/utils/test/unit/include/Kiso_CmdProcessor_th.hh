@@ -47,6 +47,12 @@ FAKE_VOID_FUNC(CmdProcessor_Resume, CmdProcessor_T *)
 FAKE_VALUE_FUNC(Retcode_T, CmdProcessor_Initialize, CmdProcessor_T *, const char *, uint32_t, uint32_t, uint32_t)
 FAKE_VALUE_FUNC(Retcode_T, CmdProcessor_Enqueue, CmdProcessor_T *, CmdProcessor_Func_T, void *, uint32_t)
 FAKE_VALUE_FUNC(Retcode_T, CmdProcessor_EnqueueFromIsr, CmdProcessor_T *, CmdProcessor_Func_T, void *, uint32_t)
+FAKE_VALUE_FUNC(Retcode_T, CmdProcessor_InitializeLanes, CmdProcessor_T *, const char *, uint32_t, uint32_t, const uint32_t *)
+FAKE_VALUE_FUNC(Retcode_T, CmdProcessor_EnqueueToLane, CmdProcessor_T *, CmdProcessor_Lane_T, bool, CmdProcessor_Func_T, void *, uint32_t)
+FAKE_VALUE_FUNC(Retcode_T, CmdProcessor_EnqueueToLaneFromIsr, CmdProcessor_T *, CmdProcessor_Lane_T, bool, CmdProcessor_Func_T, void *, uint32_t)
+FAKE_VALUE_FUNC(Retcode_T, CmdProcessor_EnqueueDelayed, CmdProcessor_T *, CmdProcessor_Timer_T *, CmdProcessor_Func_T, void *, uint32_t, uint32_t)
+FAKE_VALUE_FUNC(Retcode_T, CmdProcessor_EnqueuePeriodic, CmdProcessor_T *, CmdProcessor_Timer_T *, CmdProcessor_Func_T, void *, uint32_t, uint32_t)
+FAKE_VALUE_FUNC(Retcode_T, CmdProcessor_CancelTimer, CmdProcessor_T *, CmdProcessor_Timer_T *)
 
 #endif /* KISO_CMDPROCESSOR_TH_HH_ */
 
@@ -42,6 +42,12 @@ FAKE_VALUE_FUNC(Retcode_T, EventHub_Initialize, EventHub_T *)
 FAKE_VALUE_FUNC(Retcode_T, EventHub_Observe, EventHub_T *, EventHandler_T, TaskEvent_T)
 FAKE_VALUE_FUNC(Retcode_T, EventHub_ObserveAll, EventHub_T *, EventHandler_T)
 FAKE_VALUE_FUNC(Retcode_T, EventHub_Notify, EventHub_T *, TaskEvent_T, void *)
+FAKE_VALUE_FUNC(Retcode_T, EventHub_NotifyFromIsr, EventHub_T *, TaskEvent_T, const void *)
+#if KISO_FEATURE_CMDPROCESSOR
+FAKE_VALUE_FUNC(Retcode_T, EventHub_ObserveAsync, EventHub_T *, EventHandler_T, TaskEvent_T, CmdProcessor_T *, bool)
+FAKE_VALUE_FUNC(Retcode_T, EventHub_ObserveAllAsync, EventHub_T *, EventHandler_T, CmdProcessor_T *, bool)
+FAKE_VALUE_FUNC(Retcode_T, EventHub_GetAsyncStatistics, EventHub_T *, EventHubAsyncStatistics_T *, bool)
+#endif
 
 #endif /* KISO_EVENTHUB_TH_HH_ */
 
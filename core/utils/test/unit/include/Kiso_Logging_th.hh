@@ -39,6 +39,7 @@
 /* Mock-ups for the provided interfaces */
 FAKE_VALUE_FUNC(Retcode_T, Logging_Init, const LogRecorder_T *,
                 const LogAppender_T *);
+FAKE_VALUE_FUNC(Retcode_T, Logging_AddAppender, const LogAppender_T *, LogLevel_T);
 DECLARE_FAKE_VALUE_FUNC7_VARARG(Retcode_T, Logging_Log, LogLevel_T, uint8_t, uint8_t, const char *,
                                 uint32_t, const char *, ...);
 DEFINE_FAKE_VALUE_FUNC7_VARARG(Retcode_T, Logging_Log, LogLevel_T, uint8_t, uint8_t, const char *,
@@ -48,5 +49,16 @@ FAKE_VALUE_FUNC(Retcode_T, LogFilter_Delete, LogFilterId_T)
 FAKE_VALUE_FUNC(Retcode_T, LogFilter_Configure, LogFilterId_T, LogLevel_T,
                 uint8_t, uint8_t);
 FAKE_VALUE_FUNC(bool, LogFilter_Apply, LogLevel_T, uint8_t, uint8_t)
+#if KISO_LOG_RATE_LIMIT
+FAKE_VALUE_FUNC(bool, LogRateLimit_Apply, LogLevel_T, uint8_t, uint8_t, const char *, uint32_t, uint32_t *)
+FAKE_VALUE_FUNC(bool, LogRateLimit_TakeSuppressed, LogRateLimitReport_T *)
+#endif
+#if KISO_RAM_APPENDER
+FAKE_VALUE_FUNC(uint32_t, Logging_ReadRAMAppender, uint32_t, char *, uint32_t)
+FAKE_VOID_FUNC(Logging_ClearRAMAppender)
+#endif
+#if KISO_ASYNC_RECORDER
+FAKE_VALUE_FUNC(uint32_t, Logging_GetDroppedCount)
+#endif
 
 #endif /* KISO_LOGGING_TH_HH_ */
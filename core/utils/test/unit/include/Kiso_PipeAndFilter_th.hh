@@ -48,5 +48,21 @@ FAKE_VALUE_FUNC(Retcode_T, PipeAndFilter_CreatePipe, PipeAndFilter_Pipe_T *)
 FAKE_VALUE_FUNC(Retcode_T, PipeAndFilter_CreateFilter, PipeAndFilter_FilterFunction_T, PipeAndFilter_Pipe_T *, PipeAndFilter_Pipe_T *, PipeAndFilter_Filter_T *)
 FAKE_VALUE_FUNC(Retcode_T, PipeAndFilter_FillPipe, PipeAndFilter_Pipe_T, uint8_t *, uint32_t)
 FAKE_VALUE_FUNC(Retcode_T, PipeAndFilter_FillPipeFromISR, PipeAndFilter_Pipe_T, uint8_t *, uint32_t)
+FAKE_VALUE_FUNC(Retcode_T, PipeAndFilter_CreateMergePipe, PipeAndFilter_Pipe_T *)
+FAKE_VALUE_FUNC(Retcode_T, PipeAndFilter_SetPolicy, PipeAndFilter_Pipe_T *, PipeAndFilter_Policy_T)
+FAKE_VALUE_FUNC(uint32_t, PipeAndFilter_GetDropped, const PipeAndFilter_Pipe_T *)
+FAKE_VALUE_FUNC(Retcode_T, PipeAndFilter_SetOutputPipes, PipeAndFilter_Filter_T *, PipeAndFilter_Pipe_T **, uint32_t)
+FAKE_VALUE_FUNC(Retcode_T, PipeAndFilter_CreateFusedFilter, PipeAndFilter_Stage_T *, uint32_t, PipeAndFilter_Pipe_T *, PipeAndFilter_Pipe_T *, PipeAndFilter_Filter_T *)
+FAKE_VALUE_FUNC(Retcode_T, PipeAndFilter_SetBatchSize, PipeAndFilter_Filter_T *, uint32_t)
+FAKE_VALUE_FUNC(Retcode_T, PipeAndFilter_GetStatistics, const PipeAndFilter_Filter_T *, uint32_t, PipeAndFilter_Statistics_T *)
+FAKE_VALUE_FUNC(Retcode_T, PipeAndFilter_ResetStatistics, PipeAndFilter_Filter_T *)
+FAKE_VALUE_FUNC(Retcode_T, PipeAndFilter_CreatePool, PipeAndFilter_Pool_T *, PipeAndFilter_Buffer_T *, uint8_t *, uint32_t, uint32_t)
+FAKE_VALUE_FUNC(Retcode_T, PipeAndFilter_CreateBufferPipe, PipeAndFilter_Pipe_T *)
+FAKE_VALUE_FUNC(Retcode_T, PipeAndFilter_CreateBufferFilter, PipeAndFilter_BufferFilterFunction_T, PipeAndFilter_Pipe_T *, PipeAndFilter_Pipe_T *, PipeAndFilter_Filter_T *)
+FAKE_VALUE_FUNC(Retcode_T, PipeAndFilter_AllocateBuffer, PipeAndFilter_Pool_T *, PipeAndFilter_Buffer_T **, uint32_t)
+FAKE_VALUE_FUNC(Retcode_T, PipeAndFilter_AllocateBufferFromISR, PipeAndFilter_Pool_T *, PipeAndFilter_Buffer_T **)
+FAKE_VALUE_FUNC(Retcode_T, PipeAndFilter_ReleaseBuffer, PipeAndFilter_Buffer_T *)
+FAKE_VALUE_FUNC(Retcode_T, PipeAndFilter_FillBufferPipe, PipeAndFilter_Pipe_T, PipeAndFilter_Buffer_T *)
+FAKE_VALUE_FUNC(Retcode_T, PipeAndFilter_FillBufferPipeFromISR, PipeAndFilter_Pipe_T, PipeAndFilter_Buffer_T *)
 
 #endif /* TEST_UNIT_INCLUDE_KISO_PIPEANDFILTER_TH_HH_ */
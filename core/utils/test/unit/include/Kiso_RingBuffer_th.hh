@@ -45,11 +45,32 @@ typedef struct RingBuffer_S
     uint8_t *Wptr; /** Write pointer. NOT to be changed by hand */
     uint8_t *Rptr; /** Read pointer. NOT to be changed by hand */
     uint32_t Size; /** Maximum number of bytes in the user-supplied buffer. Must be set during init */
+    bool Overwrite; /** Record mode only: drop the oldest records when full */
 } RingBuffer_T;
 
+#define RINGBUFFER_REGION_COUNT (2UL)
+
+typedef struct RingBuffer_Region_S
+{
+    uint8_t *Data;
+    uint32_t Length;
+} RingBuffer_Region_T;
+
+#define RINGBUFFER_RECORD_HEADER_SIZE (2UL)
+#define RINGBUFFER_RECORD_MAX_LENGTH (0xFFFFUL)
+
 FAKE_VOID_FUNC(RingBuffer_Initialize, RingBuffer_T *, uint8_t *, uint32_t)
 FAKE_VALUE_FUNC(uint32_t, RingBuffer_Write, RingBuffer_T *, uint8_t *, uint32_t)
 FAKE_VALUE_FUNC(uint32_t, RingBuffer_Read, RingBuffer_T *, uint8_t *, uint32_t)
+FAKE_VALUE_FUNC(uint32_t, RingBuffer_Reserve, RingBuffer_T *, RingBuffer_Region_T *)
+FAKE_VALUE_FUNC(uint32_t, RingBuffer_Commit, RingBuffer_T *, uint32_t)
+FAKE_VALUE_FUNC(uint32_t, RingBuffer_Peek, RingBuffer_T *, RingBuffer_Region_T *)
+FAKE_VALUE_FUNC(uint32_t, RingBuffer_Consume, RingBuffer_T *, uint32_t)
+FAKE_VOID_FUNC(RingBuffer_InitializeRecords, RingBuffer_T *, uint8_t *, uint32_t, bool)
+FAKE_VALUE_FUNC(bool, RingBuffer_WriteRecord, RingBuffer_T *, const uint8_t *, uint32_t)
+FAKE_VALUE_FUNC(uint32_t, RingBuffer_ReadRecord, RingBuffer_T *, uint8_t *, uint32_t)
+FAKE_VALUE_FUNC(uint32_t, RingBuffer_PeekRecord, RingBuffer_T *, RingBuffer_Region_T *)
+FAKE_VALUE_FUNC(uint32_t, RingBuffer_ConsumeRecord, RingBuffer_T *)
 FAKE_VOID_FUNC(RingBuffer_Reset, RingBuffer_T *)
 
 #endif /* KISO_RINGBUFFER_TH_HH_ */
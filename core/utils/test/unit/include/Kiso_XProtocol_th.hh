@@ -59,12 +59,21 @@ FAKE_VALUE_FUNC(Retcode_T, xProtocol_GetPayloadLength, const uint8_t *, uint32_t
 FAKE_VALUE_FUNC(Retcode_T, XProtocol_Init)
 FAKE_VALUE_FUNC(Retcode_T, XProtocol_EncodeFrame, const uint8_t *, uint32_t,
                 uint32_t, uint8_t *, uint32_t *);
+FAKE_VALUE_FUNC(Retcode_T, XProtocol_EncodeFrameSegments, const XProtocol_Segment_T *, uint32_t,
+                uint32_t, uint8_t *, uint32_t *);
+FAKE_VALUE_FUNC(uint32_t, XProtocol_GetMaxEncodedLength, uint32_t);
 FAKE_VALUE_FUNC(Retcode_T, XProtocol_DecodeFrame, const uint8_t *, uint32_t,
                 uint32_t, uint8_t *, uint32_t *);
 FAKE_VALUE_FUNC(Retcode_T, XProtocol_IsCompleteFrame, const uint8_t *, uint32_t,
                 const uint8_t **);
 FAKE_VALUE_FUNC(Retcode_T, XProtocol_GetPayloadLength, const uint8_t *, uint32_t,
                 uint32_t *);
+FAKE_VALUE_FUNC(Retcode_T, XProtocol_DecoderInitialize, XProtocol_Decoder_T *, uint8_t *, uint32_t,
+                XProtocol_FrameCallback_T, void *);
+FAKE_VOID_FUNC(XProtocol_DecoderReset, XProtocol_Decoder_T *);
+FAKE_VALUE_FUNC(Retcode_T, XProtocol_DecoderPush, XProtocol_Decoder_T *, const uint8_t *, uint32_t);
+FAKE_VALUE_FUNC(uint32_t, XProtocol_DecoderReserve, XProtocol_Decoder_T *, uint8_t **);
+FAKE_VALUE_FUNC(Retcode_T, XProtocol_DecoderCommit, XProtocol_Decoder_T *, uint32_t);
 
 #endif /* KISO_XPROTOCOL_TH_HH_*/
 
@@ -0,0 +1,160 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ *
+ * @brief
+ *      Module test specification for the CRC context API with the hardware CRC unit dispatch enabled.
+ *
+ * @detail
+ *      The unit test file template follows the Four-Phase test pattern.
+ *      Only built with KISO_FEATURE_MCU_CRC enabled, which KISO_CRC_HARDWARE_OFFLOAD requires.
+ * 
+ * @file
+ **/
+
+/* Include gtest interface */
+#include <gtest.h>
+
+/* Start of global scope symbol and fake definitions section */
+extern "C"
+{
+/* Setup compile time configuration defines */
+#define KISO_CRC_HARDWARE_OFFLOAD 1
+
+#include "Kiso_Utils.h"
+#include "Kiso_HAL.h"
+#undef KISO_MODULE_ID
+#define KISO_MODULE_ID KISO_UTILS_MODULE_ID_CRC
+
+#if KISO_FEATURE_CRC && KISO_FEATURE_MCU_CRC
+
+/* Include faked interfaces */
+#include "Kiso_Retcode_th.hh"
+#include "Kiso_MCU_CRC_th.hh"
+
+/* Include module under test */
+#include "CRC.c"
+
+    /* End of global scope symbol and fake definitions section */
+}
+
+/* Create test fixture initializing all variables automatically */
+class CRCHardwareOffload : public testing::Test
+{
+protected:
+    /* Remember that SetUp() is run immediately before a test starts. */
+    virtual void SetUp()
+    {
+        /* Hardware CRC unit is unavailable unless a test says otherwise */
+        RESET_FAKE(MCU_CRC_Accumulate);
+        MCU_CRC_Accumulate_fake.return_val = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NOT_SUPPORTED);
+    }
+
+    /* TearDown() is invoked immediately after a test finishes. */
+    virtual void TearDown()
+    {
+        ; /* Nothing to do if clean up is not required */
+    }
+};
+
+static const uint8_t CheckString[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+struct CatalogueEntry
+{
+    CRC_Params_T Params;
+    uint32_t Check;
+};
+
+/* Parameters and check values ("123456789") from the CRC catalogue */
+static const CatalogueEntry Catalogue[] = {
+    {CRC_PARAMS_CRC8_SMBUS, UINT32_C(0xF4)},
+    {CRC_PARAMS_CRC16_IBM_3740, UINT32_C(0x29B1)},
+    {CRC_PARAMS_CRC16_KERMIT, UINT32_C(0x2189)},
+    {CRC_PARAMS_CRC16_XMODEM, UINT32_C(0x31C3)},
+    {CRC_PARAMS_CRC32_ISO_HDLC, UINT32_C(0xCBF43926)},
+    {CRC_PARAMS_CRC32_ISCSI, UINT32_C(0xE3069283)},
+    {CRC_PARAMS_CRC32_MPEG_2, UINT32_C(0x0376E6E7)},
+    {{12, 0x80F, 0x000, false, true, 0x000}, UINT32_C(0xDAF)},                      /* CRC-12/UMTS */
+    {{24, 0x00065B, 0x555555, true, true, 0x000000}, UINT32_C(0xC25A56)},           /* CRC-24/BLE */
+    {{32, 0x04C11DB7, 0xFFFFFFFF, false, false, 0xFFFFFFFF}, UINT32_C(0xFC891918)}, /* CRC-32/BZIP2 */
+};
+
+/* Behaves like the MCU CRC unit: MSB first register of the stream width, optional input reflection */
+static Retcode_T FakeHardwareAccumulate(const struct MCU_CRC_Stream_S *stream, uint32_t *crc, const uint8_t *data_in, uint32_t dataLength)
+{
+    uint32_t topBit = UINT32_C(1) << (stream->Width - 1U);
+    uint32_t mask = (32U == stream->Width) ? UINT32_MAX : ((UINT32_C(1) << stream->Width) - 1U);
+    uint32_t crcRegister = *crc;
+
+    for (uint32_t i = 0; i < dataLength; i++)
+    {
+        uint8_t octet = stream->ReflectInput ? (uint8_t)Reflect(data_in[i], 8U) : data_in[i];
+        for (int8_t bit = 7; bit >= 0; bit--)
+        {
+            bool feedback = (0U != (crcRegister & topBit)) != (0U != (octet & (1U << bit)));
+            crcRegister = ((crcRegister << 1) ^ (feedback ? stream->Polynomial : 0U)) & mask;
+        }
+    }
+    *crc = crcRegister;
+    return RETCODE_OK;
+}
+
+TEST_F(CRCHardwareOffload, TestContextSoftwareFallback)
+{
+    /** @testcase{CRCHardwareOffload::TestContextSoftwareFallback: }
+     * Updates rejected by the hardware CRC unit are calculated in software
+     */
+    for (const CatalogueEntry &entry : Catalogue)
+    {
+        uint32_t crc = 0;
+        EXPECT_EQ(RETCODE_OK, CRC_Calculate(&entry.Params, CheckString, sizeof(CheckString), &crc));
+        EXPECT_EQ(entry.Check, crc);
+    }
+    EXPECT_EQ(sizeof(Catalogue) / sizeof(Catalogue[0]), MCU_CRC_Accumulate_fake.call_count);
+}
+
+TEST_F(CRCHardwareOffload, TestContextHardwareOffload)
+{
+    /** @testcase{CRCHardwareOffload::TestContextHardwareOffload: }
+     * Updates accepted by the hardware CRC unit yield the same CRC as the software calculation, also when
+     * hardware and software updates are mixed within one message
+     */
+    MCU_CRC_Accumulate_fake.custom_fake = FakeHardwareAccumulate;
+
+    for (const CatalogueEntry &entry : Catalogue)
+    {
+        uint32_t crc = 0;
+        CRC_Context_T context;
+
+        MCU_CRC_Accumulate_fake.call_count = 0;
+        EXPECT_EQ(RETCODE_OK, CRC_Calculate(&entry.Params, CheckString, sizeof(CheckString), &crc));
+        EXPECT_EQ(entry.Check, crc);
+        EXPECT_EQ(1U, MCU_CRC_Accumulate_fake.call_count);
+
+        EXPECT_EQ(RETCODE_OK, CRC_Initialize(&context, &entry.Params));
+        EXPECT_EQ(RETCODE_OK, CRC_Update(&context, CheckString, 4U));
+        MCU_CRC_Accumulate_fake.custom_fake = NULL;
+        EXPECT_EQ(RETCODE_OK, CRC_Update(&context, &CheckString[4], 3U));
+        MCU_CRC_Accumulate_fake.custom_fake = FakeHardwareAccumulate;
+        EXPECT_EQ(RETCODE_OK, CRC_Update(&context, &CheckString[7], 2U));
+        EXPECT_EQ(RETCODE_OK, CRC_Finalize(&context, &crc));
+        EXPECT_EQ(entry.Check, crc);
+    }
+}
+
+/*****************************************************************************************/
+#else
+}
+#endif /* if KISO_FEATURE_CRC && KISO_FEATURE_MCU_CRC */
@@ -0,0 +1,35 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ *
+ * @brief
+ *      Module test specification for the CRC module with the CRC-32 slicing-by-4 lookup enabled.
+ *
+ * @detail
+ *      Runs the test vectors of CRC_unittest.cc against the slicing-by-4 build of CRC.c, whose
+ *      TableMatchesBitwise cases cover lengths that are not a multiple of four and unaligned data.
+ * 
+ * @file
+ **/
+
+/* Setup compile time configuration defines */
+#define KISO_CRC_TABLE_DRIVEN 1
+#define KISO_CRC32_SLICING_BY_4 1
+
+#include "CRC_unittest.cc"
+
+#if KISO_FEATURE_CRC
+static_assert(CRC32_TABLE_SLICES == 4U, "slicing-by-4 lookup not compiled in");
+#endif /* if KISO_FEATURE_CRC */
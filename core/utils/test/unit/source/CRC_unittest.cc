@@ -51,7 +51,13 @@ protected:
     /* Remember that SetUp() is run immediately before a test starts. */
     virtual void SetUp()
     {
-        ;
+#if KISO_CRC_TABLE_DRIVEN
+        /* Start every test with empty table caches */
+        memset(Crc8Tables, 0, sizeof(Crc8Tables));
+        memset(Crc16Tables, 0, sizeof(Crc16Tables));
+        memset(Crc32Tables, 0, sizeof(Crc32Tables));
+        memset(Crc32ReverseTables, 0, sizeof(Crc32ReverseTables));
+#endif /* if KISO_CRC_TABLE_DRIVEN */
     }
 
     /* TearDown() is invoked immediately after a test finishes. */
@@ -1095,6 +1101,295 @@ TEST_F(CRCRoutines, TestCRC32EathStandard)
     EXPECT_EQ(RETCODE_OK, retVal);
 }
 
+
+static void FillPseudoRandom(uint8_t *data, uint16_t len)
+{
+    uint32_t seed = UINT32_C(0x12345678);
+    for (uint16_t i = 0; i < len; i++)
+    {
+        seed = seed * UINT32_C(1103515245) + UINT32_C(12345);
+        data[i] = (uint8_t)(seed >> 16);
+    }
+}
+
+#if KISO_CRC_TABLE_DRIVEN
+/* Returns true if the cache holds a built table for the polynomial */
+template <typename T>
+static bool IsTableCached(const T (&tables)[KISO_CRC_TABLE_CACHE_SIZE], uint32_t poly)
+{
+    for (const T &cached : tables)
+    {
+        if (((uint32_t)CRC_TABLE_READY == cached.Header.State) && (poly == cached.Header.Poly))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+#endif /* if KISO_CRC_TABLE_DRIVEN */
+
+TEST_F(CRCRoutines, TestCRC8TableMatchesBitwise)
+{
+    /** @testcase{CRCRoutines::TestCRC8TableMatchesBitwise: }
+     * CRC_8 results are identical for the polynomials with a cached lookup table and for any further polynomial
+     */
+    uint8_t dataBuffer[300];
+    FillPseudoRandom(dataBuffer, sizeof(dataBuffer));
+
+    for (uint16_t len = 0; len <= sizeof(dataBuffer); len += 13)
+    {
+        for (uint8_t poly : {UINT8_C(0x07), UINT8_C(0xba), UINT8_C(0x31)})
+        {
+            uint8_t crc = UINT8_C(0xaa);
+            EXPECT_EQ(RETCODE_OK, CRC_8(poly, &crc, dataBuffer, len));
+            EXPECT_EQ(Crc8Bitwise(poly, UINT8_C(0xaa), dataBuffer, len), crc);
+        }
+    }
+#if KISO_CRC_TABLE_DRIVEN
+    EXPECT_TRUE(IsTableCached(Crc8Tables, UINT8_C(0x07)));
+    EXPECT_EQ(KISO_CRC_TABLE_CACHE_SIZE >= 2, IsTableCached(Crc8Tables, UINT8_C(0xba)));
+    EXPECT_EQ(KISO_CRC_TABLE_CACHE_SIZE >= 3, IsTableCached(Crc8Tables, UINT8_C(0x31)));
+#endif /* if KISO_CRC_TABLE_DRIVEN */
+}
+
+TEST_F(CRCRoutines, TestCRC16TableMatchesBitwise)
+{
+    /** @testcase{CRCRoutines::TestCRC16TableMatchesBitwise: }
+     * CRC_16 results are identical for the polynomials with a cached lookup table and for any further polynomial
+     */
+    uint8_t dataBuffer[300];
+    FillPseudoRandom(dataBuffer, sizeof(dataBuffer));
+
+    for (uint16_t len = 0; len <= sizeof(dataBuffer); len += 13)
+    {
+        for (uint16_t poly : {UINT16_C(0x1021), UINT16_C(0xbaad), UINT16_C(0x8005)})
+        {
+            uint16_t crc = UINT16_C(0xffff);
+            EXPECT_EQ(RETCODE_OK, CRC_16(poly, &crc, dataBuffer, len));
+            EXPECT_EQ(Crc16Bitwise(poly, UINT16_C(0xffff), dataBuffer, len), crc);
+        }
+    }
+#if KISO_CRC_TABLE_DRIVEN
+    EXPECT_TRUE(IsTableCached(Crc16Tables, UINT16_C(0x1021)));
+    EXPECT_EQ(KISO_CRC_TABLE_CACHE_SIZE >= 2, IsTableCached(Crc16Tables, UINT16_C(0xbaad)));
+    EXPECT_EQ(KISO_CRC_TABLE_CACHE_SIZE >= 3, IsTableCached(Crc16Tables, UINT16_C(0x8005)));
+#endif /* if KISO_CRC_TABLE_DRIVEN */
+}
+
+TEST_F(CRCRoutines, TestCRC32TableMatchesBitwise)
+{
+    /** @testcase{CRCRoutines::TestCRC32TableMatchesBitwise: }
+     * CRC_32 results are identical for the polynomials with a cached lookup table and for any further polynomial,
+     * including lengths that are not a multiple of four and unaligned start addresses
+     */
+    uint8_t dataBuffer[301];
+    FillPseudoRandom(dataBuffer, sizeof(dataBuffer));
+
+    for (uint16_t offset = 0; offset < 4; offset++)
+    {
+        for (uint16_t len = 0; len <= sizeof(dataBuffer) - 4; len += 7)
+        {
+            for (uint32_t poly : {UINT32_C(0x04C11DB7), UINT32_C(0xbaadf00d)})
+            {
+                uint32_t crc = UINT32_C(0xffffffff);
+                EXPECT_EQ(RETCODE_OK, CRC_32(poly, &crc, &dataBuffer[offset], len));
+                EXPECT_EQ(Crc32Bitwise(poly, UINT32_C(0xffffffff), &dataBuffer[offset], len), crc);
+            }
+        }
+    }
+#if KISO_CRC_TABLE_DRIVEN
+    EXPECT_TRUE(IsTableCached(Crc32Tables, UINT32_C(0x04C11DB7)));
+    EXPECT_EQ(KISO_CRC_TABLE_CACHE_SIZE >= 2, IsTableCached(Crc32Tables, UINT32_C(0xbaadf00d)));
+#endif /* if KISO_CRC_TABLE_DRIVEN */
+}
+
+TEST_F(CRCRoutines, TestCRC32ReverseTableMatchesBitwise)
+{
+    /** @testcase{CRCRoutines::TestCRC32ReverseTableMatchesBitwise: }
+     * CRC_32_Reverse results are identical for the polynomials with a cached lookup table and for any further polynomial,
+     * including lengths that are not a multiple of four and unaligned start addresses
+     */
+    uint8_t dataBuffer[301];
+    FillPseudoRandom(dataBuffer, sizeof(dataBuffer));
+
+    for (uint16_t offset = 0; offset < 4; offset++)
+    {
+        for (uint16_t len = 0; len <= sizeof(dataBuffer) - 4; len += 7)
+        {
+            for (uint32_t poly : {CRC32_ETHERNET_REVERSE_POLYNOMIAL, UINT32_C(0x82F63B78)})
+            {
+                uint32_t crc = UINT32_C(0xffffffff);
+                EXPECT_EQ(RETCODE_OK, CRC_32_Reverse(poly, &crc, &dataBuffer[offset], len));
+                EXPECT_EQ(Crc32ReverseBitwise(poly, UINT32_C(0xffffffff), &dataBuffer[offset], len), crc);
+            }
+        }
+    }
+#if KISO_CRC_TABLE_DRIVEN
+    EXPECT_TRUE(IsTableCached(Crc32ReverseTables, CRC32_ETHERNET_REVERSE_POLYNOMIAL));
+    EXPECT_EQ(KISO_CRC_TABLE_CACHE_SIZE >= 2, IsTableCached(Crc32ReverseTables, UINT32_C(0x82F63B78)));
+#endif /* if KISO_CRC_TABLE_DRIVEN */
+}
+
+TEST_F(CRCRoutines, TestCRC32ReverseCheckValue)
+{
+    /** @testcase{CRCRoutines::TestCRC32ReverseCheckValue: }
+     * CRC_32_Reverse yields the IEEE 802.3 check value for "123456789", both for the first call (building the table)
+     * and for the following one (using the table)
+     */
+    const uint8_t checkString[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+    for (uint8_t run = 0; run < 2; run++)
+    {
+        uint32_t crc = UINT32_C(0xffffffff);
+        EXPECT_EQ(RETCODE_OK, CRC_32_Reverse(CRC32_ETHERNET_REVERSE_POLYNOMIAL, &crc, checkString, sizeof(checkString)));
+        EXPECT_EQ(UINT32_C(0xCBF43926), crc ^ UINT32_C(0xffffffff));
+    }
+}
+
+
+static const uint8_t CheckString[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+struct CatalogueEntry
+{
+    CRC_Params_T Params;
+    uint32_t Check;
+};
+
+/* Parameters and check values ("123456789") from the CRC catalogue */
+static const CatalogueEntry Catalogue[] = {
+    {CRC_PARAMS_CRC8_SMBUS, UINT32_C(0xF4)},
+    {CRC_PARAMS_CRC16_IBM_3740, UINT32_C(0x29B1)},
+    {CRC_PARAMS_CRC16_KERMIT, UINT32_C(0x2189)},
+    {CRC_PARAMS_CRC16_XMODEM, UINT32_C(0x31C3)},
+    {CRC_PARAMS_CRC32_ISO_HDLC, UINT32_C(0xCBF43926)},
+    {CRC_PARAMS_CRC32_ISCSI, UINT32_C(0xE3069283)},
+    {CRC_PARAMS_CRC32_MPEG_2, UINT32_C(0x0376E6E7)},
+    {{8, 0x31, 0x00, true, true, 0x00}, UINT32_C(0xA1)},                      /* CRC-8/MAXIM-DOW */
+    {{12, 0x80F, 0x000, false, true, 0x000}, UINT32_C(0xDAF)},                /* CRC-12/UMTS */
+    {{14, 0x0805, 0x0000, true, true, 0x0000}, UINT32_C(0x082D)},             /* CRC-14/DARC */
+    {{15, 0x4599, 0x0000, false, false, 0x0000}, UINT32_C(0x059E)},           /* CRC-15/CAN */
+    {{16, 0x8005, 0x0000, true, true, 0x0000}, UINT32_C(0xBB3D)},             /* CRC-16/ARC */
+    {{16, 0x1021, 0xFFFF, false, false, 0xFFFF}, UINT32_C(0xD64E)},           /* CRC-16/GENIBUS */
+    {{17, 0x1685B, 0x00000, false, false, 0x00000}, UINT32_C(0x04F03)},       /* CRC-17/CAN-FD */
+    {{24, 0x864CFB, 0xB704CE, false, false, 0x000000}, UINT32_C(0x21CF02)},   /* CRC-24/OPENPGP */
+    {{24, 0x00065B, 0x555555, true, true, 0x000000}, UINT32_C(0xC25A56)},     /* CRC-24/BLE */
+    {{32, 0x04C11DB7, 0xFFFFFFFF, false, false, 0xFFFFFFFF}, UINT32_C(0xFC891918)}, /* CRC-32/BZIP2 */
+};
+
+TEST_F(CRCRoutines, TestContextCatalogueCheckValues)
+{
+    /** @testcase{CRCRoutines::TestContextCatalogueCheckValues: }
+     * CRC_Calculate yields the check values of the CRC catalogue, both while building the lookup tables and when using them
+     */
+    for (uint8_t run = 0; run < 2; run++)
+    {
+        for (const CatalogueEntry &entry : Catalogue)
+        {
+            uint32_t crc = 0;
+            EXPECT_EQ(RETCODE_OK, CRC_Calculate(&entry.Params, CheckString, sizeof(CheckString), &crc));
+            EXPECT_EQ(entry.Check, crc) << "width " << (int)entry.Params.Width << " poly 0x" << std::hex << entry.Params.Poly;
+        }
+    }
+}
+
+TEST_F(CRCRoutines, TestContextIncrementalUpdates)
+{
+    /** @testcase{CRCRoutines::TestContextIncrementalUpdates: }
+     * Splitting the message into several updates does not change the CRC, and finalizing does not end the calculation
+     */
+    for (const CatalogueEntry &entry : Catalogue)
+    {
+        for (uint32_t split = 0; split <= sizeof(CheckString); split++)
+        {
+            CRC_Context_T context;
+            uint32_t crc = 0;
+            EXPECT_EQ(RETCODE_OK, CRC_Initialize(&context, &entry.Params));
+            EXPECT_EQ(RETCODE_OK, CRC_Update(&context, CheckString, split));
+            EXPECT_EQ(RETCODE_OK, CRC_Finalize(&context, &crc));
+            EXPECT_EQ(RETCODE_OK, CRC_Update(&context, &CheckString[split], sizeof(CheckString) - split));
+            EXPECT_EQ(RETCODE_OK, CRC_Finalize(&context, &crc));
+            EXPECT_EQ(entry.Check, crc);
+        }
+    }
+}
+
+TEST_F(CRCRoutines, TestContextLongMessage)
+{
+    /** @testcase{CRCRoutines::TestContextLongMessage: }
+     * The context API processes messages longer than the 16-bit length of the legacy routines
+     */
+    static uint8_t dataBuffer[70000];
+    const CRC_Params_T params = CRC_PARAMS_CRC32_ISO_HDLC;
+    uint32_t crc = 0;
+    uint32_t legacyCrc;
+    FillPseudoRandom(dataBuffer, UINT16_MAX);
+    memcpy(&dataBuffer[UINT16_MAX], dataBuffer, sizeof(dataBuffer) - UINT16_MAX);
+
+    EXPECT_EQ(RETCODE_OK, CRC_Calculate(&params, dataBuffer, sizeof(dataBuffer), &crc));
+
+    legacyCrc = UINT32_C(0xFFFFFFFF);
+    EXPECT_EQ(RETCODE_OK, CRC_32_Reverse(CRC32_ETHERNET_REVERSE_POLYNOMIAL, &legacyCrc, dataBuffer, UINT16_MAX));
+    EXPECT_EQ(RETCODE_OK, CRC_32_Reverse(CRC32_ETHERNET_REVERSE_POLYNOMIAL, &legacyCrc, &dataBuffer[UINT16_MAX], sizeof(dataBuffer) - UINT16_MAX));
+    EXPECT_EQ(legacyCrc ^ UINT32_C(0xFFFFFFFF), crc);
+}
+
+TEST_F(CRCRoutines, TestContextInvalidParameters)
+{
+    /** @testcase{CRCRoutines::TestContextInvalidParameters: }
+     * The context API rejects NULL pointers and unsupported widths
+     */
+    CRC_Params_T params = CRC_PARAMS_CRC16_KERMIT;
+    CRC_Context_T context;
+    uint32_t crc;
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), CRC_Initialize(NULL, &params));
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), CRC_Initialize(&context, NULL));
+    params.Width = CRC_WIDTH_MIN - 1U;
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INVALID_PARAM), CRC_Initialize(&context, &params));
+    params.Width = CRC_WIDTH_MAX + 1U;
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INVALID_PARAM), CRC_Calculate(&params, CheckString, sizeof(CheckString), &crc));
+
+    params.Width = 16U;
+    EXPECT_EQ(RETCODE_OK, CRC_Initialize(&context, &params));
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), CRC_Update(NULL, CheckString, sizeof(CheckString)));
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), CRC_Update(&context, NULL, sizeof(CheckString)));
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), CRC_Finalize(NULL, &crc));
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), CRC_Finalize(&context, NULL));
+}
+
+TEST_F(CRCRoutines, TestContextSharedEngine)
+{
+    /** @testcase{CRCRoutines::TestContextSharedEngine: }
+     * Algorithms mapped onto the same engine each get their own lookup table, regardless of the order of their use
+     */
+    const CRC_Params_T msbFirst[] = {CRC_PARAMS_CRC16_IBM_3740, CRC_PARAMS_CRC32_MPEG_2};
+    const uint32_t msbFirstCheck[] = {UINT32_C(0x29B1), UINT32_C(0x0376E6E7)};
+    const CRC_Params_T lsbFirst[] = {CRC_PARAMS_CRC32_ISO_HDLC, CRC_PARAMS_CRC32_ISCSI};
+    const uint32_t lsbFirstCheck[] = {UINT32_C(0xCBF43926), UINT32_C(0xE3069283)};
+
+    for (uint8_t run = 0; run < 2; run++)
+    {
+        for (uint8_t i = 0; i < 2; i++)
+        {
+            uint32_t crc = 0;
+            EXPECT_EQ(RETCODE_OK, CRC_Calculate(&msbFirst[i], CheckString, sizeof(CheckString), &crc));
+            EXPECT_EQ(msbFirstCheck[i], crc);
+            EXPECT_EQ(RETCODE_OK, CRC_Calculate(&lsbFirst[i], CheckString, sizeof(CheckString), &crc));
+            EXPECT_EQ(lsbFirstCheck[i], crc);
+        }
+    }
+#if KISO_CRC_TABLE_DRIVEN
+    for (uint8_t i = 0; (i < 2) && (i < KISO_CRC_TABLE_CACHE_SIZE); i++)
+    {
+        CRC_Context_T context;
+        EXPECT_EQ(RETCODE_OK, CRC_Initialize(&context, &msbFirst[i]));
+        EXPECT_TRUE(IsTableCached(Crc32Tables, context.EnginePoly));
+        EXPECT_EQ(RETCODE_OK, CRC_Initialize(&context, &lsbFirst[i]));
+        EXPECT_TRUE(IsTableCached(Crc32ReverseTables, context.EnginePoly));
+    }
+#endif /* if KISO_CRC_TABLE_DRIVEN */
+}
+
 /*****************************************************************************************/
 #else
 }
@@ -41,6 +41,10 @@ extern "C"
 #include "Kiso_Assert_th.hh"
 #include "LogConfig.h"
 
+/* Room for combinations of filters */
+#undef LOG_FILTER_ITEM_COUNT
+#define LOG_FILTER_ITEM_COUNT (UINT8_C(4))
+
 #include "Filter.c"
     /* End of global scope symbol and fake definitions section */
 }
@@ -58,6 +62,7 @@ protected:
     {
         /* Wipe out the filter item buffer */
         memset(LogFilterItems, 0, sizeof(LogFilterItem_T) * LOG_FILTER_ITEM_COUNT);
+        LogFilter_Compile();
     }
 };
 
@@ -190,6 +195,120 @@ TEST_F(Logging_Filter, Logging_FilterApplyWrongFilter)
     EXPECT_EQ(false, output);
 }
 
+TEST_F(Logging_Filter, Logging_FilterApplyDefaultFilter)
+{
+    /* The tables are reset to the state of the default filter item */
+    memset(LogFilterItems, 0, sizeof(LogFilterItem_T) * LOG_FILTER_ITEM_COUNT);
+    LogFilterItems[0].Level = (uint8_t)LOG_LEVEL_PACKAGE_DEFAULT;
+    LogFilter_Compile();
+
+    EXPECT_EQ(true, LogFilter_Apply(LOG_LEVEL_PACKAGE_DEFAULT, 0, 0));
+    EXPECT_EQ(true, LogFilter_Apply(LOG_LEVEL_FATAL, 255, 255));
+    EXPECT_EQ((uint8_t)(LOG_LEVEL_PACKAGE_DEFAULT + 1), LogFilterActiveTables->Limit);
+}
+
+TEST_F(Logging_Filter, Logging_FilterApplyPackageFilter)
+{
+    (void)LogFilter_Add(LOG_LEVEL_WARNING, 7, LOG_MODULE_ID_ALL);
+
+    EXPECT_EQ(true, LogFilter_Apply(LOG_LEVEL_WARNING, 7, 1));
+    EXPECT_EQ(true, LogFilter_Apply(LOG_LEVEL_ERROR, 7, 200));
+    EXPECT_EQ(false, LogFilter_Apply(LOG_LEVEL_INFO, 7, 1));
+    EXPECT_EQ(false, LogFilter_Apply(LOG_LEVEL_FATAL, 8, 1));
+}
+
+TEST_F(Logging_Filter, Logging_FilterApplyModuleOfAllPackages)
+{
+    (void)LogFilter_Add(LOG_LEVEL_INFO, LOG_PACKAGE_ID_ALL, 3);
+
+    EXPECT_EQ(true, LogFilter_Apply(LOG_LEVEL_INFO, 1, 3));
+    EXPECT_EQ(true, LogFilter_Apply(LOG_LEVEL_INFO, 255, 3));
+    EXPECT_EQ(false, LogFilter_Apply(LOG_LEVEL_DEBUG, 1, 3));
+    EXPECT_EQ(false, LogFilter_Apply(LOG_LEVEL_FATAL, 1, 2));
+    EXPECT_EQ(false, LogFilter_Apply(LOG_LEVEL_FATAL, 1, 4));
+}
+
+TEST_F(Logging_Filter, Logging_FilterApplyHighestMatchingLevel)
+{
+    /* A package wide filter, a filter for a module of all packages and one for a single module */
+    (void)LogFilter_Add(LOG_LEVEL_ERROR, 5, LOG_MODULE_ID_ALL);
+    (void)LogFilter_Add(LOG_LEVEL_WARNING, LOG_PACKAGE_ID_ALL, 9);
+    (void)LogFilter_Add(LOG_LEVEL_DEBUG, 5, 10);
+
+    EXPECT_EQ(true, LogFilter_Apply(LOG_LEVEL_ERROR, 5, 1));
+    EXPECT_EQ(false, LogFilter_Apply(LOG_LEVEL_WARNING, 5, 1));
+    EXPECT_EQ(true, LogFilter_Apply(LOG_LEVEL_WARNING, 5, 9));
+    EXPECT_EQ(false, LogFilter_Apply(LOG_LEVEL_INFO, 5, 9));
+    EXPECT_EQ(true, LogFilter_Apply(LOG_LEVEL_DEBUG, 5, 10));
+    EXPECT_EQ(true, LogFilter_Apply(LOG_LEVEL_WARNING, 6, 9));
+    EXPECT_EQ(false, LogFilter_Apply(LOG_LEVEL_WARNING, 6, 10));
+    EXPECT_EQ(false, LogFilter_Apply(LOG_LEVEL_FATAL, 6, 1));
+}
+
+TEST_F(Logging_Filter, Logging_FilterApplyNeighbouringModules)
+{
+    /* Two modules share a byte of a row */
+    (void)LogFilter_Add(LOG_LEVEL_FATAL, 2, 4);
+    (void)LogFilter_Add(LOG_LEVEL_DEBUG, 2, 5);
+
+    EXPECT_EQ(true, LogFilter_Apply(LOG_LEVEL_FATAL, 2, 4));
+    EXPECT_EQ(false, LogFilter_Apply(LOG_LEVEL_ERROR, 2, 4));
+    EXPECT_EQ(true, LogFilter_Apply(LOG_LEVEL_DEBUG, 2, 5));
+    EXPECT_EQ(false, LogFilter_Apply(LOG_LEVEL_FATAL, 2, 6));
+    EXPECT_EQ(false, LogFilter_Apply(LOG_LEVEL_FATAL, 3, 5));
+}
+
+TEST_F(Logging_Filter, Logging_FilterApplyAllRowsUsed)
+{
+    for (uint8_t i = 0; i < LOG_FILTER_ITEM_COUNT; i++)
+    {
+        EXPECT_EQ((LogFilterId_T)i, LogFilter_Add(LOG_LEVEL_ERROR, (uint8_t)(i + 1U), (uint8_t)(i + 1U)));
+    }
+
+    for (uint8_t i = 0; i < LOG_FILTER_ITEM_COUNT; i++)
+    {
+        EXPECT_EQ(true, LogFilter_Apply(LOG_LEVEL_ERROR, (uint8_t)(i + 1U), (uint8_t)(i + 1U)));
+        EXPECT_EQ(false, LogFilter_Apply(LOG_LEVEL_ERROR, (uint8_t)(i + 1U), (uint8_t)(i + 2U)));
+    }
+}
+
+TEST_F(Logging_Filter, Logging_FilterApplyAfterConfigureAndDelete)
+{
+    LogFilterId_T id = LogFilter_Add(LOG_LEVEL_FATAL, 1, 2);
+
+    EXPECT_EQ(false, LogFilter_Apply(LOG_LEVEL_ERROR, 1, 2));
+
+    EXPECT_EQ(RETCODE_OK, LogFilter_Configure(id, LOG_LEVEL_ERROR, 1, 2));
+    EXPECT_EQ(true, LogFilter_Apply(LOG_LEVEL_ERROR, 1, 2));
+
+    EXPECT_EQ(RETCODE_OK, LogFilter_Configure(id, LOG_LEVEL_ERROR, 1, 3));
+    EXPECT_EQ(false, LogFilter_Apply(LOG_LEVEL_ERROR, 1, 2));
+
+    /* Without any filter, everything passes */
+    EXPECT_EQ(RETCODE_OK, LogFilter_Delete(id));
+    EXPECT_EQ(true, LogFilter_Apply(LOG_LEVEL_DEBUG, 1, 2));
+}
+
+TEST_F(Logging_Filter, Logging_FilterChangeKeepsActiveTables)
+{
+    (void)LogFilter_Add(LOG_LEVEL_ERROR, 1, LOG_MODULE_ID_ALL);
+    const LogFilterTables_T *applied = LogFilterActiveTables;
+    LogFilterTables_T snapshot = *applied;
+
+    /* A change is compiled into the inactive tables, a log call still using the active ones is not affected */
+    LogFilterId_T id = LogFilter_Add(LOG_LEVEL_FATAL, 2, 3);
+    EXPECT_NE(applied, LogFilterActiveTables);
+    EXPECT_EQ(0, memcmp(&snapshot, applied, sizeof(snapshot)));
+    EXPECT_EQ(true, LogFilter_Apply(LOG_LEVEL_FATAL, 2, 3));
+    EXPECT_EQ(true, LogFilter_Apply(LOG_LEVEL_ERROR, 1, 4));
+
+    /* The next change swaps back */
+    EXPECT_EQ(RETCODE_OK, LogFilter_Delete(id));
+    EXPECT_EQ(applied, LogFilterActiveTables);
+    EXPECT_EQ(false, LogFilter_Apply(LOG_LEVEL_FATAL, 2, 3));
+    EXPECT_EQ(true, LogFilter_Apply(LOG_LEVEL_ERROR, 1, 4));
+}
+
 #else
 }
 
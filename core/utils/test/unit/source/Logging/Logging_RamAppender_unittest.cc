@@ -0,0 +1,181 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ *
+ * @brief
+ *      Module test specification for the Logging_RamAppender_unittest.cc module.
+ *
+ * @detail
+ *      The unit test file template follows the Four-Phase test pattern.
+ *
+ * @file
+ **/
+
+/* Include gtest interface */
+#include <gtest.h>
+
+#include <string>
+
+/* Start of global scope symbol and fake definitions section */
+extern "C"
+{
+/* Module includes */
+#include "Kiso_Utils.h"
+#undef KISO_MODULE_ID
+#define KISO_MODULE_ID KISO_UTILS_MODULE_ID_LOGGING_APPENDER_RAM
+
+/* Check if the logging feature is activated */
+#if KISO_FEATURE_LOGGING
+#include "LogConfig.h"
+
+/* The appender is tested regardless of the configuration, with a small buffer to see it wrap */
+#undef KISO_RAM_APPENDER
+#define KISO_RAM_APPENDER 1
+#undef LOG_RAM_APPENDER_SIZE
+#define LOG_RAM_APPENDER_SIZE (UINT16_C(16))
+
+#include "Kiso_Basics.h"
+#include "Kiso_Retcode_th.hh"
+#include "Kiso_Assert_th.hh"
+
+#include "Logging_RamAppender.c"
+
+    /* End of global scope symbol and fake definitions section */
+}
+
+class LogRamAppender : public testing::Test
+{
+protected:
+    virtual void SetUp()
+    {
+        FFF_RESET_HISTORY()
+
+        /* Uninitialized RAM after power up */
+        memset(&LogRamAppenderBuffer, 0xA5, sizeof(LogRamAppenderBuffer));
+    }
+
+    std::string ReadAll(void)
+    {
+        char buffer[2 * LOG_RAM_APPENDER_SIZE];
+        uint32_t length = Logging_ReadRAMAppender(0, buffer, sizeof(buffer));
+        return std::string(buffer, length);
+    }
+};
+
+TEST_F(LogRamAppender, Init_ClearsInvalidBuffer)
+{
+    Retcode_T retcode = Logging_RAMAppender->Init(NULL);
+
+    EXPECT_EQ(RETCODE_OK, retcode);
+    EXPECT_EQ(LOG_RAM_APPENDER_MAGIC, LogRamAppenderBuffer.Magic);
+    EXPECT_EQ(UINT32_C(0), LogRamAppenderBuffer.Head);
+    EXPECT_EQ(std::string(), ReadAll());
+}
+
+TEST_F(LogRamAppender, Init_KeepsValidBuffer)
+{
+    EXPECT_EQ(RETCODE_OK, Logging_RAMAppender->Init(NULL));
+    EXPECT_EQ(RETCODE_OK, Logging_RAMAppender->Write("before", 6));
+
+    /* Warm reset */
+    EXPECT_EQ(RETCODE_OK, Logging_RAMAppender->Init(NULL));
+
+    EXPECT_EQ(std::string("before"), ReadAll());
+}
+
+TEST_F(LogRamAppender, Init_ClearsBufferOfOtherSize)
+{
+    EXPECT_EQ(RETCODE_OK, Logging_RAMAppender->Init(NULL));
+    EXPECT_EQ(RETCODE_OK, Logging_RAMAppender->Write("before", 6));
+    LogRamAppenderBuffer.Size = 2 * LOG_RAM_APPENDER_SIZE;
+
+    EXPECT_EQ(RETCODE_OK, Logging_RAMAppender->Init(NULL));
+
+    EXPECT_EQ(std::string(), ReadAll());
+}
+
+TEST_F(LogRamAppender, Write_NullPointer)
+{
+    EXPECT_EQ(RETCODE_OK, Logging_RAMAppender->Init(NULL));
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), Logging_RAMAppender->Write(NULL, 1));
+    EXPECT_EQ(UINT32_C(0), LogRamAppenderBuffer.Head);
+}
+
+TEST_F(LogRamAppender, Write_Wraps)
+{
+    EXPECT_EQ(RETCODE_OK, Logging_RAMAppender->Init(NULL));
+
+    EXPECT_EQ(RETCODE_OK, Logging_RAMAppender->Write("0123456789", 10));
+    EXPECT_EQ(RETCODE_OK, Logging_RAMAppender->Write("abcdefghij", 10));
+
+    /* Only the last 16 bytes are kept */
+    EXPECT_EQ(std::string("456789abcdefghij"), ReadAll());
+    EXPECT_EQ(UINT32_C(20), LogRamAppenderBuffer.Head);
+}
+
+TEST_F(LogRamAppender, Write_LongerThanBuffer)
+{
+    EXPECT_EQ(RETCODE_OK, Logging_RAMAppender->Init(NULL));
+    EXPECT_EQ(RETCODE_OK, Logging_RAMAppender->Write("xyz", 3));
+
+    EXPECT_EQ(RETCODE_OK, Logging_RAMAppender->Write("0123456789abcdefghij", 20));
+
+    EXPECT_EQ(std::string("456789abcdefghij"), ReadAll());
+}
+
+TEST_F(LogRamAppender, Read_Position)
+{
+    char buffer[LOG_RAM_APPENDER_SIZE];
+
+    EXPECT_EQ(RETCODE_OK, Logging_RAMAppender->Init(NULL));
+    EXPECT_EQ(RETCODE_OK, Logging_RAMAppender->Write("0123456789", 10));
+    EXPECT_EQ(RETCODE_OK, Logging_RAMAppender->Write("abcdefghij", 10));
+
+    /* Read in parts across the end of the ring */
+    EXPECT_EQ(UINT32_C(5), Logging_ReadRAMAppender(0, buffer, 5));
+    EXPECT_EQ(std::string("45678"), std::string(buffer, 5));
+    EXPECT_EQ(UINT32_C(5), Logging_ReadRAMAppender(5, buffer, 5));
+    EXPECT_EQ(std::string("9abcd"), std::string(buffer, 5));
+    EXPECT_EQ(UINT32_C(6), Logging_ReadRAMAppender(10, buffer, sizeof(buffer)));
+    EXPECT_EQ(std::string("efghij"), std::string(buffer, 6));
+    EXPECT_EQ(UINT32_C(0), Logging_ReadRAMAppender(16, buffer, sizeof(buffer)));
+}
+
+TEST_F(LogRamAppender, Read_InvalidBuffer)
+{
+    char buffer[LOG_RAM_APPENDER_SIZE];
+
+    EXPECT_EQ(UINT32_C(0), Logging_ReadRAMAppender(0, buffer, sizeof(buffer)));
+
+    EXPECT_EQ(RETCODE_OK, Logging_RAMAppender->Init(NULL));
+    EXPECT_EQ(UINT32_C(0), Logging_ReadRAMAppender(0, NULL, sizeof(buffer)));
+}
+
+TEST_F(LogRamAppender, Clear)
+{
+    EXPECT_EQ(RETCODE_OK, Logging_RAMAppender->Init(NULL));
+    EXPECT_EQ(RETCODE_OK, Logging_RAMAppender->Write("0123456789", 10));
+
+    Logging_ClearRAMAppender();
+
+    EXPECT_EQ(std::string(), ReadAll());
+    EXPECT_EQ(RETCODE_OK, Logging_RAMAppender->Write("abc", 3));
+    EXPECT_EQ(std::string("abc"), ReadAll());
+}
+
+#else
+}
+#endif /* if KISO_FEATURE_LOGGING */
@@ -41,12 +41,18 @@ extern "C"
 #include "Kiso_Assert_th.hh"
 #include "LogConfig.h"
 
+/* The rate limit is tested regardless of the configuration */
+#undef KISO_LOG_RATE_LIMIT
+#define KISO_LOG_RATE_LIMIT 1
+
 #include "Logging.c"
     /* End of global scope symbol and fake definitions section */
 }
 
 /* Fake one Filter API */
 FAKE_VALUE_FUNC(bool, LogFilter_Apply, LogLevel_T, uint8_t, uint8_t);
+FAKE_VALUE_FUNC(bool, LogRateLimit_Apply, LogLevel_T, uint8_t, uint8_t, const char *, uint32_t, uint32_t *);
+FAKE_VALUE_FUNC(bool, LogRateLimit_TakeSuppressed, LogRateLimitReport_T *);
 
 /* Define a fake recorder */
 FAKE_VALUE_FUNC(Retcode_T, RecorderInitFake, void *);
@@ -75,6 +81,16 @@ static const LogAppender_T Appender =
         .Write = AppenderWriteFake};
 const LogAppender_T *Fake_Appender = &Appender;
 
+/* Define a second fake appender */
+FAKE_VALUE_FUNC(Retcode_T, SecondAppenderInitFake, void *);
+FAKE_VALUE_FUNC(Retcode_T, SecondAppenderWriteFake, const char *, uint32_t);
+
+static const LogAppender_T SecondAppender =
+    {
+        .Init = SecondAppenderInitFake,
+        .Write = SecondAppenderWriteFake};
+const LogAppender_T *Fake_SecondAppender = &SecondAppender;
+
 class Logging : public testing::Test
 {
 protected:
@@ -83,11 +99,17 @@ protected:
         FFF_RESET_HISTORY()
 
         RESET_FAKE(LogFilter_Apply);
+        RESET_FAKE(LogRateLimit_Apply);
+        RESET_FAKE(LogRateLimit_TakeSuppressed);
         RESET_FAKE(RecorderInitFake);
         RESET_FAKE(RecorderDeinitFake);
         RESET_FAKE(RecorderWriteFake);
         RESET_FAKE(AppenderInitFake);
         RESET_FAKE(AppenderWriteFake);
+        RESET_FAKE(SecondAppenderInitFake);
+        RESET_FAKE(SecondAppenderWriteFake);
+
+        LogRateLimit_Apply_fake.return_val = true;
     }
 
     /* TearDown() is invoked immediately after a test finishes. */
@@ -100,6 +122,10 @@ protected:
         Logging_Recorder.Wakeup = NULL;
         Logging_Recorder.Appender.Init = NULL;
         Logging_Recorder.Appender.Write = NULL;
+        Logging_Recorder.Append = NULL;
+        memset(Logging_Appenders, 0, sizeof(Logging_Appenders));
+        Logging_AppenderCount = 0;
+        Logging_AppenderLevel = (uint8_t)LOG_LEVEL_NONE;
     }
 };
 
@@ -268,6 +294,239 @@ TEST_F(Logging, Logging_Log_WriteFail)
     EXPECT_EQ(UINT32_C(1), RecorderWriteFake_fake.call_count);
 }
 
+TEST_F(Logging, Logging_AddAppender_Success)
+{
+    Retcode_T retcode = RETCODE_OK;
+
+    retcode = Logging_Init(Fake_Recorder, Fake_Appender);
+    EXPECT_EQ(RETCODE_OK, retcode);
+
+    retcode = Logging_AddAppender(Fake_SecondAppender, LOG_LEVEL_ERROR);
+
+    EXPECT_EQ(RETCODE_OK, retcode);
+    EXPECT_EQ(UINT32_C(1), SecondAppenderInitFake_fake.call_count);
+    EXPECT_EQ(UINT32_C(2), Logging_AppenderCount);
+}
+
+TEST_F(Logging, Logging_AddAppender_InputFail)
+{
+    Retcode_T retcode = RETCODE_OK;
+    const LogAppender_T AppenderNull = {.Init = SecondAppenderInitFake, .Write = NULL};
+
+    retcode = Logging_Init(Fake_Recorder, Fake_Appender);
+    EXPECT_EQ(RETCODE_OK, retcode);
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INVALID_PARAM), Logging_AddAppender(NULL, LOG_LEVEL_ERROR));
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INVALID_PARAM), Logging_AddAppender(&AppenderNull, LOG_LEVEL_ERROR));
+    EXPECT_EQ(UINT32_C(0), SecondAppenderInitFake_fake.call_count);
+}
+
+TEST_F(Logging, Logging_AddAppender_NotInit)
+{
+    Retcode_T retcode = RETCODE_OK;
+
+    retcode = Logging_AddAppender(Fake_SecondAppender, LOG_LEVEL_ERROR);
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_UNINITIALIZED), retcode);
+    EXPECT_EQ(UINT32_C(0), SecondAppenderInitFake_fake.call_count);
+}
+
+TEST_F(Logging, Logging_AddAppender_AppenderInitFail)
+{
+    Retcode_T retcode = RETCODE_OK;
+    SecondAppenderInitFake_fake.return_val = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INCONSITENT_STATE);
+
+    retcode = Logging_Init(Fake_Recorder, Fake_Appender);
+    EXPECT_EQ(RETCODE_OK, retcode);
+
+    retcode = Logging_AddAppender(Fake_SecondAppender, LOG_LEVEL_ERROR);
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INCONSITENT_STATE), retcode);
+    EXPECT_EQ(UINT32_C(1), Logging_AppenderCount);
+}
+
+TEST_F(Logging, Logging_AddAppender_OutOfResources)
+{
+    Retcode_T retcode = RETCODE_OK;
+
+    retcode = Logging_Init(Fake_Recorder, Fake_Appender);
+    EXPECT_EQ(RETCODE_OK, retcode);
+    Logging_AppenderCount = LOG_APPENDER_COUNT;
+
+    retcode = Logging_AddAppender(Fake_SecondAppender, LOG_LEVEL_ERROR);
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_OUT_OF_RESOURCES), retcode);
+    EXPECT_EQ(UINT32_C(0), SecondAppenderInitFake_fake.call_count);
+}
+
+TEST_F(Logging, Logging_AddAppender_ChangeLevel)
+{
+    Retcode_T retcode = RETCODE_OK;
+
+    retcode = Logging_Init(Fake_Recorder, Fake_Appender);
+    EXPECT_EQ(RETCODE_OK, retcode);
+
+    /* The appender of Logging_Init() is already known, only its level changes */
+    retcode = Logging_AddAppender(Fake_Appender, LOG_LEVEL_WARNING);
+
+    EXPECT_EQ(RETCODE_OK, retcode);
+    EXPECT_EQ(UINT32_C(1), AppenderInitFake_fake.call_count);
+    EXPECT_EQ(UINT32_C(1), Logging_AppenderCount);
+    EXPECT_EQ((uint8_t)LOG_LEVEL_WARNING, Logging_AppenderLevel);
+}
+
+TEST_F(Logging, Logging_Append_FanOutByLevel)
+{
+    Retcode_T retcode = RETCODE_OK;
+    const char message[] = "message";
+
+    retcode = Logging_Init(Fake_Recorder, Fake_Appender);
+    EXPECT_EQ(RETCODE_OK, retcode);
+    retcode = Logging_AddAppender(Fake_SecondAppender, LOG_LEVEL_ERROR);
+    EXPECT_EQ(RETCODE_OK, retcode);
+    ASSERT_TRUE(NULL != Logging_Recorder.Append);
+
+    retcode = Logging_Recorder.Append(&Logging_Recorder, LOG_LEVEL_ERROR, message, sizeof(message));
+    EXPECT_EQ(RETCODE_OK, retcode);
+    EXPECT_EQ(UINT32_C(1), AppenderWriteFake_fake.call_count);
+    EXPECT_EQ(UINT32_C(1), SecondAppenderWriteFake_fake.call_count);
+
+    retcode = Logging_Recorder.Append(&Logging_Recorder, LOG_LEVEL_INFO, message, sizeof(message));
+    EXPECT_EQ(RETCODE_OK, retcode);
+    EXPECT_EQ(UINT32_C(2), AppenderWriteFake_fake.call_count);
+    EXPECT_EQ(UINT32_C(1), SecondAppenderWriteFake_fake.call_count);
+}
+
+TEST_F(Logging, Logging_Append_WriteFail)
+{
+    Retcode_T retcode = RETCODE_OK;
+    const char message[] = "message";
+    AppenderWriteFake_fake.return_val = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INCONSITENT_STATE);
+
+    retcode = Logging_Init(Fake_Recorder, Fake_Appender);
+    EXPECT_EQ(RETCODE_OK, retcode);
+    retcode = Logging_AddAppender(Fake_SecondAppender, LOG_LEVEL_DEBUG);
+    EXPECT_EQ(RETCODE_OK, retcode);
+
+    /* A failing appender does not keep the message from the others */
+    retcode = Logging_Recorder.Append(&Logging_Recorder, LOG_LEVEL_ERROR, message, sizeof(message));
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INCONSITENT_STATE), retcode);
+    EXPECT_EQ(UINT32_C(1), SecondAppenderWriteFake_fake.call_count);
+}
+
+TEST_F(Logging, Logging_Log_AboveAllAppenders)
+{
+    Retcode_T retcode = RETCODE_OK;
+    LogFilter_Apply_fake.return_val = true;
+
+    retcode = Logging_Init(Fake_Recorder, Fake_Appender);
+    EXPECT_EQ(RETCODE_OK, retcode);
+    retcode = Logging_AddAppender(Fake_Appender, LOG_LEVEL_WARNING);
+    EXPECT_EQ(RETCODE_OK, retcode);
+
+    retcode = Logging_Log(LOG_LEVEL_INFO, package, module, file, line, fmt, arg);
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_INFO, RETCODE_NOT_SUPPORTED), retcode);
+    EXPECT_EQ(UINT32_C(0), RecorderWriteFake_fake.call_count);
+    EXPECT_EQ(UINT32_C(0), LogFilter_Apply_fake.call_count);
+}
+
+TEST_F(Logging, Logging_Log_RateLimited)
+{
+    Retcode_T retcode = RETCODE_OK;
+    LogFilter_Apply_fake.return_val = true;
+    LogRateLimit_Apply_fake.return_val = false;
+
+    retcode = Logging_Init(Fake_Recorder, Fake_Appender);
+    EXPECT_EQ(RETCODE_OK, retcode);
+
+    retcode = Logging_Log(LOG_LEVEL_ERROR, package, module, file, line, fmt, arg);
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_INFO, RETCODE_NOT_SUPPORTED), retcode);
+    EXPECT_EQ(UINT32_C(1), LogRateLimit_Apply_fake.call_count);
+    EXPECT_EQ(package, LogRateLimit_Apply_fake.arg1_val);
+    EXPECT_EQ(module, LogRateLimit_Apply_fake.arg2_val);
+    EXPECT_EQ(file, LogRateLimit_Apply_fake.arg3_val);
+    EXPECT_EQ(line, LogRateLimit_Apply_fake.arg4_val);
+    EXPECT_EQ(UINT32_C(1), LogRateLimit_TakeSuppressed_fake.call_count);
+    EXPECT_EQ(UINT32_C(0), RecorderWriteFake_fake.call_count);
+}
+
+static bool LogRateLimit_ApplySuppressedFake(LogLevel_T callLevel, uint8_t callPackage, uint8_t callModule, const char *callFile, uint32_t callLine, uint32_t *suppressed)
+{
+    KISO_UNUSED(callLevel);
+    KISO_UNUSED(callPackage);
+    KISO_UNUSED(callModule);
+    KISO_UNUSED(callFile);
+    KISO_UNUSED(callLine);
+    *suppressed = 42;
+    return true;
+}
+
+TEST_F(Logging, Logging_Log_ReportsSuppressed)
+{
+    Retcode_T retcode = RETCODE_OK;
+    LogFilter_Apply_fake.return_val = true;
+    LogRateLimit_Apply_fake.custom_fake = LogRateLimit_ApplySuppressedFake;
+
+    retcode = Logging_Init(Fake_Recorder, Fake_Appender);
+    EXPECT_EQ(RETCODE_OK, retcode);
+
+    retcode = Logging_Log(LOG_LEVEL_WARNING, package, module, file, line, fmt, arg);
+
+    /* The count is recorded at the call site, before its message */
+    EXPECT_EQ(RETCODE_OK, retcode);
+    ASSERT_EQ(UINT32_C(2), RecorderWriteFake_fake.call_count);
+    EXPECT_STREQ(LOG_RATE_LIMIT_FMT, RecorderWriteFake_fake.arg6_history[0]);
+    EXPECT_EQ(LOG_LEVEL_WARNING, RecorderWriteFake_fake.arg1_history[0]);
+    EXPECT_EQ(line, RecorderWriteFake_fake.arg5_history[0]);
+    EXPECT_EQ(fmt, RecorderWriteFake_fake.arg6_history[1]);
+}
+
+static const char *OtherFile = "other.c";
+static bool LogRateLimit_TakeSuppressedFake(LogRateLimitReport_T *report)
+{
+    if (LogRateLimit_TakeSuppressed_fake.call_count > 2)
+    {
+        return false;
+    }
+    report->File = OtherFile;
+    report->Line = LogRateLimit_TakeSuppressed_fake.call_count;
+    report->Level = LOG_LEVEL_ERROR;
+    report->Package = 5;
+    report->Module = 6;
+    report->Suppressed = 9;
+    return true;
+}
+
+TEST_F(Logging, Logging_Log_ReportsSuppressedOfOtherCallSites)
+{
+    Retcode_T retcode = RETCODE_OK;
+    LogFilter_Apply_fake.return_val = true;
+    LogRateLimit_Apply_fake.return_val = false;
+    LogRateLimit_TakeSuppressed_fake.custom_fake = LogRateLimit_TakeSuppressedFake;
+
+    retcode = Logging_Init(Fake_Recorder, Fake_Appender);
+    EXPECT_EQ(RETCODE_OK, retcode);
+
+    retcode = Logging_Log(LOG_LEVEL_WARNING, package, module, file, line, fmt, arg);
+
+    /* The counts go to their call sites, even if the message itself is suppressed */
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_INFO, RETCODE_NOT_SUPPORTED), retcode);
+    EXPECT_EQ(UINT32_C(3), LogRateLimit_TakeSuppressed_fake.call_count);
+    ASSERT_EQ(UINT32_C(2), RecorderWriteFake_fake.call_count);
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        EXPECT_EQ(LOG_LEVEL_ERROR, RecorderWriteFake_fake.arg1_history[i]);
+        EXPECT_EQ(UINT8_C(5), RecorderWriteFake_fake.arg2_history[i]);
+        EXPECT_EQ(UINT8_C(6), RecorderWriteFake_fake.arg3_history[i]);
+        EXPECT_EQ(OtherFile, RecorderWriteFake_fake.arg4_history[i]);
+        EXPECT_EQ(i + 1U, RecorderWriteFake_fake.arg5_history[i]);
+        EXPECT_STREQ(LOG_RATE_LIMIT_FMT, RecorderWriteFake_fake.arg6_history[i]);
+    }
+}
+
 #else
 }
 
@@ -0,0 +1,322 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ *
+ * @brief
+ *      Module test specification for the Logging_AsyncRecorder_unittest.cc module.
+ *
+ * @detail
+ *      The unit test file template follows the Four-Phase test pattern.
+ *
+ * @file
+ **/
+
+/* Include gtest interface */
+#include <gtest.h>
+
+#include <string>
+#include <vector>
+
+/* Start of global scope symbol and fake definitions section */
+extern "C"
+{
+/* Module includes */
+#include "Kiso_Utils.h"
+#undef KISO_MODULE_ID
+#define KISO_MODULE_ID KISO_UTILS_MODULE_ID_LOGGING_RECORD_ASYNCHRONOUS
+
+/* Check if the logging feature is activated */
+#if KISO_FEATURE_LOGGING
+#include "LogConfig.h"
+
+/* The recorder is tested regardless of the recorder selected by the configuration */
+#undef KISO_ASYNC_RECORDER
+#define KISO_ASYNC_RECORDER 1
+
+#include "Kiso_Basics.h"
+#include "Kiso_Retcode_th.hh"
+#include "Kiso_Assert_th.hh"
+#include "Kiso_HAL_th.hh"
+#include "FreeRTOS_th.hh"
+#include "task_th.hh"
+#include "portmacro_th.hh"
+
+#include "Logging_AsyncRecorder.c"
+
+    /* End of global scope symbol and fake definitions section */
+}
+
+/* Define a fake appender, which keeps copies of the written lines */
+static std::vector<std::string> AppendedLines;
+
+static Retcode_T LogAppenderInitFake(void *wakeup)
+{
+    KISO_UNUSED(wakeup);
+    return RETCODE_OK;
+}
+
+static Retcode_T LogAppenderWriteFake(const char *message, uint32_t length)
+{
+    AppendedLines.push_back(std::string(message, length));
+    return RETCODE_OK;
+}
+
+static const LogAppender_T LogAppender =
+    {
+        .Init = LogAppenderInitFake,
+        .Write = LogAppenderWriteFake};
+
+static LogRecorder_T LogRecordAsyncTestInstance =
+    {
+        .Init = AsyncRecorder_Init,
+        .Deinit = AsyncRecorder_Deinit,
+        .Write = AsyncRecorder_Write,
+        .Wakeup = NULL,
+        .Appender = LogAppender};
+
+static int TaskHandleDummy;
+static char TaskName[] = "Sensor";
+
+static BaseType_t xTaskCreateFake(TaskHookFunction_t function, const char *name, unsigned short stackDepth, void *param, UBaseType_t priority, TaskHandle_t *handle)
+{
+    KISO_UNUSED(function);
+    KISO_UNUSED(name);
+    KISO_UNUSED(stackDepth);
+    KISO_UNUSED(param);
+    KISO_UNUSED(priority);
+    *handle = &TaskHandleDummy;
+    return pdPASS;
+}
+
+/* Write needs to be called in the va context */
+static Retcode_T callWrite(LogLevel_T level, uint32_t line, const char *fmt, ...)
+{
+    Retcode_T retcode = RETCODE_OK;
+
+    va_list args;
+    va_start(args, fmt);
+    retcode = LogRecordAsync.Write(&LogRecordAsyncTestInstance, level, 1, 2, "log.c", line, fmt, args);
+    va_end(args);
+
+    return retcode;
+}
+
+/* The tests */
+class Logging_AsyncRecorder : public testing::Test
+{
+protected:
+    virtual void SetUp()
+    {
+        RESET_FAKE(xTaskCreate);
+        RESET_FAKE(vTaskDelete);
+        RESET_FAKE(xTaskNotifyGive);
+        RESET_FAKE(vTaskNotifyGiveFromISR);
+        RESET_FAKE(xTaskGetTickCount);
+        RESET_FAKE(xTaskGetTickCountFromISR);
+        RESET_FAKE(pcTaskGetName);
+        RESET_FAKE(HAL_IsInISR);
+        FFF_RESET_HISTORY()
+
+        AppendedLines.clear();
+        LogTask = NULL;
+        LogRecordAsyncTestInstance.Wakeup = NULL;
+
+        xTaskCreate_fake.custom_fake = xTaskCreateFake;
+        xTaskGetTickCount_fake.return_val = 10;
+        pcTaskGetName_fake.return_val = TaskName;
+
+        ASSERT_EQ(RETCODE_OK, LogRecordAsync.Init(&LogRecordAsyncTestInstance));
+    }
+
+    /* TearDown() is invoked immediately after a test finishes. */
+    virtual void TearDown()
+    {
+        (void)LogRecordAsync.Deinit(&LogRecordAsyncTestInstance);
+    }
+};
+
+TEST_F(Logging_AsyncRecorder, Logging_AsyncRecorderInitialization_Success)
+{
+    EXPECT_EQ(1U, xTaskCreate_fake.call_count);
+    EXPECT_EQ((UBaseType_t)LOG_TASK_PRIORITY, xTaskCreate_fake.arg4_val);
+    EXPECT_EQ(&TaskHandleDummy, LogRecordAsyncTestInstance.Wakeup);
+    EXPECT_EQ(0U, Logging_GetDroppedCount());
+}
+
+TEST_F(Logging_AsyncRecorder, Logging_AsyncRecorderInitialization_NullPointerGiven)
+{
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), LogRecordAsync.Init(NULL));
+}
+
+TEST_F(Logging_AsyncRecorder, Logging_AsyncRecorderInitialization_AlreadyInitialized)
+{
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INCONSISTENT_STATE), LogRecordAsync.Init(&LogRecordAsyncTestInstance));
+}
+
+TEST_F(Logging_AsyncRecorder, Logging_AsyncRecorderInitialization_TaskCreationFails)
+{
+    (void)LogRecordAsync.Deinit(&LogRecordAsyncTestInstance);
+    xTaskCreate_fake.custom_fake = NULL;
+    xTaskCreate_fake.return_val = pdFAIL;
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_OUT_OF_RESOURCES), LogRecordAsync.Init(&LogRecordAsyncTestInstance));
+    EXPECT_EQ(NULL, LogTask);
+}
+
+TEST_F(Logging_AsyncRecorder, Logging_AsyncRecorderDeinitialization_Success)
+{
+    EXPECT_EQ(RETCODE_OK, LogRecordAsync.Deinit(&LogRecordAsyncTestInstance));
+
+    EXPECT_EQ(1U, vTaskDelete_fake.call_count);
+    EXPECT_EQ(&TaskHandleDummy, vTaskDelete_fake.arg0_val);
+    EXPECT_EQ(NULL, LogRecordAsyncTestInstance.Wakeup);
+}
+
+TEST_F(Logging_AsyncRecorder, Logging_AsyncRecorderDeinitialization_NullPointerGiven)
+{
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), LogRecordAsync.Deinit(NULL));
+}
+
+TEST_F(Logging_AsyncRecorder, Logging_AsyncRecorderWrite_NullPointerGiven)
+{
+    va_list args;
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), LogRecordAsync.Write(&LogRecordAsyncTestInstance, LOG_LEVEL_ERROR, 1, 2, NULL, 32, "fmt", args));
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), LogRecordAsync.Write(&LogRecordAsyncTestInstance, LOG_LEVEL_ERROR, 1, 2, "log.c", 32, NULL, args));
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), LogRecordAsync.Write(NULL, LOG_LEVEL_ERROR, 1, 2, "log.c", 32, "fmt", args));
+}
+
+TEST_F(Logging_AsyncRecorder, Logging_AsyncRecorderWrite_DeferredToLoggingTask)
+{
+    EXPECT_EQ(RETCODE_OK, callWrite(LOG_LEVEL_ERROR, 32, "string %s", "error"));
+
+    /* The caller only queues and wakes up the logging task */
+    EXPECT_EQ(0U, AppendedLines.size());
+    EXPECT_EQ(1U, xTaskNotifyGive_fake.call_count);
+    EXPECT_EQ(&TaskHandleDummy, xTaskNotifyGive_fake.arg0_val);
+
+    /* Formatting takes place in the logging task, with the tick and task name of the caller */
+    xTaskGetTickCount_fake.return_val = 99;
+    pcTaskGetName_fake.return_val = NULL;
+    EXPECT_EQ(1U, AsyncRecorder_Drain(&LogRecordAsyncTestInstance));
+
+    ASSERT_EQ(1U, AppendedLines.size());
+    EXPECT_EQ("10 E 1 Sensor\t[log.c:32]\tstring error\r\n", AppendedLines[0]);
+    EXPECT_EQ(0U, AsyncRecorder_Drain(&LogRecordAsyncTestInstance));
+}
+
+TEST_F(Logging_AsyncRecorder, Logging_AsyncRecorderWrite_KeepsOrder)
+{
+    EXPECT_EQ(RETCODE_OK, callWrite(LOG_LEVEL_INFO, 1, "first"));
+    EXPECT_EQ(RETCODE_OK, callWrite(LOG_LEVEL_WARNING, 2, "second %d", 2));
+
+    EXPECT_EQ(2U, AsyncRecorder_Drain(&LogRecordAsyncTestInstance));
+
+    ASSERT_EQ(2U, AppendedLines.size());
+    EXPECT_EQ("10 I 1 Sensor\t[log.c:1]\tfirst\r\n", AppendedLines[0]);
+    EXPECT_EQ("10 W 1 Sensor\t[log.c:2]\tsecond 2\r\n", AppendedLines[1]);
+}
+
+TEST_F(Logging_AsyncRecorder, Logging_AsyncRecorderWrite_FromIsr)
+{
+    HAL_IsInISR_fake.return_val = true;
+    xTaskGetTickCountFromISR_fake.return_val = 20;
+
+    EXPECT_EQ(RETCODE_OK, callWrite(LOG_LEVEL_DEBUG, 7, "irq"));
+
+    EXPECT_EQ(0U, xTaskNotifyGive_fake.call_count);
+    EXPECT_EQ(0U, xTaskGetTickCount_fake.call_count);
+    EXPECT_EQ(0U, pcTaskGetName_fake.call_count);
+    EXPECT_EQ(1U, vTaskNotifyGiveFromISR_fake.call_count);
+
+    EXPECT_EQ(1U, AsyncRecorder_Drain(&LogRecordAsyncTestInstance));
+    ASSERT_EQ(1U, AppendedLines.size());
+    EXPECT_EQ("20 D 1 ISR\t[log.c:7]\tirq\r\n", AppendedLines[0]);
+}
+
+TEST_F(Logging_AsyncRecorder, Logging_AsyncRecorderWrite_OverflowIsCounted)
+{
+    for (uint32_t i = 0; i < (uint32_t)LOG_QUEUE_SLOT_COUNT; i++)
+    {
+        EXPECT_EQ(RETCODE_OK, callWrite(LOG_LEVEL_INFO, i, "message"));
+    }
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_WARNING, RETCODE_OUT_OF_RESOURCES), callWrite(LOG_LEVEL_INFO, 100, "lost"));
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_WARNING, RETCODE_OUT_OF_RESOURCES), callWrite(LOG_LEVEL_INFO, 101, "lost"));
+    EXPECT_EQ(2U, Logging_GetDroppedCount());
+
+    EXPECT_EQ((uint32_t)LOG_QUEUE_SLOT_COUNT, AsyncRecorder_Drain(&LogRecordAsyncTestInstance));
+
+    /* The loss is reported in the log once */
+    ASSERT_EQ((uint32_t)LOG_QUEUE_SLOT_COUNT + 1U, AppendedLines.size());
+    EXPECT_EQ("2 log messages dropped\r\n", AppendedLines.back());
+
+    /* The slots are free again */
+    EXPECT_EQ(RETCODE_OK, callWrite(LOG_LEVEL_INFO, 102, "again"));
+    EXPECT_EQ(1U, AsyncRecorder_Drain(&LogRecordAsyncTestInstance));
+    EXPECT_EQ((uint32_t)LOG_QUEUE_SLOT_COUNT + 2U, AppendedLines.size());
+    EXPECT_EQ(2U, Logging_GetDroppedCount());
+}
+
+TEST_F(Logging_AsyncRecorder, Logging_AsyncRecorderWrite_WrapsAround)
+{
+    for (uint32_t i = 0; i < (3U * (uint32_t)LOG_QUEUE_SLOT_COUNT); i++)
+    {
+        EXPECT_EQ(RETCODE_OK, callWrite(LOG_LEVEL_INFO, i, "message %u", (unsigned)i));
+        EXPECT_EQ(1U, AsyncRecorder_Drain(&LogRecordAsyncTestInstance));
+    }
+    EXPECT_EQ("10 I 1 Sensor\t[log.c:23]\tmessage 23\r\n", AppendedLines[23]);
+}
+
+TEST_F(Logging_AsyncRecorder, Logging_AsyncRecorderWrite_LongMessageIsCut)
+{
+    std::string longText(2U * LOG_BUFFER_SIZE, 'x');
+
+    EXPECT_EQ(RETCODE_OK, callWrite(LOG_LEVEL_ERROR, 32, "%s", longText.c_str()));
+    EXPECT_EQ(1U, AsyncRecorder_Drain(&LogRecordAsyncTestInstance));
+
+    ASSERT_EQ(1U, AppendedLines.size());
+    EXPECT_GE((size_t)LOG_BUFFER_SIZE, AppendedLines[0].size());
+    EXPECT_EQ(0U, AppendedLines[0].find("10 E 1 Sensor\t[log.c:32]\txxx"));
+    EXPECT_EQ("x\r\n", AppendedLines[0].substr(AppendedLines[0].size() - 3U));
+}
+
+TEST_F(Logging_AsyncRecorder, Logging_AsyncRecorderWrite_UnpublishedSlotStopsDrain)
+{
+    /* A producer which has claimed a slot but not yet published it, e.g. preempted by an ISR */
+    AsyncRecorder_Slot_T *slot = AsyncRecorder_Claim();
+    ASSERT_TRUE(NULL != slot);
+
+    EXPECT_EQ(RETCODE_OK, callWrite(LOG_LEVEL_INFO, 1, "later"));
+    EXPECT_EQ(0U, AsyncRecorder_Drain(&LogRecordAsyncTestInstance));
+
+    /* The preempted producer finishes */
+    slot->Header.Level = LOG_LEVEL_INFO;
+    slot->Header.Package = 1;
+    slot->Header.File = "log.c";
+    slot->Header.Line = 0;
+    slot->Header.Tick = 10;
+    strncpy(slot->Header.TaskName, "Sensor", sizeof(slot->Header.TaskName));
+    strncpy(slot->Message, "earlier", sizeof(slot->Message));
+    __atomic_store_n(&slot->Header.Sequence, slot->Header.Sequence + 1, __ATOMIC_RELEASE);
+
+    EXPECT_EQ(2U, AsyncRecorder_Drain(&LogRecordAsyncTestInstance));
+    ASSERT_EQ(2U, AppendedLines.size());
+    EXPECT_EQ("10 I 1 Sensor\t[log.c:0]\tearlier\r\n", AppendedLines[0]);
+    EXPECT_EQ("10 I 1 Sensor\t[log.c:1]\tlater\r\n", AppendedLines[1]);
+}
+
+#else
+}
+#endif /* if KISO_FEATURE_LOGGING */
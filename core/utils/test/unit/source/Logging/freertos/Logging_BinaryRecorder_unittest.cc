@@ -0,0 +1,291 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ *
+ * @brief
+ *      Module test specification for the Logging_BinaryRecorder_unittest.cc module.
+ *
+ * @detail
+ *      The unit test file template follows the Four-Phase test pattern.
+ *
+ * @file
+ **/
+
+/* Include gtest interface */
+#include <gtest.h>
+
+#include <string>
+#include <vector>
+
+/* Start of global scope symbol and fake definitions section */
+extern "C"
+{
+/* Module includes */
+#include "Kiso_Utils.h"
+#undef KISO_MODULE_ID
+#define KISO_MODULE_ID KISO_UTILS_MODULE_ID_LOGGING_RECORD_BINARY
+
+/* Check if the logging feature is activated */
+#if KISO_FEATURE_LOGGING
+#include "LogConfig.h"
+
+/* The recorder is tested regardless of the recorder selected by the configuration */
+#undef KISO_BINARY_RECORDER
+#define KISO_BINARY_RECORDER 1
+#undef LOG_BINARY_RECORD_SIZE
+#define LOG_BINARY_RECORD_SIZE (UINT16_C(64))
+
+#include "Kiso_Basics.h"
+#include "Kiso_Retcode_th.hh"
+#include "Kiso_Assert_th.hh"
+#include "Kiso_XProtocol_th.hh"
+#include "FreeRTOS_th.hh"
+#include "task_th.hh"
+#include "portmacro_th.hh"
+
+#include "Logging_BinaryRecorder.c"
+
+    /* End of global scope symbol and fake definitions section */
+}
+
+/* Define a fake appender, which keeps a copy of the written frame */
+static std::vector<uint8_t> AppendedFrame;
+
+static Retcode_T LogAppenderInitFake(void *wakeup)
+{
+    KISO_UNUSED(wakeup);
+    return RETCODE_OK;
+}
+
+static Retcode_T LogAppenderWriteFake(const char *message, uint32_t length)
+{
+    AppendedFrame.assign((const uint8_t *)message, (const uint8_t *)message + length);
+    return RETCODE_OK;
+}
+
+static const LogAppender_T LogAppender =
+    {
+        .Init = LogAppenderInitFake,
+        .Write = LogAppenderWriteFake};
+
+static LogRecorder_T LogRecordBinaryTestInstance =
+    {
+        .Init = BinaryRecorder_Init,
+        .Deinit = BinaryRecorder_Deinit,
+        .Write = BinaryRecorder_Write,
+        .Wakeup = NULL,
+        .Appender = LogAppender};
+
+/* The frame is the record itself, the framing is tested with XProtocol */
+static Retcode_T XProtocolEncodeFrameFake(const uint8_t *data, uint32_t dataLength, uint32_t maxFrameLength, uint8_t *frame, uint32_t *frameLength)
+{
+    if (dataLength > maxFrameLength)
+    {
+        return RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_FRAME_BUFFER_TOO_SMALL);
+    }
+    memcpy(frame, data, dataLength);
+    *frameLength = dataLength;
+    return RETCODE_OK;
+}
+
+static const char File[] = "log.c";
+
+/* Write needs to be called in the va context */
+static Retcode_T callWrite(const char *fmt, ...)
+{
+    Retcode_T retcode = RETCODE_OK;
+
+    va_list args;
+    va_start(args, fmt);
+    retcode = LogRecordBinary.Write(&LogRecordBinaryTestInstance, LOG_LEVEL_WARNING, 1, 2, File, 32, fmt, args);
+    va_end(args);
+
+    return retcode;
+}
+
+static uint32_t GetUint32(size_t offset)
+{
+    return (uint32_t)AppendedFrame[offset] | ((uint32_t)AppendedFrame[offset + 1] << 8) |
+           ((uint32_t)AppendedFrame[offset + 2] << 16) | ((uint32_t)AppendedFrame[offset + 3] << 24);
+}
+
+static uint64_t GetUint64(size_t offset)
+{
+    return (uint64_t)GetUint32(offset) | ((uint64_t)GetUint32(offset + 4) << 32);
+}
+
+/* The tests */
+class Logging_BinaryRecorder : public testing::Test
+{
+protected:
+    virtual void SetUp()
+    {
+        RESET_FAKE(XProtocol_EncodeFrame);
+        RESET_FAKE(xTaskGetTickCount);
+        FFF_RESET_HISTORY()
+
+        AppendedFrame.clear();
+        XProtocol_EncodeFrame_fake.custom_fake = XProtocolEncodeFrameFake;
+        xTaskGetTickCount_fake.return_val = 10;
+    }
+};
+
+TEST_F(Logging_BinaryRecorder, Logging_BinaryRecorderInitialization_Success)
+{
+    EXPECT_EQ(RETCODE_OK, LogRecordBinary.Init(&LogRecordBinaryTestInstance));
+    EXPECT_EQ(RETCODE_OK, LogRecordBinary.Deinit(&LogRecordBinaryTestInstance));
+}
+
+TEST_F(Logging_BinaryRecorder, Logging_BinaryRecorderInitialization_NullPointerGiven)
+{
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), LogRecordBinary.Init(NULL));
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), LogRecordBinary.Deinit(NULL));
+}
+
+TEST_F(Logging_BinaryRecorder, Logging_BinaryRecorderWrite_NullPointerGiven)
+{
+    va_list args;
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), LogRecordBinary.Write(&LogRecordBinaryTestInstance, LOG_LEVEL_ERROR, 1, 2, NULL, 32, "fmt", args));
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), LogRecordBinary.Write(&LogRecordBinaryTestInstance, LOG_LEVEL_ERROR, 1, 2, "log.c", 32, NULL, args));
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), LogRecordBinary.Write(NULL, LOG_LEVEL_ERROR, 1, 2, "log.c", 32, "fmt", args));
+    EXPECT_EQ(0U, XProtocol_EncodeFrame_fake.call_count);
+}
+
+TEST_F(Logging_BinaryRecorder, Logging_BinaryRecorderWrite_Header)
+{
+    static const char fmt[] = "no arguments";
+
+    EXPECT_EQ(RETCODE_OK, callWrite(fmt));
+
+    ASSERT_EQ(20U, AppendedFrame.size());
+    EXPECT_EQ(0U, AppendedFrame[0]);
+    EXPECT_EQ((uint8_t)LOG_LEVEL_WARNING, AppendedFrame[1]);
+    EXPECT_EQ(1U, AppendedFrame[2]);
+    EXPECT_EQ(2U, AppendedFrame[3]);
+    EXPECT_EQ(10U, GetUint32(4));
+    EXPECT_EQ((uint32_t)(uintptr_t)fmt, GetUint32(8));
+    EXPECT_EQ((uint32_t)(uintptr_t)File, GetUint32(12));
+    EXPECT_EQ(32U, GetUint32(16));
+}
+
+TEST_F(Logging_BinaryRecorder, Logging_BinaryRecorderWrite_Integers)
+{
+    EXPECT_EQ(RETCODE_OK, callWrite("%d %u %5x %c %hhu %" PRIu32 " %lld %% %p", -2, 3U, 0xABU, 'k', (unsigned char)7,
+                                    (uint32_t)8, -9LL, (void *)0x1234));
+
+    ASSERT_EQ(20U + 6U * 4U + 8U + 4U, AppendedFrame.size());
+    EXPECT_EQ(0U, AppendedFrame[0]);
+    EXPECT_EQ((uint32_t)-2, GetUint32(20));
+    EXPECT_EQ(3U, GetUint32(24));
+    EXPECT_EQ(0xABU, GetUint32(28));
+    EXPECT_EQ((uint32_t)'k', GetUint32(32));
+    EXPECT_EQ(7U, GetUint32(36));
+    EXPECT_EQ(8U, GetUint32(40));
+    EXPECT_EQ((uint64_t)-9LL, GetUint64(44));
+    EXPECT_EQ(0x1234U, GetUint32(52));
+}
+
+TEST_F(Logging_BinaryRecorder, Logging_BinaryRecorderWrite_Double)
+{
+    double value = 1.5;
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    EXPECT_EQ(RETCODE_OK, callWrite("%.2f %Lg", value, (long double)value));
+
+    ASSERT_EQ(20U + 8U + 8U, AppendedFrame.size());
+    EXPECT_EQ(bits, GetUint64(20));
+    EXPECT_EQ(bits, GetUint64(28));
+}
+
+TEST_F(Logging_BinaryRecorder, Logging_BinaryRecorderWrite_Strings)
+{
+    EXPECT_EQ(RETCODE_OK, callWrite("%s|%.3s|%s", "abc", "defgh", (const char *)NULL));
+
+    ASSERT_EQ(20U + 4U + 4U + 7U, AppendedFrame.size());
+    EXPECT_EQ(std::string("\x03" "abc" "\x03" "def" "\x06" "(null)"), std::string(AppendedFrame.begin() + 20, AppendedFrame.end()));
+}
+
+TEST_F(Logging_BinaryRecorder, Logging_BinaryRecorderWrite_StarPrecisionString)
+{
+    /* As used by the cellular tracing, the string is not terminated */
+    static const char trace[] = {'O', 'K', '\r', '\n', 'x'};
+
+    EXPECT_EQ(RETCODE_OK, callWrite("Cellular-COM [%d]: %.*s", 4, 4, trace));
+
+    ASSERT_EQ(20U + 4U + 4U + 5U, AppendedFrame.size());
+    EXPECT_EQ(4U, GetUint32(20));
+    EXPECT_EQ(4U, GetUint32(24));
+    EXPECT_EQ(std::string("\x04" "OK\r\n"), std::string(AppendedFrame.begin() + 28, AppendedFrame.end()));
+}
+
+TEST_F(Logging_BinaryRecorder, Logging_BinaryRecorderWrite_StarWidth)
+{
+    EXPECT_EQ(RETCODE_OK, callWrite("%-*d|", 6, 42));
+
+    ASSERT_EQ(20U + 4U + 4U, AppendedFrame.size());
+    EXPECT_EQ(6U, GetUint32(20));
+    EXPECT_EQ(42U, GetUint32(24));
+}
+
+TEST_F(Logging_BinaryRecorder, Logging_BinaryRecorderWrite_LongStringIsCut)
+{
+    std::string longText(2U * LOG_BINARY_RECORD_SIZE, 'x');
+
+    EXPECT_EQ(RETCODE_OK, callWrite("%s %d", longText.c_str(), 1));
+
+    ASSERT_EQ((size_t)LOG_BINARY_RECORD_SIZE, AppendedFrame.size());
+    EXPECT_EQ(BINARY_RECORD_FLAG_TRUNCATED, AppendedFrame[0]);
+    EXPECT_EQ((uint8_t)(LOG_BINARY_RECORD_SIZE - 21U), AppendedFrame[20]);
+}
+
+TEST_F(Logging_BinaryRecorder, Logging_BinaryRecorderWrite_TooManyArgumentsAreCut)
+{
+    EXPECT_EQ(RETCODE_OK, callWrite("%d %d %d %d %d %d %d %d %d %d %d %d", 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12));
+
+    ASSERT_EQ(20U + 11U * 4U, AppendedFrame.size());
+    EXPECT_EQ(BINARY_RECORD_FLAG_TRUNCATED, AppendedFrame[0]);
+    EXPECT_EQ(11U, GetUint32(60));
+}
+
+TEST_F(Logging_BinaryRecorder, Logging_BinaryRecorderWrite_UnknownConversionStops)
+{
+    EXPECT_EQ(RETCODE_OK, callWrite("%d %y %d", 1, 2));
+
+    ASSERT_EQ(20U + 4U, AppendedFrame.size());
+    EXPECT_EQ(BINARY_RECORD_FLAG_TRUNCATED, AppendedFrame[0]);
+}
+
+TEST_F(Logging_BinaryRecorder, Logging_BinaryRecorderWrite_EncodingFails)
+{
+    XProtocol_EncodeFrame_fake.custom_fake = NULL;
+    XProtocol_EncodeFrame_fake.return_val = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_FRAME_BUFFER_TOO_SMALL);
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_FRAME_BUFFER_TOO_SMALL), callWrite("fmt"));
+    EXPECT_EQ(0U, AppendedFrame.size());
+}
+
+TEST_F(Logging_BinaryRecorder, Logging_BinaryRecorderWrite_FrameBufferIsLargeEnough)
+{
+    EXPECT_EQ(RETCODE_OK, callWrite("fmt"));
+
+    EXPECT_EQ(20U, XProtocol_EncodeFrame_fake.arg1_val);
+    EXPECT_EQ(XPROTOCOL_MAX_ENCODED_LENGTH(LOG_BINARY_RECORD_SIZE), XProtocol_EncodeFrame_fake.arg2_val);
+}
+
+#else
+}
+#endif /* if KISO_FEATURE_LOGGING */
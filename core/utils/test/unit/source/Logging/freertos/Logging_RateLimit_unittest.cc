@@ -0,0 +1,305 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ *
+ * @brief
+ *      Module test specification for the Logging_RateLimit_unittest.cc module.
+ *
+ * @detail
+ *      The unit test file template follows the Four-Phase test pattern.
+ *
+ * @file
+ **/
+
+/* Include gtest interface */
+#include <gtest.h>
+
+/* Start of global scope symbol and fake definitions section */
+extern "C"
+{
+/* Module includes */
+#include "Kiso_Utils.h"
+#undef KISO_MODULE_ID
+#define KISO_MODULE_ID KISO_UTILS_MODULE_ID_LOGGING_RATE_LIMIT
+
+/* Check if the logging feature is activated */
+#if KISO_FEATURE_LOGGING
+#include "LogConfig.h"
+
+/* The rate limit is tested regardless of the configuration, with a small table */
+#undef KISO_LOG_RATE_LIMIT
+#define KISO_LOG_RATE_LIMIT 1
+#undef LOG_RATE_LIMIT_SLOTS
+#define LOG_RATE_LIMIT_SLOTS (UINT8_C(4))
+#undef LOG_RATE_LIMIT_WINDOW
+#define LOG_RATE_LIMIT_WINDOW (UINT32_C(1000))
+#undef LOG_RATE_LIMIT_BUDGET_FATAL
+#define LOG_RATE_LIMIT_BUDGET_FATAL (UINT16_C(0))
+#undef LOG_RATE_LIMIT_BUDGET_WARNING
+#define LOG_RATE_LIMIT_BUDGET_WARNING (UINT16_C(2))
+
+#include "Kiso_Basics.h"
+#include "Kiso_Retcode_th.hh"
+#include "Kiso_Assert_th.hh"
+#include "Kiso_HAL_th.hh"
+#include "Kiso_HAL_CriticalSection_th.hh"
+#include "FreeRTOS_th.hh"
+#include "task_th.hh"
+#include "portmacro_th.hh"
+
+#include "Logging_RateLimit.c"
+
+    /* End of global scope symbol and fake definitions section */
+}
+
+static const char *FileA = "a.c";
+static const char *FileB = "b.c";
+static const uint8_t Package = 3;
+static const uint8_t Module = 7;
+
+class LogRateLimit : public testing::Test
+{
+protected:
+    virtual void SetUp()
+    {
+        FFF_RESET_HISTORY()
+        RESET_FAKE(HAL_IsInISR);
+        RESET_FAKE(HAL_CriticalSection_Enter);
+        RESET_FAKE(HAL_CriticalSection_Leave);
+        RESET_FAKE(xTaskGetTickCount);
+        RESET_FAKE(xTaskGetTickCountFromISR);
+
+        memset(LogRateLimitSlots, 0, sizeof(LogRateLimitSlots));
+        memset(LogRateLimitEvicted, 0, sizeof(LogRateLimitEvicted));
+        LogRateLimitPending = 0;
+        xTaskGetTickCount_fake.return_val = 5000;
+    }
+
+    /* Logs count times, returns how many passed */
+    uint32_t LogTimes(uint32_t count, LogLevel_T level, const char *file, uint32_t line)
+    {
+        uint32_t passed = 0;
+        uint32_t suppressed;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            passed += LogRateLimit_Apply(level, Package, Module, file, line, &suppressed) ? 1U : 0U;
+        }
+        return passed;
+    }
+};
+
+TEST_F(LogRateLimit, Apply_WithinBudget)
+{
+    uint32_t suppressed = 1;
+
+    EXPECT_TRUE(LogRateLimit_Apply(LOG_LEVEL_WARNING, Package, Module, FileA, 10, &suppressed));
+    EXPECT_EQ(UINT32_C(0), suppressed);
+    EXPECT_TRUE(LogRateLimit_Apply(LOG_LEVEL_WARNING, Package, Module, FileA, 10, &suppressed));
+    EXPECT_EQ(UINT32_C(2), HAL_CriticalSection_Enter_fake.call_count);
+    EXPECT_EQ(UINT32_C(2), HAL_CriticalSection_Leave_fake.call_count);
+}
+
+TEST_F(LogRateLimit, Apply_SuppressesAboveBudget)
+{
+    uint32_t suppressed = 0;
+
+    EXPECT_EQ(UINT32_C(2), LogTimes(10, LOG_LEVEL_WARNING, FileA, 10));
+
+    /* The next window reports the count with its first message */
+    xTaskGetTickCount_fake.return_val += 1000;
+    EXPECT_TRUE(LogRateLimit_Apply(LOG_LEVEL_WARNING, Package, Module, FileA, 10, &suppressed));
+    EXPECT_EQ(UINT32_C(8), suppressed);
+    EXPECT_TRUE(LogRateLimit_Apply(LOG_LEVEL_WARNING, Package, Module, FileA, 10, &suppressed));
+    EXPECT_EQ(UINT32_C(0), suppressed);
+    EXPECT_FALSE(LogRateLimit_Apply(LOG_LEVEL_WARNING, Package, Module, FileA, 10, &suppressed));
+}
+
+TEST_F(LogRateLimit, Apply_SameWindow)
+{
+    EXPECT_EQ(UINT32_C(2), LogTimes(3, LOG_LEVEL_WARNING, FileA, 10));
+
+    xTaskGetTickCount_fake.return_val += 999;
+
+    EXPECT_EQ(UINT32_C(0), LogTimes(1, LOG_LEVEL_WARNING, FileA, 10));
+}
+
+TEST_F(LogRateLimit, Apply_CallSitesSeparately)
+{
+    EXPECT_EQ(UINT32_C(2), LogTimes(5, LOG_LEVEL_WARNING, FileA, 10));
+    EXPECT_EQ(UINT32_C(2), LogTimes(5, LOG_LEVEL_WARNING, FileA, 11));
+    EXPECT_EQ(UINT32_C(2), LogTimes(5, LOG_LEVEL_WARNING, FileB, 10));
+}
+
+TEST_F(LogRateLimit, Apply_UnlimitedLevel)
+{
+    EXPECT_EQ(UINT32_C(100), LogTimes(100, LOG_LEVEL_FATAL, FileA, 10));
+    EXPECT_EQ(UINT32_C(0), HAL_CriticalSection_Enter_fake.call_count);
+    EXPECT_EQ(UINT32_C(0), xTaskGetTickCount_fake.call_count);
+}
+
+TEST_F(LogRateLimit, Apply_InvalidLevel)
+{
+    EXPECT_EQ(UINT32_C(3), LogTimes(3, LOG_LEVEL_COUNT, FileA, 10));
+}
+
+TEST_F(LogRateLimit, Apply_ReplacesOldestCallSite)
+{
+    uint32_t suppressed = 0;
+
+    /* More call sites than slots, each one older than the next */
+    for (uint32_t line = 0; line < LOG_RATE_LIMIT_SLOTS + 1U; ++line)
+    {
+        EXPECT_EQ(UINT32_C(2), LogTimes(3, LOG_LEVEL_WARNING, FileA, line));
+        xTaskGetTickCount_fake.return_val += 10;
+    }
+
+    /* The newest call sites are still limited, the oldest one starts again */
+    EXPECT_FALSE(LogRateLimit_Apply(LOG_LEVEL_WARNING, Package, Module, FileA, LOG_RATE_LIMIT_SLOTS, &suppressed));
+    EXPECT_FALSE(LogRateLimit_Apply(LOG_LEVEL_WARNING, Package, Module, FileA, LOG_RATE_LIMIT_SLOTS - 1U, &suppressed));
+    EXPECT_TRUE(LogRateLimit_Apply(LOG_LEVEL_WARNING, Package, Module, FileA, 0, &suppressed));
+    EXPECT_EQ(UINT32_C(0), suppressed);
+}
+
+TEST_F(LogRateLimit, TakeSuppressed_None)
+{
+    LogRateLimitReport_T report;
+
+    EXPECT_EQ(UINT32_C(2), LogTimes(2, LOG_LEVEL_WARNING, FileA, 10));
+
+    /* Nothing pending, checked without the critical section */
+    EXPECT_FALSE(LogRateLimit_TakeSuppressed(&report));
+    EXPECT_EQ(UINT32_C(2), HAL_CriticalSection_Enter_fake.call_count);
+}
+
+TEST_F(LogRateLimit, TakeSuppressed_WithinWindow)
+{
+    LogRateLimitReport_T report;
+
+    EXPECT_EQ(UINT32_C(2), LogTimes(5, LOG_LEVEL_WARNING, FileA, 10));
+
+    /* The call site may still report the count itself */
+    xTaskGetTickCount_fake.return_val += 999;
+    EXPECT_FALSE(LogRateLimit_TakeSuppressed(&report));
+}
+
+TEST_F(LogRateLimit, TakeSuppressed_AfterWindow)
+{
+    LogRateLimitReport_T report;
+    uint32_t suppressed = 1;
+
+    EXPECT_EQ(UINT32_C(2), LogTimes(5, LOG_LEVEL_WARNING, FileA, 10));
+    EXPECT_EQ(UINT32_C(1), LogRateLimitPending);
+
+    /* The call site does not log again, any other one takes its count */
+    xTaskGetTickCount_fake.return_val += 1000;
+    ASSERT_TRUE(LogRateLimit_TakeSuppressed(&report));
+    EXPECT_EQ(FileA, report.File);
+    EXPECT_EQ(UINT32_C(10), report.Line);
+    EXPECT_EQ(LOG_LEVEL_WARNING, report.Level);
+    EXPECT_EQ(Package, report.Package);
+    EXPECT_EQ(Module, report.Module);
+    EXPECT_EQ(UINT32_C(3), report.Suppressed);
+    EXPECT_FALSE(LogRateLimit_TakeSuppressed(&report));
+    EXPECT_EQ(UINT32_C(0), LogRateLimitPending);
+
+    /* Which is not reported twice */
+    EXPECT_TRUE(LogRateLimit_Apply(LOG_LEVEL_WARNING, Package, Module, FileA, 10, &suppressed));
+    EXPECT_EQ(UINT32_C(0), suppressed);
+}
+
+TEST_F(LogRateLimit, TakeSuppressed_ReportedByCallSite)
+{
+    LogRateLimitReport_T report;
+    uint32_t suppressed = 0;
+
+    EXPECT_EQ(UINT32_C(2), LogTimes(5, LOG_LEVEL_WARNING, FileA, 10));
+
+    xTaskGetTickCount_fake.return_val += 1000;
+    EXPECT_TRUE(LogRateLimit_Apply(LOG_LEVEL_WARNING, Package, Module, FileA, 10, &suppressed));
+    EXPECT_EQ(UINT32_C(3), suppressed);
+    EXPECT_FALSE(LogRateLimit_TakeSuppressed(&report));
+}
+
+TEST_F(LogRateLimit, TakeSuppressed_Evicted)
+{
+    LogRateLimitReport_T report;
+
+    /* Every slot holds a count, one more call site replaces the oldest within its window */
+    for (uint32_t line = 0; line < LOG_RATE_LIMIT_SLOTS + 1U; ++line)
+    {
+        EXPECT_EQ(UINT32_C(2), LogTimes(3 + line, LOG_LEVEL_WARNING, FileA, line));
+        xTaskGetTickCount_fake.return_val += 10;
+    }
+
+    ASSERT_TRUE(LogRateLimit_TakeSuppressed(&report));
+    EXPECT_EQ(FileA, report.File);
+    EXPECT_EQ(UINT32_C(0), report.Line);
+    EXPECT_EQ(UINT32_C(1), report.Suppressed);
+    EXPECT_EQ(NULL, LogRateLimitEvicted[0].File);
+    EXPECT_FALSE(LogRateLimit_TakeSuppressed(&report));
+    EXPECT_EQ((uint32_t)LOG_RATE_LIMIT_SLOTS, LogRateLimitPending);
+}
+
+TEST_F(LogRateLimit, Apply_EvictedFull)
+{
+    LogRateLimitReport_T report;
+
+    /* Replaced call sites whose counts are not taken */
+    for (uint32_t line = 0; line < LOG_RATE_LIMIT_SLOTS + LOG_RATE_LIMIT_EVICTED; ++line)
+    {
+        EXPECT_EQ(UINT32_C(2), LogTimes(3, LOG_LEVEL_WARNING, FileA, line));
+        xTaskGetTickCount_fake.return_val += 10;
+    }
+
+    /* Rather than losing a count, a further call site is not limited */
+    EXPECT_EQ(UINT32_C(5), LogTimes(5, LOG_LEVEL_WARNING, FileB, 10));
+
+    for (uint32_t line = 0; line < LOG_RATE_LIMIT_EVICTED; ++line)
+    {
+        ASSERT_TRUE(LogRateLimit_TakeSuppressed(&report));
+        EXPECT_EQ(line, report.Line);
+        EXPECT_EQ(UINT32_C(1), report.Suppressed);
+    }
+    EXPECT_FALSE(LogRateLimit_TakeSuppressed(&report));
+    EXPECT_EQ(UINT32_C(2), LogTimes(5, LOG_LEVEL_WARNING, FileB, 10));
+}
+
+TEST_F(LogRateLimit, Apply_FromIsr)
+{
+    uint32_t suppressed = 0;
+    HAL_IsInISR_fake.return_val = true;
+    xTaskGetTickCountFromISR_fake.return_val = 7000;
+
+    EXPECT_TRUE(LogRateLimit_Apply(LOG_LEVEL_WARNING, Package, Module, FileA, 10, &suppressed));
+
+    EXPECT_EQ(UINT32_C(1), xTaskGetTickCountFromISR_fake.call_count);
+    EXPECT_EQ(UINT32_C(0), xTaskGetTickCount_fake.call_count);
+}
+
+TEST_F(LogRateLimit, Apply_TickOverflow)
+{
+    uint32_t suppressed = 0;
+    xTaskGetTickCount_fake.return_val = (TickType_t)(0 - 500);
+
+    EXPECT_EQ(UINT32_C(2), LogTimes(4, LOG_LEVEL_WARNING, FileA, 10));
+
+    xTaskGetTickCount_fake.return_val = 500;
+    EXPECT_TRUE(LogRateLimit_Apply(LOG_LEVEL_WARNING, Package, Module, FileA, 10, &suppressed));
+    EXPECT_EQ(UINT32_C(2), suppressed);
+}
+
+#else
+}
+#endif /* if KISO_FEATURE_LOGGING */
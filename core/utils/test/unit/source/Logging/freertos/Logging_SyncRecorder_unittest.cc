@@ -26,6 +26,8 @@
 /* Include gtest interface */
 #include <gtest.h>
 
+#include <string>
+
 /* Start of global scope symbol and fake definitions section */
 extern "C"
 {
@@ -356,6 +358,33 @@ TEST_F(Logging_SyncRecorder, Logging_SyncRecorderWrite_AppenderFail)
     EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INCONSITENT_STATE), retcode);
 }
 
+static LogLevel_T AppendFakeReceivedLevel = LOG_LEVEL_NONE;
+static std::string AppendFakeReceivedMessage;
+
+static Retcode_T LogRecorderAppendFake(void *self, LogLevel_T level, const char *message, uint32_t length)
+{
+    KISO_UNUSED(self);
+    AppendFakeReceivedLevel = level;
+    AppendFakeReceivedMessage.assign(message, length);
+    return RETCODE_OK;
+}
+
+TEST_F(Logging_SyncRecorder, Logging_SyncRecorderWrite_Append)
+{
+    Retcode_T retcode = RETCODE_OK;
+    LogRecorder_T recorder = LogRecordSyncCompactTestInstance;
+    recorder.Append = LogRecorderAppendFake;
+
+    SetCustomerSnprintf = false;
+    xTaskGetTickCount_fake.return_val = 10;
+
+    retcode = callWrite(&recorder, LOG_LEVEL_WARNING, 1, 2, "log.txt", 32, "string %s", "warning");
+
+    EXPECT_EQ(RETCODE_OK, retcode);
+    EXPECT_EQ(LOG_LEVEL_WARNING, AppendFakeReceivedLevel);
+    EXPECT_STREQ("10 W 1 (null)\t[log.txt:32]\tstring warning\r\n", AppendFakeReceivedMessage.c_str());
+}
+
 #else
 }
 #endif /* if KISO_SYNC_RECORDER */
@@ -0,0 +1,361 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ *
+ * @brief
+ *      Module test specification for the Logging_UartDmaAppender_unittest.cc module.
+ *
+ * @detail
+ *      The unit test file template follows the Four-Phase test pattern.
+ *
+ * @file
+ **/
+
+/* Include gtest interface */
+#include <gtest.h>
+
+#include <string>
+#include <vector>
+
+/* Start of global scope symbol and fake definitions section */
+extern "C"
+{
+/* Module includes */
+#include "Kiso_Utils.h"
+#undef KISO_MODULE_ID
+#define KISO_MODULE_ID KISO_UTILS_MODULE_ID_LOGGING_APPENDER_UART_DMA
+
+/* Check if the logging feature is activated */
+#if KISO_FEATURE_LOGGING
+#include "LogConfig.h"
+
+/* The appender is tested regardless of the configuration, with small buffers to see them fill up */
+#undef KISO_UART_DMA_APPENDER
+#define KISO_UART_DMA_APPENDER 1
+#undef LOG_UART_DMA_BUFFER_SIZE
+#define LOG_UART_DMA_BUFFER_SIZE (UINT16_C(16))
+
+#include "Kiso_Basics.h"
+#include "Kiso_Retcode_th.hh"
+#include "Kiso_Assert_th.hh"
+#include "Kiso_MCU_UART_th.hh"
+#include "Kiso_BSP_TestInterface_th.hh"
+#include "Kiso_UARTTransceiver_th.hh"
+#include "FreeRTOS_th.hh"
+#include "semphr_th.hh"
+#include "timers_th.hh"
+#include "portmacro_th.hh"
+
+#include "Logging_UartDmaAppender.c"
+    /* End of global scope symbol and fake definitions section */
+}
+
+#define FAKE_LOCK ((SemaphoreHandle_t)1)
+#define FAKE_TX_DONE ((SemaphoreHandle_t)2)
+#define FAKE_TIMER ((TimerHandle_t)3)
+
+/* Transfers started by the appender */
+static std::vector<std::string> SentBatches;
+
+/* Whether each semaphore can be taken */
+static bool IsLockFree;
+static bool IsTxDone;
+
+static Retcode_T WriteDataFake(UARTTransceiver_T *transceiver, const uint8_t *data, uint32_t length, uint32_t timeout)
+{
+    KISO_UNUSED(transceiver);
+    KISO_UNUSED(timeout);
+    SentBatches.push_back(std::string((const char *)data, length));
+    return UARTTransceiver_WriteData_fake.return_val;
+}
+
+static BaseType_t SemaphoreTakeFake(SemaphoreHandle_t semaphore, TickType_t timeout)
+{
+    KISO_UNUSED(timeout);
+    bool *isFree = (FAKE_LOCK == semaphore) ? &IsLockFree : &IsTxDone;
+    if (!*isFree)
+    {
+        return pdFALSE;
+    }
+    *isFree = false;
+    return pdTRUE;
+}
+
+static BaseType_t SemaphoreGiveFake(SemaphoreHandle_t semaphore)
+{
+    bool *isFree = (FAKE_LOCK == semaphore) ? &IsLockFree : &IsTxDone;
+    *isFree = true;
+    return pdTRUE;
+}
+
+static BaseType_t SemaphoreGiveFromISRFake(SemaphoreHandle_t semaphore, BaseType_t *higherPriorityTaskWoken)
+{
+    KISO_UNUSED(higherPriorityTaskWoken);
+    return SemaphoreGiveFake(semaphore);
+}
+
+/* The tests */
+class Logging_UartDmaAppenderTest : public testing::Test
+{
+protected:
+    virtual void SetUp()
+    {
+        FFF_RESET_HISTORY()
+        RESET_FAKE(UARTTransceiver_Initialize);
+        RESET_FAKE(UARTTransceiver_StartInAsyncMode);
+        RESET_FAKE(BSP_TestInterface_Connect);
+        RESET_FAKE(BSP_TestInterface_Enable);
+        RESET_FAKE(MCU_UART_Initialize);
+        RESET_FAKE(UARTTransceiver_WriteData);
+        RESET_FAKE(UARTTransceiver_LoopCallback);
+        RESET_FAKE(xSemaphoreCreateMutex);
+        RESET_FAKE(xSemaphoreCreateBinary);
+        RESET_FAKE(xSemaphoreTake);
+        RESET_FAKE(xSemaphoreGive);
+        RESET_FAKE(xSemaphoreGiveFromISR);
+        RESET_FAKE(xTimerCreate);
+        RESET_FAKE(xTimerStart);
+        RESET_FAKE(xTimerReset);
+
+        UartDmaLock = NULL;
+        UartDmaTxDone = NULL;
+        UartDmaFlushTimer = NULL;
+        UartDmaFillIndex = 0;
+        UartDmaFillLength = 0;
+        UartDmaIsFlushPending = false;
+
+        SentBatches.clear();
+        IsLockFree = true;
+        IsTxDone = false;
+
+        xSemaphoreCreateMutex_fake.return_val = FAKE_LOCK;
+        xSemaphoreCreateBinary_fake.return_val = FAKE_TX_DONE;
+        xTimerCreate_fake.return_val = FAKE_TIMER;
+        xTimerStart_fake.return_val = pdPASS;
+        xSemaphoreTake_fake.custom_fake = SemaphoreTakeFake;
+        xSemaphoreGive_fake.custom_fake = SemaphoreGiveFake;
+        xSemaphoreGiveFromISR_fake.custom_fake = SemaphoreGiveFromISRFake;
+        UARTTransceiver_WriteData_fake.custom_fake = WriteDataFake;
+    }
+
+    /* TearDown() is invoked immediately after a test finishes. */
+    virtual void TearDown()
+    {
+        ; /* Nothing to do if clean up is not required */
+    }
+
+    void CompleteTransfer(void)
+    {
+        struct MCU_UART_Event_S event = {};
+        event.TxComplete = 1;
+        UartDmaTransceiverCallback(event);
+    }
+};
+
+TEST_F(Logging_UartDmaAppenderTest, Logging_UartDmaAppenderInitialization_Success)
+{
+    Retcode_T retcode = RETCODE_OK;
+
+    retcode = UartDmaAppender.Init(NULL);
+
+    EXPECT_EQ(RETCODE_OK, retcode);
+    EXPECT_EQ(UINT32_C(1), UARTTransceiver_StartInAsyncMode_fake.call_count);
+    EXPECT_EQ(UartDmaTransceiverCallback, UARTTransceiver_StartInAsyncMode_fake.arg2_val);
+    EXPECT_TRUE(IsTxDone);
+}
+
+TEST_F(Logging_UartDmaAppenderTest, Logging_UartDmaAppenderInitialization_OutOfResources)
+{
+    Retcode_T retcode = RETCODE_OK;
+    xTimerCreate_fake.return_val = NULL;
+
+    retcode = UartDmaAppender.Init(NULL);
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_OUT_OF_RESOURCES), retcode);
+    EXPECT_EQ(UINT32_C(0), BSP_TestInterface_Connect_fake.call_count);
+}
+
+TEST_F(Logging_UartDmaAppenderTest, Logging_UartDmaAppenderInitialization_UARTTransceiverStartFail)
+{
+    Retcode_T retcode = RETCODE_OK;
+    UARTTransceiver_StartInAsyncMode_fake.return_val = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INCONSITENT_STATE);
+
+    retcode = UartDmaAppender.Init(NULL);
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INCONSITENT_STATE), retcode);
+}
+
+TEST_F(Logging_UartDmaAppenderTest, Logging_UartDmaAppenderInitialization_MCUUARTInitializeFail)
+{
+    Retcode_T retcode = RETCODE_OK;
+    MCU_UART_Initialize_fake.return_val = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INCONSITENT_STATE);
+
+    retcode = UartDmaAppender.Init(NULL);
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INCONSITENT_STATE), retcode);
+    EXPECT_EQ(UINT32_C(0), UARTTransceiver_Initialize_fake.call_count);
+}
+
+TEST_F(Logging_UartDmaAppenderTest, Logging_UartDmaAppenderWrite_Batches)
+{
+    ASSERT_EQ(RETCODE_OK, UartDmaAppender.Init(NULL));
+
+    EXPECT_EQ(RETCODE_OK, UartDmaAppender.Write("line1\n", 6));
+    EXPECT_EQ(RETCODE_OK, UartDmaAppender.Write("line2\n", 6));
+
+    /* Nothing is sent before the buffer is full or the timer expires */
+    EXPECT_EQ(UINT32_C(0), UARTTransceiver_WriteData_fake.call_count);
+    EXPECT_EQ(UINT32_C(1), xTimerStart_fake.call_count);
+    EXPECT_TRUE(IsLockFree);
+}
+
+TEST_F(Logging_UartDmaAppenderTest, Logging_UartDmaAppenderWrite_SendsFullBuffer)
+{
+    ASSERT_EQ(RETCODE_OK, UartDmaAppender.Init(NULL));
+
+    EXPECT_EQ(RETCODE_OK, UartDmaAppender.Write("0123456789", 10));
+    EXPECT_EQ(RETCODE_OK, UartDmaAppender.Write("abcdefghij", 10));
+
+    ASSERT_EQ(1U, SentBatches.size());
+    EXPECT_EQ(std::string("0123456789abcdef"), SentBatches[0]);
+    EXPECT_EQ(UINT32_C(1), UartDmaFillIndex);
+    EXPECT_EQ(UINT32_C(4), UartDmaFillLength);
+    EXPECT_FALSE(IsTxDone);
+
+    /* The rest of the line is in the other buffer, waiting for its timer */
+    EXPECT_EQ(UINT32_C(2), xTimerStart_fake.call_count);
+}
+
+TEST_F(Logging_UartDmaAppenderTest, Logging_UartDmaAppenderWrite_AlternatesBuffers)
+{
+    ASSERT_EQ(RETCODE_OK, UartDmaAppender.Init(NULL));
+
+    EXPECT_EQ(RETCODE_OK, UartDmaAppender.Write("0123456789abcdef", 16));
+    CompleteTransfer();
+    EXPECT_EQ(RETCODE_OK, UartDmaAppender.Write("ghijklmnopqrstuv", 16));
+
+    ASSERT_EQ(2U, SentBatches.size());
+    EXPECT_EQ(std::string("0123456789abcdef"), SentBatches[0]);
+    EXPECT_EQ(std::string("ghijklmnopqrstuv"), SentBatches[1]);
+    EXPECT_EQ(UINT32_C(0), UartDmaFillIndex);
+}
+
+TEST_F(Logging_UartDmaAppenderTest, Logging_UartDmaAppenderWrite_TransferNotComplete)
+{
+    ASSERT_EQ(RETCODE_OK, UartDmaAppender.Init(NULL));
+
+    EXPECT_EQ(RETCODE_OK, UartDmaAppender.Write("0123456789abcdef", 16));
+
+    /* Both buffers are full */
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_TIMEOUT), UartDmaAppender.Write("ghijklmnopqrstuv", 16));
+    EXPECT_EQ(1U, SentBatches.size());
+    EXPECT_TRUE(IsLockFree);
+}
+
+TEST_F(Logging_UartDmaAppenderTest, Logging_UartDmaAppenderWrite_SendFail)
+{
+    ASSERT_EQ(RETCODE_OK, UartDmaAppender.Init(NULL));
+    UARTTransceiver_WriteData_fake.return_val = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INCONSITENT_STATE);
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INCONSITENT_STATE), UartDmaAppender.Write("0123456789abcdef", 16));
+
+    /* No transfer is running */
+    EXPECT_TRUE(IsTxDone);
+}
+
+TEST_F(Logging_UartDmaAppenderTest, Logging_UartDmaAppenderWrite_NullPointer)
+{
+    ASSERT_EQ(RETCODE_OK, UartDmaAppender.Init(NULL));
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), UartDmaAppender.Write(NULL, 0));
+}
+
+TEST_F(Logging_UartDmaAppenderTest, Logging_UartDmaAppenderWrite_LockFail)
+{
+    ASSERT_EQ(RETCODE_OK, UartDmaAppender.Init(NULL));
+    IsLockFree = false;
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SEMAPHORE_ERROR), UartDmaAppender.Write("line\n", 5));
+    EXPECT_EQ(UINT32_C(0), UartDmaFillLength);
+}
+
+TEST_F(Logging_UartDmaAppenderTest, UartDmaFlushTimeout_SendsPartialBuffer)
+{
+    ASSERT_EQ(RETCODE_OK, UartDmaAppender.Init(NULL));
+    EXPECT_EQ(RETCODE_OK, UartDmaAppender.Write("line\n", 5));
+
+    UartDmaFlushTimeout(FAKE_TIMER);
+
+    ASSERT_EQ(1U, SentBatches.size());
+    EXPECT_EQ(std::string("line\n"), SentBatches[0]);
+    EXPECT_FALSE(UartDmaIsFlushPending);
+    EXPECT_EQ(UINT32_C(0), xTimerReset_fake.call_count);
+
+    /* The next line starts a new batch */
+    EXPECT_EQ(RETCODE_OK, UartDmaAppender.Write("line\n", 5));
+    EXPECT_EQ(UINT32_C(2), xTimerStart_fake.call_count);
+}
+
+TEST_F(Logging_UartDmaAppenderTest, UartDmaFlushTimeout_Busy)
+{
+    ASSERT_EQ(RETCODE_OK, UartDmaAppender.Init(NULL));
+    EXPECT_EQ(RETCODE_OK, UartDmaAppender.Write("0123456789abcdef", 16));
+    EXPECT_EQ(RETCODE_OK, UartDmaAppender.Write("line\n", 5));
+
+    /* The first buffer is still in transfer */
+    UartDmaFlushTimeout(FAKE_TIMER);
+    EXPECT_EQ(1U, SentBatches.size());
+    EXPECT_EQ(UINT32_C(1), xTimerReset_fake.call_count);
+
+    /* A writer holds the lock */
+    CompleteTransfer();
+    IsLockFree = false;
+    UartDmaFlushTimeout(FAKE_TIMER);
+    EXPECT_EQ(1U, SentBatches.size());
+    EXPECT_EQ(UINT32_C(2), xTimerReset_fake.call_count);
+
+    IsLockFree = true;
+    UartDmaFlushTimeout(FAKE_TIMER);
+    ASSERT_EQ(2U, SentBatches.size());
+    EXPECT_EQ(std::string("line\n"), SentBatches[1]);
+}
+
+TEST_F(Logging_UartDmaAppenderTest, UartDmaCallback_SuccessOrFailure)
+{
+    struct MCU_UART_Event_S event = {};
+
+    UartDmaCallback(NULL, event); // Nothing really to test. There is a direct call to UARTTransceiver_LoopCallback.
+
+    EXPECT_EQ(UINT32_C(1), UARTTransceiver_LoopCallback_fake.call_count);
+}
+
+TEST_F(Logging_UartDmaAppenderTest, UartDmaTransceiverCallback_OnlyTxComplete)
+{
+    struct MCU_UART_Event_S event = {};
+    event.RxError = 1;
+
+    UartDmaTransceiverCallback(event);
+
+    EXPECT_EQ(UINT32_C(0), xSemaphoreGiveFromISR_fake.call_count);
+}
+
+TEST_F(Logging_UartDmaAppenderTest, UartDmaCheckEndFrameFunc_CheckFalse)
+{
+    EXPECT_FALSE(UartDmaCheckEndFrameFunc(0));
+}
+
+#else
+}
+#endif /* if KISO_FEATURE_LOGGING */
@@ -0,0 +1,200 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ *
+ * @brief
+ *      Module test specification for the RingBuffer module with KISO_RINGBUFFER_POWER_OF_TWO enabled.
+ *
+ * @details
+ *      The unit test file template follows the Four-Phase test pattern.
+ *
+ * @file
+ **/
+
+/* Setup testing framework ************************************************** */
+
+/* Include gtest interface */
+#include <gtest.h>
+
+#include <string.h>
+
+/* Start of global scope symbol and fake definitions section */
+extern "C"
+{
+/* Setup compile time configuration defines */
+#define KISO_RINGBUFFER_POWER_OF_TWO 1
+
+#include "Kiso_Utils.h"
+#undef KISO_MODULE_ID
+#define KISO_MODULE_ID KISO_UTILS_MODULE_ID_RINGBUFFER
+
+#if KISO_FEATURE_RINGBUFFER
+
+/* Include faked interfaces */
+#include "Kiso_Assert_th.hh"
+#include "Kiso_Retcode_th.hh"
+
+/* Include module under test */
+#define inline
+#include "RingBuffer.c"
+#undef inline
+
+    /* End of global scope symbol and fake definitions section */
+}
+
+Retcode_T RunTimeError = RETCODE_OK;
+static void Retcode_CustomRaiseError(Retcode_T error)
+{
+    RunTimeError = error;
+}
+
+/* Create test fixture initializing all variables automatically */
+
+#define TEST_BUFFER_SIZE (16U)
+
+class RingBufferPowerOfTwo : public testing::Test
+{
+public:
+    RingBuffer_T ringBuffer;
+    uint8_t localBuffer[TEST_BUFFER_SIZE];
+
+protected:
+    /* Remember that SetUp() is run immediately before a test starts. */
+    virtual void SetUp()
+    {
+        FFF_RESET_HISTORY();
+        RESET_FAKE(Retcode_RaiseError);
+        Retcode_RaiseError_fake.custom_fake = Retcode_CustomRaiseError;
+        RunTimeError = RETCODE_OK;
+        memset(&ringBuffer, 0, sizeof(RingBuffer_T));
+    }
+
+    /* TearDown() is invoked immediately after a test finishes. */
+    virtual void TearDown()
+    {
+        ; /* Nothing to do if clean up is not required */
+    }
+};
+
+/* Specify test cases ******************************************************* */
+
+TEST_F(RingBufferPowerOfTwo, BufferInit)
+{
+    RingBuffer_Initialize(&ringBuffer, localBuffer, sizeof(localBuffer));
+
+    EXPECT_EQ(0U, Retcode_RaiseError_fake.call_count);
+    EXPECT_EQ(localBuffer, ringBuffer.Base);
+    EXPECT_EQ(sizeof(localBuffer), ringBuffer.Size);
+}
+
+TEST_F(RingBufferPowerOfTwo, BufferInitRejectsOtherSizes)
+{
+    /* Masking with Size - 1 is only correct for powers of two */
+    for (uint32_t size : {3U, 12U, TEST_BUFFER_SIZE - 1U})
+    {
+        RESET_FAKE(Retcode_RaiseError);
+        Retcode_RaiseError_fake.custom_fake = Retcode_CustomRaiseError;
+        RunTimeError = RETCODE_OK;
+
+        RingBuffer_Initialize(&ringBuffer, localBuffer, size);
+
+        EXPECT_EQ(1U, Retcode_RaiseError_fake.call_count);
+        EXPECT_EQ(RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_INVALID_PARAM), RunTimeError);
+        EXPECT_EQ(NULL, ringBuffer.Base);
+        EXPECT_EQ(0U, ringBuffer.Size);
+    }
+}
+
+TEST_F(RingBufferPowerOfTwo, BufferWrapAroundPreservesOrder)
+{
+    /* Odd block size, so that every position of the indices relative to the wrap is hit */
+    uint8_t writeData[TEST_BUFFER_SIZE / 2 + 1];
+    uint8_t readData[sizeof(writeData)];
+    uint8_t pattern = 0;
+
+    RingBuffer_Initialize(&ringBuffer, localBuffer, sizeof(localBuffer));
+
+    for (unsigned int i = 0; i < 3 * TEST_BUFFER_SIZE; ++i)
+    {
+        for (unsigned int j = 0; j < sizeof(writeData); ++j)
+        {
+            writeData[j] = pattern++;
+        }
+        memset(readData, 0, sizeof(readData));
+
+        EXPECT_EQ(sizeof(writeData), RingBuffer_Write(&ringBuffer, writeData, sizeof(writeData)));
+        EXPECT_GT(ringBuffer.Size, ringBuffer.WriteIndex);
+
+        EXPECT_EQ(sizeof(writeData), RingBuffer_Read(&ringBuffer, readData, sizeof(readData)));
+        EXPECT_GT(ringBuffer.Size, ringBuffer.ReadIndex);
+
+        EXPECT_TRUE(memcmp(writeData, readData, sizeof(readData)) == 0);
+    }
+}
+
+TEST_F(RingBufferPowerOfTwo, BufferFillLevelAcrossWrap)
+{
+    uint8_t writeData[TEST_BUFFER_SIZE - 1];
+    uint8_t readData[TEST_BUFFER_SIZE - 1];
+    RingBuffer_Region_T regions[RINGBUFFER_REGION_COUNT];
+
+    RingBuffer_Initialize(&ringBuffer, localBuffer, sizeof(localBuffer));
+    for (unsigned int j = 0; j < sizeof(writeData); ++j)
+    {
+        writeData[j] = (uint8_t)j;
+    }
+
+    /* Move both indices close to the end of the buffer space */
+    EXPECT_EQ(TEST_BUFFER_SIZE - 3, RingBuffer_Write(&ringBuffer, writeData, TEST_BUFFER_SIZE - 3));
+    EXPECT_EQ(TEST_BUFFER_SIZE - 3, RingBuffer_Read(&ringBuffer, readData, TEST_BUFFER_SIZE - 3));
+
+    /* Fill completely, the write index ends up below the read index */
+    EXPECT_EQ(sizeof(writeData), RingBuffer_Write(&ringBuffer, writeData, sizeof(writeData)));
+    EXPECT_LT(ringBuffer.WriteIndex, ringBuffer.ReadIndex);
+    EXPECT_EQ(0U, RingBuffer_Write(&ringBuffer, writeData, 1U));
+
+    EXPECT_EQ(sizeof(writeData), RingBuffer_Peek(&ringBuffer, regions));
+    EXPECT_EQ(3U, regions[0].Length);
+    EXPECT_EQ(sizeof(writeData) - 3U, regions[1].Length);
+
+    EXPECT_EQ(sizeof(readData), RingBuffer_Read(&ringBuffer, readData, sizeof(readData)));
+    EXPECT_TRUE(memcmp(writeData, readData, sizeof(readData)) == 0);
+    EXPECT_EQ(ringBuffer.ReadIndex, ringBuffer.WriteIndex);
+}
+
+TEST_F(RingBufferPowerOfTwo, RecordOverwriteAcrossWrap)
+{
+    uint8_t record[5];
+    uint8_t readData[sizeof(record)];
+
+    RingBuffer_InitializeRecords(&ringBuffer, localBuffer, sizeof(localBuffer), true);
+
+    /* Records of 7 bytes including the length prefix keep wrapping and overwriting the oldest one */
+    for (uint8_t i = 0; i < 10U; i++)
+    {
+        memset(record, i, sizeof(record));
+        EXPECT_TRUE(RingBuffer_WriteRecord(&ringBuffer, record, sizeof(record)));
+    }
+
+    EXPECT_EQ(sizeof(record), RingBuffer_ReadRecord(&ringBuffer, readData, sizeof(readData)));
+    EXPECT_EQ(8U, readData[0]);
+    EXPECT_EQ(sizeof(record), RingBuffer_ReadRecord(&ringBuffer, readData, sizeof(readData)));
+    EXPECT_EQ(9U, readData[4]);
+    EXPECT_EQ(0U, RingBuffer_ReadRecord(&ringBuffer, readData, sizeof(readData)));
+}
+
+#else
+}
+#endif /* if KISO_FEATURE_RINGBUFFER */
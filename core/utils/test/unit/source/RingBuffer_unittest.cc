@@ -45,9 +45,29 @@ extern "C"
 #include "Kiso_Assert_th.hh"
 #include "Kiso_Retcode_th.hh"
 
+/*
+ * Lets a test act as the producer in the middle of a read: the hook runs once, right after the
+ * next segment has been copied, as an ISR writing to the buffer at that point would.
+ */
+static void (*MemcpyHook)(void) = NULL;
+static void *RingBuffer_TestMemcpy(void *destination, const void *source, size_t length)
+{
+    void (*hook)(void) = MemcpyHook;
+    void *result = memcpy(destination, source, length);
+
+    MemcpyHook = NULL;
+    if (NULL != hook)
+    {
+        hook();
+    }
+    return result;
+}
+
 /* Include module under test */
 #define inline
+#define memcpy RingBuffer_TestMemcpy
 #include "RingBuffer.c"
+#undef memcpy
 #undef inline
 
     /* End of global scope symbol and fake definitions section */
@@ -344,6 +364,346 @@ TEST_F(UartRingBuffer_InitTest, BufferMultipleReadWriteNonSame)
     }
 }
 
+TEST_F(UartRingBuffer_InitTest, BufferWrapAroundPreservesOrder)
+{
+    uint8_t writeData[TEST_LOW_BUFFER_SIZE / 2 + 1];
+    uint8_t readData[sizeof(writeData)];
+    uint8_t pattern = 0;
+    uint32_t written = 0;
+    uint32_t nRead = 0;
+
+    RingBuffer_Initialize(&ringBuffer, localBuffer, sizeof(localBuffer));
+
+    for (unsigned int i = 0; i < 3 * TEST_LOW_BUFFER_SIZE; ++i)
+    {
+        for (unsigned int j = 0; j < sizeof(writeData); ++j)
+        {
+            writeData[j] = pattern++;
+        }
+        memset(readData, 0, sizeof(readData));
+
+        written = RingBuffer_Write(&ringBuffer, writeData, sizeof(writeData));
+        EXPECT_EQ(sizeof(writeData), written);
+        EXPECT_GT(ringBuffer.Size, ringBuffer.WriteIndex);
+
+        nRead = RingBuffer_Read(&ringBuffer, readData, sizeof(readData));
+        EXPECT_EQ(written, nRead);
+        EXPECT_GT(ringBuffer.Size, ringBuffer.ReadIndex);
+
+        EXPECT_TRUE(memcmp(writeData, readData, nRead) == 0);
+    }
+}
+
+TEST_F(UartRingBuffer_InitTest, BufferPartialReadAcrossWrap)
+{
+    uint8_t writeData[TEST_LOW_BUFFER_SIZE - 1];
+    uint8_t readData[TEST_LOW_BUFFER_SIZE - 1];
+    uint32_t written = 0;
+    uint32_t nRead = 0;
+
+    RingBuffer_Initialize(&ringBuffer, localBuffer, sizeof(localBuffer));
+    for (unsigned int j = 0; j < sizeof(writeData); ++j)
+    {
+        writeData[j] = (uint8_t)j;
+    }
+
+    /* Move both indices close to the end of the buffer space */
+    written = RingBuffer_Write(&ringBuffer, writeData, TEST_LOW_BUFFER_SIZE - 3);
+    EXPECT_EQ(TEST_LOW_BUFFER_SIZE - 3, written);
+    nRead = RingBuffer_Read(&ringBuffer, readData, TEST_LOW_BUFFER_SIZE - 3);
+    EXPECT_EQ(written, nRead);
+
+    /* Fill completely, which wraps the write index */
+    written = RingBuffer_Write(&ringBuffer, writeData, sizeof(writeData));
+    EXPECT_EQ(sizeof(writeData), written);
+    EXPECT_EQ(0U, RingBuffer_Write(&ringBuffer, writeData, 1U));
+
+    /* Read back in two uneven steps, the first one ending after the wrap */
+    nRead = RingBuffer_Read(&ringBuffer, readData, 5U);
+    EXPECT_EQ(5U, nRead);
+    nRead += RingBuffer_Read(&ringBuffer, &readData[nRead], sizeof(readData));
+    EXPECT_EQ(sizeof(writeData), nRead);
+    EXPECT_TRUE(memcmp(writeData, readData, sizeof(writeData)) == 0);
+    EXPECT_EQ(ringBuffer.ReadIndex, ringBuffer.WriteIndex);
+}
+
+TEST_F(UartRingBuffer_InitTest, BufferReserveCommitOnEmpty)
+{
+    RingBuffer_Region_T regions[RINGBUFFER_REGION_COUNT];
+    uint8_t readData[TEST_LOW_BUFFER_SIZE - 1];
+    uint32_t reserved = 0;
+
+    RingBuffer_Initialize(&ringBuffer, localBuffer, sizeof(localBuffer));
+
+    reserved = RingBuffer_Reserve(&ringBuffer, regions);
+    EXPECT_EQ(ringBuffer.Size - 1, reserved);
+    EXPECT_EQ(localBuffer, regions[0].Data);
+    EXPECT_EQ(reserved, regions[0].Length);
+    EXPECT_EQ(0U, regions[1].Length);
+
+    memset(regions[0].Data, 'x', 4U);
+    EXPECT_EQ(4U, RingBuffer_Commit(&ringBuffer, 4U));
+    EXPECT_EQ(4U, RingBuffer_Read(&ringBuffer, readData, sizeof(readData)));
+    EXPECT_EQ('x', readData[0]);
+    EXPECT_EQ('x', readData[3]);
+}
+
+TEST_F(UartRingBuffer_InitTest, BufferReserveAcrossWrap)
+{
+    RingBuffer_Region_T regions[RINGBUFFER_REGION_COUNT];
+    uint8_t dummyData[TEST_LOW_BUFFER_SIZE - 5];
+    uint8_t readData[TEST_LOW_BUFFER_SIZE - 1];
+    uint32_t reserved = 0;
+
+    RingBuffer_Initialize(&ringBuffer, localBuffer, sizeof(localBuffer));
+    memset(dummyData, 'a', sizeof(dummyData));
+    EXPECT_EQ(sizeof(dummyData), RingBuffer_Write(&ringBuffer, dummyData, sizeof(dummyData)));
+    EXPECT_EQ(sizeof(dummyData), RingBuffer_Read(&ringBuffer, readData, sizeof(dummyData)));
+
+    reserved = RingBuffer_Reserve(&ringBuffer, regions);
+    EXPECT_EQ(ringBuffer.Size - 1, reserved);
+    EXPECT_EQ(&localBuffer[sizeof(dummyData)], regions[0].Data);
+    EXPECT_EQ(ringBuffer.Size - sizeof(dummyData), regions[0].Length);
+    EXPECT_EQ(localBuffer, regions[1].Data);
+    EXPECT_EQ(reserved - regions[0].Length, regions[1].Length);
+
+    memset(regions[0].Data, 'b', regions[0].Length);
+    memset(regions[1].Data, 'c', regions[1].Length);
+    EXPECT_EQ(reserved, RingBuffer_Commit(&ringBuffer, reserved));
+    EXPECT_EQ(0U, RingBuffer_Reserve(&ringBuffer, regions));
+    EXPECT_EQ(0U, RingBuffer_Commit(&ringBuffer, 1U));
+
+    EXPECT_EQ(reserved, RingBuffer_Read(&ringBuffer, readData, sizeof(readData)));
+    EXPECT_EQ('b', readData[0]);
+    EXPECT_EQ('b', readData[ringBuffer.Size - sizeof(dummyData) - 1]);
+    EXPECT_EQ('c', readData[ringBuffer.Size - sizeof(dummyData)]);
+    EXPECT_EQ('c', readData[reserved - 1]);
+}
+
+TEST_F(UartRingBuffer_InitTest, BufferPeekConsumeOnEmpty)
+{
+    RingBuffer_Region_T regions[RINGBUFFER_REGION_COUNT];
+
+    RingBuffer_Initialize(&ringBuffer, localBuffer, sizeof(localBuffer));
+
+    EXPECT_EQ(0U, RingBuffer_Peek(&ringBuffer, regions));
+    EXPECT_EQ(0U, regions[0].Length);
+    EXPECT_EQ(0U, regions[1].Length);
+    EXPECT_EQ(0U, RingBuffer_Consume(&ringBuffer, 1U));
+    EXPECT_EQ(0U, ringBuffer.ReadIndex);
+}
+
+TEST_F(UartRingBuffer_InitTest, BufferPeekConsumeAcrossWrap)
+{
+    RingBuffer_Region_T regions[RINGBUFFER_REGION_COUNT];
+    uint8_t writeData[TEST_LOW_BUFFER_SIZE - 1];
+    uint32_t peeked = 0;
+
+    RingBuffer_Initialize(&ringBuffer, localBuffer, sizeof(localBuffer));
+    for (unsigned int j = 0; j < sizeof(writeData); ++j)
+    {
+        writeData[j] = (uint8_t)j;
+    }
+    EXPECT_EQ(10U, RingBuffer_Write(&ringBuffer, writeData, 10U));
+    EXPECT_EQ(10U, RingBuffer_Consume(&ringBuffer, 10U));
+    EXPECT_EQ(sizeof(writeData), RingBuffer_Write(&ringBuffer, writeData, sizeof(writeData)));
+
+    peeked = RingBuffer_Peek(&ringBuffer, regions);
+    EXPECT_EQ(sizeof(writeData), peeked);
+    EXPECT_EQ(&localBuffer[10], regions[0].Data);
+    EXPECT_EQ(ringBuffer.Size - 10U, regions[0].Length);
+    EXPECT_EQ(localBuffer, regions[1].Data);
+    EXPECT_EQ(peeked - regions[0].Length, regions[1].Length);
+    EXPECT_TRUE(memcmp(writeData, regions[0].Data, regions[0].Length) == 0);
+    EXPECT_TRUE(memcmp(&writeData[regions[0].Length], regions[1].Data, regions[1].Length) == 0);
+
+    /* Peeking does not release anything */
+    EXPECT_EQ(0U, RingBuffer_Write(&ringBuffer, writeData, 1U));
+
+    EXPECT_EQ(peeked, RingBuffer_Consume(&ringBuffer, peeked + 1U));
+    EXPECT_EQ(0U, RingBuffer_Peek(&ringBuffer, regions));
+    EXPECT_EQ(ringBuffer.ReadIndex, ringBuffer.WriteIndex);
+}
+
+static RingBuffer_T *InterleavedRingBuffer = NULL;
+static uint8_t InterleavedData[] = {'x', 'y', 'z'};
+static uint32_t InterleavedWritten = 0;
+
+static void WriteInterleaved(void)
+{
+    InterleavedWritten = RingBuffer_Write(InterleavedRingBuffer, InterleavedData, sizeof(InterleavedData));
+}
+
+TEST_F(UartRingBuffer_InitTest, BufferWriteDuringWrappedRead)
+{
+    uint8_t writeData[TEST_LOW_BUFFER_SIZE - 3];
+    uint8_t readData[TEST_LOW_BUFFER_SIZE - 1];
+
+    RingBuffer_Initialize(&ringBuffer, localBuffer, sizeof(localBuffer));
+    for (unsigned int j = 0; j < sizeof(writeData); ++j)
+    {
+        writeData[j] = (uint8_t)j;
+    }
+    /* Place the content so that it wraps around the end of the buffer space */
+    EXPECT_EQ(10U, RingBuffer_Write(&ringBuffer, writeData, 10U));
+    EXPECT_EQ(10U, RingBuffer_Read(&ringBuffer, readData, 10U));
+    EXPECT_EQ(sizeof(writeData), RingBuffer_Write(&ringBuffer, writeData, sizeof(writeData)));
+
+    /* The producer writes between the two segments of the read; the space of the segment not yet
+     * copied is still owned by the consumer, so only the remaining free space may be used */
+    InterleavedRingBuffer = &ringBuffer;
+    InterleavedWritten = 0;
+    MemcpyHook = WriteInterleaved;
+    EXPECT_EQ(sizeof(writeData), RingBuffer_Read(&ringBuffer, readData, sizeof(readData)));
+    EXPECT_EQ(NULL, MemcpyHook);
+    EXPECT_EQ(TEST_LOW_BUFFER_SIZE - 1U - sizeof(writeData), InterleavedWritten);
+    EXPECT_TRUE(memcmp(writeData, readData, sizeof(writeData)) == 0);
+
+    /* The data published during the read is available afterwards, in order */
+    EXPECT_EQ(InterleavedWritten, RingBuffer_Read(&ringBuffer, readData, sizeof(readData)));
+    EXPECT_TRUE(memcmp(InterleavedData, readData, InterleavedWritten) == 0);
+    EXPECT_EQ(ringBuffer.ReadIndex, ringBuffer.WriteIndex);
+}
+
+TEST_F(UartRingBuffer_InitTest, RecordInitTooSmall)
+{
+    RingBuffer_InitializeRecords(&ringBuffer, localBuffer, RINGBUFFER_RECORD_HEADER_SIZE + 1U, false);
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_FATAL, RETCODE_INVALID_PARAM), RunTimeError);
+    EXPECT_EQ(1U, Retcode_RaiseError_fake.call_count);
+    RESET_FAKE(Retcode_RaiseError);
+}
+
+TEST_F(UartRingBuffer_InitTest, RecordWriteRead)
+{
+    uint8_t readData[TEST_LOW_BUFFER_SIZE];
+    uint8_t first[] = {1, 2, 3};
+    uint8_t second[] = {4, 5, 6, 7, 8};
+
+    RingBuffer_InitializeRecords(&ringBuffer, localBuffer, sizeof(localBuffer), false);
+    EXPECT_FALSE(ringBuffer.Overwrite);
+
+    EXPECT_TRUE(RingBuffer_WriteRecord(&ringBuffer, first, sizeof(first)));
+    EXPECT_TRUE(RingBuffer_WriteRecord(&ringBuffer, second, sizeof(second)));
+
+    EXPECT_EQ(sizeof(first), RingBuffer_ReadRecord(&ringBuffer, readData, sizeof(readData)));
+    EXPECT_TRUE(memcmp(first, readData, sizeof(first)) == 0);
+    EXPECT_EQ(sizeof(second), RingBuffer_ReadRecord(&ringBuffer, readData, sizeof(readData)));
+    EXPECT_TRUE(memcmp(second, readData, sizeof(second)) == 0);
+    EXPECT_EQ(0U, RingBuffer_ReadRecord(&ringBuffer, readData, sizeof(readData)));
+}
+
+TEST_F(UartRingBuffer_InitTest, RecordWriteInvalidLength)
+{
+    uint8_t data[TEST_LOW_BUFFER_SIZE];
+
+    RingBuffer_InitializeRecords(&ringBuffer, localBuffer, sizeof(localBuffer), false);
+
+    EXPECT_FALSE(RingBuffer_WriteRecord(&ringBuffer, data, 0U));
+    EXPECT_FALSE(RingBuffer_WriteRecord(&ringBuffer, data, TEST_LOW_BUFFER_SIZE - RINGBUFFER_RECORD_HEADER_SIZE));
+    EXPECT_TRUE(RingBuffer_WriteRecord(&ringBuffer, data, TEST_LOW_BUFFER_SIZE - RINGBUFFER_RECORD_HEADER_SIZE - 1U));
+}
+
+TEST_F(UartRingBuffer_InitTest, RecordWriteFullRejects)
+{
+    uint8_t readData[TEST_LOW_BUFFER_SIZE];
+    uint8_t data[5] = {'a', 'b', 'c', 'd', 'e'};
+
+    RingBuffer_InitializeRecords(&ringBuffer, localBuffer, sizeof(localBuffer), false);
+
+    EXPECT_TRUE(RingBuffer_WriteRecord(&ringBuffer, data, sizeof(data)));
+    EXPECT_TRUE(RingBuffer_WriteRecord(&ringBuffer, data, sizeof(data)));
+    EXPECT_FALSE(RingBuffer_WriteRecord(&ringBuffer, data, sizeof(data)));
+
+    EXPECT_EQ(sizeof(data), RingBuffer_ReadRecord(&ringBuffer, readData, sizeof(readData)));
+    EXPECT_EQ(sizeof(data), RingBuffer_ReadRecord(&ringBuffer, readData, sizeof(readData)));
+    EXPECT_EQ(0U, RingBuffer_ReadRecord(&ringBuffer, readData, sizeof(readData)));
+}
+
+TEST_F(UartRingBuffer_InitTest, RecordWriteFullOverwritesOldest)
+{
+    uint8_t readData[TEST_LOW_BUFFER_SIZE];
+    uint8_t first[5] = {'a', 'a', 'a', 'a', 'a'};
+    uint8_t second[5] = {'b', 'b', 'b', 'b', 'b'};
+    uint8_t third[5] = {'c', 'c', 'c', 'c', 'c'};
+
+    RingBuffer_InitializeRecords(&ringBuffer, localBuffer, sizeof(localBuffer), true);
+    EXPECT_TRUE(ringBuffer.Overwrite);
+
+    EXPECT_TRUE(RingBuffer_WriteRecord(&ringBuffer, first, sizeof(first)));
+    EXPECT_TRUE(RingBuffer_WriteRecord(&ringBuffer, second, sizeof(second)));
+    EXPECT_TRUE(RingBuffer_WriteRecord(&ringBuffer, third, sizeof(third)));
+
+    EXPECT_EQ(sizeof(second), RingBuffer_ReadRecord(&ringBuffer, readData, sizeof(readData)));
+    EXPECT_TRUE(memcmp(second, readData, sizeof(second)) == 0);
+    EXPECT_EQ(sizeof(third), RingBuffer_ReadRecord(&ringBuffer, readData, sizeof(readData)));
+    EXPECT_TRUE(memcmp(third, readData, sizeof(third)) == 0);
+    EXPECT_EQ(0U, RingBuffer_ReadRecord(&ringBuffer, readData, sizeof(readData)));
+}
+
+TEST_F(UartRingBuffer_InitTest, RecordReadTruncates)
+{
+    uint8_t readData[2];
+    uint8_t data[5] = {'a', 'b', 'c', 'd', 'e'};
+
+    RingBuffer_InitializeRecords(&ringBuffer, localBuffer, sizeof(localBuffer), false);
+
+    EXPECT_TRUE(RingBuffer_WriteRecord(&ringBuffer, data, sizeof(data)));
+    EXPECT_EQ(sizeof(data), RingBuffer_ReadRecord(&ringBuffer, readData, sizeof(readData)));
+    EXPECT_EQ('a', readData[0]);
+    EXPECT_EQ('b', readData[1]);
+    EXPECT_EQ(ringBuffer.ReadIndex, ringBuffer.WriteIndex);
+}
+
+TEST_F(UartRingBuffer_InitTest, RecordPeekConsumeAcrossWrap)
+{
+    RingBuffer_Region_T regions[RINGBUFFER_REGION_COUNT];
+    uint8_t data[7] = {0, 1, 2, 3, 4, 5, 6};
+
+    RingBuffer_InitializeRecords(&ringBuffer, localBuffer, sizeof(localBuffer), false);
+
+    EXPECT_EQ(0U, RingBuffer_PeekRecord(&ringBuffer, regions));
+    EXPECT_EQ(0U, regions[0].Length + regions[1].Length);
+    EXPECT_EQ(0U, RingBuffer_ConsumeRecord(&ringBuffer));
+
+    /* Move the indices so that the second record wraps around the end of the buffer space */
+    EXPECT_TRUE(RingBuffer_WriteRecord(&ringBuffer, data, sizeof(data)));
+    EXPECT_EQ(sizeof(data), RingBuffer_ConsumeRecord(&ringBuffer));
+    EXPECT_TRUE(RingBuffer_WriteRecord(&ringBuffer, data, sizeof(data)));
+
+    EXPECT_EQ(sizeof(data), RingBuffer_PeekRecord(&ringBuffer, regions));
+    EXPECT_EQ(sizeof(data), regions[0].Length + regions[1].Length);
+    EXPECT_NE(0U, regions[1].Length);
+    EXPECT_TRUE(memcmp(data, regions[0].Data, regions[0].Length) == 0);
+    EXPECT_TRUE(memcmp(&data[regions[0].Length], regions[1].Data, regions[1].Length) == 0);
+
+    EXPECT_EQ(sizeof(data), RingBuffer_ConsumeRecord(&ringBuffer));
+    EXPECT_EQ(0U, RingBuffer_PeekRecord(&ringBuffer, regions));
+}
+
+TEST_F(UartRingBuffer_InitTest, RecordOverwriteMany)
+{
+    uint8_t readData[TEST_LOW_BUFFER_SIZE];
+    uint8_t data[3];
+
+    RingBuffer_InitializeRecords(&ringBuffer, localBuffer, sizeof(localBuffer), true);
+
+    for (uint8_t i = 0; i < 20U; ++i)
+    {
+        memset(data, i, sizeof(data));
+        EXPECT_TRUE(RingBuffer_WriteRecord(&ringBuffer, data, (i % sizeof(data)) + 1U));
+    }
+
+    /* Only the newest records are left, oldest first */
+    EXPECT_EQ(3U, RingBuffer_ReadRecord(&ringBuffer, readData, sizeof(readData)));
+    EXPECT_EQ(17U, readData[0]);
+    EXPECT_EQ(1U, RingBuffer_ReadRecord(&ringBuffer, readData, sizeof(readData)));
+    EXPECT_EQ(18U, readData[0]);
+    EXPECT_EQ(2U, RingBuffer_ReadRecord(&ringBuffer, readData, sizeof(readData)));
+    EXPECT_EQ(19U, readData[0]);
+    EXPECT_EQ(0U, RingBuffer_ReadRecord(&ringBuffer, readData, sizeof(readData)));
+}
+
 TEST_F(UartRingBuffer_InitTest, RingBufferResetNullCheck)
 {
 
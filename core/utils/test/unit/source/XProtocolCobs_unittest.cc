@@ -0,0 +1,476 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ *
+ * @brief
+ *      Module test specification for the XProtocol.c module with COBS framing (KISO_XPROTOCOL_COBS).
+ *
+ * @details
+ *      The unit test file template follows the Four-Phase test pattern.
+ *
+ * @file
+ **/
+
+/* Include gtest interface */
+#include <gtest.h>
+
+/* Start of global scope symbol and fake definitions section */
+extern "C"
+{
+/* Module includes, with COBS framing selected before the configuration is read */
+#define KISO_XPROTOCOL_COBS 1
+#include "Kiso_Utils.h"
+#undef KISO_MODULE_ID
+#define KISO_MODULE_ID KISO_UTILS_MODULE_ID_XPROTOCOL
+
+#if KISO_FEATURE_XPROTOCOL
+
+/* Include faked interfaces */
+#include "Kiso_CRC_th.hh"
+
+/* Include module under test */
+#include "XProtocol.c"
+
+    /* End of global scope symbol and fake definitions section */
+}
+
+#define MAX_FRAME_SIZE 1000U  /**< MAX size of buffer */
+#define MAX_DATA_LENGTH 1000U /**< MAX size of payload */
+
+static uint16_t CrcChecksum;
+
+/* CRC_16_custom_fake function locally defined */
+static Retcode_T CRC_16_custom_fake(uint16_t poly, uint16_t *shifter,
+                                    const uint8_t *data_p, uint16_t len)
+{
+    KISO_UNUSED(poly);
+    KISO_UNUSED(data_p);
+    KISO_UNUSED(len);
+    *shifter = CrcChecksum;
+
+    return RETCODE_OK;
+}
+
+/* CRC_16 fake which depends on every byte and on the order of the bytes, but not on how they are split into calls */
+static Retcode_T CRC_16_sequence_fake(uint16_t poly, uint16_t *shifter,
+                                      const uint8_t *data_p, uint16_t len)
+{
+    KISO_UNUSED(poly);
+    for (uint16_t i = 0; i < len; i++)
+    {
+        *shifter = (uint16_t)(((*shifter << 1) | (*shifter >> 15)) ^ data_p[i]);
+    }
+
+    return RETCODE_OK;
+}
+
+/* Retcode function locally defined */
+Retcode_T Retcode_compose(uint32_t package,
+                          Retcode_Severity_T severity, uint32_t code)
+{
+    uint32_t p = (package & 0x000000FF) << 24;
+    uint32_t s = ((uint32_t)severity & 0x000000FF) << 16;
+    uint32_t c = (code & 0x0000FFFF);
+    Retcode_T retcode = (code == UINT32_C(0)) ? (Retcode_T)UINT32_C(0) : (Retcode_T)(p | s | c);
+
+    return (retcode);
+}
+
+/* Payload with zeros, long runs without zeros and bytes which would need escaping without COBS */
+static void FillPayload(uint8_t *data, uint32_t length, uint32_t seed)
+{
+    uint32_t state = seed * UINT32_C(2654435761) + UINT32_C(1);
+    for (uint32_t i = 0; i < length; i++)
+    {
+        state = state * UINT32_C(1103515245) + UINT32_C(12345);
+        data[i] = (uint8_t)(state >> 16);
+        if ((seed % 3U) == 0U && (state & 0x100U))
+        {
+            data[i] = 0x00;
+        }
+        else if ((seed % 3U) == 1U && 0x00 == data[i])
+        {
+            data[i] = 0xC0;
+        }
+    }
+}
+
+/* Frames passed to the callback of the streaming decoder */
+struct DecodedFrames
+{
+    uint32_t Count;
+    uint32_t Length;
+    uint8_t Payload[MAX_DATA_LENGTH];
+};
+
+static void DecoderCallback(const uint8_t *payload, uint32_t payloadLength, void *callbackParam)
+{
+    DecodedFrames *frames = (DecodedFrames *)callbackParam;
+    memcpy(&frames->Payload[frames->Length], payload, payloadLength);
+    frames->Length += payloadLength;
+    frames->Count++;
+}
+
+/* Create test fixture initializing all variables automatically */
+class XProtocolCobsRoutines : public testing::Test
+{
+protected:
+    /* Remember that SetUp() is run immediately before a test starts. */
+    virtual void SetUp()
+    {
+        RESET_FAKE(CRC_16);
+        CRC_16_fake.custom_fake = CRC_16_custom_fake;
+    }
+
+    /* TearDown() is invoked immediately after a test finishes. */
+    virtual void TearDown()
+    {
+        ; /* Nothing to do if clean up is not required */
+    }
+};
+
+/**
+ * Module test cases to test X-Protocol with COBS framing
+ */
+
+TEST_F(XProtocolCobsRoutines, testEncodeFrame)
+{
+    /** @testcase{XProtocolCobsRoutines::testEncodeFrame: }
+     * XProtocol_EncodeFrame API stuffs payload and trailing checksum and ends the frame with 0x00
+     */
+    uint8_t frame[MAX_FRAME_SIZE];
+    uint32_t framelen;
+
+    CrcChecksum = 0x1234;
+    const uint8_t data1[] = {0x11, 0x22, 0x00, 0x33};
+    const uint8_t frame1[] = {0x03, 0x11, 0x22, 0x04, 0x33, 0x12, 0x34, 0x00};
+    EXPECT_EQ(RETCODE_OK, XProtocol_EncodeFrame(data1, sizeof(data1), sizeof(frame), frame, &framelen));
+    ASSERT_EQ(sizeof(frame1), framelen);
+    EXPECT_EQ(0, memcmp(frame1, frame, framelen));
+
+    /* Special characters of the escaping framing are not touched */
+    const uint8_t data2[] = {0xC0, 0xC9, 0xDB};
+    const uint8_t frame2[] = {0x06, 0xC0, 0xC9, 0xDB, 0x12, 0x34, 0x00};
+    EXPECT_EQ(RETCODE_OK, XProtocol_EncodeFrame(data2, sizeof(data2), sizeof(frame), frame, &framelen));
+    ASSERT_EQ(sizeof(frame2), framelen);
+    EXPECT_EQ(0, memcmp(frame2, frame, framelen));
+
+    /* Zeros in the checksum are stuffed as well */
+    CrcChecksum = 0x0000;
+    const uint8_t data3[] = {0x00};
+    const uint8_t frame3[] = {0x01, 0x01, 0x01, 0x01, 0x00};
+    EXPECT_EQ(RETCODE_OK, XProtocol_EncodeFrame(data3, sizeof(data3), sizeof(frame), frame, &framelen));
+    ASSERT_EQ(sizeof(frame3), framelen);
+    EXPECT_EQ(0, memcmp(frame3, frame, framelen));
+
+    /* A full block of 254 bytes is not followed by an implied 0x00 */
+    CrcChecksum = 0x1234;
+    uint8_t data4[254];
+    memset(data4, 0x55, sizeof(data4));
+    EXPECT_EQ(RETCODE_OK, XProtocol_EncodeFrame(data4, sizeof(data4), sizeof(frame), frame, &framelen));
+    ASSERT_EQ(XProtocol_GetMaxEncodedLength(sizeof(data4)), framelen);
+    EXPECT_EQ(0xFF, frame[0]);
+    EXPECT_EQ(0, memcmp(data4, &frame[1], sizeof(data4)));
+    const uint8_t tail4[] = {0x03, 0x12, 0x34, 0x00};
+    EXPECT_EQ(0, memcmp(tail4, &frame[255], sizeof(tail4)));
+}
+
+TEST_F(XProtocolCobsRoutines, testEncodeFrameFail)
+{
+    /** @testcase{XProtocolCobsRoutines::testEncodeFrameFail: }
+     * XProtocol_EncodeFrame API fails if the frame buffer is too small, down to the last byte
+     */
+    uint8_t frame[MAX_FRAME_SIZE];
+    uint32_t framelen;
+    uint8_t data[300];
+    FillPayload(data, sizeof(data), 3);
+
+    CRC_16_fake.custom_fake = CRC_16_sequence_fake;
+    ASSERT_EQ(RETCODE_OK, XProtocol_EncodeFrame(data, sizeof(data), sizeof(frame), frame, &framelen));
+    for (uint32_t size = 0; size < framelen; size++)
+    {
+        EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_FRAME_BUFFER_TOO_SMALL), XProtocol_EncodeFrame(data, sizeof(data), size, frame, &framelen));
+    }
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), XProtocol_EncodeFrame(NULL, sizeof(data), sizeof(frame), frame, &framelen));
+}
+
+TEST_F(XProtocolCobsRoutines, testRoundTrip)
+{
+    /** @testcase{XProtocolCobsRoutines::testRoundTrip: }
+     * Frames of any length contain no 0x00 but the delimiter, stay within the bounded overhead and decode to the payload
+     */
+    CRC_16_fake.custom_fake = CRC_16_sequence_fake;
+    uint8_t data[MAX_DATA_LENGTH - 100];
+    uint8_t frame[MAX_FRAME_SIZE];
+    uint8_t decoded[MAX_DATA_LENGTH];
+    uint32_t framelen;
+    uint32_t length;
+
+    for (uint32_t dataLength = 0; dataLength <= sizeof(data); dataLength += (dataLength < 520) ? 1 : 37)
+    {
+        FillPayload(data, dataLength, dataLength);
+        ASSERT_EQ(RETCODE_OK, XProtocol_EncodeFrame(data, dataLength, sizeof(frame), frame, &framelen)) << dataLength;
+        ASSERT_GE(XProtocol_GetMaxEncodedLength(dataLength), framelen) << dataLength;
+        EXPECT_EQ(NULL, memchr(frame, 0x00, framelen - 1)) << dataLength;
+        EXPECT_EQ(RETCODE_OK, XProtocol_IsCompleteFrame(frame, framelen, NULL));
+
+        if (0U < dataLength)
+        {
+            EXPECT_EQ(RETCODE_OK, XProtocol_GetPayloadLength(frame, framelen, &length)) << dataLength;
+            EXPECT_EQ(dataLength, length);
+        }
+
+        memset(decoded, 0xAA, sizeof(decoded));
+        EXPECT_EQ(RETCODE_OK, XProtocol_DecodeFrame(frame, framelen, sizeof(decoded), decoded, &length)) << dataLength;
+        ASSERT_EQ(dataLength, length);
+        EXPECT_EQ(0, memcmp(data, decoded, dataLength)) << dataLength;
+
+        /* Scatter-gather input gives the same frame */
+        uint8_t segmentedFrame[MAX_FRAME_SIZE];
+        uint32_t segmentedFramelen;
+        XProtocol_Segment_T segments[2] = {{data, dataLength / 2}, {&data[dataLength / 2], dataLength - dataLength / 2}};
+        EXPECT_EQ(RETCODE_OK, XProtocol_EncodeFrameSegments(segments, 2, sizeof(segmentedFrame), segmentedFrame, &segmentedFramelen));
+        ASSERT_EQ(framelen, segmentedFramelen);
+        EXPECT_EQ(0, memcmp(frame, segmentedFrame, framelen));
+    }
+}
+
+TEST_F(XProtocolCobsRoutines, testBoundedOverhead)
+{
+    /** @testcase{XProtocolCobsRoutines::testBoundedOverhead: }
+     * Payload consisting of special characters of the escaping framing only grows by the COBS overhead
+     */
+    uint8_t data[508];
+    uint8_t frame[MAX_FRAME_SIZE];
+    uint32_t framelen;
+    memset(data, 0xC0, sizeof(data));
+
+    CrcChecksum = 0x1234;
+    EXPECT_EQ(RETCODE_OK, XProtocol_EncodeFrame(data, sizeof(data), sizeof(frame), frame, &framelen));
+    /* Two full blocks, one block for the checksum and the delimiter */
+    EXPECT_EQ(sizeof(data) + 2 + 3 + 1, framelen);
+    EXPECT_EQ(XProtocol_GetMaxEncodedLength(sizeof(data)), framelen);
+}
+
+TEST_F(XProtocolCobsRoutines, testDecodeFrameFail)
+{
+    /** @testcase{XProtocolCobsRoutines::testDecodeFrameFail: }
+     * XProtocol_DecodeFrame API rejects broken frames
+     */
+    uint8_t data[MAX_DATA_LENGTH];
+    uint32_t length;
+    CrcChecksum = 0x1234;
+
+    const uint8_t noDelimiter[] = {0x03, 0x12, 0x34};
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_END_DELIMITER_MISSING), XProtocol_DecodeFrame(noDelimiter, sizeof(noDelimiter), sizeof(data), data, &length));
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_FRAME_BUFFER_TOO_SMALL), XProtocol_DecodeFrame(noDelimiter, 0, sizeof(data), data, &length));
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), XProtocol_DecodeFrame(NULL, sizeof(noDelimiter), sizeof(data), data, &length));
+
+    const uint8_t twoFrames[] = {0x03, 0x12, 0x34, 0x00, 0x03, 0x12, 0x34, 0x00};
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_INTEGRITY_FAILED), XProtocol_DecodeFrame(twoFrames, sizeof(twoFrames), sizeof(data), data, &length));
+
+    const uint8_t cutOff[] = {0x05, 0x12, 0x34, 0x00};
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_INTEGRITY_FAILED), XProtocol_DecodeFrame(cutOff, sizeof(cutOff), sizeof(data), data, &length));
+
+    const uint8_t noChecksum[] = {0x02, 0x12, 0x00};
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_INTEGRITY_FAILED), XProtocol_DecodeFrame(noChecksum, sizeof(noChecksum), sizeof(data), data, &length));
+
+    const uint8_t delimiterOnly[] = {0x00};
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_INTEGRITY_FAILED), XProtocol_DecodeFrame(delimiterOnly, sizeof(delimiterOnly), sizeof(data), data, &length));
+
+    const uint8_t wrongChecksum[] = {0x04, 0x11, 0x12, 0x35, 0x00};
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_INTEGRITY_FAILED), XProtocol_DecodeFrame(wrongChecksum, sizeof(wrongChecksum), sizeof(data), data, &length));
+
+    const uint8_t tooLong[] = {0x06, 0x11, 0x22, 0x33, 0x12, 0x34, 0x00};
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_DATA_BUFFER_TOO_SMALL), XProtocol_DecodeFrame(tooLong, sizeof(tooLong), 2, data, &length));
+    EXPECT_EQ(RETCODE_OK, XProtocol_DecodeFrame(tooLong, sizeof(tooLong), 3, data, &length));
+    EXPECT_EQ(UINT32_C(3), length);
+}
+
+TEST_F(XProtocolCobsRoutines, testGetPayloadLength)
+{
+    /** @testcase{XProtocolCobsRoutines::testGetPayloadLength: }
+     * XProtocol_GetPayloadLength API follows the code bytes
+     */
+    uint32_t length;
+
+    const uint8_t frame1[] = {0x03, 0x11, 0x22, 0x04, 0x33, 0x12, 0x34, 0x00};
+    EXPECT_EQ(RETCODE_OK, XProtocol_GetPayloadLength(frame1, sizeof(frame1), &length));
+    EXPECT_EQ(UINT32_C(4), length);
+
+    const uint8_t frame2[] = {0x01, 0x01, 0x01, 0x01, 0x00};
+    EXPECT_EQ(RETCODE_OK, XProtocol_GetPayloadLength(frame2, sizeof(frame2), &length));
+    EXPECT_EQ(UINT32_C(1), length);
+
+    const uint8_t checksumOnly[] = {0x03, 0x12, 0x34, 0x00};
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_INTEGRITY_FAILED), XProtocol_GetPayloadLength(checksumOnly, sizeof(checksumOnly), &length));
+
+    const uint8_t cutOff[] = {0x05, 0x12, 0x34};
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_INTEGRITY_FAILED), XProtocol_GetPayloadLength(cutOff, sizeof(cutOff), &length));
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), XProtocol_GetPayloadLength(NULL, sizeof(cutOff), &length));
+}
+
+TEST_F(XProtocolCobsRoutines, testIsCompleteFrame)
+{
+    /** @testcase{XProtocolCobsRoutines::testIsCompleteFrame: }
+     * XProtocol_IsCompleteFrame API checks for the 0x00 delimiter
+     */
+    const uint8_t frame[] = {0x03, 0x12, 0x34, 0x00};
+    const uint8_t *last;
+
+    EXPECT_EQ(RETCODE_OK, XProtocol_IsCompleteFrame(frame, sizeof(frame), &last));
+    EXPECT_EQ(&frame[3], last);
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_INFO, RETCODE_XPROTOCOL_FRAME_NOT_COMPLETE_YET), XProtocol_IsCompleteFrame(frame, 3, NULL));
+}
+
+TEST_F(XProtocolCobsRoutines, testDecoderPush)
+{
+    /** @testcase{XProtocolCobsRoutines::testDecoderPush: }
+     * Streaming decoder delivers the same frames for any split of the received bytes and ignores empty frames
+     */
+    CRC_16_fake.custom_fake = CRC_16_sequence_fake;
+    uint8_t first[300];
+    const uint8_t second[] = {0x00, 0x00, 0x21};
+    uint8_t stream[MAX_FRAME_SIZE];
+    uint32_t streamLength = 0;
+    uint32_t framelen;
+    FillPayload(first, sizeof(first), 3);
+    memset(&first[10], 0x77, 260);
+
+    /* Leading delimiter, first frame, empty frame, second frame */
+    stream[streamLength++] = 0x00;
+    ASSERT_EQ(RETCODE_OK, XProtocol_EncodeFrame(first, sizeof(first), sizeof(stream) - streamLength, &stream[streamLength], &framelen));
+    streamLength += framelen;
+    stream[streamLength++] = 0x00;
+    ASSERT_EQ(RETCODE_OK, XProtocol_EncodeFrame(second, sizeof(second), sizeof(stream) - streamLength, &stream[streamLength], &framelen));
+    streamLength += framelen;
+
+    for (uint32_t chunk = 1; chunk <= streamLength; chunk += (chunk < 40) ? 1 : 13)
+    {
+        XProtocol_Decoder_T decoder;
+        uint8_t buffer[sizeof(first)];
+        DecodedFrames frames;
+        memset(&frames, 0, sizeof(frames));
+        ASSERT_EQ(RETCODE_OK, XProtocol_DecoderInitialize(&decoder, buffer, sizeof(buffer), DecoderCallback, &frames));
+
+        for (uint32_t offset = 0; offset < streamLength; offset += chunk)
+        {
+            uint32_t length = (streamLength - offset < chunk) ? (streamLength - offset) : chunk;
+            EXPECT_EQ(RETCODE_OK, XProtocol_DecoderPush(&decoder, &stream[offset], length)) << chunk;
+        }
+
+        EXPECT_EQ(UINT32_C(2), frames.Count);
+        ASSERT_EQ(sizeof(first) + sizeof(second), frames.Length);
+        EXPECT_EQ(0, memcmp(first, frames.Payload, sizeof(first)));
+        EXPECT_EQ(0, memcmp(second, &frames.Payload[sizeof(first)], sizeof(second)));
+    }
+}
+
+TEST_F(XProtocolCobsRoutines, testDecoderDropsBrokenFrames)
+{
+    /** @testcase{XProtocolCobsRoutines::testDecoderDropsBrokenFrames: }
+     * Streaming decoder drops broken frames, reports why and resynchronizes at the next delimiter
+     */
+    CRC_16_fake.custom_fake = CRC_16_sequence_fake;
+    const uint8_t data[] = {0x01, 0x00, 0x03, 0x04};
+    uint8_t frame[MAX_FRAME_SIZE];
+    uint32_t framelen;
+    XProtocol_Decoder_T decoder;
+    uint8_t buffer[sizeof(data)];
+    DecodedFrames frames;
+    memset(&frames, 0, sizeof(frames));
+
+    ASSERT_EQ(RETCODE_OK, XProtocol_EncodeFrame(data, sizeof(data), sizeof(frame), frame, &framelen));
+    ASSERT_EQ(RETCODE_OK, XProtocol_DecoderInitialize(&decoder, buffer, sizeof(buffer), DecoderCallback, &frames));
+
+    /* Wrong checksum */
+    frame[framelen - 2] ^= 0x01;
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_INTEGRITY_FAILED), XProtocol_DecoderPush(&decoder, frame, framelen));
+    frame[framelen - 2] ^= 0x01;
+    EXPECT_EQ(RETCODE_OK, XProtocol_DecoderPush(&decoder, frame, framelen));
+    EXPECT_EQ(UINT32_C(1), frames.Count);
+
+    /* Frame cut off inside a block */
+    const uint8_t cutOff[] = {0x05, 0x01, 0x02, 0x00};
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_INTEGRITY_FAILED), XProtocol_DecoderPush(&decoder, cutOff, sizeof(cutOff)));
+    EXPECT_EQ(RETCODE_OK, XProtocol_DecoderPush(&decoder, frame, framelen));
+    EXPECT_EQ(UINT32_C(2), frames.Count);
+
+    /* Payload exceeding the buffer, the rest of the frame is skipped */
+    const uint8_t tooLong[] = {0x08, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x03, 0x01, 0x02, 0x00};
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_DATA_BUFFER_TOO_SMALL), XProtocol_DecoderPush(&decoder, tooLong, sizeof(tooLong)));
+    EXPECT_EQ(RETCODE_OK, XProtocol_DecoderPush(&decoder, frame, framelen));
+    EXPECT_EQ(UINT32_C(3), frames.Count);
+
+    /* Reset drops a partial frame */
+    EXPECT_EQ(RETCODE_OK, XProtocol_DecoderPush(&decoder, frame, 2));
+    XProtocol_DecoderReset(&decoder);
+    EXPECT_EQ(RETCODE_OK, XProtocol_DecoderPush(&decoder, frame, framelen));
+    EXPECT_EQ(UINT32_C(4), frames.Count);
+    EXPECT_EQ(4 * sizeof(data), frames.Length);
+}
+
+TEST_F(XProtocolCobsRoutines, testDecoderInPlace)
+{
+    /** @testcase{XProtocolCobsRoutines::testDecoderInPlace: }
+     * Streaming decoder decodes bytes received into the reserved space of its own buffer
+     */
+    CRC_16_fake.custom_fake = CRC_16_sequence_fake;
+    uint8_t data[260];
+    uint8_t stream[MAX_FRAME_SIZE];
+    uint32_t streamLength = 0;
+    uint32_t framelen;
+    FillPayload(data, sizeof(data), 0);
+    memset(data, 0x11, 255);
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        ASSERT_EQ(RETCODE_OK, XProtocol_EncodeFrame(data, sizeof(data), sizeof(stream) - streamLength, &stream[streamLength], &framelen));
+        streamLength += framelen;
+    }
+
+    for (uint32_t chunk = 1; chunk <= streamLength; chunk += (chunk < 40) ? 1 : 29)
+    {
+        XProtocol_Decoder_T decoder;
+        /* Exactly the payload size, so the delimiter of a full payload is received into the spare bytes */
+        uint8_t buffer[sizeof(data)];
+        DecodedFrames frames;
+        memset(&frames, 0, sizeof(frames));
+        ASSERT_EQ(RETCODE_OK, XProtocol_DecoderInitialize(&decoder, buffer, sizeof(buffer), DecoderCallback, &frames));
+
+        uint32_t offset = 0;
+        while (offset < streamLength)
+        {
+            uint8_t *reserved;
+            uint32_t size = XProtocol_DecoderReserve(&decoder, &reserved);
+            ASSERT_LT(UINT32_C(0), size);
+            uint32_t length = (size < chunk) ? size : chunk;
+            length = (streamLength - offset < length) ? (streamLength - offset) : length;
+            memcpy(reserved, &stream[offset], length);
+            offset += length;
+            EXPECT_EQ(RETCODE_OK, XProtocol_DecoderCommit(&decoder, length)) << chunk;
+        }
+
+        EXPECT_EQ(UINT32_C(3), frames.Count);
+        ASSERT_EQ(3 * sizeof(data), frames.Length);
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            EXPECT_EQ(0, memcmp(data, &frames.Payload[i * sizeof(data)], sizeof(data)));
+        }
+    }
+}
+#else
+}
+#endif /* if KISO_FEATURE_XPROTOCOL */
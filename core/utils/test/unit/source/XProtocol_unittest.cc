@@ -64,6 +64,19 @@ static Retcode_T CRC_16_custom_fake(uint16_t poly, uint16_t *shifter,
     return RETCODE_OK;
 }
 
+/* CRC_16 fake which depends on every byte and on the order of the bytes, but not on how they are split into calls */
+static Retcode_T CRC_16_sequence_fake(uint16_t poly, uint16_t *shifter,
+                                      const uint8_t *data_p, uint16_t len)
+{
+    KISO_UNUSED(poly);
+    for (uint16_t i = 0; i < len; i++)
+    {
+        *shifter = (uint16_t)(((*shifter << 1) | (*shifter >> 15)) ^ data_p[i]);
+    }
+
+    return RETCODE_OK;
+}
+
 /* Retcode function locally defined */
 Retcode_T Retcode_compose(uint32_t package,
                           Retcode_Severity_T severity, uint32_t code)
@@ -543,6 +556,298 @@ TEST_F(XProtocolRoutines, testIsCompleteFrame)
      * function as NULL so, we don't expect the lastCheckPosition to change. */
     EXPECT_EQ(&frame[5], lastCheckPosition);
 }
+TEST_F(XProtocolRoutines, testGetMaxEncodedLength)
+{
+    /** @testcase{XProtocolRoutines::testGetMaxEncodedLength: }
+     * XProtocol_GetMaxEncodedLength API is called for a payload of special characters only, with a special checksum
+     */
+    const uint8_t data[] = {0xC0, 0xC9, 0xDB, 0xDB, 0xC9, 0xC0};
+    uint8_t frame[XPROTOCOL_MAX_ENCODED_LENGTH(sizeof(data))];
+    uint32_t framelen = 0;
+    CrcChecksum = 0xDBC0;
+
+    EXPECT_EQ(UINT32_C(6), XProtocol_GetMaxEncodedLength(0));
+    EXPECT_EQ(sizeof(frame), XProtocol_GetMaxEncodedLength(sizeof(data)));
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_FRAME_BUFFER_TOO_SMALL),
+              XProtocol_EncodeFrame(data, sizeof(data), sizeof(frame) - 1, frame, &framelen));
+    EXPECT_EQ(RETCODE_OK, XProtocol_EncodeFrame(data, sizeof(data), sizeof(frame), frame, &framelen));
+    EXPECT_EQ(sizeof(frame), framelen);
+}
+
+TEST_F(XProtocolRoutines, testEncodeFrameExactBufferSize)
+{
+    /** @testcase{XProtocolRoutines::testEncodeFrameExactBufferSize: }
+     * XProtocol_EncodeFrame API succeeds with a frame buffer of exactly the encoded length and fails with one byte less
+     */
+    const uint8_t data[] = {0x01, 0xC0, 0x02, 0x03, 0xDB, 0xC9, 0x04};
+    uint8_t frame[MAX_FRAME_SIZE];
+    uint32_t framelen;
+
+    for (uint16_t checksum : {0x0102, 0xC001, 0x01DB, 0xC9C0})
+    {
+        CrcChecksum = checksum;
+        for (uint32_t length = 0; length <= sizeof(data); length++)
+        {
+            uint32_t expectedLength = UINT32_C(0);
+            ASSERT_EQ(RETCODE_OK, XProtocol_EncodeFrame(data, length, sizeof(frame), frame, &expectedLength));
+            EXPECT_EQ(RETCODE_OK, XProtocol_EncodeFrame(data, length, expectedLength, frame, &framelen));
+            EXPECT_EQ(expectedLength, framelen);
+            EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_FRAME_BUFFER_TOO_SMALL),
+                      XProtocol_EncodeFrame(data, length, expectedLength - 1, frame, &framelen));
+        }
+    }
+}
+
+TEST_F(XProtocolRoutines, testEncodeFrameSegmentsFail)
+{
+    /** @testcase{XProtocolRoutines::testEncodeFrameSegmentsFail: }
+     * XProtocol_EncodeFrameSegments API is called with NULL pointers
+     */
+    const uint8_t data[2] = {1, 2};
+    XProtocol_Segment_T segments[2] = {{data, sizeof(data)}, {NULL, 1}};
+    uint8_t frame[MAX_FRAME_SIZE];
+    uint32_t framelen;
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER),
+              XProtocol_EncodeFrameSegments(NULL, 1, sizeof(frame), frame, &framelen));
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER),
+              XProtocol_EncodeFrameSegments(segments, 2, sizeof(frame), frame, &framelen));
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER),
+              XProtocol_EncodeFrameSegments(segments, 1, sizeof(frame), NULL, &framelen));
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER),
+              XProtocol_EncodeFrameSegments(segments, 1, sizeof(frame), frame, NULL));
+}
+
+TEST_F(XProtocolRoutines, testEncodeFrameSegments)
+{
+    /** @testcase{XProtocolRoutines::testEncodeFrameSegments: }
+     * XProtocol_EncodeFrameSegments API produces the same frame, including the checksum, for any split of the payload
+     */
+    CRC_16_fake.custom_fake = CRC_16_sequence_fake;
+    const uint8_t data[] = {0x10, 0xC0, 0x11, 0x12, 0xDB, 0xDB, 0x13, 0xC9, 0xC1, 0xC8, 0xDA, 0xDC, 0x14};
+    uint8_t expectedFrame[MAX_FRAME_SIZE];
+    uint32_t expectedFramelen;
+    uint8_t frame[MAX_FRAME_SIZE];
+    uint32_t framelen;
+
+    ASSERT_EQ(RETCODE_OK, XProtocol_EncodeFrame(data, sizeof(data), sizeof(expectedFrame), expectedFrame, &expectedFramelen));
+    EXPECT_EQ(UINT32_C(1 + 2 + sizeof(data) + 4 + 1), expectedFramelen);
+
+    for (uint32_t split = 0; split <= sizeof(data); split++)
+    {
+        XProtocol_Segment_T segments[3] = {{data, split}, {NULL, 0}, {&data[split], (uint32_t)sizeof(data) - split}};
+        memset(frame, 0, sizeof(frame));
+
+        EXPECT_EQ(RETCODE_OK, XProtocol_EncodeFrameSegments(segments, 3, sizeof(frame), frame, &framelen));
+        ASSERT_EQ(expectedFramelen, framelen);
+        EXPECT_EQ(0, memcmp(expectedFrame, frame, framelen));
+    }
+
+    /* The decoder accepts the checksum calculated in the same pass as the escaping */
+    uint8_t decoded[MAX_DATA_LENGTH];
+    uint32_t decodedLength;
+    EXPECT_EQ(RETCODE_OK, XProtocol_DecodeFrame(expectedFrame, expectedFramelen, sizeof(decoded), decoded, &decodedLength));
+    EXPECT_EQ(sizeof(data), decodedLength);
+    EXPECT_EQ(0, memcmp(data, decoded, sizeof(data)));
+
+    /* Without any segment the frame only consists of delimiters and checksum */
+    CRC_16_fake.custom_fake = CRC_16_custom_fake;
+    CrcChecksum = 0x1234;
+    const uint8_t emptyFrame[] = {0xC0, 0x00, 0x00, 0xC9};
+    EXPECT_EQ(RETCODE_OK, XProtocol_EncodeFrameSegments(NULL, 0, sizeof(frame), frame, &framelen));
+    ASSERT_EQ(sizeof(emptyFrame), framelen);
+    EXPECT_EQ(0, memcmp(emptyFrame, frame, framelen));
+}
+
+/* Frames passed to the callback of the streaming decoder */
+struct DecodedFrames
+{
+    uint32_t Count;
+    uint32_t Length;
+    uint8_t Payload[MAX_DATA_LENGTH];
+};
+
+static void DecoderCallback(const uint8_t *payload, uint32_t payloadLength, void *callbackParam)
+{
+    DecodedFrames *frames = (DecodedFrames *)callbackParam;
+    memcpy(&frames->Payload[frames->Length], payload, payloadLength);
+    frames->Length += payloadLength;
+    frames->Count++;
+}
+
+TEST_F(XProtocolRoutines, testDecoderFail)
+{
+    /** @testcase{XProtocolRoutines::testDecoderFail: }
+     * Streaming decoder API rejects NULL pointers
+     */
+    XProtocol_Decoder_T decoder;
+    uint8_t buffer[TEST_DATA_SIZE];
+    uint8_t *reserved;
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), XProtocol_DecoderInitialize(NULL, buffer, sizeof(buffer), DecoderCallback, NULL));
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), XProtocol_DecoderInitialize(&decoder, NULL, sizeof(buffer), DecoderCallback, NULL));
+    ASSERT_EQ(RETCODE_OK, XProtocol_DecoderInitialize(&decoder, buffer, sizeof(buffer), DecoderCallback, NULL));
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), XProtocol_DecoderPush(NULL, buffer, 1));
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), XProtocol_DecoderPush(&decoder, NULL, 1));
+    EXPECT_EQ(UINT32_C(0), XProtocol_DecoderReserve(NULL, &reserved));
+    EXPECT_EQ(UINT32_C(0), XProtocol_DecoderReserve(&decoder, NULL));
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), XProtocol_DecoderCommit(NULL, 1));
+    /* Commit without reserve */
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), XProtocol_DecoderCommit(&decoder, 1));
+
+    EXPECT_EQ(sizeof(buffer), XProtocol_DecoderReserve(&decoder, &reserved));
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INVALID_PARAM), XProtocol_DecoderCommit(&decoder, sizeof(buffer) + 1));
+    XProtocol_DecoderReset(NULL);
+}
+
+TEST_F(XProtocolRoutines, testDecoderPush)
+{
+    /** @testcase{XProtocolRoutines::testDecoderPush: }
+     * Streaming decoder delivers the same frames for any split of the received bytes, skipping garbage between frames
+     */
+    CRC_16_fake.custom_fake = CRC_16_sequence_fake;
+    const uint8_t first[] = {0x10, 0xC0, 0x11, 0x12, 0xDB, 0xDB, 0x13, 0xC9, 0xC1, 0xC8, 0xDA, 0xDC, 0x14};
+    const uint8_t second[] = {0x20, 0x21, 0x22};
+    uint8_t stream[MAX_FRAME_SIZE];
+    uint32_t streamLength = 0;
+    uint32_t framelen;
+
+    /* Garbage, first frame, garbage including an end delimiter, empty frame, second frame */
+    stream[streamLength++] = 0x55;
+    stream[streamLength++] = 0xC9;
+    ASSERT_EQ(RETCODE_OK, XProtocol_EncodeFrame(first, sizeof(first), sizeof(stream) - streamLength, &stream[streamLength], &framelen));
+    streamLength += framelen;
+    stream[streamLength++] = 0xC9;
+    stream[streamLength++] = 0x66;
+    ASSERT_EQ(RETCODE_OK, XProtocol_EncodeFrame(second, 0, sizeof(stream) - streamLength, &stream[streamLength], &framelen));
+    streamLength += framelen;
+    ASSERT_EQ(RETCODE_OK, XProtocol_EncodeFrame(second, sizeof(second), sizeof(stream) - streamLength, &stream[streamLength], &framelen));
+    streamLength += framelen;
+
+    for (uint32_t chunk = 1; chunk <= streamLength; chunk++)
+    {
+        XProtocol_Decoder_T decoder;
+        uint8_t buffer[sizeof(first)];
+        DecodedFrames frames;
+        memset(&frames, 0, sizeof(frames));
+        ASSERT_EQ(RETCODE_OK, XProtocol_DecoderInitialize(&decoder, buffer, sizeof(buffer), DecoderCallback, &frames));
+
+        for (uint32_t offset = 0; offset < streamLength; offset += chunk)
+        {
+            uint32_t length = (streamLength - offset < chunk) ? (streamLength - offset) : chunk;
+            EXPECT_EQ(RETCODE_OK, XProtocol_DecoderPush(&decoder, &stream[offset], length));
+        }
+
+        EXPECT_EQ(UINT32_C(3), frames.Count);
+        ASSERT_EQ(sizeof(first) + sizeof(second), frames.Length);
+        EXPECT_EQ(0, memcmp(first, frames.Payload, sizeof(first)));
+        EXPECT_EQ(0, memcmp(second, &frames.Payload[sizeof(first)], sizeof(second)));
+    }
+}
+
+TEST_F(XProtocolRoutines, testDecoderDropsBrokenFrames)
+{
+    /** @testcase{XProtocolRoutines::testDecoderDropsBrokenFrames: }
+     * Streaming decoder drops broken frames, reports why and resynchronizes at the next start delimiter
+     */
+    CRC_16_fake.custom_fake = CRC_16_sequence_fake;
+    const uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+    uint8_t frame[MAX_FRAME_SIZE];
+    uint32_t framelen;
+    XProtocol_Decoder_T decoder;
+    uint8_t buffer[sizeof(data)];
+    DecodedFrames frames;
+    memset(&frames, 0, sizeof(frames));
+
+    ASSERT_EQ(RETCODE_OK, XProtocol_EncodeFrame(data, sizeof(data), sizeof(frame), frame, &framelen));
+    ASSERT_EQ(RETCODE_OK, XProtocol_DecoderInitialize(&decoder, buffer, sizeof(buffer), DecoderCallback, &frames));
+
+    /* Wrong checksum */
+    frame[framelen - 2] ^= 0x01;
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_INTEGRITY_FAILED), XProtocol_DecoderPush(&decoder, frame, framelen));
+    frame[framelen - 2] ^= 0x01;
+    EXPECT_EQ(RETCODE_OK, XProtocol_DecoderPush(&decoder, frame, framelen));
+    EXPECT_EQ(UINT32_C(1), frames.Count);
+
+    /* Frame too short for a checksum */
+    const uint8_t shortFrame[] = {0xC0, 0x01, 0xC9};
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_INTEGRITY_FAILED), XProtocol_DecoderPush(&decoder, shortFrame, sizeof(shortFrame)));
+
+    /* Invalid escape sequence, the rest of the frame is skipped */
+    const uint8_t invalidEscape[] = {0xC0, 0x00, 0x00, 0xDB, 0x01, 0x02, 0xC9};
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_INTEGRITY_FAILED), XProtocol_DecoderPush(&decoder, invalidEscape, sizeof(invalidEscape)));
+    EXPECT_EQ(RETCODE_OK, XProtocol_DecoderPush(&decoder, frame, framelen));
+    EXPECT_EQ(UINT32_C(2), frames.Count);
+
+    /* Payload exceeding the buffer */
+    const uint8_t tooLong[] = {0xC0, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0xC9};
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_DATA_BUFFER_TOO_SMALL), XProtocol_DecoderPush(&decoder, tooLong, sizeof(tooLong)));
+    EXPECT_EQ(RETCODE_OK, XProtocol_DecoderPush(&decoder, frame, framelen));
+    EXPECT_EQ(UINT32_C(3), frames.Count);
+
+    /* Frame cut off by the next one, which is still delivered */
+    EXPECT_EQ(RETCODE_OK, XProtocol_DecoderPush(&decoder, frame, framelen - 3));
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_XPROTOCOL_END_DELIMITER_MISSING), XProtocol_DecoderPush(&decoder, frame, 1));
+    EXPECT_EQ(RETCODE_OK, XProtocol_DecoderPush(&decoder, &frame[1], framelen - 1));
+    EXPECT_EQ(UINT32_C(4), frames.Count);
+
+    /* Reset drops a partial frame */
+    EXPECT_EQ(RETCODE_OK, XProtocol_DecoderPush(&decoder, frame, framelen - 1));
+    XProtocol_DecoderReset(&decoder);
+    EXPECT_EQ(RETCODE_OK, XProtocol_DecoderPush(&decoder, &frame[framelen - 1], 1));
+    EXPECT_EQ(UINT32_C(4), frames.Count);
+    EXPECT_EQ(4 * sizeof(data), frames.Length);
+}
+
+TEST_F(XProtocolRoutines, testDecoderInPlace)
+{
+    /** @testcase{XProtocolRoutines::testDecoderInPlace: }
+     * Streaming decoder decodes bytes received into the reserved space of its own buffer
+     */
+    CRC_16_fake.custom_fake = CRC_16_sequence_fake;
+    const uint8_t data[] = {0xC0, 0x31, 0xC9, 0x32, 0xDB, 0x33, 0x34, 0x35};
+    uint8_t stream[MAX_FRAME_SIZE];
+    uint32_t streamLength = 0;
+    uint32_t framelen;
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        ASSERT_EQ(RETCODE_OK, XProtocol_EncodeFrame(data, sizeof(data), sizeof(stream) - streamLength, &stream[streamLength], &framelen));
+        streamLength += framelen;
+    }
+
+    for (uint32_t chunk = 1; chunk <= streamLength; chunk++)
+    {
+        XProtocol_Decoder_T decoder;
+        /* Exactly the payload size, so the delimiter of a full payload is received into the spare bytes */
+        uint8_t buffer[sizeof(data)];
+        DecodedFrames frames;
+        memset(&frames, 0, sizeof(frames));
+        ASSERT_EQ(RETCODE_OK, XProtocol_DecoderInitialize(&decoder, buffer, sizeof(buffer), DecoderCallback, &frames));
+
+        uint32_t offset = 0;
+        while (offset < streamLength)
+        {
+            uint8_t *reserved;
+            uint32_t size = XProtocol_DecoderReserve(&decoder, &reserved);
+            ASSERT_LT(UINT32_C(0), size);
+            uint32_t length = (size < chunk) ? size : chunk;
+            length = (streamLength - offset < length) ? (streamLength - offset) : length;
+            memcpy(reserved, &stream[offset], length);
+            offset += length;
+            EXPECT_EQ(RETCODE_OK, XProtocol_DecoderCommit(&decoder, length));
+        }
+
+        EXPECT_EQ(UINT32_C(3), frames.Count);
+        ASSERT_EQ(3 * sizeof(data), frames.Length);
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            EXPECT_EQ(0, memcmp(data, &frames.Payload[i * sizeof(data)], sizeof(data)));
+        }
+    }
+}
 #else
 }
 #endif /* if KISO_FEATURE_XPROTOCOL */
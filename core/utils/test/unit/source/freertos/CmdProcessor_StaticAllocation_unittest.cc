@@ -0,0 +1,152 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ *
+ * @brief
+ *      Module test specification for the CmdProcessor module created in storage given by the caller.
+ *
+ * @detail
+ *      The unit test file template follows the Four-Phase test pattern.
+ *
+ * @file
+ **/
+
+/* Include gtest interface */
+#include <gtest.h>
+
+/* Start of global scope symbol and fake definitions section */
+extern "C"
+{
+/* Setup compile time configuration defines */
+#define KISO_UTILS_STATIC_ALLOCATION 1
+
+#include "Kiso_Utils.h"
+#undef KISO_MODULE_ID
+#define KISO_MODULE_ID KISO_UTILS_MODULE_ID_CMDPROCESSOR
+
+#if KISO_FEATURE_CMDPROCESSOR
+
+/* Include faked interfaces */
+#include "Kiso_Retcode_th.hh"
+#include "Kiso_Assert_th.hh"
+
+#include "Kiso_HAL_CriticalSection_th.hh"
+#include "task_th.hh"
+#include "queue_th.hh"
+
+/* Include module under test */
+#include "CmdProcessor.c"
+
+    /* End of global scope symbol and fake definitions section */
+}
+
+#define STACK_SIZE UINT32_C(256)
+#define QUEUE_SIZE UINT32_C(3)
+
+class CmdProcessorStatic : public testing::Test
+{
+protected:
+    CmdProcessor_T CmdProcessor;
+    CmdProcessor_Storage_T Storage;
+    StackType_t Stack[STACK_SIZE];
+    uint8_t QueueMemory[CMDPROCESSOR_QUEUE_MEMORY_SIZE(2 * QUEUE_SIZE)];
+
+    virtual void SetUp()
+    {
+        RESET_FAKE(xQueueCreate);
+        RESET_FAKE(xQueueCreateStatic);
+        RESET_FAKE(xTaskCreate);
+        RESET_FAKE(xTaskCreateStatic);
+        FFF_RESET_HISTORY();
+
+        memset(&CmdProcessor, 0, sizeof(CmdProcessor));
+        xQueueCreateStatic_fake.return_val = (QueueHandle_t)0x10;
+        xTaskCreateStatic_fake.return_val = (TaskHandle_t)0x20;
+    }
+};
+
+/* Specify test cases ******************************************************* */
+
+TEST_F(CmdProcessorStatic, CommandSize)
+{
+    EXPECT_EQ(sizeof(CmdProcessor_Cmd_T), CMDPROCESSOR_COMMAND_SIZE);
+}
+
+TEST_F(CmdProcessorStatic, InitializeInStorage)
+{
+    Retcode_T retcode = CmdProcessor_InitializeStatic(&CmdProcessor, "Static", 1, STACK_SIZE, QUEUE_SIZE, Stack, QueueMemory, &Storage);
+
+    EXPECT_EQ(RETCODE_OK, retcode);
+    EXPECT_EQ(UINT32_C(1), xQueueCreateStatic_fake.call_count);
+    EXPECT_EQ(QUEUE_SIZE, xQueueCreateStatic_fake.arg0_val);
+    EXPECT_EQ(sizeof(CmdProcessor_Cmd_T), xQueueCreateStatic_fake.arg1_val);
+    EXPECT_EQ(QueueMemory, xQueueCreateStatic_fake.arg2_val);
+    EXPECT_EQ(&Storage.queues[CMDPROCESSOR_LANE_NORMAL], xQueueCreateStatic_fake.arg3_val);
+    EXPECT_EQ(UINT32_C(1), xTaskCreateStatic_fake.call_count);
+    EXPECT_EQ(STACK_SIZE, xTaskCreateStatic_fake.arg2_val);
+    EXPECT_EQ(&CmdProcessor, xTaskCreateStatic_fake.arg3_val);
+    EXPECT_EQ(Stack, xTaskCreateStatic_fake.arg5_val);
+    EXPECT_EQ(&Storage.task, xTaskCreateStatic_fake.arg6_val);
+    EXPECT_EQ(UINT32_C(0), xQueueCreate_fake.call_count);
+    EXPECT_EQ(UINT32_C(0), xTaskCreate_fake.call_count);
+
+    EXPECT_EQ(UINT32_C(1), CmdProcessor.laneCount);
+    EXPECT_EQ((cmdProcessorTaskHandle_t)0x20, CmdProcessor.task);
+    EXPECT_STREQ("Static", (const char *)CmdProcessor.name);
+}
+
+TEST_F(CmdProcessorStatic, LanesShareQueueMemory)
+{
+    uint32_t queueSizes[CMDPROCESSOR_LANE_COUNT] = {0};
+    queueSizes[CMDPROCESSOR_LANE_URGENT] = QUEUE_SIZE;
+    queueSizes[CMDPROCESSOR_LANE_BULK] = QUEUE_SIZE;
+
+    Retcode_T retcode = CmdProcessor_InitializeLanesStatic(&CmdProcessor, "Lanes", 1, STACK_SIZE, queueSizes, Stack, QueueMemory, &Storage);
+
+    EXPECT_EQ(RETCODE_OK, retcode);
+    EXPECT_EQ(UINT32_C(2), xQueueCreateStatic_fake.call_count);
+    EXPECT_EQ(QueueMemory, xQueueCreateStatic_fake.arg2_history[0]);
+    EXPECT_EQ(&QueueMemory[CMDPROCESSOR_QUEUE_MEMORY_SIZE(QUEUE_SIZE)], xQueueCreateStatic_fake.arg2_history[1]);
+    EXPECT_EQ(UINT32_C(2), CmdProcessor.laneCount);
+    EXPECT_EQ(NULL, CmdProcessor.queues[CMDPROCESSOR_LANE_NORMAL]);
+}
+
+TEST_F(CmdProcessorStatic, InitializeWithoutQueue)
+{
+    uint32_t queueSizes[CMDPROCESSOR_LANE_COUNT] = {0};
+
+    Retcode_T retcode = CmdProcessor_InitializeLanesStatic(&CmdProcessor, "Empty", 1, STACK_SIZE, queueSizes, Stack, QueueMemory, &Storage);
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INVALID_PARAM), retcode);
+    EXPECT_EQ(UINT32_C(0), xQueueCreateStatic_fake.call_count);
+    EXPECT_EQ(UINT32_C(0), xTaskCreateStatic_fake.call_count);
+}
+
+TEST_F(CmdProcessorStatic, InitializeWithoutStorage)
+{
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INVALID_PARAM),
+              CmdProcessor_InitializeStatic(&CmdProcessor, "Static", 1, STACK_SIZE, QUEUE_SIZE, NULL, QueueMemory, &Storage));
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INVALID_PARAM),
+              CmdProcessor_InitializeStatic(&CmdProcessor, "Static", 1, STACK_SIZE, QUEUE_SIZE, Stack, NULL, &Storage));
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INVALID_PARAM),
+              CmdProcessor_InitializeStatic(&CmdProcessor, "Static", 1, STACK_SIZE, QUEUE_SIZE, Stack, QueueMemory, NULL));
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INVALID_PARAM),
+              CmdProcessor_InitializeStatic(NULL, "Static", 1, STACK_SIZE, QUEUE_SIZE, Stack, QueueMemory, &Storage));
+    EXPECT_EQ(UINT32_C(0), xTaskCreateStatic_fake.call_count);
+}
+
+#else
+}
+#endif /* if KISO_FEATURE_CMDPROCESSOR */
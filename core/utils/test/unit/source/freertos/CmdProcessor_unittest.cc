@@ -25,6 +25,11 @@
 /* Include gtest interface */
 #include <gtest.h>
 
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <vector>
+
 /* Start of global scope symbol and fake definitions section */
 
 FFF_DEFINITION_BLOCK_START
@@ -44,6 +49,7 @@ extern "C"
 #include "Kiso_Retcode_th.hh"
 #include "Kiso_Assert_th.hh"
 
+#include "Kiso_HAL_CriticalSection_th.hh"
 #include "task_th.hh"
 #include "queue_th.hh"
 
@@ -88,6 +94,70 @@ BaseType_t xTaskCreate_fake_success(TaskFunction_t, const char *const,
     return pdTRUE;
 }
 
+/* Fake queues of a command processor with lanes, by handle */
+static std::map<QueueHandle_t, std::deque<CmdProcessor_Cmd_T>> laneQueues;
+static uintptr_t nextQueueHandle;
+static std::vector<uint32_t> executedCmds;
+
+QueueHandle_t myXQueueCreate(UBaseType_t, UBaseType_t)
+{
+    return (QueueHandle_t)++nextQueueHandle;
+}
+
+BaseType_t myXQueueSend(QueueHandle_t xQueue, void *pvItemToQueue, TickType_t)
+{
+    laneQueues[xQueue].push_back(*(const CmdProcessor_Cmd_T *)pvItemToQueue);
+    return pdPASS;
+}
+
+BaseType_t myXQueueSendFromISR(QueueHandle_t xQueue, void *pvItemToQueue, BaseType_t *)
+{
+    return myXQueueSend(xQueue, pvItemToQueue, 0);
+}
+
+signed long myLaneXQueueReceive(QueueHandle_t xQueue, void *pvBuffer, TickType_t xTicksToWait)
+{
+    EXPECT_EQ(0U, xTicksToWait);
+    std::deque<CmdProcessor_Cmd_T> &queue = laneQueues[xQueue];
+    if (queue.empty())
+    {
+        return errQUEUE_EMPTY;
+    }
+    *((CmdProcessor_Cmd_T *)pvBuffer) = queue.front();
+    queue.pop_front();
+    return pdPASS;
+}
+
+void recordingFn(void *, uint32_t param2)
+{
+    executedCmds.push_back(param2);
+}
+
+void otherFn(void *, uint32_t param2)
+{
+    executedCmds.push_back(param2 + 1000U);
+}
+
+/* Ticks at which timers ran, by param2 */
+static std::vector<std::pair<uint32_t, TickType_t>> timerRuns;
+static CmdProcessor_T *timerCmdProcessor;
+static CmdProcessor_Timer_T selfTimer;
+
+void timerFn(void *, uint32_t param2)
+{
+    timerRuns.push_back(std::make_pair(param2, xTaskGetTickCount_fake.return_val));
+}
+
+/* Schedules itself again right away, param2 times */
+void selfSchedulingFn(void *, uint32_t param2)
+{
+    timerFn(NULL, param2);
+    if (0U != param2)
+    {
+        (void)CmdProcessor_EnqueueDelayed(timerCmdProcessor, &selfTimer, selfSchedulingFn, NULL, param2 - 1U, 0);
+    }
+}
+
 class CmdProcessor : public testing::Test
 {
 protected:
@@ -100,8 +170,23 @@ protected:
         RESET_FAKE(vTaskSuspend);
         RESET_FAKE(vTaskResume);
         RESET_FAKE(xQueueReceive);
+        RESET_FAKE(vQueueDelete);
+        RESET_FAKE(xTaskNotifyGive);
+        RESET_FAKE(vTaskNotifyGiveFromISR);
+        RESET_FAKE(ulTaskNotifyTake);
+        RESET_FAKE(taskYIELD);
+        RESET_FAKE(xTaskGetTickCount);
+        RESET_FAKE(HAL_CriticalSection_Enter);
+        RESET_FAKE(HAL_CriticalSection_Leave);
         RESET_FAKE(Retcode_RaiseError);
 
+        laneQueues.clear();
+        nextQueueHandle = 0;
+        executedCmds.clear();
+        timerRuns.clear();
+        timerCmdProcessor = &cmdProcessor;
+        memset(&selfTimer, 0, sizeof(selfTimer));
+
         memset(&cmd, 0, sizeof(CmdProcessor_Cmd_T));
 
         xTaskCreate_fake.custom_fake = xTaskCreate_fake_success;
@@ -116,6 +201,35 @@ protected:
         FFF_RESET_HISTORY();
     }
 
+    /* Re-initializes the command processor with lanes on fake queues */
+    void InitializeLanes(uint32_t urgent, uint32_t normal, uint32_t bulk)
+    {
+        const uint32_t queueSizes[CMDPROCESSOR_LANE_COUNT] = {urgent, normal, bulk};
+        xTaskCreate_fake.custom_fake = xTaskCreate_fake_success;
+        xQueueCreate_fake.custom_fake = myXQueueCreate;
+        xQueueSend_fake.custom_fake = myXQueueSend;
+        xQueueSendFromISR_fake.custom_fake = myXQueueSendFromISR;
+        xQueueReceive_fake.custom_fake = myLaneXQueueReceive;
+
+        ASSERT_EQ(RETCODE_OK, CmdProcessor_InitializeLanes(&cmdProcessor, "lanes", TASK_PRIORITY, STACK_SIZE, queueSizes));
+    }
+
+    /* Lets the task sleep as long as it asks for, up to the given tick, returns the number of wake-ups */
+    uint32_t RunTimersUntil(TickType_t end)
+    {
+        uint32_t wakeUps = 0;
+        TickType_t timeout = TimerRun(&cmdProcessor);
+
+        while ((portMAX_DELAY != timeout) && ((int32_t)(end - (xTaskGetTickCount_fake.return_val + timeout)) >= 0))
+        {
+            xTaskGetTickCount_fake.return_val += timeout;
+            timeout = TimerRun(&cmdProcessor);
+            wakeUps++;
+        }
+        xTaskGetTickCount_fake.return_val = end;
+        return wakeUps;
+    }
+
     CmdProcessor_T cmdProcessor = {0};
 };
 
@@ -206,7 +320,7 @@ TEST_F(CmdProcessor, CmdProcessorEnqueueCmdProcessorNull)
 TEST_F(CmdProcessor, CmdProcessorEnqueueCmdProcessorQueueNull)
 {
     Retcode_T retVal = RETCODE_OK;
-    cmdProcessor.queue = NULL;
+    cmdProcessor.queues[CMDPROCESSOR_LANE_NORMAL] = NULL;
     retVal = CmdProcessor_Enqueue(&cmdProcessor, fake_fn, NULL, INIT_VAL);
 
     EXPECT_EQ(RETCODE_INVALID_PARAM, Retcode_GetCode(retVal));
@@ -267,7 +381,7 @@ TEST_F(CmdProcessor, CmdProcessorEnqueueFromISRCmdProcessorNull)
 TEST_F(CmdProcessor, CmdProcessorEnqueueFromISRQueueNull)
 {
     Retcode_T retVal = RETCODE_OK;
-    cmdProcessor.queue = NULL;
+    cmdProcessor.queues[CMDPROCESSOR_LANE_NORMAL] = NULL;
 
     retVal = CmdProcessor_EnqueueFromIsr(&cmdProcessor, fake_fn, NULL, INIT_VAL);
 
@@ -379,7 +493,7 @@ TEST_F(CmdProcessor, CmdProcessorDequeueCmdPrcsrFail)
 
 TEST_F(CmdProcessor, CmdProcessorDequeueCmdPrcsrQueueFail)
 {
-    cmdProcessor.queue = NULL;
+    cmdProcessor.queues[CMDPROCESSOR_LANE_NORMAL] = NULL;
 
     Dequeue(&cmdProcessor);
 
@@ -387,6 +501,451 @@ TEST_F(CmdProcessor, CmdProcessorDequeueCmdPrcsrQueueFail)
     EXPECT_EQ(UINT32_C(1), Retcode_RaiseError_fake.call_count);
     EXPECT_EQ(RETCODE_INVALID_PARAM, Retcode_GetCode(Retcode_RaiseError_fake.arg0_val));
 }
+TEST_F(CmdProcessor, CmdProcessorInitializeLanesSuccess)
+{
+    const uint32_t queueSizes[CMDPROCESSOR_LANE_COUNT] = {2, 3, 0};
+    CmdProcessor_T cmdProcessorInstance;
+    xTaskCreate_fake.custom_fake = xTaskCreate_fake_success;
+    xQueueCreate_fake.custom_fake = myXQueueCreate;
+
+    Retcode_T retVal = CmdProcessor_InitializeLanes(&cmdProcessorInstance, "abc", TASK_PRIORITY, STACK_SIZE, queueSizes);
+
+    EXPECT_EQ(RETCODE_OK, Retcode_GetCode(retVal));
+    EXPECT_EQ(UINT32_C(2), xQueueCreate_fake.call_count);
+    EXPECT_EQ(UINT32_C(2), xQueueCreate_fake.arg0_history[0]);
+    EXPECT_EQ(UINT32_C(3), xQueueCreate_fake.arg0_history[1]);
+    EXPECT_EQ(UINT32_C(2), cmdProcessorInstance.laneCount);
+    EXPECT_EQ(NULL, cmdProcessorInstance.queues[CMDPROCESSOR_LANE_BULK]);
+    EXPECT_EQ(UINT32_C(1), xTaskCreate_fake.call_count);
+}
+
+TEST_F(CmdProcessor, CmdProcessorInitializeLanesInvalidParam)
+{
+    const uint32_t noQueueSizes[CMDPROCESSOR_LANE_COUNT] = {0, 0, 0};
+    CmdProcessor_T cmdProcessorInstance;
+
+    EXPECT_EQ(RETCODE_INVALID_PARAM, Retcode_GetCode(CmdProcessor_InitializeLanes(&cmdProcessorInstance, "abc", TASK_PRIORITY, STACK_SIZE, NULL)));
+    EXPECT_EQ(RETCODE_INVALID_PARAM, Retcode_GetCode(CmdProcessor_InitializeLanes(&cmdProcessorInstance, "abc", TASK_PRIORITY, STACK_SIZE, noQueueSizes)));
+    EXPECT_EQ(UINT32_C(0), xQueueCreate_fake.call_count);
+    EXPECT_EQ(UINT32_C(0), xTaskCreate_fake.call_count);
+}
+
+TEST_F(CmdProcessor, CmdProcessorInitializeLanesQueueFail)
+{
+    const uint32_t queueSizes[CMDPROCESSOR_LANE_COUNT] = {2, 3, 4};
+    QueueHandle_t queues[] = {(QueueHandle_t)1, NULL};
+    CmdProcessor_T cmdProcessorInstance;
+    SET_RETURN_SEQ(xQueueCreate, queues, 2);
+
+    Retcode_T retVal = CmdProcessor_InitializeLanes(&cmdProcessorInstance, "abc", TASK_PRIORITY, STACK_SIZE, queueSizes);
+
+    EXPECT_EQ(RETCODE_FAILURE, Retcode_GetCode(retVal));
+    EXPECT_EQ(UINT32_C(2), xQueueCreate_fake.call_count);
+    EXPECT_EQ(UINT32_C(0), xTaskCreate_fake.call_count);
+    EXPECT_EQ(UINT32_C(1), vQueueDelete_fake.call_count);
+    EXPECT_EQ(queues[0], vQueueDelete_fake.arg0_val);
+    EXPECT_EQ(UINT32_C(0), cmdProcessorInstance.laneCount);
+}
+
+TEST_F(CmdProcessor, CmdProcessorEnqueueToLaneInvalidParam)
+{
+    InitializeLanes(2, 2, 0);
+
+    EXPECT_EQ(RETCODE_INVALID_PARAM, Retcode_GetCode(CmdProcessor_EnqueueToLane(NULL, CMDPROCESSOR_LANE_URGENT, false, fake_fn, NULL, 0)));
+    EXPECT_EQ(RETCODE_INVALID_PARAM, Retcode_GetCode(CmdProcessor_EnqueueToLane(&cmdProcessor, CMDPROCESSOR_LANE_BULK, false, fake_fn, NULL, 0)));
+    EXPECT_EQ(RETCODE_INVALID_PARAM, Retcode_GetCode(CmdProcessor_EnqueueToLane(&cmdProcessor, CMDPROCESSOR_LANE_COUNT, false, fake_fn, NULL, 0)));
+    EXPECT_EQ(UINT32_C(0), xQueueSend_fake.call_count);
+}
+
+TEST_F(CmdProcessor, CmdProcessorEnqueueSingleLaneNoNotification)
+{
+    xQueueSend_fake.return_val = pdPASS;
+    xQueueSendFromISR_fake.return_val = pdPASS;
+
+    EXPECT_EQ(RETCODE_OK, CmdProcessor_Enqueue(&cmdProcessor, fake_fn, NULL, INIT_VAL));
+    EXPECT_EQ(RETCODE_OK, CmdProcessor_EnqueueFromIsr(&cmdProcessor, fake_fn, NULL, INIT_VAL));
+
+    EXPECT_EQ(UINT32_C(0), xTaskNotifyGive_fake.call_count);
+    EXPECT_EQ(UINT32_C(0), vTaskNotifyGiveFromISR_fake.call_count);
+}
+
+TEST_F(CmdProcessor, CmdProcessorEnqueueToLaneNotifies)
+{
+    InitializeLanes(2, 2, 2);
+
+    EXPECT_EQ(RETCODE_OK, CmdProcessor_EnqueueToLane(&cmdProcessor, CMDPROCESSOR_LANE_BULK, false, recordingFn, NULL, 1));
+    EXPECT_EQ(RETCODE_OK, CmdProcessor_EnqueueToLaneFromIsr(&cmdProcessor, CMDPROCESSOR_LANE_URGENT, false, recordingFn, NULL, 2));
+
+    EXPECT_EQ(UINT32_C(1), xTaskNotifyGive_fake.call_count);
+    EXPECT_EQ((TaskHandle_t)0x123, xTaskNotifyGive_fake.arg0_val);
+    EXPECT_EQ(UINT32_C(1), vTaskNotifyGiveFromISR_fake.call_count);
+    EXPECT_EQ(1U, laneQueues[(QueueHandle_t)cmdProcessor.queues[CMDPROCESSOR_LANE_BULK]].size());
+    EXPECT_EQ(1U, laneQueues[(QueueHandle_t)cmdProcessor.queues[CMDPROCESSOR_LANE_URGENT]].size());
+}
+
+TEST_F(CmdProcessor, CmdProcessorDequeueMostUrgentFirst)
+{
+    InitializeLanes(4, 4, 4);
+    (void)CmdProcessor_EnqueueToLane(&cmdProcessor, CMDPROCESSOR_LANE_BULK, false, recordingFn, NULL, 1);
+    (void)CmdProcessor_Enqueue(&cmdProcessor, recordingFn, NULL, 2);
+    (void)CmdProcessor_EnqueueToLane(&cmdProcessor, CMDPROCESSOR_LANE_URGENT, false, recordingFn, NULL, 3);
+    (void)CmdProcessor_Enqueue(&cmdProcessor, recordingFn, NULL, 4);
+    (void)CmdProcessor_EnqueueToLane(&cmdProcessor, CMDPROCESSOR_LANE_URGENT, false, recordingFn, NULL, 5);
+
+    Dequeue(&cmdProcessor);
+
+    std::vector<uint32_t> expected = {3, 5, 2, 4, 1};
+    EXPECT_EQ(expected, executedCmds);
+    EXPECT_EQ(UINT32_C(0), ulTaskNotifyTake_fake.call_count);
+    EXPECT_EQ(UINT32_C(0), Retcode_RaiseError_fake.call_count);
+
+    /* Nothing left, the task waits for its notification */
+    Dequeue(&cmdProcessor);
+
+    EXPECT_EQ(UINT32_C(1), ulTaskNotifyTake_fake.call_count);
+    EXPECT_EQ(pdTRUE, ulTaskNotifyTake_fake.arg0_val);
+    EXPECT_EQ(portMAX_DELAY, ulTaskNotifyTake_fake.arg1_val);
+}
+
+TEST_F(CmdProcessor, CmdProcessorDequeueBatch)
+{
+    const uint32_t total = CONFIG_CMDPROCESSOR_BATCH_SIZE + 2U;
+    InitializeLanes(0, total, total);
+    for (uint32_t i = 0; i < total; i++)
+    {
+        (void)CmdProcessor_EnqueueToLane(&cmdProcessor, CMDPROCESSOR_LANE_BULK, false, recordingFn, NULL, i);
+    }
+
+    Dequeue(&cmdProcessor);
+
+    EXPECT_EQ((size_t)CONFIG_CMDPROCESSOR_BATCH_SIZE, executedCmds.size());
+    EXPECT_EQ(UINT32_C(1), taskYIELD_fake.call_count);
+    EXPECT_EQ(UINT32_C(0), ulTaskNotifyTake_fake.call_count);
+
+    Dequeue(&cmdProcessor);
+
+    EXPECT_EQ((size_t)total, executedCmds.size());
+    EXPECT_EQ(UINT32_C(1), taskYIELD_fake.call_count);
+    EXPECT_EQ(UINT32_C(0), ulTaskNotifyTake_fake.call_count);
+}
+
+TEST_F(CmdProcessor, CmdProcessorEnqueueCoalesced)
+{
+    int context1;
+    int context2;
+    InitializeLanes(4, 4, 0);
+
+    EXPECT_EQ(RETCODE_OK, CmdProcessor_EnqueueToLane(&cmdProcessor, CMDPROCESSOR_LANE_NORMAL, true, recordingFn, &context1, 1));
+    EXPECT_EQ(RETCODE_OK, CmdProcessor_EnqueueToLane(&cmdProcessor, CMDPROCESSOR_LANE_NORMAL, true, recordingFn, &context1, 2));
+    EXPECT_EQ(RETCODE_OK, CmdProcessor_EnqueueToLaneFromIsr(&cmdProcessor, CMDPROCESSOR_LANE_URGENT, true, recordingFn, &context1, 3));
+    EXPECT_EQ(RETCODE_OK, CmdProcessor_EnqueueToLane(&cmdProcessor, CMDPROCESSOR_LANE_NORMAL, true, recordingFn, &context2, 4));
+    EXPECT_EQ(RETCODE_OK, CmdProcessor_EnqueueToLane(&cmdProcessor, CMDPROCESSOR_LANE_NORMAL, true, otherFn, &context1, 5));
+    EXPECT_EQ(RETCODE_OK, CmdProcessor_EnqueueToLane(&cmdProcessor, CMDPROCESSOR_LANE_NORMAL, false, recordingFn, &context1, 6));
+
+    EXPECT_EQ(UINT32_C(4), xQueueSend_fake.call_count);
+    EXPECT_EQ(UINT32_C(0), xQueueSendFromISR_fake.call_count);
+    EXPECT_EQ(HAL_CriticalSection_Enter_fake.call_count, HAL_CriticalSection_Leave_fake.call_count);
+
+    Dequeue(&cmdProcessor);
+
+    std::vector<uint32_t> expected = {1, 4, 1005, 6};
+    EXPECT_EQ(expected, executedCmds);
+
+    /* Started commands are queued again */
+    EXPECT_EQ(RETCODE_OK, CmdProcessor_EnqueueToLane(&cmdProcessor, CMDPROCESSOR_LANE_NORMAL, true, recordingFn, &context1, 7));
+    EXPECT_EQ(UINT32_C(5), xQueueSend_fake.call_count);
+}
+
+TEST_F(CmdProcessor, CmdProcessorEnqueueCoalescedQueueFull)
+{
+    int context;
+    InitializeLanes(0, 4, 4);
+    xQueueSend_fake.custom_fake = NULL;
+    xQueueSend_fake.return_val = errQUEUE_FULL;
+
+    EXPECT_EQ(RETCODE_FAILURE, Retcode_GetCode(CmdProcessor_EnqueueToLane(&cmdProcessor, CMDPROCESSOR_LANE_NORMAL, true, recordingFn, &context, 1)));
+    EXPECT_EQ(NULL, cmdProcessor.queued[0].func);
+    EXPECT_EQ(UINT32_C(0), cmdProcessor.queuedCount);
+
+    /* The next try is not taken for a queued one */
+    xQueueSend_fake.return_val = pdPASS;
+    EXPECT_EQ(RETCODE_OK, CmdProcessor_EnqueueToLane(&cmdProcessor, CMDPROCESSOR_LANE_NORMAL, true, recordingFn, &context, 2));
+    EXPECT_EQ(UINT32_C(2), xQueueSend_fake.call_count);
+}
+
+TEST_F(CmdProcessor, CmdProcessorEnqueueCoalescedSlotsFull)
+{
+    int contexts[CONFIG_CMDPROCESSOR_COALESCE_SLOTS + 1];
+    InitializeLanes(0, 2 * CONFIG_CMDPROCESSOR_COALESCE_SLOTS + 2, 0);
+
+    for (uint32_t i = 0; i <= CONFIG_CMDPROCESSOR_COALESCE_SLOTS; i++)
+    {
+        EXPECT_EQ(RETCODE_OK, CmdProcessor_EnqueueToLane(&cmdProcessor, CMDPROCESSOR_LANE_NORMAL, true, recordingFn, &contexts[i], i));
+    }
+    /* The last one is not tracked, so it is queued again */
+    EXPECT_EQ(RETCODE_OK, CmdProcessor_EnqueueToLane(&cmdProcessor, CMDPROCESSOR_LANE_NORMAL, true, recordingFn, &contexts[CONFIG_CMDPROCESSOR_COALESCE_SLOTS], 0));
+    EXPECT_EQ(RETCODE_OK, CmdProcessor_EnqueueToLane(&cmdProcessor, CMDPROCESSOR_LANE_NORMAL, true, recordingFn, &contexts[0], 0));
+
+    EXPECT_EQ((uint32_t)CONFIG_CMDPROCESSOR_COALESCE_SLOTS + 2U, xQueueSend_fake.call_count);
+}
+
+TEST_F(CmdProcessor, CmdProcessorTimerInvalidParam)
+{
+    CmdProcessor_Timer_T timer = {0};
+    CmdProcessor_T uninitialized = {0};
+
+    EXPECT_EQ(RETCODE_INVALID_PARAM, Retcode_GetCode(CmdProcessor_EnqueueDelayed(NULL, &timer, timerFn, NULL, 0, 10)));
+    EXPECT_EQ(RETCODE_INVALID_PARAM, Retcode_GetCode(CmdProcessor_EnqueueDelayed(&cmdProcessor, NULL, timerFn, NULL, 0, 10)));
+    EXPECT_EQ(RETCODE_INVALID_PARAM, Retcode_GetCode(CmdProcessor_EnqueueDelayed(&cmdProcessor, &timer, NULL, NULL, 0, 10)));
+    EXPECT_EQ(RETCODE_INVALID_PARAM, Retcode_GetCode(CmdProcessor_EnqueuePeriodic(&uninitialized, &timer, timerFn, NULL, 0, 10)));
+    EXPECT_EQ(RETCODE_INVALID_PARAM, Retcode_GetCode(CmdProcessor_CancelTimer(&cmdProcessor, NULL)));
+    EXPECT_EQ(RETCODE_INVALID_PARAM, Retcode_GetCode(CmdProcessor_CancelTimer(NULL, &timer)));
+    EXPECT_EQ(NULL, timer.pprev);
+}
+
+TEST_F(CmdProcessor, CmdProcessorTimerDelayed)
+{
+    CmdProcessor_Timer_T timer = {0};
+    xTaskGetTickCount_fake.return_val = 100;
+
+    EXPECT_EQ(RETCODE_OK, CmdProcessor_EnqueueDelayed(&cmdProcessor, &timer, timerFn, NULL, 7, 10));
+
+    EXPECT_EQ(10U, TimerRun(&cmdProcessor));
+    xTaskGetTickCount_fake.return_val = 109;
+    EXPECT_EQ(1U, TimerRun(&cmdProcessor));
+    EXPECT_TRUE(timerRuns.empty());
+
+    xTaskGetTickCount_fake.return_val = 110;
+    EXPECT_EQ(portMAX_DELAY, TimerRun(&cmdProcessor));
+
+    std::vector<std::pair<uint32_t, TickType_t>> expected = {{7, 110}};
+    EXPECT_EQ(expected, timerRuns);
+    EXPECT_EQ(NULL, timer.pprev);
+    EXPECT_EQ(HAL_CriticalSection_Enter_fake.call_count, HAL_CriticalSection_Leave_fake.call_count);
+}
+
+TEST_F(CmdProcessor, CmdProcessorTimerPeriodic)
+{
+    CmdProcessor_Timer_T timer = {0};
+
+    EXPECT_EQ(RETCODE_OK, CmdProcessor_EnqueuePeriodic(&cmdProcessor, &timer, timerFn, NULL, 1, 5));
+
+    /* The task only wakes up for the runs */
+    EXPECT_EQ(10U, RunTimersUntil(50));
+
+    ASSERT_EQ(10U, timerRuns.size());
+    for (uint32_t i = 0; i < timerRuns.size(); i++)
+    {
+        EXPECT_EQ(5U * (i + 1U), timerRuns[i].second);
+    }
+}
+
+TEST_F(CmdProcessor, CmdProcessorTimerPeriodicSkipsMissedRuns)
+{
+    CmdProcessor_Timer_T timer = {0};
+
+    EXPECT_EQ(RETCODE_OK, CmdProcessor_EnqueuePeriodic(&cmdProcessor, &timer, timerFn, NULL, 1, 10));
+
+    /* Busy for three periods */
+    xTaskGetTickCount_fake.return_val = 35;
+    (void)TimerRun(&cmdProcessor);
+
+    EXPECT_EQ(1U, timerRuns.size());
+    (void)RunTimersUntil(60);
+
+    std::vector<std::pair<uint32_t, TickType_t>> expected = {{1, 35}, {1, 40}, {1, 50}, {1, 60}};
+    EXPECT_EQ(expected, timerRuns);
+}
+
+TEST_F(CmdProcessor, CmdProcessorTimerBeyondWheel)
+{
+    CmdProcessor_Timer_T timer = {0};
+    uint32_t wakeUps;
+
+    EXPECT_EQ(RETCODE_OK, CmdProcessor_EnqueueDelayed(&cmdProcessor, &timer, timerFn, NULL, 1, 100000));
+
+    wakeUps = RunTimersUntil(200000);
+
+    std::vector<std::pair<uint32_t, TickType_t>> expected = {{1, 100000}};
+    EXPECT_EQ(expected, timerRuns);
+    /* Once per turn of the wheel, to place the timer again */
+    EXPECT_GE(100000U / TIMER_RANGE + CMDPROCESSOR_TIMER_LEVELS + 1U, wakeUps);
+}
+
+TEST_F(CmdProcessor, CmdProcessorTimerMany)
+{
+    const uint32_t count = 300;
+    CmdProcessor_Timer_T timers[count];
+    TickType_t deadlines[count];
+    memset(timers, 0, sizeof(timers));
+    xTaskGetTickCount_fake.return_val = 1000;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        deadlines[i] = 1000U + ((i * 7919U) % 20000U);
+        EXPECT_EQ(RETCODE_OK, CmdProcessor_EnqueueDelayed(&cmdProcessor, &timers[i], timerFn, NULL, i, deadlines[i] - 1000U));
+    }
+
+    (void)RunTimersUntil(30000);
+
+    ASSERT_EQ((size_t)count, timerRuns.size());
+    for (uint32_t i = 0; i < count; i++)
+    {
+        EXPECT_EQ(deadlines[timerRuns[i].first], timerRuns[i].second);
+        if (0U != i)
+        {
+            EXPECT_LE(timerRuns[i - 1U].second, timerRuns[i].second);
+        }
+    }
+    for (uint32_t level = 0; level < CMDPROCESSOR_TIMER_LEVELS; level++)
+    {
+        EXPECT_EQ(0U, cmdProcessor.timers.occupied[level]);
+    }
+}
+
+TEST_F(CmdProcessor, CmdProcessorTimerCancel)
+{
+    CmdProcessor_Timer_T timers[3];
+    memset(timers, 0, sizeof(timers));
+
+    for (uint32_t i = 0; i < 3U; i++)
+    {
+        EXPECT_EQ(RETCODE_OK, CmdProcessor_EnqueuePeriodic(&cmdProcessor, &timers[i], timerFn, NULL, i, 20));
+    }
+    EXPECT_EQ(RETCODE_OK, CmdProcessor_CancelTimer(&cmdProcessor, &timers[1]));
+    EXPECT_EQ(RETCODE_OK, CmdProcessor_CancelTimer(&cmdProcessor, &timers[1]));
+
+    (void)RunTimersUntil(20);
+
+    /* Timers due at the same tick run in any order */
+    std::sort(timerRuns.begin(), timerRuns.end());
+    std::vector<std::pair<uint32_t, TickType_t>> expected = {{0, 20}, {2, 20}};
+    EXPECT_EQ(expected, timerRuns);
+
+    EXPECT_EQ(RETCODE_OK, CmdProcessor_CancelTimer(&cmdProcessor, &timers[0]));
+    EXPECT_EQ(RETCODE_OK, CmdProcessor_CancelTimer(&cmdProcessor, &timers[2]));
+    EXPECT_EQ(portMAX_DELAY, TimerRun(&cmdProcessor));
+    EXPECT_EQ(0U, cmdProcessor.timers.occupied[0] | cmdProcessor.timers.occupied[1] | cmdProcessor.timers.occupied[2]);
+}
+
+TEST_F(CmdProcessor, CmdProcessorTimerReschedule)
+{
+    CmdProcessor_Timer_T timer = {0};
+
+    EXPECT_EQ(RETCODE_OK, CmdProcessor_EnqueueDelayed(&cmdProcessor, &timer, timerFn, NULL, 1, 500));
+    EXPECT_EQ(RETCODE_OK, CmdProcessor_EnqueueDelayed(&cmdProcessor, &timer, timerFn, NULL, 2, 10));
+
+    (void)RunTimersUntil(1000);
+
+    std::vector<std::pair<uint32_t, TickType_t>> expected = {{2, 10}};
+    EXPECT_EQ(expected, timerRuns);
+}
+
+TEST_F(CmdProcessor, CmdProcessorTimerScheduledByTimer)
+{
+    EXPECT_EQ(RETCODE_OK, CmdProcessor_EnqueueDelayed(&cmdProcessor, &selfTimer, selfSchedulingFn, NULL, 2, 0));
+
+    /* A timer scheduled by a running one waits for the next tick */
+    EXPECT_EQ(1U, TimerRun(&cmdProcessor));
+    (void)RunTimersUntil(10);
+
+    std::vector<std::pair<uint32_t, TickType_t>> expected = {{2, 0}, {1, 1}, {0, 2}};
+    EXPECT_EQ(expected, timerRuns);
+}
+
+TEST_F(CmdProcessor, CmdProcessorTimerTickOverflow)
+{
+    CmdProcessor_Timer_T timer = {0};
+    xTaskGetTickCount_fake.return_val = (TickType_t)(0 - 16);
+
+    EXPECT_EQ(RETCODE_OK, CmdProcessor_EnqueueDelayed(&cmdProcessor, &timer, timerFn, NULL, 1, 32));
+
+    (void)RunTimersUntil(100);
+
+    std::vector<std::pair<uint32_t, TickType_t>> expected = {{1, 16}};
+    EXPECT_EQ(expected, timerRuns);
+}
+
+TEST_F(CmdProcessor, CmdProcessorTimerWakesSingleLane)
+{
+    CmdProcessor_Timer_T timers[4];
+    QueueHandle_t queue = (QueueHandle_t)cmdProcessor.queues[CMDPROCESSOR_LANE_NORMAL];
+    memset(timers, 0, sizeof(timers));
+    xQueueSend_fake.custom_fake = myXQueueSend;
+
+    /* Not waiting, nothing to wake */
+    EXPECT_EQ(RETCODE_OK, CmdProcessor_EnqueueDelayed(&cmdProcessor, &timers[0], timerFn, NULL, 0, 10));
+    EXPECT_EQ(UINT32_C(0), xQueueSend_fake.call_count);
+
+    /* Waiting for the timer, a later one does not wake the task, an earlier one does */
+    EXPECT_EQ(10U, TimerRun(&cmdProcessor));
+    EXPECT_EQ(RETCODE_OK, CmdProcessor_EnqueueDelayed(&cmdProcessor, &timers[1], timerFn, NULL, 1, 30));
+    EXPECT_EQ(UINT32_C(0), xQueueSend_fake.call_count);
+    EXPECT_EQ(RETCODE_OK, CmdProcessor_EnqueueDelayed(&cmdProcessor, &timers[2], timerFn, NULL, 2, 5));
+    EXPECT_EQ(UINT32_C(1), xQueueSend_fake.call_count);
+    EXPECT_EQ(queue, xQueueSend_fake.arg0_val);
+    EXPECT_EQ(0U, xQueueSend_fake.arg2_val);
+    EXPECT_EQ(RETCODE_OK, CmdProcessor_EnqueueDelayed(&cmdProcessor, &timers[3], timerFn, NULL, 3, 1));
+    EXPECT_EQ(UINT32_C(1), xQueueSend_fake.call_count);
+
+    /* The wake-up command does nothing */
+    ASSERT_EQ(1U, laneQueues[queue].size());
+    Execute(&cmdProcessor, &laneQueues[queue].front());
+    EXPECT_TRUE(timerRuns.empty());
+    EXPECT_EQ(UINT32_C(0), Retcode_RaiseError_fake.call_count);
+}
+
+TEST_F(CmdProcessor, CmdProcessorTimerWakesLanes)
+{
+    CmdProcessor_Timer_T timer = {0};
+    InitializeLanes(2, 2, 2);
+
+    EXPECT_EQ(portMAX_DELAY, TimerRun(&cmdProcessor));
+    EXPECT_EQ(RETCODE_OK, CmdProcessor_EnqueuePeriodic(&cmdProcessor, &timer, timerFn, NULL, 0, 100));
+
+    EXPECT_EQ(UINT32_C(1), xTaskNotifyGive_fake.call_count);
+    EXPECT_EQ((TaskHandle_t)0x123, xTaskNotifyGive_fake.arg0_val);
+    EXPECT_EQ(UINT32_C(0), xQueueSend_fake.call_count);
+}
+
+TEST_F(CmdProcessor, CmdProcessorDequeueWaitsForTimer)
+{
+    CmdProcessor_Timer_T timer = {0};
+    xQueueReceive_fake.return_val = errQUEUE_EMPTY;
+    EXPECT_EQ(RETCODE_OK, CmdProcessor_EnqueueDelayed(&cmdProcessor, &timer, timerFn, NULL, 0, 12));
+
+    Dequeue(&cmdProcessor);
+
+    EXPECT_EQ(UINT32_C(1), xQueueReceive_fake.call_count);
+    EXPECT_EQ(12U, xQueueReceive_fake.arg2_val);
+    EXPECT_FALSE(cmdProcessor.timers.isSleeping);
+    EXPECT_EQ(UINT32_C(0), Retcode_RaiseError_fake.call_count);
+
+    /* The timeout runs the timer */
+    xTaskGetTickCount_fake.return_val = 12;
+    Dequeue(&cmdProcessor);
+
+    EXPECT_EQ(1U, timerRuns.size());
+    EXPECT_EQ(portMAX_DELAY, xQueueReceive_fake.arg2_val);
+}
+
+TEST_F(CmdProcessor, CmdProcessorDequeueLanesWaitForTimer)
+{
+    CmdProcessor_Timer_T timer = {0};
+    InitializeLanes(2, 2, 2);
+    EXPECT_EQ(RETCODE_OK, CmdProcessor_EnqueuePeriodic(&cmdProcessor, &timer, timerFn, NULL, 0, 14));
+
+    Dequeue(&cmdProcessor);
+
+    EXPECT_EQ(UINT32_C(1), ulTaskNotifyTake_fake.call_count);
+    EXPECT_EQ(14U, ulTaskNotifyTake_fake.arg1_val);
+
+    xTaskGetTickCount_fake.return_val = 14;
+    Dequeue(&cmdProcessor);
+
+    EXPECT_EQ(1U, timerRuns.size());
+    EXPECT_EQ(14U, ulTaskNotifyTake_fake.arg1_val);
+}
 #else
 }
 
@@ -0,0 +1,101 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ *
+ * @brief
+ *      Module test specification for the EventHub module created in storage given by the caller.
+ *
+ * @detail
+ *      The unit test file template follows the Four-Phase test pattern.
+ *
+ * @file
+ **/
+
+/* include gtest interface */
+#include <gtest.h>
+
+/* Start of global scope symbol and fake definitions section */
+extern "C"
+{
+/* Setup compile time configuration defines */
+#define KISO_UTILS_STATIC_ALLOCATION 1
+
+/* Module includes */
+#include "Kiso_Utils.h"
+#undef KISO_MODULE_ID
+#define KISO_MODULE_ID KISO_UTILS_MODULE_ID_EVENTHUB
+
+#if KISO_FEATURE_EVENTHUB
+
+/* include faked interfaces */
+#include "Kiso_Retcode_th.hh"
+#include "Kiso_Assert_th.hh"
+
+#include "task_th.hh"
+#include "fff.h"
+
+#include "queue_th.hh"
+#include "semphr_th.hh"
+#include "timers_th.hh"
+#include "portmacro_th.hh"
+#include "Kiso_HAL_CriticalSection_th.hh"
+#include "Kiso_CmdProcessor_th.hh"
+
+/* Include module under test */
+#include "EventHub.c"
+
+} /* End of global scope symbol and fake definitions section */
+
+class EventHubStatic : public testing::Test
+{
+protected:
+    EventHub_T Hub;
+    EventHub_Storage_T Storage;
+
+    virtual void SetUp()
+    {
+        RESET_FAKE(xSemaphoreCreateMutex);
+        RESET_FAKE(xSemaphoreCreateMutexStatic);
+        FFF_RESET_HISTORY();
+
+        memset(&Hub, 0xFF, sizeof(Hub));
+        xSemaphoreCreateMutexStatic_fake.return_val = (SemaphoreHandle_t)0x10;
+    }
+};
+
+/* specify test cases ******************************************************* */
+
+TEST_F(EventHubStatic, InitializeInStorage)
+{
+    Retcode_T retcode = EventHub_InitializeStatic(&Hub, &Storage);
+
+    EXPECT_EQ(RETCODE_OK, retcode);
+    EXPECT_EQ(UINT32_C(1), xSemaphoreCreateMutexStatic_fake.call_count);
+    EXPECT_EQ(&Storage.lock, xSemaphoreCreateMutexStatic_fake.arg0_val);
+    EXPECT_EQ(UINT32_C(0), xSemaphoreCreateMutex_fake.call_count);
+    EXPECT_EQ((void *)0x10, Hub.lock);
+    EXPECT_EQ(UINT32_C(0), Hub.observerCount);
+}
+
+TEST_F(EventHubStatic, InitializeNullPointer)
+{
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), EventHub_InitializeStatic(&Hub, NULL));
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), EventHub_InitializeStatic(NULL, &Storage));
+    EXPECT_EQ(UINT32_C(0), xSemaphoreCreateMutexStatic_fake.call_count);
+}
+
+#else
+}
+#endif /* if KISO_FEATURE_EVENTHUB */
@@ -45,12 +45,18 @@ extern "C"
 
 #include "queue_th.hh"
 #include "semphr_th.hh"
+#include "timers_th.hh"
+#include "portmacro_th.hh"
+#include "Kiso_HAL_CriticalSection_th.hh"
+#include "Kiso_CmdProcessor_th.hh"
 
 /* Include module under test */
 #include "EventHub.c"
 
 } /* End of global scope symbol and fake definitions section */
 
+#include <vector>
+
 #if (CONFIG_EVENTHUB_MAX_OBSERVERS <= 0)
 #error "CONFIG_EVENTHUB_MAX_OBSERVERS must not be less or equal to 0"
 #endif
@@ -93,6 +99,52 @@ void TestObserver_All(TaskEvent_T event, const void *data)
     dataCorrect_All = (gTestDataPtr == data);
 }
 
+/* Observers recording the order of their calls */
+std::vector<char> callOrder;
+std::vector<TaskEvent_T> callEvents;
+std::vector<const void *> callData;
+
+void TestRecorder_A(TaskEvent_T event, const void *data)
+{
+    callOrder.push_back('A');
+    callEvents.push_back(event);
+    callData.push_back(data);
+}
+
+void TestRecorder_B(TaskEvent_T event, const void *data)
+{
+    callOrder.push_back('B');
+    callEvents.push_back(event);
+    callData.push_back(data);
+}
+
+void TestRecorder_All(TaskEvent_T event, const void *data)
+{
+    callOrder.push_back('*');
+    callEvents.push_back(event);
+    callData.push_back(data);
+}
+
+/* Commands enqueued in the fake command processor */
+struct QueuedCmd_S
+{
+    CmdProcessor_Func_T func;
+    void *param1;
+    uint32_t param2;
+};
+std::vector<QueuedCmd_S> queuedCmds;
+
+Retcode_T CmdProcessor_EnqueueCustom(CmdProcessor_T *cmdProcessor, CmdProcessor_Func_T func, void *param1, uint32_t param2)
+{
+    KISO_UNUSED(cmdProcessor);
+    queuedCmds.push_back({func, param1, param2});
+    return RETCODE_OK;
+}
+
+static CmdProcessor_T testCmdProcessor;
+static const uint32_t gTestData2 = 0xCC;
+static const uint32_t gTestData3 = 0xDD;
+
 class EventHubTest : public testing::Test
 {
 protected:
@@ -102,8 +154,54 @@ protected:
         RESET_FAKE(xSemaphoreCreateMutex);
         RESET_FAKE(xSemaphoreTake);
         RESET_FAKE(xSemaphoreGive);
+        RESET_FAKE(xTimerPendFunctionCallFromISR);
+        RESET_FAKE(HAL_CriticalSection_Enter);
+        RESET_FAKE(HAL_CriticalSection_Leave);
+        RESET_FAKE(CmdProcessor_Enqueue);
+        RESET_FAKE(xTaskGetTickCount);
 
         FFF_RESET_HISTORY();
+
+        callOrder.clear();
+        callEvents.clear();
+        callData.clear();
+        queuedCmds.clear();
+        CmdProcessor_Enqueue_fake.custom_fake = CmdProcessor_EnqueueCustom;
+    }
+
+    /* Runs the commands enqueued in the fake command processor, in order */
+    void RunQueuedCmds(void)
+    {
+        std::vector<QueuedCmd_S> cmds;
+        cmds.swap(queuedCmds);
+        for (auto &cmd : cmds)
+        {
+            cmd.func(cmd.param1, cmd.param2);
+        }
+    }
+
+    EventHubAsyncStatistics_T GetStatistics(EventHub_T *hub, bool isReset = false)
+    {
+        EventHubAsyncStatistics_T statistics;
+        EXPECT_EQ(RETCODE_OK, EventHub_GetAsyncStatistics(hub, &statistics, isReset));
+        return statistics;
+    }
+
+    /* Initializes the hub with working fakes */
+    void InitializeHub(EventHub_T *hub)
+    {
+        xSemaphoreCreateMutex_fake.return_val = (SemaphoreHandle_t)1;
+        xSemaphoreTake_fake.return_val = (uint32_t)1;
+        xSemaphoreGive_fake.return_val = (uint32_t)1;
+        xTimerPendFunctionCallFromISR_fake.return_val = pdPASS;
+        ASSERT_EQ(RETCODE_OK, EventHub_Initialize(hub));
+    }
+
+    /* Runs the delivery which the last EventHub_NotifyFromIsr() handed to the timer service task */
+    void RunPendedDelivery(void)
+    {
+        ASSERT_NE((PendedFunction_t)NULL, xTimerPendFunctionCallFromISR_fake.arg0_val);
+        xTimerPendFunctionCallFromISR_fake.arg0_val(xTimerPendFunctionCallFromISR_fake.arg1_val, xTimerPendFunctionCallFromISR_fake.arg2_val);
     }
 };
 
@@ -227,6 +325,7 @@ TEST_F(EventHubTest, EventHubObserverNotNullHubObserverCount)
     xSemaphoreCreateMutex_fake.return_val = (SemaphoreHandle_t)1;
     xSemaphoreTake_fake.return_val = (uint32_t)1;
     xSemaphoreGive_fake.return_val = (uint32_t)1;
+    eventHub.lock = (SemaphoreHandle_t)1;
     eventHub.observerCount = CONFIG_EVENTHUB_MAX_OBSERVERS;
 
     retVal = EventHub_Observe(&eventHub, TestObserver_A, (TaskEvent_T)gTestEvent);
@@ -519,44 +618,353 @@ TEST_F(EventHubTest, EventHubNotifyHubLockNull)
     EXPECT_EQ(RETCODE_UNINITIALIZED, Retcode_GetCode(retVal));
 }
 
-TEST_F(EventHubTest, EventHubNotifySemTakeNotPass)
+TEST_F(EventHubTest, EventHubNotifyWithoutLock)
 {
-    /** @testcase{ eventHub::EventHubNotifySemTakeNotPass: }
-     * Test EventHub notify failures
+    /** @testcase{ eventHub::EventHubNotifyWithoutLock: }
+     * Test EventHub notify does not take the hub lock
      */
     EventHub_T eventHub;
-    Retcode_T retVal = RETCODE_OK;
+    Retcode_T retVal = RETCODE_FAILURE;
     eventReceived_A = false;
-    eventHub.observerCount = 0;
-    xSemaphoreTake_fake.return_val = (uint32_t)1;
+    InitializeHub(&eventHub);
+    (void)EventHub_Observe(&eventHub, TestObserver_A, (TaskEvent_T)gTestEvent);
+    xSemaphoreTake_fake.return_val = (uint32_t)0;
+    xSemaphoreGive_fake.return_val = (uint32_t)0;
 
-    retVal = EventHub_Notify(&eventHub, (TaskEvent_T)gTestEvent, NULL);
+    retVal = EventHub_Notify(&eventHub, (TaskEvent_T)gTestEvent, gTestDataPtr);
 
-    EXPECT_NE(RETCODE_UNINITIALIZED, Retcode_GetCode(retVal));
-    EXPECT_NE(RETCODE_NULL_POINTER, Retcode_GetCode(retVal));
-    EXPECT_EQ(RETCODE_SEMAPHORE_ERROR, Retcode_GetCode(retVal));
-    EXPECT_NE(true, eventReceived_A);
+    EXPECT_EQ(RETCODE_OK, Retcode_GetCode(retVal));
+    EXPECT_EQ(true, eventReceived_A);
     EXPECT_EQ(UINT32_C(1), xSemaphoreTake_fake.call_count);
+    EXPECT_EQ(UINT32_C(1), xSemaphoreGive_fake.call_count);
 }
 
-TEST_F(EventHubTest, EventHubNotifySemGiveNotPass)
+TEST_F(EventHubTest, EventHubNotifyOnlyObserversOfEvent)
 {
-    /** @testcase{ eventHub::EventHubNotifySemGiveNotPass: }
-     * Test EventHub notify failures
+    /** @testcase{ eventHub::EventHubNotifyOnlyObserversOfEvent: }
+     * Test EventHub notify skips the observers of other events, also within the same bucket
      */
     EventHub_T eventHub;
-    Retcode_T retVal = RETCODE_OK;
-    eventHub.observerCount = 0;
-    xSemaphoreTake_fake.return_val = (uint32_t)1;
-    xSemaphoreGive_fake.return_val = (uint32_t)0;
+    const TaskEvent_T sameBucketEvent = gTestEvent + CONFIG_EVENTHUB_EVENT_BUCKETS;
+    InitializeHub(&eventHub);
+    ASSERT_EQ(EventHub_GetList(&eventHub, gTestEvent, false), EventHub_GetList(&eventHub, sameBucketEvent, false));
+    (void)EventHub_Observe(&eventHub, TestRecorder_A, gTestEvent);
+    (void)EventHub_Observe(&eventHub, TestRecorder_B, sameBucketEvent);
+
+    EXPECT_EQ(RETCODE_OK, EventHub_Notify(&eventHub, sameBucketEvent, NULL));
+    EXPECT_EQ(RETCODE_OK, EventHub_Notify(&eventHub, gTestEvent + 1U, NULL));
+
+    ASSERT_EQ(1U, callOrder.size());
+    EXPECT_EQ('B', callOrder[0]);
+    EXPECT_EQ(sameBucketEvent, callEvents[0]);
+}
 
-    retVal = EventHub_Notify(&eventHub, (TaskEvent_T)gTestEvent, NULL);
+TEST_F(EventHubTest, EventHubNotifyOrder)
+{
+    /** @testcase{ eventHub::EventHubNotifyOrder: }
+     * Test EventHub notify calls the observers of the event in the order of registration, then the observers of all events
+     */
+    EventHub_T eventHub;
+    InitializeHub(&eventHub);
+    (void)EventHub_ObserveAll(&eventHub, TestRecorder_All);
+    (void)EventHub_Observe(&eventHub, TestRecorder_B, gTestEvent);
+    (void)EventHub_Observe(&eventHub, TestRecorder_A, gTestEvent);
+
+    EXPECT_EQ(RETCODE_OK, EventHub_Notify(&eventHub, gTestEvent, NULL));
+    EXPECT_EQ(RETCODE_OK, EventHub_Notify(&eventHub, gTestEvent + 1U, NULL));
+
+    std::vector<char> expectedOrder = {'B', 'A', '*', '*'};
+    std::vector<TaskEvent_T> expectedEvents = {gTestEvent, gTestEvent, gTestEvent, gTestEvent + 1U};
+    EXPECT_EQ(expectedOrder, callOrder);
+    EXPECT_EQ(expectedEvents, callEvents);
+    EXPECT_EQ(UINT32_C(3), eventHub.observerCount);
+}
 
-    EXPECT_NE(RETCODE_NULL_POINTER, Retcode_GetCode(retVal));
-    EXPECT_NE(RETCODE_UNINITIALIZED, Retcode_GetCode(retVal));
-    EXPECT_EQ(RETCODE_SEMAPHORE_ERROR, Retcode_GetCode(retVal));
-    EXPECT_NE(true, eventReceived_A);
-    EXPECT_EQ(UINT32_C(1), xSemaphoreGive_fake.call_count);
+TEST_F(EventHubTest, EventHubNotifyFromIsrFailure)
+{
+    /** @testcase{ eventHub::EventHubNotifyFromIsrFailure: }
+     * Test EventHub notify from interrupt failures
+     */
+    EventHub_T eventHub;
+    memset(&eventHub, 0, sizeof(eventHub));
+
+    EXPECT_EQ(RETCODE_NULL_POINTER, Retcode_GetCode(EventHub_NotifyFromIsr(NULL, gTestEvent, NULL)));
+    EXPECT_EQ(RETCODE_UNINITIALIZED, Retcode_GetCode(EventHub_NotifyFromIsr(&eventHub, gTestEvent, NULL)));
+    EXPECT_EQ(UINT32_C(0), xTimerPendFunctionCallFromISR_fake.call_count);
+}
+
+TEST_F(EventHubTest, EventHubNotifyFromIsrDeferred)
+{
+    /** @testcase{ eventHub::EventHubNotifyFromIsrDeferred: }
+     * Test EventHub notify from interrupt delivers in the timer service task, in order
+     */
+    EventHub_T eventHub;
+    InitializeHub(&eventHub);
+    (void)EventHub_Observe(&eventHub, TestRecorder_A, gTestEvent);
+    (void)EventHub_ObserveAll(&eventHub, TestRecorder_All);
+
+    EXPECT_EQ(RETCODE_OK, EventHub_NotifyFromIsr(&eventHub, gTestEvent, gTestDataPtr));
+    EXPECT_EQ(RETCODE_OK, EventHub_NotifyFromIsr(&eventHub, gTestEvent + 1U, gTestDataPtr));
+
+    /* Nothing is called in the interrupt, one delivery is pended for both */
+    EXPECT_EQ(0U, callOrder.size());
+    EXPECT_EQ(UINT32_C(1), xTimerPendFunctionCallFromISR_fake.call_count);
+    EXPECT_EQ((void *)&eventHub, xTimerPendFunctionCallFromISR_fake.arg1_val);
+    EXPECT_EQ(HAL_CriticalSection_Enter_fake.call_count, HAL_CriticalSection_Leave_fake.call_count);
+
+    RunPendedDelivery();
+
+    std::vector<char> expectedOrder = {'A', '*', '*'};
+    std::vector<TaskEvent_T> expectedEvents = {gTestEvent, gTestEvent, gTestEvent + 1U};
+    EXPECT_EQ(expectedOrder, callOrder);
+    EXPECT_EQ(expectedEvents, callEvents);
+    EXPECT_EQ(0U, eventHub.deferredCount);
+    EXPECT_FALSE(eventHub.isDeliveryPending);
+    EXPECT_EQ(HAL_CriticalSection_Enter_fake.call_count, HAL_CriticalSection_Leave_fake.call_count);
+
+    /* The next notification pends a new delivery */
+    EXPECT_EQ(RETCODE_OK, EventHub_NotifyFromIsr(&eventHub, gTestEvent, gTestDataPtr));
+    EXPECT_EQ(UINT32_C(2), xTimerPendFunctionCallFromISR_fake.call_count);
+}
+
+TEST_F(EventHubTest, EventHubNotifyFromIsrQueueFull)
+{
+    /** @testcase{ eventHub::EventHubNotifyFromIsrQueueFull: }
+     * Test EventHub notify from interrupt drops notifications beyond the queue size
+     */
+    EventHub_T eventHub;
+    InitializeHub(&eventHub);
+    (void)EventHub_ObserveAll(&eventHub, TestRecorder_All);
+
+    for (uint32_t i = 0; i < CONFIG_EVENTHUB_ISR_QUEUE_SIZE; ++i)
+    {
+        EXPECT_EQ(RETCODE_OK, EventHub_NotifyFromIsr(&eventHub, i, NULL));
+    }
+    EXPECT_EQ(RETCODE_OUT_OF_RESOURCES, Retcode_GetCode(EventHub_NotifyFromIsr(&eventHub, gTestEvent, NULL)));
+
+    RunPendedDelivery();
+
+    EXPECT_EQ((size_t)CONFIG_EVENTHUB_ISR_QUEUE_SIZE, callEvents.size());
+    EXPECT_EQ((TaskEvent_T)(CONFIG_EVENTHUB_ISR_QUEUE_SIZE - 1), callEvents.back());
+}
+
+TEST_F(EventHubTest, EventHubNotifyFromIsrPendFails)
+{
+    /** @testcase{ eventHub::EventHubNotifyFromIsrPendFails: }
+     * Test EventHub notify from interrupt keeps the notification if the timer command queue is full
+     */
+    EventHub_T eventHub;
+    InitializeHub(&eventHub);
+    (void)EventHub_Observe(&eventHub, TestRecorder_A, gTestEvent);
+    xTimerPendFunctionCallFromISR_fake.return_val = pdFAIL;
+
+    EXPECT_EQ(RETCODE_FAILURE, Retcode_GetCode(EventHub_NotifyFromIsr(&eventHub, gTestEvent, NULL)));
+    EXPECT_FALSE(eventHub.isDeliveryPending);
+
+    xTimerPendFunctionCallFromISR_fake.return_val = pdPASS;
+    EXPECT_EQ(RETCODE_OK, EventHub_NotifyFromIsr(&eventHub, gTestEvent, NULL));
+    EXPECT_EQ(UINT32_C(2), xTimerPendFunctionCallFromISR_fake.call_count);
+
+    RunPendedDelivery();
+
+    std::vector<char> expectedOrder = {'A', 'A'};
+    EXPECT_EQ(expectedOrder, callOrder);
+}
+
+TEST_F(EventHubTest, EventHubObserveAsyncFailure)
+{
+    /** @testcase{ eventHub::EventHubObserveAsyncFailure: }
+     * Test EventHub observe with a command processor failures
+     */
+    EventHub_T eventHub;
+    EventHubAsyncStatistics_T statistics;
+    InitializeHub(&eventHub);
+
+    EXPECT_EQ(RETCODE_NULL_POINTER, Retcode_GetCode(EventHub_ObserveAsync(&eventHub, TestRecorder_A, gTestEvent, NULL, false)));
+    EXPECT_EQ(RETCODE_NULL_POINTER, Retcode_GetCode(EventHub_ObserveAsync(&eventHub, NULL, gTestEvent, &testCmdProcessor, false)));
+    EXPECT_EQ(RETCODE_NULL_POINTER, Retcode_GetCode(EventHub_ObserveAllAsync(&eventHub, TestRecorder_A, NULL, false)));
+    EXPECT_EQ(RETCODE_NULL_POINTER, Retcode_GetCode(EventHub_ObserveAllAsync(NULL, TestRecorder_A, &testCmdProcessor, false)));
+    EXPECT_EQ(RETCODE_NULL_POINTER, Retcode_GetCode(EventHub_GetAsyncStatistics(NULL, &statistics, false)));
+    EXPECT_EQ(RETCODE_NULL_POINTER, Retcode_GetCode(EventHub_GetAsyncStatistics(&eventHub, NULL, false)));
+    EXPECT_EQ(UINT32_C(0), eventHub.observerCount);
+}
+
+TEST_F(EventHubTest, EventHubNotifyAsync)
+{
+    /** @testcase{ eventHub::EventHubNotifyAsync: }
+     * Test EventHub notify calls an asynchronous observer in its command processor
+     */
+    EventHub_T eventHub;
+    InitializeHub(&eventHub);
+    EXPECT_EQ(RETCODE_OK, EventHub_ObserveAsync(&eventHub, TestRecorder_A, gTestEvent, &testCmdProcessor, false));
+    EXPECT_EQ(RETCODE_OK, EventHub_Observe(&eventHub, TestRecorder_B, gTestEvent));
+
+    EXPECT_EQ(RETCODE_OK, EventHub_Notify(&eventHub, gTestEvent, gTestDataPtr));
+
+    /* Only the synchronous observer is called by the notifying task */
+    std::vector<char> expectedOrder = {'B'};
+    EXPECT_EQ(expectedOrder, callOrder);
+    ASSERT_EQ(UINT32_C(1), CmdProcessor_Enqueue_fake.call_count);
+    EXPECT_EQ(&testCmdProcessor, CmdProcessor_Enqueue_fake.arg0_val);
+    EXPECT_EQ(UINT8_C(1), GetStatistics(&eventHub).depth);
+
+    RunQueuedCmds();
+
+    expectedOrder = {'B', 'A'};
+    EXPECT_EQ(expectedOrder, callOrder);
+    EXPECT_EQ(gTestEvent, callEvents[1]);
+    EXPECT_EQ(gTestDataPtr, callData[1]);
+    EventHubAsyncStatistics_T statistics = GetStatistics(&eventHub);
+    EXPECT_EQ(UINT32_C(1), statistics.delivered);
+    EXPECT_EQ(UINT8_C(0), statistics.depth);
+    EXPECT_EQ(UINT8_C(1), statistics.depthMax);
+    EXPECT_EQ(HAL_CriticalSection_Enter_fake.call_count, HAL_CriticalSection_Leave_fake.call_count);
+}
+
+TEST_F(EventHubTest, EventHubNotifyAsyncCoalesced)
+{
+    /** @testcase{ eventHub::EventHubNotifyAsyncCoalesced: }
+     * Test EventHub notify merges consecutive notifications of the same event for a coalescing observer
+     */
+    EventHub_T eventHub;
+    InitializeHub(&eventHub);
+    (void)EventHub_ObserveAsync(&eventHub, TestRecorder_A, gTestEvent, &testCmdProcessor, true);
+    (void)EventHub_ObserveAllAsync(&eventHub, TestRecorder_All, &testCmdProcessor, true);
+
+    EXPECT_EQ(RETCODE_OK, EventHub_Notify(&eventHub, gTestEvent, gTestDataPtr));
+    EXPECT_EQ(RETCODE_OK, EventHub_Notify(&eventHub, gTestEvent, &gTestData2));
+    EXPECT_EQ(RETCODE_OK, EventHub_Notify(&eventHub, gTestEvent + 1U, gTestDataPtr));
+    EXPECT_EQ(RETCODE_OK, EventHub_Notify(&eventHub, gTestEvent, &gTestData3));
+
+    /* The observer of all events saw another event in between */
+    EXPECT_EQ(UINT32_C(4), CmdProcessor_Enqueue_fake.call_count);
+    EXPECT_EQ(UINT32_C(3), GetStatistics(&eventHub).coalesced);
+
+    RunQueuedCmds();
+
+    std::vector<char> expectedOrder = {'A', '*', '*', '*'};
+    std::vector<TaskEvent_T> expectedEvents = {gTestEvent, gTestEvent, gTestEvent + 1U, gTestEvent};
+    std::vector<const void *> expectedData = {&gTestData3, &gTestData2, gTestDataPtr, &gTestData3};
+    EXPECT_EQ(expectedOrder, callOrder);
+    EXPECT_EQ(expectedEvents, callEvents);
+    EXPECT_EQ(expectedData, callData);
+
+    /* A running delivery is not merged into */
+    EXPECT_EQ(RETCODE_OK, EventHub_Notify(&eventHub, gTestEvent, gTestDataPtr));
+    EXPECT_EQ(UINT32_C(6), CmdProcessor_Enqueue_fake.call_count);
+}
+
+TEST_F(EventHubTest, EventHubNotifyAsyncNotCoalesced)
+{
+    /** @testcase{ eventHub::EventHubNotifyAsyncNotCoalesced: }
+     * Test EventHub notify queues every notification for an observer which does not coalesce
+     */
+    EventHub_T eventHub;
+    InitializeHub(&eventHub);
+    (void)EventHub_ObserveAsync(&eventHub, TestRecorder_A, gTestEvent, &testCmdProcessor, false);
+
+    EXPECT_EQ(RETCODE_OK, EventHub_Notify(&eventHub, gTestEvent, gTestDataPtr));
+    EXPECT_EQ(RETCODE_OK, EventHub_Notify(&eventHub, gTestEvent, &gTestData2));
+
+    RunQueuedCmds();
+
+    std::vector<const void *> expectedData = {gTestDataPtr, &gTestData2};
+    EXPECT_EQ(expectedData, callData);
+    EXPECT_EQ(UINT32_C(0), GetStatistics(&eventHub).coalesced);
+    EXPECT_EQ(UINT8_C(2), GetStatistics(&eventHub).depthMax);
+}
+
+TEST_F(EventHubTest, EventHubNotifyAsyncQueueFull)
+{
+    /** @testcase{ eventHub::EventHubNotifyAsyncQueueFull: }
+     * Test EventHub notify drops asynchronous deliveries beyond the queue size of the hub
+     */
+    EventHub_T eventHub;
+    InitializeHub(&eventHub);
+    (void)EventHub_ObserveAsync(&eventHub, TestRecorder_A, gTestEvent, &testCmdProcessor, false);
+    (void)EventHub_Observe(&eventHub, TestRecorder_B, gTestEvent);
+
+    for (uint32_t i = 0; i < CONFIG_EVENTHUB_ASYNC_QUEUE_SIZE; ++i)
+    {
+        EXPECT_EQ(RETCODE_OK, EventHub_Notify(&eventHub, gTestEvent, NULL));
+    }
+    EXPECT_EQ(RETCODE_OUT_OF_RESOURCES, Retcode_GetCode(EventHub_Notify(&eventHub, gTestEvent, NULL)));
+
+    /* The synchronous observer is still called */
+    EXPECT_EQ((size_t)CONFIG_EVENTHUB_ASYNC_QUEUE_SIZE + 1U, callOrder.size());
+    EventHubAsyncStatistics_T statistics = GetStatistics(&eventHub);
+    EXPECT_EQ(UINT32_C(1), statistics.dropped);
+    EXPECT_EQ((uint8_t)CONFIG_EVENTHUB_ASYNC_QUEUE_SIZE, statistics.depth);
+
+    RunQueuedCmds();
+    EXPECT_EQ(RETCODE_OK, EventHub_Notify(&eventHub, gTestEvent, NULL));
+}
+
+TEST_F(EventHubTest, EventHubNotifyAsyncEnqueueFails)
+{
+    /** @testcase{ eventHub::EventHubNotifyAsyncEnqueueFails: }
+     * Test EventHub notify frees the delivery if the command processor queue is full
+     */
+    EventHub_T eventHub;
+    InitializeHub(&eventHub);
+    (void)EventHub_ObserveAsync(&eventHub, TestRecorder_A, gTestEvent, &testCmdProcessor, true);
+    CmdProcessor_Enqueue_fake.custom_fake = NULL;
+    CmdProcessor_Enqueue_fake.return_val = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_FAILURE);
+
+    EXPECT_EQ(RETCODE_OUT_OF_RESOURCES, Retcode_GetCode(EventHub_Notify(&eventHub, gTestEvent, NULL)));
+
+    EventHubAsyncStatistics_T statistics = GetStatistics(&eventHub);
+    EXPECT_EQ(UINT32_C(1), statistics.dropped);
+    EXPECT_EQ(UINT8_C(0), statistics.depth);
+    EXPECT_EQ(UINT8_C(0), eventHub.observers[0].queuedDelivery);
+    EXPECT_EQ(UINT8_C(0), eventHub.deliveries[0].observer);
+}
+
+TEST_F(EventHubTest, EventHubNotifyAsyncLatency)
+{
+    /** @testcase{ eventHub::EventHubNotifyAsyncLatency: }
+     * Test EventHub measures the latency of asynchronous deliveries
+     */
+    EventHub_T eventHub;
+    InitializeHub(&eventHub);
+    (void)EventHub_ObserveAsync(&eventHub, TestRecorder_A, gTestEvent, &testCmdProcessor, false);
+
+    xTaskGetTickCount_fake.return_val = 100;
+    (void)EventHub_Notify(&eventHub, gTestEvent, NULL);
+    xTaskGetTickCount_fake.return_val = 110;
+    (void)EventHub_Notify(&eventHub, gTestEvent, NULL);
+    xTaskGetTickCount_fake.return_val = 130;
+    RunQueuedCmds();
+
+    EventHubAsyncStatistics_T statistics = GetStatistics(&eventHub, true);
+    EXPECT_EQ(UINT32_C(2), statistics.delivered);
+    EXPECT_EQ(UINT32_C(30), statistics.latencyMax);
+    EXPECT_EQ(UINT32_C(50), statistics.latencyTotal);
+    EXPECT_EQ(UINT8_C(2), statistics.depthMax);
+
+    statistics = GetStatistics(&eventHub);
+    EXPECT_EQ(UINT32_C(0), statistics.delivered);
+    EXPECT_EQ(UINT32_C(0), statistics.latencyMax);
+    EXPECT_EQ(UINT32_C(0), statistics.latencyTotal);
+    EXPECT_EQ(UINT8_C(0), statistics.depthMax);
+}
+
+TEST_F(EventHubTest, EventHubNotifyFromIsrAsync)
+{
+    /** @testcase{ eventHub::EventHubNotifyFromIsrAsync: }
+     * Test EventHub notify from interrupt hands asynchronous observers to their command processor
+     */
+    EventHub_T eventHub;
+    InitializeHub(&eventHub);
+    (void)EventHub_ObserveAsync(&eventHub, TestRecorder_A, gTestEvent, &testCmdProcessor, false);
+
+    EXPECT_EQ(RETCODE_OK, EventHub_NotifyFromIsr(&eventHub, gTestEvent, gTestDataPtr));
+    RunPendedDelivery();
+    EXPECT_EQ(UINT32_C(1), CmdProcessor_Enqueue_fake.call_count);
+    EXPECT_EQ(0U, callOrder.size());
+
+    RunQueuedCmds();
+    EXPECT_EQ(1U, callOrder.size());
 }
 #else
 }
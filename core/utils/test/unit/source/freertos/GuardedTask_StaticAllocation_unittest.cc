@@ -0,0 +1,124 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+/**
+ *
+ * @brief
+ *      Module test specification for the GuardedTask module created in storage given by the caller.
+ *
+ * @detail
+ *      The unit test file template follows the Four-Phase test pattern.
+ *
+ * @file
+ **/
+
+/* Include gtest interface */
+#include <gtest.h>
+
+/* Start of global scope symbol and fake definitions section */
+extern "C"
+{
+/* Setup compile time configuration defines */
+#define KISO_UTILS_STATIC_ALLOCATION 1
+
+#include "Kiso_Utils.h"
+#undef KISO_MODULE_ID
+#define KISO_MODULE_ID KISO_UTILS_MODULE_ID_GUARDEDTASK
+
+#if KISO_FEATURE_GUARDEDTASK
+
+/* Include faked interfaces */
+#include "Kiso_Retcode_th.hh"
+#include "Kiso_Assert_th.hh"
+
+#include "FreeRTOS_th.hh"
+#include "semphr_th.hh"
+#include "queue_th.hh"
+#include "task_th.hh"
+
+/* Include module under test */
+#include "GuardedTask.c"
+
+    /* End of global scope symbol and fake definitions section */
+}
+
+#define STACK_SIZE UINT32_C(128)
+
+static void dummyRunFunction(void)
+{
+}
+
+class guardedTaskStatic : public testing::Test
+{
+protected:
+    GuardedTask_T handleBlock;
+    GuardedTask_Storage_T storage;
+    StackType_t stack[STACK_SIZE];
+
+    virtual void SetUp()
+    {
+        RESET_FAKE(xTaskCreate);
+        RESET_FAKE(xTaskCreateStatic);
+        RESET_FAKE(xSemaphoreCreateBinary);
+        RESET_FAKE(xSemaphoreCreateBinaryStatic);
+        FFF_RESET_HISTORY();
+
+        memset(&handleBlock, 0, sizeof(handleBlock));
+        xTaskCreateStatic_fake.return_val = (TaskHandle_t)0x10;
+        xSemaphoreCreateBinaryStatic_fake.return_val = (SemaphoreHandle_t)0x20;
+    }
+};
+
+/* specify test cases ******************************************************* */
+
+TEST_F(guardedTaskStatic, InitializeInStorage)
+{
+    /** @testcase{ guardedTaskStatic::InitializeInStorage: }
+     *
+     * API is used to check that the task and its semaphore are created in the given storage
+     */
+    Retcode_T retVal = GuardedTask_InitializeStatic(&handleBlock, &dummyRunFunction, "test", 2, STACK_SIZE, stack, &storage);
+
+    EXPECT_EQ(RETCODE_OK, retVal);
+    EXPECT_EQ(UINT32_C(1), xSemaphoreCreateBinaryStatic_fake.call_count);
+    EXPECT_EQ(&storage.signal, xSemaphoreCreateBinaryStatic_fake.arg0_val);
+    EXPECT_EQ(UINT32_C(1), xTaskCreateStatic_fake.call_count);
+    EXPECT_EQ(STACK_SIZE, xTaskCreateStatic_fake.arg2_val);
+    EXPECT_EQ(&handleBlock, xTaskCreateStatic_fake.arg3_val);
+    EXPECT_EQ(UINT32_C(2), xTaskCreateStatic_fake.arg4_val);
+    EXPECT_EQ(stack, xTaskCreateStatic_fake.arg5_val);
+    EXPECT_EQ(&storage.task, xTaskCreateStatic_fake.arg6_val);
+    EXPECT_EQ(UINT32_C(0), xTaskCreate_fake.call_count);
+    EXPECT_EQ(UINT32_C(0), xSemaphoreCreateBinary_fake.call_count);
+
+    EXPECT_EQ((TaskHandle_t)0x10, handleBlock.task);
+    EXPECT_EQ((SemaphoreHandle_t)0x20, handleBlock.signal);
+    EXPECT_EQ(&dummyRunFunction, handleBlock.runFunction);
+}
+
+TEST_F(guardedTaskStatic, InitializeInvalidParam)
+{
+    /** @testcase{ guardedTaskStatic::InitializeInvalidParam: }
+     *
+     * API is used to check that nothing is created without stack or storage
+     */
+    EXPECT_EQ(RETCODE_INVALID_PARAM, Retcode_GetCode(GuardedTask_InitializeStatic(&handleBlock, &dummyRunFunction, "test", 2, STACK_SIZE, NULL, &storage)));
+    EXPECT_EQ(RETCODE_INVALID_PARAM, Retcode_GetCode(GuardedTask_InitializeStatic(&handleBlock, &dummyRunFunction, "test", 2, STACK_SIZE, stack, NULL)));
+    EXPECT_EQ(RETCODE_INVALID_PARAM, Retcode_GetCode(GuardedTask_InitializeStatic(&handleBlock, NULL, "test", 2, STACK_SIZE, stack, &storage)));
+    EXPECT_EQ(UINT32_C(0), xTaskCreateStatic_fake.call_count);
+    EXPECT_EQ(UINT32_C(0), xSemaphoreCreateBinaryStatic_fake.call_count);
+}
+
+#else
+}
+#endif /* KISO_FEATURE_GUARDEDTASK */
@@ -0,0 +1,239 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+/**
+ *
+ * @brief
+ *      Module test specification for the GuardedTask module signaled by task notifications.
+ *
+ * @detail
+ *      The unit test file template follows the Four-Phase test pattern.
+ *
+ * @file
+ **/
+
+/* Include gtest interface */
+#include <gtest.h>
+
+/* Start of global scope symbol and fake definitions section */
+extern "C"
+{
+/* Setup compile time configuration defines */
+#define KISO_UTILS_TASK_NOTIFICATIONS 1
+
+#include "Kiso_Utils.h"
+#undef KISO_MODULE_ID
+#define KISO_MODULE_ID KISO_UTILS_MODULE_ID_GUARDEDTASK
+
+#if KISO_FEATURE_GUARDEDTASK
+
+/* Include faked interfaces */
+#include "Kiso_Retcode_th.hh"
+#include "Kiso_Assert_th.hh"
+
+#include "FreeRTOS_th.hh"
+#include "semphr_th.hh"
+#include "queue_th.hh"
+#include "task_th.hh"
+
+/* Include module under test */
+#include "GuardedTask.c"
+
+    /* End of global scope symbol and fake definitions section */
+}
+
+static bool runFunctionCalled = false;
+
+static uint32_t notificationValue = 0;
+
+static void dummyRunFunction(void)
+{
+    runFunctionCalled = true;
+}
+
+static BaseType_t fakeTaskNotifyAndQuery(TaskHandle_t task, uint32_t value, eNotifyAction action, uint32_t *previousValue)
+{
+    KISO_UNUSED(task);
+    KISO_UNUSED(value);
+    KISO_UNUSED(action);
+    *previousValue = notificationValue++;
+    return pdPASS;
+}
+
+static BaseType_t fakeTaskNotifyAndQueryFromISR(TaskHandle_t task, uint32_t value, eNotifyAction action, uint32_t *previousValue, BaseType_t *higherPriorityTaskWoken)
+{
+    KISO_UNUSED(task);
+    KISO_UNUSED(value);
+    KISO_UNUSED(action);
+    *previousValue = notificationValue++;
+    *higherPriorityTaskWoken = pdTRUE;
+    return pdPASS;
+}
+
+class guardedTaskNotify : public testing::Test
+{
+public:
+    GuardedTask_T guardTask;
+
+protected:
+    virtual void SetUp()
+    {
+        guardTask.task = (TaskHandle_t)1;
+        guardTask.runFunction = &dummyRunFunction;
+        runFunctionCalled = false;
+        notificationValue = 0;
+        RESET_FAKE(xTaskCreate);
+        RESET_FAKE(vTaskDelete);
+        RESET_FAKE(xTaskNotifyAndQuery);
+        RESET_FAKE(xTaskNotifyAndQueryFromISR);
+        RESET_FAKE(ulTaskNotifyTake);
+        RESET_FAKE(xSemaphoreCreateBinary);
+        RESET_FAKE(Retcode_RaiseError);
+
+        xTaskNotifyAndQuery_fake.custom_fake = fakeTaskNotifyAndQuery;
+        xTaskNotifyAndQueryFromISR_fake.custom_fake = fakeTaskNotifyAndQueryFromISR;
+
+        FFF_RESET_HISTORY();
+    }
+};
+
+/* specify test cases ******************************************************* */
+
+TEST_F(guardedTaskNotify, InitializeCreatesNoSemaphore)
+{
+    /** @testcase{ guardedTaskNotify::InitializeCreatesNoSemaphore: }
+     *
+     * API is used to check that only the task is created
+     */
+    GuardedTask_T handleBlock;
+    xTaskCreate_fake.return_val = pdPASS;
+
+    Retcode_T retVal = GuardedTask_Initialize(&handleBlock, &dummyRunFunction, "test", 0, 0);
+
+    EXPECT_EQ(RETCODE_OK, retVal);
+    EXPECT_EQ(UINT32_C(1), xTaskCreate_fake.call_count);
+    EXPECT_EQ(UINT32_C(0), xSemaphoreCreateBinary_fake.call_count);
+}
+
+TEST_F(guardedTaskNotify, InitializeTaskFail)
+{
+    /** @testcase{ guardedTaskNotify::InitializeTaskFail: }
+     *
+     * API is used to check if the initialize function will handle task-creation fail correctly
+     */
+    GuardedTask_T handleBlock;
+    xTaskCreate_fake.return_val = pdFAIL;
+
+    Retcode_T retVal = GuardedTask_Initialize(&handleBlock, &dummyRunFunction, "test", 0, 0);
+
+    EXPECT_EQ(RETCODE_OUT_OF_RESOURCES, Retcode_GetCode(retVal));
+    EXPECT_EQ(RETCODE_SEVERITY_ERROR, Retcode_GetSeverity(retVal));
+}
+
+TEST_F(guardedTaskNotify, DeinitializeSuccess)
+{
+    /** @testcase{ guardedTaskNotify::DeinitializeSuccess: }
+     *
+     * API is used to check that the task is deleted
+     */
+    Retcode_T retVal = GuardedTask_Deinitialize(&guardTask);
+
+    EXPECT_EQ(RETCODE_OK, retVal);
+    EXPECT_EQ(UINT32_C(1), vTaskDelete_fake.call_count);
+    EXPECT_EQ(NULL, guardTask.task);
+    EXPECT_EQ(NULL, guardTask.runFunction);
+}
+
+TEST_F(guardedTaskNotify, SignalInvalidParam)
+{
+    /** @testcase{ guardedTaskNotify::SignalInvalidParam: }
+     *
+     * API is used to check that a guarded task without task is not notified
+     */
+    guardTask.task = NULL;
+
+    Retcode_T retVal = GuardedTask_Signal(&guardTask);
+
+    EXPECT_EQ(RETCODE_INVALID_PARAM, Retcode_GetCode(retVal));
+    EXPECT_EQ(UINT32_C(0), xTaskNotifyAndQuery_fake.call_count);
+}
+
+TEST_F(guardedTaskNotify, SignalMultipleGives)
+{
+    /** @testcase{ guardedTaskNotify::SignalMultipleGives: }
+     *
+     * API is used to check that the task is notified and a pending notification is reported
+     */
+    Retcode_T retVal = GuardedTask_Signal(&guardTask);
+
+    EXPECT_EQ(RETCODE_OK, retVal);
+    EXPECT_EQ(guardTask.task, xTaskNotifyAndQuery_fake.arg0_val);
+    EXPECT_EQ(eIncrement, xTaskNotifyAndQuery_fake.arg2_val);
+
+    retVal = GuardedTask_Signal(&guardTask);
+
+    EXPECT_EQ(RETCODE_GUARDEDTASK_SEMAPHORE_ALREADY_GIVEN, Retcode_GetCode(retVal));
+    EXPECT_EQ(RETCODE_SEVERITY_WARNING, Retcode_GetSeverity(retVal));
+    EXPECT_EQ(UINT32_C(2), xTaskNotifyAndQuery_fake.call_count);
+}
+
+TEST_F(guardedTaskNotify, SignalFromIsrMultipleGives)
+{
+    /** @testcase{ guardedTaskNotify::SignalFromIsrMultipleGives: }
+     *
+     * API is used to check that the task is notified from ISR and a pending notification is reported
+     */
+    Retcode_T retVal = GuardedTask_SignalFromIsr(&guardTask);
+
+    EXPECT_EQ(RETCODE_OK, retVal);
+    EXPECT_EQ(guardTask.task, xTaskNotifyAndQueryFromISR_fake.arg0_val);
+    EXPECT_EQ(eIncrement, xTaskNotifyAndQueryFromISR_fake.arg2_val);
+
+    retVal = GuardedTask_SignalFromIsr(&guardTask);
+
+    EXPECT_EQ(RETCODE_GUARDEDTASK_SEMAPHORE_ALREADY_GIVEN, Retcode_GetCode(retVal));
+    EXPECT_EQ(RETCODE_SEVERITY_WARNING, Retcode_GetSeverity(retVal));
+}
+
+TEST_F(guardedTaskNotify, ExecuteSuccess)
+{
+    /** @testcase{ guardedTaskNotify::ExecuteSuccess: }
+     *
+     * API is used to check that the run function is called once the task is notified
+     */
+    ulTaskNotifyTake_fake.return_val = 2;
+
+    GuardedTaskExecute(&guardTask);
+
+    EXPECT_TRUE(runFunctionCalled);
+    EXPECT_EQ(pdTRUE, ulTaskNotifyTake_fake.arg0_val);
+    EXPECT_EQ(portMAX_DELAY, ulTaskNotifyTake_fake.arg1_val);
+}
+
+TEST_F(guardedTaskNotify, ExecuteIgnoresWakeUpWithoutValue)
+{
+    /** @testcase{ guardedTaskNotify::ExecuteIgnoresWakeUpWithoutValue: }
+     *
+     * API is used to check that a wake-up of a transceiver does not run the function
+     */
+    ulTaskNotifyTake_fake.return_val = 0;
+
+    GuardedTaskExecute(&guardTask);
+
+    EXPECT_FALSE(runFunctionCalled);
+    EXPECT_EQ(UINT32_C(0), Retcode_RaiseError_fake.call_count);
+}
+
+#else
+}
+#endif /* KISO_FEATURE_GUARDEDTASK */
@@ -0,0 +1,106 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ *
+ * @brief
+ *      Module test specification for the I2CTransceiver module created in storage given by the caller.
+ *
+ * @detail
+ *      The unit test file template follows the Four-Phase test pattern.
+ *
+ * @file
+ **/
+
+/* Include gtest interface */
+#include <gtest.h>
+
+/* Start of global scope symbol and fake definitions section */
+extern "C"
+{
+    /* Setup compile time configuration defines */
+#define KISO_UTILS_STATIC_ALLOCATION 1
+
+#include "Kiso_Utils.h"
+#undef KISO_MODULE_ID
+#define KISO_MODULE_ID KISO_UTILS_MODULE_ID_I2C_TRANSCEIVER
+
+#if KISO_FEATURE_I2CTRANSCEIVER
+/* Include faked interfaces */
+#include "Kiso_Retcode_th.hh"
+#include "Kiso_MCU_I2C_th.hh"
+#include "FreeRTOS_th.hh"
+#include "semphr_th.hh"
+#include "queue_th.hh"
+#include "task_th.hh"
+
+    uint32_t tempI2CHandle = 0x55;
+    I2C_T I2CHandle = (I2C_T)&tempI2CHandle;
+
+/* Include module under test */
+#include "I2CTransceiver.c"
+
+    /* End of global scope symbol and fake definitions section */
+}
+
+class I2CTransceiverStatic : public testing::Test
+{
+protected:
+    I2cTranceiverHandle_T TranceiverHandle;
+    I2cTranceiverStorage_T Storage;
+
+    virtual void SetUp()
+    {
+        RESET_FAKE(xSemaphoreCreateMutex);
+        RESET_FAKE(xSemaphoreCreateBinary);
+        RESET_FAKE(xSemaphoreCreateMutexStatic);
+        RESET_FAKE(xSemaphoreCreateBinaryStatic);
+        FFF_RESET_HISTORY();
+
+        memset(&TranceiverHandle, 0, sizeof(TranceiverHandle));
+        xSemaphoreCreateMutexStatic_fake.return_val = (SemaphoreHandle_t)0x10;
+        xSemaphoreCreateBinaryStatic_fake.return_val = (SemaphoreHandle_t)0x20;
+    }
+};
+
+/* Specify test cases ******************************************************* */
+
+TEST_F(I2CTransceiverStatic, InitInStorage)
+{
+    Retcode_T retcode = I2CTransceiver_InitStatic(&TranceiverHandle, I2CHandle, &Storage);
+
+    EXPECT_EQ(RETCODE_OK, retcode);
+    EXPECT_EQ(UINT32_C(1), xSemaphoreCreateMutexStatic_fake.call_count);
+    EXPECT_EQ(&Storage.I2CMutexLock, xSemaphoreCreateMutexStatic_fake.arg0_val);
+    EXPECT_EQ(UINT32_C(1), xSemaphoreCreateBinaryStatic_fake.call_count);
+    EXPECT_EQ(&Storage.I2CBusSync, xSemaphoreCreateBinaryStatic_fake.arg0_val);
+    EXPECT_EQ(UINT32_C(0), xSemaphoreCreateMutex_fake.call_count);
+    EXPECT_EQ(UINT32_C(0), xSemaphoreCreateBinary_fake.call_count);
+    EXPECT_EQ((void *)0x10, TranceiverHandle.I2CMutexLock);
+    EXPECT_EQ((void *)0x20, TranceiverHandle.I2CBusSync);
+    EXPECT_TRUE(TranceiverHandle.InitializationStatus);
+}
+
+TEST_F(I2CTransceiverStatic, InitWithoutStorage)
+{
+    Retcode_T retcode = I2CTransceiver_InitStatic(&TranceiverHandle, I2CHandle, NULL);
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), retcode);
+    EXPECT_EQ(UINT32_C(0), xSemaphoreCreateMutexStatic_fake.call_count);
+    EXPECT_FALSE(TranceiverHandle.InitializationStatus);
+}
+
+#else
+}
+#endif /* if KISO_FEATURE_I2CTRANSCEIVER */
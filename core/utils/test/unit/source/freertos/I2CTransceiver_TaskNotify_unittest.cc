@@ -0,0 +1,257 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ *
+ * @brief
+ *      Module test specification for the I2CTransceiver module waking its callers by task notifications.
+ *
+ * @detail
+ *      The unit test file template follows the Four-Phase test pattern.
+ *
+ * @file
+ **/
+
+/* Include gtest interface */
+#include <gtest.h>
+
+/* Start of global scope symbol and fake definitions section */
+extern "C"
+{
+    /* Setup compile time configuration defines */
+#define KISO_UTILS_TASK_NOTIFICATIONS 1
+
+#include "Kiso_Utils.h"
+#undef KISO_MODULE_ID
+#define KISO_MODULE_ID KISO_UTILS_MODULE_ID_I2C_TRANSCEIVER
+
+#if KISO_FEATURE_I2CTRANSCEIVER
+/* Include faked interfaces */
+#include "Kiso_Retcode_th.hh"
+#include "Kiso_MCU_I2C_th.hh"
+#include "FreeRTOS_th.hh"
+#include "semphr_th.hh"
+#include "queue_th.hh"
+#include "task_th.hh"
+
+    uint32_t tempI2CHandle = 0x55;
+    I2C_T I2CHandle = (I2C_T)&tempI2CHandle;
+
+/* Include module under test */
+#include "I2CTransceiver.c"
+
+    /* End of global scope symbol and fake definitions section */
+}
+
+static I2cTranceiverHandle_T TranceiverHandle;
+
+static TaskHandle_t const CurrentTask = (TaskHandle_t)0x42;
+
+/* Number of wake-ups of the waiting task after which the transfer ends, 0 for never */
+static uint32_t TransferEndsAtWait = 0;
+
+static uint32_t TransferHasError = 0;
+
+static void TransferEnd(uint32_t transferError)
+{
+    struct MCU_I2C_Event_S event;
+    memset(&event, 0, sizeof(event));
+    event.TransferError = transferError;
+    event.TxComplete = !transferError;
+    I2CTransceiver_LoopCallback(&TranceiverHandle, event);
+}
+
+static Retcode_T FakeRegisterTransferDone(I2C_T i2c, uint16_t address, uint8_t reg, uint8_t *data, uint32_t length)
+{
+    KISO_UNUSED(i2c);
+    KISO_UNUSED(address);
+    KISO_UNUSED(reg);
+    KISO_UNUSED(data);
+    KISO_UNUSED(length);
+    TransferEnd(0);
+    return RETCODE_OK;
+}
+
+static BaseType_t FakeTaskNotifyWait(uint32_t bitsToClearOnEntry, uint32_t bitsToClearOnExit, uint32_t *value, TickType_t ticksToWait)
+{
+    KISO_UNUSED(bitsToClearOnEntry);
+    KISO_UNUSED(bitsToClearOnExit);
+    KISO_UNUSED(value);
+    KISO_UNUSED(ticksToWait);
+    EXPECT_EQ((void *)CurrentTask, TranceiverHandle.I2CWaitingTask);
+    if (TransferEndsAtWait == xTaskNotifyWait_fake.call_count)
+    {
+        TransferEnd(TransferHasError);
+    }
+    return pdTRUE;
+}
+
+class I2CTransceiverNotify : public testing::Test
+{
+protected:
+    uint8_t Buffer[4];
+
+    virtual void SetUp()
+    {
+        RESET_FAKE(xSemaphoreCreateMutex);
+        RESET_FAKE(xSemaphoreCreateBinary);
+        RESET_FAKE(xSemaphoreTake);
+        RESET_FAKE(xSemaphoreGive);
+        RESET_FAKE(vQueueDelete);
+        RESET_FAKE(MCU_I2C_ReadRegister);
+        RESET_FAKE(MCU_I2C_WriteRegister);
+        RESET_FAKE(MCU_I2C_Send);
+        RESET_FAKE(Retcode_RaiseErrorFromIsr);
+        RESET_FAKE(xTaskGetCurrentTaskHandle);
+        RESET_FAKE(vTaskSetTimeOutState);
+        RESET_FAKE(xTaskCheckForTimeOut);
+        RESET_FAKE(xTaskNotifyWait);
+        RESET_FAKE(xTaskNotifyFromISR);
+        FFF_RESET_HISTORY();
+
+        memset(&TranceiverHandle, 0, sizeof(TranceiverHandle));
+        TransferEndsAtWait = 0;
+        TransferHasError = 0;
+        xSemaphoreCreateMutex_fake.return_val = (SemaphoreHandle_t)0x124;
+        xSemaphoreTake_fake.return_val = pdTRUE;
+        xSemaphoreGive_fake.return_val = pdTRUE;
+        xTaskGetCurrentTaskHandle_fake.return_val = CurrentTask;
+        xTaskNotifyWait_fake.custom_fake = FakeTaskNotifyWait;
+
+        ASSERT_EQ(RETCODE_OK, I2CTransceiver_Init(&TranceiverHandle, I2CHandle));
+        FFF_RESET_HISTORY();
+    }
+};
+
+/* Specify test cases ******************************************************* */
+
+TEST_F(I2CTransceiverNotify, InitCreatesMutexOnly)
+{
+    I2cTranceiverHandle_T handle;
+    memset(&handle, 0, sizeof(handle));
+    RESET_FAKE(xSemaphoreCreateMutex);
+    xSemaphoreCreateMutex_fake.return_val = (SemaphoreHandle_t)0x124;
+
+    Retcode_T retcode = I2CTransceiver_Init(&handle, I2CHandle);
+
+    EXPECT_EQ(RETCODE_OK, retcode);
+    EXPECT_EQ(UINT32_C(0), xSemaphoreCreateBinary_fake.call_count);
+    EXPECT_EQ(UINT32_C(1), xSemaphoreCreateMutex_fake.call_count);
+    EXPECT_TRUE(handle.InitializationStatus);
+    EXPECT_EQ(NULL, handle.I2CWaitingTask);
+    EXPECT_FALSE(handle.I2CTransferDone);
+}
+
+TEST_F(I2CTransceiverNotify, InitMutexFail)
+{
+    I2cTranceiverHandle_T handle;
+    memset(&handle, 0, sizeof(handle));
+    xSemaphoreCreateMutex_fake.return_val = NULL;
+
+    Retcode_T retcode = I2CTransceiver_Init(&handle, I2CHandle);
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_OUT_OF_RESOURCES), retcode);
+    EXPECT_FALSE(handle.InitializationStatus);
+}
+
+TEST_F(I2CTransceiverNotify, ReadEndsBeforeWait)
+{
+    MCU_I2C_ReadRegister_fake.custom_fake = FakeRegisterTransferDone;
+
+    Retcode_T retcode = I2CTransceiver_Read(&TranceiverHandle, 0x10, 0x20, Buffer, sizeof(Buffer));
+
+    EXPECT_EQ(RETCODE_OK, retcode);
+    EXPECT_EQ(UINT32_C(0), xTaskNotifyWait_fake.call_count);
+    /* Nobody waited yet, so nobody is woken */
+    EXPECT_EQ(UINT32_C(0), xTaskNotifyFromISR_fake.call_count);
+    EXPECT_EQ(NULL, TranceiverHandle.I2CWaitingTask);
+    EXPECT_FALSE(TranceiverHandle.I2CTransferDone);
+}
+
+TEST_F(I2CTransceiverNotify, WriteWakesWaitingTask)
+{
+    TransferEndsAtWait = 1;
+
+    Retcode_T retcode = I2CTransceiver_Write(&TranceiverHandle, 0x10, 0x20, Buffer, sizeof(Buffer));
+
+    EXPECT_EQ(RETCODE_OK, retcode);
+    EXPECT_EQ(UINT32_C(1), xTaskNotifyWait_fake.call_count);
+    EXPECT_EQ(UINT32_C(0), xTaskNotifyWait_fake.arg0_val);
+    EXPECT_EQ(UINT32_C(0), xTaskNotifyWait_fake.arg1_val);
+    EXPECT_EQ(UINT32_C(1), xTaskNotifyFromISR_fake.call_count);
+    EXPECT_EQ(CurrentTask, xTaskNotifyFromISR_fake.arg0_val);
+    EXPECT_EQ(eNoAction, xTaskNotifyFromISR_fake.arg2_val);
+    EXPECT_EQ(NULL, TranceiverHandle.I2CWaitingTask);
+}
+
+TEST_F(I2CTransceiverNotify, ReadIgnoresOtherNotifications)
+{
+    /* The first two wake-ups are meant for someone else */
+    TransferEndsAtWait = 3;
+
+    Retcode_T retcode = I2CTransceiver_Read(&TranceiverHandle, 0x10, 0x20, Buffer, sizeof(Buffer));
+
+    EXPECT_EQ(RETCODE_OK, retcode);
+    EXPECT_EQ(UINT32_C(3), xTaskNotifyWait_fake.call_count);
+    EXPECT_EQ(UINT32_C(0), MCU_I2C_Send_fake.call_count);
+}
+
+TEST_F(I2CTransceiverNotify, ReadTransferError)
+{
+    TransferEndsAtWait = 1;
+    TransferHasError = 1;
+
+    Retcode_T retcode = I2CTransceiver_Read(&TranceiverHandle, 0x10, 0x20, Buffer, sizeof(Buffer));
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_I2CTRANSCEIVER_TRANSFER_ERROR), retcode);
+    EXPECT_EQ(UINT32_C(1), Retcode_RaiseErrorFromIsr_fake.call_count);
+}
+
+TEST_F(I2CTransceiverNotify, ReadIgnoresEarlierTransferEnd)
+{
+    BaseType_t timeOut[] = {pdFALSE, pdTRUE};
+    SET_RETURN_SEQ(xTaskCheckForTimeOut, timeOut, 2);
+
+    /* A late end of an earlier transfer which timed out */
+    TransferEnd(0);
+    Retcode_T retcode = I2CTransceiver_Read(&TranceiverHandle, 0x10, 0x20, Buffer, sizeof(Buffer));
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_TIMEOUT), retcode);
+}
+
+TEST_F(I2CTransceiverNotify, WriteTimeout)
+{
+    BaseType_t timeOut[] = {pdFALSE, pdFALSE, pdTRUE};
+    SET_RETURN_SEQ(xTaskCheckForTimeOut, timeOut, 3);
+
+    Retcode_T retcode = I2CTransceiver_Write(&TranceiverHandle, 0x10, 0x20, Buffer, sizeof(Buffer));
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_TIMEOUT), retcode);
+    EXPECT_EQ(UINT32_C(2), xTaskNotifyWait_fake.call_count);
+    EXPECT_EQ(UINT32_C(1), MCU_I2C_Send_fake.call_count);
+    EXPECT_EQ(NULL, TranceiverHandle.I2CWaitingTask);
+}
+
+TEST_F(I2CTransceiverNotify, DeinitDeletesMutexOnly)
+{
+    Retcode_T retcode = I2CTransceiver_Deinit(&TranceiverHandle);
+
+    EXPECT_EQ(RETCODE_OK, retcode);
+    EXPECT_EQ(UINT32_C(1), vQueueDelete_fake.call_count);
+    EXPECT_FALSE(TranceiverHandle.InitializationStatus);
+}
+
+#else
+}
+#endif /* if KISO_FEATURE_I2CTRANSCEIVER */
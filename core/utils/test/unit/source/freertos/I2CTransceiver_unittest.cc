@@ -41,6 +41,7 @@ extern "C"
 #include "Kiso_MCU_I2C_th.hh"
 #include "FreeRTOS_th.hh"
 #include "semphr_th.hh"
+#include "task_th.hh"
 
     uint32_t tempI2CHandle = 0x55;
     I2C_T I2CHandle = (I2C_T)&tempI2CHandle;
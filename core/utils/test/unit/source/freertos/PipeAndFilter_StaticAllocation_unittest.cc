@@ -0,0 +1,210 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ *
+ * @brief
+ *      Module test specification for the PipeAndFilter module created in storage given by the caller.
+ *
+ * @detail
+ *      The unit test file template follows the Four-Phase test pattern.
+ *
+ * @file
+ **/
+
+/* Include gtest interface */
+#include <gtest.h>
+
+/* Start of global scope symbol and fake definitions section */
+extern "C"
+{ /* start of global scope symbol and fake definitions section */
+/* Setup compile time configuration defines */
+#define KISO_UTILS_STATIC_ALLOCATION 1
+
+/* Module includes */
+#include "Kiso_Utils.h"
+#undef KISO_MODULE_ID
+#define KISO_MODULE_ID KISO_UTILS_MODULE_ID_PIPEANDFILTER
+
+#if KISO_FEATURE_PIPEANDFILTER
+
+/* Include faked interfaces */
+#include "Kiso_Retcode_th.hh"
+#include "Kiso_HAL_th.hh"
+
+#include "task_th.hh"
+#include "semphr_th.hh"
+#include "queue_th.hh"
+#include "message_buffer_th.hh"
+#include "stream_buffer_th.hh"
+
+/* Ensure the filter-task will not run anymore */
+#define RUN_FILTER_ALWAYS 0
+
+/* Include the configuration */
+#include "PipeAndFilterConfig.h"
+/* Include module under test */
+#include "PipeAndFilter.c"
+
+    /* End of global scope symbol and fake definitions section */
+}
+
+#define POOL_COUNT UINT32_C(2)
+#define POOL_BUFFER_SIZE UINT32_C(8)
+
+static Retcode_T filterCopy(uint8_t *bufferIn, uint32_t sizeBuffIn, uint8_t *bufferOut, uint32_t *sizeBuffOut)
+{
+    memcpy(bufferOut, bufferIn, sizeBuffIn);
+    *sizeBuffOut = sizeBuffIn;
+    return RETCODE_OK;
+}
+
+class PipeAndFilterStatic : public testing::Test
+{
+protected:
+    PipeAndFilter_Pipe_T pipeIn;
+    PipeAndFilter_Pipe_T pipeOut;
+    PipeAndFilter_Filter_T filter;
+
+    virtual void SetUp()
+    {
+        RESET_FAKE(xStreamBufferGenericCreate);
+        RESET_FAKE(xStreamBufferGenericCreateStatic);
+        RESET_FAKE(xSemaphoreCreateMutex);
+        RESET_FAKE(xSemaphoreCreateMutexStatic);
+        RESET_FAKE(xQueueCreate);
+        RESET_FAKE(xQueueCreateStatic);
+        RESET_FAKE(xQueueSend);
+        RESET_FAKE(xTaskCreate);
+        RESET_FAKE(xTaskCreateStatic);
+        FFF_RESET_HISTORY();
+
+        memset(&pipeIn, 0, sizeof(pipeIn));
+        memset(&pipeOut, 0, sizeof(pipeOut));
+        memset(&filter, 0, sizeof(filter));
+        xStreamBufferGenericCreateStatic_fake.return_val = (StreamBufferHandle_t)0x10;
+        xSemaphoreCreateMutexStatic_fake.return_val = (SemaphoreHandle_t)0x20;
+        xQueueCreateStatic_fake.return_val = (QueueHandle_t)0x30;
+        xTaskCreateStatic_fake.return_val = (TaskHandle_t)0x40;
+    }
+};
+
+/* Specify test cases ******************************************************* */
+
+TEST_F(PipeAndFilterStatic, CreatePipeInStorage)
+{
+    PipeAndFilter_PipeStorage_T storage;
+
+    Retcode_T retcode = PipeAndFilter_CreatePipeStatic(&pipeIn, &storage);
+
+    /* The message buffer is created as stream buffer by the macros of message_buffer.h */
+    EXPECT_EQ(RETCODE_OK, retcode);
+    EXPECT_EQ(UINT32_C(1), xStreamBufferGenericCreateStatic_fake.call_count);
+    EXPECT_EQ((size_t)PIPE_SIZE, xStreamBufferGenericCreateStatic_fake.arg0_val);
+    EXPECT_EQ(pdTRUE, xStreamBufferGenericCreateStatic_fake.arg2_val);
+    EXPECT_EQ(storage.memory, xStreamBufferGenericCreateStatic_fake.arg3_val);
+    EXPECT_EQ((StaticStreamBuffer_t *)&storage.buffer, xStreamBufferGenericCreateStatic_fake.arg4_val);
+    EXPECT_EQ(UINT32_C(0), xStreamBufferGenericCreate_fake.call_count);
+    EXPECT_EQ((void *)0x10, pipeIn.pipeInternalHandle);
+    EXPECT_EQ(NULL, pipeIn.lockInternalHandle);
+    EXPECT_FALSE(pipeIn.isBufferPipe);
+}
+
+TEST_F(PipeAndFilterStatic, CreateMergePipeInStorage)
+{
+    PipeAndFilter_PipeStorage_T storage;
+
+    Retcode_T retcode = PipeAndFilter_CreateMergePipeStatic(&pipeIn, &storage);
+
+    EXPECT_EQ(RETCODE_OK, retcode);
+    EXPECT_EQ((StaticStreamBuffer_t *)&storage.buffer, xStreamBufferGenericCreateStatic_fake.arg4_val);
+    EXPECT_EQ(UINT32_C(1), xSemaphoreCreateMutexStatic_fake.call_count);
+    EXPECT_EQ(&storage.lock, xSemaphoreCreateMutexStatic_fake.arg0_val);
+    EXPECT_EQ(UINT32_C(0), xSemaphoreCreateMutex_fake.call_count);
+    EXPECT_EQ((void *)0x20, pipeIn.lockInternalHandle);
+}
+
+TEST_F(PipeAndFilterStatic, CreateFilterInStorage)
+{
+    PipeAndFilter_FilterStorage_T storage;
+
+    Retcode_T retcode = PipeAndFilter_CreateFilterStatic(filterCopy, &pipeIn, &pipeOut, &filter, &storage);
+
+    EXPECT_EQ(RETCODE_OK, retcode);
+    EXPECT_EQ(UINT32_C(1), xTaskCreateStatic_fake.call_count);
+    EXPECT_EQ((uint32_t)FILTER_STACK_SIZE, xTaskCreateStatic_fake.arg2_val);
+    EXPECT_EQ(&filter, xTaskCreateStatic_fake.arg3_val);
+    EXPECT_EQ(storage.stack, xTaskCreateStatic_fake.arg5_val);
+    EXPECT_EQ(&storage.task, xTaskCreateStatic_fake.arg6_val);
+    EXPECT_EQ(UINT32_C(0), xTaskCreate_fake.call_count);
+    EXPECT_EQ((void *)0x40, filter.filterInternalHandle);
+    EXPECT_EQ((void *)0x40, pipeIn.filterInternalHandle);
+}
+
+TEST_F(PipeAndFilterStatic, CreateBufferPipeInStorage)
+{
+    PipeAndFilter_BufferPipeStorage_T storage;
+
+    Retcode_T retcode = PipeAndFilter_CreateBufferPipeStatic(&pipeIn, &storage);
+
+    EXPECT_EQ(RETCODE_OK, retcode);
+    EXPECT_EQ(UINT32_C(1), xQueueCreateStatic_fake.call_count);
+    EXPECT_EQ((UBaseType_t)BUFFER_PIPE_DEPTH, xQueueCreateStatic_fake.arg0_val);
+    EXPECT_EQ(sizeof(PipeAndFilter_Buffer_T *), xQueueCreateStatic_fake.arg1_val);
+    EXPECT_EQ((uint8_t *)storage.buffers, xQueueCreateStatic_fake.arg2_val);
+    EXPECT_EQ(&storage.queue, xQueueCreateStatic_fake.arg3_val);
+    EXPECT_EQ(UINT32_C(0), xQueueCreate_fake.call_count);
+    EXPECT_TRUE(pipeIn.isBufferPipe);
+}
+
+TEST_F(PipeAndFilterStatic, CreatePoolInStorage)
+{
+    PipeAndFilter_Pool_T pool;
+    PipeAndFilter_Buffer_T buffers[POOL_COUNT];
+    uint8_t memory[POOL_COUNT * POOL_BUFFER_SIZE];
+    PipeAndFilter_Buffer_T *freeBuffers[POOL_COUNT];
+    PipeAndFilter_PoolStorage_T storage;
+
+    Retcode_T retcode = PipeAndFilter_CreatePoolStatic(&pool, buffers, memory, POOL_COUNT, POOL_BUFFER_SIZE, freeBuffers, &storage);
+
+    EXPECT_EQ(RETCODE_OK, retcode);
+    EXPECT_EQ(UINT32_C(1), xQueueCreateStatic_fake.call_count);
+    EXPECT_EQ(POOL_COUNT, xQueueCreateStatic_fake.arg0_val);
+    EXPECT_EQ((uint8_t *)freeBuffers, xQueueCreateStatic_fake.arg2_val);
+    EXPECT_EQ(&storage.queue, xQueueCreateStatic_fake.arg3_val);
+    EXPECT_EQ(UINT32_C(0), xQueueCreate_fake.call_count);
+    EXPECT_EQ(POOL_COUNT, xQueueSend_fake.call_count);
+    EXPECT_EQ(&memory[POOL_BUFFER_SIZE], buffers[1].data);
+}
+
+TEST_F(PipeAndFilterStatic, CreateWithoutStorage)
+{
+    PipeAndFilter_Pool_T pool;
+    PipeAndFilter_Buffer_T buffers[POOL_COUNT];
+    uint8_t memory[POOL_COUNT * POOL_BUFFER_SIZE];
+    PipeAndFilter_PoolStorage_T storage;
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), PipeAndFilter_CreatePipeStatic(&pipeIn, NULL));
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), PipeAndFilter_CreateMergePipeStatic(&pipeIn, NULL));
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), PipeAndFilter_CreateFilterStatic(filterCopy, &pipeIn, &pipeOut, &filter, NULL));
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), PipeAndFilter_CreateBufferPipeStatic(&pipeIn, NULL));
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_NULL_POINTER), PipeAndFilter_CreatePoolStatic(&pool, buffers, memory, POOL_COUNT, POOL_BUFFER_SIZE, NULL, &storage));
+    EXPECT_EQ(UINT32_C(0), xStreamBufferGenericCreateStatic_fake.call_count);
+    EXPECT_EQ(UINT32_C(0), xQueueCreateStatic_fake.call_count);
+    EXPECT_EQ(UINT32_C(0), xTaskCreateStatic_fake.call_count);
+}
+
+#else
+}
+#endif /* if KISO_FEATURE_PIPEANDFILTER */
@@ -25,6 +25,10 @@
 /* Include gtest interface */
 #include <gtest.h>
 
+#include <deque>
+#include <map>
+#include <vector>
+
 /* Start of global scope symbol and fake definitions section */
 extern "C"
 { /* start of global scope symbol and fake definitions section */
@@ -37,8 +41,11 @@ extern "C"
 
 /* Include faked interfaces */
 #include "Kiso_Retcode_th.hh"
+#include "Kiso_HAL_th.hh"
 
 #include "task_th.hh"
+#include "semphr_th.hh"
+#include "queue_th.hh"
 #include "message_buffer_th.hh"
 #include "stream_buffer_th.hh"
 
@@ -80,6 +87,154 @@ Retcode_T filterCustom(uint8_t *bufferIn, uint32_t sizeBuffIn, uint8_t *bufferOu
     return retcodeFakeValue;
 }
 
+/* Stages of a fused filter: increments every byte, doubles every byte, keeps the first bytes */
+static uint32_t stageKeepBytes;
+static Retcode_T stageRetcode;
+Retcode_T stageIncrement(uint8_t *bufferIn, uint32_t sizeBuffIn, uint8_t *bufferOut, uint32_t *sizeBuffOut)
+{
+    for (uint32_t i = 0; i < sizeBuffIn; i++)
+    {
+        bufferOut[i] = bufferIn[i] + 1U;
+    }
+    *sizeBuffOut = sizeBuffIn;
+    return RETCODE_OK;
+}
+
+Retcode_T stageDouble(uint8_t *bufferIn, uint32_t sizeBuffIn, uint8_t *bufferOut, uint32_t *sizeBuffOut)
+{
+    for (uint32_t i = 0; i < sizeBuffIn; i++)
+    {
+        bufferOut[i] = bufferIn[i] * 2U;
+    }
+    *sizeBuffOut = sizeBuffIn;
+    return stageRetcode;
+}
+
+Retcode_T stageKeep(uint8_t *bufferIn, uint32_t sizeBuffIn, uint8_t *bufferOut, uint32_t *sizeBuffOut)
+{
+    *sizeBuffOut = (sizeBuffIn < stageKeepBytes) ? sizeBuffIn : stageKeepBytes;
+    memcpy(bufferOut, bufferIn, *sizeBuffOut);
+    return RETCODE_OK;
+}
+
+/* Received messages are 1, 2, 3..., the sent ones are recorded */
+static std::vector<std::vector<uint8_t>> sentMessages;
+size_t xStreamBufferReceiveCustom(StreamBufferHandle_t, void *data, size_t, TickType_t)
+{
+    for (uint8_t i = 0; i < 3U; i++)
+    {
+        ((uint8_t *)data)[i] = i + 1U;
+    }
+    return 3;
+}
+
+size_t xStreamBufferSendCustom(StreamBufferHandle_t, const void *data, size_t length, TickType_t)
+{
+    sentMessages.push_back(std::vector<uint8_t>((const uint8_t *)data, (const uint8_t *)data + length));
+    return length;
+}
+
+/* Fake queues of buffer pipes and pools, by handle */
+struct FakeQueue
+{
+    UBaseType_t length;
+    std::deque<PipeAndFilter_Buffer_T *> items;
+};
+static std::map<QueueHandle_t, FakeQueue> fakeQueues;
+static uintptr_t nextQueueHandle;
+
+QueueHandle_t xQueueCreateCustom(UBaseType_t length, UBaseType_t itemSize)
+{
+    EXPECT_EQ(sizeof(PipeAndFilter_Buffer_T *), itemSize);
+    QueueHandle_t handle = (QueueHandle_t)++nextQueueHandle;
+    fakeQueues[handle].length = length;
+    return handle;
+}
+
+BaseType_t xQueueSendCustom(QueueHandle_t queue, void *item, TickType_t)
+{
+    FakeQueue &fakeQueue = fakeQueues[queue];
+    if (fakeQueue.items.size() >= fakeQueue.length)
+    {
+        return errQUEUE_FULL;
+    }
+    fakeQueue.items.push_back(*(PipeAndFilter_Buffer_T **)item);
+    return pdPASS;
+}
+
+BaseType_t xQueueSendFromISRCustom(QueueHandle_t queue, void *item, BaseType_t *)
+{
+    return xQueueSendCustom(queue, item, 0);
+}
+
+BaseType_t xQueueReceiveCustom(QueueHandle_t queue, void *item, TickType_t)
+{
+    FakeQueue &fakeQueue = fakeQueues[queue];
+    if (fakeQueue.items.empty())
+    {
+        return errQUEUE_EMPTY;
+    }
+    *(PipeAndFilter_Buffer_T **)item = fakeQueue.items.front();
+    fakeQueue.items.pop_front();
+    return pdPASS;
+}
+
+BaseType_t uxQueueMessagesWaitingCustom(QueueHandle_t queue)
+{
+    return (BaseType_t)fakeQueues[queue].items.size();
+}
+
+BaseType_t xQueueReceiveFromISRCustom(QueueHandle_t queue, void *item, BaseType_t *)
+{
+    return xQueueReceiveCustom(queue, item, 0);
+}
+
+#define POOL_COUNT 4U
+#define POOL_BUFFER_SIZE 8U
+
+static PipeAndFilter_Pool_T pool;
+static PipeAndFilter_Buffer_T poolBuffers[POOL_COUNT];
+static uint8_t poolMemory[POOL_COUNT * POOL_BUFFER_SIZE];
+
+/* Behavior of the buffer filter under test */
+enum BufferFilterMode
+{
+    BUFFER_FILTER_IN_PLACE,
+    BUFFER_FILTER_NEW_BUFFER,
+    BUFFER_FILTER_DROP,
+    BUFFER_FILTER_OVERFLOW,
+};
+static BufferFilterMode bufferFilterMode;
+static Retcode_T bufferFilterRetcode;
+static PipeAndFilter_Buffer_T *bufferFilterIn;
+
+Retcode_T bufferFilter(PipeAndFilter_Buffer_T *bufferIn, PipeAndFilter_Buffer_T **bufferOut)
+{
+    bufferFilterIn = bufferIn;
+    EXPECT_EQ(bufferIn, *bufferOut);
+    switch (bufferFilterMode)
+    {
+    case BUFFER_FILTER_IN_PLACE:
+        for (uint32_t i = 0; i < bufferIn->length; i++)
+        {
+            bufferIn->data[i] *= 2U;
+        }
+        break;
+    case BUFFER_FILTER_NEW_BUFFER:
+        EXPECT_EQ(RETCODE_OK, PipeAndFilter_AllocateBuffer(&pool, bufferOut, 0));
+        (*bufferOut)->data[0] = 42;
+        (*bufferOut)->length = 1;
+        break;
+    case BUFFER_FILTER_DROP:
+        *bufferOut = NULL;
+        break;
+    case BUFFER_FILTER_OVERFLOW:
+        bufferIn->length = bufferIn->size + 1U;
+        break;
+    }
+    return bufferFilterRetcode;
+}
+
 class PipeAndFilter : public testing::Test
 {
 public:
@@ -89,6 +244,7 @@ public:
 protected:
     virtual void SetUp()
     {
+        memset(&pipeS, 0, sizeof(pipeS));
         pipeS.filterInternalHandle = (TaskHandle_t)0x00000001;
         pipeS.pipeInternalHandle = (PipeAndFilter_FilterInternalHandle_T)0x00000001;
         filterS.filterFunction = NULL;
@@ -101,9 +257,75 @@ protected:
         RESET_FAKE(xStreamBufferSendFromISR);
         RESET_FAKE(xStreamBufferReceive);
         RESET_FAKE(functionA);
+        RESET_FAKE(xQueueCreate);
+        RESET_FAKE(xQueueSend);
+        RESET_FAKE(xQueueSendFromISR);
+        RESET_FAKE(xQueueReceive);
+        RESET_FAKE(xQueueReceiveFromISR);
+        RESET_FAKE(HAL_IsInISR);
+        RESET_FAKE(uxQueueMessagesWaiting);
+        RESET_FAKE(xSemaphoreCreateMutex);
+        RESET_FAKE(xSemaphoreTake);
+        RESET_FAKE(xSemaphoreGive);
+        RESET_FAKE(vStreamBufferDelete);
+        RESET_FAKE(xStreamBufferSpacesAvailable);
+
+        fakeQueues.clear();
+        nextQueueHandle = 0;
+        xQueueCreate_fake.custom_fake = xQueueCreateCustom;
+        xQueueSend_fake.custom_fake = xQueueSendCustom;
+        xQueueSendFromISR_fake.custom_fake = xQueueSendFromISRCustom;
+        xQueueReceive_fake.custom_fake = xQueueReceiveCustom;
+        xQueueReceiveFromISR_fake.custom_fake = xQueueReceiveFromISRCustom;
+        uxQueueMessagesWaiting_fake.custom_fake = uxQueueMessagesWaitingCustom;
+
+        stageKeepBytes = PIPE_SIZE;
+        stageRetcode = RETCODE_OK;
+        sentMessages.clear();
+
+        bufferFilterMode = BUFFER_FILTER_IN_PLACE;
+        bufferFilterRetcode = RETCODE_OK;
+        bufferFilterIn = NULL;
 
         FFF_RESET_HISTORY();
     }
+
+    /* Number of free buffers of the pool */
+    size_t FreeBuffers(void)
+    {
+        return fakeQueues[(QueueHandle_t)pool.poolInternalHandle].items.size();
+    }
+
+    /* Creates the pool, two buffer pipes and a buffer filter between them */
+    void CreateBufferChain(PipeAndFilter_Pipe_T *pipeIn, PipeAndFilter_Pipe_T *pipeOut, PipeAndFilter_Filter_T *filter)
+    {
+        taskHandleOfFakeFunction = (TaskHandle_t)0x00000001;
+        xTaskCreate_fake.custom_fake = &xTaskCreateCustom;
+        ASSERT_EQ(RETCODE_OK, PipeAndFilter_CreatePool(&pool, poolBuffers, poolMemory, POOL_COUNT, POOL_BUFFER_SIZE));
+        if (pipeIn != NULL)
+        {
+            ASSERT_EQ(RETCODE_OK, PipeAndFilter_CreateBufferPipe(pipeIn));
+        }
+        if (pipeOut != NULL)
+        {
+            ASSERT_EQ(RETCODE_OK, PipeAndFilter_CreateBufferPipe(pipeOut));
+        }
+        ASSERT_EQ(RETCODE_OK, PipeAndFilter_CreateBufferFilter(bufferFilter, pipeIn, pipeOut, filter));
+    }
+
+    /* Takes a buffer of the pool, fills it with length bytes counting from 1 and puts it in the pipe */
+    PipeAndFilter_Buffer_T *FillBuffer(PipeAndFilter_Pipe_T pipe, uint32_t length)
+    {
+        PipeAndFilter_Buffer_T *buffer = NULL;
+        EXPECT_EQ(RETCODE_OK, PipeAndFilter_AllocateBuffer(&pool, &buffer, 0));
+        for (uint32_t i = 0; i < length; i++)
+        {
+            buffer->data[i] = (uint8_t)(i + 1U);
+        }
+        buffer->length = length;
+        EXPECT_EQ(RETCODE_OK, PipeAndFilter_FillBufferPipe(pipe, buffer));
+        return buffer;
+    }
 };
 
 /* Specify test cases ******************************************************* */
@@ -114,7 +336,7 @@ TEST_F(PipeAndFilter, InitializePipeSuccess)
      * Successful initialization
      */
     Retcode_T retVal = RETCODE_OK;
-    PipeAndFilter_Pipe_T pipeHandle;
+    PipeAndFilter_Pipe_T pipeHandle = pipeS;
     xStreamBufferGenericCreate_fake.return_val = (MessageBufferHandle_t)0xAAAAAAAA;
 
     retVal = PipeAndFilter_CreatePipe(&pipeHandle);
@@ -130,7 +352,7 @@ TEST_F(PipeAndFilter, InitializePipeFailure)
      * Not enough resources left in the heap
      */
     Retcode_T retVal = RETCODE_OK;
-    PipeAndFilter_Pipe_T pipeHandle;
+    PipeAndFilter_Pipe_T pipeHandle = pipeS;
     xStreamBufferGenericCreate_fake.return_val = NULL;
 
     retVal = PipeAndFilter_CreatePipe(&pipeHandle);
@@ -146,8 +368,8 @@ TEST_F(PipeAndFilter, InitializeFilterSuccess)
      * Manage to successful initialize a filter
      */
     Retcode_T retVal = RETCODE_OK;
-    PipeAndFilter_Pipe_T pipeHandleIn;
-    PipeAndFilter_Pipe_T pipeHandleOut;
+    PipeAndFilter_Pipe_T pipeHandleIn = pipeS;
+    PipeAndFilter_Pipe_T pipeHandleOut = pipeS;
     PipeAndFilter_Filter_T filter1;
     taskHandleOfFakeFunction = (TaskHandle_t)0x00000001;
 
@@ -169,7 +391,7 @@ TEST_F(PipeAndFilter, InitializeFilterSuccessWithNoInputPipe)
      * Manage to successful initialize a filter
      */
     Retcode_T retVal = RETCODE_OK;
-    PipeAndFilter_Pipe_T pipeHandleOut;
+    PipeAndFilter_Pipe_T pipeHandleOut = pipeS;
     PipeAndFilter_Filter_T filter1;
     taskHandleOfFakeFunction = (TaskHandle_t)0x00000001;
 
@@ -190,8 +412,8 @@ TEST_F(PipeAndFilter, InitializeFilterNullPointer)
      * Filter ressource is NULL
      */
     Retcode_T retVal = RETCODE_OK;
-    PipeAndFilter_Pipe_T pipeHandleIn;
-    PipeAndFilter_Pipe_T pipeHandleOut;
+    PipeAndFilter_Pipe_T pipeHandleIn = pipeS;
+    PipeAndFilter_Pipe_T pipeHandleOut = pipeS;
     PipeAndFilter_Filter_T *filter1 = NULL;
     taskHandleOfFakeFunction = NULL;
     xTaskCreate_fake.custom_fake = &xTaskCreateCustom;
@@ -207,8 +429,8 @@ TEST_F(PipeAndFilter, initializeFilterFailure)
      * Not enough resources left in the heap
      */
     Retcode_T retVal = RETCODE_OK;
-    PipeAndFilter_Pipe_T pipeHandleIn;
-    PipeAndFilter_Pipe_T pipeHandleOut;
+    PipeAndFilter_Pipe_T pipeHandleIn = pipeS;
+    PipeAndFilter_Pipe_T pipeHandleOut = pipeS;
     PipeAndFilter_Filter_T filter1;
     taskHandleOfFakeFunction = NULL;
 
@@ -228,7 +450,7 @@ TEST_F(PipeAndFilter, fillPipeSuccess)
      * Successful send
      */
     Retcode_T retVal = RETCODE_OK;
-    PipeAndFilter_Pipe_T pipeHandle;
+    PipeAndFilter_Pipe_T pipeHandle = pipeS;
     uint8_t buffer[5] = {1, 2, 3, 4, 5};
     xStreamBufferSend_fake.return_val = 5; // 5 bytes are sent
 
@@ -244,7 +466,7 @@ TEST_F(PipeAndFilter, fillPipeNullPointers)
      * Null pointer check
      */
     Retcode_T retVal = RETCODE_OK;
-    PipeAndFilter_Pipe_T pipeHandle;
+    PipeAndFilter_Pipe_T pipeHandle = pipeS;
     uint8_t buffer[5] = {1, 2, 3, 4, 5};
     xStreamBufferSend_fake.return_val = 5; // 5 bytes are sent
 
@@ -272,7 +494,7 @@ TEST_F(PipeAndFilter, fillPipeFailToFill)
      * Buffer full
      */
     Retcode_T retVal = RETCODE_OK;
-    PipeAndFilter_Pipe_T pipeHandle;
+    PipeAndFilter_Pipe_T pipeHandle = pipeS;
     uint8_t buffer[5] = {1, 2, 3, 4, 5};
     xStreamBufferSend_fake.return_val = 0; // 0 bytes could be sent, full.
 
@@ -289,7 +511,7 @@ TEST_F(PipeAndFilter, fillPipeFromISRSuccess)
      * Successful send from ISR
      */
     Retcode_T retVal = RETCODE_OK;
-    PipeAndFilter_Pipe_T pipeHandle;
+    PipeAndFilter_Pipe_T pipeHandle = pipeS;
     uint8_t buffer[5] = {1, 2, 3, 4, 5};
     xStreamBufferSendFromISR_fake.return_val = 5; // 5 bytes are sent
 
@@ -306,7 +528,7 @@ TEST_F(PipeAndFilter, fillPipeFromISRNullPointers)
      * Null pointer check
      */
     Retcode_T retVal = RETCODE_OK;
-    PipeAndFilter_Pipe_T pipeHandle;
+    PipeAndFilter_Pipe_T pipeHandle = pipeS;
     uint8_t buffer[5] = {1, 2, 3, 4, 5};
     xStreamBufferSendFromISR_fake.return_val = 5; // 5 bytes are sent
 
@@ -334,7 +556,7 @@ TEST_F(PipeAndFilter, fillPipeFromISRFailToFill)
      * Buffer full
      */
     Retcode_T retVal = RETCODE_OK;
-    PipeAndFilter_Pipe_T pipeHandle;
+    PipeAndFilter_Pipe_T pipeHandle = pipeS;
     uint8_t buffer[5] = {1, 2, 3, 4, 5};
     xStreamBufferSendFromISR_fake.return_val = 0; // 0 bytes could be sent, full.
 
@@ -350,8 +572,8 @@ TEST_F(PipeAndFilter, filterRunSuccessWithPipes)
      * Filter function was not given as parameter ot the filter-structure...
      */
     Retcode_T retVal = RETCODE_OK;
-    PipeAndFilter_Pipe_T pipeHandleIn;
-    PipeAndFilter_Pipe_T pipeHandleOut;
+    PipeAndFilter_Pipe_T pipeHandleIn = pipeS;
+    PipeAndFilter_Pipe_T pipeHandleOut = pipeS;
     PipeAndFilter_Filter_T filter1;
 
     taskHandleOfFakeFunction = (TaskHandle_t)0x00000001;
@@ -381,8 +603,8 @@ TEST_F(PipeAndFilter, filterRunFailurePipeInCalledWithNoParam)
      * Somehow the pipe send a message of 0 bytes...
      */
     Retcode_T retVal = RETCODE_OK;
-    PipeAndFilter_Pipe_T pipeHandleIn;
-    PipeAndFilter_Pipe_T pipeHandleOut;
+    PipeAndFilter_Pipe_T pipeHandleIn = pipeS;
+    PipeAndFilter_Pipe_T pipeHandleOut = pipeS;
     PipeAndFilter_Filter_T filter1;
 
     taskHandleOfFakeFunction = (TaskHandle_t)0x00000001;
@@ -412,8 +634,8 @@ TEST_F(PipeAndFilter, filterRunFailurePipeOutParamMatching)
      * Somehow the pipe out is full
      */
     Retcode_T retVal = RETCODE_OK;
-    PipeAndFilter_Pipe_T pipeHandleIn;
-    PipeAndFilter_Pipe_T pipeHandleOut;
+    PipeAndFilter_Pipe_T pipeHandleIn = pipeS;
+    PipeAndFilter_Pipe_T pipeHandleOut = pipeS;
     PipeAndFilter_Filter_T filter1;
 
     taskHandleOfFakeFunction = (TaskHandle_t)0x00000001;
@@ -443,8 +665,8 @@ TEST_F(PipeAndFilter, filterRunFailurePipeOutParamOverflow)
      * Somehow the buffer to send out is bigger than the pipe out
      */
     Retcode_T retVal = RETCODE_OK;
-    PipeAndFilter_Pipe_T pipeHandleIn;
-    PipeAndFilter_Pipe_T pipeHandleOut;
+    PipeAndFilter_Pipe_T pipeHandleIn = pipeS;
+    PipeAndFilter_Pipe_T pipeHandleOut = pipeS;
     PipeAndFilter_Filter_T filter1;
 
     taskHandleOfFakeFunction = (TaskHandle_t)0x00000001;
@@ -516,6 +738,791 @@ TEST_F(PipeAndFilter, filterRunFailureNoFunction)
     EXPECT_EQ(UINT32_C(1), Retcode_RaiseError_fake.call_count);
 }
 
+TEST_F(PipeAndFilter, createPoolSuccess)
+{
+    /** @testcase{ PipeAndFilter::createPoolSuccess: }
+     * All buffers are free and point into the memory of the pool
+     */
+    Retcode_T retVal = PipeAndFilter_CreatePool(&pool, poolBuffers, poolMemory, POOL_COUNT, POOL_BUFFER_SIZE);
+
+    EXPECT_EQ(RETCODE_OK, retVal);
+    EXPECT_EQ(UINT32_C(1), xQueueCreate_fake.call_count);
+    EXPECT_EQ(POOL_COUNT, xQueueCreate_fake.arg0_val);
+    EXPECT_EQ(POOL_BUFFER_SIZE, pool.bufferSize);
+    EXPECT_EQ((size_t)POOL_COUNT, FreeBuffers());
+    for (uint32_t i = 0; i < POOL_COUNT; i++)
+    {
+        EXPECT_EQ(&poolMemory[i * POOL_BUFFER_SIZE], poolBuffers[i].data);
+        EXPECT_EQ(POOL_BUFFER_SIZE, poolBuffers[i].size);
+        EXPECT_EQ(&pool, poolBuffers[i].pool);
+    }
+}
+
+TEST_F(PipeAndFilter, createPoolFailure)
+{
+    /** @testcase{ PipeAndFilter::createPoolFailure: }
+     * Invalid parameters or not enough resources left in the heap
+     */
+    EXPECT_EQ(RETCODE_NULL_POINTER, Retcode_GetCode(PipeAndFilter_CreatePool(NULL, poolBuffers, poolMemory, POOL_COUNT, POOL_BUFFER_SIZE)));
+    EXPECT_EQ(RETCODE_NULL_POINTER, Retcode_GetCode(PipeAndFilter_CreatePool(&pool, NULL, poolMemory, POOL_COUNT, POOL_BUFFER_SIZE)));
+    EXPECT_EQ(RETCODE_NULL_POINTER, Retcode_GetCode(PipeAndFilter_CreatePool(&pool, poolBuffers, NULL, POOL_COUNT, POOL_BUFFER_SIZE)));
+    EXPECT_EQ(RETCODE_INVALID_PARAM, Retcode_GetCode(PipeAndFilter_CreatePool(&pool, poolBuffers, poolMemory, 0, POOL_BUFFER_SIZE)));
+    EXPECT_EQ(RETCODE_INVALID_PARAM, Retcode_GetCode(PipeAndFilter_CreatePool(&pool, poolBuffers, poolMemory, POOL_COUNT, 0)));
+    EXPECT_EQ(UINT32_C(0), xQueueCreate_fake.call_count);
+
+    xQueueCreate_fake.custom_fake = NULL;
+    xQueueCreate_fake.return_val = NULL;
+    EXPECT_EQ(RETCODE_OUT_OF_RESOURCES, Retcode_GetCode(PipeAndFilter_CreatePool(&pool, poolBuffers, poolMemory, POOL_COUNT, POOL_BUFFER_SIZE)));
+}
+
+TEST_F(PipeAndFilter, allocateAndReleaseBuffer)
+{
+    /** @testcase{ PipeAndFilter::allocateAndReleaseBuffer: }
+     * Buffers are taken until the pool is empty and can be taken again once released
+     */
+    PipeAndFilter_Buffer_T *buffers[POOL_COUNT];
+    PipeAndFilter_Buffer_T *buffer = &poolBuffers[0];
+    ASSERT_EQ(RETCODE_OK, PipeAndFilter_CreatePool(&pool, poolBuffers, poolMemory, POOL_COUNT, POOL_BUFFER_SIZE));
+
+    for (uint32_t i = 0; i < POOL_COUNT; i++)
+    {
+        EXPECT_EQ(RETCODE_OK, PipeAndFilter_AllocateBuffer(&pool, &buffers[i], 10));
+        EXPECT_EQ(UINT32_C(0), buffers[i]->length);
+        buffers[i]->length = 5;
+    }
+    EXPECT_EQ(pdMS_TO_TICKS(10), xQueueReceive_fake.arg2_val);
+    EXPECT_EQ(RETCODE_OUT_OF_RESOURCES, Retcode_GetCode(PipeAndFilter_AllocateBuffer(&pool, &buffer, 0)));
+    EXPECT_EQ(NULL, buffer);
+
+    EXPECT_EQ(RETCODE_OK, PipeAndFilter_ReleaseBuffer(buffers[2]));
+    EXPECT_EQ(RETCODE_OK, PipeAndFilter_AllocateBuffer(&pool, &buffer, 0));
+    EXPECT_EQ(buffers[2], buffer);
+    EXPECT_EQ(UINT32_C(0), buffer->length);
+
+    EXPECT_EQ(RETCODE_NULL_POINTER, Retcode_GetCode(PipeAndFilter_AllocateBuffer(NULL, &buffer, 0)));
+    EXPECT_EQ(RETCODE_NULL_POINTER, Retcode_GetCode(PipeAndFilter_AllocateBuffer(&pool, NULL, 0)));
+    EXPECT_EQ(RETCODE_NULL_POINTER, Retcode_GetCode(PipeAndFilter_ReleaseBuffer(NULL)));
+}
+
+TEST_F(PipeAndFilter, releaseBufferTwice)
+{
+    /** @testcase{ PipeAndFilter::releaseBufferTwice: }
+     * A pool never holds more buffers than it has
+     */
+    ASSERT_EQ(RETCODE_OK, PipeAndFilter_CreatePool(&pool, poolBuffers, poolMemory, POOL_COUNT, POOL_BUFFER_SIZE));
+
+    EXPECT_EQ(RETCODE_FAILURE, Retcode_GetCode(PipeAndFilter_ReleaseBuffer(&poolBuffers[0])));
+    EXPECT_EQ((size_t)POOL_COUNT, FreeBuffers());
+}
+
+TEST_F(PipeAndFilter, allocateAndReleaseBufferFromISR)
+{
+    /** @testcase{ PipeAndFilter::allocateAndReleaseBufferFromISR: }
+     * The ISR variants of the queue functions are used
+     */
+    PipeAndFilter_Buffer_T *buffer = NULL;
+    ASSERT_EQ(RETCODE_OK, PipeAndFilter_CreatePool(&pool, poolBuffers, poolMemory, POOL_COUNT, POOL_BUFFER_SIZE));
+    HAL_IsInISR_fake.return_val = true;
+    unsigned int sendCount = xQueueSend_fake.call_count;
+
+    EXPECT_EQ(RETCODE_OK, PipeAndFilter_AllocateBufferFromISR(&pool, &buffer));
+    EXPECT_EQ(RETCODE_OK, PipeAndFilter_ReleaseBuffer(buffer));
+
+    EXPECT_EQ(UINT32_C(1), xQueueReceiveFromISR_fake.call_count);
+    EXPECT_EQ(UINT32_C(1), xQueueSendFromISR_fake.call_count);
+    EXPECT_EQ(UINT32_C(0), xQueueReceive_fake.call_count);
+    EXPECT_EQ(sendCount, xQueueSend_fake.call_count);
+    EXPECT_EQ((size_t)POOL_COUNT, FreeBuffers());
+}
+
+TEST_F(PipeAndFilter, createBufferPipe)
+{
+    /** @testcase{ PipeAndFilter::createBufferPipe: }
+     * The pipe holds BUFFER_PIPE_DEPTH buffer pointers
+     */
+    PipeAndFilter_Pipe_T pipeHandle = pipeS;
+
+    EXPECT_EQ(RETCODE_OK, PipeAndFilter_CreateBufferPipe(&pipeHandle));
+    EXPECT_EQ((UBaseType_t)BUFFER_PIPE_DEPTH, xQueueCreate_fake.arg0_val);
+    EXPECT_TRUE(pipeHandle.pipeInternalHandle != NULL);
+    EXPECT_TRUE(pipeHandle.filterInternalHandle == NULL);
+
+    EXPECT_EQ(RETCODE_NULL_POINTER, Retcode_GetCode(PipeAndFilter_CreateBufferPipe(NULL)));
+
+    xQueueCreate_fake.custom_fake = NULL;
+    xQueueCreate_fake.return_val = NULL;
+    EXPECT_EQ(RETCODE_OUT_OF_RESOURCES, Retcode_GetCode(PipeAndFilter_CreateBufferPipe(&pipeHandle)));
+}
+
+TEST_F(PipeAndFilter, fillBufferPipe)
+{
+    /** @testcase{ PipeAndFilter::fillBufferPipe: }
+     * The pipe takes buffers until it is full, the caller keeps the ones not taken
+     */
+    PipeAndFilter_Pipe_T pipeHandle = pipeS;
+    PipeAndFilter_Buffer_T buffer = {poolMemory, 1, POOL_BUFFER_SIZE, &pool};
+    ASSERT_EQ(RETCODE_OK, PipeAndFilter_CreateBufferPipe(&pipeHandle));
+
+    for (uint32_t i = 0; i < BUFFER_PIPE_DEPTH; i++)
+    {
+        EXPECT_EQ(RETCODE_OK, PipeAndFilter_FillBufferPipe(pipeHandle, &buffer));
+    }
+    EXPECT_EQ(RETCODE_OUT_OF_RESOURCES, Retcode_GetCode(PipeAndFilter_FillBufferPipe(pipeHandle, &buffer)));
+    EXPECT_EQ(RETCODE_OUT_OF_RESOURCES, Retcode_GetCode(PipeAndFilter_FillBufferPipeFromISR(pipeHandle, &buffer)));
+    EXPECT_EQ(UINT32_C(1), xQueueSendFromISR_fake.call_count);
+
+    buffer.length = POOL_BUFFER_SIZE + 1U;
+    EXPECT_EQ(RETCODE_INVALID_PARAM, Retcode_GetCode(PipeAndFilter_FillBufferPipe(pipeHandle, &buffer)));
+    EXPECT_EQ(RETCODE_NULL_POINTER, Retcode_GetCode(PipeAndFilter_FillBufferPipe(pipeHandle, NULL)));
+    pipeHandle.pipeInternalHandle = NULL;
+    EXPECT_EQ(RETCODE_NULL_POINTER, Retcode_GetCode(PipeAndFilter_FillBufferPipeFromISR(pipeHandle, &buffer)));
+}
+
+TEST_F(PipeAndFilter, createBufferFilter)
+{
+    /** @testcase{ PipeAndFilter::createBufferFilter: }
+     * The filter task runs the buffer loop
+     */
+    PipeAndFilter_Pipe_T pipeIn = pipeS;
+    PipeAndFilter_Filter_T filter;
+    taskHandleOfFakeFunction = (TaskHandle_t)0x00000001;
+    xTaskCreate_fake.custom_fake = &xTaskCreateCustom;
+
+    EXPECT_EQ(RETCODE_OK, PipeAndFilter_CreateBufferFilter(bufferFilter, &pipeIn, NULL, &filter));
+
+    EXPECT_EQ(UINT32_C(1), xTaskCreate_fake.call_count);
+    EXPECT_EQ((TaskFunction_t)RunBufferFilter, xTaskCreate_fake.arg0_val);
+    EXPECT_EQ(bufferFilter, filter.bufferFilterFunction);
+    EXPECT_TRUE(filter.filterFunction == NULL);
+    EXPECT_EQ(taskHandleOfFakeFunction, pipeIn.filterInternalHandle);
+    EXPECT_EQ(RETCODE_NULL_POINTER, Retcode_GetCode(PipeAndFilter_CreateBufferFilter(bufferFilter, &pipeIn, NULL, NULL)));
+}
+
+TEST_F(PipeAndFilter, bufferFilterRunInPlace)
+{
+    /** @testcase{ PipeAndFilter::bufferFilterRunInPlace: }
+     * The filter changes the buffer in place and it is handed on without a copy
+     */
+    PipeAndFilter_Pipe_T pipeIn = pipeS;
+    PipeAndFilter_Pipe_T pipeOut = pipeS;
+    PipeAndFilter_Filter_T filter;
+    CreateBufferChain(&pipeIn, &pipeOut, &filter);
+    PipeAndFilter_Buffer_T *buffer = FillBuffer(pipeIn, 3);
+
+    RunBufferFilter(&filter);
+
+    std::deque<PipeAndFilter_Buffer_T *> &out = fakeQueues[(QueueHandle_t)pipeOut.pipeInternalHandle].items;
+    ASSERT_EQ(1U, out.size());
+    EXPECT_EQ(buffer, out.front());
+    EXPECT_EQ(UINT32_C(3), buffer->length);
+    EXPECT_EQ(2U, buffer->data[0]);
+    EXPECT_EQ(6U, buffer->data[2]);
+    EXPECT_EQ((size_t)POOL_COUNT - 1U, FreeBuffers());
+    EXPECT_EQ(UINT32_C(0), Retcode_RaiseError_fake.call_count);
+}
+
+TEST_F(PipeAndFilter, bufferFilterRunNewBuffer)
+{
+    /** @testcase{ PipeAndFilter::bufferFilterRunNewBuffer: }
+     * The filter hands on another buffer, the input one goes back to the pool
+     */
+    PipeAndFilter_Pipe_T pipeIn = pipeS;
+    PipeAndFilter_Pipe_T pipeOut = pipeS;
+    PipeAndFilter_Filter_T filter;
+    CreateBufferChain(&pipeIn, &pipeOut, &filter);
+    PipeAndFilter_Buffer_T *buffer = FillBuffer(pipeIn, 3);
+    bufferFilterMode = BUFFER_FILTER_NEW_BUFFER;
+
+    RunBufferFilter(&filter);
+
+    std::deque<PipeAndFilter_Buffer_T *> &out = fakeQueues[(QueueHandle_t)pipeOut.pipeInternalHandle].items;
+    ASSERT_EQ(1U, out.size());
+    EXPECT_NE(buffer, out.front());
+    EXPECT_EQ(42U, out.front()->data[0]);
+    EXPECT_EQ((size_t)POOL_COUNT - 1U, FreeBuffers());
+    EXPECT_EQ(buffer, fakeQueues[(QueueHandle_t)pool.poolInternalHandle].items.back());
+}
+
+TEST_F(PipeAndFilter, bufferFilterRunDrop)
+{
+    /** @testcase{ PipeAndFilter::bufferFilterRunDrop: }
+     * The filter passes nothing on, the input buffer goes back to the pool
+     */
+    PipeAndFilter_Pipe_T pipeIn = pipeS;
+    PipeAndFilter_Pipe_T pipeOut = pipeS;
+    PipeAndFilter_Filter_T filter;
+    CreateBufferChain(&pipeIn, &pipeOut, &filter);
+    (void)FillBuffer(pipeIn, 3);
+    bufferFilterMode = BUFFER_FILTER_DROP;
+
+    RunBufferFilter(&filter);
+
+    EXPECT_TRUE(fakeQueues[(QueueHandle_t)pipeOut.pipeInternalHandle].items.empty());
+    EXPECT_EQ((size_t)POOL_COUNT, FreeBuffers());
+    EXPECT_EQ(UINT32_C(0), Retcode_RaiseError_fake.call_count);
+}
+
+TEST_F(PipeAndFilter, bufferFilterRunFailure)
+{
+    /** @testcase{ PipeAndFilter::bufferFilterRunFailure: }
+     * A buffer of a failed filter or longer than its size is not handed on
+     */
+    PipeAndFilter_Pipe_T pipeIn = pipeS;
+    PipeAndFilter_Pipe_T pipeOut = pipeS;
+    PipeAndFilter_Filter_T filter;
+    CreateBufferChain(&pipeIn, &pipeOut, &filter);
+    (void)FillBuffer(pipeIn, 3);
+    bufferFilterRetcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_FAILURE);
+
+    RunBufferFilter(&filter);
+
+    EXPECT_EQ(UINT32_C(1), Retcode_RaiseError_fake.call_count);
+    EXPECT_EQ(RETCODE_FAILURE, Retcode_GetCode(Retcode_RaiseError_fake.arg0_val));
+
+    (void)FillBuffer(pipeIn, 3);
+    bufferFilterRetcode = RETCODE_OK;
+    bufferFilterMode = BUFFER_FILTER_OVERFLOW;
+
+    RunBufferFilter(&filter);
+
+    EXPECT_EQ(UINT32_C(2), Retcode_RaiseError_fake.call_count);
+    EXPECT_EQ(RETCODE_OUT_OF_RESOURCES, Retcode_GetCode(Retcode_RaiseError_fake.arg0_val));
+    EXPECT_TRUE(fakeQueues[(QueueHandle_t)pipeOut.pipeInternalHandle].items.empty());
+    EXPECT_EQ((size_t)POOL_COUNT, FreeBuffers());
+}
+
+TEST_F(PipeAndFilter, bufferFilterRunNoPipes)
+{
+    /** @testcase{ PipeAndFilter::bufferFilterRunNoPipes: }
+     * A source gets no buffer, the buffers of a sink go back to the pool
+     */
+    PipeAndFilter_Pipe_T pipeIn = pipeS;
+    PipeAndFilter_Filter_T source;
+    PipeAndFilter_Filter_T sink;
+    CreateBufferChain(NULL, NULL, &source);
+    bufferFilterMode = BUFFER_FILTER_NEW_BUFFER;
+
+    RunBufferFilter(&source);
+
+    EXPECT_TRUE(bufferFilterIn == NULL);
+    EXPECT_EQ((size_t)POOL_COUNT, FreeBuffers());
+
+    ASSERT_EQ(RETCODE_OK, PipeAndFilter_CreateBufferPipe(&pipeIn));
+    ASSERT_EQ(RETCODE_OK, PipeAndFilter_CreateBufferFilter(bufferFilter, &pipeIn, NULL, &sink));
+    bufferFilterMode = BUFFER_FILTER_IN_PLACE;
+    PipeAndFilter_Buffer_T *buffer = FillBuffer(pipeIn, 3);
+
+    RunBufferFilter(&sink);
+
+    EXPECT_EQ(buffer, bufferFilterIn);
+    EXPECT_EQ((size_t)POOL_COUNT, FreeBuffers());
+    EXPECT_EQ(UINT32_C(0), Retcode_RaiseError_fake.call_count);
+}
+
+TEST_F(PipeAndFilter, bufferFilterRunNoFunction)
+{
+    /** @testcase{ PipeAndFilter::bufferFilterRunNoFunction: }
+     * No context or no buffer filter function
+     */
+    PipeAndFilter_Filter_T filterContext;
+    filterContext.bufferFilterFunction = NULL;
+
+    RunBufferFilter(NULL);
+    RunBufferFilter(&filterContext);
+
+    EXPECT_EQ(UINT32_C(2), Retcode_RaiseError_fake.call_count);
+    EXPECT_EQ(UINT32_C(0), xQueueReceive_fake.call_count);
+}
+
+TEST_F(PipeAndFilter, createFusedFilter)
+{
+    /** @testcase{ PipeAndFilter::createFusedFilter: }
+     * One task runs all the stages, whose statistics start at 0
+     */
+    PipeAndFilter_Pipe_T pipeIn = pipeS;
+    PipeAndFilter_Filter_T filter;
+    PipeAndFilter_Stage_T stages[2];
+    stages[0].filterFunction = stageIncrement;
+    stages[0].statistics.messagesIn = 7;
+    stages[1].filterFunction = stageDouble;
+    stages[1].statistics.errors = 7;
+    taskHandleOfFakeFunction = (TaskHandle_t)0x00000001;
+    xTaskCreate_fake.custom_fake = &xTaskCreateCustom;
+
+    EXPECT_EQ(RETCODE_OK, PipeAndFilter_CreateFusedFilter(stages, 2, &pipeIn, NULL, &filter));
+
+    EXPECT_EQ(UINT32_C(1), xTaskCreate_fake.call_count);
+    EXPECT_EQ((TaskFunction_t)RunFilter, xTaskCreate_fake.arg0_val);
+    EXPECT_EQ(stages, filter.stages);
+    EXPECT_EQ(UINT32_C(2), filter.stageCount);
+    EXPECT_EQ(UINT32_C(1), filter.batchSize);
+    EXPECT_EQ(UINT32_C(0), stages[0].statistics.messagesIn);
+    EXPECT_EQ(UINT32_C(0), stages[1].statistics.errors);
+}
+
+TEST_F(PipeAndFilter, createFusedFilterFailure)
+{
+    /** @testcase{ PipeAndFilter::createFusedFilterFailure: }
+     * Missing stages or functions
+     */
+    PipeAndFilter_Filter_T filter;
+    PipeAndFilter_Stage_T stages[2];
+    stages[0].filterFunction = stageIncrement;
+    stages[1].filterFunction = NULL;
+
+    EXPECT_EQ(RETCODE_NULL_POINTER, Retcode_GetCode(PipeAndFilter_CreateFusedFilter(NULL, 1, NULL, NULL, &filter)));
+    EXPECT_EQ(RETCODE_NULL_POINTER, Retcode_GetCode(PipeAndFilter_CreateFusedFilter(stages, 1, NULL, NULL, NULL)));
+    EXPECT_EQ(RETCODE_NULL_POINTER, Retcode_GetCode(PipeAndFilter_CreateFusedFilter(stages, 2, NULL, NULL, &filter)));
+    EXPECT_EQ(RETCODE_INVALID_PARAM, Retcode_GetCode(PipeAndFilter_CreateFusedFilter(stages, 0, NULL, NULL, &filter)));
+    EXPECT_EQ(UINT32_C(0), xTaskCreate_fake.call_count);
+}
+
+TEST_F(PipeAndFilter, fusedFilterRunChain)
+{
+    /** @testcase{ PipeAndFilter::fusedFilterRunChain: }
+     * Each stage works on the output of the previous one, the last output is sent
+     */
+    PipeAndFilter_Pipe_T pipeIn = pipeS;
+    PipeAndFilter_Pipe_T pipeOut = pipeS;
+    PipeAndFilter_Filter_T filter;
+    PipeAndFilter_Stage_T stages[3];
+    PipeAndFilter_Statistics_T statistics;
+    stages[0].filterFunction = stageIncrement;
+    stages[1].filterFunction = stageDouble;
+    stages[2].filterFunction = stageKeep;
+    stageKeepBytes = 2;
+    taskHandleOfFakeFunction = (TaskHandle_t)0x00000001;
+    xTaskCreate_fake.custom_fake = &xTaskCreateCustom;
+    xStreamBufferReceive_fake.custom_fake = xStreamBufferReceiveCustom;
+    xStreamBufferSend_fake.custom_fake = xStreamBufferSendCustom;
+    ASSERT_EQ(RETCODE_OK, PipeAndFilter_CreateFusedFilter(stages, 3, &pipeIn, &pipeOut, &filter));
+
+    RunFilter(&filter);
+
+    ASSERT_EQ(1U, sentMessages.size());
+    EXPECT_EQ(std::vector<uint8_t>({4, 6}), sentMessages[0]);
+    EXPECT_EQ(UINT32_C(1), xStreamBufferReceive_fake.call_count);
+    EXPECT_EQ(UINT32_C(0), Retcode_RaiseError_fake.call_count);
+
+    ASSERT_EQ(RETCODE_OK, PipeAndFilter_GetStatistics(&filter, 0, &statistics));
+    EXPECT_EQ(UINT32_C(1), statistics.activations);
+    EXPECT_EQ(UINT32_C(1), statistics.messagesIn);
+    EXPECT_EQ(UINT32_C(3), statistics.bytesIn);
+    EXPECT_EQ(UINT32_C(1), statistics.messagesOut);
+    EXPECT_EQ(UINT32_C(3), statistics.bytesOut);
+    ASSERT_EQ(RETCODE_OK, PipeAndFilter_GetStatistics(&filter, 2, &statistics));
+    EXPECT_EQ(UINT32_C(0), statistics.activations);
+    EXPECT_EQ(UINT32_C(3), statistics.bytesIn);
+    EXPECT_EQ(UINT32_C(1), statistics.messagesOut);
+    EXPECT_EQ(UINT32_C(2), statistics.bytesOut);
+}
+
+TEST_F(PipeAndFilter, fusedFilterRunStops)
+{
+    /** @testcase{ PipeAndFilter::fusedFilterRunStops: }
+     * A stage without output or with an error ends the chain
+     */
+    PipeAndFilter_Pipe_T pipeIn = pipeS;
+    PipeAndFilter_Pipe_T pipeOut = pipeS;
+    PipeAndFilter_Filter_T filter;
+    PipeAndFilter_Stage_T stages[3];
+    stages[0].filterFunction = stageKeep;
+    stages[1].filterFunction = stageDouble;
+    stages[2].filterFunction = stageIncrement;
+    stageKeepBytes = 0;
+    taskHandleOfFakeFunction = (TaskHandle_t)0x00000001;
+    xTaskCreate_fake.custom_fake = &xTaskCreateCustom;
+    xStreamBufferReceive_fake.custom_fake = xStreamBufferReceiveCustom;
+    xStreamBufferSend_fake.custom_fake = xStreamBufferSendCustom;
+    ASSERT_EQ(RETCODE_OK, PipeAndFilter_CreateFusedFilter(stages, 3, &pipeIn, &pipeOut, &filter));
+
+    RunFilter(&filter);
+
+    EXPECT_TRUE(sentMessages.empty());
+    EXPECT_EQ(UINT32_C(1), stages[0].statistics.messagesIn);
+    EXPECT_EQ(UINT32_C(0), stages[0].statistics.messagesOut);
+    EXPECT_EQ(UINT32_C(0), stages[1].statistics.messagesIn);
+    EXPECT_EQ(UINT32_C(0), Retcode_RaiseError_fake.call_count);
+
+    stageKeepBytes = PIPE_SIZE;
+    stageRetcode = RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_FAILURE);
+
+    RunFilter(&filter);
+
+    EXPECT_TRUE(sentMessages.empty());
+    EXPECT_EQ(UINT32_C(1), stages[1].statistics.errors);
+    EXPECT_EQ(UINT32_C(0), stages[2].statistics.messagesIn);
+    EXPECT_EQ(UINT32_C(1), Retcode_RaiseError_fake.call_count);
+    EXPECT_EQ(RETCODE_FAILURE, Retcode_GetCode(Retcode_RaiseError_fake.arg0_val));
+}
+
+TEST_F(PipeAndFilter, filterRunBatch)
+{
+    /** @testcase{ PipeAndFilter::filterRunBatch: }
+     * The messages waiting are received without blocking, up to the batch size
+     */
+    PipeAndFilter_Pipe_T pipeIn = pipeS;
+    PipeAndFilter_Pipe_T pipeOut = pipeS;
+    PipeAndFilter_Filter_T filter;
+    size_t received[] = {5, 5, 5, 0};
+    taskHandleOfFakeFunction = (TaskHandle_t)0x00000001;
+    xTaskCreate_fake.custom_fake = &xTaskCreateCustom;
+    xStreamBufferSend_fake.custom_fake = xStreamBufferSendCustom;
+    functionA_fake.custom_fake = &filterCustom;
+    retcodeFakeValue = RETCODE_OK;
+    sizeBuffOutFakeValue = 5;
+    ASSERT_EQ(RETCODE_OK, PipeAndFilter_CreateFilter((PipeAndFilter_FilterFunction_T)functionA, &pipeIn, &pipeOut, &filter));
+    ASSERT_EQ(RETCODE_OK, PipeAndFilter_SetBatchSize(&filter, PIPEANDFILTER_BATCH_ALL));
+    SET_RETURN_SEQ(xStreamBufferReceive, received, 4);
+
+    RunFilter(&filter);
+
+    EXPECT_EQ(UINT32_C(4), xStreamBufferReceive_fake.call_count);
+    EXPECT_EQ(portMAX_DELAY, xStreamBufferReceive_fake.arg3_history[0]);
+    EXPECT_EQ(0U, xStreamBufferReceive_fake.arg3_history[1]);
+    EXPECT_EQ(0U, xStreamBufferReceive_fake.arg3_history[3]);
+    EXPECT_EQ(3U, sentMessages.size());
+    EXPECT_EQ(UINT32_C(1), filter.stage.statistics.activations);
+    EXPECT_EQ(UINT32_C(3), filter.stage.statistics.messagesIn);
+    EXPECT_EQ(UINT32_C(15), filter.stage.statistics.bytesOut);
+
+    RESET_FAKE(xStreamBufferReceive);
+    xStreamBufferReceive_fake.return_val = 5;
+    ASSERT_EQ(RETCODE_OK, PipeAndFilter_SetBatchSize(&filter, 2));
+
+    RunFilter(&filter);
+
+    EXPECT_EQ(UINT32_C(2), xStreamBufferReceive_fake.call_count);
+    EXPECT_EQ(UINT32_C(2), filter.stage.statistics.activations);
+    EXPECT_EQ(UINT32_C(5), filter.stage.statistics.messagesIn);
+}
+
+TEST_F(PipeAndFilter, filterRunHighWater)
+{
+    /** @testcase{ PipeAndFilter::filterRunHighWater: }
+     * The bytes waiting in the input pipe when the filter wakes up are tracked
+     */
+    PipeAndFilter_Pipe_T pipeIn = pipeS;
+    PipeAndFilter_Filter_T filter;
+    taskHandleOfFakeFunction = (TaskHandle_t)0x00000001;
+    xTaskCreate_fake.custom_fake = &xTaskCreateCustom;
+    functionA_fake.custom_fake = &filterCustom;
+    retcodeFakeValue = RETCODE_OK;
+    sizeBuffOutFakeValue = 0;
+    xStreamBufferReceive_fake.return_val = 5;
+    ASSERT_EQ(RETCODE_OK, PipeAndFilter_CreateFilter((PipeAndFilter_FilterFunction_T)functionA, &pipeIn, NULL, &filter));
+
+    xStreamBufferSpacesAvailable_fake.return_val = PIPE_SIZE - 20;
+    RunFilter(&filter);
+    xStreamBufferSpacesAvailable_fake.return_val = PIPE_SIZE;
+    RunFilter(&filter);
+
+    EXPECT_EQ(UINT32_C(25), filter.stage.statistics.pipeInHighWater);
+    EXPECT_EQ(UINT32_C(0), filter.stage.statistics.messagesOut);
+}
+
+TEST_F(PipeAndFilter, statisticsAndBatchSizeFailure)
+{
+    /** @testcase{ PipeAndFilter::statisticsAndBatchSizeFailure: }
+     * Invalid parameters
+     */
+    PipeAndFilter_Filter_T filter;
+    PipeAndFilter_Statistics_T statistics;
+    taskHandleOfFakeFunction = (TaskHandle_t)0x00000001;
+    xTaskCreate_fake.custom_fake = &xTaskCreateCustom;
+    ASSERT_EQ(RETCODE_OK, PipeAndFilter_CreateFilter((PipeAndFilter_FilterFunction_T)functionA, NULL, NULL, &filter));
+
+    EXPECT_EQ(RETCODE_NULL_POINTER, Retcode_GetCode(PipeAndFilter_SetBatchSize(NULL, 1)));
+    EXPECT_EQ(RETCODE_INVALID_PARAM, Retcode_GetCode(PipeAndFilter_SetBatchSize(&filter, 0)));
+    EXPECT_EQ(RETCODE_NULL_POINTER, Retcode_GetCode(PipeAndFilter_GetStatistics(NULL, 0, &statistics)));
+    EXPECT_EQ(RETCODE_NULL_POINTER, Retcode_GetCode(PipeAndFilter_GetStatistics(&filter, 0, NULL)));
+    EXPECT_EQ(RETCODE_INVALID_PARAM, Retcode_GetCode(PipeAndFilter_GetStatistics(&filter, 1, &statistics)));
+    EXPECT_EQ(RETCODE_NULL_POINTER, Retcode_GetCode(PipeAndFilter_ResetStatistics(NULL)));
+}
+
+TEST_F(PipeAndFilter, resetStatistics)
+{
+    /** @testcase{ PipeAndFilter::resetStatistics: }
+     * All the counters of all the stages start again at 0
+     */
+    PipeAndFilter_Filter_T filter;
+    PipeAndFilter_Statistics_T statistics;
+    taskHandleOfFakeFunction = (TaskHandle_t)0x00000001;
+    xTaskCreate_fake.custom_fake = &xTaskCreateCustom;
+    functionA_fake.custom_fake = &filterCustom;
+    retcodeFakeValue = RETCODE_OK;
+    sizeBuffOutFakeValue = 5;
+    ASSERT_EQ(RETCODE_OK, PipeAndFilter_CreateFilter((PipeAndFilter_FilterFunction_T)functionA, NULL, NULL, &filter));
+    RunFilter(&filter);
+    ASSERT_EQ(RETCODE_OK, PipeAndFilter_GetStatistics(&filter, 0, &statistics));
+    ASSERT_EQ(UINT32_C(1), statistics.messagesOut);
+
+    EXPECT_EQ(RETCODE_OK, PipeAndFilter_ResetStatistics(&filter));
+
+    ASSERT_EQ(RETCODE_OK, PipeAndFilter_GetStatistics(&filter, 0, &statistics));
+    EXPECT_EQ(UINT32_C(0), statistics.activations);
+    EXPECT_EQ(UINT32_C(0), statistics.messagesIn);
+    EXPECT_EQ(UINT32_C(0), statistics.messagesOut);
+    EXPECT_EQ(UINT32_C(0), statistics.bytesOut);
+}
+
+TEST_F(PipeAndFilter, bufferFilterRunBatch)
+{
+    /** @testcase{ PipeAndFilter::bufferFilterRunBatch: }
+     * All the buffers waiting are processed in one activation
+     */
+    PipeAndFilter_Pipe_T pipeIn = pipeS;
+    PipeAndFilter_Pipe_T pipeOut = pipeS;
+    PipeAndFilter_Filter_T filter;
+    CreateBufferChain(&pipeIn, &pipeOut, &filter);
+    ASSERT_EQ(RETCODE_OK, PipeAndFilter_SetBatchSize(&filter, PIPEANDFILTER_BATCH_ALL));
+    (void)FillBuffer(pipeIn, 1);
+    (void)FillBuffer(pipeIn, 2);
+    (void)FillBuffer(pipeIn, 3);
+
+    RunBufferFilter(&filter);
+
+    EXPECT_EQ(3U, fakeQueues[(QueueHandle_t)pipeOut.pipeInternalHandle].items.size());
+    EXPECT_TRUE(fakeQueues[(QueueHandle_t)pipeIn.pipeInternalHandle].items.empty());
+    EXPECT_EQ(UINT32_C(1), filter.stage.statistics.activations);
+    EXPECT_EQ(UINT32_C(3), filter.stage.statistics.messagesIn);
+    EXPECT_EQ(UINT32_C(6), filter.stage.statistics.bytesIn);
+    EXPECT_EQ(UINT32_C(3), filter.stage.statistics.messagesOut);
+    EXPECT_EQ(UINT32_C(3), filter.stage.statistics.pipeInHighWater);
+    EXPECT_EQ(UINT32_C(0), filter.stage.statistics.errors);
+}
+
+TEST_F(PipeAndFilter, createMergePipe)
+{
+    /** @testcase{ PipeAndFilter::createMergePipe: }
+     * The writers of a merge pipe take turns with a mutex
+     */
+    PipeAndFilter_Pipe_T pipeHandle;
+    xStreamBufferGenericCreate_fake.return_val = (StreamBufferHandle_t)0x00000002;
+    xSemaphoreCreateMutex_fake.return_val = (SemaphoreHandle_t)0x00000003;
+
+    EXPECT_EQ(RETCODE_OK, PipeAndFilter_CreateMergePipe(&pipeHandle));
+
+    EXPECT_EQ((PipeAndFilter_PipeInternalHandle_T)0x00000002, pipeHandle.pipeInternalHandle);
+    EXPECT_EQ((PipeAndFilter_LockInternalHandle_T)0x00000003, pipeHandle.lockInternalHandle);
+    EXPECT_EQ(PIPEANDFILTER_POLICY_BLOCK, pipeHandle.policy);
+    EXPECT_FALSE(pipeHandle.isBufferPipe);
+    EXPECT_EQ(UINT32_C(0), PipeAndFilter_GetDropped(&pipeHandle));
+
+    xSemaphoreCreateMutex_fake.return_val = NULL;
+    EXPECT_EQ(RETCODE_OUT_OF_RESOURCES, Retcode_GetCode(PipeAndFilter_CreateMergePipe(&pipeHandle)));
+    EXPECT_EQ(UINT32_C(1), vStreamBufferDelete_fake.call_count);
+    EXPECT_TRUE(pipeHandle.pipeInternalHandle == NULL);
+    EXPECT_EQ(RETCODE_NULL_POINTER, Retcode_GetCode(PipeAndFilter_CreateMergePipe(NULL)));
+}
+
+TEST_F(PipeAndFilter, fillMergePipe)
+{
+    /** @testcase{ PipeAndFilter::fillMergePipe: }
+     * A task fills a merge pipe holding its mutex, an ISR cannot
+     */
+    PipeAndFilter_Pipe_T pipeHandle = pipeS;
+    uint8_t buffer[5] = {1, 2, 3, 4, 5};
+    pipeHandle.lockInternalHandle = (PipeAndFilter_LockInternalHandle_T)0x00000003;
+    xSemaphoreTake_fake.return_val = pdTRUE;
+    xStreamBufferSend_fake.return_val = 5;
+
+    EXPECT_EQ(RETCODE_OK, PipeAndFilter_FillPipe(pipeHandle, buffer, sizeof(buffer)));
+    EXPECT_EQ(UINT32_C(1), xSemaphoreTake_fake.call_count);
+    EXPECT_EQ(UINT32_C(1), xSemaphoreGive_fake.call_count);
+
+    EXPECT_EQ(RETCODE_NOT_SUPPORTED, Retcode_GetCode(PipeAndFilter_FillPipeFromISR(pipeHandle, buffer, sizeof(buffer))));
+    EXPECT_EQ(UINT32_C(0), xStreamBufferSendFromISR_fake.call_count);
+}
+
+TEST_F(PipeAndFilter, setPolicy)
+{
+    /** @testcase{ PipeAndFilter::setPolicy: }
+     * Only buffer pipes may drop their oldest messages
+     */
+    PipeAndFilter_Pipe_T bytePipe = pipeS;
+    PipeAndFilter_Pipe_T bufferPipe;
+    ASSERT_EQ(RETCODE_OK, PipeAndFilter_CreateBufferPipe(&bufferPipe));
+
+    EXPECT_EQ(RETCODE_OK, PipeAndFilter_SetPolicy(&bytePipe, PIPEANDFILTER_POLICY_DROP_NEWEST));
+    EXPECT_EQ(PIPEANDFILTER_POLICY_DROP_NEWEST, bytePipe.policy);
+    EXPECT_EQ(RETCODE_NOT_SUPPORTED, Retcode_GetCode(PipeAndFilter_SetPolicy(&bytePipe, PIPEANDFILTER_POLICY_DROP_OLDEST)));
+    EXPECT_EQ(RETCODE_OK, PipeAndFilter_SetPolicy(&bufferPipe, PIPEANDFILTER_POLICY_DROP_OLDEST));
+    EXPECT_EQ(PIPEANDFILTER_POLICY_DROP_OLDEST, bufferPipe.policy);
+    EXPECT_EQ(RETCODE_INVALID_PARAM, Retcode_GetCode(PipeAndFilter_SetPolicy(&bufferPipe, (PipeAndFilter_Policy_T)3)));
+    EXPECT_EQ(RETCODE_NULL_POINTER, Retcode_GetCode(PipeAndFilter_SetPolicy(NULL, PIPEANDFILTER_POLICY_BLOCK)));
+    EXPECT_EQ(UINT32_C(0), PipeAndFilter_GetDropped(NULL));
+}
+
+TEST_F(PipeAndFilter, setOutputPipes)
+{
+    /** @testcase{ PipeAndFilter::setOutputPipes: }
+     * The output pipes must carry the kind of data of the filter
+     */
+    PipeAndFilter_Pipe_T bytePipe = pipeS;
+    PipeAndFilter_Pipe_T bufferPipe;
+    PipeAndFilter_Filter_T filter;
+    PipeAndFilter_Pipe_T *outputs[] = {&bytePipe, &bytePipe};
+    PipeAndFilter_Pipe_T *mixed[] = {&bytePipe, &bufferPipe};
+    PipeAndFilter_Pipe_T *missing[] = {&bytePipe, NULL};
+    taskHandleOfFakeFunction = (TaskHandle_t)0x00000001;
+    xTaskCreate_fake.custom_fake = &xTaskCreateCustom;
+    ASSERT_EQ(RETCODE_OK, PipeAndFilter_CreateBufferPipe(&bufferPipe));
+    ASSERT_EQ(RETCODE_OK, PipeAndFilter_CreateFilter((PipeAndFilter_FilterFunction_T)functionA, NULL, &bytePipe, &filter));
+    EXPECT_EQ(UINT32_C(1), filter.pipeOutCount);
+
+    EXPECT_EQ(RETCODE_OK, PipeAndFilter_SetOutputPipes(&filter, outputs, 2));
+    EXPECT_EQ(outputs, filter.pipeOutHandles);
+    EXPECT_EQ(UINT32_C(2), filter.pipeOutCount);
+    EXPECT_EQ(RETCODE_INVALID_PARAM, Retcode_GetCode(PipeAndFilter_SetOutputPipes(&filter, mixed, 2)));
+    EXPECT_EQ(RETCODE_NULL_POINTER, Retcode_GetCode(PipeAndFilter_SetOutputPipes(&filter, missing, 2)));
+    EXPECT_EQ(RETCODE_NULL_POINTER, Retcode_GetCode(PipeAndFilter_SetOutputPipes(&filter, NULL, 1)));
+    EXPECT_EQ(RETCODE_NULL_POINTER, Retcode_GetCode(PipeAndFilter_SetOutputPipes(NULL, outputs, 1)));
+    EXPECT_EQ(RETCODE_OK, PipeAndFilter_SetOutputPipes(&filter, NULL, 0));
+    EXPECT_EQ(UINT32_C(0), filter.pipeOutCount);
+}
+
+TEST_F(PipeAndFilter, filterRunFanOut)
+{
+    /** @testcase{ PipeAndFilter::filterRunFanOut: }
+     * Every output pipe gets a copy, a full dropping pipe does not stop the others
+     */
+    PipeAndFilter_Pipe_T pipeIn = pipeS;
+    PipeAndFilter_Pipe_T fast = pipeS;
+    PipeAndFilter_Pipe_T slow = pipeS;
+    PipeAndFilter_Pipe_T *outputs[] = {&slow, &fast};
+    PipeAndFilter_Filter_T filter;
+    size_t sent[] = {0, 5};
+    taskHandleOfFakeFunction = (TaskHandle_t)0x00000001;
+    xTaskCreate_fake.custom_fake = &xTaskCreateCustom;
+    functionA_fake.custom_fake = &filterCustom;
+    retcodeFakeValue = RETCODE_OK;
+    sizeBuffOutFakeValue = 5;
+    xStreamBufferReceive_fake.return_val = 5;
+    fast.pipeInternalHandle = (PipeAndFilter_PipeInternalHandle_T)0x00000002;
+    slow.pipeInternalHandle = (PipeAndFilter_PipeInternalHandle_T)0x00000003;
+    ASSERT_EQ(RETCODE_OK, PipeAndFilter_SetPolicy(&slow, PIPEANDFILTER_POLICY_DROP_NEWEST));
+    ASSERT_EQ(RETCODE_OK, PipeAndFilter_CreateFilter((PipeAndFilter_FilterFunction_T)functionA, &pipeIn, NULL, &filter));
+    ASSERT_EQ(RETCODE_OK, PipeAndFilter_SetOutputPipes(&filter, outputs, 2));
+    SET_RETURN_SEQ(xStreamBufferSend, sent, 2);
+
+    RunFilter(&filter);
+
+    ASSERT_EQ(UINT32_C(2), xStreamBufferSend_fake.call_count);
+    EXPECT_EQ((StreamBufferHandle_t)slow.pipeInternalHandle, xStreamBufferSend_fake.arg0_history[0]);
+    EXPECT_EQ(0U, xStreamBufferSend_fake.arg3_history[0]);
+    EXPECT_EQ((StreamBufferHandle_t)fast.pipeInternalHandle, xStreamBufferSend_fake.arg0_history[1]);
+    EXPECT_EQ(portMAX_DELAY, xStreamBufferSend_fake.arg3_history[1]);
+    EXPECT_EQ(UINT32_C(1), PipeAndFilter_GetDropped(&slow));
+    EXPECT_EQ(UINT32_C(0), PipeAndFilter_GetDropped(&fast));
+    EXPECT_EQ(UINT32_C(1), filter.stage.statistics.messagesOut);
+    EXPECT_EQ(UINT32_C(0), Retcode_RaiseError_fake.call_count);
+}
+
+TEST_F(PipeAndFilter, filterRunMerge)
+{
+    /** @testcase{ PipeAndFilter::filterRunMerge: }
+     * A filter writes to a merge pipe holding its mutex
+     */
+    PipeAndFilter_Pipe_T pipeIn = pipeS;
+    PipeAndFilter_Pipe_T pipeOut = pipeS;
+    PipeAndFilter_Filter_T filter;
+    taskHandleOfFakeFunction = (TaskHandle_t)0x00000001;
+    xTaskCreate_fake.custom_fake = &xTaskCreateCustom;
+    functionA_fake.custom_fake = &filterCustom;
+    retcodeFakeValue = RETCODE_OK;
+    sizeBuffOutFakeValue = 5;
+    xStreamBufferReceive_fake.return_val = 5;
+    xStreamBufferSend_fake.return_val = 5;
+    pipeOut.lockInternalHandle = (PipeAndFilter_LockInternalHandle_T)0x00000003;
+    ASSERT_EQ(RETCODE_OK, PipeAndFilter_CreateFilter((PipeAndFilter_FilterFunction_T)functionA, &pipeIn, &pipeOut, &filter));
+
+    xSemaphoreTake_fake.return_val = pdTRUE;
+    RunFilter(&filter);
+
+    EXPECT_EQ(UINT32_C(1), xSemaphoreTake_fake.call_count);
+    EXPECT_EQ(UINT32_C(1), xSemaphoreGive_fake.call_count);
+    EXPECT_EQ(UINT32_C(1), xStreamBufferSend_fake.call_count);
+    EXPECT_EQ(UINT32_C(0), Retcode_RaiseError_fake.call_count);
+
+    xSemaphoreTake_fake.return_val = pdFALSE;
+    RunFilter(&filter);
+
+    EXPECT_EQ(UINT32_C(1), xStreamBufferSend_fake.call_count);
+    EXPECT_EQ(UINT32_C(1), Retcode_RaiseError_fake.call_count);
+    EXPECT_EQ(RETCODE_SEMAPHORE_ERROR, Retcode_GetCode(Retcode_RaiseError_fake.arg0_val));
+    EXPECT_EQ(UINT32_C(1), filter.stage.statistics.errors);
+}
+
+TEST_F(PipeAndFilter, bufferFilterRunFanOut)
+{
+    /** @testcase{ PipeAndFilter::bufferFilterRunFanOut: }
+     * The output pipes share the buffer, it goes back to the pool once both released it
+     */
+    PipeAndFilter_Pipe_T pipeIn;
+    PipeAndFilter_Pipe_T first;
+    PipeAndFilter_Pipe_T second;
+    PipeAndFilter_Pipe_T *outputs[] = {&first, &second};
+    PipeAndFilter_Filter_T filter;
+    CreateBufferChain(&pipeIn, NULL, &filter);
+    ASSERT_EQ(RETCODE_OK, PipeAndFilter_CreateBufferPipe(&first));
+    ASSERT_EQ(RETCODE_OK, PipeAndFilter_CreateBufferPipe(&second));
+    ASSERT_EQ(RETCODE_OK, PipeAndFilter_SetOutputPipes(&filter, outputs, 2));
+    PipeAndFilter_Buffer_T *buffer = FillBuffer(pipeIn, 3);
+
+    RunBufferFilter(&filter);
+
+    EXPECT_EQ(buffer, fakeQueues[(QueueHandle_t)first.pipeInternalHandle].items.front());
+    EXPECT_EQ(buffer, fakeQueues[(QueueHandle_t)second.pipeInternalHandle].items.front());
+    EXPECT_EQ(UINT32_C(2), buffer->references);
+    EXPECT_EQ((size_t)POOL_COUNT - 1U, FreeBuffers());
+
+    EXPECT_EQ(RETCODE_OK, PipeAndFilter_ReleaseBuffer(buffer));
+    EXPECT_EQ((size_t)POOL_COUNT - 1U, FreeBuffers());
+    EXPECT_EQ(RETCODE_OK, PipeAndFilter_ReleaseBuffer(buffer));
+    EXPECT_EQ((size_t)POOL_COUNT, FreeBuffers());
+    EXPECT_EQ(RETCODE_FAILURE, Retcode_GetCode(PipeAndFilter_ReleaseBuffer(buffer)));
+}
+
+TEST_F(PipeAndFilter, bufferFilterRunPolicies)
+{
+    /** @testcase{ PipeAndFilter::bufferFilterRunPolicies: }
+     * A full pipe drops its oldest buffer or the new one, both go back to the pool
+     */
+    PipeAndFilter_Pipe_T pipeIn;
+    PipeAndFilter_Pipe_T latest;
+    PipeAndFilter_Pipe_T earliest;
+    PipeAndFilter_Pipe_T *outputs[] = {&latest, &earliest};
+    PipeAndFilter_Filter_T filter;
+    PipeAndFilter_Buffer_T *buffers[3];
+    CreateBufferChain(&pipeIn, NULL, &filter);
+    ASSERT_EQ(RETCODE_OK, PipeAndFilter_CreateBufferPipe(&latest));
+    ASSERT_EQ(RETCODE_OK, PipeAndFilter_CreateBufferPipe(&earliest));
+    ASSERT_EQ(RETCODE_OK, PipeAndFilter_SetPolicy(&latest, PIPEANDFILTER_POLICY_DROP_OLDEST));
+    ASSERT_EQ(RETCODE_OK, PipeAndFilter_SetPolicy(&earliest, PIPEANDFILTER_POLICY_DROP_NEWEST));
+    ASSERT_EQ(RETCODE_OK, PipeAndFilter_SetOutputPipes(&filter, outputs, 2));
+    fakeQueues[(QueueHandle_t)latest.pipeInternalHandle].length = 2;
+    fakeQueues[(QueueHandle_t)earliest.pipeInternalHandle].length = 2;
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        buffers[i] = FillBuffer(pipeIn, i + 1U);
+        RunBufferFilter(&filter);
+    }
+
+    std::deque<PipeAndFilter_Buffer_T *> &latestItems = fakeQueues[(QueueHandle_t)latest.pipeInternalHandle].items;
+    std::deque<PipeAndFilter_Buffer_T *> &earliestItems = fakeQueues[(QueueHandle_t)earliest.pipeInternalHandle].items;
+    EXPECT_EQ(std::deque<PipeAndFilter_Buffer_T *>({buffers[1], buffers[2]}), latestItems);
+    EXPECT_EQ(std::deque<PipeAndFilter_Buffer_T *>({buffers[0], buffers[1]}), earliestItems);
+    EXPECT_EQ(UINT32_C(1), PipeAndFilter_GetDropped(&latest));
+    EXPECT_EQ(UINT32_C(1), PipeAndFilter_GetDropped(&earliest));
+    EXPECT_EQ(UINT32_C(1), buffers[0]->references);
+    EXPECT_EQ(UINT32_C(2), buffers[1]->references);
+    EXPECT_EQ(UINT32_C(1), buffers[2]->references);
+    EXPECT_EQ((size_t)POOL_COUNT - 3U, FreeBuffers());
+    EXPECT_EQ(UINT32_C(0), Retcode_RaiseError_fake.call_count);
+}
+
 #else
 }
 
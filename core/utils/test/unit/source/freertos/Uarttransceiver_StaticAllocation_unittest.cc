@@ -0,0 +1,111 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ *
+ * @brief
+ *      Module test specification for the UARTTransceiver module created in storage given by the caller.
+ *
+ * @detail
+ *      The unit test file template follows the Four-Phase test pattern.
+ *
+ * @file
+ **/
+
+/* Include gtest interface */
+#include <gtest.h>
+
+/* Start of global scope symbol and fake definitions section */
+extern "C"
+{
+/* Setup compile time configuration defines */
+#define KISO_UTILS_STATIC_ALLOCATION 1
+
+#include "Kiso_Utils.h"
+#undef KISO_MODULE_ID
+#define KISO_MODULE_ID KISO_UTILS_MODULE_ID_UART_TRANSCEIVER
+
+#if KISO_FEATURE_UARTTRANSCEIVER
+
+/* Include faked interfaces */
+#include "Kiso_Assert_th.hh"
+#include "Kiso_Retcode_th.hh"
+#include "Kiso_RingBuffer_th.hh"
+#include "Kiso_MCU_UART_th.hh"
+#include "FreeRTOS_th.hh"
+#include "semphr_th.hh"
+#include "task_th.hh"
+
+/* Include module under test */
+#include "UartTransceiver.c"
+
+    /* End of global scope symbol and fake definitions section */
+}
+
+class UARTTransceiverStatic : public testing::Test
+{
+protected:
+    UARTTransceiver_T Transceiver;
+    UARTTransceiver_Storage_T Storage;
+    uint8_t RawRxBuffer[4];
+
+    virtual void SetUp()
+    {
+        RESET_FAKE(xSemaphoreCreateBinary);
+        RESET_FAKE(xSemaphoreCreateBinaryStatic);
+        RESET_FAKE(RingBuffer_Initialize);
+        FFF_RESET_HISTORY();
+
+        memset(&Transceiver, 0, sizeof(Transceiver));
+        xSemaphoreCreateBinaryStatic_fake.return_val = (SemaphoreHandle_t)0x10;
+    }
+};
+
+/* Specify test cases ******************************************************* */
+
+TEST_F(UARTTransceiverStatic, InitializeInStorage)
+{
+    Retcode_T retcode = UARTTransceiver_InitializeStatic(&Transceiver, (HWHandle_T)0x55, RawRxBuffer, sizeof(RawRxBuffer), UART_TRANSCEIVER_UART_TYPE_UART, &Storage);
+
+    EXPECT_EQ(RETCODE_OK, retcode);
+    EXPECT_EQ(UINT32_C(2), xSemaphoreCreateBinaryStatic_fake.call_count);
+    EXPECT_EQ(&Storage.RxSemaphore, xSemaphoreCreateBinaryStatic_fake.arg0_history[0]);
+    EXPECT_EQ(&Storage.TxSemaphore, xSemaphoreCreateBinaryStatic_fake.arg0_history[1]);
+    EXPECT_EQ(UINT32_C(0), xSemaphoreCreateBinary_fake.call_count);
+    EXPECT_EQ(UART_TRANSCEIVER_STATE_INITIALIZED, Transceiver.State);
+    EXPECT_EQ(UINT32_C(1), RingBuffer_Initialize_fake.call_count);
+}
+
+TEST_F(UARTTransceiverStatic, InitializeWithoutStorage)
+{
+    Retcode_T retcode = UARTTransceiver_InitializeStatic(&Transceiver, (HWHandle_T)0x55, RawRxBuffer, sizeof(RawRxBuffer), UART_TRANSCEIVER_UART_TYPE_UART, NULL);
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_INVALID_PARAM), retcode);
+    EXPECT_EQ(UINT32_C(0), xSemaphoreCreateBinaryStatic_fake.call_count);
+    EXPECT_EQ(UART_TRANSCEIVER_STATE_RESET, Transceiver.State);
+}
+
+TEST_F(UARTTransceiverStatic, InitializeTwice)
+{
+    Transceiver.State = UART_TRANSCEIVER_STATE_INITIALIZED;
+
+    Retcode_T retcode = UARTTransceiver_InitializeStatic(&Transceiver, (HWHandle_T)0x55, RawRxBuffer, sizeof(RawRxBuffer), UART_TRANSCEIVER_UART_TYPE_UART, &Storage);
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_DOPPLE_INITIALIZATION), retcode);
+    EXPECT_EQ(UINT32_C(0), xSemaphoreCreateBinaryStatic_fake.call_count);
+}
+
+#else
+}
+#endif /* if KISO_FEATURE_UARTTRANSCEIVER */
@@ -0,0 +1,241 @@
+/********************************************************************************
+* Copyright (c) 2010-2019 Robert Bosch GmbH
+*
+* This program and the accompanying materials are made available under the
+* terms of the Eclipse Public License 2.0 which is available at
+* http://www.eclipse.org/legal/epl-2.0.
+*
+* SPDX-License-Identifier: EPL-2.0
+*
+* Contributors:
+*    Robert Bosch GmbH - initial contribution
+*
+********************************************************************************/
+
+/**
+ *
+ * @brief
+ *      Module test specification for the UARTTransceiver module waking its callers by task notifications.
+ *
+ * @detail
+ *      The unit test file template follows the Four-Phase test pattern.
+ *
+ * @file
+ **/
+
+/* Include gtest interface */
+#include <gtest.h>
+
+/* Start of global scope symbol and fake definitions section */
+extern "C"
+{
+/* Setup compile time configuration defines */
+#define KISO_UTILS_TASK_NOTIFICATIONS 1
+
+#include "Kiso_Utils.h"
+#undef KISO_MODULE_ID
+#define KISO_MODULE_ID KISO_UTILS_MODULE_ID_UART_TRANSCEIVER
+
+#if KISO_FEATURE_UARTTRANSCEIVER
+
+/* Include faked interfaces */
+#include "Kiso_Assert_th.hh"
+#include "Kiso_Retcode_th.hh"
+#include "Kiso_RingBuffer_th.hh"
+#include "Kiso_MCU_UART_th.hh"
+#include "FreeRTOS_th.hh"
+#include "semphr_th.hh"
+#include "task_th.hh"
+
+/* Include module under test */
+#include "UartTransceiver.c"
+
+    /* End of global scope symbol and fake definitions section */
+}
+
+static UARTTransceiver_T Transceiver;
+
+static TaskHandle_t const CurrentTask = (TaskHandle_t)0x42;
+
+/* Event of the loop callback while the task waits, and at which wake-up, 0 for never */
+static struct MCU_UART_Event_S EventAtWait;
+static uint32_t EventAtWaitCount = 0;
+
+static bool FrameEndCheck(uint8_t lastByte)
+{
+    KISO_UNUSED(lastByte);
+    return true;
+}
+
+static void AsyncCallback(struct MCU_UART_Event_S event)
+{
+    KISO_UNUSED(event);
+}
+
+static BaseType_t FakeTaskNotifyWait(uint32_t bitsToClearOnEntry, uint32_t bitsToClearOnExit, uint32_t *value, TickType_t ticksToWait)
+{
+    KISO_UNUSED(bitsToClearOnEntry);
+    KISO_UNUSED(bitsToClearOnExit);
+    KISO_UNUSED(value);
+    KISO_UNUSED(ticksToWait);
+    if (EventAtWaitCount == xTaskNotifyWait_fake.call_count)
+    {
+        UARTTransceiver_LoopCallback(&Transceiver, EventAtWait);
+    }
+    return pdTRUE;
+}
+
+class UARTTransceiverNotify : public testing::Test
+{
+protected:
+    uint8_t Buffer[8];
+    uint32_t Length;
+
+    virtual void SetUp()
+    {
+        RESET_FAKE(xSemaphoreCreateBinary);
+        RESET_FAKE(MCU_UART_Send);
+        RESET_FAKE(RingBuffer_Initialize);
+        RESET_FAKE(RingBuffer_Write);
+        RESET_FAKE(RingBuffer_Read);
+        RESET_FAKE(xTaskGetCurrentTaskHandle);
+        RESET_FAKE(vTaskSetTimeOutState);
+        RESET_FAKE(xTaskCheckForTimeOut);
+        RESET_FAKE(xTaskNotifyWait);
+        RESET_FAKE(xTaskNotifyFromISR);
+        FFF_RESET_HISTORY();
+
+        memset(&Transceiver, 0, sizeof(Transceiver));
+        Transceiver.handle = (HWHandle_T)0x55;
+        Transceiver.UartType = UART_TRANSCEIVER_UART_TYPE_UART;
+        Transceiver.Mode = UART_TRANSCEIVER_MODE_SYNCH;
+        Transceiver.State = UART_TRANSCEIVER_STATE_ACTIVE;
+        Transceiver.EndOfFrameCheck = FrameEndCheck;
+        Transceiver.errorCode = RETCODE_SUCCESS;
+
+        memset(&EventAtWait, 0, sizeof(EventAtWait));
+        EventAtWaitCount = 0;
+        Length = 0;
+        RingBuffer_Write_fake.return_val = 1;
+        RingBuffer_Read_fake.return_val = 3;
+        xTaskGetCurrentTaskHandle_fake.return_val = CurrentTask;
+        xTaskNotifyWait_fake.custom_fake = FakeTaskNotifyWait;
+    }
+};
+
+/* Specify test cases ******************************************************* */
+
+TEST_F(UARTTransceiverNotify, InitializeCreatesNoSemaphore)
+{
+    uint8_t rawRxBuffer[4];
+    UARTTransceiver_T transceiver;
+    memset(&transceiver, 0, sizeof(transceiver));
+
+    Retcode_T retcode = UARTTransceiver_Initialize(&transceiver, (HWHandle_T)0x55, rawRxBuffer, sizeof(rawRxBuffer), UART_TRANSCEIVER_UART_TYPE_UART);
+
+    EXPECT_EQ(RETCODE_OK, retcode);
+    EXPECT_EQ(UINT32_C(0), xSemaphoreCreateBinary_fake.call_count);
+    EXPECT_EQ(UART_TRANSCEIVER_STATE_INITIALIZED, transceiver.State);
+    EXPECT_EQ(RETCODE_OK, UARTTransceiver_Deinitialize(&transceiver));
+}
+
+TEST_F(UARTTransceiverNotify, ReadFrameBeforeWait)
+{
+    struct MCU_UART_Event_S event;
+    memset(&event, 0, sizeof(event));
+    event.RxComplete = 1;
+    UARTTransceiver_LoopCallback(&Transceiver, event);
+
+    Retcode_T retcode = UARTTransceiver_ReadData(&Transceiver, Buffer, sizeof(Buffer), &Length, 100);
+
+    /* The frame end is kept until the read, as the semaphore did */
+    EXPECT_EQ(RETCODE_OK, retcode);
+    EXPECT_EQ(UINT32_C(3), Length);
+    EXPECT_EQ(UINT32_C(0), xTaskNotifyFromISR_fake.call_count);
+    EXPECT_EQ(UINT32_C(0), xTaskNotifyWait_fake.call_count);
+    EXPECT_FALSE(Transceiver.RxSignaled);
+}
+
+TEST_F(UARTTransceiverNotify, ReadWakesWaitingTask)
+{
+    EventAtWait.RxComplete = 1;
+    EventAtWaitCount = 1;
+
+    Retcode_T retcode = UARTTransceiver_ReadData(&Transceiver, Buffer, sizeof(Buffer), &Length, 100);
+
+    EXPECT_EQ(RETCODE_OK, retcode);
+    EXPECT_EQ(UINT32_C(1), xTaskNotifyWait_fake.call_count);
+    EXPECT_EQ(UINT32_C(1), xTaskNotifyFromISR_fake.call_count);
+    EXPECT_EQ(CurrentTask, xTaskNotifyFromISR_fake.arg0_val);
+    EXPECT_EQ(eNoAction, xTaskNotifyFromISR_fake.arg2_val);
+    EXPECT_EQ(NULL, Transceiver.RxWaitingTask);
+}
+
+TEST_F(UARTTransceiverNotify, ReadRxError)
+{
+    EventAtWait.RxError = 1;
+    EventAtWaitCount = 1;
+
+    Retcode_T retcode = UARTTransceiver_ReadData(&Transceiver, Buffer, sizeof(Buffer), &Length, 100);
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_FAILURE), retcode);
+}
+
+TEST_F(UARTTransceiverNotify, ReadIgnoresTxComplete)
+{
+    BaseType_t timeOut[] = {pdFALSE, pdFALSE, pdTRUE};
+    SET_RETURN_SEQ(xTaskCheckForTimeOut, timeOut, 3);
+    EventAtWait.TxComplete = 1;
+    EventAtWaitCount = 1;
+
+    Retcode_T retcode = UARTTransceiver_ReadData(&Transceiver, Buffer, sizeof(Buffer), &Length, 100);
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SEMAPHORE_ERROR), retcode);
+    EXPECT_EQ(UINT32_C(2), xTaskNotifyWait_fake.call_count);
+    EXPECT_TRUE(Transceiver.TxSignaled);
+    EXPECT_EQ(NULL, Transceiver.RxWaitingTask);
+}
+
+TEST_F(UARTTransceiverNotify, WriteWakesWaitingTask)
+{
+    /* Other notifications of the task come first */
+    EventAtWait.TxComplete = 1;
+    EventAtWaitCount = 2;
+
+    Retcode_T retcode = UARTTransceiver_WriteData(&Transceiver, Buffer, sizeof(Buffer), 100);
+
+    EXPECT_EQ(RETCODE_OK, retcode);
+    EXPECT_EQ(UINT32_C(1), MCU_UART_Send_fake.call_count);
+    EXPECT_EQ(UINT32_C(2), xTaskNotifyWait_fake.call_count);
+    EXPECT_EQ(UINT32_C(1), xTaskNotifyFromISR_fake.call_count);
+    EXPECT_EQ(NULL, Transceiver.TxWaitingTask);
+}
+
+TEST_F(UARTTransceiverNotify, WriteIgnoresEarlierTxComplete)
+{
+    BaseType_t timeOut[] = {pdFALSE, pdTRUE};
+    SET_RETURN_SEQ(xTaskCheckForTimeOut, timeOut, 2);
+    Transceiver.TxSignaled = true;
+
+    Retcode_T retcode = UARTTransceiver_WriteData(&Transceiver, Buffer, sizeof(Buffer), 100);
+
+    EXPECT_EQ(RETCODE(RETCODE_SEVERITY_ERROR, RETCODE_SEMAPHORE_ERROR), retcode);
+}
+
+TEST_F(UARTTransceiverNotify, AsyncModeNotifiesNobody)
+{
+    struct MCU_UART_Event_S event;
+    memset(&event, 0, sizeof(event));
+    event.TxComplete = 1;
+    Transceiver.Mode = UART_TRANSCEIVER_MODE_ASYNCH;
+    Transceiver.callback = AsyncCallback;
+
+    UARTTransceiver_LoopCallback(&Transceiver, event);
+
+    EXPECT_FALSE(Transceiver.TxSignaled);
+    EXPECT_EQ(UINT32_C(0), xTaskNotifyFromISR_fake.call_count);
+}
+
+#else
+}
+#endif /* if KISO_FEATURE_UARTTRANSCEIVER */
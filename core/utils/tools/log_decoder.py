@@ -0,0 +1,334 @@
+#!/usr/bin/env python3
+
+"""
+Binary Log Decoder
+******************
+
+:module: log_decoder
+
+:platform: Windows, Linux, MacOS
+:synopsis: Turn the records of the binary log recorder (Logging_BinaryRecorder)
+back into text lines.
+The records carry the addresses of the format string and the file name, which
+are looked up in the ELF file of the application, and the raw arguments.
+This modules is intended to be invoked as __main__. Trying to import the module
+will fail.
+Make sure to invoke this script with Python 3.6 or higher, as certain language
+features are not supported by older Python versions.
+
+Usage::
+
+    log_decoder.py [--framing {escaping,cobs}] application.elf [log]
+
+The log is a recorded file or a serial device, standard input by default. It
+has to be read with the XProtocol framing the application was built with
+(KISO_XPROTOCOL_COBS). Every record is printed as one line in the format of
+the synchronous recorder, without the task name::
+
+    <tick> <level> <package>\\t[<file>:<line>]\\t<message>
+
+The arguments are formatted like printf() on the target would. The recorder
+sends integers as promoted to int, so the h and hh length modifiers are
+applied here: %hhu of 300 prints 44, %hd of 40000 prints -25536. A message
+whose arguments were cut on the target ends with ' ...'. Frames with a wrong
+checksum and records too short for their header are skipped and counted; the
+exit code is 1 if there were any.
+
+The decoder is tested by core/utils/test/tools/log_decoder_test.py.
+
+:Copyright: Copyright (c) 2010-2019 Robert Bosch GmbH
+
+    This program and the accompanying materials are made available under the
+    terms of the Eclipse Public License 2.0 which is available at
+    http://www.eclipse.org/legal/epl-2.0.
+
+    SPDX-License-Identifier: EPL-2.0
+
+    Contributors:
+        Robert Bosch GmbH - initial contribution
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+if __name__ != '__main__':
+    raise ImportError('This module is intended to be invoked as __main__')
+
+XPROTOCOL_SD = 0xC0
+XPROTOCOL_ED = 0xC9
+XPROTOCOL_ESC = 0xDB
+XPROTOCOL_UNESCAPE = {0xDC: XPROTOCOL_SD, 0xDE: XPROTOCOL_ED, 0xDD: XPROTOCOL_ESC}
+XPROTOCOL_CRC_CCITT_POLY = 0x1021
+
+RECORD_HEADER = struct.Struct('<BBBBIIII')
+RECORD_FLAG_TRUNCATED = 0x01
+LOG_LEVEL_STRING = ['', 'F', 'E', 'W', 'I', 'D']
+
+# Integer arguments are sent as 32 bit words, unless they are converted to a smaller type
+INTEGER_BITS = {'hh': 8, 'h': 16}
+
+SHT_NOBITS = 8
+SHF_ALLOC = 0x2
+
+CONVERSION = re.compile(
+    r'%(?P<flags>[-+ #0]*)(?P<width>\*|\d+)?(?:\.(?P<precision>\*|\d*))?'
+    r'(?P<length>hh|h|ll|l|j|z|t|L)?(?P<conversion>[diouxXcpaAeEfFgGsn%])')
+
+
+class ElfImage:
+    """ Loaded sections of an ELF file, to read strings by their address. """
+
+    def __init__(self, path):
+        with open(path, 'rb') as elf:
+            self.data = elf.read()
+        if self.data[:4] != b'\x7fELF':
+            raise ValueError('{} is not an ELF file'.format(path))
+        is64 = (2 == self.data[4])
+        order = '<' if (1 == self.data[5]) else '>'
+        if is64:
+            shoff, = struct.unpack_from(order + 'Q', self.data, 0x28)
+            shentsize, shnum = struct.unpack_from(order + 'HH', self.data, 0x3A)
+            section = struct.Struct(order + 'IIQQQQ')
+        else:
+            shoff, = struct.unpack_from(order + 'I', self.data, 0x20)
+            shentsize, shnum = struct.unpack_from(order + 'HH', self.data, 0x2E)
+            section = struct.Struct(order + 'IIIIII')
+
+        self.sections = []
+        for index in range(shnum):
+            _, kind, flags, address, offset, size = section.unpack_from(self.data, shoff + index * shentsize)
+            if (flags & SHF_ALLOC) and (SHT_NOBITS != kind) and (0 < size):
+                self.sections.append((address, size, offset))
+
+    def string(self, address):
+        """ Returns the terminated string at address, or None if no loaded section holds it. """
+        for start, size, offset in self.sections:
+            if start <= address < (start + size):
+                begin = offset + address - start
+                end = self.data.find(b'\0', begin, offset + size)
+                end = (offset + size) if (end < 0) else end
+                return self.data[begin:end].decode('utf-8', errors='replace')
+        return None
+
+
+def crc16(data):
+    """ CRC-16 as calculated by XProtocol with CRC_16(), polynomial 0x1021 and initial value 0. """
+    crc = 0
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ XPROTOCOL_CRC_CCITT_POLY) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def escaping_frames(stream):
+    """ Yields the unescaped content (checksum and payload) of SD/ED delimited frames. """
+    frame = None
+    escaped = False
+    for chunk in iter(lambda: stream.read(1024), b''):
+        for byte in chunk:
+            if XPROTOCOL_SD == byte:
+                frame = bytearray()
+                escaped = False
+            elif frame is None:
+                continue
+            elif XPROTOCOL_ED == byte:
+                yield bytes(frame)
+                frame = None
+            elif escaped:
+                frame.append(XPROTOCOL_UNESCAPE.get(byte, byte))
+                escaped = False
+            elif XPROTOCOL_ESC == byte:
+                escaped = True
+            else:
+                frame.append(byte)
+
+
+def cobs_frames(stream):
+    """ Yields the decoded content (payload and checksum) of 0x00 delimited COBS frames. """
+    frame = bytearray()
+    for chunk in iter(lambda: stream.read(1024), b''):
+        for byte in chunk:
+            if 0 != byte:
+                frame.append(byte)
+                continue
+            if not frame:
+                continue
+            decoded = bytearray()
+            index = 0
+            while index < len(frame):
+                code = frame[index]
+                decoded += frame[index + 1:index + code]
+                index += code
+                if (0xFF != code) and (index < len(frame)):
+                    decoded.append(0)
+            frame = bytearray()
+            yield bytes(decoded)
+
+
+def payloads(stream, framing, errors):
+    """ Yields the payloads of all frames with a valid checksum. """
+    if 'cobs' == framing:
+        frames = ((content[:-2], content[-2:]) for content in cobs_frames(stream))
+    else:
+        frames = ((content[2:], content[:2]) for content in escaping_frames(stream))
+    for payload, checksum in frames:
+        if (2 == len(checksum)) and (crc16(payload) == ((checksum[0] << 8) | checksum[1])):
+            yield payload
+        else:
+            errors['checksum'] += 1
+
+
+class Arguments:
+    """ Reads the arguments of a record in the order of the conversions. """
+
+    def __init__(self, data):
+        self.data = data
+        self.offset = 0
+
+    def _take(self, size):
+        if (self.offset + size) > len(self.data):
+            raise IndexError
+        value = self.data[self.offset:self.offset + size]
+        self.offset += size
+        return value
+
+    def word(self):
+        return struct.unpack('<I', self._take(4))[0]
+
+    def long_long(self):
+        return struct.unpack('<Q', self._take(8))[0]
+
+    def double(self):
+        return struct.unpack('<d', self._take(8))[0]
+
+    def string(self):
+        length = self._take(1)[0]
+        return self._take(length).decode('utf-8', errors='replace')
+
+
+def signed(value, bits):
+    """ Interprets the lowest bits of value as two's complement. """
+    value &= (1 << bits) - 1
+    return (value - (1 << bits)) if (value & (1 << (bits - 1))) else value
+
+
+def integer(arguments, length):
+    """ Reads an integer argument and converts it to the type of the length modifier, like printf() does. """
+    if length in ('ll', 'j'):
+        return arguments.long_long(), 64
+    return arguments.word(), INTEGER_BITS.get(length, 32)
+
+
+def convert(match, arguments):
+    """ Formats one conversion with its arguments, like printf() would. """
+    flags = match.group('flags')
+    width = match.group('width') or ''
+    precision = match.group('precision')
+    conversion = match.group('conversion')
+    length = match.group('length')
+
+    if '%' == conversion:
+        return '%'
+    if '*' == width:
+        width = signed(arguments.word(), 32)
+        flags, width = (flags + '-', str(-width)) if (width < 0) else (flags, str(width))
+    if '*' == precision:
+        precision = signed(arguments.word(), 32)
+        precision = None if (precision < 0) else str(precision)
+    spec = '%' + flags + width + ('' if precision is None else '.' + precision)
+
+    if 'n' == conversion:
+        return ''
+    if conversion in 'di':
+        value, bits = integer(arguments, length)
+        return (spec + 'd') % signed(value, bits)
+    if conversion in 'ouxX':
+        value, bits = integer(arguments, length)
+        value &= (1 << bits) - 1
+        if ('o' == conversion) and ('#' in flags):
+            # Python prefixes 0o instead of 0
+            return (spec.replace('#', '').split('.')[0] + 's') % (('0%o' % value) if value else '0')
+        return (spec + ('d' if ('u' == conversion) else conversion)) % value
+    if 'c' == conversion:
+        return (spec + 'c') % chr(arguments.word() & 0xFF)
+    if 'p' == conversion:
+        return (spec + 's') % ('0x%08x' % arguments.word())
+    if conversion in 'aA':
+        text = arguments.double().hex()
+        return (spec.split('.')[0] + 's') % (text.upper() if ('A' == conversion) else text)
+    if conversion in 'eEfFgG':
+        return (spec + conversion) % arguments.double()
+    return (spec + 's') % arguments.string()
+
+
+def format_message(fmt, data):
+    """ Rebuilds the message, returns it and whether arguments were missing. """
+    arguments = Arguments(data)
+    message = []
+    position = 0
+    for match in CONVERSION.finditer(fmt):
+        message.append(fmt[position:match.start()])
+        try:
+            message.append(convert(match, arguments))
+        except IndexError:
+            return ''.join(message), True
+        position = match.end()
+    message.append(fmt[position:])
+    return ''.join(message), False
+
+
+def decode_record(payload, elf):
+    """ Returns the text line of a record, in the format of the synchronous recorder without task name. """
+    if len(payload) < RECORD_HEADER.size:
+        return None
+    flags, level, package, module, tick, fmt, file, line = RECORD_HEADER.unpack_from(payload)
+    fmt_string = elf.string(fmt)
+    file_string = elf.string(file)
+    if fmt_string is None:
+        message, is_cut = '<unknown format 0x{:08x}>'.format(fmt), False
+    else:
+        message, is_cut = format_message(fmt_string, payload[RECORD_HEADER.size:])
+    if is_cut or (flags & RECORD_FLAG_TRUNCATED):
+        message += ' ...'
+    level_string = LOG_LEVEL_STRING[level] if (level < len(LOG_LEVEL_STRING)) else str(level)
+    file_string = file_string if file_string is not None else '0x{:08x}'.format(file)
+    return '{} {} {}\t[{}:{}]\t{}'.format(tick, level_string, package, file_string, line, message)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode the output of the binary log recorder.')
+    parser.add_argument('elf', help='ELF file of the application which wrote the log')
+    parser.add_argument('input', nargs='?', default='-',
+                        help='Recorded log or serial device, standard input by default')
+    parser.add_argument('--framing', choices=['escaping', 'cobs'], default='escaping',
+                        help='XProtocol framing of the application (KISO_XPROTOCOL_COBS)')
+    args = parser.parse_args()
+
+    elf = ElfImage(args.elf)
+    errors = {'checksum': 0, 'record': 0}
+    stream = sys.stdin.buffer if ('-' == args.input) else open(args.input, 'rb')
+    try:
+        for payload in payloads(stream, args.framing, errors):
+            line = decode_record(payload, elf)
+            if line is None:
+                errors['record'] += 1
+            else:
+                print(line, flush=True)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if stream is not sys.stdin.buffer:
+            stream.close()
+
+    if errors['checksum'] or errors['record']:
+        print('{} frames with a wrong checksum, {} invalid records'.format(errors['checksum'], errors['record']),
+              file=sys.stderr)
+        return 1
+    return 0
+
+
+sys.exit(main())
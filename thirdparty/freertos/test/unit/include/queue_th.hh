@@ -39,6 +39,10 @@ typedef void *QueueSetMemberHandle_t;
 
 FAKE_VALUE_FUNC(QueueHandle_t, xQueueCreate, UBaseType_t, UBaseType_t)
 
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+FAKE_VALUE_FUNC(QueueHandle_t, xQueueCreateStatic, UBaseType_t, UBaseType_t, uint8_t *, StaticQueue_t *)
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+
 FAKE_VALUE_FUNC(BaseType_t, xQueueSendToFront, QueueHandle_t, void *, TickType_t)
 FAKE_VALUE_FUNC(BaseType_t, xQueueSendToBack, QueueHandle_t, void *, TickType_t)
 FAKE_VALUE_FUNC(BaseType_t, xQueueSend, QueueHandle_t, void *, TickType_t)
@@ -39,6 +39,9 @@ typedef void (*PendedFunction_t)(void *, uint32_t);
 
 /* mock-ups for the provided interfaces */
 FAKE_VALUE_FUNC(TimerHandle_t, xTimerCreate, const char *, TickType_t, UBaseType_t, void *, TimerCallbackFunction_t)
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+FAKE_VALUE_FUNC(TimerHandle_t, xTimerCreateStatic, const char *, TickType_t, UBaseType_t, void *, TimerCallbackFunction_t, StaticTimer_t *)
+#endif /* configSUPPORT_STATIC_ALLOCATION */
 FAKE_VALUE_FUNC(void *, pvTimerGetTimerID, TimerHandle_t)
 FAKE_VOID_FUNC(vTimerSetTimerID, TimerHandle_t, void *)
 FAKE_VALUE_FUNC(BaseType_t, xTimerIsTimerActive, TimerHandle_t)